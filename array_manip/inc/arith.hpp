@@ -31,6 +31,9 @@
 #define _ARITH_HPP 1
 
 #include "nessi.hpp"
+#include "nessi_block.hpp"
+#include "nessi_exec.hpp"
+#include "nessi_view.hpp"
 #include <string>
 
 /**
@@ -74,6 +77,29 @@ namespace ArrayManip
   abs_val(const Nessi::Vector<NumT> & input,
           Nessi::Vector<NumT> & output,
           void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.55 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be processed in place.
+   *
+   * \param input (INPUT) is a view of the array to be absolute valued
+   * \param output (OUTPUT) is a view of the result array
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not the
+   * same size.
+   */
+  template <typename NumT>
+  std::string
+  abs_val(const Nessi::VectorView<const NumT> & input,
+          const Nessi::VectorView<NumT> & output,
+          void *temp=NULL);
   /**
    * \}
    */ // end of abs_val group
@@ -392,6 +418,208 @@ namespace ArrayManip
             const size_t o_span,
             void *temp=NULL);
 
+  /**
+   * \brief This function is described in section 3.6 applied to every
+   * spectrum of a block
+   *
+   * This function adds the spectra of two blocks bin by bin. Spectrum
+   * \f$p\f$ of the output is the result of the vector version of this
+   * function for spectrum \f$p\f$ of both inputs, including the
+   * propagation of the uncertainties. All spectra are processed in one
+   * call and blocks without padding are processed as a single array.
+   *
+   * \param input1 (INPUT) is the first block
+   * \param input2 (INPUT) is the second block
+   * \param output (OUTPUT) is the result block
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the blocks do not have
+   * the same number of spectra and bins.
+   */
+  template <typename NumT>
+  std::string
+  add_ncerr(const Nessi::SpectrumBlock<NumT> & input1,
+            const Nessi::SpectrumBlock<NumT> & input2,
+            Nessi::SpectrumBlock<NumT> & output,
+            void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.6 applied to every
+   * spectrum of a block with an execution policy
+   *
+   * This function adds the spectra of two blocks bin by bin. Spectrum
+   * \f$p\f$ of the output is the result of the vector version of this
+   * function for spectrum \f$p\f$ of both inputs, including the
+   * propagation of the uncertainties. All spectra are processed in one
+   * call and blocks without padding are processed as a single array.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param input1 (INPUT) is the first block
+   * \param input2 (INPUT) is the second block
+   * \param output (OUTPUT) is the result block
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the blocks do not have
+   * the same number of spectra and bins.
+   */
+  template <typename NumT>
+  std::string
+  add_ncerr(const Nessi::ExecutionPolicy & policy,
+            const Nessi::SpectrumBlock<NumT> & input1,
+            const Nessi::SpectrumBlock<NumT> & input2,
+            Nessi::SpectrumBlock<NumT> & output,
+            void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.6 applied to every
+   * spectrum of a block
+   *
+   * This function takes every spectrum of a block and the single spectrum
+   * \f$data_2\f$ and applies the vector version of this function to them,
+   * including the propagation of the uncertainties. This is the usual way
+   * of applying a common correction, such as a vanadium or a background
+   * spectrum, to all pixels in one call.
+   *
+   * \param input1 (INPUT) is the block of spectra
+   * \param input2 (INPUT) is the spectrum added to every spectrum
+   * of input1
+   * \param input2_err2 (INPUT) is the square of the uncertainty in input2
+   * \param output (OUTPUT) is the result block
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if input1 and output do not
+   * have the same number of spectra and bins, or if input2 and input2_err2
+   * do not have the number of bins of the blocks.
+   */
+  template <typename NumT>
+  std::string
+  add_ncerr(const Nessi::SpectrumBlock<NumT> & input1,
+            const Nessi::Vector<NumT> & input2,
+            const Nessi::Vector<NumT> & input2_err2,
+            Nessi::SpectrumBlock<NumT> & output,
+            void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.6 applied to every
+   * spectrum of a block with an execution policy
+   *
+   * This function takes every spectrum of a block and the single spectrum
+   * \f$data_2\f$ and applies the vector version of this function to them,
+   * including the propagation of the uncertainties. This is the usual way
+   * of applying a common correction, such as a vanadium or a background
+   * spectrum, to all pixels in one call.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param input1 (INPUT) is the block of spectra
+   * \param input2 (INPUT) is the spectrum added to every spectrum
+   * of input1
+   * \param input2_err2 (INPUT) is the square of the uncertainty in input2
+   * \param output (OUTPUT) is the result block
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if input1 and output do not
+   * have the same number of spectra and bins, or if input2 and input2_err2
+   * do not have the number of bins of the blocks.
+   */
+  template <typename NumT>
+  std::string
+  add_ncerr(const Nessi::ExecutionPolicy & policy,
+            const Nessi::SpectrumBlock<NumT> & input1,
+            const Nessi::Vector<NumT> & input2,
+            const Nessi::Vector<NumT> & input2_err2,
+            Nessi::SpectrumBlock<NumT> & output,
+            void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.1 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be processed in place. Views with unit stride are passed to the same
+   * kernel as the vector version, while strided views are gathered into
+   * contiguous buffers first.
+   *
+   * \param array_in (INPUT) is a view of the array to be added
+   * \param array_in_err2 (INPUT) is a view of the square of the uncertainty
+   * in the array to be added
+   * \param scalar (INPUT) is the scalar to add to each element of array_in
+   * \param scalar_err2 (INPUT) is the square of the uncertainty in the
+   * scalar
+   * \param array_out (OUTPUT) is a view of the result array
+   * \param array_out_err2 (OUTPUT) is a view of the square of the
+   * uncertainty in the result array
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  add_ncerr(const Nessi::VectorView<const NumT> & array_in,
+            const Nessi::VectorView<const NumT> & array_in_err2,
+            const NumT scalar,
+            const NumT scalar_err2,
+            const Nessi::VectorView<NumT> & array_out,
+            const Nessi::VectorView<NumT> & array_out_err2,
+            void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.6 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be processed in place. Views with unit stride are passed to the same
+   * kernel as the vector version, while strided views are gathered into
+   * contiguous buffers first.
+   *
+   * \param input1 (INPUT) is a view of the first array to be added
+   * \param input1_err2 (INPUT) is a view of the square of the uncertainty
+   * in the first array to be added
+   * \param input2 (INPUT) is a view of the second array to be added
+   * \param input2_err2 (INPUT) is a view of the square of the uncertainty
+   * in the second array to be added
+   * \param output (OUTPUT) is a view of the result array
+   * \param output_err2 (OUTPUT) is a view of the square of the uncertainty
+   * in the result array
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  add_ncerr(const Nessi::VectorView<const NumT> & input1,
+            const Nessi::VectorView<const NumT> & input1_err2,
+            const Nessi::VectorView<const NumT> & input2,
+            const Nessi::VectorView<const NumT> & input2_err2,
+            const Nessi::VectorView<NumT> & output,
+            const Nessi::VectorView<NumT> & output_err2,
+            void *temp=NULL);
+
   /**
    * \}
    */ // end of add_ncerr group
@@ -679,6 +907,248 @@ namespace ArrayManip
             NumT & output_err2,
             void *temp=NULL);
 
+  /**
+   * \brief This function is described in section 3.9 applied to every
+   * spectrum of a block
+   *
+   * This function divides the spectra of two blocks bin by bin. Spectrum
+   * \f$p\f$ of the output is the result of the vector version of this
+   * function for spectrum \f$p\f$ of both inputs, including the
+   * propagation of the uncertainties. All spectra are processed in one
+   * call and blocks without padding are processed as a single array.
+   *
+   * \param input1 (INPUT) is the first block
+   * \param input2 (INPUT) is the second block
+   * \param output (OUTPUT) is the result block
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the blocks do not have
+   * the same number of spectra and bins.
+   */
+  template <typename NumT>
+  std::string
+  div_ncerr(const Nessi::SpectrumBlock<NumT> & input1,
+            const Nessi::SpectrumBlock<NumT> & input2,
+            Nessi::SpectrumBlock<NumT> & output,
+            void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.9 applied to every
+   * spectrum of a block with an execution policy
+   *
+   * This function divides the spectra of two blocks bin by bin. Spectrum
+   * \f$p\f$ of the output is the result of the vector version of this
+   * function for spectrum \f$p\f$ of both inputs, including the
+   * propagation of the uncertainties. All spectra are processed in one
+   * call and blocks without padding are processed as a single array.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param input1 (INPUT) is the first block
+   * \param input2 (INPUT) is the second block
+   * \param output (OUTPUT) is the result block
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the blocks do not have
+   * the same number of spectra and bins.
+   */
+  template <typename NumT>
+  std::string
+  div_ncerr(const Nessi::ExecutionPolicy & policy,
+            const Nessi::SpectrumBlock<NumT> & input1,
+            const Nessi::SpectrumBlock<NumT> & input2,
+            Nessi::SpectrumBlock<NumT> & output,
+            void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.9 applied to every
+   * spectrum of a block
+   *
+   * This function takes every spectrum of a block and the single spectrum
+   * \f$data_2\f$ and applies the vector version of this function to them,
+   * including the propagation of the uncertainties. This is the usual way
+   * of applying a common correction, such as a vanadium or a background
+   * spectrum, to all pixels in one call.
+   *
+   * \param input1 (INPUT) is the block of spectra
+   * \param input2 (INPUT) is the spectrum divided by every spectrum
+   * of input1
+   * \param input2_err2 (INPUT) is the square of the uncertainty in input2
+   * \param output (OUTPUT) is the result block
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if input1 and output do not
+   * have the same number of spectra and bins, or if input2 and input2_err2
+   * do not have the number of bins of the blocks.
+   */
+  template <typename NumT>
+  std::string
+  div_ncerr(const Nessi::SpectrumBlock<NumT> & input1,
+            const Nessi::Vector<NumT> & input2,
+            const Nessi::Vector<NumT> & input2_err2,
+            Nessi::SpectrumBlock<NumT> & output,
+            void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.9 applied to every
+   * spectrum of a block with an execution policy
+   *
+   * This function takes every spectrum of a block and the single spectrum
+   * \f$data_2\f$ and applies the vector version of this function to them,
+   * including the propagation of the uncertainties. This is the usual way
+   * of applying a common correction, such as a vanadium or a background
+   * spectrum, to all pixels in one call.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param input1 (INPUT) is the block of spectra
+   * \param input2 (INPUT) is the spectrum divided by every spectrum
+   * of input1
+   * \param input2_err2 (INPUT) is the square of the uncertainty in input2
+   * \param output (OUTPUT) is the result block
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if input1 and output do not
+   * have the same number of spectra and bins, or if input2 and input2_err2
+   * do not have the number of bins of the blocks.
+   */
+  template <typename NumT>
+  std::string
+  div_ncerr(const Nessi::ExecutionPolicy & policy,
+            const Nessi::SpectrumBlock<NumT> & input1,
+            const Nessi::Vector<NumT> & input2,
+            const Nessi::Vector<NumT> & input2_err2,
+            Nessi::SpectrumBlock<NumT> & output,
+            void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.4 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be processed in place. Views with unit stride are passed to the same
+   * kernel as the vector version, while strided views are gathered into
+   * contiguous buffers first.
+   *
+   * \param scalar (INPUT) is the scalar to be divided by each element of
+   * array_in
+   * \param scalar_err2 (INPUT) is the square of the uncertainty in the
+   * scalar
+   * \param array_in (INPUT) is a view of the array to divide from the
+   * scalar
+   * \param array_in_err2 (INPUT) is a view of the square of the uncertainty
+   * in the array to divide the scalar
+   * \param array_out (OUTPUT) is a view of the result array
+   * \param array_out_err2 (OUTPUT) is a view of the square of the
+   * uncertainty in the result array
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  div_ncerr(const NumT scalar,
+            const NumT scalar_err2,
+            const Nessi::VectorView<const NumT> & array_in,
+            const Nessi::VectorView<const NumT> & array_in_err2,
+            const Nessi::VectorView<NumT> & array_out,
+            const Nessi::VectorView<NumT> & array_out_err2,
+            void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.5 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be processed in place. Views with unit stride are passed to the same
+   * kernel as the vector version, while strided views are gathered into
+   * contiguous buffers first.
+   *
+   * \param array_in (INPUT) is a view of the array to be divided by the
+   * scalar
+   * \param array_in_err2 (INPUT) is a view of the square of the uncertainty
+   * in the array to be divided by the scalar
+   * \param scalar (INPUT) is the scalar to divide each element of array_in
+   * by
+   * \param scalar_err2 (INPUT) is the square of the uncertainty in the
+   * scalar
+   * \param array_out (OUTPUT) is a view of the result array
+   * \param array_out_err2 (OUTPUT) is a view of the square of the
+   * uncertainty in the result array
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  div_ncerr(const Nessi::VectorView<const NumT> & array_in,
+            const Nessi::VectorView<const NumT> & array_in_err2,
+            const NumT scalar,
+            const NumT scalar_err2,
+            const Nessi::VectorView<NumT> & array_out,
+            const Nessi::VectorView<NumT> & array_out_err2,
+            void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.9 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be processed in place. Views with unit stride are passed to the same
+   * kernel as the vector version, while strided views are gathered into
+   * contiguous buffers first.
+   *
+   * \param input1 (INPUT) is a view of the array to be divided from
+   * \param input1_err2 (INPUT) is a view of the square of the uncertainty
+   * in the array to be divided from
+   * \param input2 (INPUT) is a view of the array to divide by
+   * \param input2_err2 (INPUT) is a view of the square of the uncertainty
+   * in the array to divide by
+   * \param output (OUTPUT) is a view of the result array
+   * \param output_err2 (OUTPUT) is a view of the square of the uncertainty
+   * in the result array
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  div_ncerr(const Nessi::VectorView<const NumT> & input1,
+            const Nessi::VectorView<const NumT> & input1_err2,
+            const Nessi::VectorView<const NumT> & input2,
+            const Nessi::VectorView<const NumT> & input2_err2,
+            const Nessi::VectorView<NumT> & output,
+            const Nessi::VectorView<NumT> & output_err2,
+            void *temp=NULL);
+
   /**
    * \}
    */ // end of div_ncerr group
@@ -892,6 +1362,209 @@ namespace ArrayManip
              NumT & output_err2,
              void *temp=NULL);  
 
+  /**
+   * \brief This function is described in section 3.8 applied to every
+   * spectrum of a block
+   *
+   * This function multiplies the spectra of two blocks bin by bin. Spectrum
+   * \f$p\f$ of the output is the result of the vector version of this
+   * function for spectrum \f$p\f$ of both inputs, including the
+   * propagation of the uncertainties. All spectra are processed in one
+   * call and blocks without padding are processed as a single array.
+   *
+   * \param input1 (INPUT) is the first block
+   * \param input2 (INPUT) is the second block
+   * \param output (OUTPUT) is the result block
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the blocks do not have
+   * the same number of spectra and bins.
+   */
+  template <typename NumT>
+  std::string
+  mult_ncerr(const Nessi::SpectrumBlock<NumT> & input1,
+             const Nessi::SpectrumBlock<NumT> & input2,
+             Nessi::SpectrumBlock<NumT> & output,
+             void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.8 applied to every
+   * spectrum of a block with an execution policy
+   *
+   * This function multiplies the spectra of two blocks bin by bin. Spectrum
+   * \f$p\f$ of the output is the result of the vector version of this
+   * function for spectrum \f$p\f$ of both inputs, including the
+   * propagation of the uncertainties. All spectra are processed in one
+   * call and blocks without padding are processed as a single array.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param input1 (INPUT) is the first block
+   * \param input2 (INPUT) is the second block
+   * \param output (OUTPUT) is the result block
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the blocks do not have
+   * the same number of spectra and bins.
+   */
+  template <typename NumT>
+  std::string
+  mult_ncerr(const Nessi::ExecutionPolicy & policy,
+             const Nessi::SpectrumBlock<NumT> & input1,
+             const Nessi::SpectrumBlock<NumT> & input2,
+             Nessi::SpectrumBlock<NumT> & output,
+             void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.8 applied to every
+   * spectrum of a block
+   *
+   * This function takes every spectrum of a block and the single spectrum
+   * \f$data_2\f$ and applies the vector version of this function to them,
+   * including the propagation of the uncertainties. This is the usual way
+   * of applying a common correction, such as a vanadium or a background
+   * spectrum, to all pixels in one call.
+   *
+   * \param input1 (INPUT) is the block of spectra
+   * \param input2 (INPUT) is the spectrum multiplied by every spectrum
+   * of input1
+   * \param input2_err2 (INPUT) is the square of the uncertainty in input2
+   * \param output (OUTPUT) is the result block
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if input1 and output do not
+   * have the same number of spectra and bins, or if input2 and input2_err2
+   * do not have the number of bins of the blocks.
+   */
+  template <typename NumT>
+  std::string
+  mult_ncerr(const Nessi::SpectrumBlock<NumT> & input1,
+             const Nessi::Vector<NumT> & input2,
+             const Nessi::Vector<NumT> & input2_err2,
+             Nessi::SpectrumBlock<NumT> & output,
+             void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.8 applied to every
+   * spectrum of a block with an execution policy
+   *
+   * This function takes every spectrum of a block and the single spectrum
+   * \f$data_2\f$ and applies the vector version of this function to them,
+   * including the propagation of the uncertainties. This is the usual way
+   * of applying a common correction, such as a vanadium or a background
+   * spectrum, to all pixels in one call.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param input1 (INPUT) is the block of spectra
+   * \param input2 (INPUT) is the spectrum multiplied by every spectrum
+   * of input1
+   * \param input2_err2 (INPUT) is the square of the uncertainty in input2
+   * \param output (OUTPUT) is the result block
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if input1 and output do not
+   * have the same number of spectra and bins, or if input2 and input2_err2
+   * do not have the number of bins of the blocks.
+   */
+  template <typename NumT>
+  std::string
+  mult_ncerr(const Nessi::ExecutionPolicy & policy,
+             const Nessi::SpectrumBlock<NumT> & input1,
+             const Nessi::Vector<NumT> & input2,
+             const Nessi::Vector<NumT> & input2_err2,
+             Nessi::SpectrumBlock<NumT> & output,
+             void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.3 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be processed in place. Views with unit stride are passed to the same
+   * kernel as the vector version, while strided views are gathered into
+   * contiguous buffers first.
+   *
+   * \param array_in (INPUT) is a view of the array to be multipled
+   * \param array_in_err2 (INPUT) is a view of the square of the uncertainty
+   * in the array to be multiplied
+   * \param scalar (INPUT) is the scalar to multiply to each element of
+   * array_in
+   * \param scalar_err2 (INPUT) is the square of the uncertainty in the
+   * scalar
+   * \param array_out (OUTPUT) is a view of the result array
+   * \param array_out_err2 (OUTPUT) is a view of the square of the
+   * uncertainty in the result array
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  mult_ncerr(const Nessi::VectorView<const NumT> & array_in,
+             const Nessi::VectorView<const NumT> & array_in_err2,
+             const NumT scalar,
+             const NumT scalar_err2,
+             const Nessi::VectorView<NumT> & array_out,
+             const Nessi::VectorView<NumT> & array_out_err2,
+             void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.8 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be processed in place. Views with unit stride are passed to the same
+   * kernel as the vector version, while strided views are gathered into
+   * contiguous buffers first.
+   *
+   * \param input1 (INPUT) is a view of the first array to be multiplied
+   * \param input1_err2 (INPUT) is a view of the square of the uncertainty
+   * in the first array to be multiplied
+   * \param input2 (INPUT) is a view of the second array to be multiplied
+   * \param input2_err2 (INPUT) is a view of the square of the uncertainty
+   * in the second array to be multiplied
+   * \param output (OUTPUT) is a view of the result array
+   * \param output_err2 (OUTPUT) is a view of the square of the uncertainty
+   * in the result array
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  mult_ncerr(const Nessi::VectorView<const NumT> & input1,
+             const Nessi::VectorView<const NumT> & input1_err2,
+             const Nessi::VectorView<const NumT> & input2,
+             const Nessi::VectorView<const NumT> & input2_err2,
+             const Nessi::VectorView<NumT> & output,
+             const Nessi::VectorView<NumT> & output_err2,
+             void *temp=NULL);
+
   /**
    * \}
    */ // end of mult_ncerr group
@@ -1175,6 +1848,246 @@ namespace ArrayManip
             NumT & output_err2,
             void *temp=NULL);
     
+  /**
+   * \brief This function is described in section 3.7 applied to every
+   * spectrum of a block
+   *
+   * This function subtracts the spectra of two blocks bin by bin. Spectrum
+   * \f$p\f$ of the output is the result of the vector version of this
+   * function for spectrum \f$p\f$ of both inputs, including the
+   * propagation of the uncertainties. All spectra are processed in one
+   * call and blocks without padding are processed as a single array.
+   *
+   * \param input1 (INPUT) is the first block
+   * \param input2 (INPUT) is the second block
+   * \param output (OUTPUT) is the result block
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the blocks do not have
+   * the same number of spectra and bins.
+   */
+  template <typename NumT>
+  std::string
+  sub_ncerr(const Nessi::SpectrumBlock<NumT> & input1,
+            const Nessi::SpectrumBlock<NumT> & input2,
+            Nessi::SpectrumBlock<NumT> & output,
+            void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.7 applied to every
+   * spectrum of a block with an execution policy
+   *
+   * This function subtracts the spectra of two blocks bin by bin. Spectrum
+   * \f$p\f$ of the output is the result of the vector version of this
+   * function for spectrum \f$p\f$ of both inputs, including the
+   * propagation of the uncertainties. All spectra are processed in one
+   * call and blocks without padding are processed as a single array.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param input1 (INPUT) is the first block
+   * \param input2 (INPUT) is the second block
+   * \param output (OUTPUT) is the result block
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the blocks do not have
+   * the same number of spectra and bins.
+   */
+  template <typename NumT>
+  std::string
+  sub_ncerr(const Nessi::ExecutionPolicy & policy,
+            const Nessi::SpectrumBlock<NumT> & input1,
+            const Nessi::SpectrumBlock<NumT> & input2,
+            Nessi::SpectrumBlock<NumT> & output,
+            void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.7 applied to every
+   * spectrum of a block
+   *
+   * This function takes every spectrum of a block and the single spectrum
+   * \f$data_2\f$ and applies the vector version of this function to them,
+   * including the propagation of the uncertainties. This is the usual way
+   * of applying a common correction, such as a vanadium or a background
+   * spectrum, to all pixels in one call.
+   *
+   * \param input1 (INPUT) is the block of spectra
+   * \param input2 (INPUT) is the spectrum subtracted from every spectrum
+   * of input1
+   * \param input2_err2 (INPUT) is the square of the uncertainty in input2
+   * \param output (OUTPUT) is the result block
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if input1 and output do not
+   * have the same number of spectra and bins, or if input2 and input2_err2
+   * do not have the number of bins of the blocks.
+   */
+  template <typename NumT>
+  std::string
+  sub_ncerr(const Nessi::SpectrumBlock<NumT> & input1,
+            const Nessi::Vector<NumT> & input2,
+            const Nessi::Vector<NumT> & input2_err2,
+            Nessi::SpectrumBlock<NumT> & output,
+            void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.7 applied to every
+   * spectrum of a block with an execution policy
+   *
+   * This function takes every spectrum of a block and the single spectrum
+   * \f$data_2\f$ and applies the vector version of this function to them,
+   * including the propagation of the uncertainties. This is the usual way
+   * of applying a common correction, such as a vanadium or a background
+   * spectrum, to all pixels in one call.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param input1 (INPUT) is the block of spectra
+   * \param input2 (INPUT) is the spectrum subtracted from every spectrum
+   * of input1
+   * \param input2_err2 (INPUT) is the square of the uncertainty in input2
+   * \param output (OUTPUT) is the result block
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if input1 and output do not
+   * have the same number of spectra and bins, or if input2 and input2_err2
+   * do not have the number of bins of the blocks.
+   */
+  template <typename NumT>
+  std::string
+  sub_ncerr(const Nessi::ExecutionPolicy & policy,
+            const Nessi::SpectrumBlock<NumT> & input1,
+            const Nessi::Vector<NumT> & input2,
+            const Nessi::Vector<NumT> & input2_err2,
+            Nessi::SpectrumBlock<NumT> & output,
+            void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.2 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be processed in place. Views with unit stride are passed to the same
+   * kernel as the vector version, while strided views are gathered into
+   * contiguous buffers first.
+   *
+   * \param array_in (INPUT) is a view of the array to be subtracted from
+   * \param array_in_err2 (INPUT) is a view of the square of the uncertainty
+   * in the array to be subtracted from
+   * \param scalar (INPUT) is the scalar to subtract from each element of
+   * array_in
+   * \param scalar_err2 (INPUT) is the square of the uncertainty in the
+   * scalar
+   * \param array_out (OUTPUT) is a view of the result array
+   * \param array_out_err2 (OUTPUT) is a view of the square of the
+   * uncertainty in the result array
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  sub_ncerr(const Nessi::VectorView<const NumT> & array_in,
+            const Nessi::VectorView<const NumT> & array_in_err2,
+            const NumT scalar,
+            const NumT scalar_err2,
+            const Nessi::VectorView<NumT> & array_out,
+            const Nessi::VectorView<NumT> & array_out_err2,
+            void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.44 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be processed in place. Views with unit stride are passed to the same
+   * kernel as the vector version, while strided views are gathered into
+   * contiguous buffers first.
+   *
+   * \param scalar (INPUT) is the scalar to subtract from each element of
+   * array_in
+   * \param scalar_err2 (INPUT) is the square of the uncertainty in the
+   * scalar
+   * \param array_in (INPUT) is a view of the array to be subtracted from
+   * \param array_in_err2 (INPUT) is a view of the square of the uncertainty
+   * in the array to be subtracted from
+   * \param array_out (OUTPUT) is a view of the result array
+   * \param array_out_err2 (OUTPUT) is a view of the square of the
+   * uncertainty in the result array
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  sub_ncerr(const NumT scalar,
+            const NumT scalar_err2,
+            const Nessi::VectorView<const NumT> & array_in,
+            const Nessi::VectorView<const NumT> & array_in_err2,
+            const Nessi::VectorView<NumT> & array_out,
+            const Nessi::VectorView<NumT> & array_out_err2,
+            void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.7 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be processed in place. Views with unit stride are passed to the same
+   * kernel as the vector version, while strided views are gathered into
+   * contiguous buffers first.
+   *
+   * \param input1 (INPUT) is a view of the array to be subtracted from
+   * \param input1_err2 (INPUT) is a view of the square of the uncertainty
+   * in the array to be subtracted from
+   * \param input2 (INPUT) is a view of the array to subtract
+   * \param input2_err2 (INPUT) is a view of the square of the uncertainty
+   * in the array to subtract
+   * \param output (OUTPUT) is a view of the result array
+   * \param output_err2 (OUTPUT) is a view of the square of the uncertainty
+   * in the result array
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  sub_ncerr(const Nessi::VectorView<const NumT> & input1,
+            const Nessi::VectorView<const NumT> & input1_err2,
+            const Nessi::VectorView<const NumT> & input2,
+            const Nessi::VectorView<const NumT> & input2_err2,
+            const Nessi::VectorView<NumT> & output,
+            const Nessi::VectorView<NumT> & output_err2,
+            void *temp=NULL);
+
   /**
    * \}
    */ // end of sub_ncerr group
@@ -1257,6 +2170,103 @@ namespace ArrayManip
              Nessi::Vector<NumT> & output_err2,
              void *temp=NULL);
 
+  /**
+   * \brief This function is described in section 3.10 applied to every
+   * spectrum of a block
+   *
+   * This function adds the spectra of two blocks weighted by their
+   * uncertainties. Spectrum \f$p\f$ of the output is the result of the
+   * vector version of this function for spectrum \f$p\f$ of both inputs.
+   * All spectra are processed in one call and blocks without padding are
+   * processed as a single array.
+   *
+   * \param input1 (INPUT) is the first block to be added
+   * \param input2 (INPUT) is the second block to be added
+   * \param output (OUTPUT) is the result block
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the blocks do not have
+   * the same number of spectra and bins.
+   */
+  template <typename NumT>
+  std::string
+  sumw_ncerr(const Nessi::SpectrumBlock<NumT> & input1,
+             const Nessi::SpectrumBlock<NumT> & input2,
+             Nessi::SpectrumBlock<NumT> & output,
+             void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.10 applied to every
+   * spectrum of a block with an execution policy
+   *
+   * This function adds the spectra of two blocks weighted by their
+   * uncertainties. Spectrum \f$p\f$ of the output is the result of the
+   * vector version of this function for spectrum \f$p\f$ of both inputs.
+   * All spectra are processed in one call and blocks without padding are
+   * processed as a single array.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param input1 (INPUT) is the first block to be added
+   * \param input2 (INPUT) is the second block to be added
+   * \param output (OUTPUT) is the result block
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the blocks do not have
+   * the same number of spectra and bins.
+   */
+  template <typename NumT>
+  std::string
+  sumw_ncerr(const Nessi::ExecutionPolicy & policy,
+             const Nessi::SpectrumBlock<NumT> & input1,
+             const Nessi::SpectrumBlock<NumT> & input2,
+             Nessi::SpectrumBlock<NumT> & output,
+             void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.10 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be processed in place. Views with unit stride are passed to the same
+   * kernel as the vector version, while strided views are gathered into
+   * contiguous buffers first.
+   *
+   * \param input1 (INPUT) is a view of the first array to be added
+   * \param input1_err2 (INPUT) is a view of the square of the uncertainty
+   * in the first array to be added
+   * \param input2 (INPUT) is a view of the second array to be added
+   * \param input2_err2 (INPUT) is a view of the square of the uncertainty
+   * in the second array to be added
+   * \param output (OUTPUT) is a view of the result array
+   * \param output_err2 (OUTPUT) is a view of the square of the uncertainty
+   * in the result array
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  sumw_ncerr(const Nessi::VectorView<const NumT> & input1,
+             const Nessi::VectorView<const NumT> & input1_err2,
+             const Nessi::VectorView<const NumT> & input2,
+             const Nessi::VectorView<const NumT> & input2_err2,
+             const Nessi::VectorView<NumT> & output,
+             const Nessi::VectorView<NumT> & output_err2,
+             void *temp=NULL);
+
   /**
    * \}
    */ // end of sumw_ncerr group
@@ -0,0 +1,446 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file array_manip/inc/ncerr_expr.hpp
+ */
+#ifndef _NCERR_EXPR_HPP
+#define _NCERR_EXPR_HPP 1
+
+#include "nessi.hpp"
+#include "nessi_warn.hpp"
+#include <stdexcept>
+#include <string>
+
+namespace ArrayManip
+{
+  /**
+   * \defgroup ncerr_expr ArrayManip::ncerr_expr
+   * \{
+   *
+   * These classes allow a chain of the uncertainty arithmetic functions to
+   * be written as a single expression, for example
+   *
+   * \code
+   * ArrayManip::evaluate((ArrayManip::ncerr(sample, sample_err2)
+   *                       - ArrayManip::ncerr(background, background_err2))
+   *                      / (ArrayManip::ncerr(vanadium, vanadium_err2)
+   *                         * ArrayManip::ncerr(eff, eff_err2)),
+   *                      output, output_err2);
+   * \endcode
+   *
+   * The operators do not compute anything, they only record the shape of
+   * the expression. ArrayManip::evaluate() then walks over the elements
+   * once and computes the value and the square of the uncertainty of every
+   * element through the whole expression, so no temporary arrays are
+   * created. The uncertainties are propagated with the formulas of
+   * ArrayManip::add_ncerr(), ArrayManip::sub_ncerr(),
+   * ArrayManip::mult_ncerr() and ArrayManip::div_ncerr() in the same
+   * order of operations, so the result is identical to calling those
+   * functions one after another.
+   *
+   * Scalars with an uncertainty enter an expression through the scalar
+   * version of ArrayManip::ncerr(). The arrays of an expression are held
+   * by reference and must outlive the call to ArrayManip::evaluate().
+   */
+
+  /**
+   * \brief Base class of all uncertainty expressions
+   *
+   * This class only exists to restrict the arithmetic operators to the
+   * expression classes. \p ExprT is the derived class and \p NumT the type
+   * of the data.
+   */
+  template <typename ExprT, typename NumT>
+  class NcerrBase
+  {
+  public:
+    /**
+     * \brief Returns the derived expression
+     */
+    const ExprT & expr() const
+    {
+      return static_cast<const ExprT &>(*this);
+    }
+  };
+
+  /**
+   * \brief An array and its squared uncertainty in an expression
+   */
+  template <typename NumT>
+  class NcerrArray : public NcerrBase<NcerrArray<NumT>, NumT>
+  {
+  public:
+    /**
+     * \brief Constructor for an array leaf
+     *
+     * \param value (INPUT) is the array of values
+     * \param err2 (INPUT) is the array of squared uncertainties
+     */
+    NcerrArray(const Nessi::Vector<NumT> & value,
+               const Nessi::Vector<NumT> & err2)
+      : value_(value), err2_(err2)
+    { }
+
+    /**
+     * \brief Checks that the arrays have \p size elements
+     *
+     * \exception std::invalid_argument is thrown if the value or the
+     * uncertainty array has a different size.
+     */
+    void check_size(const std::size_t size) const
+    {
+      if (value_.size() != size)
+        {
+          throw std::invalid_argument("data array not the same size as "
+                                      "output");
+        }
+      if (err2_.size() != size)
+        {
+          throw std::invalid_argument("err2 array not the same size as "
+                                      "output");
+        }
+    }
+
+    /**
+     * \brief Returns the value and squared uncertainty of element \p i
+     */
+    void eval(const std::size_t i, NumT & value, NumT & err2) const
+    {
+      value = value_[i];
+      err2 = err2_[i];
+    }
+
+  private:
+    /// The array of values
+    const Nessi::Vector<NumT> & value_;
+    /// The array of squared uncertainties
+    const Nessi::Vector<NumT> & err2_;
+  };
+
+  /**
+   * \brief A scalar and its squared uncertainty in an expression
+   */
+  template <typename NumT>
+  class NcerrScalar : public NcerrBase<NcerrScalar<NumT>, NumT>
+  {
+  public:
+    /**
+     * \brief Constructor for a scalar leaf
+     *
+     * \param value (INPUT) is the scalar value
+     * \param err2 (INPUT) is the square of the uncertainty in the scalar
+     */
+    NcerrScalar(const NumT value, const NumT err2)
+      : value_(value), err2_(err2)
+    { }
+
+    /**
+     * \brief A scalar matches every size
+     */
+    void check_size(const std::size_t) const
+    { }
+
+    /**
+     * \brief Returns the scalar and its squared uncertainty
+     */
+    void eval(const std::size_t, NumT & value, NumT & err2) const
+    {
+      value = value_;
+      err2 = err2_;
+    }
+
+  private:
+    /// The scalar value
+    NumT value_;
+    /// The square of the uncertainty in the scalar
+    NumT err2_;
+  };
+
+  /**
+   * This is a PRIVATE helper for the sum in an expression. The formulas
+   * are those of ArrayManip::add_ncerr().
+   */
+  struct __NcerrAdd
+  {
+    template <typename NumT>
+    static void apply(const NumT in1, const NumT in1_err2,
+                      const NumT in2, const NumT in2_err2,
+                      NumT & value, NumT & err2)
+    {
+      value = in1 + in2;
+      err2 = in1_err2 + in2_err2;
+    }
+  };
+
+  /**
+   * This is a PRIVATE helper for the difference in an expression. The
+   * formulas are those of ArrayManip::sub_ncerr().
+   */
+  struct __NcerrSub
+  {
+    template <typename NumT>
+    static void apply(const NumT in1, const NumT in1_err2,
+                      const NumT in2, const NumT in2_err2,
+                      NumT & value, NumT & err2)
+    {
+      value = in1 - in2;
+      err2 = in1_err2 + in2_err2;
+    }
+  };
+
+  /**
+   * This is a PRIVATE helper for the product in an expression. The
+   * formulas are those of ArrayManip::mult_ncerr().
+   */
+  struct __NcerrMult
+  {
+    template <typename NumT>
+    static void apply(const NumT in1, const NumT in1_err2,
+                      const NumT in2, const NumT in2_err2,
+                      NumT & value, NumT & err2)
+    {
+      value = in1 * in2;
+      err2 = (in2 * in2 * in1_err2) + (in1 * in1 * in2_err2);
+    }
+  };
+
+  /**
+   * This is a PRIVATE helper for the quotient in an expression. The
+   * formulas are those of ArrayManip::div_ncerr().
+   */
+  struct __NcerrDiv
+  {
+    template <typename NumT>
+    static void apply(const NumT in1, const NumT in1_err2,
+                      const NumT in2, const NumT in2_err2,
+                      NumT & value, NumT & err2)
+    {
+      NumT in2_2 = in2 * in2;
+      value = in1 / in2;
+      err2 = (in1_err2 / in2_2) + (((in1 * in1) / (in2_2 * in2_2))
+                                    * in2_err2);
+    }
+  };
+
+  /**
+   * \brief A binary operation in an expression
+   *
+   * The operands are stored by value. The leaves only hold references to
+   * the arrays, so copying an expression is cheap.
+   */
+  template <typename OpT, typename LeftT, typename RightT, typename NumT>
+  class NcerrBinary
+    : public NcerrBase<NcerrBinary<OpT, LeftT, RightT, NumT>, NumT>
+  {
+  public:
+    /**
+     * \brief Constructor for a binary operation
+     *
+     * \param left (INPUT) is the left operand
+     * \param right (INPUT) is the right operand
+     */
+    NcerrBinary(const LeftT & left, const RightT & right)
+      : left_(left), right_(right)
+    { }
+
+    /**
+     * \brief Checks that every array of the expression has \p size elements
+     */
+    void check_size(const std::size_t size) const
+    {
+      left_.check_size(size);
+      right_.check_size(size);
+    }
+
+    /**
+     * \brief Returns the value and squared uncertainty of element \p i
+     */
+    void eval(const std::size_t i, NumT & value, NumT & err2) const
+    {
+      NumT in1;
+      NumT in1_err2;
+      NumT in2;
+      NumT in2_err2;
+      left_.eval(i, in1, in1_err2);
+      right_.eval(i, in2, in2_err2);
+      OpT::apply(in1, in1_err2, in2, in2_err2, value, err2);
+    }
+
+  private:
+    /// The left operand
+    LeftT left_;
+    /// The right operand
+    RightT right_;
+  };
+
+  /**
+   * \brief This function puts an array with uncertainties into an
+   * expression.
+   *
+   * \param value (INPUT) is the array of values
+   * \param err2 (INPUT) is the array of squared uncertainties
+   *
+   * \return The expression leaf
+   */
+  template <typename NumT>
+  inline NcerrArray<NumT>
+  ncerr(const Nessi::Vector<NumT> & value,
+        const Nessi::Vector<NumT> & err2)
+  {
+    return NcerrArray<NumT>(value, err2);
+  }
+
+  /**
+   * \brief This function puts a scalar with uncertainty into an
+   * expression.
+   *
+   * \param value (INPUT) is the scalar value
+   * \param err2 (INPUT) is the square of the uncertainty in the scalar
+   *
+   * \return The expression leaf
+   */
+  template <typename NumT>
+  inline NcerrScalar<NumT>
+  ncerr(const NumT value, const NumT err2)
+  {
+    return NcerrScalar<NumT>(value, err2);
+  }
+
+  /**
+   * \brief Records the sum of two expressions
+   */
+  template <typename LeftT, typename RightT, typename NumT>
+  inline NcerrBinary<__NcerrAdd, LeftT, RightT, NumT>
+  operator+(const NcerrBase<LeftT, NumT> & left,
+            const NcerrBase<RightT, NumT> & right)
+  {
+    return NcerrBinary<__NcerrAdd, LeftT, RightT, NumT>(left.expr(),
+                                                       right.expr());
+  }
+
+  /**
+   * \brief Records the difference of two expressions
+   */
+  template <typename LeftT, typename RightT, typename NumT>
+  inline NcerrBinary<__NcerrSub, LeftT, RightT, NumT>
+  operator-(const NcerrBase<LeftT, NumT> & left,
+            const NcerrBase<RightT, NumT> & right)
+  {
+    return NcerrBinary<__NcerrSub, LeftT, RightT, NumT>(left.expr(),
+                                                       right.expr());
+  }
+
+  /**
+   * \brief Records the product of two expressions
+   */
+  template <typename LeftT, typename RightT, typename NumT>
+  inline NcerrBinary<__NcerrMult, LeftT, RightT, NumT>
+  operator*(const NcerrBase<LeftT, NumT> & left,
+            const NcerrBase<RightT, NumT> & right)
+  {
+    return NcerrBinary<__NcerrMult, LeftT, RightT, NumT>(left.expr(),
+                                                        right.expr());
+  }
+
+  /**
+   * \brief Records the quotient of two expressions
+   */
+  template <typename LeftT, typename RightT, typename NumT>
+  inline NcerrBinary<__NcerrDiv, LeftT, RightT, NumT>
+  operator/(const NcerrBase<LeftT, NumT> & left,
+            const NcerrBase<RightT, NumT> & right)
+  {
+    return NcerrBinary<__NcerrDiv, LeftT, RightT, NumT>(left.expr(),
+                                                       right.expr());
+  }
+
+  /// String for holding the expression evaluation function name
+  const std::string evaluate_func_str = "ArrayManip::evaluate";
+
+  /**
+   * \brief This function evaluates an uncertainty expression in a single
+   * pass over the data.
+   *
+   * For every element \f$i\f$ the value and the square of the uncertainty
+   * are computed through the whole expression and stored in
+   * \f$output[i]\f$ and \f$\sigma^2_o[i]\f$. All operands of an element are
+   * read before the element is written, so \p output and \p output_err2
+   * may be arrays that appear in the expression.
+   *
+   * \param expression (INPUT) is the expression to evaluate
+   * \param output (OUTPUT) is the array of values
+   * \param output_err2 (OUTPUT) is the array of squared uncertainties
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if an array of the
+   * expression or \p output_err2 does not have the size of \p output.
+   */
+  template <typename ExprT, typename NumT>
+  std::string
+  evaluate(const NcerrBase<ExprT, NumT> & expression,
+           Nessi::Vector<NumT> & output,
+           Nessi::Vector<NumT> & output_err2,
+           void *temp=NULL)
+  {
+    const ExprT & expr = expression.expr();
+    std::size_t size = output.size();
+
+    // check that the arrays are of proper size
+    try
+      {
+        if (output_err2.size() != size)
+          {
+            throw std::invalid_argument("output err2 not the same size as "
+                                        "output");
+          }
+        expr.check_size(size);
+      }
+    catch (std::invalid_argument &e)
+      {
+        throw std::invalid_argument(evaluate_func_str+": "+e.what());
+      }
+
+    NumT value;
+    NumT err2;
+    for (std::size_t i = 0; i < size; ++i)
+      {
+        expr.eval(i, value, err2);
+        output[i] = value;
+        output_err2[i] = err2;
+      }
+
+    return Nessi::EMPTY_WARN;
+  }
+
+  /**
+   * \}
+   */ // end of ncerr_expr group
+} // ArrayManip
+
+#endif // _NCERR_EXPR_HPP
@@ -64,4 +64,36 @@ namespace ArrayManip
                Nessi::Vector<int> & output,
                void *temp);
 
+  /**
+   * This is the float declaration of the function defined in 3.55 for views
+   *
+   * \ingroup abs_val
+   */
+  template std::string
+  abs_val<float>(const Nessi::VectorView<const float> & input,
+                 const Nessi::VectorView<float> & output,
+                 void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.55 for views
+   *
+   * \ingroup abs_val
+   */
+  template std::string
+  abs_val<double>(const Nessi::VectorView<const double> & input,
+                  const Nessi::VectorView<double> & output,
+                  void *temp);
+
+  /**
+   * This is the integer declaration of the function defined in 3.55 for
+   * views
+   *
+   * \ingroup abs_val
+   */
+  template std::string
+  abs_val<int>(const Nessi::VectorView<const int> & input,
+               const Nessi::VectorView<int> & output,
+               void *temp);
+
 } // ArrayManip
@@ -34,6 +34,7 @@
 #include "nessi_warn.hpp"
 #include <algorithm>
 #include <cmath>
+#include <stdexcept>
 
 namespace  ArrayManip
 {
@@ -55,6 +56,29 @@ namespace  ArrayManip
 
     return Nessi::EMPTY_WARN;
   }
+
+  // 3.55
+  template <typename NumT>
+  std::string
+  abs_val(const Nessi::VectorView<const NumT> & input,
+          const Nessi::VectorView<NumT> & output,
+          void *temp=NULL)
+  {
+    // check that the views are of proper size
+    size_t size = input.size();
+    if (output.size() != size)
+      {
+        throw std::invalid_argument(abs_func_str+" (view): views not the "
+                                    +"same size");
+      }
+
+    for (size_t i = 0; i < size; ++i)
+      {
+        output[i] = static_cast<NumT>(std::abs(static_cast<double>(input[i])));
+      }
+
+    return Nessi::EMPTY_WARN;
+  }
 } // ArrayManip
 
 #endif // _ABS_VAL_HPP
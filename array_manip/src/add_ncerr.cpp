@@ -291,6 +291,333 @@ namespace ArrayManip
                           const size_t o_start,
                           const size_t o_span,
                           void *temp);
-  
 
+  /**
+   * This is the float declaration of the function defined in 3.6 for blocks
+   *
+   * \ingroup add_ncerr
+   */
+  template std::string
+  add_ncerr<float>(const Nessi::SpectrumBlock<float> & input1,
+                   const Nessi::SpectrumBlock<float> & input2,
+                   Nessi::SpectrumBlock<float> & output,
+                   void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.6 for blocks
+   * with an execution policy
+   *
+   * \ingroup add_ncerr
+   */
+  template std::string
+  add_ncerr<float>(const Nessi::ExecutionPolicy & policy,
+                   const Nessi::SpectrumBlock<float> & input1,
+                   const Nessi::SpectrumBlock<float> & input2,
+                   Nessi::SpectrumBlock<float> & output,
+                   void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined in
+   * 3.6 for blocks
+   *
+   * \ingroup add_ncerr
+   */
+  template std::string
+  add_ncerr<double>(const Nessi::SpectrumBlock<double> & input1,
+                    const Nessi::SpectrumBlock<double> & input2,
+                    Nessi::SpectrumBlock<double> & output,
+                    void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined in
+   * 3.6 for blocks with an execution policy
+   *
+   * \ingroup add_ncerr
+   */
+  template std::string
+  add_ncerr<double>(const Nessi::ExecutionPolicy & policy,
+                    const Nessi::SpectrumBlock<double> & input1,
+                    const Nessi::SpectrumBlock<double> & input2,
+                    Nessi::SpectrumBlock<double> & output,
+                    void *temp);
+
+  /**
+   * This is the integer declaration of the function defined in 3.6 for blocks
+   *
+   * \ingroup add_ncerr
+   */
+  template std::string
+  add_ncerr<int>(const Nessi::SpectrumBlock<int> & input1,
+                 const Nessi::SpectrumBlock<int> & input2,
+                 Nessi::SpectrumBlock<int> & output,
+                 void *temp);
+
+  /**
+   * This is the integer declaration of the function defined in 3.6 for blocks
+   * with an execution policy
+   *
+   * \ingroup add_ncerr
+   */
+  template std::string
+  add_ncerr<int>(const Nessi::ExecutionPolicy & policy,
+                 const Nessi::SpectrumBlock<int> & input1,
+                 const Nessi::SpectrumBlock<int> & input2,
+                 Nessi::SpectrumBlock<int> & output,
+                 void *temp);
+
+  /**
+   * This is the unsigned integer declaration of the function defined in 3.6
+   * for blocks
+   *
+   * \ingroup add_ncerr
+   */
+  template std::string
+  add_ncerr<unsigned int>(const Nessi::SpectrumBlock<unsigned int> & input1,
+                          const Nessi::SpectrumBlock<unsigned int> & input2,
+                          Nessi::SpectrumBlock<unsigned int> & output,
+                          void *temp);
+
+  /**
+   * This is the unsigned integer declaration of the function defined in 3.6
+   * for blocks with an execution policy
+   *
+   * \ingroup add_ncerr
+   */
+  template std::string
+  add_ncerr<unsigned int>(const Nessi::ExecutionPolicy & policy,
+                          const Nessi::SpectrumBlock<unsigned int> & input1,
+                          const Nessi::SpectrumBlock<unsigned int> & input2,
+                          Nessi::SpectrumBlock<unsigned int> & output,
+                          void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.6 for a block
+   * and a spectrum
+   *
+   * \ingroup add_ncerr
+   */
+  template std::string
+  add_ncerr<float>(const Nessi::SpectrumBlock<float> & input1,
+                   const Nessi::Vector<float> & input2,
+                   const Nessi::Vector<float> & input2_err2,
+                   Nessi::SpectrumBlock<float> & output,
+                   void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.6 for a block
+   * and a spectrum with an execution policy
+   *
+   * \ingroup add_ncerr
+   */
+  template std::string
+  add_ncerr<float>(const Nessi::ExecutionPolicy & policy,
+                   const Nessi::SpectrumBlock<float> & input1,
+                   const Nessi::Vector<float> & input2,
+                   const Nessi::Vector<float> & input2_err2,
+                   Nessi::SpectrumBlock<float> & output,
+                   void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined in
+   * 3.6 for a block and a spectrum
+   *
+   * \ingroup add_ncerr
+   */
+  template std::string
+  add_ncerr<double>(const Nessi::SpectrumBlock<double> & input1,
+                    const Nessi::Vector<double> & input2,
+                    const Nessi::Vector<double> & input2_err2,
+                    Nessi::SpectrumBlock<double> & output,
+                    void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined in
+   * 3.6 for a block and a spectrum with an execution policy
+   *
+   * \ingroup add_ncerr
+   */
+  template std::string
+  add_ncerr<double>(const Nessi::ExecutionPolicy & policy,
+                    const Nessi::SpectrumBlock<double> & input1,
+                    const Nessi::Vector<double> & input2,
+                    const Nessi::Vector<double> & input2_err2,
+                    Nessi::SpectrumBlock<double> & output,
+                    void *temp);
+
+  /**
+   * This is the integer declaration of the function defined in 3.6 for a
+   * block and a spectrum
+   *
+   * \ingroup add_ncerr
+   */
+  template std::string
+  add_ncerr<int>(const Nessi::SpectrumBlock<int> & input1,
+                 const Nessi::Vector<int> & input2,
+                 const Nessi::Vector<int> & input2_err2,
+                 Nessi::SpectrumBlock<int> & output,
+                 void *temp);
+
+  /**
+   * This is the integer declaration of the function defined in 3.6 for a
+   * block and a spectrum with an execution policy
+   *
+   * \ingroup add_ncerr
+   */
+  template std::string
+  add_ncerr<int>(const Nessi::ExecutionPolicy & policy,
+                 const Nessi::SpectrumBlock<int> & input1,
+                 const Nessi::Vector<int> & input2,
+                 const Nessi::Vector<int> & input2_err2,
+                 Nessi::SpectrumBlock<int> & output,
+                 void *temp);
+
+  /**
+   * This is the unsigned integer declaration of the function defined in 3.6
+   * for a block and a spectrum
+   *
+   * \ingroup add_ncerr
+   */
+  template std::string
+  add_ncerr<unsigned int>(const Nessi::SpectrumBlock<unsigned int> & input1,
+                          const Nessi::Vector<unsigned int> & input2,
+                          const Nessi::Vector<unsigned int> & input2_err2,
+                          Nessi::SpectrumBlock<unsigned int> & output,
+                          void *temp);
+
+  /**
+   * This is the unsigned integer declaration of the function defined in 3.6
+   * for a block and a spectrum with an execution policy
+   *
+   * \ingroup add_ncerr
+   */
+  template std::string
+  add_ncerr<unsigned int>(const Nessi::ExecutionPolicy & policy,
+                          const Nessi::SpectrumBlock<unsigned int> & input1,
+                          const Nessi::Vector<unsigned int> & input2,
+                          const Nessi::Vector<unsigned int> & input2_err2,
+                          Nessi::SpectrumBlock<unsigned int> & output,
+                          void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.1 for views
+   *
+   * \ingroup add_ncerr
+   */
+  template std::string
+  add_ncerr<float>(const Nessi::VectorView<const float> & array_in,
+                   const Nessi::VectorView<const float> & array_in_err2,
+                   const float scalar,
+                   const float scalar_err2,
+                   const Nessi::VectorView<float> & array_out,
+                   const Nessi::VectorView<float> & array_out_err2,
+                   void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.1 for views
+   *
+   * \ingroup add_ncerr
+   */
+  template std::string
+  add_ncerr<double>(const Nessi::VectorView<const double> & array_in,
+                    const Nessi::VectorView<const double> & array_in_err2,
+                    const double scalar,
+                    const double scalar_err2,
+                    const Nessi::VectorView<double> & array_out,
+                    const Nessi::VectorView<double> & array_out_err2,
+                    void *temp);
+
+  /**
+   * This is the integer declaration of the function defined in 3.1 for
+   * views
+   *
+   * \ingroup add_ncerr
+   */
+  template std::string
+  add_ncerr<int>(const Nessi::VectorView<const int> & array_in,
+                 const Nessi::VectorView<const int> & array_in_err2,
+                 const int scalar,
+                 const int scalar_err2,
+                 const Nessi::VectorView<int> & array_out,
+                 const Nessi::VectorView<int> & array_out_err2,
+                 void *temp);
+
+  /**
+   * This is the unsigned integer declaration of the function defined in 3.1
+   * for views
+   *
+   * \ingroup add_ncerr
+   */
+  template std::string
+  add_ncerr<unsigned int>(const Nessi::VectorView<const unsigned int> &
+                          array_in,
+                          const Nessi::VectorView<const unsigned int> &
+                          array_in_err2,
+                          const unsigned int scalar,
+                          const unsigned int scalar_err2,
+                          const Nessi::VectorView<unsigned int> & array_out,
+                          const Nessi::VectorView<unsigned int> &
+                          array_out_err2,
+                          void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.6 for views
+   *
+   * \ingroup add_ncerr
+   */
+  template std::string
+  add_ncerr<float>(const Nessi::VectorView<const float> & input1,
+                   const Nessi::VectorView<const float> & input1_err2,
+                   const Nessi::VectorView<const float> & input2,
+                   const Nessi::VectorView<const float> & input2_err2,
+                   const Nessi::VectorView<float> & output,
+                   const Nessi::VectorView<float> & output_err2,
+                   void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.6 for views
+   *
+   * \ingroup add_ncerr
+   */
+  template std::string
+  add_ncerr<double>(const Nessi::VectorView<const double> & input1,
+                    const Nessi::VectorView<const double> & input1_err2,
+                    const Nessi::VectorView<const double> & input2,
+                    const Nessi::VectorView<const double> & input2_err2,
+                    const Nessi::VectorView<double> & output,
+                    const Nessi::VectorView<double> & output_err2,
+                    void *temp);
+
+  /**
+   * This is the integer declaration of the function defined in 3.6 for
+   * views
+   *
+   * \ingroup add_ncerr
+   */
+  template std::string
+  add_ncerr<int>(const Nessi::VectorView<const int> & input1,
+                 const Nessi::VectorView<const int> & input1_err2,
+                 const Nessi::VectorView<const int> & input2,
+                 const Nessi::VectorView<const int> & input2_err2,
+                 const Nessi::VectorView<int> & output,
+                 const Nessi::VectorView<int> & output_err2,
+                 void *temp);
+
+  /**
+   * This is the unsigned integer declaration of the function defined in 3.6
+   * for views
+   *
+   * \ingroup add_ncerr
+   */
+  template std::string
+  add_ncerr<unsigned int>(const Nessi::VectorView<const unsigned int> & input1,
+                          const Nessi::VectorView<const unsigned int> &
+                          input1_err2,
+                          const Nessi::VectorView<const unsigned int> & input2,
+                          const Nessi::VectorView<const unsigned int> &
+                          input2_err2,
+                          const Nessi::VectorView<unsigned int> & output,
+                          const Nessi::VectorView<unsigned int> & output_err2,
+                          void *temp);
 } // ArrayManip
@@ -31,9 +31,9 @@
 #define _MULT_NCERR_HPP 1
 
 #include "arith.hpp"
+#include "ncerr_kernels.hpp"
 #include "nessi_warn.hpp"
 #include "size_checks.hpp"
-#include <algorithm>
 #include <stdexcept>
 
 namespace ArrayManip
@@ -80,14 +80,11 @@ namespace ArrayManip
         throw std::invalid_argument(mult_func_str+" (v,s): input "+e.what());
       }
 
-    NumT scalar2 = scalar * scalar;
-
     size_t size = array_in.size();
-    for (size_t i = 0; i < size; ++i)
+    if (size > 0)
       {
-        array_out[i] = array_in[i] * scalar;
-        array_out_err2[i] = (scalar2 * array_in_err2[i]) +
-          ((array_in[i] * array_in[i]) * scalar_err2);
+        __mult_ncerr_vs(&array_in[0], &array_in_err2[0], scalar, scalar_err2,
+                        &array_out[0], &array_out_err2[0], size);
       }
     return Nessi::EMPTY_WARN;
   }
@@ -132,14 +129,12 @@ namespace ArrayManip
       }
 
 
-    std::transform(input1.begin(), input1.end(), input2.begin(),
-                   output.begin(), std::multiplies<NumT>());
-
-    size_t sz = input1.size();
-    for (size_t i = 0; i < sz; ++i)
+    size_t size = input1.size();
+    if (size > 0)
       {
-        output_err2[i] = (input2[i] * input2[i] * input1_err2[i]) +
-          (input1[i] * input1[i] * input2_err2[i]);
+        __mult_ncerr_vv(&input1[0], &input1_err2[0],
+                        &input2[0], &input2_err2[0],
+                        &output[0], &output_err2[0], size);
       }
 
     return Nessi::EMPTY_WARN;
@@ -163,6 +158,134 @@ namespace ArrayManip
     return Nessi::EMPTY_WARN;
   }
   
+  // 3.8
+  template <typename NumT>
+  std::string
+  mult_ncerr(const Nessi::ExecutionPolicy & policy,
+             const Nessi::SpectrumBlock<NumT> & input1,
+             const Nessi::SpectrumBlock<NumT> & input2,
+             Nessi::SpectrumBlock<NumT> & output,
+             void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!input1.same_shape(input2) || !input1.same_shape(output))
+      {
+        throw std::invalid_argument(mult_func_str+" (b,b): blocks not the "
+                                    +"same shape");
+      }
+
+    __block_ncerr_bb<NumT>(policy, __mult_ncerr_vv, input1, input2,
+                           output);
+
+    return Nessi::EMPTY_WARN;
+  }
+
+  // 3.8
+  template <typename NumT>
+  std::string
+  mult_ncerr(const Nessi::SpectrumBlock<NumT> & input1,
+             const Nessi::SpectrumBlock<NumT> & input2,
+             Nessi::SpectrumBlock<NumT> & output,
+             void *temp=NULL)
+  {
+    return mult_ncerr(Nessi::execution::seq, input1, input2, output, temp);
+  }
+
+  // 3.8
+  template <typename NumT>
+  std::string
+  mult_ncerr(const Nessi::ExecutionPolicy & policy,
+             const Nessi::SpectrumBlock<NumT> & input1,
+             const Nessi::Vector<NumT> & input2,
+             const Nessi::Vector<NumT> & input2_err2,
+             Nessi::SpectrumBlock<NumT> & output,
+             void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!input1.same_shape(output))
+      {
+        throw std::invalid_argument(mult_func_str+" (b,v): blocks not the "
+                                    +"same shape");
+      }
+    // check that the spectrum is of proper size
+    if (input2.size() != output.num_bins()
+        || input2_err2.size() != output.num_bins())
+      {
+        throw std::invalid_argument(mult_func_str+" (b,v): input2 not the "
+                                    +"size of a spectrum");
+      }
+
+    __block_ncerr_bv<NumT>(policy, __mult_ncerr_vv, input1, input2,
+                           input2_err2, output);
+
+    return Nessi::EMPTY_WARN;
+  }
+
+  // 3.8
+  template <typename NumT>
+  std::string
+  mult_ncerr(const Nessi::SpectrumBlock<NumT> & input1,
+             const Nessi::Vector<NumT> & input2,
+             const Nessi::Vector<NumT> & input2_err2,
+             Nessi::SpectrumBlock<NumT> & output,
+             void *temp=NULL)
+  {
+    return mult_ncerr(Nessi::execution::seq, input1, input2, input2_err2,
+                      output, temp);
+  }
+
+  // 3.3
+  template <typename NumT>
+  std::string
+  mult_ncerr(const Nessi::VectorView<const NumT> & array_in,
+             const Nessi::VectorView<const NumT> & array_in_err2,
+             const NumT scalar,
+             const NumT scalar_err2,
+             const Nessi::VectorView<NumT> & array_out,
+             const Nessi::VectorView<NumT> & array_out_err2,
+             void *temp=NULL)
+  {
+    // check that the views are of proper size
+    size_t size = array_in.size();
+    if (array_in_err2.size() != size || array_out.size() != size
+        || array_out_err2.size() != size)
+      {
+        throw std::invalid_argument(mult_func_str+" (view,s): views not the "
+                                    +"same size");
+      }
+
+    __view_ncerr_vs<NumT>(__mult_ncerr_vs, array_in, array_in_err2, scalar,
+                          scalar_err2, array_out, array_out_err2);
+
+    return Nessi::EMPTY_WARN;
+  }
+
+  // 3.8
+  template <typename NumT>
+  std::string
+  mult_ncerr(const Nessi::VectorView<const NumT> & input1,
+             const Nessi::VectorView<const NumT> & input1_err2,
+             const Nessi::VectorView<const NumT> & input2,
+             const Nessi::VectorView<const NumT> & input2_err2,
+             const Nessi::VectorView<NumT> & output,
+             const Nessi::VectorView<NumT> & output_err2,
+             void *temp=NULL)
+  {
+    // check that the views are of proper size
+    size_t size = input1.size();
+    if (input1_err2.size() != size || input2.size() != size
+        || input2_err2.size() != size || output.size() != size
+        || output_err2.size() != size)
+      {
+        throw std::invalid_argument(mult_func_str+" (view,view): views "
+                                    +"not the same size");
+      }
+
+    __view_ncerr_vv<NumT>(__mult_ncerr_vv, input1, input1_err2, input2,
+                          input2_err2, output, output_err2);
+
+    return Nessi::EMPTY_WARN;
+  }
 } // ArrayManip
 
 #endif // _MULT_NCERR_HPP
@@ -0,0 +1,413 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file array_manip/src/ncerr_kernels.cpp
+ */
+#include "ncerr_kernels.hpp"
+#include "nessi_simd.hpp"
+
+#ifdef NESSI_HAVE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace ArrayManip
+{
+#ifdef NESSI_HAVE_X86_SIMD
+
+  // Every instruction set gets its own region. Floating point contraction
+  // is switched off so that a multiply followed by an add is never fused,
+  // which would round differently than the scalar templates.
+
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#pragma GCC optimize("fp-contract=off")
+  namespace __sse2
+  {
+    struct VecF
+    {
+      typedef float value_type;
+      typedef __m128 reg;
+      enum { width = 4 };
+      static inline reg load(const float * p) { return _mm_loadu_ps(p); }
+      static inline void store(float * p, reg a) { _mm_storeu_ps(p, a); }
+      static inline reg set1(const float a) { return _mm_set1_ps(a); }
+      static inline reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+      static inline reg sub(reg a, reg b) { return _mm_sub_ps(a, b); }
+      static inline reg mul(reg a, reg b) { return _mm_mul_ps(a, b); }
+      static inline reg div(reg a, reg b) { return _mm_div_ps(a, b); }
+      static inline reg sqrt(reg a) { return _mm_sqrt_ps(a); }
+    };
+
+    struct VecD
+    {
+      typedef double value_type;
+      typedef __m128d reg;
+      enum { width = 2 };
+      static inline reg load(const double * p) { return _mm_loadu_pd(p); }
+      static inline void store(double * p, reg a) { _mm_storeu_pd(p, a); }
+      static inline reg set1(const double a) { return _mm_set1_pd(a); }
+      static inline reg add(reg a, reg b) { return _mm_add_pd(a, b); }
+      static inline reg sub(reg a, reg b) { return _mm_sub_pd(a, b); }
+      static inline reg mul(reg a, reg b) { return _mm_mul_pd(a, b); }
+      static inline reg div(reg a, reg b) { return _mm_div_pd(a, b); }
+      static inline reg sqrt(reg a) { return _mm_sqrt_pd(a); }
+    };
+
+#include "ncerr_kernels_isa.hpp"
+  } // __sse2
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#pragma GCC optimize("fp-contract=off")
+  namespace __avx2
+  {
+    struct VecF
+    {
+      typedef float value_type;
+      typedef __m256 reg;
+      enum { width = 8 };
+      static inline reg load(const float * p) { return _mm256_loadu_ps(p); }
+      static inline void store(float * p, reg a) { _mm256_storeu_ps(p, a); }
+      static inline reg set1(const float a) { return _mm256_set1_ps(a); }
+      static inline reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+      static inline reg sub(reg a, reg b) { return _mm256_sub_ps(a, b); }
+      static inline reg mul(reg a, reg b) { return _mm256_mul_ps(a, b); }
+      static inline reg div(reg a, reg b) { return _mm256_div_ps(a, b); }
+      static inline reg sqrt(reg a) { return _mm256_sqrt_ps(a); }
+    };
+
+    struct VecD
+    {
+      typedef double value_type;
+      typedef __m256d reg;
+      enum { width = 4 };
+      static inline reg load(const double * p) { return _mm256_loadu_pd(p); }
+      static inline void store(double * p, reg a) { _mm256_storeu_pd(p, a); }
+      static inline reg set1(const double a) { return _mm256_set1_pd(a); }
+      static inline reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+      static inline reg sub(reg a, reg b) { return _mm256_sub_pd(a, b); }
+      static inline reg mul(reg a, reg b) { return _mm256_mul_pd(a, b); }
+      static inline reg div(reg a, reg b) { return _mm256_div_pd(a, b); }
+      static inline reg sqrt(reg a) { return _mm256_sqrt_pd(a); }
+    };
+
+#include "ncerr_kernels_isa.hpp"
+  } // __avx2
+#pragma GCC pop_options
+
+#ifdef NESSI_HAVE_AVX512
+  // The AVX-512 headers of some GCC releases trigger a spurious
+  // uninitialized variable warning in the sqrt intrinsics.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#pragma GCC optimize("fp-contract=off")
+  namespace __avx512
+  {
+    struct VecF
+    {
+      typedef float value_type;
+      typedef __m512 reg;
+      enum { width = 16 };
+      static inline reg load(const float * p) { return _mm512_loadu_ps(p); }
+      static inline void store(float * p, reg a) { _mm512_storeu_ps(p, a); }
+      static inline reg set1(const float a) { return _mm512_set1_ps(a); }
+      static inline reg add(reg a, reg b) { return _mm512_add_ps(a, b); }
+      static inline reg sub(reg a, reg b) { return _mm512_sub_ps(a, b); }
+      static inline reg mul(reg a, reg b) { return _mm512_mul_ps(a, b); }
+      static inline reg div(reg a, reg b) { return _mm512_div_ps(a, b); }
+      static inline reg sqrt(reg a) { return _mm512_sqrt_ps(a); }
+    };
+
+    struct VecD
+    {
+      typedef double value_type;
+      typedef __m512d reg;
+      enum { width = 8 };
+      static inline reg load(const double * p) { return _mm512_loadu_pd(p); }
+      static inline void store(double * p, reg a) { _mm512_storeu_pd(p, a); }
+      static inline reg set1(const double a) { return _mm512_set1_pd(a); }
+      static inline reg add(reg a, reg b) { return _mm512_add_pd(a, b); }
+      static inline reg sub(reg a, reg b) { return _mm512_sub_pd(a, b); }
+      static inline reg mul(reg a, reg b) { return _mm512_mul_pd(a, b); }
+      static inline reg div(reg a, reg b) { return _mm512_div_pd(a, b); }
+      static inline reg sqrt(reg a) { return _mm512_sqrt_pd(a); }
+    };
+
+#include "ncerr_kernels_isa.hpp"
+  } // __avx512
+#pragma GCC pop_options
+#pragma GCC diagnostic pop
+#endif // NESSI_HAVE_AVX512
+
+#endif // NESSI_HAVE_X86_SIMD
+
+  /**
+   * This macro expands to the body of a dispatching kernel. It calls the
+   * version of the kernel compiled for the selected instruction set, or
+   * the scalar template when no vector version is available.
+   */
+#ifdef NESSI_HAVE_AVX512
+#define __NCERR_DISPATCH_AVX512(name, vec, args)        \
+  case Nessi::SIMD_AVX512:                              \
+    __avx512::name<__avx512::vec> args;                 \
+    return;
+#else
+#define __NCERR_DISPATCH_AVX512(name, vec, args)
+#endif
+
+#ifdef NESSI_HAVE_X86_SIMD
+#define __NCERR_DISPATCH(name, scalar_name, NumT, vec, args)    \
+  switch (Nessi::simd_level())                                  \
+    {                                                           \
+      __NCERR_DISPATCH_AVX512(name, vec, args)                  \
+    case Nessi::SIMD_AVX2:                                      \
+      __avx2::name<__avx2::vec> args;                           \
+      return;                                                   \
+    case Nessi::SIMD_SSE2:                                      \
+      __sse2::name<__sse2::vec> args;                           \
+      return;                                                   \
+    default:                                                    \
+      scalar_name<NumT> args;                                   \
+      return;                                                   \
+    }
+#else
+#define __NCERR_DISPATCH(name, scalar_name, NumT, vec, args)    \
+  scalar_name<NumT> args;
+#endif
+
+  /// Arguments of the vector-scalar kernels
+#define __NCERR_VS_ARGS                                                 \
+  (array_in, array_in_err2, scalar, scalar_err2, array_out, array_out_err2, \
+   size)
+  /// Arguments of the scalar-vector kernels
+#define __NCERR_SV_ARGS                                                 \
+  (scalar, scalar_err2, array_in, array_in_err2, array_out, array_out_err2, \
+   size)
+  /// Arguments of the vector-vector kernels
+#define __NCERR_VV_ARGS                                                 \
+  (input1, input1_err2, input2, input2_err2, output, output_err2, size)
+
+  // 3.1
+
+  void __add_ncerr_vs(const float * array_in, const float * array_in_err2,
+                      const float scalar, const float scalar_err2,
+                      float * array_out, float * array_out_err2,
+                      const std::size_t size)
+  {
+    __NCERR_DISPATCH(add_vs, __add_ncerr_vs, float, VecF, __NCERR_VS_ARGS)
+  }
+
+  void __add_ncerr_vs(const double * array_in, const double * array_in_err2,
+                      const double scalar, const double scalar_err2,
+                      double * array_out, double * array_out_err2,
+                      const std::size_t size)
+  {
+    __NCERR_DISPATCH(add_vs, __add_ncerr_vs, double, VecD, __NCERR_VS_ARGS)
+  }
+
+  // 3.6
+
+  void __add_ncerr_vv(const float * input1, const float * input1_err2,
+                      const float * input2, const float * input2_err2,
+                      float * output, float * output_err2,
+                      const std::size_t size)
+  {
+    __NCERR_DISPATCH(add_vv, __add_ncerr_vv, float, VecF, __NCERR_VV_ARGS)
+  }
+
+  void __add_ncerr_vv(const double * input1, const double * input1_err2,
+                      const double * input2, const double * input2_err2,
+                      double * output, double * output_err2,
+                      const std::size_t size)
+  {
+    __NCERR_DISPATCH(add_vv, __add_ncerr_vv, double, VecD, __NCERR_VV_ARGS)
+  }
+
+  // 3.2
+
+  void __sub_ncerr_vs(const float * array_in, const float * array_in_err2,
+                      const float scalar, const float scalar_err2,
+                      float * array_out, float * array_out_err2,
+                      const std::size_t size)
+  {
+    __NCERR_DISPATCH(sub_vs, __sub_ncerr_vs, float, VecF, __NCERR_VS_ARGS)
+  }
+
+  void __sub_ncerr_vs(const double * array_in, const double * array_in_err2,
+                      const double scalar, const double scalar_err2,
+                      double * array_out, double * array_out_err2,
+                      const std::size_t size)
+  {
+    __NCERR_DISPATCH(sub_vs, __sub_ncerr_vs, double, VecD, __NCERR_VS_ARGS)
+  }
+
+  void __sub_ncerr_sv(const float scalar, const float scalar_err2,
+                      const float * array_in, const float * array_in_err2,
+                      float * array_out, float * array_out_err2,
+                      const std::size_t size)
+  {
+    __NCERR_DISPATCH(sub_sv, __sub_ncerr_sv, float, VecF, __NCERR_SV_ARGS)
+  }
+
+  void __sub_ncerr_sv(const double scalar, const double scalar_err2,
+                      const double * array_in, const double * array_in_err2,
+                      double * array_out, double * array_out_err2,
+                      const std::size_t size)
+  {
+    __NCERR_DISPATCH(sub_sv, __sub_ncerr_sv, double, VecD, __NCERR_SV_ARGS)
+  }
+
+  // 3.7
+
+  void __sub_ncerr_vv(const float * input1, const float * input1_err2,
+                      const float * input2, const float * input2_err2,
+                      float * output, float * output_err2,
+                      const std::size_t size)
+  {
+    __NCERR_DISPATCH(sub_vv, __sub_ncerr_vv, float, VecF, __NCERR_VV_ARGS)
+  }
+
+  void __sub_ncerr_vv(const double * input1, const double * input1_err2,
+                      const double * input2, const double * input2_err2,
+                      double * output, double * output_err2,
+                      const std::size_t size)
+  {
+    __NCERR_DISPATCH(sub_vv, __sub_ncerr_vv, double, VecD, __NCERR_VV_ARGS)
+  }
+
+  // 3.3
+
+  void __mult_ncerr_vs(const float * array_in, const float * array_in_err2,
+                       const float scalar, const float scalar_err2,
+                       float * array_out, float * array_out_err2,
+                       const std::size_t size)
+  {
+    __NCERR_DISPATCH(mult_vs, __mult_ncerr_vs, float, VecF, __NCERR_VS_ARGS)
+  }
+
+  void __mult_ncerr_vs(const double * array_in, const double * array_in_err2,
+                       const double scalar, const double scalar_err2,
+                       double * array_out, double * array_out_err2,
+                       const std::size_t size)
+  {
+    __NCERR_DISPATCH(mult_vs, __mult_ncerr_vs, double, VecD, __NCERR_VS_ARGS)
+  }
+
+  // 3.8
+
+  void __mult_ncerr_vv(const float * input1, const float * input1_err2,
+                       const float * input2, const float * input2_err2,
+                       float * output, float * output_err2,
+                       const std::size_t size)
+  {
+    __NCERR_DISPATCH(mult_vv, __mult_ncerr_vv, float, VecF, __NCERR_VV_ARGS)
+  }
+
+  void __mult_ncerr_vv(const double * input1, const double * input1_err2,
+                       const double * input2, const double * input2_err2,
+                       double * output, double * output_err2,
+                       const std::size_t size)
+  {
+    __NCERR_DISPATCH(mult_vv, __mult_ncerr_vv, double, VecD, __NCERR_VV_ARGS)
+  }
+
+  // 3.4
+
+  void __div_ncerr_sv(const float scalar, const float scalar_err2,
+                      const float * array_in, const float * array_in_err2,
+                      float * array_out, float * array_out_err2,
+                      const std::size_t size)
+  {
+    __NCERR_DISPATCH(div_sv, __div_ncerr_sv, float, VecF, __NCERR_SV_ARGS)
+  }
+
+  void __div_ncerr_sv(const double scalar, const double scalar_err2,
+                      const double * array_in, const double * array_in_err2,
+                      double * array_out, double * array_out_err2,
+                      const std::size_t size)
+  {
+    __NCERR_DISPATCH(div_sv, __div_ncerr_sv, double, VecD, __NCERR_SV_ARGS)
+  }
+
+  // 3.5
+
+  void __div_ncerr_vs(const float * array_in, const float * array_in_err2,
+                      const float scalar, const float scalar_err2,
+                      float * array_out, float * array_out_err2,
+                      const std::size_t size)
+  {
+    __NCERR_DISPATCH(div_vs, __div_ncerr_vs, float, VecF, __NCERR_VS_ARGS)
+  }
+
+  void __div_ncerr_vs(const double * array_in, const double * array_in_err2,
+                      const double scalar, const double scalar_err2,
+                      double * array_out, double * array_out_err2,
+                      const std::size_t size)
+  {
+    __NCERR_DISPATCH(div_vs, __div_ncerr_vs, double, VecD, __NCERR_VS_ARGS)
+  }
+
+  // 3.9
+
+  void __div_ncerr_vv(const float * input1, const float * input1_err2,
+                      const float * input2, const float * input2_err2,
+                      float * output, float * output_err2,
+                      const std::size_t size)
+  {
+    __NCERR_DISPATCH(div_vv, __div_ncerr_vv, float, VecF, __NCERR_VV_ARGS)
+  }
+
+  void __div_ncerr_vv(const double * input1, const double * input1_err2,
+                      const double * input2, const double * input2_err2,
+                      double * output, double * output_err2,
+                      const std::size_t size)
+  {
+    __NCERR_DISPATCH(div_vv, __div_ncerr_vv, double, VecD, __NCERR_VV_ARGS)
+  }
+
+  // 3.10
+
+  void __sumw_ncerr_vv(const float * input1, const float * input1_err2,
+                       const float * input2, const float * input2_err2,
+                       float * output, float * output_err2,
+                       const std::size_t size)
+  {
+    __NCERR_DISPATCH(sumw_vv, __sumw_ncerr_vv, float, VecF, __NCERR_VV_ARGS)
+  }
+
+  void __sumw_ncerr_vv(const double * input1, const double * input1_err2,
+                       const double * input2, const double * input2_err2,
+                       double * output, double * output_err2,
+                       const std::size_t size)
+  {
+    __NCERR_DISPATCH(sumw_vv, __sumw_ncerr_vv, double, VecD, __NCERR_VV_ARGS)
+  }
+} // ArrayManip
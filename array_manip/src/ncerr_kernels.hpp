@@ -0,0 +1,617 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file array_manip/src/ncerr_kernels.hpp
+ */
+#ifndef _NCERR_KERNELS_HPP
+#define _NCERR_KERNELS_HPP 1
+
+#include "nessi_block.hpp"
+#include "nessi_exec.hpp"
+#include "nessi_view.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+/**
+ * \defgroup ncerr_kernels ArrayManip ncerr kernels
+ * \{
+ *
+ * These are PRIVATE single pass loops shared by the vector overloads of
+ * the *_ncerr functions. Each loop computes the value and the square of
+ * the uncertainty of an element together, so the data is streamed through
+ * memory only once. The templates are the reference implementation and
+ * are used for the integer types. The float and double overloads are
+ * defined in ncerr_kernels.cpp and select an SSE2, AVX2 or AVX-512
+ * version at runtime (see Nessi::simd_level()). The vector versions
+ * perform the operations in the same order as the templates, so the
+ * results are identical whichever instruction set is used. All inputs of
+ * an element are read before its outputs are written, so the output may
+ * be the same array as one of the inputs.
+ */
+
+namespace ArrayManip
+{
+  // 3.1
+  template <typename NumT>
+  void __add_ncerr_vs(const NumT * array_in, const NumT * array_in_err2,
+                      const NumT scalar, const NumT scalar_err2,
+                      NumT * array_out, NumT * array_out_err2,
+                      const std::size_t size)
+  {
+    for (std::size_t i = 0; i < size; ++i)
+      {
+        array_out[i] = array_in[i] + scalar;
+        array_out_err2[i] = array_in_err2[i] + scalar_err2;
+      }
+  }
+
+  // 3.6
+  template <typename NumT>
+  void __add_ncerr_vv(const NumT * input1, const NumT * input1_err2,
+                      const NumT * input2, const NumT * input2_err2,
+                      NumT * output, NumT * output_err2,
+                      const std::size_t size)
+  {
+    for (std::size_t i = 0; i < size; ++i)
+      {
+        output[i] = input1[i] + input2[i];
+        output_err2[i] = input1_err2[i] + input2_err2[i];
+      }
+  }
+
+  // 3.2
+  template <typename NumT>
+  void __sub_ncerr_vs(const NumT * array_in, const NumT * array_in_err2,
+                      const NumT scalar, const NumT scalar_err2,
+                      NumT * array_out, NumT * array_out_err2,
+                      const std::size_t size)
+  {
+    for (std::size_t i = 0; i < size; ++i)
+      {
+        array_out[i] = array_in[i] - scalar;
+        array_out_err2[i] = array_in_err2[i] + scalar_err2;
+      }
+  }
+
+  // 3.44
+  template <typename NumT>
+  void __sub_ncerr_sv(const NumT scalar, const NumT scalar_err2,
+                      const NumT * array_in, const NumT * array_in_err2,
+                      NumT * array_out, NumT * array_out_err2,
+                      const std::size_t size)
+  {
+    for (std::size_t i = 0; i < size; ++i)
+      {
+        array_out[i] = scalar - array_in[i];
+        array_out_err2[i] = array_in_err2[i] + scalar_err2;
+      }
+  }
+
+  // 3.7
+  template <typename NumT>
+  void __sub_ncerr_vv(const NumT * input1, const NumT * input1_err2,
+                      const NumT * input2, const NumT * input2_err2,
+                      NumT * output, NumT * output_err2,
+                      const std::size_t size)
+  {
+    for (std::size_t i = 0; i < size; ++i)
+      {
+        output[i] = input1[i] - input2[i];
+        output_err2[i] = input1_err2[i] + input2_err2[i];
+      }
+  }
+
+  // 3.3
+  template <typename NumT>
+  void __mult_ncerr_vs(const NumT * array_in, const NumT * array_in_err2,
+                       const NumT scalar, const NumT scalar_err2,
+                       NumT * array_out, NumT * array_out_err2,
+                       const std::size_t size)
+  {
+    NumT scalar2 = scalar * scalar;
+
+    for (std::size_t i = 0; i < size; ++i)
+      {
+        NumT in = array_in[i];
+        array_out[i] = in * scalar;
+        array_out_err2[i] = (scalar2 * array_in_err2[i]) +
+          ((in * in) * scalar_err2);
+      }
+  }
+
+  // 3.8
+  template <typename NumT>
+  void __mult_ncerr_vv(const NumT * input1, const NumT * input1_err2,
+                       const NumT * input2, const NumT * input2_err2,
+                       NumT * output, NumT * output_err2,
+                       const std::size_t size)
+  {
+    for (std::size_t i = 0; i < size; ++i)
+      {
+        NumT in1 = input1[i];
+        NumT in2 = input2[i];
+        output[i] = in1 * in2;
+        output_err2[i] = (in2 * in2 * input1_err2[i]) +
+          (in1 * in1 * input2_err2[i]);
+      }
+  }
+
+  // 3.4
+  template <typename NumT>
+  void __div_ncerr_sv(const NumT scalar, const NumT scalar_err2,
+                      const NumT * array_in, const NumT * array_in_err2,
+                      NumT * array_out, NumT * array_out_err2,
+                      const std::size_t size)
+  {
+    NumT scalar2 = scalar * scalar;
+
+    for (std::size_t i = 0; i < size; ++i)
+      {
+        NumT in = array_in[i];
+        NumT array_in2 = in * in;
+        array_out[i] = scalar / in;
+        array_out_err2[i] =
+          ((scalar2 / (array_in2 * array_in2)) * array_in_err2[i])
+          + (scalar_err2 / array_in2);
+      }
+  }
+
+  // 3.5
+  template <typename NumT>
+  void __div_ncerr_vs(const NumT * array_in, const NumT * array_in_err2,
+                      const NumT scalar, const NumT scalar_err2,
+                      NumT * array_out, NumT * array_out_err2,
+                      const std::size_t size)
+  {
+    NumT scalar2 = scalar * scalar;
+    NumT scalar4 = scalar2 * scalar2;
+
+    for (std::size_t i = 0; i < size; ++i)
+      {
+        NumT in = array_in[i];
+        array_out[i] = in / scalar;
+        array_out_err2[i] = (array_in_err2[i] / scalar2)
+          + (((in * in)/ scalar4) * scalar_err2);
+      }
+  }
+
+  // 3.9
+  template <typename NumT>
+  void __div_ncerr_vv(const NumT * input1, const NumT * input1_err2,
+                      const NumT * input2, const NumT * input2_err2,
+                      NumT * output, NumT * output_err2,
+                      const std::size_t size)
+  {
+    for (std::size_t i = 0; i < size; ++i)
+      {
+        NumT in1 = input1[i];
+        NumT in2 = input2[i];
+        NumT input2_2 = in2 * in2;
+        output[i] = in1 / in2;
+        output_err2[i] = (input1_err2[i] / input2_2) +
+          (((in1 * in1) / (input2_2 * input2_2)) * input2_err2[i]);
+      }
+  }
+
+  // 3.10
+  template <typename NumT>
+  void __sumw_ncerr_vv(const NumT * input1, const NumT * input1_err2,
+                       const NumT * input2, const NumT * input2_err2,
+                       NumT * output, NumT * output_err2,
+                       const std::size_t size)
+  {
+    for (std::size_t i = 0; i < size; ++i)
+      {
+        // calculate the value
+        NumT in1_err2 = input1_err2[i];
+        NumT in2_err2 = input2_err2[i];
+        NumT input1_err =
+          static_cast<NumT>(std::sqrt(static_cast<double>(in1_err2)));
+        NumT input2_err =
+          static_cast<NumT>(std::sqrt(static_cast<double>(in2_err2)));
+        NumT sum_err = input1_err + input2_err;
+        NumT value = (input1[i] / input1_err) + (input2[i] / input2_err);
+        output[i] = value * (sum_err / static_cast<NumT>(2.));
+
+        // calculate the uncertainty
+        output_err2[i]=(in1_err2*input2_err+in2_err2*input1_err)
+          *(input1_err+input2_err);
+      }
+  }
+
+  // float and double versions using the vector instruction sets
+
+  void __add_ncerr_vs(const float *, const float *, const float, const float,
+                      float *, float *, const std::size_t);
+  void __add_ncerr_vs(const double *, const double *, const double,
+                      const double, double *, double *, const std::size_t);
+  void __add_ncerr_vv(const float *, const float *, const float *,
+                      const float *, float *, float *, const std::size_t);
+  void __add_ncerr_vv(const double *, const double *, const double *,
+                      const double *, double *, double *, const std::size_t);
+
+  void __sub_ncerr_vs(const float *, const float *, const float, const float,
+                      float *, float *, const std::size_t);
+  void __sub_ncerr_vs(const double *, const double *, const double,
+                      const double, double *, double *, const std::size_t);
+  void __sub_ncerr_sv(const float, const float, const float *, const float *,
+                      float *, float *, const std::size_t);
+  void __sub_ncerr_sv(const double, const double, const double *,
+                      const double *, double *, double *, const std::size_t);
+  void __sub_ncerr_vv(const float *, const float *, const float *,
+                      const float *, float *, float *, const std::size_t);
+  void __sub_ncerr_vv(const double *, const double *, const double *,
+                      const double *, double *, double *, const std::size_t);
+
+  void __mult_ncerr_vs(const float *, const float *, const float,
+                       const float, float *, float *, const std::size_t);
+  void __mult_ncerr_vs(const double *, const double *, const double,
+                       const double, double *, double *, const std::size_t);
+  void __mult_ncerr_vv(const float *, const float *, const float *,
+                       const float *, float *, float *, const std::size_t);
+  void __mult_ncerr_vv(const double *, const double *, const double *,
+                       const double *, double *, double *, const std::size_t);
+
+  void __div_ncerr_sv(const float, const float, const float *, const float *,
+                      float *, float *, const std::size_t);
+  void __div_ncerr_sv(const double, const double, const double *,
+                      const double *, double *, double *, const std::size_t);
+  void __div_ncerr_vs(const float *, const float *, const float, const float,
+                      float *, float *, const std::size_t);
+  void __div_ncerr_vs(const double *, const double *, const double,
+                      const double, double *, double *, const std::size_t);
+  void __div_ncerr_vv(const float *, const float *, const float *,
+                      const float *, float *, float *, const std::size_t);
+  void __div_ncerr_vv(const double *, const double *, const double *,
+                      const double *, double *, double *, const std::size_t);
+
+  void __sumw_ncerr_vv(const float *, const float *, const float *,
+                       const float *, float *, float *, const std::size_t);
+  void __sumw_ncerr_vv(const double *, const double *, const double *,
+                       const double *, double *, double *, const std::size_t);
+
+  /**
+   * This is a PRIVATE function object applying a vector-vector kernel to
+   * a range of spectra of two blocks. When no block is padded the range is
+   * processed with a single call of the kernel.
+   */
+  template <typename NumT>
+  class __BlockNcerrBB
+  {
+  public:
+    /// Type of the vector-vector kernels
+    typedef void (*Kernel)(const NumT *, const NumT *, const NumT *,
+                           const NumT *, NumT *, NumT *, const std::size_t);
+
+    /// Constructor keeping the kernel and the blocks
+    __BlockNcerrBB(Kernel kernel,
+                   const Nessi::SpectrumBlock<NumT> & input1,
+                   const Nessi::SpectrumBlock<NumT> & input2,
+                   Nessi::SpectrumBlock<NumT> & output)
+      : kernel_(kernel), input1_(input1), input2_(input2), output_(output)
+    { }
+
+    /// Processes the spectra [begin, end)
+    void operator()(const std::size_t, const std::size_t begin,
+                    const std::size_t end) const
+    {
+      std::size_t num_bins = output_.num_bins();
+      if (input1_.is_contiguous() && input2_.is_contiguous()
+          && output_.is_contiguous())
+        {
+          kernel_(input1_.value(begin), input1_.err2(begin),
+                  input2_.value(begin), input2_.err2(begin),
+                  output_.value(begin), output_.err2(begin),
+                  (end - begin) * num_bins);
+          return;
+        }
+
+      for (std::size_t i = begin; i < end; ++i)
+        {
+          kernel_(input1_.value(i), input1_.err2(i),
+                  input2_.value(i), input2_.err2(i),
+                  output_.value(i), output_.err2(i), num_bins);
+        }
+    }
+
+  private:
+    /// The kernel applied to the spectra
+    Kernel kernel_;
+    /// The first block
+    const Nessi::SpectrumBlock<NumT> & input1_;
+    /// The second block
+    const Nessi::SpectrumBlock<NumT> & input2_;
+    /// The result block
+    Nessi::SpectrumBlock<NumT> & output_;
+  };
+
+  /**
+   * This is a PRIVATE function object applying a vector-vector kernel to
+   * a range of spectra of a block and a single spectrum.
+   */
+  template <typename NumT>
+  class __BlockNcerrBV
+  {
+  public:
+    /// Type of the vector-vector kernels
+    typedef void (*Kernel)(const NumT *, const NumT *, const NumT *,
+                           const NumT *, NumT *, NumT *, const std::size_t);
+
+    /// Constructor keeping the kernel, the block and the spectrum
+    __BlockNcerrBV(Kernel kernel,
+                   const Nessi::SpectrumBlock<NumT> & input1,
+                   const Nessi::Vector<NumT> & input2,
+                   const Nessi::Vector<NumT> & input2_err2,
+                   Nessi::SpectrumBlock<NumT> & output)
+      : kernel_(kernel), input1_(input1), input2_(input2),
+        input2_err2_(input2_err2), output_(output)
+    { }
+
+    /// Processes the spectra [begin, end)
+    void operator()(const std::size_t, const std::size_t begin,
+                    const std::size_t end) const
+    {
+      std::size_t num_bins = output_.num_bins();
+      for (std::size_t i = begin; i < end; ++i)
+        {
+          kernel_(input1_.value(i), input1_.err2(i),
+                  &input2_[0], &input2_err2_[0],
+                  output_.value(i), output_.err2(i), num_bins);
+        }
+    }
+
+  private:
+    /// The kernel applied to the spectra
+    Kernel kernel_;
+    /// The block
+    const Nessi::SpectrumBlock<NumT> & input1_;
+    /// The spectrum combined with every spectrum of the block
+    const Nessi::Vector<NumT> & input2_;
+    /// The square of the uncertainty of the spectrum
+    const Nessi::Vector<NumT> & input2_err2_;
+    /// The result block
+    Nessi::SpectrumBlock<NumT> & output_;
+  };
+
+  /**
+   * This is a PRIVATE helper applying a vector-vector kernel to every
+   * spectrum of two blocks with the given execution policy. Blocks without
+   * padding are processed with one call of the kernel per chunk. The
+   * shapes must have been checked.
+   */
+  template <typename NumT>
+  void __block_ncerr_bb(const Nessi::ExecutionPolicy & policy,
+                        void (*kernel)(const NumT *, const NumT *,
+                                       const NumT *, const NumT *,
+                                       NumT *, NumT *, const std::size_t),
+                        const Nessi::SpectrumBlock<NumT> & input1,
+                        const Nessi::SpectrumBlock<NumT> & input2,
+                        Nessi::SpectrumBlock<NumT> & output)
+  {
+    if (output.num_spectra() == 0 || output.num_bins() == 0)
+      {
+        return;
+      }
+
+    Nessi::for_each_chunk(policy, output.num_spectra(),
+                          __BlockNcerrBB<NumT>(kernel, input1, input2,
+                                               output));
+  }
+
+  /**
+   * This is a PRIVATE helper applying a vector-vector kernel to every
+   * spectrum of a block and a single spectrum with the given execution
+   * policy. The sizes must have been checked.
+   */
+  template <typename NumT>
+  void __block_ncerr_bv(const Nessi::ExecutionPolicy & policy,
+                        void (*kernel)(const NumT *, const NumT *,
+                                       const NumT *, const NumT *,
+                                       NumT *, NumT *, const std::size_t),
+                        const Nessi::SpectrumBlock<NumT> & input1,
+                        const Nessi::Vector<NumT> & input2,
+                        const Nessi::Vector<NumT> & input2_err2,
+                        Nessi::SpectrumBlock<NumT> & output)
+  {
+    if (output.num_spectra() == 0 || output.num_bins() == 0)
+      {
+        return;
+      }
+
+    Nessi::for_each_chunk(policy, output.num_spectra(),
+                          __BlockNcerrBV<NumT>(kernel, input1, input2,
+                                               input2_err2, output));
+  }
+
+  /// Number of elements of strided views gathered at a time
+  const std::size_t __VIEW_CHUNK = 256;
+
+  /**
+   * This is a PRIVATE helper applying a vector-vector kernel to views.
+   * Views with unit stride are passed to the kernel directly. Otherwise
+   * the inputs are gathered into contiguous buffers a chunk at a time and
+   * the results are scattered back, so every view is processed by the
+   * same kernel. The sizes must have been checked.
+   */
+  template <typename NumT>
+  void __view_ncerr_vv(void (*kernel)(const NumT *, const NumT *,
+                                      const NumT *, const NumT *,
+                                      NumT *, NumT *, const std::size_t),
+                       const Nessi::VectorView<const NumT> & input1,
+                       const Nessi::VectorView<const NumT> & input1_err2,
+                       const Nessi::VectorView<const NumT> & input2,
+                       const Nessi::VectorView<const NumT> & input2_err2,
+                       const Nessi::VectorView<NumT> & output,
+                       const Nessi::VectorView<NumT> & output_err2)
+  {
+    std::size_t size = output.size();
+    if (size == 0)
+      {
+        return;
+      }
+
+    if (input1.is_contiguous() && input1_err2.is_contiguous()
+        && input2.is_contiguous() && input2_err2.is_contiguous()
+        && output.is_contiguous() && output_err2.is_contiguous())
+      {
+        kernel(input1.data(), input1_err2.data(), input2.data(),
+               input2_err2.data(), output.data(), output_err2.data(), size);
+        return;
+      }
+
+    NumT in1[__VIEW_CHUNK];
+    NumT in1_err2[__VIEW_CHUNK];
+    NumT in2[__VIEW_CHUNK];
+    NumT in2_err2[__VIEW_CHUNK];
+    NumT out[__VIEW_CHUNK];
+    NumT out_err2[__VIEW_CHUNK];
+    for (std::size_t start = 0; start < size; start += __VIEW_CHUNK)
+      {
+        std::size_t num = std::min(__VIEW_CHUNK, size - start);
+        for (std::size_t i = 0; i < num; ++i)
+          {
+            in1[i] = input1[start + i];
+            in1_err2[i] = input1_err2[start + i];
+            in2[i] = input2[start + i];
+            in2_err2[i] = input2_err2[start + i];
+          }
+        kernel(in1, in1_err2, in2, in2_err2, out, out_err2, num);
+        for (std::size_t i = 0; i < num; ++i)
+          {
+            output[start + i] = out[i];
+            output_err2[start + i] = out_err2[i];
+          }
+      }
+  }
+
+  /**
+   * This is a PRIVATE helper applying a vector-scalar kernel to views in
+   * the same way as __view_ncerr_vv(). The sizes must have been checked.
+   */
+  template <typename NumT>
+  void __view_ncerr_vs(void (*kernel)(const NumT *, const NumT *,
+                                      const NumT, const NumT,
+                                      NumT *, NumT *, const std::size_t),
+                       const Nessi::VectorView<const NumT> & array_in,
+                       const Nessi::VectorView<const NumT> & array_in_err2,
+                       const NumT scalar,
+                       const NumT scalar_err2,
+                       const Nessi::VectorView<NumT> & array_out,
+                       const Nessi::VectorView<NumT> & array_out_err2)
+  {
+    std::size_t size = array_out.size();
+    if (size == 0)
+      {
+        return;
+      }
+
+    if (array_in.is_contiguous() && array_in_err2.is_contiguous()
+        && array_out.is_contiguous() && array_out_err2.is_contiguous())
+      {
+        kernel(array_in.data(), array_in_err2.data(), scalar, scalar_err2,
+               array_out.data(), array_out_err2.data(), size);
+        return;
+      }
+
+    NumT in[__VIEW_CHUNK];
+    NumT in_err2[__VIEW_CHUNK];
+    NumT out[__VIEW_CHUNK];
+    NumT out_err2[__VIEW_CHUNK];
+    for (std::size_t start = 0; start < size; start += __VIEW_CHUNK)
+      {
+        std::size_t num = std::min(__VIEW_CHUNK, size - start);
+        for (std::size_t i = 0; i < num; ++i)
+          {
+            in[i] = array_in[start + i];
+            in_err2[i] = array_in_err2[start + i];
+          }
+        kernel(in, in_err2, scalar, scalar_err2, out, out_err2, num);
+        for (std::size_t i = 0; i < num; ++i)
+          {
+            array_out[start + i] = out[i];
+            array_out_err2[start + i] = out_err2[i];
+          }
+      }
+  }
+
+  /**
+   * This is a PRIVATE helper applying a scalar-vector kernel to views in
+   * the same way as __view_ncerr_vv(). The sizes must have been checked.
+   */
+  template <typename NumT>
+  void __view_ncerr_sv(void (*kernel)(const NumT, const NumT,
+                                      const NumT *, const NumT *,
+                                      NumT *, NumT *, const std::size_t),
+                       const NumT scalar,
+                       const NumT scalar_err2,
+                       const Nessi::VectorView<const NumT> & array_in,
+                       const Nessi::VectorView<const NumT> & array_in_err2,
+                       const Nessi::VectorView<NumT> & array_out,
+                       const Nessi::VectorView<NumT> & array_out_err2)
+  {
+    std::size_t size = array_out.size();
+    if (size == 0)
+      {
+        return;
+      }
+
+    if (array_in.is_contiguous() && array_in_err2.is_contiguous()
+        && array_out.is_contiguous() && array_out_err2.is_contiguous())
+      {
+        kernel(scalar, scalar_err2, array_in.data(), array_in_err2.data(),
+               array_out.data(), array_out_err2.data(), size);
+        return;
+      }
+
+    NumT in[__VIEW_CHUNK];
+    NumT in_err2[__VIEW_CHUNK];
+    NumT out[__VIEW_CHUNK];
+    NumT out_err2[__VIEW_CHUNK];
+    for (std::size_t start = 0; start < size; start += __VIEW_CHUNK)
+      {
+        std::size_t num = std::min(__VIEW_CHUNK, size - start);
+        for (std::size_t i = 0; i < num; ++i)
+          {
+            in[i] = array_in[start + i];
+            in_err2[i] = array_in_err2[start + i];
+          }
+        kernel(scalar, scalar_err2, in, in_err2, out, out_err2, num);
+        for (std::size_t i = 0; i < num; ++i)
+          {
+            array_out[start + i] = out[i];
+            array_out_err2[start + i] = out_err2[i];
+          }
+      }
+  }
+} // ArrayManip
+
+/**
+ * \}
+ */ // end of ncerr_kernels group
+
+#endif // _NCERR_KERNELS_HPP
@@ -0,0 +1,358 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file array_manip/src/ncerr_kernels_isa.hpp
+ *
+ * This file contains the bodies of the vectorized ncerr kernels. It has no
+ * include guard on purpose: ncerr_kernels.cpp includes it once per
+ * instruction set, inside a namespace that defines the register traits
+ * VecF (float) and VecD (double) and inside a region compiled for that
+ * instruction set. Each trait provides the register type, the number of
+ * elements per register (width) and the load, store, set1, add, sub, mul,
+ * div and sqrt operations. The remainder that does not fill a register is
+ * handed to the scalar templates in ncerr_kernels.hpp.
+ */
+
+// 3.1
+template <typename V>
+void add_vs(const typename V::value_type * array_in,
+            const typename V::value_type * array_in_err2,
+            const typename V::value_type scalar,
+            const typename V::value_type scalar_err2,
+            typename V::value_type * array_out,
+            typename V::value_type * array_out_err2,
+            const std::size_t size)
+{
+  typedef typename V::value_type NumT;
+  typedef typename V::reg reg;
+  const reg s = V::set1(scalar);
+  const reg s_err2 = V::set1(scalar_err2);
+
+  std::size_t i = 0;
+  for ( ; i + V::width <= size; i += V::width)
+    {
+      V::store(array_out + i, V::add(V::load(array_in + i), s));
+      V::store(array_out_err2 + i, V::add(V::load(array_in_err2 + i),
+                                          s_err2));
+    }
+  ArrayManip::__add_ncerr_vs<NumT>(array_in + i, array_in_err2 + i,
+                                   scalar, scalar_err2,
+                                   array_out + i, array_out_err2 + i,
+                                   size - i);
+}
+
+// 3.6
+template <typename V>
+void add_vv(const typename V::value_type * input1,
+            const typename V::value_type * input1_err2,
+            const typename V::value_type * input2,
+            const typename V::value_type * input2_err2,
+            typename V::value_type * output,
+            typename V::value_type * output_err2,
+            const std::size_t size)
+{
+  typedef typename V::value_type NumT;
+  std::size_t i = 0;
+  for ( ; i + V::width <= size; i += V::width)
+    {
+      V::store(output + i, V::add(V::load(input1 + i), V::load(input2 + i)));
+      V::store(output_err2 + i, V::add(V::load(input1_err2 + i),
+                                       V::load(input2_err2 + i)));
+    }
+  ArrayManip::__add_ncerr_vv<NumT>(input1 + i, input1_err2 + i,
+                                   input2 + i, input2_err2 + i,
+                                   output + i, output_err2 + i, size - i);
+}
+
+// 3.2
+template <typename V>
+void sub_vs(const typename V::value_type * array_in,
+            const typename V::value_type * array_in_err2,
+            const typename V::value_type scalar,
+            const typename V::value_type scalar_err2,
+            typename V::value_type * array_out,
+            typename V::value_type * array_out_err2,
+            const std::size_t size)
+{
+  typedef typename V::value_type NumT;
+  typedef typename V::reg reg;
+  const reg s = V::set1(scalar);
+  const reg s_err2 = V::set1(scalar_err2);
+
+  std::size_t i = 0;
+  for ( ; i + V::width <= size; i += V::width)
+    {
+      V::store(array_out + i, V::sub(V::load(array_in + i), s));
+      V::store(array_out_err2 + i, V::add(V::load(array_in_err2 + i),
+                                          s_err2));
+    }
+  ArrayManip::__sub_ncerr_vs<NumT>(array_in + i, array_in_err2 + i,
+                                   scalar, scalar_err2,
+                                   array_out + i, array_out_err2 + i,
+                                   size - i);
+}
+
+// 3.44
+template <typename V>
+void sub_sv(const typename V::value_type scalar,
+            const typename V::value_type scalar_err2,
+            const typename V::value_type * array_in,
+            const typename V::value_type * array_in_err2,
+            typename V::value_type * array_out,
+            typename V::value_type * array_out_err2,
+            const std::size_t size)
+{
+  typedef typename V::value_type NumT;
+  typedef typename V::reg reg;
+  const reg s = V::set1(scalar);
+  const reg s_err2 = V::set1(scalar_err2);
+
+  std::size_t i = 0;
+  for ( ; i + V::width <= size; i += V::width)
+    {
+      V::store(array_out + i, V::sub(s, V::load(array_in + i)));
+      V::store(array_out_err2 + i, V::add(V::load(array_in_err2 + i),
+                                          s_err2));
+    }
+  ArrayManip::__sub_ncerr_sv<NumT>(scalar, scalar_err2,
+                                   array_in + i, array_in_err2 + i,
+                                   array_out + i, array_out_err2 + i,
+                                   size - i);
+}
+
+// 3.7
+template <typename V>
+void sub_vv(const typename V::value_type * input1,
+            const typename V::value_type * input1_err2,
+            const typename V::value_type * input2,
+            const typename V::value_type * input2_err2,
+            typename V::value_type * output,
+            typename V::value_type * output_err2,
+            const std::size_t size)
+{
+  typedef typename V::value_type NumT;
+  std::size_t i = 0;
+  for ( ; i + V::width <= size; i += V::width)
+    {
+      V::store(output + i, V::sub(V::load(input1 + i), V::load(input2 + i)));
+      V::store(output_err2 + i, V::add(V::load(input1_err2 + i),
+                                       V::load(input2_err2 + i)));
+    }
+  ArrayManip::__sub_ncerr_vv<NumT>(input1 + i, input1_err2 + i,
+                                   input2 + i, input2_err2 + i,
+                                   output + i, output_err2 + i, size - i);
+}
+
+// 3.3
+template <typename V>
+void mult_vs(const typename V::value_type * array_in,
+             const typename V::value_type * array_in_err2,
+             const typename V::value_type scalar,
+             const typename V::value_type scalar_err2,
+             typename V::value_type * array_out,
+             typename V::value_type * array_out_err2,
+             const std::size_t size)
+{
+  typedef typename V::value_type NumT;
+  typedef typename V::reg reg;
+  const reg s = V::set1(scalar);
+  const reg s2 = V::set1(scalar * scalar);
+  const reg s_err2 = V::set1(scalar_err2);
+
+  std::size_t i = 0;
+  for ( ; i + V::width <= size; i += V::width)
+    {
+      reg in = V::load(array_in + i);
+      V::store(array_out + i, V::mul(in, s));
+      V::store(array_out_err2 + i,
+               V::add(V::mul(s2, V::load(array_in_err2 + i)),
+                      V::mul(V::mul(in, in), s_err2)));
+    }
+  ArrayManip::__mult_ncerr_vs<NumT>(array_in + i, array_in_err2 + i,
+                                    scalar, scalar_err2,
+                                    array_out + i, array_out_err2 + i,
+                                    size - i);
+}
+
+// 3.8
+template <typename V>
+void mult_vv(const typename V::value_type * input1,
+             const typename V::value_type * input1_err2,
+             const typename V::value_type * input2,
+             const typename V::value_type * input2_err2,
+             typename V::value_type * output,
+             typename V::value_type * output_err2,
+             const std::size_t size)
+{
+  typedef typename V::value_type NumT;
+  typedef typename V::reg reg;
+
+  std::size_t i = 0;
+  for ( ; i + V::width <= size; i += V::width)
+    {
+      reg in1 = V::load(input1 + i);
+      reg in2 = V::load(input2 + i);
+      V::store(output + i, V::mul(in1, in2));
+      V::store(output_err2 + i,
+               V::add(V::mul(V::mul(in2, in2), V::load(input1_err2 + i)),
+                      V::mul(V::mul(in1, in1), V::load(input2_err2 + i))));
+    }
+  ArrayManip::__mult_ncerr_vv<NumT>(input1 + i, input1_err2 + i,
+                                    input2 + i, input2_err2 + i,
+                                    output + i, output_err2 + i, size - i);
+}
+
+// 3.4
+template <typename V>
+void div_sv(const typename V::value_type scalar,
+            const typename V::value_type scalar_err2,
+            const typename V::value_type * array_in,
+            const typename V::value_type * array_in_err2,
+            typename V::value_type * array_out,
+            typename V::value_type * array_out_err2,
+            const std::size_t size)
+{
+  typedef typename V::value_type NumT;
+  typedef typename V::reg reg;
+  const reg s = V::set1(scalar);
+  const reg s2 = V::set1(scalar * scalar);
+  const reg s_err2 = V::set1(scalar_err2);
+
+  std::size_t i = 0;
+  for ( ; i + V::width <= size; i += V::width)
+    {
+      reg in = V::load(array_in + i);
+      reg in2 = V::mul(in, in);
+      V::store(array_out + i, V::div(s, in));
+      V::store(array_out_err2 + i,
+               V::add(V::mul(V::div(s2, V::mul(in2, in2)),
+                             V::load(array_in_err2 + i)),
+                      V::div(s_err2, in2)));
+    }
+  ArrayManip::__div_ncerr_sv<NumT>(scalar, scalar_err2,
+                                   array_in + i, array_in_err2 + i,
+                                   array_out + i, array_out_err2 + i,
+                                   size - i);
+}
+
+// 3.5
+template <typename V>
+void div_vs(const typename V::value_type * array_in,
+            const typename V::value_type * array_in_err2,
+            const typename V::value_type scalar,
+            const typename V::value_type scalar_err2,
+            typename V::value_type * array_out,
+            typename V::value_type * array_out_err2,
+            const std::size_t size)
+{
+  typedef typename V::value_type NumT;
+  typedef typename V::reg reg;
+  const NumT scalar2 = scalar * scalar;
+  const reg s = V::set1(scalar);
+  const reg s2 = V::set1(scalar2);
+  const reg s4 = V::set1(scalar2 * scalar2);
+  const reg s_err2 = V::set1(scalar_err2);
+
+  std::size_t i = 0;
+  for ( ; i + V::width <= size; i += V::width)
+    {
+      reg in = V::load(array_in + i);
+      V::store(array_out + i, V::div(in, s));
+      V::store(array_out_err2 + i,
+               V::add(V::div(V::load(array_in_err2 + i), s2),
+                      V::mul(V::div(V::mul(in, in), s4), s_err2)));
+    }
+  ArrayManip::__div_ncerr_vs<NumT>(array_in + i, array_in_err2 + i,
+                                   scalar, scalar_err2,
+                                   array_out + i, array_out_err2 + i,
+                                   size - i);
+}
+
+// 3.9
+template <typename V>
+void div_vv(const typename V::value_type * input1,
+            const typename V::value_type * input1_err2,
+            const typename V::value_type * input2,
+            const typename V::value_type * input2_err2,
+            typename V::value_type * output,
+            typename V::value_type * output_err2,
+            const std::size_t size)
+{
+  typedef typename V::value_type NumT;
+  typedef typename V::reg reg;
+
+  std::size_t i = 0;
+  for ( ; i + V::width <= size; i += V::width)
+    {
+      reg in1 = V::load(input1 + i);
+      reg in2 = V::load(input2 + i);
+      reg in2_2 = V::mul(in2, in2);
+      V::store(output + i, V::div(in1, in2));
+      V::store(output_err2 + i,
+               V::add(V::div(V::load(input1_err2 + i), in2_2),
+                      V::mul(V::div(V::mul(in1, in1), V::mul(in2_2, in2_2)),
+                             V::load(input2_err2 + i))));
+    }
+  ArrayManip::__div_ncerr_vv<NumT>(input1 + i, input1_err2 + i,
+                                   input2 + i, input2_err2 + i,
+                                   output + i, output_err2 + i, size - i);
+}
+
+// 3.10
+template <typename V>
+void sumw_vv(const typename V::value_type * input1,
+             const typename V::value_type * input1_err2,
+             const typename V::value_type * input2,
+             const typename V::value_type * input2_err2,
+             typename V::value_type * output,
+             typename V::value_type * output_err2,
+             const std::size_t size)
+{
+  typedef typename V::value_type NumT;
+  typedef typename V::reg reg;
+  const reg two = V::set1(static_cast<NumT>(2.));
+
+  std::size_t i = 0;
+  for ( ; i + V::width <= size; i += V::width)
+    {
+      reg in1_err2 = V::load(input1_err2 + i);
+      reg in2_err2 = V::load(input2_err2 + i);
+      reg in1_err = V::sqrt(in1_err2);
+      reg in2_err = V::sqrt(in2_err2);
+      reg sum_err = V::add(in1_err, in2_err);
+      reg value = V::add(V::div(V::load(input1 + i), in1_err),
+                         V::div(V::load(input2 + i), in2_err));
+      V::store(output + i, V::mul(value, V::div(sum_err, two)));
+      V::store(output_err2 + i,
+               V::mul(V::add(V::mul(in1_err2, in2_err),
+                             V::mul(in2_err2, in1_err)),
+                      V::add(in1_err, in2_err)));
+    }
+  ArrayManip::__sumw_ncerr_vv<NumT>(input1 + i, input1_err2 + i,
+                                    input2 + i, input2_err2 + i,
+                                    output + i, output_err2 + i, size - i);
+}
@@ -90,4 +90,166 @@ namespace ArrayManip
                            Nessi::Vector<unsigned int> & output,
                            Nessi::Vector<unsigned int> & output_err2,
                            void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.10 for blocks
+   *
+   * \ingroup sumw_ncerr
+   */
+  template std::string
+  sumw_ncerr<float>(const Nessi::SpectrumBlock<float> & input1,
+                    const Nessi::SpectrumBlock<float> & input2,
+                    Nessi::SpectrumBlock<float> & output,
+                    void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.10 for blocks
+   * with an execution policy
+   *
+   * \ingroup sumw_ncerr
+   */
+  template std::string
+  sumw_ncerr<float>(const Nessi::ExecutionPolicy & policy,
+                    const Nessi::SpectrumBlock<float> & input1,
+                    const Nessi::SpectrumBlock<float> & input2,
+                    Nessi::SpectrumBlock<float> & output,
+                    void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined in
+   * 3.10 for blocks
+   *
+   * \ingroup sumw_ncerr
+   */
+  template std::string
+  sumw_ncerr<double>(const Nessi::SpectrumBlock<double> & input1,
+                     const Nessi::SpectrumBlock<double> & input2,
+                     Nessi::SpectrumBlock<double> & output,
+                     void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined in
+   * 3.10 for blocks with an execution policy
+   *
+   * \ingroup sumw_ncerr
+   */
+  template std::string
+  sumw_ncerr<double>(const Nessi::ExecutionPolicy & policy,
+                     const Nessi::SpectrumBlock<double> & input1,
+                     const Nessi::SpectrumBlock<double> & input2,
+                     Nessi::SpectrumBlock<double> & output,
+                     void *temp);
+
+  /**
+   * This is the integer declaration of the function defined in 3.10 for
+   * blocks
+   *
+   * \ingroup sumw_ncerr
+   */
+  template std::string
+  sumw_ncerr<int>(const Nessi::SpectrumBlock<int> & input1,
+                  const Nessi::SpectrumBlock<int> & input2,
+                  Nessi::SpectrumBlock<int> & output,
+                  void *temp);
+
+  /**
+   * This is the integer declaration of the function defined in 3.10 for
+   * blocks with an execution policy
+   *
+   * \ingroup sumw_ncerr
+   */
+  template std::string
+  sumw_ncerr<int>(const Nessi::ExecutionPolicy & policy,
+                  const Nessi::SpectrumBlock<int> & input1,
+                  const Nessi::SpectrumBlock<int> & input2,
+                  Nessi::SpectrumBlock<int> & output,
+                  void *temp);
+
+  /**
+   * This is the unsigned integer declaration of the function defined in 3.10
+   * for blocks
+   *
+   * \ingroup sumw_ncerr
+   */
+  template std::string
+  sumw_ncerr<unsigned int>(const Nessi::SpectrumBlock<unsigned int> & input1,
+                           const Nessi::SpectrumBlock<unsigned int> & input2,
+                           Nessi::SpectrumBlock<unsigned int> & output,
+                           void *temp);
+
+  /**
+   * This is the unsigned integer declaration of the function defined in 3.10
+   * for blocks with an execution policy
+   *
+   * \ingroup sumw_ncerr
+   */
+  template std::string
+  sumw_ncerr<unsigned int>(const Nessi::ExecutionPolicy & policy,
+                           const Nessi::SpectrumBlock<unsigned int> & input1,
+                           const Nessi::SpectrumBlock<unsigned int> & input2,
+                           Nessi::SpectrumBlock<unsigned int> & output,
+                           void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.10 for views
+   *
+   * \ingroup sumw_ncerr
+   */
+  template std::string
+  sumw_ncerr<float>(const Nessi::VectorView<const float> & input1,
+                    const Nessi::VectorView<const float> & input1_err2,
+                    const Nessi::VectorView<const float> & input2,
+                    const Nessi::VectorView<const float> & input2_err2,
+                    const Nessi::VectorView<float> & output,
+                    const Nessi::VectorView<float> & output_err2,
+                    void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.10 for views
+   *
+   * \ingroup sumw_ncerr
+   */
+  template std::string
+  sumw_ncerr<double>(const Nessi::VectorView<const double> & input1,
+                     const Nessi::VectorView<const double> & input1_err2,
+                     const Nessi::VectorView<const double> & input2,
+                     const Nessi::VectorView<const double> & input2_err2,
+                     const Nessi::VectorView<double> & output,
+                     const Nessi::VectorView<double> & output_err2,
+                     void *temp);
+
+  /**
+   * This is the integer declaration of the function defined in 3.10 for
+   * views
+   *
+   * \ingroup sumw_ncerr
+   */
+  template std::string
+  sumw_ncerr<int>(const Nessi::VectorView<const int> & input1,
+                  const Nessi::VectorView<const int> & input1_err2,
+                  const Nessi::VectorView<const int> & input2,
+                  const Nessi::VectorView<const int> & input2_err2,
+                  const Nessi::VectorView<int> & output,
+                  const Nessi::VectorView<int> & output_err2,
+                  void *temp);
+
+  /**
+   * This is the unsigned integer declaration of the function defined in
+   * 3.10 for views
+   *
+   * \ingroup sumw_ncerr
+   */
+  template std::string
+  sumw_ncerr<unsigned int>(const Nessi::VectorView<const unsigned int> &
+                           input1,
+                           const Nessi::VectorView<const unsigned int> &
+                           input1_err2,
+                           const Nessi::VectorView<const unsigned int> &
+                           input2,
+                           const Nessi::VectorView<const unsigned int> &
+                           input2_err2,
+                           const Nessi::VectorView<unsigned int> & output,
+                           const Nessi::VectorView<unsigned int> & output_err2,
+                           void *temp);
 } // ArrayManip
@@ -31,9 +31,9 @@
 #define _SUMW_NCERR_HPP 1
 
 #include "arith.hpp"
+#include "ncerr_kernels.hpp"
 #include "nessi_warn.hpp"
 #include "size_checks.hpp"
-#include <cmath>
 #include <stdexcept>
 
 namespace ArrayManip
@@ -81,23 +81,74 @@ namespace ArrayManip
       }
 
 
-    size_t sz = input1.size();
-    for (size_t i = 0; i < sz; ++i)
+    size_t size = input1.size();
+    if (size > 0)
       {
-        // calculate the value
-        NumT input1_err =
-          static_cast<NumT>(std::sqrt(static_cast<double>(input1_err2[i])));
-        NumT input2_err =
-          static_cast<NumT>(std::sqrt(static_cast<double>(input2_err2[i])));
-        NumT sum_err = input1_err + input2_err;
-        output[i] = (input1[i] / input1_err) + (input2[i] / input2_err);
-        output[i] *= sum_err / static_cast<NumT>(2.);
+        __sumw_ncerr_vv(&input1[0], &input1_err2[0],
+                        &input2[0], &input2_err2[0],
+                        &output[0], &output_err2[0], size);
+      }
+
+    return Nessi::EMPTY_WARN;
+  }
+
+  // 3.10
+  template <typename NumT>
+  std::string
+  sumw_ncerr(const Nessi::ExecutionPolicy & policy,
+             const Nessi::SpectrumBlock<NumT> & input1,
+             const Nessi::SpectrumBlock<NumT> & input2,
+             Nessi::SpectrumBlock<NumT> & output,
+             void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!input1.same_shape(input2) || !input1.same_shape(output))
+      {
+        throw std::invalid_argument(sumw_func_str+" (b,b): blocks not the "
+                                    +"same shape");
+      }
+
+    __block_ncerr_bb<NumT>(policy, __sumw_ncerr_vv, input1, input2,
+                           output);
+
+    return Nessi::EMPTY_WARN;
+  }
+
+  // 3.10
+  template <typename NumT>
+  std::string
+  sumw_ncerr(const Nessi::SpectrumBlock<NumT> & input1,
+             const Nessi::SpectrumBlock<NumT> & input2,
+             Nessi::SpectrumBlock<NumT> & output,
+             void *temp=NULL)
+  {
+    return sumw_ncerr(Nessi::execution::seq, input1, input2, output, temp);
+  }
 
-        // calculate the uncertainty
-        output_err2[i]=(input1_err2[i]*input2_err+input2_err2[i]*input1_err)
-          *(input1_err+input2_err);
+  // 3.10
+  template <typename NumT>
+  std::string
+  sumw_ncerr(const Nessi::VectorView<const NumT> & input1,
+             const Nessi::VectorView<const NumT> & input1_err2,
+             const Nessi::VectorView<const NumT> & input2,
+             const Nessi::VectorView<const NumT> & input2_err2,
+             const Nessi::VectorView<NumT> & output,
+             const Nessi::VectorView<NumT> & output_err2,
+             void *temp=NULL)
+  {
+    // check that the views are of proper size
+    size_t size = input1.size();
+    if (input1_err2.size() != size || input2.size() != size
+        || input2_err2.size() != size || output.size() != size
+        || output_err2.size() != size)
+      {
+        throw std::invalid_argument(sumw_func_str+" (view,view): views "
+                                    +"not the same size");
       }
 
+    __view_ncerr_vv<NumT>(__sumw_ncerr_vv, input1, input1_err2, input2,
+                          input2_err2, output, output_err2);
+
     return Nessi::EMPTY_WARN;
   }
 } // ArrayManip
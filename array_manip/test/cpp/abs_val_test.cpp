@@ -132,6 +132,20 @@ bool test_func(NumT key, string debug){ // key forces correct test to happen
   // run the code being tested
   ArrayManip::abs_val(input, output);
 
+  // the view version on every other element gives the vector result
+  Nessi::Vector<NumT> output_view(2 * NUM_VAL);
+  ArrayManip::abs_val(Nessi::VectorView<const NumT>(input),
+                      Nessi::VectorView<NumT>(output_view, 1, NUM_VAL, 2));
+  for (int i = 0; i < NUM_VAL; ++i)
+    {
+      if (output_view[2 * i + 1] != output[i])
+        {
+          cout << "(" << type_string(output) << ") FAILED....View output "
+               << "different from vector output" << endl;
+          return false;
+        }
+    }
+
   if(!debug.empty())
     {
       cout << endl;
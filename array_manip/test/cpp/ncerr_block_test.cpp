@@ -0,0 +1,362 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file array_manip/test/cpp/ncerr_block_test.cpp
+ */
+
+#include "arith.hpp"
+#include "test_common.hpp"
+#include <stdexcept>
+
+using namespace std;
+
+/// Number of spectra in the blocks
+const size_t NUM_SPECTRA = 5;
+/// Number of bins in every spectrum
+const size_t NUM_BINS = 7;
+/// Stride of the padded blocks
+const size_t STRIDE = 9;
+
+/**
+ * \defgroup ncerr_block_test ncerr_block_test
+ * \{
+ *
+ * This test runs the block versions of <i>add_ncerr</i>, <i>sub_ncerr</i>,
+ * <i>mult_ncerr</i>, <i>div_ncerr</i> and <i>sumw_ncerr</i> on contiguous
+ * and on padded blocks and compares every spectrum of the result with
+ * the vector version of the function applied to that spectrum. The
+ * parallel execution policy must give the same blocks as the sequential
+ * one for any number of threads.
+ *
+ * <b>Notations used:</b>
+ * - VV = "v,v"
+ * - SV = "s,v"
+ * - VS = "v,s"
+ * - ERROR = "error "
+ */
+
+/**
+ * This function fills every spectrum of a block.
+ *
+ * \param offset (INPUT) is added to every value
+ * \param block (OUTPUT) is the block to fill
+ */
+template <typename NumT>
+void initialize_block(const int offset, Nessi::SpectrumBlock<NumT> & block)
+{
+  Nessi::Vector<NumT> value(NUM_BINS);
+  Nessi::Vector<NumT> err2(NUM_BINS);
+  for (size_t p = 0; p < block.num_spectra(); ++p)
+    {
+      for (size_t i = 0; i < NUM_BINS; ++i)
+        {
+          value[i] = static_cast<NumT>(offset + 3 * p + 2 * i + 1);
+          err2[i] = static_cast<NumT>(p + i + 1);
+        }
+      block.set_spectrum(p, value, err2);
+    }
+}
+
+/**
+ * This function runs the vector version of a function on spectrum \p p of
+ * the inputs.
+ *
+ * \param func (INPUT) selects the function
+ * \param input1 (INPUT) is the first block
+ * \param input2 (INPUT) is the second block
+ * \param p (INPUT) is the spectrum
+ * \param output (OUTPUT) is the result
+ * \param output_err2 (OUTPUT) is the square of the uncertainty in the result
+ */
+template <typename NumT>
+void run_vector(const int func,
+                const Nessi::SpectrumBlock<NumT> & input1,
+                const Nessi::SpectrumBlock<NumT> & input2,
+                const size_t p,
+                Nessi::Vector<NumT> & output,
+                Nessi::Vector<NumT> & output_err2)
+{
+  Nessi::Vector<NumT> in1(NUM_BINS);
+  Nessi::Vector<NumT> in1_err2(NUM_BINS);
+  Nessi::Vector<NumT> in2(NUM_BINS);
+  Nessi::Vector<NumT> in2_err2(NUM_BINS);
+  input1.get_spectrum(p, in1, in1_err2);
+  // the (b,v) versions use the first spectrum of input2 for every pixel
+  input2.get_spectrum(func % 2 ? 0 : p, in2, in2_err2);
+
+  switch (func / 2)
+    {
+    case 0:
+      ArrayManip::add_ncerr(in1, in1_err2, in2, in2_err2, output,
+                            output_err2);
+      break;
+    case 1:
+      ArrayManip::sub_ncerr(in1, in1_err2, in2, in2_err2, output,
+                            output_err2);
+      break;
+    case 2:
+      ArrayManip::mult_ncerr(in1, in1_err2, in2, in2_err2, output,
+                             output_err2);
+      break;
+    case 3:
+      ArrayManip::div_ncerr(in1, in1_err2, in2, in2_err2, output,
+                            output_err2);
+      break;
+    case 4:
+      ArrayManip::sumw_ncerr(in1, in1_err2, in2, in2_err2, output,
+                             output_err2);
+      break;
+    }
+}
+
+/**
+ * This function runs the block version of a function.
+ *
+ * \param policy (INPUT) is the execution policy
+ * \param func (INPUT) selects the function, odd values select the (b,v)
+ * version
+ * \param input1 (INPUT) is the first block
+ * \param input2 (INPUT) is the second block
+ * \param output (OUTPUT) is the result block
+ */
+template <typename NumT>
+void run_block(const Nessi::ExecutionPolicy & policy,
+               const int func,
+               const Nessi::SpectrumBlock<NumT> & input1,
+               const Nessi::SpectrumBlock<NumT> & input2,
+               Nessi::SpectrumBlock<NumT> & output)
+{
+  Nessi::Vector<NumT> in2(NUM_BINS);
+  Nessi::Vector<NumT> in2_err2(NUM_BINS);
+  input2.get_spectrum(0, in2, in2_err2);
+
+  switch (func)
+    {
+    case 0:
+      ArrayManip::add_ncerr(policy, input1, input2, output);
+      break;
+    case 1:
+      ArrayManip::add_ncerr(policy, input1, in2, in2_err2, output);
+      break;
+    case 2:
+      ArrayManip::sub_ncerr(policy, input1, input2, output);
+      break;
+    case 3:
+      ArrayManip::sub_ncerr(policy, input1, in2, in2_err2, output);
+      break;
+    case 4:
+      ArrayManip::mult_ncerr(policy, input1, input2, output);
+      break;
+    case 5:
+      ArrayManip::mult_ncerr(policy, input1, in2, in2_err2, output);
+      break;
+    case 6:
+      ArrayManip::div_ncerr(policy, input1, input2, output);
+      break;
+    case 7:
+      ArrayManip::div_ncerr(policy, input1, in2, in2_err2, output);
+      break;
+    case 8:
+      ArrayManip::sumw_ncerr(policy, input1, input2, output);
+      break;
+    }
+}
+
+/**
+ * Function that compares the blocks with the vector version of every
+ * function for one layout of the blocks.
+ *
+ * \param stride1 (INPUT) is the stride of the first input
+ * \param stride2 (INPUT) is the stride of the second input
+ * \param stride_out (INPUT) is the stride of the output
+ * \param debug (INPUT) is any string that launches the debug mode
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_layout(const size_t stride1, const size_t stride2,
+                 const size_t stride_out, string debug)
+{
+  Nessi::SpectrumBlock<NumT> input1(NUM_SPECTRA, NUM_BINS, stride1);
+  Nessi::SpectrumBlock<NumT> input2(NUM_SPECTRA, NUM_BINS, stride2);
+  initialize_block(20, input1);
+  initialize_block(1, input2);
+
+  Nessi::Vector<NumT> true_output(NUM_BINS);
+  Nessi::Vector<NumT> true_output_err2(NUM_BINS);
+  Nessi::Vector<NumT> output(NUM_BINS);
+  Nessi::Vector<NumT> output_err2(NUM_BINS);
+
+  for (int func = 0; func < 9; ++func)
+    {
+      Nessi::SpectrumBlock<NumT> block_out(NUM_SPECTRA, NUM_BINS,
+                                           stride_out);
+      run_block(Nessi::execution::seq, func, input1, input2, block_out);
+
+      // the parallel policy gives the same result for any number of threads
+      for (int num_threads = 1; num_threads <= 3; ++num_threads)
+        {
+          Nessi::set_num_threads(num_threads);
+          Nessi::SpectrumBlock<NumT> par_out(NUM_SPECTRA, NUM_BINS,
+                                             stride_out);
+          run_block(Nessi::execution::par, func, input1, input2, par_out);
+          if (par_out.value() != block_out.value()
+              || par_out.err2() != block_out.err2())
+            {
+              cout << "(" << type_string(output) << " function " << func
+                   << ", " << num_threads << " threads) FAILED....Parallel "
+                   << "output different from sequential" << endl;
+              return false;
+            }
+        }
+      Nessi::set_num_threads(0);
+
+      for (size_t p = 0; p < NUM_SPECTRA; ++p)
+        {
+          run_vector(func, input1, input2, p, true_output,
+                     true_output_err2);
+          block_out.get_spectrum(p, output, output_err2);
+
+          if (!debug.empty())
+            {
+              print(output, true_output, VV, debug);
+              print(output_err2, true_output_err2, ERROR + VV, debug);
+            }
+
+          if (!Utils::vector_is_equals(output, true_output)
+              || !Utils::vector_is_equals(output_err2, true_output_err2))
+            {
+              cout << "(" << type_string(output) << " function " << func
+                   << ", spectrum " << p << ") FAILED....Output different "
+                   << "from vector expected" << endl;
+              return false;
+            }
+        }
+
+      // the padding of the output is left alone
+      for (size_t p = 0; p < NUM_SPECTRA; ++p)
+        {
+          for (size_t i = NUM_BINS; i < stride_out; ++i)
+            {
+              if (block_out.value(p)[i] != 0 || block_out.err2(p)[i] != 0)
+                {
+                  cout << "(" << type_string(output) << " function " << func
+                       << ") FAILED....Padding overwritten" << endl;
+                  return false;
+                }
+            }
+        }
+    }
+
+  return true;
+}
+
+/**
+ * Function that runs the tests for contiguous and padded blocks and checks
+ * that blocks of different shapes are rejected.
+ *
+ * \param key (INPUT) key that permits to launch the correct test
+ * \param debug (INPUT) is any string that launches the debug mode (print all
+ * the array created and calculated)
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_func(NumT key, string debug)
+{
+  if (!test_layout<NumT>(NUM_BINS, NUM_BINS, NUM_BINS, debug)
+      || !test_layout<NumT>(STRIDE, NUM_BINS, STRIDE, debug))
+    {
+      return false;
+    }
+
+  Nessi::SpectrumBlock<NumT> input(NUM_SPECTRA, NUM_BINS);
+  Nessi::SpectrumBlock<NumT> wrong(NUM_SPECTRA + 1, NUM_BINS);
+  try
+    {
+      ArrayManip::add_ncerr(input, input, wrong);
+      cout << "(" << type_string(input.value()) << ") FAILED....No "
+           << "exception thrown" << endl;
+      return false;
+    }
+  catch (std::invalid_argument &)
+    {
+    }
+
+  return true;
+}
+
+/**
+ * Main function that tests the block versions of the arithmetic functions
+ * for float, double, int and unsigned int.
+ *
+ * \param argc The number of command-line arguments present
+ * \param argv The list of command-line arguments
+ */
+int main(int argc, char *argv[])
+{
+  cout << "ncerr_block_test.cpp..........";
+
+  string debug;
+  if (argc >1)
+    {
+      debug = argv[1];
+    }
+
+  int value = 0;
+
+  if(!test_func(static_cast<float>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(!test_func(static_cast<double>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(!test_func(static_cast<int>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(!test_func(static_cast<unsigned int>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(value == 0)
+    {
+      cout << "Functionality OK" << endl;
+    }
+
+  return value;
+}
+
+/**
+ * \}
+ */   //end of ncerr_block_test group
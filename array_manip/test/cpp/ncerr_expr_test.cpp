@@ -0,0 +1,249 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file array_manip/test/cpp/ncerr_expr_test.cpp
+ */
+
+#include "arith.hpp"
+#include "ncerr_expr.hpp"
+#include "test_common.hpp"
+#include <stdexcept>
+
+using namespace std;
+
+/// Number of elements in the arrays
+const int NUM_VAL = 13;
+
+/**
+ * \defgroup ncerr_expr_test ncerr_expr_test
+ * \{
+ *
+ * This test evaluates the correction
+ * \f$(sample - background) / (vanadium * efficiency) + offset\f$
+ * once as a single expression with ArrayManip::evaluate() and once with
+ * a sequence of calls to the *_ncerr functions. Both results must be
+ * identical. It also checks that an expression may write into one of its
+ * own arrays and that arrays of the wrong size are rejected.
+ *
+ * <b>Notations used:</b>
+ * - VV = "v,v"
+ * - SV = "s,v"
+ * - VS = "v,s"
+ * - ERROR = "error "
+ */
+
+/**
+ * This function fills an array and its squared uncertainty.
+ *
+ * \param offset (INPUT) is the value of the first element
+ * \param step (INPUT) is the difference between two elements
+ * \param value (OUTPUT) is the array of values
+ * \param err2 (OUTPUT) is the array of squared uncertainties
+ */
+template <typename NumT>
+void initialize_input(const double offset, const double step,
+                      Nessi::Vector<NumT> & value,
+                      Nessi::Vector<NumT> & err2)
+{
+  for (int i = 0; i < NUM_VAL; ++i)
+    {
+      value.push_back(static_cast<NumT>(offset + step * i));
+      err2.push_back(static_cast<NumT>(0.5 * offset + 0.03 * i));
+    }
+}
+
+/**
+ * Function that compares two arrays element by element. No tolerance is
+ * allowed.
+ *
+ * \param output (INPUT) is the array created by the expression
+ * \param true_output (INPUT) is the array created by the *_ncerr functions
+ * \param what (INPUT) is the name of the check for the error message
+ */
+template <typename NumT>
+bool test_okay(const Nessi::Vector<NumT> & output,
+               const Nessi::Vector<NumT> & true_output,
+               const string & what)
+{
+  if (output.size() != true_output.size())
+    {
+      cout << "(" << what << ") FAILED....Output size different from "
+           << "vector expected" << endl;
+      return false;
+    }
+  size_t size = output.size();
+  for (size_t i = 0; i < size; ++i)
+    {
+      if (!(output[i] == true_output[i]))
+        {
+          cout << "(" << what << ") FAILED....Output different from "
+               << "vector expected at index #" << i << endl;
+          return false;
+        }
+    }
+  return true;
+}
+
+/**
+ * Function that generates the data with the expression and with the
+ * *_ncerr functions and launches the comparison of the data.
+ *
+ * \param key (INPUT) key that permits to launch the correct test
+ * \param debug (INPUT) is any string that launches the debug mode (print all
+ * the array created and calculated)
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_func(NumT key, string debug)
+{
+  Nessi::Vector<NumT> sample;
+  Nessi::Vector<NumT> sample_err2;
+  Nessi::Vector<NumT> background;
+  Nessi::Vector<NumT> background_err2;
+  Nessi::Vector<NumT> vanadium;
+  Nessi::Vector<NumT> vanadium_err2;
+  Nessi::Vector<NumT> efficiency;
+  Nessi::Vector<NumT> efficiency_err2;
+  NumT offset = static_cast<NumT>(2.5);
+  NumT offset_err2 = static_cast<NumT>(0.25);
+
+  initialize_input(40., 3.5, sample, sample_err2);
+  initialize_input(4., 0.25, background, background_err2);
+  initialize_input(11., -0.5, vanadium, vanadium_err2);
+  initialize_input(0.75, 0.01, efficiency, efficiency_err2);
+
+  // the sequence of function calls
+  Nessi::Vector<NumT> diff(NUM_VAL);
+  Nessi::Vector<NumT> diff_err2(NUM_VAL);
+  Nessi::Vector<NumT> norm(NUM_VAL);
+  Nessi::Vector<NumT> norm_err2(NUM_VAL);
+  Nessi::Vector<NumT> ratio(NUM_VAL);
+  Nessi::Vector<NumT> ratio_err2(NUM_VAL);
+  Nessi::Vector<NumT> true_output(NUM_VAL);
+  Nessi::Vector<NumT> true_output_err2(NUM_VAL);
+  ArrayManip::sub_ncerr(sample, sample_err2, background, background_err2,
+                        diff, diff_err2);
+  ArrayManip::mult_ncerr(vanadium, vanadium_err2, efficiency,
+                         efficiency_err2, norm, norm_err2);
+  ArrayManip::div_ncerr(diff, diff_err2, norm, norm_err2, ratio,
+                        ratio_err2);
+  ArrayManip::add_ncerr(ratio, ratio_err2, offset, offset_err2,
+                        true_output, true_output_err2);
+
+  // the single expression
+  Nessi::Vector<NumT> output(NUM_VAL);
+  Nessi::Vector<NumT> output_err2(NUM_VAL);
+  ArrayManip::evaluate((ArrayManip::ncerr(sample, sample_err2)
+                        - ArrayManip::ncerr(background, background_err2))
+                       / (ArrayManip::ncerr(vanadium, vanadium_err2)
+                          * ArrayManip::ncerr(efficiency, efficiency_err2))
+                       + ArrayManip::ncerr(offset, offset_err2),
+                       output, output_err2);
+
+  if (!debug.empty())
+    {
+      print(output, true_output, VV, debug);
+      print(output_err2, true_output_err2, ERROR + VV, debug);
+    }
+
+  bool value = true;
+  if (!test_okay(output, true_output, "data")
+      || !test_okay(output_err2, true_output_err2, "err2"))
+    {
+      value = false;
+    }
+
+  // the output is one of the arrays of the expression
+  ArrayManip::div_ncerr(offset, offset_err2, diff, diff_err2,
+                        true_output, true_output_err2);
+  ArrayManip::evaluate(ArrayManip::ncerr(offset, offset_err2)
+                       / ArrayManip::ncerr(diff, diff_err2),
+                       diff, diff_err2);
+  if (!test_okay(diff, true_output, "in place data")
+      || !test_okay(diff_err2, true_output_err2, "in place err2"))
+    {
+      value = false;
+    }
+
+  // arrays of the wrong size are rejected
+  Nessi::Vector<NumT> too_short(NUM_VAL - 1);
+  try
+    {
+      ArrayManip::evaluate(ArrayManip::ncerr(sample, sample_err2)
+                           + ArrayManip::ncerr(too_short, too_short),
+                           output, output_err2);
+      cout << "(size check) FAILED....No exception thrown" << endl;
+      value = false;
+    }
+  catch (std::invalid_argument &)
+    {
+    }
+
+  return value;
+}
+
+/**
+ * Main function that tests the uncertainty expressions for float and
+ * double.
+ *
+ * \param argc The number of command-line arguments present
+ * \param argv The list of command-line arguments
+ */
+int main(int argc, char *argv[])
+{
+  cout << "ncerr_expr_test.cpp..........";
+
+  string debug;
+  if (argc >1)
+    {
+      debug = argv[1];
+    }
+
+  int value = 0;
+
+  if(!test_func(static_cast<float>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(!test_func(static_cast<double>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(value == 0)
+    {
+      cout << "Functionality OK" << endl;
+    }
+
+  return value;
+}
+
+/**
+ * \}
+ */   //end of ncerr_expr_test group
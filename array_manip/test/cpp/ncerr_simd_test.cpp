@@ -0,0 +1,302 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file array_manip/test/cpp/ncerr_simd_test.cpp
+ */
+
+#include "arith.hpp"
+#include "nessi_simd.hpp"
+#include "test_common.hpp"
+
+using namespace std;
+
+/// Number of elements, chosen to leave a remainder for every register width
+const int NUM_VAL = 37;
+
+/**
+ * \defgroup ncerr_simd_test ncerr_simd_test
+ * \{
+ *
+ * This test runs the vector-vector, vector-scalar and scalar-vector
+ * versions of <i>add_ncerr</i>, <i>sub_ncerr</i>, <i>mult_ncerr</i>,
+ * <i>div_ncerr</i> and <i>sumw_ncerr</i> once with the plain scalar loops
+ * (Nessi::SIMD_NONE) and once for every instruction set supported by the
+ * host. The vectorized kernels perform the operations in the same order as
+ * the scalar loops, so the outputs must be identical. The arrays are long
+ * enough for both the vector body and the scalar remainder to be used.
+ *
+ * <b>Notations used:</b>
+ * - VV = "v,v"
+ * - SV = "s,v"
+ * - VS = "v,s"
+ * - ERROR = "error "
+ */
+
+/**
+ * This function initializes the values of the input arrays.
+ *
+ * \param input1 (OUTPUT) is the first array
+ * \param input1_err2 (OUTPUT) is the square of the uncertainty in the first
+ * array
+ * \param input2 (OUTPUT) is the second array
+ * \param input2_err2 (OUTPUT) is the square of the uncertainty in the second
+ * array
+ */
+template <typename NumT>
+void initialize_inputs(Nessi::Vector<NumT> & input1,
+                       Nessi::Vector<NumT> & input1_err2,
+                       Nessi::Vector<NumT> & input2,
+                       Nessi::Vector<NumT> & input2_err2)
+{
+  for (int i = 0; i < NUM_VAL; ++i)
+    {
+      input1.push_back(static_cast<NumT>(1.5 + 0.37 * i));
+      input1_err2.push_back(static_cast<NumT>(0.25 + 0.11 * i));
+      input2.push_back(static_cast<NumT>(7.25 - 0.13 * i));
+      input2_err2.push_back(static_cast<NumT>(1.75 + 0.07 * i));
+    }
+}
+
+/**
+ * This function runs all of the vector versions of the ncerr functions and
+ * appends the results to the \f$output\f$ array.
+ *
+ * \param input1 (INPUT) is the first array
+ * \param input1_err2 (INPUT) is the square of the uncertainty in the first
+ * array
+ * \param input2 (INPUT) is the second array
+ * \param input2_err2 (INPUT) is the square of the uncertainty in the second
+ * array
+ * \param output (OUTPUT) is all values followed by all squared
+ * uncertainties of the functions run
+ */
+template <typename NumT>
+void run_all(const Nessi::Vector<NumT> & input1,
+             const Nessi::Vector<NumT> & input1_err2,
+             const Nessi::Vector<NumT> & input2,
+             const Nessi::Vector<NumT> & input2_err2,
+             Nessi::Vector<NumT> & output)
+{
+  Nessi::Vector<NumT> value(NUM_VAL);
+  Nessi::Vector<NumT> value_err2(NUM_VAL);
+  NumT scalar = input2[3];
+  NumT scalar_err2 = input2_err2[3];
+
+  output.clear();
+
+  for (int func = 0; func < 11; ++func)
+    {
+      switch (func)
+        {
+        case 0:
+          ArrayManip::add_ncerr(input1, input1_err2, input2, input2_err2,
+                                value, value_err2);
+          break;
+        case 1:
+          ArrayManip::add_ncerr(input1, input1_err2, scalar, scalar_err2,
+                                value, value_err2);
+          break;
+        case 2:
+          ArrayManip::sub_ncerr(input1, input1_err2, input2, input2_err2,
+                                value, value_err2);
+          break;
+        case 3:
+          ArrayManip::sub_ncerr(input1, input1_err2, scalar, scalar_err2,
+                                value, value_err2);
+          break;
+        case 4:
+          ArrayManip::sub_ncerr(scalar, scalar_err2, input1, input1_err2,
+                                value, value_err2);
+          break;
+        case 5:
+          ArrayManip::mult_ncerr(input1, input1_err2, input2, input2_err2,
+                                 value, value_err2);
+          break;
+        case 6:
+          ArrayManip::mult_ncerr(input1, input1_err2, scalar, scalar_err2,
+                                 value, value_err2);
+          break;
+        case 7:
+          ArrayManip::div_ncerr(input1, input1_err2, input2, input2_err2,
+                                value, value_err2);
+          break;
+        case 8:
+          ArrayManip::div_ncerr(input1, input1_err2, scalar, scalar_err2,
+                                value, value_err2);
+          break;
+        case 9:
+          ArrayManip::div_ncerr(scalar, scalar_err2, input1, input1_err2,
+                                value, value_err2);
+          break;
+        case 10:
+          ArrayManip::sumw_ncerr(input1, input1_err2, input2, input2_err2,
+                                 value, value_err2);
+          break;
+        }
+      output.insert(output.end(), value.begin(), value.end());
+      output.insert(output.end(), value_err2.begin(), value_err2.end());
+    }
+}
+
+/**
+ * Function that compares the outputs of the vectorized kernels with the
+ * output of the scalar loops element by element. Unlike
+ * Utils::vector_is_equals() no tolerance is allowed.
+ *
+ * \param output (INPUT) is the array created with a vector instruction set
+ * \param true_output (INPUT) is the array created with the scalar loops
+ * \param level (INPUT) is the instruction set used to create output
+ */
+template <typename NumT>
+bool test_okay(const Nessi::Vector<NumT> & output,
+               const Nessi::Vector<NumT> & true_output,
+               const Nessi::SimdLevel level)
+{
+  if (output.size() != true_output.size())
+    {
+      cout << "(SIMD level " << level << ") FAILED....Output size "
+           << "different from vector expected" << endl;
+      return false;
+    }
+  size_t size = output.size();
+  for (size_t i = 0; i < size; ++i)
+    {
+      if (!(output[i] == true_output[i]))
+        {
+          cout << "(SIMD level " << level << ") FAILED....Output "
+               << "different from vector expected at index #" << i << endl;
+          return false;
+        }
+    }
+  return true;
+}
+
+/**
+ * Function that generates the data with the scalar loops and with every
+ * supported instruction set and launches the comparison of the data.
+ *
+ * \param key (INPUT) key that permits to launch the correct test
+ * \param debug (INPUT) is any string that launches the debug mode (print all
+ * the array created and calculated)
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_func(NumT key, string debug)
+{
+  Nessi::Vector<NumT> input1;
+  Nessi::Vector<NumT> input1_err2;
+  Nessi::Vector<NumT> input2;
+  Nessi::Vector<NumT> input2_err2;
+  Nessi::Vector<NumT> true_output;
+  Nessi::Vector<NumT> output;
+
+  initialize_inputs(input1, input1_err2, input2, input2_err2);
+
+  Nessi::SimdLevel host = Nessi::set_simd_level(Nessi::SIMD_AVX512);
+  Nessi::set_simd_level(Nessi::SIMD_NONE);
+  run_all(input1, input1_err2, input2, input2_err2, true_output);
+
+  bool value = true;
+  for (int level = Nessi::SIMD_SSE2; level <= host; ++level)
+    {
+      Nessi::set_simd_level(static_cast<Nessi::SimdLevel>(level));
+      run_all(input1, input1_err2, input2, input2_err2, output);
+
+      if (!debug.empty())
+        {
+          cout << endl << "SIMD level " << level << endl;
+          print(output, true_output, VV, debug);
+        }
+
+      if (!test_okay(output, true_output,
+                     static_cast<Nessi::SimdLevel>(level)))
+        {
+          value = false;
+        }
+    }
+
+  // the output may overwrite an input
+  Nessi::Vector<NumT> in_place(input1);
+  Nessi::Vector<NumT> in_place_err2(input1_err2);
+  Nessi::Vector<NumT> expected(NUM_VAL);
+  Nessi::Vector<NumT> expected_err2(NUM_VAL);
+  ArrayManip::div_ncerr(input1, input1_err2, input2, input2_err2,
+                        expected, expected_err2);
+  ArrayManip::div_ncerr(in_place, in_place_err2, input2, input2_err2,
+                        in_place, in_place_err2);
+  if (!test_okay(in_place, expected, host)
+      || !test_okay(in_place_err2, expected_err2, host))
+    {
+      value = false;
+    }
+
+  Nessi::set_simd_level(host);
+
+  return value;
+}
+
+/**
+ * Main function that tests the vectorized ncerr kernels for float and
+ * double.
+ *
+ * \param argc The number of command-line arguments present
+ * \param argv The list of command-line arguments
+ */
+int main(int argc, char *argv[])
+{
+  cout << "ncerr_simd_test.cpp..........";
+
+  string debug;
+  if (argc >1)
+    {
+      debug = argv[1];
+    }
+
+  int value = 0;
+
+  if(!test_func(static_cast<float>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(!test_func(static_cast<double>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(value == 0)
+    {
+      cout << "Functionality OK" << endl;
+    }
+
+  return value;
+}
+
+/**
+ * \}
+ */   //end of ncerr_simd_test group
@@ -0,0 +1,354 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file array_manip/test/cpp/ncerr_view_test.cpp
+ */
+#include "arith.hpp"
+#include "test_common.hpp"
+#include <stdexcept>
+
+using namespace std;
+
+/// Number of elements in the views, more than one chunk of the strided path
+const size_t NUM_VAL = 300;
+/// Stride of the strided views
+const size_t STRIDE = 3;
+/// Number of view overloads tested
+const int NUM_FUNC = 11;
+
+/**
+ * \defgroup ncerr_view_test ncerr_view_test
+ * \{
+ *
+ * This test runs the view versions of <i>add_ncerr</i>, <i>sub_ncerr</i>,
+ * <i>mult_ncerr</i>, <i>div_ncerr</i> and <i>sumw_ncerr</i> on contiguous
+ * and on strided views and compares the result with the vector version of
+ * the function. The elements of the arrays between the strided elements
+ * must be left alone.
+ *
+ * <b>Notations used:</b>
+ * - VV = "v,v"
+ * - SV = "s,v"
+ * - VS = "v,s"
+ * - ERROR = "error "
+ */
+
+template <typename NumT>
+void initialize_inputs(Nessi::Vector<NumT> & input1,
+                       Nessi::Vector<NumT> & input1_err2,
+                       Nessi::Vector<NumT> & input2,
+                       Nessi::Vector<NumT> & input2_err2)
+{
+  for (size_t i = 0; i < NUM_VAL; ++i)
+    {
+      input1[i] = static_cast<NumT>(20 + i % 11);
+      input1_err2[i] = static_cast<NumT>(1 + i % 5);
+      input2[i] = static_cast<NumT>(1 + i % 7);
+      input2_err2[i] = static_cast<NumT>(2 + i % 3);
+    }
+}
+
+template <typename NumT>
+void run_vector(const int func,
+                const Nessi::Vector<NumT> & in1,
+                const Nessi::Vector<NumT> & in1_err2,
+                const Nessi::Vector<NumT> & in2,
+                const Nessi::Vector<NumT> & in2_err2,
+                Nessi::Vector<NumT> & out,
+                Nessi::Vector<NumT> & out_err2)
+{
+  NumT s = static_cast<NumT>(3);
+  NumT s_err2 = static_cast<NumT>(2);
+
+  switch (func)
+    {
+    case 0:
+      ArrayManip::add_ncerr(in1, in1_err2, in2, in2_err2, out, out_err2);
+      break;
+    case 1:
+      ArrayManip::add_ncerr(in1, in1_err2, s, s_err2, out, out_err2);
+      break;
+    case 2:
+      ArrayManip::sub_ncerr(in1, in1_err2, in2, in2_err2, out, out_err2);
+      break;
+    case 3:
+      ArrayManip::sub_ncerr(in1, in1_err2, s, s_err2, out, out_err2);
+      break;
+    case 4:
+      ArrayManip::sub_ncerr(s, s_err2, in1, in1_err2, out, out_err2);
+      break;
+    case 5:
+      ArrayManip::mult_ncerr(in1, in1_err2, in2, in2_err2, out, out_err2);
+      break;
+    case 6:
+      ArrayManip::mult_ncerr(in1, in1_err2, s, s_err2, out, out_err2);
+      break;
+    case 7:
+      ArrayManip::div_ncerr(in1, in1_err2, in2, in2_err2, out, out_err2);
+      break;
+    case 8:
+      ArrayManip::div_ncerr(in1, in1_err2, s, s_err2, out, out_err2);
+      break;
+    case 9:
+      ArrayManip::div_ncerr(s, s_err2, in1, in1_err2, out, out_err2);
+      break;
+    case 10:
+      ArrayManip::sumw_ncerr(in1, in1_err2, in2, in2_err2, out, out_err2);
+      break;
+    }
+}
+
+template <typename NumT>
+void run_view(const int func,
+              const Nessi::VectorView<const NumT> & in1,
+              const Nessi::VectorView<const NumT> & in1_err2,
+              const Nessi::VectorView<const NumT> & in2,
+              const Nessi::VectorView<const NumT> & in2_err2,
+              const Nessi::VectorView<NumT> & out,
+              const Nessi::VectorView<NumT> & out_err2)
+{
+  NumT s = static_cast<NumT>(3);
+  NumT s_err2 = static_cast<NumT>(2);
+
+  switch (func)
+    {
+    case 0:
+      ArrayManip::add_ncerr(in1, in1_err2, in2, in2_err2, out, out_err2);
+      break;
+    case 1:
+      ArrayManip::add_ncerr(in1, in1_err2, s, s_err2, out, out_err2);
+      break;
+    case 2:
+      ArrayManip::sub_ncerr(in1, in1_err2, in2, in2_err2, out, out_err2);
+      break;
+    case 3:
+      ArrayManip::sub_ncerr(in1, in1_err2, s, s_err2, out, out_err2);
+      break;
+    case 4:
+      ArrayManip::sub_ncerr(s, s_err2, in1, in1_err2, out, out_err2);
+      break;
+    case 5:
+      ArrayManip::mult_ncerr(in1, in1_err2, in2, in2_err2, out, out_err2);
+      break;
+    case 6:
+      ArrayManip::mult_ncerr(in1, in1_err2, s, s_err2, out, out_err2);
+      break;
+    case 7:
+      ArrayManip::div_ncerr(in1, in1_err2, in2, in2_err2, out, out_err2);
+      break;
+    case 8:
+      ArrayManip::div_ncerr(in1, in1_err2, s, s_err2, out, out_err2);
+      break;
+    case 9:
+      ArrayManip::div_ncerr(s, s_err2, in1, in1_err2, out, out_err2);
+      break;
+    case 10:
+      ArrayManip::sumw_ncerr(in1, in1_err2, in2, in2_err2, out, out_err2);
+      break;
+    }
+}
+
+/**
+ * Function that compares the views with the vector version of every
+ * function for one stride of the views.
+ *
+ * \param stride (INPUT) is the stride of every view
+ * \param debug (INPUT) is any string that launches the debug mode
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_layout(const size_t stride, string debug)
+{
+  Nessi::Vector<NumT> input1(NUM_VAL);
+  Nessi::Vector<NumT> input1_err2(NUM_VAL);
+  Nessi::Vector<NumT> input2(NUM_VAL);
+  Nessi::Vector<NumT> input2_err2(NUM_VAL);
+  initialize_inputs(input1, input1_err2, input2, input2_err2);
+
+  // the inputs are spread over arrays holding stride elements per value
+  Nessi::Vector<NumT> array1(NUM_VAL * stride);
+  Nessi::Vector<NumT> array1_err2(NUM_VAL * stride);
+  Nessi::Vector<NumT> array2(NUM_VAL * stride);
+  Nessi::Vector<NumT> array2_err2(NUM_VAL * stride);
+  for (size_t i = 0; i < NUM_VAL; ++i)
+    {
+      array1[i * stride] = input1[i];
+      array1_err2[i * stride] = input1_err2[i];
+      array2[i * stride] = input2[i];
+      array2_err2[i * stride] = input2_err2[i];
+    }
+
+  Nessi::Vector<NumT> true_output(NUM_VAL);
+  Nessi::Vector<NumT> true_output_err2(NUM_VAL);
+  Nessi::Vector<NumT> output(NUM_VAL);
+  Nessi::Vector<NumT> output_err2(NUM_VAL);
+
+  for (int func = 0; func < NUM_FUNC; ++func)
+    {
+      run_vector(func, input1, input1_err2, input2, input2_err2,
+                 true_output, true_output_err2);
+
+      Nessi::Vector<NumT> array_out(NUM_VAL * stride);
+      Nessi::Vector<NumT> array_out_err2(NUM_VAL * stride);
+      run_view(func,
+               Nessi::VectorView<const NumT>(array1, 0, NUM_VAL, stride),
+               Nessi::VectorView<const NumT>(array1_err2, 0, NUM_VAL,
+                                             stride),
+               Nessi::VectorView<const NumT>(array2, 0, NUM_VAL, stride),
+               Nessi::VectorView<const NumT>(array2_err2, 0, NUM_VAL,
+                                             stride),
+               Nessi::VectorView<NumT>(array_out, 0, NUM_VAL, stride),
+               Nessi::VectorView<NumT>(array_out_err2, 0, NUM_VAL, stride));
+
+      for (size_t i = 0; i < NUM_VAL; ++i)
+        {
+          output[i] = array_out[i * stride];
+          output_err2[i] = array_out_err2[i * stride];
+        }
+
+      if (!debug.empty())
+        {
+          print(output, true_output, VV, debug);
+          print(output_err2, true_output_err2, ERROR + VV, debug);
+        }
+
+      if (!Utils::vector_is_equals(output, true_output)
+          || !Utils::vector_is_equals(output_err2, true_output_err2))
+        {
+          cout << "(" << type_string(output) << " function " << func
+               << ", stride " << stride << ") FAILED....Output different "
+               << "from vector expected" << endl;
+          return false;
+        }
+
+      // the elements between the strided ones are left alone
+      for (size_t i = 0; i < NUM_VAL * stride; ++i)
+        {
+          if (i % stride != 0
+              && (array_out[i] != 0 || array_out_err2[i] != 0))
+            {
+              cout << "(" << type_string(output) << " function " << func
+                   << ") FAILED....Element outside the view overwritten"
+                   << endl;
+              return false;
+            }
+        }
+    }
+
+  return true;
+}
+
+/**
+ * Function that runs the tests for contiguous and strided views and checks
+ * that views of different sizes are rejected.
+ *
+ * \param key (INPUT) key that permits to launch the correct test
+ * \param debug (INPUT) is any string that launches the debug mode (print all
+ * the array created and calculated)
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_func(NumT key, string debug)
+{
+  if (!test_layout<NumT>(1, debug) || !test_layout<NumT>(STRIDE, debug))
+    {
+      return false;
+    }
+
+  Nessi::Vector<NumT> input(NUM_VAL);
+  Nessi::Vector<NumT> wrong(NUM_VAL + 1);
+  try
+    {
+      ArrayManip::add_ncerr(Nessi::VectorView<const NumT>(input),
+                            Nessi::VectorView<const NumT>(input),
+                            Nessi::VectorView<const NumT>(input),
+                            Nessi::VectorView<const NumT>(input),
+                            Nessi::VectorView<NumT>(input),
+                            Nessi::VectorView<NumT>(wrong));
+      cout << "(" << type_string(input) << ") FAILED....No exception "
+           << "thrown" << endl;
+      return false;
+    }
+  catch (std::invalid_argument &)
+    {
+    }
+
+  return true;
+}
+
+/**
+ * Main function that tests the view versions of the arithmetic functions
+ * for float, double, int and unsigned int.
+ *
+ * \param argc The number of command-line arguments present
+ * \param argv The list of command-line arguments
+ */
+int main(int argc, char *argv[])
+{
+  cout << "ncerr_view_test.cpp..........";
+
+  string debug;
+  if (argc >1)
+    {
+      debug = argv[1];
+    }
+
+  int value = 0;
+
+  if(!test_func(static_cast<float>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(!test_func(static_cast<double>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(!test_func(static_cast<int>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(!test_func(static_cast<unsigned int>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(value == 0)
+    {
+      cout << "Functionality OK" << endl;
+    }
+
+  return value;
+}
+
+/**
+ * \}
+ */   //end of ncerr_view_test group
@@ -31,6 +31,9 @@
 #define _CONVERSIONS_HPP 1
 
 #include "nessi.hpp"
+#include "nessi_block.hpp"
+#include "nessi_exec.hpp"
+#include "nessi_view.hpp"
 #include <string>
 
 /**
@@ -49,6 +52,9 @@
  */
 namespace AxisManip
 {
+  template <typename NumT>
+  class InstrumentGeometryCache;
+
   /**
    * \defgroup d_spacing_to_tof_focused_det AxisManip::d_spacing_to_tof_focused_det
    * \{
@@ -165,6 +171,132 @@ namespace AxisManip
                                NumT & tof,
                                NumT & tof_err2,
                                void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.39 applied to every
+   * pixel of a block
+   *
+   * This function converts the d-spacing axes of all pixels of a block to
+   * time-of-flight in one call using the equations of the vector version.
+   * All pixels share the focused detector.
+   *
+   * \param d_spacing (INPUT) is the block of d-spacing axes in units of
+   * Angstroms
+   * \param pathlength_focused (INPUT) is the total flight path of the
+   * focused neutron in units of meter
+   * \param pathlength_focused_err2 (INPUT) is the square of the uncertainty
+   * in pathlength_focused
+   * \param polar_focused (INPUT) is the polar angle of the focused neutron
+   * in units of radians
+   * \param polar_focused_err2 (INPUT) is the square of the uncertainty in
+   * polar_focused
+   * \param tof (OUTPUT) is the block of time-of-flight axes in units of
+   * microseconds
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if d_spacing and tof do not
+   * have the same number of pixels and bins.
+   */
+  template <typename NumT>
+  std::string
+  d_spacing_to_tof_focused_det(const Nessi::SpectrumBlock<NumT> & d_spacing,
+                               const NumT pathlength_focused,
+                               const NumT pathlength_focused_err2,
+                               const NumT polar_focused,
+                               const NumT polar_focused_err2,
+                               Nessi::SpectrumBlock<NumT> & tof,
+                               void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.39 applied to every
+   * pixel of a block with an execution policy
+   *
+   * This function converts the d-spacing axes of all pixels of a block to
+   * time-of-flight in one call using the equations of the vector version.
+   * All pixels share the focused detector.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param d_spacing (INPUT) is the block of d-spacing axes in units of
+   * Angstroms
+   * \param pathlength_focused (INPUT) is the total flight path of the
+   * focused neutron in units of meter
+   * \param pathlength_focused_err2 (INPUT) is the square of the uncertainty
+   * in pathlength_focused
+   * \param polar_focused (INPUT) is the polar angle of the focused neutron
+   * in units of radians
+   * \param polar_focused_err2 (INPUT) is the square of the uncertainty in
+   * polar_focused
+   * \param tof (OUTPUT) is the block of time-of-flight axes in units of
+   * microseconds
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if d_spacing and tof do not
+   * have the same number of pixels and bins.
+   */
+  template <typename NumT>
+  std::string
+  d_spacing_to_tof_focused_det(const Nessi::ExecutionPolicy & policy,
+                               const Nessi::SpectrumBlock<NumT> & d_spacing,
+                               const NumT pathlength_focused,
+                               const NumT pathlength_focused_err2,
+                               const NumT polar_focused,
+                               const NumT polar_focused_err2,
+                               Nessi::SpectrumBlock<NumT> & tof,
+                               void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.39 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be converted in place.
+   *
+   * \param d_spacing (INPUT) is a view of the d-spacing axis in units of
+   * Angstrom
+   * \param d_spacing_err2 (INPUT) is a view of the square of the
+   * uncertainty in the d-spacing axis
+   * \param pathlength_focused (INPUT) is the total flight path of the
+   * focused neutron in units of meter
+   * \param pathlength_focused_err2 (INPUT) is the square of the uncertainty
+   * in pathlength_focused
+   * \param polar_focused (INPUT) is the polar angle of the focused neutron
+   * in the equation above in units of radians
+   * \param polar_focused_err2 (INPUT) is the square of the uncertainty in
+   * polar_focused
+   * \param tof (OUTPUT) is a view of the time-of-flight axis in units of
+   * micro-seconds
+   * \param tof_err2 (OUTPUT) is a view of the square of the uncertainty in
+   * the time-of-flight axis
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  d_spacing_to_tof_focused_det(const Nessi::VectorView<const NumT> & d_spacing,
+                               const Nessi::VectorView<const NumT> &
+                               d_spacing_err2,
+                               const NumT pathlength_focused,
+                               const NumT pathlength_focused_err2,
+                               const NumT polar_focused,
+                               const NumT polar_focused_err2,
+                               const Nessi::VectorView<NumT> & tof,
+                               const Nessi::VectorView<NumT> & tof_err2,
+                               void *temp=NULL);
+
   /**
    * \}
    */ // end of d_spacing_to_tof_focused_det group
@@ -253,6 +385,90 @@ namespace AxisManip
                        NumT & wavelength_err2,
                        void *temp=NULL);
 
+  /**
+   * \brief This function is described in section 3.51 applied to every
+   * pixel of a block
+   *
+   * This function converts the energy axes of all pixels of a block to
+   * wavelength in one call using the equations of the vector version.
+   *
+   * \param energy (INPUT) is the block of energy axes in units of meV
+   * \param wavelength (OUTPUT) is the block of wavelength axes in units of
+   * Angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if energy and wavelength do
+   * not have the same number of pixels and bins.
+   */
+  template <typename NumT>
+  std::string
+  energy_to_wavelength(const Nessi::SpectrumBlock<NumT> & energy,
+                       Nessi::SpectrumBlock<NumT> & wavelength,
+                       void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.51 applied to every
+   * pixel of a block with an execution policy
+   *
+   * This function converts the energy axes of all pixels of a block to
+   * wavelength in one call using the equations of the vector version.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param energy (INPUT) is the block of energy axes in units of meV
+   * \param wavelength (OUTPUT) is the block of wavelength axes in units of
+   * Angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if energy and wavelength do
+   * not have the same number of pixels and bins.
+   */
+  template <typename NumT>
+  std::string
+  energy_to_wavelength(const Nessi::ExecutionPolicy & policy,
+                       const Nessi::SpectrumBlock<NumT> & energy,
+                       Nessi::SpectrumBlock<NumT> & wavelength,
+                       void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.51 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be converted in place.
+   *
+   * \param energy (INPUT) is a view of the energy of the neutron in units
+   * of meV
+   * \param energy_err2 (INPUT) is a view of the square of the uncertainty
+   * in the energy
+   * \param wavelength (OUTPUT) is a view of the wavelength axis in units of
+   * angstroms
+   * \param wavelength_err2 (OUTPUT) is a view of the square of the
+   * uncertainty in the wavelength axis
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  energy_to_wavelength(const Nessi::VectorView<const NumT> & energy,
+                       const Nessi::VectorView<const NumT> & energy_err2,
+                       const Nessi::VectorView<NumT> & wavelength,
+                       const Nessi::VectorView<NumT> & wavelength_err2,
+                       void *temp=NULL);
+
   /**
    * \}
    */ // end of energy_to_wavelength group
@@ -466,6 +682,110 @@ namespace AxisManip
                   NumT & energy_transfer_err2,
                   void *temp=NULL);
 
+  /**
+   * \brief This function is described in section 3.30 applied to every
+   * pixel of a block
+   *
+   * This function converts the final energy axes of all pixels of a block
+   * to energy transfer in one call using the equations of the vector
+   * version.
+   *
+   * \param initial_energy (INPUT) is the incident energy in units of meV
+   * \param initial_energy_err2 (INPUT) is the square of the uncertainty
+   * of the incident energy
+   * \param final_energy (INPUT) is the block of final energy axes in
+   * units of meV
+   * \param energy_transfer (OUTPUT) is the block of energy transfer axes
+   * in units of THz
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if final_energy and
+   * energy_transfer do not have the same number of pixels and bins.
+   */
+  template <typename NumT>
+  std::string
+  energy_transfer(const NumT initial_energy,
+                  const NumT initial_energy_err2,
+                  const Nessi::SpectrumBlock<NumT> & final_energy,
+                  Nessi::SpectrumBlock<NumT> & energy_transfer,
+                  void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.30 applied to every
+   * pixel of a block with an execution policy
+   *
+   * This function converts the final energy axes of all pixels of a block
+   * to energy transfer in one call using the equations of the vector
+   * version.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param initial_energy (INPUT) is the incident energy in units of meV
+   * \param initial_energy_err2 (INPUT) is the square of the uncertainty
+   * of the incident energy
+   * \param final_energy (INPUT) is the block of final energy axes in
+   * units of meV
+   * \param energy_transfer (OUTPUT) is the block of energy transfer axes
+   * in units of THz
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if final_energy and
+   * energy_transfer do not have the same number of pixels and bins.
+   */
+  template <typename NumT>
+  std::string
+  energy_transfer(const Nessi::ExecutionPolicy & policy,
+                  const NumT initial_energy,
+                  const NumT initial_energy_err2,
+                  const Nessi::SpectrumBlock<NumT> & final_energy,
+                  Nessi::SpectrumBlock<NumT> & energy_transfer,
+                  void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.30 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be converted in place.
+   *
+   * \param initial_energy (INPUT) is the incident energy axis in units of
+   * meV
+   * \param initial_energy_err2 (INPUT) is the square of the uncertainty of
+   * the incident energy axis
+   * \param final_energy (INPUT) is a view of the final energy axis in units
+   * of meV
+   * \param final_energy_err2 (INPUT) is a view of the square of the
+   * uncertainty of the final energy axis
+   * \param energy_transfer (OUTPUT) is a view of the energy transfer axis
+   * in units of THz
+   * \param energy_transfer_err2 (OUTPUT) is a view of the square of the
+   * uncertainty in the energy transfer axis
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  energy_transfer(const NumT initial_energy,
+                  const NumT initial_energy_err2,
+                  const Nessi::VectorView<const NumT> & final_energy,
+                  const Nessi::VectorView<const NumT> & final_energy_err2,
+                  const Nessi::VectorView<NumT> & energy_transfer,
+                  const Nessi::VectorView<NumT> & energy_transfer_err2,
+                  void *temp=NULL);
+
   /**
    * \}
    */ // end of energy_transfer group
@@ -547,6 +867,98 @@ namespace AxisManip
                                  NumT & angular_frequency_err2,
                                  void *temp=NULL);
 
+  /**
+   * \brief This function is described in section 3.31 applied to every
+   * pixel of a block
+   *
+   * This function converts the frequency axes of all pixels of a block to
+   * angular frequency in one call using the equations of the vector
+   * version.
+   *
+   * \param frequency (INPUT) is the block of frequency axes in units of THz
+   * \param angular_frequency (OUTPUT) is the block of angular frequency
+   * axes in units of rad/second
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if frequency and
+   * angular_frequency do not have the same number of pixels and bins.
+   */
+  template <typename NumT>
+  std::string
+  frequency_to_angular_frequency(const Nessi::SpectrumBlock<NumT> & frequency,
+                                 Nessi::SpectrumBlock<NumT> &
+                                 angular_frequency,
+                                 void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.31 applied to every
+   * pixel of a block with an execution policy
+   *
+   * This function converts the frequency axes of all pixels of a block to
+   * angular frequency in one call using the equations of the vector
+   * version.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param frequency (INPUT) is the block of frequency axes in units of THz
+   * \param angular_frequency (OUTPUT) is the block of angular frequency
+   * axes in units of rad/second
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if frequency and
+   * angular_frequency do not have the same number of pixels and bins.
+   */
+  template <typename NumT>
+  std::string
+  frequency_to_angular_frequency(const Nessi::ExecutionPolicy & policy,
+                                 const Nessi::SpectrumBlock<NumT> & frequency,
+                                 Nessi::SpectrumBlock<NumT> &
+                                 angular_frequency,
+                                 void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.31 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be converted in place.
+   *
+   * \param frequency (INPUT) is a view of the frequency axis in units of
+   * THz
+   * \param frequency_err2 (INPUT) is a view of the square of the
+   * uncertainty in the frequency axis
+   * \param angular_frequency (OUTPUT) is a view of the angular frequency
+   * axis in units of rad/second
+   * \param angular_frequency_err2 (OUTPUT) is a view of the square of the
+   * uncertainty in the angular frequency axis
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  frequency_to_angular_frequency(const Nessi::VectorView<const NumT> &
+                                 frequency,
+                                 const Nessi::VectorView<const NumT> &
+                                 frequency_err2,
+                                 const Nessi::VectorView<NumT> &
+                                 angular_frequency,
+                                 const Nessi::VectorView<NumT> &
+                                 angular_frequency_err2,
+                                 void *temp=NULL);
+
   /**
    * \}
    */ // end of frequency_to_angular_frequency group
@@ -625,6 +1037,87 @@ namespace AxisManip
                       NumT & E,
                       NumT & E_err2,
                       void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.47 applied to every
+   * pixel of a block
+   *
+   * This function converts the frequency axes of all pixels of a block to
+   * energy in one call using the equations of the vector version.
+   *
+   * \param frequency (INPUT) is the block of frequency axes in units of THz
+   * \param energy (OUTPUT) is the block of energy axes in units of meV
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if frequency and energy do
+   * not have the same number of pixels and bins.
+   */
+  template <typename NumT>
+  std::string
+  frequency_to_energy(const Nessi::SpectrumBlock<NumT> & frequency,
+                      Nessi::SpectrumBlock<NumT> & energy,
+                      void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.47 applied to every
+   * pixel of a block with an execution policy
+   *
+   * This function converts the frequency axes of all pixels of a block to
+   * energy in one call using the equations of the vector version.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param frequency (INPUT) is the block of frequency axes in units of THz
+   * \param energy (OUTPUT) is the block of energy axes in units of meV
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if frequency and energy do
+   * not have the same number of pixels and bins.
+   */
+  template <typename NumT>
+  std::string
+  frequency_to_energy(const Nessi::ExecutionPolicy & policy,
+                      const Nessi::SpectrumBlock<NumT> & frequency,
+                      Nessi::SpectrumBlock<NumT> & energy,
+                      void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.47 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be converted in place.
+   *
+   * \param frequency (INPUT) is a view of the frequency axis in unit of THz
+   * \param frequency_err2 (INPUT) is a view of the square of the
+   * uncertainty of the frequency axis
+   * \param energy (OUTPUT) is a view of the energy axis in units of meV
+   * \param energy_err2 (OUTPUT) is a view of the square of the uncertainty
+   * of the energy axis
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  frequency_to_energy(const Nessi::VectorView<const NumT> & frequency,
+                      const Nessi::VectorView<const NumT> & frequency_err2,
+                      const Nessi::VectorView<NumT> & energy,
+                      const Nessi::VectorView<NumT> & energy_err2,
+                      void *temp=NULL);
+
   /**
    * \}
    */ // end of frequency_to_energy
@@ -1061,26 +1554,181 @@ namespace AxisManip
                              void *temp=NULL);
 
   /**
-   * \}
-   */ // end of init_scatt_wavevector_to_Q group
-
-  /**
-   * \defgroup init_scatt_wavevector_to_scalar_Q AxisManip::init_scatt_wavevector_to_scalar_Q
-   * \{
-   */
-
-  /**
-   * \brief This function is described in section 3.33.
+   * \brief This function is described in section 3.32 applied to every
+   * pixel of a block with the constants of an InstrumentGeometryCache
    *
-   * This function calculates the scalar momentum transfer from the
-   * incident and scattered wavevectors according to the equation
-   * \f[
-   * Q[i]=\sqrt{k_i^2[i]+k_f^2[i]-2k_i[i]k_f[i]\cos(\theta)}
-   * \f]
-   * Where \f$Q\f$ is the scalar momentum transfer, \f$k_i\f$ is the
-   * incident wavevector, \f$k_f\f$ is the final wavevector, and
-   * \f$\theta\f$ is the angle between the z-axis and the scattered
-   * neutron.
+   * This function converts the final wavevector axes of all pixels of a
+   * block with one initial wavevector, like the version taking a scalar
+   * initial wavevector and a final wavevector axis. The azimuthal and
+   * polar angles of pixel \f$p\f$ and the constants calculated from them
+   * are read from \p geometry.
+   *
+   * \param initial_wavevector (INPUT) is the initial wavevector in units
+   * of reciprocal Angstroms
+   * \param initial_wavevector_err2 (INPUT) is the square of the
+   * uncertainty in the initial wavevector
+   * \param final_wavevector (INPUT) is the block of final wavevector axes
+   * in units of reciprocal Angstroms
+   * \param geometry (INPUT) holds the constants of every pixel
+   * \param Qx (OUTPUT) is the block of x components of the momentum
+   * transfer in units of reciprocal Angstroms
+   * \param Qy (OUTPUT) is the block of y components of the momentum
+   * transfer in units of reciprocal Angstroms
+   * \param Qz (OUTPUT) is the block of z components of the momentum
+   * transfer in units of reciprocal Angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the blocks do not have
+   * the same number of pixels and bins, or if geometry does not have one
+   * pixel per spectrum.
+   */
+  template <typename NumT>
+  std::string
+  init_scatt_wavevector_to_Q(const NumT initial_wavevector,
+                             const NumT initial_wavevector_err2,
+                             const Nessi::SpectrumBlock<NumT> &
+                             final_wavevector,
+                             const InstrumentGeometryCache<NumT> & geometry,
+                             Nessi::SpectrumBlock<NumT> & Qx,
+                             Nessi::SpectrumBlock<NumT> & Qy,
+                             Nessi::SpectrumBlock<NumT> & Qz,
+                             void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.32 applied to every
+   * pixel of a block with the constants of an InstrumentGeometryCache
+   * and an execution policy
+   *
+   * This function converts the final wavevector axes of all pixels of a
+   * block with one initial wavevector, like the version taking a scalar
+   * initial wavevector and a final wavevector axis. The azimuthal and
+   * polar angles of pixel \f$p\f$ and the constants calculated from them
+   * are read from \p geometry.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param initial_wavevector (INPUT) is the initial wavevector in units
+   * of reciprocal Angstroms
+   * \param initial_wavevector_err2 (INPUT) is the square of the
+   * uncertainty in the initial wavevector
+   * \param final_wavevector (INPUT) is the block of final wavevector axes
+   * in units of reciprocal Angstroms
+   * \param geometry (INPUT) holds the constants of every pixel
+   * \param Qx (OUTPUT) is the block of x components of the momentum
+   * transfer in units of reciprocal Angstroms
+   * \param Qy (OUTPUT) is the block of y components of the momentum
+   * transfer in units of reciprocal Angstroms
+   * \param Qz (OUTPUT) is the block of z components of the momentum
+   * transfer in units of reciprocal Angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the blocks do not have
+   * the same number of pixels and bins, or if geometry does not have one
+   * pixel per spectrum.
+   */
+  template <typename NumT>
+  std::string
+  init_scatt_wavevector_to_Q(const Nessi::ExecutionPolicy & policy,
+                             const NumT initial_wavevector,
+                             const NumT initial_wavevector_err2,
+                             const Nessi::SpectrumBlock<NumT> &
+                             final_wavevector,
+                             const InstrumentGeometryCache<NumT> & geometry,
+                             Nessi::SpectrumBlock<NumT> & Qx,
+                             Nessi::SpectrumBlock<NumT> & Qy,
+                             Nessi::SpectrumBlock<NumT> & Qz,
+                             void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.32 applied to views
+   *
+   * This function is the same as the version taking a scalar initial
+   * wavevector and a final wavevector axis, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be converted in place.
+   *
+   * \param initial_wavevector (INPUT) is the initial wavevector in units
+   * of reciprocal Angstroms
+   * \param initial_wavevector_err2 (INPUT) is the square of the
+   * uncertainty in the initial wavevector
+   * \param final_wavevector (INPUT) is a view of the final wavevector axis
+   * in units of reciprocal Angstroms
+   * \param final_wavevector_err2 (INPUT) is a view of the square of the
+   * uncertainty of the final wavevector axis
+   * \param azimuthal (INPUT) is the azimuthal angle in units of radians
+   * \param azimuthal_err2 (INPUT) is the square of the uncertainty in
+   * azimuthal
+   * \param polar (INPUT) is the polar angle in units of radians
+   * \param polar_err2 (INPUT) is the square of the uncertainty in polar
+   * \param Qx (OUTPUT) is a view of the x-component of the momentum
+   * transfer axis in units of reciprocal Angstroms
+   * \param Qx_err2 (OUTPUT) is a view of the square of the uncertainty in
+   * the x-component of the momentum transfer axis
+   * \param Qy (OUTPUT) is a view of the y-component of the momentum
+   * transfer axis in units of reciprocal Angstroms
+   * \param Qy_err2 (OUTPUT) is a view of the square of the uncertainty in
+   * the y-component of the momentum transfer axis
+   * \param Qz (OUTPUT) is a view of the z-component of the momentum
+   * transfer axis in units of reciprocal Angstroms
+   * \param Qz_err2 (OUTPUT) is a view of the square of the uncertainty in
+   * the z-component of the momentum transfer axis
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  init_scatt_wavevector_to_Q(const NumT initial_wavevector,
+                             const NumT initial_wavevector_err2,
+                             const Nessi::VectorView<const NumT> &
+                             final_wavevector,
+                             const Nessi::VectorView<const NumT> &
+                             final_wavevector_err2,
+                             const NumT azimuthal,
+                             const NumT azimuthal_err2,
+                             const NumT polar,
+                             const NumT polar_err2,
+                             const Nessi::VectorView<NumT> & Qx,
+                             const Nessi::VectorView<NumT> & Qx_err2,
+                             const Nessi::VectorView<NumT> & Qy,
+                             const Nessi::VectorView<NumT> & Qy_err2,
+                             const Nessi::VectorView<NumT> & Qz,
+                             const Nessi::VectorView<NumT> & Qz_err2,
+                             void *temp=NULL);
+
+  /**
+   * \}
+   */ // end of init_scatt_wavevector_to_Q group
+
+  /**
+   * \defgroup init_scatt_wavevector_to_scalar_Q AxisManip::init_scatt_wavevector_to_scalar_Q
+   * \{
+   */
+
+  /**
+   * \brief This function is described in section 3.33.
+   *
+   * This function calculates the scalar momentum transfer from the
+   * incident and scattered wavevectors according to the equation
+   * \f[
+   * Q[i]=\sqrt{k_i^2[i]+k_f^2[i]-2k_i[i]k_f[i]\cos(\theta)}
+   * \f]
+   * Where \f$Q\f$ is the scalar momentum transfer, \f$k_i\f$ is the
+   * incident wavevector, \f$k_f\f$ is the final wavevector, and
+   * \f$\theta\f$ is the angle between the z-axis and the scattered
+   * neutron.
    *
    * Using the assumption that the uncertainties are uncorrelated,
    * the square of the uncertainty of the scalar momentum transfer
@@ -1332,6 +1980,188 @@ namespace AxisManip
    * \}
    */ // end of init_scatt_wavevector_to_scalar_Q group
 
+  /**
+   * \defgroup instrument_geometry_cache AxisManip::InstrumentGeometryCache
+   * \{
+   */
+
+  template <typename NumT>
+  class __TofToWavelengthKernel;
+
+  template <typename NumT>
+  class __TofToScalarQKernel;
+
+  template <typename NumT>
+  class __WavelengthToScalarQKernel;
+
+  template <typename NumT>
+  class __InitScattWavevectorToQBlock;
+
+  /**
+   * \brief Conversion constants of every pixel of an instrument
+   *
+   * The static helpers of tof_to_wavelength(), tof_to_scalar_Q(),
+   * wavelength_to_scalar_Q() and init_scatt_wavevector_to_Q() calculate
+   * constants that only depend on the geometry of a pixel, several of them
+   * with trigonometric functions. That geometry is the same for every run
+   * on an instrument. An InstrumentGeometryCache calculates the constants
+   * of all pixels once, when it is constructed, and keeps one array per
+   * constant. The block versions of the conversions taking a cache read
+   * the constants of pixel \f$p\f$ from these arrays and give the same
+   * results as the versions taking the geometry.
+   *
+   * A cache can be written to a binary file with save() and read back with
+   * load(), so a new run converts without calculating the constants
+   * again. The file holds the numbers as they are stored in memory, so
+   * load() rejects a file written with another floating point type or
+   * another byte order.
+   */
+  template <typename NumT>
+  class InstrumentGeometryCache
+  {
+  public:
+    /**
+     * \brief Constructor for a cache without pixels, to be filled by
+     * load()
+     */
+    InstrumentGeometryCache();
+
+    /**
+     * \brief Constructor calculating the constants of every pixel
+     *
+     * \param pathlength (INPUT) is the total flight path of the neutron
+     * for every pixel in units of meter
+     * \param pathlength_err2 (INPUT) is the square of the uncertainty in
+     * pathlength
+     * \param polar (INPUT) is the polar angle of every pixel in units of
+     * radians
+     * \param polar_err2 (INPUT) is the square of the uncertainty in polar
+     * \param azimuthal (INPUT) is the azimuthal angle of every pixel in
+     * units of radians
+     * \param azimuthal_err2 (INPUT) is the square of the uncertainty in
+     * azimuthal
+     *
+     * \param temp holds temporary memory to be passed to the function
+     *
+     * \exception std::invalid_argument is thrown if the arrays do not all
+     * have the same size
+     */
+    InstrumentGeometryCache(const Nessi::Vector<NumT> & pathlength,
+                            const Nessi::Vector<NumT> & pathlength_err2,
+                            const Nessi::Vector<NumT> & polar,
+                            const Nessi::Vector<NumT> & polar_err2,
+                            const Nessi::Vector<NumT> & azimuthal,
+                            const Nessi::Vector<NumT> & azimuthal_err2,
+                            void *temp=NULL);
+
+    /**
+     * \brief Returns the number of pixels
+     */
+    std::size_t num_pixels() const;
+
+    /**
+     * \brief Writes the cache to a binary file
+     *
+     * \param filename (INPUT) is the name of the file, which is replaced
+     * if it exists
+     *
+     * \exception std::runtime_error is thrown if the file cannot be
+     * written
+     */
+    void save(const std::string & filename) const;
+
+    /**
+     * \brief Replaces the cache by the one of a binary file written by
+     * save()
+     *
+     * \param filename (INPUT) is the name of the file
+     *
+     * \exception std::runtime_error is thrown if the file cannot be read
+     * \exception std::invalid_argument is thrown if the file was not
+     * written by save() with the same floating point type and byte order,
+     * is truncated or holds too many pixels.
+     *
+     * The cache is left unchanged when an exception is thrown.
+     */
+    void load(const std::string & filename);
+
+  private:
+    friend class __TofToWavelengthKernel<NumT>;
+    friend class __TofToScalarQKernel<NumT>;
+    friend class __WavelengthToScalarQKernel<NumT>;
+    friend class __InitScattWavevectorToQBlock<NumT>;
+
+    /// The arrays of constants, each holding one element per pixel
+    enum Column
+      {
+        /// The constant a of __tof_to_wavelength_static()
+        TTW_A,
+        /// The constant a2 of __tof_to_wavelength_static()
+        TTW_A2,
+        /// The constant a_err2 of __tof_to_wavelength_static()
+        TTW_A_ERR2,
+        /// The parameter b of __tof_to_scalar_Q_static()
+        TTSQ_B,
+        /// The parameter term1 of __tof_to_scalar_Q_static()
+        TTSQ_TERM1,
+        /// The parameter term2 of __tof_to_scalar_Q_static()
+        TTSQ_TERM2,
+        /// The parameter sin of __wavelength_to_scalar_Q_static()
+        WTSQ_SIN,
+        /// The parameter sin2 of __wavelength_to_scalar_Q_static()
+        WTSQ_SIN2,
+        /// The parameter term of __wavelength_to_scalar_Q_static()
+        WTSQ_TERM,
+        /// The parameter a of __init_scatt_wavevector_to_Q_static()
+        ISWTQ_A,
+        /// The parameter a2 of __init_scatt_wavevector_to_Q_static()
+        ISWTQ_A2,
+        /// The parameter b of __init_scatt_wavevector_to_Q_static()
+        ISWTQ_B,
+        /// The parameter b2 of __init_scatt_wavevector_to_Q_static()
+        ISWTQ_B2,
+        /// The parameter c of __init_scatt_wavevector_to_Q_static()
+        ISWTQ_C,
+        /// The parameter c2 of __init_scatt_wavevector_to_Q_static()
+        ISWTQ_C2,
+        /// The parameter d of __init_scatt_wavevector_to_Q_static()
+        ISWTQ_D,
+        /// The parameter d2 of __init_scatt_wavevector_to_Q_static()
+        ISWTQ_D2,
+        /// The azimuthal angles
+        AZIMUTHAL,
+        /// The square of the uncertainty in the azimuthal angles
+        AZIMUTHAL_ERR2,
+        /// The polar angles
+        POLAR,
+        /// The square of the uncertainty in the polar angles
+        POLAR_ERR2,
+        /// The number of arrays, not an array itself
+        NUM_COLUMNS
+      };
+
+    /// Returns the first element of an array of constants
+    NumT * column(const Column column);
+
+    /// Returns the first element of an array of constants
+    const NumT * column(const Column column) const;
+
+    /// Number of pixels
+    std::size_t num_pixels_;
+    /// The parameter a2 of __tof_to_scalar_Q_static(), the same for all
+    /// pixels
+    NumT ttsq_a2_;
+    /// The parameter _4Pi of __wavelength_to_scalar_Q_static(), the same
+    /// for all pixels
+    NumT wtsq_4Pi_;
+    /// The arrays of constants, one after the other
+    Nessi::Vector<NumT> columns_;
+  };
+
+  /**
+   * \}
+   */ // end of instrument_geometry_cache group
+
   /**
    * \defgroup time_offset_dgs AxisManip::time_offset_dgs
    * \{
@@ -1394,6 +2224,559 @@ namespace AxisManip
    * \}
    */ // end of time_offset_dgs group
 
+  /**
+   * \defgroup tof_to_d_spacing AxisManip::tof_to_d_spacing
+   * \{
+   */
+
+  /**
+   * \brief This function is tof_to_wavelength() (section 3.15) followed
+   * by wavelength_to_d_spacing() (section 3.25).
+   *
+   * This function calculates the d-spacing of a time-of-flight axis
+   * according to the equation
+   * \f[
+   * d[i]=\frac{h}{m_n L}\frac{t[i]}{2\sin(polar/2)}
+   * \f]
+   * Where \f$d[i]\f$ is the d-spacing, \f$h\f$ is Planck's constant,
+   * \f$m_n\f$ is the mass of the neutron, \f$L\f$ is the total flight
+   * path of the neutron, \f$t[i]\f$ is the time-of-flight and
+   * \f$polar\f$ is the angle between the z-axis and the scattered
+   * neutron. The wavelength of every bin is converted to d-spacing
+   * without being stored, and the uncertainty is carried through both
+   * conversions. The results are identical to those of the two functions
+   * called one after the other.
+   *
+   * \param tof (INPUT) is the time-of-flight axis in units of
+   * micro-seconds
+   * \param tof_err2 (INPUT) is the square of the uncertainty in the
+   * time-of-flight axis
+   * \param pathlength (INPUT) is the total flight path of the neutron
+   * in units of meter
+   * \param pathlength_err2 (INPUT) is the square of the uncertainty in
+   * pathlength
+   * \param polar_angle (INPUT) is the polar angle in units of radians
+   * \param polar_angle_err2 (INPUT) is the square of the uncertainty in
+   * polar_angle
+   * \param d_spacing (OUTPUT) is the d-spacing axis in units of
+   * Angstrom
+   * \param d_spacing_err2 (OUTPUT) is the square of the uncertainty in
+   * the d-spacing axis
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if tof, tof_err2,
+   * d_spacing and d_spacing_err2 are not of the same size
+   */
+  template <typename NumT>
+  std::string
+  tof_to_d_spacing(const Nessi::Vector<NumT> & tof,
+                   const Nessi::Vector<NumT> & tof_err2,
+                   const NumT pathlength,
+                   const NumT pathlength_err2,
+                   const NumT polar_angle,
+                   const NumT polar_angle_err2,
+                   Nessi::Vector<NumT> & d_spacing,
+                   Nessi::Vector<NumT> & d_spacing_err2,
+                   void *temp=NULL);
+
+  /**
+   * \brief This function is tof_to_wavelength() (section 3.15) followed
+   * by wavelength_to_d_spacing() (section 3.25).
+   *
+   * This function calculates the d-spacing of a time-of-flight according
+   * to the equation
+   * \f[
+   * d=\frac{h}{m_n L}\frac{t}{2\sin(polar/2)}
+   * \f]
+   * with the symbols of the version converting an axis.
+   *
+   * \param tof (INPUT) is the time-of-flight in units of micro-seconds
+   * \param tof_err2 (INPUT) is the square of the uncertainty in the
+   * time-of-flight
+   * \param pathlength (INPUT) is the total flight path of the neutron
+   * in units of meter
+   * \param pathlength_err2 (INPUT) is the square of the uncertainty in
+   * pathlength
+   * \param polar_angle (INPUT) is the polar angle in units of radians
+   * \param polar_angle_err2 (INPUT) is the square of the uncertainty in
+   * polar_angle
+   * \param d_spacing (OUTPUT) is the d-spacing in units of Angstrom
+   * \param d_spacing_err2 (OUTPUT) is the square of the uncertainty in
+   * the d-spacing
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   */
+  template <typename NumT>
+  std::string
+  tof_to_d_spacing(const NumT tof,
+                   const NumT tof_err2,
+                   const NumT pathlength,
+                   const NumT pathlength_err2,
+                   const NumT polar_angle,
+                   const NumT polar_angle_err2,
+                   NumT & d_spacing,
+                   NumT & d_spacing_err2,
+                   void *temp=NULL);
+
+  /**
+   * \brief This function is tof_to_d_spacing() applied to every pixel of
+   * a block
+   *
+   * Spectrum \f$p\f$ of \p tof is converted with the flight path and the
+   * polar angle of pixel \f$p\f$ into spectrum \f$p\f$ of \p d_spacing.
+   *
+   * \param tof (INPUT) is the block of time-of-flight axes in units of
+   * micro-seconds
+   * \param pathlength (INPUT) is the total flight path of every pixel in
+   * units of meter
+   * \param pathlength_err2 (INPUT) is the square of the uncertainty in
+   * pathlength
+   * \param polar_angle (INPUT) is the polar angle of every pixel in
+   * units of radians
+   * \param polar_angle_err2 (INPUT) is the square of the uncertainty in
+   * polar_angle
+   * \param d_spacing (OUTPUT) is the block of d-spacing axes in units of
+   * Angstrom
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if tof and d_spacing do
+   * not have the same number of pixels and bins, or if the geometry
+   * arrays do not have one element per spectrum.
+   */
+  template <typename NumT>
+  std::string
+  tof_to_d_spacing(const Nessi::SpectrumBlock<NumT> & tof,
+                   const Nessi::Vector<NumT> & pathlength,
+                   const Nessi::Vector<NumT> & pathlength_err2,
+                   const Nessi::Vector<NumT> & polar_angle,
+                   const Nessi::Vector<NumT> & polar_angle_err2,
+                   Nessi::SpectrumBlock<NumT> & d_spacing,
+                   void *temp=NULL);
+
+  /**
+   * \brief This function is tof_to_d_spacing() applied to every pixel of
+   * a block with an execution policy
+   *
+   * This function is the same as the version without a policy. The
+   * spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param tof (INPUT) is the block of time-of-flight axes in units of
+   * micro-seconds
+   * \param pathlength (INPUT) is the total flight path of every pixel in
+   * units of meter
+   * \param pathlength_err2 (INPUT) is the square of the uncertainty in
+   * pathlength
+   * \param polar_angle (INPUT) is the polar angle of every pixel in
+   * units of radians
+   * \param polar_angle_err2 (INPUT) is the square of the uncertainty in
+   * polar_angle
+   * \param d_spacing (OUTPUT) is the block of d-spacing axes in units of
+   * Angstrom
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if tof and d_spacing do
+   * not have the same number of pixels and bins, or if the geometry
+   * arrays do not have one element per spectrum.
+   */
+  template <typename NumT>
+  std::string
+  tof_to_d_spacing(const Nessi::ExecutionPolicy & policy,
+                   const Nessi::SpectrumBlock<NumT> & tof,
+                   const Nessi::Vector<NumT> & pathlength,
+                   const Nessi::Vector<NumT> & pathlength_err2,
+                   const Nessi::Vector<NumT> & polar_angle,
+                   const Nessi::Vector<NumT> & polar_angle_err2,
+                   Nessi::SpectrumBlock<NumT> & d_spacing,
+                   void *temp=NULL);
+
+  /**
+   * \brief This function is tof_to_wavelength() (section 3.15) followed by
+   * wavelength_to_d_spacing() (section 3.25) applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be converted in place.
+   *
+   * \param tof (INPUT) is a view of the time-of-flight in units of
+   * micro-seconds
+   * \param tof_err2 (INPUT) is a view of the square of the uncertainty in
+   * the time-of-flight
+   * \param pathlength (INPUT) is the total flight path of the neutron in
+   * units of meter
+   * \param pathlength_err2 (INPUT) is the square of the uncertainty in
+   * pathlength
+   * \param polar_angle (INPUT) is the polar angle in units of radians
+   * \param polar_angle_err2 (INPUT) is the square of the uncertainty in
+   * polar_angle
+   * \param d_spacing (OUTPUT) is a view of the d-spacing in units of
+   * Angstrom
+   * \param d_spacing_err2 (OUTPUT) is a view of the square of the
+   * uncertainty in the d-spacing
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  tof_to_d_spacing(const Nessi::VectorView<const NumT> & tof,
+                   const Nessi::VectorView<const NumT> & tof_err2,
+                   const NumT pathlength,
+                   const NumT pathlength_err2,
+                   const NumT polar_angle,
+                   const NumT polar_angle_err2,
+                   const Nessi::VectorView<NumT> & d_spacing,
+                   const Nessi::VectorView<NumT> & d_spacing_err2,
+                   void *temp=NULL);
+
+  /**
+   * \}
+   */ // end of tof_to_d_spacing group
+
+  /**
+   * \defgroup tof_to_energy_transfer_dgs AxisManip::tof_to_energy_transfer_dgs
+   * \{
+   */
+
+  /**
+   * \brief This function is tof_to_final_velocity_dgs() (section 3.27)
+   * followed by velocity_to_energy() (section 3.21) and
+   * energy_transfer() (section 3.30).
+   *
+   * This function calculates the energy transfer of a time-of-flight
+   * axis of a direct geometry spectrometer according to the equations
+   * \f[
+   * v_f[i]=\frac{L_D}{t[i]-\frac{L_S}{v_i}-t_0}, \quad
+   * E_f[i]=\frac{1}{2}m_n v_f^2[i], \quad
+   * \nu[i]=\frac{E_i-E_f[i]}{h}
+   * \f]
+   * Where \f$v_f[i]\f$ is the final velocity of the neutron, \f$L_D\f$
+   * is the distance from the sample to the detector, \f$t[i]\f$ is the
+   * total time-of-flight, \f$L_S\f$ is the distance from source to
+   * sample, \f$v_i\f$ is the initial velocity of the neutron,
+   * \f$t_0\f$ is the time-offset of the neutron, \f$E_f\f$ is the final
+   * energy, \f$E_i\f$ is the incident energy and \f$\nu\f$ is the energy
+   * transfer. The final velocity and the final energy of every bin are
+   * converted without being stored, and the uncertainty is carried
+   * through the three conversions. The results are identical to those of
+   * the three functions called one after the other.
+   *
+   * \param tof (INPUT) is the time-of-flight axis in units of
+   * micro-seconds
+   * \param tof_err2 (INPUT) is the square of the uncertainty in the
+   * time-of-flight axis
+   * \param initial_velocity (INPUT) is the initial velocity of the
+   * neutron in units of meter/micro-seconds
+   * \param initial_velocity_err2 (INPUT) is the square of the
+   * uncertainty in initial_velocity
+   * \param time_offset (INPUT) is the time offset of the neutron
+   * emitting from the source assuming the velocity supplied in units
+   * of micro-seconds
+   * \param time_offset_err2 (INPUT) is the square of the uncertainty
+   * in time_offset
+   * \param dist_source_sample (INPUT) is the distance from source to
+   * sample in units of meter
+   * \param dist_source_sample_err2 (INPUT) is the square of the
+   * uncertainty in dist_source_sample
+   * \param dist_sample_detector (INPUT) is the distance from sample
+   * to detector in units of meter
+   * \param dist_sample_detector_err2 (INPUT) is the square of the
+   * uncertainty in dist_sample_detector
+   * \param initial_energy (INPUT) is the incident energy in units of meV
+   * \param initial_energy_err2 (INPUT) is the square of the uncertainty
+   * in initial_energy
+   * \param energy_transfer (OUTPUT) is the energy transfer axis in
+   * units of THz
+   * \param energy_transfer_err2 (OUTPUT) is the square of the
+   * uncertainty in the energy transfer axis
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if tof, tof_err2,
+   * energy_transfer and energy_transfer_err2 are not of the same size
+   */
+  template <typename NumT>
+  std::string
+  tof_to_energy_transfer_dgs(const Nessi::Vector<NumT> & tof,
+                             const Nessi::Vector<NumT> & tof_err2,
+                             const NumT initial_velocity,
+                             const NumT initial_velocity_err2,
+                             const NumT time_offset,
+                             const NumT time_offset_err2,
+                             const NumT dist_source_sample,
+                             const NumT dist_source_sample_err2,
+                             const NumT dist_sample_detector,
+                             const NumT dist_sample_detector_err2,
+                             const NumT initial_energy,
+                             const NumT initial_energy_err2,
+                             Nessi::Vector<NumT> & energy_transfer,
+                             Nessi::Vector<NumT> & energy_transfer_err2,
+                             void *temp=NULL);
+
+  /**
+   * \brief This function is tof_to_final_velocity_dgs() (section 3.27)
+   * followed by velocity_to_energy() (section 3.21) and
+   * energy_transfer() (section 3.30).
+   *
+   * This function calculates the energy transfer of one time-of-flight
+   * with the equations of the version converting an axis.
+   *
+   * \param tof (INPUT) is the time-of-flight in units of micro-seconds
+   * \param tof_err2 (INPUT) is the square of the uncertainty in the
+   * time-of-flight
+   * \param initial_velocity (INPUT) is the initial velocity of the
+   * neutron in units of meter/micro-seconds
+   * \param initial_velocity_err2 (INPUT) is the square of the
+   * uncertainty in initial_velocity
+   * \param time_offset (INPUT) is the time offset of the neutron
+   * emitting from the source assuming the velocity supplied in units
+   * of micro-seconds
+   * \param time_offset_err2 (INPUT) is the square of the uncertainty
+   * in time_offset
+   * \param dist_source_sample (INPUT) is the distance from source to
+   * sample in units of meter
+   * \param dist_source_sample_err2 (INPUT) is the square of the
+   * uncertainty in dist_source_sample
+   * \param dist_sample_detector (INPUT) is the distance from sample
+   * to detector in units of meter
+   * \param dist_sample_detector_err2 (INPUT) is the square of the
+   * uncertainty in dist_sample_detector
+   * \param initial_energy (INPUT) is the incident energy in units of meV
+   * \param initial_energy_err2 (INPUT) is the square of the uncertainty
+   * in initial_energy
+   * \param energy_transfer (OUTPUT) is the energy transfer in units of
+   * THz
+   * \param energy_transfer_err2 (OUTPUT) is the square of the
+   * uncertainty in the energy transfer
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   */
+  template <typename NumT>
+  std::string
+  tof_to_energy_transfer_dgs(const NumT tof,
+                             const NumT tof_err2,
+                             const NumT initial_velocity,
+                             const NumT initial_velocity_err2,
+                             const NumT time_offset,
+                             const NumT time_offset_err2,
+                             const NumT dist_source_sample,
+                             const NumT dist_source_sample_err2,
+                             const NumT dist_sample_detector,
+                             const NumT dist_sample_detector_err2,
+                             const NumT initial_energy,
+                             const NumT initial_energy_err2,
+                             NumT & energy_transfer,
+                             NumT & energy_transfer_err2,
+                             void *temp=NULL);
+
+  /**
+   * \brief This function is tof_to_energy_transfer_dgs() applied to every
+   * pixel of a block
+   *
+   * Spectrum \f$p\f$ of \p tof is converted with the sample to detector
+   * distance of pixel \f$p\f$ into spectrum \f$p\f$ of
+   * \p energy_transfer. The other parameters are shared by all pixels.
+   *
+   * \param tof (INPUT) is the block of time-of-flight axes in units of
+   * micro-seconds
+   * \param initial_velocity (INPUT) is the initial velocity of the
+   * neutron in units of meter/micro-seconds
+   * \param initial_velocity_err2 (INPUT) is the square of the
+   * uncertainty in initial_velocity
+   * \param time_offset (INPUT) is the time offset of the neutron
+   * emitting from the source assuming the velocity supplied in units
+   * of micro-seconds
+   * \param time_offset_err2 (INPUT) is the square of the uncertainty
+   * in time_offset
+   * \param dist_source_sample (INPUT) is the distance from source to
+   * sample in units of meter
+   * \param dist_source_sample_err2 (INPUT) is the square of the
+   * uncertainty in dist_source_sample
+   * \param dist_sample_detector (INPUT) is the distance from sample to
+   * every pixel in units of meter
+   * \param dist_sample_detector_err2 (INPUT) is the square of the
+   * uncertainty in dist_sample_detector
+   * \param initial_energy (INPUT) is the incident energy in units of meV
+   * \param initial_energy_err2 (INPUT) is the square of the uncertainty
+   * in initial_energy
+   * \param energy_transfer (OUTPUT) is the block of energy transfer axes
+   * in units of THz
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if tof and
+   * energy_transfer do not have the same number of pixels and bins, or if
+   * the distance arrays do not have one element per spectrum.
+   */
+  template <typename NumT>
+  std::string
+  tof_to_energy_transfer_dgs(const Nessi::SpectrumBlock<NumT> & tof,
+                             const NumT initial_velocity,
+                             const NumT initial_velocity_err2,
+                             const NumT time_offset,
+                             const NumT time_offset_err2,
+                             const NumT dist_source_sample,
+                             const NumT dist_source_sample_err2,
+                             const Nessi::Vector<NumT> &
+                             dist_sample_detector,
+                             const Nessi::Vector<NumT> &
+                             dist_sample_detector_err2,
+                             const NumT initial_energy,
+                             const NumT initial_energy_err2,
+                             Nessi::SpectrumBlock<NumT> & energy_transfer,
+                             void *temp=NULL);
+
+  /**
+   * \brief This function is tof_to_energy_transfer_dgs() applied to every
+   * pixel of a block with an execution policy
+   *
+   * This function is the same as the version without a policy. The
+   * spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param tof (INPUT) is the block of time-of-flight axes in units of
+   * micro-seconds
+   * \param initial_velocity (INPUT) is the initial velocity of the
+   * neutron in units of meter/micro-seconds
+   * \param initial_velocity_err2 (INPUT) is the square of the
+   * uncertainty in initial_velocity
+   * \param time_offset (INPUT) is the time offset of the neutron
+   * emitting from the source assuming the velocity supplied in units
+   * of micro-seconds
+   * \param time_offset_err2 (INPUT) is the square of the uncertainty
+   * in time_offset
+   * \param dist_source_sample (INPUT) is the distance from source to
+   * sample in units of meter
+   * \param dist_source_sample_err2 (INPUT) is the square of the
+   * uncertainty in dist_source_sample
+   * \param dist_sample_detector (INPUT) is the distance from sample to
+   * every pixel in units of meter
+   * \param dist_sample_detector_err2 (INPUT) is the square of the
+   * uncertainty in dist_sample_detector
+   * \param initial_energy (INPUT) is the incident energy in units of meV
+   * \param initial_energy_err2 (INPUT) is the square of the uncertainty
+   * in initial_energy
+   * \param energy_transfer (OUTPUT) is the block of energy transfer axes
+   * in units of THz
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if tof and
+   * energy_transfer do not have the same number of pixels and bins, or if
+   * the distance arrays do not have one element per spectrum.
+   */
+  template <typename NumT>
+  std::string
+  tof_to_energy_transfer_dgs(const Nessi::ExecutionPolicy & policy,
+                             const Nessi::SpectrumBlock<NumT> & tof,
+                             const NumT initial_velocity,
+                             const NumT initial_velocity_err2,
+                             const NumT time_offset,
+                             const NumT time_offset_err2,
+                             const NumT dist_source_sample,
+                             const NumT dist_source_sample_err2,
+                             const Nessi::Vector<NumT> &
+                             dist_sample_detector,
+                             const Nessi::Vector<NumT> &
+                             dist_sample_detector_err2,
+                             const NumT initial_energy,
+                             const NumT initial_energy_err2,
+                             Nessi::SpectrumBlock<NumT> & energy_transfer,
+                             void *temp=NULL);
+
+  /**
+   * \brief This function is tof_to_final_velocity_dgs() (section 3.27)
+   * followed by velocity_to_energy() (section 3.21) and energy_transfer()
+   * (section 3.30) applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be converted in place.
+   *
+   * \param tof (INPUT) is a view of the time-of-flight in units of
+   * micro-seconds
+   * \param tof_err2 (INPUT) is a view of the square of the uncertainty in
+   * the time-of-flight
+   * \param initial_velocity (INPUT) is the initial velocity of the neutron
+   * in units of meter/micro-seconds
+   * \param initial_velocity_err2 (INPUT) is the square of the uncertainty
+   * in initial_velocity
+   * \param time_offset (INPUT) is the time offset of the neutron emitting
+   * from the source assuming the velocity supplied in units of
+   * micro-seconds
+   * \param time_offset_err2 (INPUT) is the square of the uncertainty in
+   * time_offset
+   * \param dist_source_sample (INPUT) is the distance from source to sample
+   * in units of meter
+   * \param dist_source_sample_err2 (INPUT) is the square of the uncertainty
+   * in dist_source_sample
+   * \param dist_sample_detector (INPUT) is the distance from sample to
+   * detector in units of meter
+   * \param dist_sample_detector_err2 (INPUT) is the square of the
+   * uncertainty in dist_sample_detector
+   * \param initial_energy (INPUT) is the incident energy in units of meV
+   * \param initial_energy_err2 (INPUT) is the square of the uncertainty in
+   * initial_energy
+   * \param energy_transfer (OUTPUT) is a view of the energy transfer in
+   * units of THz
+   * \param energy_transfer_err2 (OUTPUT) is a view of the square of the
+   * uncertainty in the energy transfer
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  tof_to_energy_transfer_dgs(const Nessi::VectorView<const NumT> & tof,
+                             const Nessi::VectorView<const NumT> & tof_err2,
+                             const NumT initial_velocity,
+                             const NumT initial_velocity_err2,
+                             const NumT time_offset,
+                             const NumT time_offset_err2,
+                             const NumT dist_source_sample,
+                             const NumT dist_source_sample_err2,
+                             const NumT dist_sample_detector,
+                             const NumT dist_sample_detector_err2,
+                             const NumT initial_energy,
+                             const NumT initial_energy_err2,
+                             const Nessi::VectorView<NumT> & energy_transfer,
+                             const Nessi::VectorView<NumT> &
+                             energy_transfer_err2,
+                             void *temp=NULL);
+
+  /**
+   * \}
+   */ // end of tof_to_energy_transfer_dgs group
+
   /**
    * \defgroup tof_to_final_velocity_dgs AxisManip::tof_to_final_velocity_dgs
    * \{
@@ -1426,10 +2809,189 @@ namespace AxisManip
    *
    * \param tof (INPUT) is the time-of-flight axis in units of
    * micro-seconds
-   * \param tof_err2 (INPUT) is the square of the uncertainty in the
-   * time-of-flight axis
+   * \param tof_err2 (INPUT) is the square of the uncertainty in the
+   * time-of-flight axis
+   * \param initial_velocity (INPUT) is the initial velocity of the
+   * neutron in units of meter/mirco-seconds
+   * \param initial_velocity_err2 (INPUT) is the square of the
+   * uncertainty in initial_velocity
+   * \param time_offset (INPUT) is the time offset of the neutron
+   * emitting from the source assuming the velocity supplied in units
+   * of micro-seconds
+   * \param time_offset_err2 (INPUT) is the square of the uncertainty
+   * in time_offset
+   * \param dist_source_sample (INPUT) is the distance from source to
+   * sample in units of meter
+   * \param dist_source_sample_err2 (INPUT) is the square of the
+   * uncertainty in dist_source_sample
+   * \param dist_sample_detector (INPUT) is the distance from sample
+   * to detector in units of meter
+   * \param dist_sample_detector_err2 (INPUT) is the square of the
+   * uncertainty in dist_sample_detector
+   * \param final_velocity (OUTPUT) is the final velocity axis of the
+   * neutron in units of meter/micro-second
+   * \param final_velocity_err2 (OUTPUT) is the square of the
+   * uncertainty in the final velocity axis
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   */
+  template <typename NumT>
+  std::string
+  tof_to_final_velocity_dgs(Nessi::Vector<NumT> const & tof,
+                            Nessi::Vector<NumT> const & tof_err2,
+                            const NumT initial_velocity,
+                            const NumT initial_velocity_err2,
+                            const NumT time_offset,
+                            const NumT time_offset_err2,
+                            const NumT dist_source_sample,
+                            const NumT dist_source_sample_err2,
+                            const NumT dist_sample_detector,
+                            const NumT dist_sample_detector_err2,
+                            Nessi::Vector<NumT> & final_velocity,
+                            Nessi::Vector<NumT> & final_velocity_err2,
+                            void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.27.
+   *
+   * This function calculates the final velocity of the neutron for a
+   * direct geometry spectrometer according to the equation
+   * \f[
+   * v_f=\frac{L_D}{t-\frac{L_S}{v_i}-t_0}
+   * \f]
+   * Where \f$v_f\f$ is the final velocity of the neutron, \f$L_D\f$
+   * is the distance from the sample to the detector, \f$t\f$ is the
+   * total time-of-flight, \f$L_S\f$ is the distance from source to
+   * sample, \f$v_i\f$ is the initial velocity of the neutron, and
+   * \f$t_0\f$ is the time-offset of the neutron. The uncertainty is
+   * calculated using the assumption of uncorrelated uncertainties.
+   *
+   * \f[
+   * \sigma^2_{v_f} = 
+   * \frac{\sigma^2_{L_D}}{(t-\frac{L_S}{v_i}-t_0)^2} +
+   * \frac{L_D^2 \sigma^2_t}{(t-\frac{L_S}{v_i}-t_0)^4} +
+   * \frac{L^2_D \sigma^2_{L_S}}{v^2_i (t-\frac{L_S}{v_i}-t_0)^4} +
+   * \frac{L^2_S L^2_D \sigma^2_{v_i}}{v^4_i (t-\frac{L_S}{v_i}-t_0)^4}
+   * + \frac{L^2_D \sigma^2_{t_0}}{(t-\frac{L_S}{v_i}-t_0)^4}
+   * \f]
+   *  
+   * \param tof (INPUT) is the time-of-flight axis in units of
+   * micro-seconds
+   * \param tof_err2 (INPUT) is the square of the uncertainty in the
+   * time-of-flight axis
+   * \param initial_velocity (INPUT) is the initial velocity of the
+   * neutron in units of meter/mirco-seconds
+   * \param initial_velocity_err2 (INPUT) is the square of the
+   * uncertainty in initial_velocity
+   * \param time_offset (INPUT) is the time offset of the neutron
+   * emitting from the source assuming the velocity supplied in units
+   * of micro-seconds
+   * \param time_offset_err2 (INPUT) is the square of the uncertainty
+   * in time_offset
+   * \param dist_source_sample (INPUT) is the distance from source to
+   * sample in units of meter
+   * \param dist_source_sample_err2 (INPUT) is the square of the
+   * uncertainty in dist_source_sample
+   * \param dist_sample_detector (INPUT) is the distance from sample
+   * to detector in units of meter
+   * \param dist_sample_detector_err2 (INPUT) is the square of the
+   * uncertainty in dist_sample_detector
+   * \param final_velocity (OUTPUT) is the final velocity axis of the
+   * neutron in units of meter/micro-second
+   * \param final_velocity_err2 (OUTPUT) is the square of the
+   * uncertainty in the final velocity axis
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   */
+  template <typename NumT>
+  std::string
+  tof_to_final_velocity_dgs(const NumT tof,
+                            const NumT tof_err2,
+                            const NumT initial_velocity,
+                            const NumT initial_velocity_err2,
+                            const NumT time_offset,
+                            const NumT time_offset_err2,
+                            const NumT dist_source_sample,
+                            const NumT dist_source_sample_err2,
+                            const NumT dist_sample_detector,
+                            const NumT dist_sample_detector_err2,
+                            NumT & final_velocity,
+                            NumT & final_velocity_err2,
+                            void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.27 applied to every
+   * pixel of a block
+   *
+   * This function converts the time-of-flight axes of all pixels of a
+   * block to final velocity in one call using the equations of the vector
+   * version. Every pixel has its own sample to detector distance.
+   *
+   * \param tof (INPUT) is the block of time-of-flight axes in units of
+   * micro-seconds
+   * \param initial_velocity (INPUT) is the initial velocity of the
+   * neutron in units of meter/micro-seconds
+   * \param initial_velocity_err2 (INPUT) is the square of the
+   * uncertainty in initial_velocity
+   * \param time_offset (INPUT) is the time offset of the neutron
+   * emitting from the source assuming the velocity supplied in units
+   * of micro-seconds
+   * \param time_offset_err2 (INPUT) is the square of the uncertainty
+   * in time_offset
+   * \param dist_source_sample (INPUT) is the distance from source to
+   * sample in units of meter
+   * \param dist_source_sample_err2 (INPUT) is the square of the
+   * uncertainty in dist_source_sample
+   * \param dist_sample_detector (INPUT) is the distance from sample to
+   * every pixel in units of meter
+   * \param dist_sample_detector_err2 (INPUT) is the square of the
+   * uncertainty in dist_sample_detector
+   * \param final_velocity (OUTPUT) is the block of final velocity axes
+   * in units of meter/micro-second
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if tof and final_velocity
+   * do not have the same number of pixels and bins, or if the distance
+   * arrays do not have one element per spectrum.
+   */
+  template <typename NumT>
+  std::string
+  tof_to_final_velocity_dgs(const Nessi::SpectrumBlock<NumT> & tof,
+                            const NumT initial_velocity,
+                            const NumT initial_velocity_err2,
+                            const NumT time_offset,
+                            const NumT time_offset_err2,
+                            const NumT dist_source_sample,
+                            const NumT dist_source_sample_err2,
+                            const Nessi::Vector<NumT> & dist_sample_detector,
+                            const Nessi::Vector<NumT> &
+                            dist_sample_detector_err2,
+                            Nessi::SpectrumBlock<NumT> & final_velocity,
+                            void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.27 applied to every
+   * pixel of a block with an execution policy
+   *
+   * This function converts the time-of-flight axes of all pixels of a
+   * block to final velocity in one call using the equations of the vector
+   * version. Every pixel has its own sample to detector distance.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param tof (INPUT) is the block of time-of-flight axes in units of
+   * micro-seconds
    * \param initial_velocity (INPUT) is the initial velocity of the
-   * neutron in units of meter/mirco-seconds
+   * neutron in units of meter/micro-seconds
    * \param initial_velocity_err2 (INPUT) is the square of the
    * uncertainty in initial_velocity
    * \param time_offset (INPUT) is the time offset of the neutron
@@ -1441,93 +3003,81 @@ namespace AxisManip
    * sample in units of meter
    * \param dist_source_sample_err2 (INPUT) is the square of the
    * uncertainty in dist_source_sample
-   * \param dist_sample_detector (INPUT) is the distance from sample
-   * to detector in units of meter
+   * \param dist_sample_detector (INPUT) is the distance from sample to
+   * every pixel in units of meter
    * \param dist_sample_detector_err2 (INPUT) is the square of the
    * uncertainty in dist_sample_detector
-   * \param final_velocity (OUTPUT) is the final velocity axis of the
-   * neutron in units of meter/micro-second
-   * \param final_velocity_err2 (OUTPUT) is the square of the
-   * uncertainty in the final velocity axis
+   * \param final_velocity (OUTPUT) is the block of final velocity axes
+   * in units of meter/micro-second
    *
    * \param temp holds temporary memory to be passed to the function
    *
    * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if tof and final_velocity
+   * do not have the same number of pixels and bins, or if the distance
+   * arrays do not have one element per spectrum.
    */
   template <typename NumT>
   std::string
-  tof_to_final_velocity_dgs(Nessi::Vector<NumT> const & tof,
-                            Nessi::Vector<NumT> const & tof_err2,
+  tof_to_final_velocity_dgs(const Nessi::ExecutionPolicy & policy,
+                            const Nessi::SpectrumBlock<NumT> & tof,
                             const NumT initial_velocity,
                             const NumT initial_velocity_err2,
                             const NumT time_offset,
                             const NumT time_offset_err2,
                             const NumT dist_source_sample,
                             const NumT dist_source_sample_err2,
-                            const NumT dist_sample_detector,
-                            const NumT dist_sample_detector_err2,
-                            Nessi::Vector<NumT> & final_velocity,
-                            Nessi::Vector<NumT> & final_velocity_err2,
+                            const Nessi::Vector<NumT> & dist_sample_detector,
+                            const Nessi::Vector<NumT> &
+                            dist_sample_detector_err2,
+                            Nessi::SpectrumBlock<NumT> & final_velocity,
                             void *temp=NULL);
 
   /**
-   * \brief This function is described in section 3.27.
+   * \brief This function is described in section 3.27 applied to views
    *
-   * This function calculates the final velocity of the neutron for a
-   * direct geometry spectrometer according to the equation
-   * \f[
-   * v_f=\frac{L_D}{t-\frac{L_S}{v_i}-t_0}
-   * \f]
-   * Where \f$v_f\f$ is the final velocity of the neutron, \f$L_D\f$
-   * is the distance from the sample to the detector, \f$t\f$ is the
-   * total time-of-flight, \f$L_S\f$ is the distance from source to
-   * sample, \f$v_i\f$ is the initial velocity of the neutron, and
-   * \f$t_0\f$ is the time-offset of the neutron. The uncertainty is
-   * calculated using the assumption of uncorrelated uncertainties.
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be converted in place.
    *
-   * \f[
-   * \sigma^2_{v_f} = 
-   * \frac{\sigma^2_{L_D}}{(t-\frac{L_S}{v_i}-t_0)^2} +
-   * \frac{L_D^2 \sigma^2_t}{(t-\frac{L_S}{v_i}-t_0)^4} +
-   * \frac{L^2_D \sigma^2_{L_S}}{v^2_i (t-\frac{L_S}{v_i}-t_0)^4} +
-   * \frac{L^2_S L^2_D \sigma^2_{v_i}}{v^4_i (t-\frac{L_S}{v_i}-t_0)^4}
-   * + \frac{L^2_D \sigma^2_{t_0}}{(t-\frac{L_S}{v_i}-t_0)^4}
-   * \f]
-   *  
-   * \param tof (INPUT) is the time-of-flight axis in units of
+   * \param tof (INPUT) is a view of the time-of-flight axis in units of
    * micro-seconds
-   * \param tof_err2 (INPUT) is the square of the uncertainty in the
-   * time-of-flight axis
-   * \param initial_velocity (INPUT) is the initial velocity of the
-   * neutron in units of meter/mirco-seconds
-   * \param initial_velocity_err2 (INPUT) is the square of the
-   * uncertainty in initial_velocity
-   * \param time_offset (INPUT) is the time offset of the neutron
-   * emitting from the source assuming the velocity supplied in units
-   * of micro-seconds
-   * \param time_offset_err2 (INPUT) is the square of the uncertainty
-   * in time_offset
-   * \param dist_source_sample (INPUT) is the distance from source to
-   * sample in units of meter
-   * \param dist_source_sample_err2 (INPUT) is the square of the
-   * uncertainty in dist_source_sample
-   * \param dist_sample_detector (INPUT) is the distance from sample
-   * to detector in units of meter
+   * \param tof_err2 (INPUT) is a view of the square of the uncertainty in
+   * the time-of-flight axis
+   * \param initial_velocity (INPUT) is the initial velocity of the neutron
+   * in units of meter/mirco-seconds
+   * \param initial_velocity_err2 (INPUT) is the square of the uncertainty
+   * in initial_velocity
+   * \param time_offset (INPUT) is the time offset of the neutron emitting
+   * from the source assuming the velocity supplied in units of
+   * micro-seconds
+   * \param time_offset_err2 (INPUT) is the square of the uncertainty in
+   * time_offset
+   * \param dist_source_sample (INPUT) is the distance from source to sample
+   * in units of meter
+   * \param dist_source_sample_err2 (INPUT) is the square of the uncertainty
+   * in dist_source_sample
+   * \param dist_sample_detector (INPUT) is the distance from sample to
+   * detector in units of meter
    * \param dist_sample_detector_err2 (INPUT) is the square of the
    * uncertainty in dist_sample_detector
-   * \param final_velocity (OUTPUT) is the final velocity axis of the
-   * neutron in units of meter/micro-second
-   * \param final_velocity_err2 (OUTPUT) is the square of the
+   * \param final_velocity (OUTPUT) is a view of the final velocity axis of
+   * the neutron in units of meter/micro-second
+   * \param final_velocity_err2 (OUTPUT) is a view of the square of the
    * uncertainty in the final velocity axis
    *
    * \param temp holds temporary memory to be passed to the function
    *
    * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
    */
   template <typename NumT>
   std::string
-  tof_to_final_velocity_dgs(const NumT tof,
-                            const NumT tof_err2,
+  tof_to_final_velocity_dgs(const Nessi::VectorView<const NumT> & tof,
+                            const Nessi::VectorView<const NumT> & tof_err2,
                             const NumT initial_velocity,
                             const NumT initial_velocity_err2,
                             const NumT time_offset,
@@ -1536,8 +3086,9 @@ namespace AxisManip
                             const NumT dist_source_sample_err2,
                             const NumT dist_sample_detector,
                             const NumT dist_sample_detector_err2,
-                            NumT & final_velocity,
-                            NumT & final_velocity_err2,
+                            const Nessi::VectorView<NumT> & final_velocity,
+                            const Nessi::VectorView<NumT> &
+                            final_velocity_err2,
                             void *temp=NULL);
 
   /**
@@ -1849,6 +3400,185 @@ namespace AxisManip
                                 NumT & initial_wavelength_err2,
                                 void *temp=NULL);
 
+  /**
+   * \brief This function is described in section 3.29 applied to every
+   * pixel of a block
+   *
+   * This function converts the time-of-flight axes of all pixels of a
+   * block to initial wavelength in one call. Pixel \f$p\f$ is converted
+   * with its own sample to detector distance \f$L_d[p]\f$ using the
+   * equations of the vector version, the other parameters are shared by
+   * all pixels. The terms that only depend on the geometry are computed
+   * once per pixel.
+   *
+   * \param tof (INPUT) is the block of time-of-flight axes in units of
+   * micro-seconds
+   * \param final_wavelength (INPUT) is the final wavelength in units of
+   * Angstroms
+   * \param final_wavelength_err2 (INPUT) is the square of the
+   * uncertainty in final_wavelength
+   * \param time_offset (INPUT) is the time offset in units of
+   * micro-seconds
+   * \param time_offset_err2 (INPUT) is the square of the uncertainty
+   * in time_offset
+   * \param dist_source_sample (INPUT) is the distance from source to
+   * sample in units of meter
+   * \param dist_source_sample_err2 (INPUT) is the square of the
+   * uncertainty in dist_source_sample
+   * \param dist_sample_detector (INPUT) is the distance from sample
+   * to detector for every pixel in units of meter
+   * \param dist_sample_detector_err2 (INPUT) is the square of the
+   * uncertainty in dist_sample_detector
+   * \param initial_wavelength (OUTPUT) is the block of initial
+   * wavelength axes in units of Angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if tof and
+   * initial_wavelength do not have the same number of pixels and bins, or
+   * if dist_sample_detector and dist_sample_detector_err2 do not have one
+   * element per pixel.
+   */
+  template <typename NumT>
+  std::string
+  tof_to_initial_wavelength_igs(const Nessi::SpectrumBlock<NumT> & tof,
+                                const NumT final_wavelength,
+                                const NumT final_wavelength_err2,
+                                const NumT time_offset,
+                                const NumT time_offset_err2,
+                                const NumT dist_source_sample,
+                                const NumT dist_source_sample_err2,
+                                const Nessi::Vector<NumT> &
+                                dist_sample_detector,
+                                const Nessi::Vector<NumT> &
+                                dist_sample_detector_err2,
+                                Nessi::SpectrumBlock<NumT> &
+                                initial_wavelength,
+                                void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.29 applied to every
+   * pixel of a block with an execution policy
+   *
+   * This function converts the time-of-flight axes of all pixels of a
+   * block to initial wavelength in one call. Pixel \f$p\f$ is converted
+   * with its own sample to detector distance \f$L_d[p]\f$ using the
+   * equations of the vector version, the other parameters are shared by
+   * all pixels. The terms that only depend on the geometry are computed
+   * once per pixel.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param tof (INPUT) is the block of time-of-flight axes in units of
+   * micro-seconds
+   * \param final_wavelength (INPUT) is the final wavelength in units of
+   * Angstroms
+   * \param final_wavelength_err2 (INPUT) is the square of the
+   * uncertainty in final_wavelength
+   * \param time_offset (INPUT) is the time offset in units of
+   * micro-seconds
+   * \param time_offset_err2 (INPUT) is the square of the uncertainty
+   * in time_offset
+   * \param dist_source_sample (INPUT) is the distance from source to
+   * sample in units of meter
+   * \param dist_source_sample_err2 (INPUT) is the square of the
+   * uncertainty in dist_source_sample
+   * \param dist_sample_detector (INPUT) is the distance from sample
+   * to detector for every pixel in units of meter
+   * \param dist_sample_detector_err2 (INPUT) is the square of the
+   * uncertainty in dist_sample_detector
+   * \param initial_wavelength (OUTPUT) is the block of initial
+   * wavelength axes in units of Angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if tof and
+   * initial_wavelength do not have the same number of pixels and bins, or
+   * if dist_sample_detector and dist_sample_detector_err2 do not have one
+   * element per pixel.
+   */
+  template <typename NumT>
+  std::string
+  tof_to_initial_wavelength_igs(const Nessi::ExecutionPolicy & policy,
+                                const Nessi::SpectrumBlock<NumT> & tof,
+                                const NumT final_wavelength,
+                                const NumT final_wavelength_err2,
+                                const NumT time_offset,
+                                const NumT time_offset_err2,
+                                const NumT dist_source_sample,
+                                const NumT dist_source_sample_err2,
+                                const Nessi::Vector<NumT> &
+                                dist_sample_detector,
+                                const Nessi::Vector<NumT> &
+                                dist_sample_detector_err2,
+                                Nessi::SpectrumBlock<NumT> &
+                                initial_wavelength,
+                                void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.29 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be converted in place.
+   *
+   * \param tof (INPUT) is a view of the time-of-flight axis in units of
+   * micro-seconds
+   * \param tof_err2 (INPUT) is a view of the square of the uncertainty in
+   * the time-of-flight axis
+   * \param final_wavelength (INPUT) is the final wavelength of the neutron
+   * in units of Angstroms
+   * \param final_wavelength_err2 (INPUT) is the square of the uncertainty
+   * in final_wavelength
+   * \param time_offset (INPUT) is the time offset of the neutron emitting
+   * from the source assuming the velocity supplied in units of
+   * micro-seconds
+   * \param time_offset_err2 (INPUT) is the square of the uncertainty in
+   * time_offset
+   * \param dist_source_sample (INPUT) is the distance from source to sample
+   * in units of meter
+   * \param dist_source_sample_err2 (INPUT) is the square of the uncertainty
+   * in dist_source_sample
+   * \param dist_sample_detector (INPUT) is the distance from sample to
+   * detector in units of meter
+   * \param dist_sample_detector_err2 (INPUT) is the square of the
+   * uncertainty in dist_sample_detector
+   * \param initial_wavelength (OUTPUT) is a view of the initial wavelength
+   * axis in units of Anstrom
+   * \param initial_wavelength_err2 (OUTPUT) is a view of the square of the
+   * uncertainty of the initial wavelength axis
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  tof_to_initial_wavelength_igs(const Nessi::VectorView<const NumT> & tof,
+                                const Nessi::VectorView<const NumT> & tof_err2,
+                                const NumT final_wavelength,
+                                const NumT final_wavelength_err2,
+                                const NumT time_offset,
+                                const NumT time_offset_err2,
+                                const NumT dist_source_sample,
+                                const NumT dist_source_sample_err2,
+                                const NumT dist_sample_detector,
+                                const NumT dist_sample_detector_err2,
+                                const Nessi::VectorView<NumT> &
+                                initial_wavelength,
+                                const Nessi::VectorView<NumT> &
+                                initial_wavelength_err2,
+                                void *temp=NULL);
+
   /**
    * \}
    */ // end of tof_to_initial_wavelength_igs group
@@ -1987,67 +3717,263 @@ namespace AxisManip
    * \sigma^2_{\lambda_f}\right)\right)
    * \f]
    *
-   * where \f$\sigma_{\lambda_i}\f$ is the uncertainty of the initial
-   * wavelength axis, \f$\sigma_{L_S}\f$ is the uncertainty of the
-   * distance from the source to the sample, \f$\sigma_t\f$ is the
-   * uncertainty of the time-of-flight, \f$\sigma_{t_{0,offset}}\f$ is the
-   * uncertainty of the time-zero-offset, \f$\sigma_{t_{0,slope}}\f$ is the
-   * uncertainty of the time-zero-slope, \f$\sigma_{L_D}\f$ is the
-   * uncertainty of the distance from the sample to the detector, and
-   * \f$\sigma_{\lambda_f}\f$ the uncertainty of the final wavelength.
+   * where \f$\sigma_{\lambda_i}\f$ is the uncertainty of the initial
+   * wavelength axis, \f$\sigma_{L_S}\f$ is the uncertainty of the
+   * distance from the source to the sample, \f$\sigma_t\f$ is the
+   * uncertainty of the time-of-flight, \f$\sigma_{t_{0,offset}}\f$ is the
+   * uncertainty of the time-zero-offset, \f$\sigma_{t_{0,slope}}\f$ is the
+   * uncertainty of the time-zero-slope, \f$\sigma_{L_D}\f$ is the
+   * uncertainty of the distance from the sample to the detector, and
+   * \f$\sigma_{\lambda_f}\f$ the uncertainty of the final wavelength.
+   *
+   *\param tof (INPUT) is the time-of-flight axis in units of
+   * micro-seconds
+   * \param tof_err2 (INPUT) is the square of the uncertainty in the
+   * time-of-flight axis
+   * \param final_wavelength (INPUT) is the final wavelength of the
+   * neutron in units of Angstroms
+   * \param final_wavelength_err2 (INPUT) is the square of the
+   * uncertainty in final_wavelength
+   * \param time_0_slope (INPUT) is the slope parameter of a linear fit of 
+   * time zero versus initial wavelength
+   * \param time_0_slope_err2 (INPUT) is the square of the uncertainty
+   * in time_0_slope
+   * \param time_0_offset (INPUT) is the offset parameter of a linear fit of 
+   * time zero versus initial wavelength
+   * \param time_0_offset_err2 (INPUT) is the square of the uncertainty
+   * in time_0_offset
+   * \param dist_source_sample (INPUT) is the distance from source to
+   * sample in units of meter
+   * \param dist_source_sample_err2 (INPUT) is the square of the
+   * uncertainty in dist_source_sample
+   * \param dist_sample_detector (INPUT) is the distance from sample
+   * to detector in units of meter
+   * \param dist_sample_detector_err2 (INPUT) is the square of the
+   * uncertainty in dist_sample_detector
+   * \param initial_wavelength (OUTPUT) is the initial wavelength axis
+   * in units of Anstrom
+   * \param initial_wavelength_err2 (OUTPUT) is the square of the
+   * uncertainty of the initial wavelength axis
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   */
+  template <typename NumT>
+  std::string
+  tof_to_initial_wavelength_igs_lin_time_zero(
+                                     const NumT tof,
+                                     const NumT tof_err2,
+                                     const NumT final_wavelength,
+                                     const NumT final_wavelength_err2,
+                                     const NumT time_0_slope,
+                                     const NumT time_0_slope_err2,
+                                     const NumT time_0_offset,
+                                     const NumT time_0_offset_err2,
+                                     const NumT dist_source_sample,
+                                     const NumT dist_source_sample_err2,
+                                     const NumT dist_sample_detector,
+                                     const NumT dist_sample_detector_err2,
+                                     NumT & initial_wavelength,
+                                     NumT & initial_wavelength_err2,
+                                     void *temp=NULL);
+  
+
+  /**
+   * \brief This function is described in section 3.48 applied to every
+   * pixel of a block
+   *
+   * This function converts the time-of-flight axes of all pixels of a block
+   * to initial wavelength in one call using the equations of the vector
+   * version. Every pixel is converted with its own sample to detector
+   * distance.
+   *
+   * \param tof (INPUT) is the block of time-of-flight axes in units of
+   * microseconds
+   * \param final_wavelength (INPUT) is the final wavelength shared by all
+   * pixels in units of Angstroms
+   * \param final_wavelength_err2 (INPUT) is the square of the uncertainty
+   * in final_wavelength
+   * \param time_0_slope (INPUT) is the slope of the time zero shared by all
+   * pixels
+   * \param time_0_slope_err2 (INPUT) is the square of the uncertainty in
+   * time_0_slope
+   * \param time_0_offset (INPUT) is the offset of the time zero shared by
+   * all pixels
+   * \param time_0_offset_err2 (INPUT) is the square of the uncertainty in
+   * time_0_offset
+   * \param dist_source_sample (INPUT) is the distance from the source to
+   * the sample in units of meter
+   * \param dist_source_sample_err2 (INPUT) is the square of the uncertainty
+   * in dist_source_sample
+   * \param dist_sample_detector (INPUT) is the distance from the sample to
+   * the detector of every pixel in units of meter
+   * \param dist_sample_detector_err2 (INPUT) is the square of the
+   * uncertainty in dist_sample_detector
+   * \param initial_wavelength (OUTPUT) is the block of initial wavelength
+   * axes in units of Angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if tof and
+   * initial_wavelength do not have the same number of pixels and bins, or
+   * if the dist_sample_detector arrays do not have one element per
+   * spectrum.
+   */
+  template <typename NumT>
+  std::string
+  tof_to_initial_wavelength_igs_lin_time_zero(
+                                const Nessi::SpectrumBlock<NumT> & tof,
+                                const NumT final_wavelength,
+                                const NumT final_wavelength_err2,
+                                const NumT time_0_slope,
+                                const NumT time_0_slope_err2,
+                                const NumT time_0_offset,
+                                const NumT time_0_offset_err2,
+                                const NumT dist_source_sample,
+                                const NumT dist_source_sample_err2,
+                                const Nessi::Vector<NumT> &
+                                dist_sample_detector,
+                                const Nessi::Vector<NumT> &
+                                dist_sample_detector_err2,
+                                Nessi::SpectrumBlock<NumT> &
+                                initial_wavelength,
+                                void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.48 applied to every
+   * pixel of a block with an execution policy
+   *
+   * This function converts the time-of-flight axes of all pixels of a block
+   * to initial wavelength in one call using the equations of the vector
+   * version. Every pixel is converted with its own sample to detector
+   * distance.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param tof (INPUT) is the block of time-of-flight axes in units of
+   * microseconds
+   * \param final_wavelength (INPUT) is the final wavelength shared by all
+   * pixels in units of Angstroms
+   * \param final_wavelength_err2 (INPUT) is the square of the uncertainty
+   * in final_wavelength
+   * \param time_0_slope (INPUT) is the slope of the time zero shared by all
+   * pixels
+   * \param time_0_slope_err2 (INPUT) is the square of the uncertainty in
+   * time_0_slope
+   * \param time_0_offset (INPUT) is the offset of the time zero shared by
+   * all pixels
+   * \param time_0_offset_err2 (INPUT) is the square of the uncertainty in
+   * time_0_offset
+   * \param dist_source_sample (INPUT) is the distance from the source to
+   * the sample in units of meter
+   * \param dist_source_sample_err2 (INPUT) is the square of the uncertainty
+   * in dist_source_sample
+   * \param dist_sample_detector (INPUT) is the distance from the sample to
+   * the detector of every pixel in units of meter
+   * \param dist_sample_detector_err2 (INPUT) is the square of the
+   * uncertainty in dist_sample_detector
+   * \param initial_wavelength (OUTPUT) is the block of initial wavelength
+   * axes in units of Angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if tof and
+   * initial_wavelength do not have the same number of pixels and bins, or
+   * if the dist_sample_detector arrays do not have one element per
+   * spectrum.
+   */
+  template <typename NumT>
+  std::string
+  tof_to_initial_wavelength_igs_lin_time_zero(
+                                const Nessi::ExecutionPolicy & policy,
+                                const Nessi::SpectrumBlock<NumT> & tof,
+                                const NumT final_wavelength,
+                                const NumT final_wavelength_err2,
+                                const NumT time_0_slope,
+                                const NumT time_0_slope_err2,
+                                const NumT time_0_offset,
+                                const NumT time_0_offset_err2,
+                                const NumT dist_source_sample,
+                                const NumT dist_source_sample_err2,
+                                const Nessi::Vector<NumT> &
+                                dist_sample_detector,
+                                const Nessi::Vector<NumT> &
+                                dist_sample_detector_err2,
+                                Nessi::SpectrumBlock<NumT> &
+                                initial_wavelength,
+                                void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.48 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be converted in place.
    *
-   *\param tof (INPUT) is the time-of-flight axis in units of
+   * \param tof (INPUT) is a view of the time-of-flight axis in units of
    * micro-seconds
-   * \param tof_err2 (INPUT) is the square of the uncertainty in the
-   * time-of-flight axis
-   * \param final_wavelength (INPUT) is the final wavelength of the
-   * neutron in units of Angstroms
-   * \param final_wavelength_err2 (INPUT) is the square of the
-   * uncertainty in final_wavelength
-   * \param time_0_slope (INPUT) is the slope parameter of a linear fit of 
+   * \param tof_err2 (INPUT) is a view of the square of the uncertainty in
+   * the time-of-flight axis
+   * \param final_wavelength (INPUT) is the final wavelength of the neutron
+   * in units of Angstroms
+   * \param final_wavelength_err2 (INPUT) is the square of the uncertainty
+   * in final_wavelength
+   * \param time_0_slope (INPUT) is the slope parameter of a linear fit of
    * time zero versus initial wavelength
-   * \param time_0_slope_err2 (INPUT) is the square of the uncertainty
-   * in time_0_slope
-   * \param time_0_offset (INPUT) is the offset parameter of a linear fit of 
+   * \param time_0_slope_err2 (INPUT) is the square of the uncertainty in
+   * time_0_slope
+   * \param time_0_offset (INPUT) is the offset parameter of a linear fit of
    * time zero versus initial wavelength
-   * \param time_0_offset_err2 (INPUT) is the square of the uncertainty
-   * in time_0_offset
-   * \param dist_source_sample (INPUT) is the distance from source to
-   * sample in units of meter
-   * \param dist_source_sample_err2 (INPUT) is the square of the
-   * uncertainty in dist_source_sample
-   * \param dist_sample_detector (INPUT) is the distance from sample
-   * to detector in units of meter
+   * \param time_0_offset_err2 (INPUT) is the square of the uncertainty in
+   * time_0_offset
+   * \param dist_source_sample (INPUT) is the distance from source to sample
+   * in units of meter
+   * \param dist_source_sample_err2 (INPUT) is the square of the uncertainty
+   * in dist_source_sample
+   * \param dist_sample_detector (INPUT) is the distance from sample to
+   * detector in units of meter
    * \param dist_sample_detector_err2 (INPUT) is the square of the
    * uncertainty in dist_sample_detector
-   * \param initial_wavelength (OUTPUT) is the initial wavelength axis
-   * in units of Anstrom
-   * \param initial_wavelength_err2 (OUTPUT) is the square of the
+   * \param initial_wavelength (OUTPUT) is a view of the initial wavelength
+   * axis in units of Anstrom
+   * \param initial_wavelength_err2 (OUTPUT) is a view of the square of the
    * uncertainty of the initial wavelength axis
    *
    * \param temp holds temporary memory to be passed to the function
    *
    * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
    */
   template <typename NumT>
   std::string
   tof_to_initial_wavelength_igs_lin_time_zero(
-                                     const NumT tof,
-                                     const NumT tof_err2,
-                                     const NumT final_wavelength,
-                                     const NumT final_wavelength_err2,
-                                     const NumT time_0_slope,
-                                     const NumT time_0_slope_err2,
-                                     const NumT time_0_offset,
-                                     const NumT time_0_offset_err2,
-                                     const NumT dist_source_sample,
-                                     const NumT dist_source_sample_err2,
-                                     const NumT dist_sample_detector,
-                                     const NumT dist_sample_detector_err2,
-                                     NumT & initial_wavelength,
-                                     NumT & initial_wavelength_err2,
-                                     void *temp=NULL);
-  
+                                const Nessi::VectorView<const NumT> & tof,
+                                const Nessi::VectorView<const NumT> & tof_err2,
+                                const NumT final_wavelength,
+                                const NumT final_wavelength_err2,
+                                const NumT time_0_slope,
+                                const NumT time_0_slope_err2,
+                                const NumT time_0_offset,
+                                const NumT time_0_offset_err2,
+                                const NumT dist_source_sample,
+                                const NumT dist_source_sample_err2,
+                                const NumT dist_sample_detector,
+                                const NumT dist_sample_detector_err2,
+                                const Nessi::VectorView<NumT> &
+                                initial_wavelength,
+                                const Nessi::VectorView<NumT> &
+                                initial_wavelength_err2,
+                                void *temp=NULL);
+
   /**
    * \}
    */ // end of tof_to_initial_wavelength_igs_lin_time_zero group
@@ -2365,6 +4291,203 @@ namespace AxisManip
                   NumT & Q_err2,
                   void *temp=NULL);
 
+  /**
+   * \brief This function is described in section 3.17 applied to every
+   * pixel of a block
+   *
+   * This function converts the time-of-flight axes of all pixels of a
+   * block to scalar momentum transfer in one call. Pixel \f$p\f$ is
+   * converted with its own flight path \f$L[p]\f$ and polar angle
+   * \f$polar[p]\f$ using the equations of the vector version. The terms
+   * that only depend on the geometry are computed for all pixels before
+   * the conversion, with the sines and cosines of the whole instrument
+   * evaluated together.
+   *
+   * \param tof (INPUT) is the block of time-of-flight axes in units of
+   * micro-seconds
+   * \param pathlength (INPUT) is the total flight path of the neutron
+   * for every pixel in units of meter
+   * \param pathlength_err2 (INPUT) is the square of the uncertainty
+   * in pathlength
+   * \param polar (INPUT) is the polar angle of every pixel in units of
+   * radians
+   * \param polar_err2 (INPUT) is the square of the uncertainty in
+   * polar
+   * \param Q (OUTPUT) is the block of scalar momentum transfer axes in
+   * units of reciprocal angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if tof and Q do not have
+   * the same number of pixels and bins, or if the geometry arrays do not
+   * have one element per pixel.
+   */
+  template <typename NumT>
+  std::string
+  tof_to_scalar_Q(const Nessi::SpectrumBlock<NumT> & tof,
+                  const Nessi::Vector<NumT> & pathlength,
+                  const Nessi::Vector<NumT> & pathlength_err2,
+                  const Nessi::Vector<NumT> & polar,
+                  const Nessi::Vector<NumT> & polar_err2,
+                  Nessi::SpectrumBlock<NumT> & Q,
+                  void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.17 applied to every
+   * pixel of a block with an execution policy
+   *
+   * This function converts the time-of-flight axes of all pixels of a
+   * block to scalar momentum transfer in one call. Pixel \f$p\f$ is
+   * converted with its own flight path \f$L[p]\f$ and polar angle
+   * \f$polar[p]\f$ using the equations of the vector version. The terms
+   * that only depend on the geometry are computed for all pixels before
+   * the conversion, with the sines and cosines of the whole instrument
+   * evaluated together.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param tof (INPUT) is the block of time-of-flight axes in units of
+   * micro-seconds
+   * \param pathlength (INPUT) is the total flight path of the neutron
+   * for every pixel in units of meter
+   * \param pathlength_err2 (INPUT) is the square of the uncertainty
+   * in pathlength
+   * \param polar (INPUT) is the polar angle of every pixel in units of
+   * radians
+   * \param polar_err2 (INPUT) is the square of the uncertainty in
+   * polar
+   * \param Q (OUTPUT) is the block of scalar momentum transfer axes in
+   * units of reciprocal angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if tof and Q do not have
+   * the same number of pixels and bins, or if the geometry arrays do not
+   * have one element per pixel.
+   */
+  template <typename NumT>
+  std::string
+  tof_to_scalar_Q(const Nessi::ExecutionPolicy & policy,
+                  const Nessi::SpectrumBlock<NumT> & tof,
+                  const Nessi::Vector<NumT> & pathlength,
+                  const Nessi::Vector<NumT> & pathlength_err2,
+                  const Nessi::Vector<NumT> & polar,
+                  const Nessi::Vector<NumT> & polar_err2,
+                  Nessi::SpectrumBlock<NumT> & Q,
+                  void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.17 applied to every
+   * pixel of a block with the constants of an InstrumentGeometryCache
+   *
+   * This function is the same as the block version taking the geometry
+   * of every pixel, but the parameters of pixel \f$p\f$ are read from
+   * \p geometry instead of being calculated.
+   *
+   * \param tof (INPUT) is the block of time-of-flight axes in units of
+   * micro-seconds
+   * \param geometry (INPUT) holds the constants of every pixel
+   * \param Q (OUTPUT) is the block of scalar momentum transfer axes in
+   * units of reciprocal angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if tof and Q do not have
+   * the same number of pixels and bins, or if geometry does not have one
+   * pixel per spectrum.
+   */
+  template <typename NumT>
+  std::string
+  tof_to_scalar_Q(const Nessi::SpectrumBlock<NumT> & tof,
+                  const InstrumentGeometryCache<NumT> & geometry,
+                  Nessi::SpectrumBlock<NumT> & Q,
+                  void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.17 applied to every
+   * pixel of a block with the constants of an InstrumentGeometryCache
+   * and an execution policy
+   *
+   * This function is the same as the block version taking the geometry
+   * of every pixel, but the parameters of pixel \f$p\f$ are read from
+   * \p geometry instead of being calculated.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param tof (INPUT) is the block of time-of-flight axes in units of
+   * micro-seconds
+   * \param geometry (INPUT) holds the constants of every pixel
+   * \param Q (OUTPUT) is the block of scalar momentum transfer axes in
+   * units of reciprocal angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if tof and Q do not have
+   * the same number of pixels and bins, or if geometry does not have one
+   * pixel per spectrum.
+   */
+  template <typename NumT>
+  std::string
+  tof_to_scalar_Q(const Nessi::ExecutionPolicy & policy,
+                  const Nessi::SpectrumBlock<NumT> & tof,
+                  const InstrumentGeometryCache<NumT> & geometry,
+                  Nessi::SpectrumBlock<NumT> & Q,
+                  void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.17 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be converted in place.
+   *
+   * \param tof (INPUT) is a view of the time-of-flight axis in units of
+   * micro-seconds
+   * \param tof_err2 (INPUT) is a view of the square of the uncertainty in
+   * the time-of-flight axis
+   * \param pathlength (INPUT) is the total flight path of the neutron in
+   * units of meter
+   * \param pathlength_err2 (INPUT) is the square of the uncertainty in
+   * pathlength
+   * \param polar (INPUT) is the polar angle in the equation above in units
+   * of radians
+   * \param polar_err2 (INPUT) is the square of the uncertainty in polar
+   * \param Q (OUTPUT) is a view of the scalar momentum transfer, Q, axis in
+   * units of reciprocal angstroms
+   * \param Q_err2 (OUTPUT) is a view of the square of the uncertainty in
+   * the scalar momentum transfer axis
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  tof_to_scalar_Q(const Nessi::VectorView<const NumT> & tof,
+                  const Nessi::VectorView<const NumT> & tof_err2,
+                  const NumT pathlength,
+                  const NumT pathlength_err2,
+                  const NumT polar,
+                  const NumT polar_err2,
+                  const Nessi::VectorView<NumT> & Q,
+                  const Nessi::VectorView<NumT> & Q_err2,
+                  void *temp=NULL);
+
   /**
    * \}
    */ // end of tof_to_scalar_Q group
@@ -2449,31 +4572,207 @@ namespace AxisManip
    * \f$\sigma_{TOF}\f$ is the uncertainty in the time of flight axis, and
    * \f$\sigma_L\f$ is the uncertainty in the pathlength.
    *
-   * \param tof (INPUT) is the time-of-flight axis in units of
+   * \param tof (INPUT) is the time-of-flight axis in units of
+   * micro-seconds
+   * \param tof_err2 (INPUT) is the square of the uncertainty in the
+   * time-of-flight axis
+   * \param pathlength (INPUT) is the total flight path of the neutron
+   * in units of meter
+   * \param pathlength_err2 (INPUT) is the square of the uncertainty
+   * in pathlength
+   * \param wavelength (OUTPUT) is the wavelength axis in units of
+   * angstrom
+   * \param wavelength_err2 (OUTPUT) is the square of the uncertainty
+   * in the wavelength axis
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   */
+  template <typename NumT>
+  std::string
+  tof_to_wavelength(const NumT tof,
+                    const NumT tof_err2,
+                    const NumT pathlength,
+                    const NumT pathlength_err2,
+                    NumT & wavelength,
+                    NumT & wavelength_err2,
+                    void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.15 applied to every
+   * pixel of a block
+   *
+   * This function converts the time-of-flight axes of all pixels of a
+   * block to wavelength in one call. Pixel \f$p\f$ is converted with its
+   * own flight path \f$L[p]\f$ using the equations of the vector version.
+   * The terms that only depend on the flight path are computed once per
+   * pixel.
+   *
+   * \param tof (INPUT) is the block of time-of-flight axes in units of
+   * micro-seconds
+   * \param pathlength (INPUT) is the total flight path of the neutron
+   * for every pixel in units of meter
+   * \param pathlength_err2 (INPUT) is the square of the uncertainty
+   * in pathlength
+   * \param wavelength (OUTPUT) is the block of wavelength axes in units of
+   * Angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if tof and wavelength do
+   * not have the same number of pixels and bins, or if pathlength and
+   * pathlength_err2 do not have one element per pixel.
+   */
+  template <typename NumT>
+  std::string
+  tof_to_wavelength(const Nessi::SpectrumBlock<NumT> & tof,
+                    const Nessi::Vector<NumT> & pathlength,
+                    const Nessi::Vector<NumT> & pathlength_err2,
+                    Nessi::SpectrumBlock<NumT> & wavelength,
+                    void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.15 applied to every
+   * pixel of a block with an execution policy
+   *
+   * This function converts the time-of-flight axes of all pixels of a
+   * block to wavelength in one call. Pixel \f$p\f$ is converted with its
+   * own flight path \f$L[p]\f$ using the equations of the vector version.
+   * The terms that only depend on the flight path are computed once per
+   * pixel.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param tof (INPUT) is the block of time-of-flight axes in units of
+   * micro-seconds
+   * \param pathlength (INPUT) is the total flight path of the neutron
+   * for every pixel in units of meter
+   * \param pathlength_err2 (INPUT) is the square of the uncertainty
+   * in pathlength
+   * \param wavelength (OUTPUT) is the block of wavelength axes in units of
+   * Angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if tof and wavelength do
+   * not have the same number of pixels and bins, or if pathlength and
+   * pathlength_err2 do not have one element per pixel.
+   */
+  template <typename NumT>
+  std::string
+  tof_to_wavelength(const Nessi::ExecutionPolicy & policy,
+                    const Nessi::SpectrumBlock<NumT> & tof,
+                    const Nessi::Vector<NumT> & pathlength,
+                    const Nessi::Vector<NumT> & pathlength_err2,
+                    Nessi::SpectrumBlock<NumT> & wavelength,
+                    void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.15 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be converted in place.
+   *
+   * \param tof (INPUT) is a view of the time-of-flight axis in units of
+   * micro-seconds
+   * \param tof_err2 (INPUT) is a view of the square of the uncertainty in
+   * the time-of-flight axis
+   * \param pathlength (INPUT) is the total flight path of the neutron in
+   * units of meter
+   * \param pathlength_err2 (INPUT) is the square of the uncertainty in
+   * pathlength
+   * \param wavelength (OUTPUT) is a view of the wavelength axis in units of
+   * Angstroms
+   * \param wavelength_err2 (OUTPUT) is a view of the square of the
+   * uncertainty in the wavelength axis
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  tof_to_wavelength(const Nessi::VectorView<const NumT> & tof,
+                    const Nessi::VectorView<const NumT> & tof_err2,
+                    const NumT pathlength,
+                    const NumT pathlength_err2,
+                    const Nessi::VectorView<NumT> & wavelength,
+                    const Nessi::VectorView<NumT> & wavelength_err2,
+                    void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.15 applied to every
+   * pixel of a block with the constants of an InstrumentGeometryCache
+   *
+   * This function is the same as the block version taking the flight
+   * paths, but the constants of pixel \f$p\f$ are read from \p geometry
+   * instead of being calculated.
+   *
+   * \param tof (INPUT) is the block of time-of-flight axes in units of
+   * micro-seconds
+   * \param geometry (INPUT) holds the constants of every pixel
+   * \param wavelength (OUTPUT) is the block of wavelength axes in units of
+   * Angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if tof and wavelength do
+   * not have the same number of pixels and bins, or if geometry does not
+   * have one pixel per spectrum.
+   */
+  template <typename NumT>
+  std::string
+  tof_to_wavelength(const Nessi::SpectrumBlock<NumT> & tof,
+                    const InstrumentGeometryCache<NumT> & geometry,
+                    Nessi::SpectrumBlock<NumT> & wavelength,
+                    void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.15 applied to every
+   * pixel of a block with the constants of an InstrumentGeometryCache
+   * and an execution policy
+   *
+   * This function is the same as the block version taking the flight
+   * paths, but the constants of pixel \f$p\f$ are read from \p geometry
+   * instead of being calculated.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param tof (INPUT) is the block of time-of-flight axes in units of
    * micro-seconds
-   * \param tof_err2 (INPUT) is the square of the uncertainty in the
-   * time-of-flight axis
-   * \param pathlength (INPUT) is the total flight path of the neutron
-   * in units of meter
-   * \param pathlength_err2 (INPUT) is the square of the uncertainty
-   * in pathlength
-   * \param wavelength (OUTPUT) is the wavelength axis in units of
-   * angstrom
-   * \param wavelength_err2 (OUTPUT) is the square of the uncertainty
-   * in the wavelength axis
+   * \param geometry (INPUT) holds the constants of every pixel
+   * \param wavelength (OUTPUT) is the block of wavelength axes in units of
+   * Angstroms
    *
    * \param temp holds temporary memory to be passed to the function
    *
    * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if tof and wavelength do
+   * not have the same number of pixels and bins, or if geometry does not
+   * have one pixel per spectrum.
    */
   template <typename NumT>
   std::string
-  tof_to_wavelength(const NumT tof,
-                    const NumT tof_err2,
-                    const NumT pathlength,
-                    const NumT pathlength_err2,
-                    NumT & wavelength,
-                    NumT & wavelength_err2,
+  tof_to_wavelength(const Nessi::ExecutionPolicy & policy,
+                    const Nessi::SpectrumBlock<NumT> & tof,
+                    const InstrumentGeometryCache<NumT> & geometry,
+                    Nessi::SpectrumBlock<NumT> & wavelength,
                     void *temp=NULL);
 
   /**
@@ -2630,6 +4929,152 @@ namespace AxisManip
                                   NumT & wavelength_err2,
                                   void *temp=NULL);
 
+  /**
+   * \brief This function is described in section 3.50 applied to every
+   * pixel of a block
+   *
+   * This function converts the time-of-flight axes of all pixels of a block
+   * to wavelength in one call using the equations of the vector version.
+   * Every pixel is converted with its own flight path.
+   *
+   * \param tof (INPUT) is the block of time-of-flight axes in units of
+   * microseconds
+   * \param pathlength (INPUT) is the total flight path of every pixel in
+   * units of meter
+   * \param pathlength_err2 (INPUT) is the square of the uncertainty in
+   * pathlength
+   * \param time_0_slope (INPUT) is the slope of the time zero shared by all
+   * pixels
+   * \param time_0_slope_err2 (INPUT) is the square of the uncertainty in
+   * time_0_slope
+   * \param time_0_offset (INPUT) is the offset of the time zero shared by
+   * all pixels
+   * \param time_0_offset_err2 (INPUT) is the square of the uncertainty in
+   * time_0_offset
+   * \param wavelength (OUTPUT) is the block of wavelength axes in units of
+   * Angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if tof and wavelength do not
+   * have the same number of pixels and bins, or if the pathlength arrays do
+   * not have one element per spectrum.
+   */
+  template <typename NumT>
+  std::string
+  tof_to_wavelength_lin_time_zero(const Nessi::SpectrumBlock<NumT> & tof,
+                                  const Nessi::Vector<NumT> & pathlength,
+                                  const Nessi::Vector<NumT> & pathlength_err2,
+                                  const NumT time_0_slope,
+                                  const NumT time_0_slope_err2,
+                                  const NumT time_0_offset,
+                                  const NumT time_0_offset_err2,
+                                  Nessi::SpectrumBlock<NumT> & wavelength,
+                                  void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.50 applied to every
+   * pixel of a block with an execution policy
+   *
+   * This function converts the time-of-flight axes of all pixels of a block
+   * to wavelength in one call using the equations of the vector version.
+   * Every pixel is converted with its own flight path.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param tof (INPUT) is the block of time-of-flight axes in units of
+   * microseconds
+   * \param pathlength (INPUT) is the total flight path of every pixel in
+   * units of meter
+   * \param pathlength_err2 (INPUT) is the square of the uncertainty in
+   * pathlength
+   * \param time_0_slope (INPUT) is the slope of the time zero shared by all
+   * pixels
+   * \param time_0_slope_err2 (INPUT) is the square of the uncertainty in
+   * time_0_slope
+   * \param time_0_offset (INPUT) is the offset of the time zero shared by
+   * all pixels
+   * \param time_0_offset_err2 (INPUT) is the square of the uncertainty in
+   * time_0_offset
+   * \param wavelength (OUTPUT) is the block of wavelength axes in units of
+   * Angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if tof and wavelength do not
+   * have the same number of pixels and bins, or if the pathlength arrays do
+   * not have one element per spectrum.
+   */
+  template <typename NumT>
+  std::string
+  tof_to_wavelength_lin_time_zero(const Nessi::ExecutionPolicy & policy,
+                                  const Nessi::SpectrumBlock<NumT> & tof,
+                                  const Nessi::Vector<NumT> & pathlength,
+                                  const Nessi::Vector<NumT> & pathlength_err2,
+                                  const NumT time_0_slope,
+                                  const NumT time_0_slope_err2,
+                                  const NumT time_0_offset,
+                                  const NumT time_0_offset_err2,
+                                  Nessi::SpectrumBlock<NumT> & wavelength,
+                                  void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.50 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be converted in place.
+   *
+   * \param tof (INPUT) is a view of the time-of-flight axis in units of
+   * micro-seconds
+   * \param tof_err2 (INPUT) is a view of the square of the uncertainty in
+   * the time-of-flight axis
+   * \param pathlength (INPUT) is the total flight path of the neutron in
+   * units of meter
+   * \param pathlength_err2 (INPUT) is the square of the uncertainty in
+   * pathlength
+   * \param time_0_slope (INPUT) is the slope parameter of a linear fit of
+   * time zero versus wavelength
+   * \param time_0_slope_err2 (INPUT) is the square of the uncertainty in
+   * time_0_slope
+   * \param time_0_offset (INPUT) is the offset parameter of a linear fit of
+   * time zero versus wavelength
+   * \param time_0_offset_err2 (INPUT) is the square of the uncertainty in
+   * time_0_offset
+   * \param wavelength (OUTPUT) is a view of the wavelength axis in units of
+   * angstrom
+   * \param wavelength_err2 (OUTPUT) is a view of the square of the
+   * uncertainty in the wavelength axis
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  tof_to_wavelength_lin_time_zero(const Nessi::VectorView<const NumT> & tof,
+                                  const Nessi::VectorView<const NumT> &
+                                  tof_err2,
+                                  const NumT pathlength,
+                                  const NumT pathlength_err2,
+                                  const NumT time_0_slope,
+                                  const NumT time_0_slope_err2,
+                                  const NumT time_0_offset,
+                                  const NumT time_0_offset_err2,
+                                  const Nessi::VectorView<NumT> & wavelength,
+                                  const Nessi::VectorView<NumT> &
+                                  wavelength_err2,
+                                  void *temp=NULL);
+
   /**
    * \}
    */ // end of tof_to_wavelength_lin_time_zero group
@@ -2717,6 +5162,90 @@ namespace AxisManip
                      NumT & energy_err2,
                      void *temp=NULL);
 
+  /**
+   * \brief This function is described in section 3.21 applied to every
+   * pixel of a block
+   *
+   * This function converts the velocity axes of all pixels of a block to
+   * energy in one call using the equations of the vector version.
+   *
+   * \param velocity (INPUT) is the block of velocity axes in units of
+   * meter/micro-seconds
+   * \param energy (OUTPUT) is the block of energy axes in units of meV
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if velocity and energy do
+   * not have the same number of pixels and bins.
+   */
+  template <typename NumT>
+  std::string
+  velocity_to_energy(const Nessi::SpectrumBlock<NumT> & velocity,
+                     Nessi::SpectrumBlock<NumT> & energy,
+                     void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.21 applied to every
+   * pixel of a block with an execution policy
+   *
+   * This function converts the velocity axes of all pixels of a block to
+   * energy in one call using the equations of the vector version.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param velocity (INPUT) is the block of velocity axes in units of
+   * meter/micro-seconds
+   * \param energy (OUTPUT) is the block of energy axes in units of meV
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if velocity and energy do
+   * not have the same number of pixels and bins.
+   */
+  template <typename NumT>
+  std::string
+  velocity_to_energy(const Nessi::ExecutionPolicy & policy,
+                     const Nessi::SpectrumBlock<NumT> & velocity,
+                     Nessi::SpectrumBlock<NumT> & energy,
+                     void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.21 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be converted in place.
+   *
+   * \param velocity (INPUT) is a view of the velocity of the neutron in
+   * units of meter/micro-seconds
+   * \param velocity_err2 (INPUT) is a view of the square of the uncertainty
+   * in the velocity of the neutron
+   * \param energy (OUTPUT) is a view of the energy of the neutron in units
+   * of meV
+   * \param energy_err2 (OUTPUT) is a view of the square of the uncertainty
+   * in the energy
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  velocity_to_energy(const Nessi::VectorView<const NumT> & velocity,
+                     const Nessi::VectorView<const NumT> & velocity_err2,
+                     const Nessi::VectorView<NumT> & energy,
+                     const Nessi::VectorView<NumT> & energy_err2,
+                     void *temp=NULL);
+
   /**
    * \}
    */ // end of velocity_to_energy group
@@ -2804,6 +5333,94 @@ namespace AxisManip
                        NumT & wavevector_err2,
                        void *temp=NULL);
 
+  /**
+   * \brief This function is described in section 3.23 applied to every
+   * pixel of a block
+   *
+   * This function converts the velocity axes of all pixels of a block to
+   * scalar wavevector in one call using the equations of the vector
+   * version.
+   *
+   * \param velocity (INPUT) is the block of velocity axes in units of
+   * meter/micro-seconds
+   * \param wavevector (OUTPUT) is the block of scalar wavevector axes in
+   * units of reciprocal Angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if velocity and wavevector
+   * do not have the same number of pixels and bins.
+   */
+  template <typename NumT>
+  std::string
+  velocity_to_scalar_k(const Nessi::SpectrumBlock<NumT> & velocity,
+                       Nessi::SpectrumBlock<NumT> & wavevector,
+                       void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.23 applied to every
+   * pixel of a block with an execution policy
+   *
+   * This function converts the velocity axes of all pixels of a block to
+   * scalar wavevector in one call using the equations of the vector
+   * version.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param velocity (INPUT) is the block of velocity axes in units of
+   * meter/micro-seconds
+   * \param wavevector (OUTPUT) is the block of scalar wavevector axes in
+   * units of reciprocal Angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if velocity and wavevector
+   * do not have the same number of pixels and bins.
+   */
+  template <typename NumT>
+  std::string
+  velocity_to_scalar_k(const Nessi::ExecutionPolicy & policy,
+                       const Nessi::SpectrumBlock<NumT> & velocity,
+                       Nessi::SpectrumBlock<NumT> & wavevector,
+                       void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.23 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be converted in place.
+   *
+   * \param velocity (INPUT) is a view of the velocity of the neutron in
+   * units of meter/micro-seconds
+   * \param velocity_err2 (INPUT) is a view of the square of the uncertainty
+   * in the velocity of the neutron
+   * \param wavevector (OUTPUT) is a view of the scalar wavevector in units
+   * of reciprocal Angstroms
+   * \param wavevector_err2 (OUTPUT) is a view of the square of the
+   * uncertainty in the scalar wavevector
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  velocity_to_scalar_k(const Nessi::VectorView<const NumT> & velocity,
+                       const Nessi::VectorView<const NumT> & velocity_err2,
+                       const Nessi::VectorView<NumT> & wavevector,
+                       const Nessi::VectorView<NumT> & wavevector_err2,
+                       void *temp=NULL);
+
   /**
    * \}
    */ // end of velocity_to_scalar_k group
@@ -2894,6 +5511,92 @@ namespace AxisManip
                          NumT & wavelength_err2,
                          void *temp=NULL);
 
+  /**
+   * \brief This function is described in section 3.58 applied to every
+   * pixel of a block
+   *
+   * This function converts the velocity axes of all pixels of a block to
+   * wavelength in one call using the equations of the vector version.
+   *
+   * \param velocity (INPUT) is the block of velocity axes in units of
+   * meter/micro-seconds
+   * \param wavelength (OUTPUT) is the block of wavelength axes in units of
+   * Angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if velocity and wavelength
+   * do not have the same number of pixels and bins.
+   */
+  template <typename NumT>
+  std::string
+  velocity_to_wavelength(const Nessi::SpectrumBlock<NumT> & velocity,
+                         Nessi::SpectrumBlock<NumT> & wavelength,
+                         void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.58 applied to every
+   * pixel of a block with an execution policy
+   *
+   * This function converts the velocity axes of all pixels of a block to
+   * wavelength in one call using the equations of the vector version.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param velocity (INPUT) is the block of velocity axes in units of
+   * meter/micro-seconds
+   * \param wavelength (OUTPUT) is the block of wavelength axes in units of
+   * Angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if velocity and wavelength
+   * do not have the same number of pixels and bins.
+   */
+  template <typename NumT>
+  std::string
+  velocity_to_wavelength(const Nessi::ExecutionPolicy & policy,
+                         const Nessi::SpectrumBlock<NumT> & velocity,
+                         Nessi::SpectrumBlock<NumT> & wavelength,
+                         void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.58 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be converted in place.
+   *
+   * \param velocity (INPUT) is a view of the velocity axis in units of
+   * meter/micro-seconds
+   * \param velocity_err2 (INPUT) is a view of the square of the uncertainty
+   * in the velocity axis
+   * \param wavelength (OUTPUT) is a view of the wavelength axis in units of
+   * Angstroms
+   * \param wavelength_err2 (OUTPUT) is a view of the square of the
+   * uncertainty in the wavelength axis
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  velocity_to_wavelength(const Nessi::VectorView<const NumT> & velocity,
+                         const Nessi::VectorView<const NumT> & velocity_err2,
+                         const Nessi::VectorView<NumT> & wavelength,
+                         const Nessi::VectorView<NumT> & wavelength_err2,
+                         void *temp=NULL);
+
   /**
    * \}
    */ // end of velocity_to_wavelength group
@@ -2995,6 +5698,115 @@ namespace AxisManip
                           NumT & d_spacing_err2,
                           void *temp=NULL);
 
+  /**
+   * \brief This function is described in section 3.25 applied to every
+   * pixel of a block
+   *
+   * This function converts the wavelength axes of all pixels of a block to
+   * d-spacing in one call using the equations of the vector version. Every
+   * pixel is converted with its own polar angle.
+   *
+   * \param wavelength (INPUT) is the block of wavelength axes in units of
+   * Angstroms
+   * \param polar_angle (INPUT) is the polar angle of every pixel in units
+   * of radians
+   * \param polar_angle_err2 (INPUT) is the square of the uncertainty in
+   * polar_angle
+   * \param d_spacing (OUTPUT) is the block of d-spacing axes in units of
+   * Angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if wavelength and d_spacing
+   * do not have the same number of pixels and bins, or if the polar_angle
+   * arrays do not have one element per spectrum.
+   */
+  template <typename NumT>
+  std::string
+  wavelength_to_d_spacing(const Nessi::SpectrumBlock<NumT> & wavelength,
+                          const Nessi::Vector<NumT> & polar_angle,
+                          const Nessi::Vector<NumT> & polar_angle_err2,
+                          Nessi::SpectrumBlock<NumT> & d_spacing,
+                          void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.25 applied to every
+   * pixel of a block with an execution policy
+   *
+   * This function converts the wavelength axes of all pixels of a block to
+   * d-spacing in one call using the equations of the vector version. Every
+   * pixel is converted with its own polar angle.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param wavelength (INPUT) is the block of wavelength axes in units of
+   * Angstroms
+   * \param polar_angle (INPUT) is the polar angle of every pixel in units
+   * of radians
+   * \param polar_angle_err2 (INPUT) is the square of the uncertainty in
+   * polar_angle
+   * \param d_spacing (OUTPUT) is the block of d-spacing axes in units of
+   * Angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if wavelength and d_spacing
+   * do not have the same number of pixels and bins, or if the polar_angle
+   * arrays do not have one element per spectrum.
+   */
+  template <typename NumT>
+  std::string
+  wavelength_to_d_spacing(const Nessi::ExecutionPolicy & policy,
+                          const Nessi::SpectrumBlock<NumT> & wavelength,
+                          const Nessi::Vector<NumT> & polar_angle,
+                          const Nessi::Vector<NumT> & polar_angle_err2,
+                          Nessi::SpectrumBlock<NumT> & d_spacing,
+                          void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.25 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be converted in place.
+   *
+   * \param wavelength (INPUT) is a view of the wavelength axis in units of
+   * angstroms
+   * \param wavelength_err2 (INPUT) is a view of the square of the
+   * uncertainty in the wavelength axis
+   * \param polar_angle (INPUT) is the polar angle in the equation above in
+   * units of radians
+   * \param polar_angle_err2 (INPUT) is the square of the uncertainty in
+   * polar
+   * \param d_spacing (OUTPUT) is a view of the d-spacing axis in units of
+   * Angstrom
+   * \param d_spacing_err2 (OUTPUT) is a view of the square of the
+   * uncertainty in the d-spacing axis
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  wavelength_to_d_spacing(const Nessi::VectorView<const NumT> & wavelength,
+                          const Nessi::VectorView<const NumT> &
+                          wavelength_err2,
+                          const NumT polar_angle,
+                          const NumT polar_angle_err2,
+                          const Nessi::VectorView<NumT> & d_spacing,
+                          const Nessi::VectorView<NumT> & d_spacing_err2,
+                          void *temp=NULL);
+
   /**
    * \}
    */ // end of wavelength_to_d_spacing group
@@ -3093,6 +5905,89 @@ namespace AxisManip
                        void *temp=NULL);
 
 
+  /**
+   * \brief This function is described in section 3.22 applied to every
+   * pixel of a block
+   *
+   * This function converts the wavelength axes of all pixels of a block
+   * to energy in one call using the equations of the vector version.
+   *
+   * \param wavelength (INPUT) is the block of wavelength axes in units of
+   * Angstroms
+   * \param energy (OUTPUT) is the block of energy axes in units of meV
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if wavelength and energy
+   * do not have the same number of pixels and bins.
+   */
+  template <typename NumT>
+  std::string
+  wavelength_to_energy(const Nessi::SpectrumBlock<NumT> & wavelength,
+                       Nessi::SpectrumBlock<NumT> & energy,
+                       void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.22 applied to every
+   * pixel of a block with an execution policy
+   *
+   * This function converts the wavelength axes of all pixels of a block
+   * to energy in one call using the equations of the vector version.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param wavelength (INPUT) is the block of wavelength axes in units of
+   * Angstroms
+   * \param energy (OUTPUT) is the block of energy axes in units of meV
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if wavelength and energy
+   * do not have the same number of pixels and bins.
+   */
+  template <typename NumT>
+  std::string
+  wavelength_to_energy(const Nessi::ExecutionPolicy & policy,
+                       const Nessi::SpectrumBlock<NumT> & wavelength,
+                       Nessi::SpectrumBlock<NumT> & energy,
+                       void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.22 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be converted in place.
+   *
+   * \param wavelength (INPUT) is a view of the wavelength axis in units of
+   * Angstroms
+   * \param wavelength_err2 (INPUT) is a view of the square of the
+   * uncertainty in the wavelength axis
+   * \param energy (OUTPUT) is a view of the energy axis in units of meV
+   * \param energy_err2 (OUTPUT) is a view of the square of the uncertainty
+   * in the energy axis
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  wavelength_to_energy(const Nessi::VectorView<const NumT> & wavelength,
+                       const Nessi::VectorView<const NumT> & wavelength_err2,
+                       const Nessi::VectorView<NumT> & energy,
+                       const Nessi::VectorView<NumT> & energy_err2,
+                       void *temp=NULL);
+
   /**
    * \}
    */ // end of wavelength_to_energy group
@@ -3186,6 +6081,94 @@ namespace AxisManip
                          NumT & wavevector_err2,
                          void *temp=NULL);
 
+  /**
+   * \brief This function is described in section 3.24 applied to every
+   * pixel of a block
+   *
+   * This function converts the wavelength axes of all pixels of a block to
+   * scalar wavevector in one call using the equations of the vector
+   * version.
+   *
+   * \param wavelength (INPUT) is the block of wavelength axes in units of
+   * Angstroms
+   * \param wavevector (OUTPUT) is the block of scalar wavevector axes in
+   * units of reciprocal Angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if wavelength and wavevector
+   * do not have the same number of pixels and bins.
+   */
+  template <typename NumT>
+  std::string
+  wavelength_to_scalar_k(const Nessi::SpectrumBlock<NumT> & wavelength,
+                         Nessi::SpectrumBlock<NumT> & wavevector,
+                         void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.24 applied to every
+   * pixel of a block with an execution policy
+   *
+   * This function converts the wavelength axes of all pixels of a block to
+   * scalar wavevector in one call using the equations of the vector
+   * version.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param wavelength (INPUT) is the block of wavelength axes in units of
+   * Angstroms
+   * \param wavevector (OUTPUT) is the block of scalar wavevector axes in
+   * units of reciprocal Angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if wavelength and wavevector
+   * do not have the same number of pixels and bins.
+   */
+  template <typename NumT>
+  std::string
+  wavelength_to_scalar_k(const Nessi::ExecutionPolicy & policy,
+                         const Nessi::SpectrumBlock<NumT> & wavelength,
+                         Nessi::SpectrumBlock<NumT> & wavevector,
+                         void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.24 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be converted in place.
+   *
+   * \param wavelength (INPUT) is a view of the wavelength axis in units of
+   * Angstroms
+   * \param wavelength_err2 (INPUT) is a view of the square of the
+   * uncertainty in the wavelength axis
+   * \param wavevector (OUTPUT) is a view of the scalar wavevector in units
+   * of reciprocal Angstroms
+   * \param wavevector_err2 (OUTPUT) is a view of the square of the
+   * uncertainty in the scalar wavevector
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  wavelength_to_scalar_k(const Nessi::VectorView<const NumT> & wavelength,
+                         const Nessi::VectorView<const NumT> & wavelength_err2,
+                         const Nessi::VectorView<NumT> & wavevector,
+                         const Nessi::VectorView<NumT> & wavevector_err2,
+                         void *temp=NULL);
+
   /**
    * \}
    */ // end of wavelength_to_scalar_k group
@@ -3291,6 +6274,184 @@ namespace AxisManip
                          NumT & Q_err2,
                          void *temp=NULL);
 
+  /**
+   * \brief This function is described in section 3.18 applied to every
+   * pixel of a block
+   *
+   * This function converts the wavelength axes of all pixels of a block
+   * to scalar momentum transfer in one call. Pixel \f$p\f$ is converted
+   * with its own polar angle \f$polar[p]\f$ using the equations of the
+   * vector version. The terms that only depend on the polar angle are
+   * computed for all pixels before the conversion, with the sines and
+   * cosines of the whole instrument evaluated together.
+   *
+   * \param wavelength (INPUT) is the block of wavelength axes in units
+   * of angstroms
+   * \param polar (INPUT) is the polar angle of every pixel in units of
+   * radians
+   * \param polar_err2 (INPUT) is the square of the uncertainty in
+   * polar
+   * \param Q (OUTPUT) is the block of scalar momentum transfer axes in
+   * units of reciprocal angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if wavelength and Q do not
+   * have the same number of pixels and bins, or if polar and polar_err2
+   * do not have one element per pixel.
+   */
+  template <typename NumT>
+  std::string
+  wavelength_to_scalar_Q(const Nessi::SpectrumBlock<NumT> & wavelength,
+                         const Nessi::Vector<NumT> & polar,
+                         const Nessi::Vector<NumT> & polar_err2,
+                         Nessi::SpectrumBlock<NumT> & Q,
+                         void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.18 applied to every
+   * pixel of a block with an execution policy
+   *
+   * This function converts the wavelength axes of all pixels of a block
+   * to scalar momentum transfer in one call. Pixel \f$p\f$ is converted
+   * with its own polar angle \f$polar[p]\f$ using the equations of the
+   * vector version. The terms that only depend on the polar angle are
+   * computed for all pixels before the conversion, with the sines and
+   * cosines of the whole instrument evaluated together.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param wavelength (INPUT) is the block of wavelength axes in units
+   * of angstroms
+   * \param polar (INPUT) is the polar angle of every pixel in units of
+   * radians
+   * \param polar_err2 (INPUT) is the square of the uncertainty in
+   * polar
+   * \param Q (OUTPUT) is the block of scalar momentum transfer axes in
+   * units of reciprocal angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if wavelength and Q do not
+   * have the same number of pixels and bins, or if polar and polar_err2
+   * do not have one element per pixel.
+   */
+  template <typename NumT>
+  std::string
+  wavelength_to_scalar_Q(const Nessi::ExecutionPolicy & policy,
+                         const Nessi::SpectrumBlock<NumT> & wavelength,
+                         const Nessi::Vector<NumT> & polar,
+                         const Nessi::Vector<NumT> & polar_err2,
+                         Nessi::SpectrumBlock<NumT> & Q,
+                         void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.18 applied to every
+   * pixel of a block with the constants of an InstrumentGeometryCache
+   *
+   * This function is the same as the block version taking the polar
+   * angle of every pixel, but the constants of pixel \f$p\f$ are read
+   * from \p geometry instead of being calculated.
+   *
+   * \param wavelength (INPUT) is the block of wavelength axes in units
+   * of angstroms
+   * \param geometry (INPUT) holds the constants of every pixel
+   * \param Q (OUTPUT) is the block of scalar momentum transfer axes in
+   * units of reciprocal angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if wavelength and Q do not
+   * have the same number of pixels and bins, or if geometry does not have
+   * one pixel per spectrum.
+   */
+  template <typename NumT>
+  std::string
+  wavelength_to_scalar_Q(const Nessi::SpectrumBlock<NumT> & wavelength,
+                         const InstrumentGeometryCache<NumT> & geometry,
+                         Nessi::SpectrumBlock<NumT> & Q,
+                         void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.18 applied to every
+   * pixel of a block with the constants of an InstrumentGeometryCache
+   * and an execution policy
+   *
+   * This function is the same as the block version taking the polar
+   * angle of every pixel, but the constants of pixel \f$p\f$ are read
+   * from \p geometry instead of being calculated.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param wavelength (INPUT) is the block of wavelength axes in units
+   * of angstroms
+   * \param geometry (INPUT) holds the constants of every pixel
+   * \param Q (OUTPUT) is the block of scalar momentum transfer axes in
+   * units of reciprocal angstroms
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if wavelength and Q do not
+   * have the same number of pixels and bins, or if geometry does not have
+   * one pixel per spectrum.
+   */
+  template <typename NumT>
+  std::string
+  wavelength_to_scalar_Q(const Nessi::ExecutionPolicy & policy,
+                         const Nessi::SpectrumBlock<NumT> & wavelength,
+                         const InstrumentGeometryCache<NumT> & geometry,
+                         Nessi::SpectrumBlock<NumT> & Q,
+                         void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.18 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be converted in place.
+   *
+   * \param wavelength (INPUT) is a view of the wavelength axis in units of
+   * angstroms
+   * \param wavelength_err2 (INPUT) is a view of the square of the
+   * uncertainty in the wavelength axis
+   * \param polar_angle (INPUT) is the polar angle in the equation above in
+   * units of radians
+   * \param polar_angle_err2 (INPUT) is the square of the uncertainty in
+   * polar
+   * \param Q (OUTPUT) is a view of the scalar momentum transfer, Q, axis in
+   * units of reciprocal angstroms
+   * \param Q_err2 (OUTPUT) is a view of the square of the uncertainty in
+   * the scalar momentum transfer axis
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  wavelength_to_scalar_Q(const Nessi::VectorView<const NumT> & wavelength,
+                         const Nessi::VectorView<const NumT> & wavelength_err2,
+                         const NumT polar_angle,
+                         const NumT polar_angle_err2,
+                         const Nessi::VectorView<NumT> & Q,
+                         const Nessi::VectorView<NumT> & Q_err2,
+                         void *temp=NULL);
+
   /**
    * \}
    */ // end of wavelength_to_scalar_Q group
@@ -3402,6 +6563,114 @@ namespace AxisManip
                     NumT & tof_err2,
                     void *temp=NULL);
 
+  /**
+   * \brief This function is described in section 3.16 applied to every
+   * pixel of a block
+   *
+   * This function converts the wavelength axes of all pixels of a block to
+   * time-of-flight in one call using the equations of the vector version.
+   * Every pixel is converted with its own flight path.
+   *
+   * \param wavelength (INPUT) is the block of wavelength axes in units of
+   * Angstroms
+   * \param pathlength (INPUT) is the total flight path of every pixel in
+   * units of meter
+   * \param pathlength_err2 (INPUT) is the square of the uncertainty in
+   * pathlength
+   * \param tof (OUTPUT) is the block of time-of-flight axes in units of
+   * microseconds
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if wavelength and tof do not
+   * have the same number of pixels and bins, or if the pathlength arrays do
+   * not have one element per spectrum.
+   */
+  template <typename NumT>
+  std::string
+  wavelength_to_tof(const Nessi::SpectrumBlock<NumT> & wavelength,
+                    const Nessi::Vector<NumT> & pathlength,
+                    const Nessi::Vector<NumT> & pathlength_err2,
+                    Nessi::SpectrumBlock<NumT> & tof,
+                    void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.16 applied to every
+   * pixel of a block with an execution policy
+   *
+   * This function converts the wavelength axes of all pixels of a block to
+   * time-of-flight in one call using the equations of the vector version.
+   * Every pixel is converted with its own flight path.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param wavelength (INPUT) is the block of wavelength axes in units of
+   * Angstroms
+   * \param pathlength (INPUT) is the total flight path of every pixel in
+   * units of meter
+   * \param pathlength_err2 (INPUT) is the square of the uncertainty in
+   * pathlength
+   * \param tof (OUTPUT) is the block of time-of-flight axes in units of
+   * microseconds
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if wavelength and tof do not
+   * have the same number of pixels and bins, or if the pathlength arrays do
+   * not have one element per spectrum.
+   */
+  template <typename NumT>
+  std::string
+  wavelength_to_tof(const Nessi::ExecutionPolicy & policy,
+                    const Nessi::SpectrumBlock<NumT> & wavelength,
+                    const Nessi::Vector<NumT> & pathlength,
+                    const Nessi::Vector<NumT> & pathlength_err2,
+                    Nessi::SpectrumBlock<NumT> & tof,
+                    void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.16 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be converted in place.
+   *
+   * \param wavelength (INPUT) is a view of the wavelength axis in units of
+   * angstroms
+   * \param wavelength_err2 (INPUT) is a view of the square of the
+   * uncertainty in the wavelength axis
+   * \param pathlength (INPUT) is the total flight path of the neutron in
+   * units of meter
+   * \param pathlength_err2 (INPUT) is the square of the uncertainty in
+   * pathlength
+   * \param tof (OUTPUT) is a view of the time-of-flight axis in units of
+   * micro-seconds
+   * \param tof_err2 (OUTPUT) is a view of the square of the uncertainty in
+   * the time-of-flight axis
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  wavelength_to_tof(const Nessi::VectorView<const NumT> & wavelength,
+                    const Nessi::VectorView<const NumT> & wavelength_err2,
+                    const NumT pathlength,
+                    const NumT pathlength_err2,
+                    const Nessi::VectorView<NumT> & tof,
+                    const Nessi::VectorView<NumT> & tof_err2,
+                    void *temp=NULL);
+
   /**
    * \}
    */ // end of wavelength_to_tof group
@@ -3492,6 +6761,92 @@ namespace AxisManip
                          NumT & velocity_err2,
                          void *temp=NULL);
 
+  /**
+   * \brief This function is described in section 3.20 applied to every
+   * pixel of a block
+   *
+   * This function converts the wavelength axes of all pixels of a block to
+   * velocity in one call using the equations of the vector version.
+   *
+   * \param wavelength (INPUT) is the block of wavelength axes in units of
+   * Angstroms
+   * \param velocity (OUTPUT) is the block of velocity axes in units of
+   * meter/micro-seconds
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if wavelength and velocity
+   * do not have the same number of pixels and bins.
+   */
+  template <typename NumT>
+  std::string
+  wavelength_to_velocity(const Nessi::SpectrumBlock<NumT> & wavelength,
+                         Nessi::SpectrumBlock<NumT> & velocity,
+                         void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.20 applied to every
+   * pixel of a block with an execution policy
+   *
+   * This function converts the wavelength axes of all pixels of a block to
+   * velocity in one call using the equations of the vector version.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param wavelength (INPUT) is the block of wavelength axes in units of
+   * Angstroms
+   * \param velocity (OUTPUT) is the block of velocity axes in units of
+   * meter/micro-seconds
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if wavelength and velocity
+   * do not have the same number of pixels and bins.
+   */
+  template <typename NumT>
+  std::string
+  wavelength_to_velocity(const Nessi::ExecutionPolicy & policy,
+                         const Nessi::SpectrumBlock<NumT> & wavelength,
+                         Nessi::SpectrumBlock<NumT> & velocity,
+                         void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.20 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be converted in place.
+   *
+   * \param wavelength (INPUT) is a view of the wavelength axis in units of
+   * Angstroms
+   * \param wavelength_err2 (INPUT) is a view of the square of the
+   * uncertainty in the wavelength axis
+   * \param velocity (OUTPUT) is a view of the velocity axis in units of
+   * meter/micro-seconds
+   * \param velocity_err2 (OUTPUT) is a view of the square of the
+   * uncertainty in the velocity axis
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  wavelength_to_velocity(const Nessi::VectorView<const NumT> & wavelength,
+                         const Nessi::VectorView<const NumT> & wavelength_err2,
+                         const Nessi::VectorView<NumT> & velocity,
+                         const Nessi::VectorView<NumT> & velocity_err2,
+                         void *temp=NULL);
+
   /**
    * \}
    */ // end of wavelength_to_velocity group
@@ -31,6 +31,11 @@
 #define _REBINNING_HPP 1
 
 #include "nessi.hpp"
+#include "nessi_block.hpp"
+#include "nessi_exec.hpp"
+#include "nessi_sparse.hpp"
+#include "nessi_view.hpp"
+#include <iosfwd>
 #include <string>
 
 namespace AxisManip
@@ -65,6 +70,12 @@ namespace AxisManip
    *
    * <IMG SRC="../images/Rebin_2D_Quad_To_Rectlin_RebinHist.png">
    *
+   * Since the grid bins are rectangles parallel to the axes, the overlaps
+   * are found by clipping every quadrilateral against the edges of the grid
+   * bins, see Utils::__clip_quad_to_rectangle(), without allocating any
+   * memory. The placeholder arrays are no longer used, only their sizes are
+   * checked.
+   *
    * \param axis_in_x1 (INPUT) is the x-coordinate of the 1st corner of the 
    * initial data axis
    * \param axis_in_y1 (INPUT) is the y-coordinate of the 1st corner of the 
@@ -148,6 +159,515 @@ namespace AxisManip
                            Nessi::Vector<NumT> & bin_count,
                            void *temp=NULL);
 
+  /**
+   * \brief This function is described in section 3.61.
+   *
+   * This function is the same as rebin_2D_quad_to_rectlin() without the
+   * placeholder arrays, with the rows of the grid (the bins of the 1st
+   * target axis) distributed over the threads of the library according to
+   * \p policy. Every thread clips all quadrilaterals against its own rows
+   * only, so the threads write to separate parts of the rebinned arrays
+   * and every grid bin receives the overlaps in the order of the
+   * quadrilaterals. The result is therefore identical to the sequential
+   * version for any number of threads. The function keeps no state
+   * between calls and can be called from several threads at once with
+   * different output arrays.
+   *
+   * \param policy (INPUT) is the execution policy of the call
+   * \param axis_in_x1 (INPUT) is the x-coordinate of the 1st corner of the
+   * initial data axis
+   * \param axis_in_y1 (INPUT) is the y-coordinate of the 1st corner of the
+   * initial data axis
+   * \param axis_in_x2 (INPUT) is the x-coordinate of the 2nd corner of the
+   * initial data axis
+   * \param axis_in_y2 (INPUT) is the y-coordinate of the 2nd corner of the
+   * initial data axis
+   * \param axis_in_x3 (INPUT) is the x-coordinate of the 3rd corner of the
+   * initial data axis
+   * \param axis_in_y3 (INPUT) is the y-coordinate of the 3rd corner of the
+   * initial data axis
+   * \param axis_in_x4 (INPUT) is the x-coordinate of the 4th corner of the
+   * initial data axis
+   * \param axis_in_y4 (INPUT) is the y-coordinate of the 4th corner of the
+   * initial data axis
+   * \param input (INPUT) is the data associated with the initial axis
+   * \param input_err2 (INPUT) is the square of the uncertainty associated
+   * with the data
+   * \param axis_out_1 (INPUT) is the 1st (x-coordinate) target axis for
+   * rebinning
+   * \param axis_out_2 (INPUT) is the 2nd (y-coordinate) target axis for
+   * rebinning
+   * \param output (OUTPUT) is the rebinned data according to the target axis
+   * \param output_err2 (OUTPUT) is the square of the uncertainty associated
+   * with the rebinned data
+   * \param frac_area (OUTPUT) is the fractional area accumulated during
+   * rebinning
+   * \param bin_count (OUTPUT) is the tracking array for the contribution of
+   * the data to the rebinned data. This will either be 0 or 1 for each bin.
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown in the same cases as
+   * rebin_2D_quad_to_rectlin() and if frac_area is not the size of output.
+   * When several quadrilaterals cannot be clipped, the error of the first
+   * one is thrown.
+   */
+  template <typename NumT>
+  std::string
+  rebin_2D_quad_to_rectlin(const Nessi::ExecutionPolicy & policy,
+                           const Nessi::Vector<NumT> & axis_in_x1,
+                           const Nessi::Vector<NumT> & axis_in_y1,
+                           const Nessi::Vector<NumT> & axis_in_x2,
+                           const Nessi::Vector<NumT> & axis_in_y2,
+                           const Nessi::Vector<NumT> & axis_in_x3,
+                           const Nessi::Vector<NumT> & axis_in_y3,
+                           const Nessi::Vector<NumT> & axis_in_x4,
+                           const Nessi::Vector<NumT> & axis_in_y4,
+                           const Nessi::Vector<NumT> & input,
+                           const Nessi::Vector<NumT> & input_err2,
+                           const Nessi::Vector<NumT> & axis_out_1,
+                           const Nessi::Vector<NumT> & axis_out_2,
+                           Nessi::Vector<NumT> & output,
+                           Nessi::Vector<NumT> & output_err2,
+                           Nessi::Vector<NumT> & frac_area,
+                           Nessi::Vector<NumT> & bin_count,
+                           void *temp=NULL);
+
+  /**
+   * \brief Validated step of rebin_2D_quad_to_rectlin()
+   *
+   * A reduction usually calls rebin_2D_quad_to_rectlin() once per pixel.
+   * The grid, the output arrays and the number of quadrilaterals are the
+   * same for every pixel, but the function checks all of their sizes again
+   * on every call. A Rebin2DQuadToRectlinStep checks them once, when it is
+   * constructed, and keeps references to the grid and the output arrays.
+   * Every call of execute() then only compares the size of each of its
+   * arrays with num_quads() before it rebins one set of quadrilaterals
+   * into the output.
+   *
+   * The arrays given to the constructor must outlive the step and must not
+   * be resized while it is in use.
+   */
+  template <typename NumT>
+  class Rebin2DQuadToRectlinStep
+  {
+  public:
+    /**
+     * \brief Constructor checking the shapes of the step
+     *
+     * \param num_quads (INPUT) is the number of quadrilaterals given to
+     * every call of execute()
+     * \param axis_out_1 (INPUT) same as the parameter in
+     * rebin_2D_quad_to_rectlin()
+     * \param axis_out_2 (INPUT) same as the parameter in
+     * rebin_2D_quad_to_rectlin()
+     * \param output (OUTPUT) same as the parameter in
+     * rebin_2D_quad_to_rectlin()
+     * \param output_err2 (OUTPUT) same as the parameter in
+     * rebin_2D_quad_to_rectlin()
+     * \param frac_area (OUTPUT) same as the parameter in
+     * rebin_2D_quad_to_rectlin()
+     * \param bin_count (OUTPUT) same as the parameter in
+     * rebin_2D_quad_to_rectlin()
+     *
+     * \exception std::invalid_argument is thrown if the sizes of
+     * axis_out_1, axis_out_2, output and output_err2 are not that of a
+     * histogram dataset
+     * \exception std::invalid_argument is thrown if frac_area or bin_count
+     * is not the size of output
+     */
+    Rebin2DQuadToRectlinStep(const std::size_t num_quads,
+                             const Nessi::Vector<NumT> & axis_out_1,
+                             const Nessi::Vector<NumT> & axis_out_2,
+                             Nessi::Vector<NumT> & output,
+                             Nessi::Vector<NumT> & output_err2,
+                             Nessi::Vector<NumT> & frac_area,
+                             Nessi::Vector<NumT> & bin_count);
+
+    /**
+     * \brief Returns the number of quadrilaterals of every call
+     */
+    std::size_t num_quads() const;
+
+    /**
+     * \brief Rebins one set of quadrilaterals
+     *
+     * The parameters are the same as the ones of
+     * rebin_2D_quad_to_rectlin(). Each array has num_quads() elements.
+     *
+     * \return A set of warnings generated by the function
+     *
+     * \exception std::invalid_argument is thrown if an array does not have
+     * num_quads() elements
+     * \exception std::invalid_argument is thrown if two quadrilaterals
+     * cannot be intersected
+     */
+    std::string execute(const Nessi::Vector<NumT> & axis_in_x1,
+                        const Nessi::Vector<NumT> & axis_in_y1,
+                        const Nessi::Vector<NumT> & axis_in_x2,
+                        const Nessi::Vector<NumT> & axis_in_y2,
+                        const Nessi::Vector<NumT> & axis_in_x3,
+                        const Nessi::Vector<NumT> & axis_in_y3,
+                        const Nessi::Vector<NumT> & axis_in_x4,
+                        const Nessi::Vector<NumT> & axis_in_y4,
+                        const Nessi::Vector<NumT> & input,
+                        const Nessi::Vector<NumT> & input_err2,
+                        void *temp=NULL);
+
+  private:
+    /// Number of quadrilaterals of every call
+    std::size_t num_quads_;
+    /// The 1st target axis
+    const Nessi::Vector<NumT> * axis_out_1_;
+    /// The 2nd target axis
+    const Nessi::Vector<NumT> * axis_out_2_;
+    /// The rebinned data
+    Nessi::Vector<NumT> * output_;
+    /// The square of the uncertainty of the rebinned data
+    Nessi::Vector<NumT> * output_err2_;
+    /// The accumulated fractional area
+    Nessi::Vector<NumT> * frac_area_;
+    /// The contribution of the data to the rebinned data
+    Nessi::Vector<NumT> * bin_count_;
+  };
+
+  /**
+   * \brief Precomputed overlaps of rebin_2D_quad_to_rectlin()
+   *
+   * For a given instrument the quadrilaterals given to
+   * rebin_2D_quad_to_rectlin() are the same for every run, only the data
+   * change. A Rebin2DQuadToRectlinPlan intersects the quadrilaterals with
+   * the grid once, when it is constructed, and stores for every
+   * quadrilateral \f$k\f$ the grid bins \f$c\f$ it overlaps together with
+   * the area of the overlap \f$a_{kc}\f$. Applying the plan is then a
+   * sparse product without any geometry:
+   *
+   * \f[
+   * data_{out}[c] = data_{out}[c] + \sum_k data_{in}[k] \times a_{kc}
+   * \f]
+   * \f[
+   * \sigma_{out}^2[c] = \sigma_{out}^2[c] + \sum_k \sigma_{in}^2[k]
+   * \times a_{kc}^2
+   * \f]
+   * \f[
+   * f[c] = f[c] + \sum_k a_{kc}
+   * \f]
+   *
+   * and the bin count of every overlapped grid bin is set to one. The
+   * terms are added in the same order as in rebin_2D_quad_to_rectlin(), so
+   * the results are identical.
+   *
+   * A plan can be written to a stream with save() and read back with
+   * load(), so it can be reused across sessions. The format is text and
+   * keeps the areas exactly.
+   */
+  template <typename NumT>
+  class Rebin2DQuadToRectlinPlan
+  {
+  public:
+    /**
+     * \brief Constructor for an empty plan, to be filled with load()
+     */
+    Rebin2DQuadToRectlinPlan();
+
+    /**
+     * \brief Constructor intersecting the quadrilaterals with the grid
+     *
+     * The parameters are the same as the ones of
+     * rebin_2D_quad_to_rectlin().
+     *
+     * \exception std::invalid_argument is thrown if the coordinate arrays
+     * do not all have the same size or if an axis is empty
+     * \exception std::invalid_argument is thrown if two quadrilaterals
+     * cannot be intersected
+     */
+    Rebin2DQuadToRectlinPlan(const Nessi::Vector<NumT> & axis_in_x1,
+                             const Nessi::Vector<NumT> & axis_in_y1,
+                             const Nessi::Vector<NumT> & axis_in_x2,
+                             const Nessi::Vector<NumT> & axis_in_y2,
+                             const Nessi::Vector<NumT> & axis_in_x3,
+                             const Nessi::Vector<NumT> & axis_in_y3,
+                             const Nessi::Vector<NumT> & axis_in_x4,
+                             const Nessi::Vector<NumT> & axis_in_y4,
+                             const Nessi::Vector<NumT> & axis_out_1,
+                             const Nessi::Vector<NumT> & axis_out_2,
+                             void *temp=NULL);
+
+    /**
+     * \brief Returns the number of quadrilaterals
+     */
+    std::size_t num_quads() const;
+
+    /**
+     * \brief Returns the number of bins of the 1st target axis
+     */
+    std::size_t num_bins_out_1() const;
+
+    /**
+     * \brief Returns the number of bins of the 2nd target axis
+     */
+    std::size_t num_bins_out_2() const;
+
+    /**
+     * \brief Returns the number of overlapping pairs of bins
+     */
+    std::size_t num_weights() const;
+
+    /**
+     * \brief Rebins the data of the quadrilaterals onto the grid
+     *
+     * The parameters are the same as the ones of
+     * rebin_2D_quad_to_rectlin().
+     *
+     * \return A set of warnings generated by the function
+     *
+     * \exception std::invalid_argument is thrown if input and input_err2
+     * do not have num_quads() elements or if output, output_err2,
+     * frac_area and bin_count do not have one element per grid bin
+     */
+    std::string apply(const Nessi::Vector<NumT> & input,
+                      const Nessi::Vector<NumT> & input_err2,
+                      Nessi::Vector<NumT> & output,
+                      Nessi::Vector<NumT> & output_err2,
+                      Nessi::Vector<NumT> & frac_area,
+                      Nessi::Vector<NumT> & bin_count,
+                      void *temp=NULL) const;
+
+    /**
+     * \brief Writes the plan to a stream
+     *
+     * \param out (OUTPUT) is the stream to write to
+     */
+    void save(std::ostream & out) const;
+
+    /**
+     * \brief Replaces the plan by one read from a stream
+     *
+     * \param in (INPUT) is the stream written by save()
+     *
+     * \exception std::invalid_argument is thrown if the stream does not
+     * hold a valid plan. The plan is left unchanged.
+     */
+    void load(std::istream & in);
+
+  private:
+    /// Number of bins of the 1st target axis
+    std::size_t num_bins_out_1_;
+    /// Number of bins of the 2nd target axis
+    std::size_t num_bins_out_2_;
+    /// First weight of every quadrilateral, one more than the quadrilaterals
+    Nessi::Vector<std::size_t> offset_;
+    /// Grid bin of every weight
+    Nessi::Vector<std::size_t> channel_;
+    /// The overlap areas
+    Nessi::Vector<NumT> weight_;
+  };
+
+  /**
+   * \brief Quadrilaterals of rebin_2D_quad_to_rectlin() bucketed by tiles
+   * of the grid
+   *
+   * The quadrilaterals are usually given in the order of the detector
+   * pixels, so consecutive quadrilaterals fall on distant parts of the
+   * grid and rebinning onto a large grid misses the cache for nearly every
+   * overlap. A Rebin2DQuadToRectlinTiling cuts the grid into tiles of
+   * \f$tile\_size\_1 \times tile\_size\_2\f$ bins and, when it is
+   * constructed, lists for every tile the quadrilaterals whose bounding
+   * box covers it. The quadrilaterals of a tile are then rebinned together
+   * and only touch the bins of that tile.
+   *
+   * Tile \f$t\f$ holds the bins \f$[begin_1, end_1) \times [begin_2,
+   * end_2)\f$ given by tile_bounds(), and the tiles are numbered like the
+   * grid bins, along the 2nd target axis first. apply() fills the whole
+   * grid one tile after the other. apply_tile() fills a single tile into
+   * arrays of that tile only, so a grid larger than the memory can be
+   * rebinned one tile at a time and every tile written out before the
+   * next one is computed.
+   *
+   * Every grid bin receives the overlaps in the order of the
+   * quadrilaterals, so the results are identical to the ones of
+   * rebin_2D_quad_to_rectlin(). The tiling keeps references to the
+   * coordinates and the target axes, which must not change or go away
+   * while it is used.
+   */
+  template <typename NumT>
+  class Rebin2DQuadToRectlinTiling
+  {
+  public:
+    /**
+     * \brief Constructor bucketing the quadrilaterals by tiles
+     *
+     * \param axis_in_x1 (INPUT) is the x-coordinate of the 1st corners
+     * \param axis_in_y1 (INPUT) is the y-coordinate of the 1st corners
+     * \param axis_in_x2 (INPUT) is the x-coordinate of the 2nd corners
+     * \param axis_in_y2 (INPUT) is the y-coordinate of the 2nd corners
+     * \param axis_in_x3 (INPUT) is the x-coordinate of the 3rd corners
+     * \param axis_in_y3 (INPUT) is the y-coordinate of the 3rd corners
+     * \param axis_in_x4 (INPUT) is the x-coordinate of the 4th corners
+     * \param axis_in_y4 (INPUT) is the y-coordinate of the 4th corners
+     * \param axis_out_1 (INPUT) is the 1st (x-coordinate) target axis
+     * \param axis_out_2 (INPUT) is the 2nd (y-coordinate) target axis
+     * \param tile_size_1 (INPUT) is the number of bins of a tile along the
+     * 1st target axis
+     * \param tile_size_2 (INPUT) is the number of bins of a tile along the
+     * 2nd target axis
+     *
+     * \exception std::invalid_argument is thrown if the coordinate arrays
+     * do not all have the same size, if an axis is empty or if a tile size
+     * is zero
+     */
+    Rebin2DQuadToRectlinTiling(const Nessi::Vector<NumT> & axis_in_x1,
+                               const Nessi::Vector<NumT> & axis_in_y1,
+                               const Nessi::Vector<NumT> & axis_in_x2,
+                               const Nessi::Vector<NumT> & axis_in_y2,
+                               const Nessi::Vector<NumT> & axis_in_x3,
+                               const Nessi::Vector<NumT> & axis_in_y3,
+                               const Nessi::Vector<NumT> & axis_in_x4,
+                               const Nessi::Vector<NumT> & axis_in_y4,
+                               const Nessi::Vector<NumT> & axis_out_1,
+                               const Nessi::Vector<NumT> & axis_out_2,
+                               const std::size_t tile_size_1,
+                               const std::size_t tile_size_2);
+
+    /**
+     * \brief Returns the number of quadrilaterals
+     */
+    std::size_t num_quads() const;
+
+    /**
+     * \brief Returns the number of tiles
+     */
+    std::size_t num_tiles() const;
+
+    /**
+     * \brief Returns the number of quadrilaterals listed for tile \p tile
+     */
+    std::size_t num_quads(const std::size_t tile) const;
+
+    /**
+     * \brief Returns the grid bins of a tile
+     *
+     * \param tile (INPUT) is the index of the tile
+     * \param begin_1 (OUTPUT) is the first bin on the 1st target axis
+     * \param end_1 (OUTPUT) is one past the last bin on the 1st target axis
+     * \param begin_2 (OUTPUT) is the first bin on the 2nd target axis
+     * \param end_2 (OUTPUT) is one past the last bin on the 2nd target axis
+     *
+     * \exception std::invalid_argument is thrown if the tile does not
+     * exist
+     */
+    void tile_bounds(const std::size_t tile,
+                     std::size_t & begin_1,
+                     std::size_t & end_1,
+                     std::size_t & begin_2,
+                     std::size_t & end_2) const;
+
+    /**
+     * \brief Rebins the data of the quadrilaterals onto the whole grid,
+     * one tile after the other
+     *
+     * The parameters are the same as the ones of
+     * rebin_2D_quad_to_rectlin().
+     *
+     * \return A set of warnings generated by the function
+     *
+     * \exception std::invalid_argument is thrown if input and input_err2
+     * do not have num_quads() elements or if output, output_err2,
+     * frac_area and bin_count do not have one element per grid bin
+     * \exception std::invalid_argument is thrown if a quadrilateral cannot
+     * be clipped
+     */
+    std::string apply(const Nessi::Vector<NumT> & input,
+                      const Nessi::Vector<NumT> & input_err2,
+                      Nessi::Vector<NumT> & output,
+                      Nessi::Vector<NumT> & output_err2,
+                      Nessi::Vector<NumT> & frac_area,
+                      Nessi::Vector<NumT> & bin_count,
+                      void *temp=NULL) const;
+
+    /**
+     * \brief Rebins the data of the quadrilaterals onto a single tile
+     *
+     * The arrays of the tile hold its bins in the order of the grid, bin
+     * \f$(i, j)\f$ of the grid being element \f$(j - begin_2) + (i -
+     * begin_1) \times (end_2 - begin_2)\f$. The other parameters are the
+     * same as the ones of rebin_2D_quad_to_rectlin().
+     *
+     * \param tile (INPUT) is the index of the tile
+     * \param input (INPUT) is the data associated with the quadrilaterals
+     * \param input_err2 (INPUT) is the square of the uncertainty of the data
+     * \param tile_output (OUTPUT) is the rebinned data of the tile
+     * \param tile_output_err2 (OUTPUT) is the square of the uncertainty of
+     * the rebinned data of the tile
+     * \param tile_frac_area (OUTPUT) is the fractional area of the tile
+     * \param tile_bin_count (OUTPUT) is the bin count of the tile
+     * \param temp holds temporary memory to be passed to the function
+     *
+     * \return A set of warnings generated by the function
+     *
+     * \exception std::invalid_argument is thrown if the tile does not
+     * exist, if input and input_err2 do not have num_quads() elements or
+     * if the arrays of the tile do not have one element per bin of the tile
+     * \exception std::invalid_argument is thrown if a quadrilateral cannot
+     * be clipped
+     */
+    std::string apply_tile(const std::size_t tile,
+                           const Nessi::Vector<NumT> & input,
+                           const Nessi::Vector<NumT> & input_err2,
+                           Nessi::Vector<NumT> & tile_output,
+                           Nessi::Vector<NumT> & tile_output_err2,
+                           Nessi::Vector<NumT> & tile_frac_area,
+                           Nessi::Vector<NumT> & tile_bin_count,
+                           void *temp=NULL) const;
+
+  private:
+    /**
+     * This is a PRIVATE helper checking the data of the quadrilaterals.
+     */
+    void check_input(const Nessi::Vector<NumT> & input,
+                     const Nessi::Vector<NumT> & input_err2) const;
+
+    /**
+     * This is a PRIVATE helper passing the overlaps of the quadrilaterals
+     * of a tile with the bins of that tile to \p accum.
+     */
+    template <typename AccumT>
+    void rebin_tile(const std::size_t tile, AccumT & accum) const;
+
+    /// The x-coordinate of the 1st corners
+    const Nessi::Vector<NumT> * axis_in_x1_;
+    /// The y-coordinate of the 1st corners
+    const Nessi::Vector<NumT> * axis_in_y1_;
+    /// The x-coordinate of the 2nd corners
+    const Nessi::Vector<NumT> * axis_in_x2_;
+    /// The y-coordinate of the 2nd corners
+    const Nessi::Vector<NumT> * axis_in_y2_;
+    /// The x-coordinate of the 3rd corners
+    const Nessi::Vector<NumT> * axis_in_x3_;
+    /// The y-coordinate of the 3rd corners
+    const Nessi::Vector<NumT> * axis_in_y3_;
+    /// The x-coordinate of the 4th corners
+    const Nessi::Vector<NumT> * axis_in_x4_;
+    /// The y-coordinate of the 4th corners
+    const Nessi::Vector<NumT> * axis_in_y4_;
+    /// The 1st target axis
+    const Nessi::Vector<NumT> * axis_out_1_;
+    /// The 2nd target axis
+    const Nessi::Vector<NumT> * axis_out_2_;
+    /// Number of bins of a tile along the 1st target axis
+    std::size_t tile_size_1_;
+    /// Number of bins of a tile along the 2nd target axis
+    std::size_t tile_size_2_;
+    /// Number of tiles along the 2nd target axis
+    std::size_t num_tiles_2_;
+    /// First quadrilateral of every tile, one more than the tiles
+    Nessi::Vector<std::size_t> offset_;
+    /// Quadrilaterals of the tiles, in increasing order in every tile
+    Nessi::Vector<std::size_t> quad_;
+  };
+
   /**
    * \}
    */ // end of rebin_2D_quad_to_rectlin group
@@ -298,6 +818,117 @@ namespace AxisManip
                 Nessi::Vector<NumT> & output_err2,
                 void *temp=NULL);
 
+  /**
+   * \brief This function is described in section 3.12 applied to every
+   * spectrum of a block
+   *
+   * This function rebins all spectra of a block that share the same
+   * initial axis onto the same target axis in one call. Spectrum \f$p\f$ of
+   * the output is the result of the vector version of this function for
+   * spectrum \f$p\f$ of the input. As in the vector version the rebinned
+   * portions are added to the output, which should be zero filled.
+   *
+   * \param axis_in (INPUT) is the initial data axis of every spectrum
+   * \param input (INPUT) is the block of spectra associated with the
+   * initial axis
+   * \param axis_out (INPUT) is the target axis for rebinning
+   * \param output (OUTPUT) is the block of rebinned spectra
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the size of axis_in
+   * is not one more than the number of bins of input.
+   * \exception std::invalid_argument is thrown if the size of axis_out
+   * is not one more than the number of bins of output.
+   * \exception std::invalid_argument is thrown if input and output do not
+   * have the same number of spectra.
+   */
+  template <typename NumT>
+  std::string
+  rebin_axis_1D(const Nessi::Vector<NumT> & axis_in,
+                const Nessi::SpectrumBlock<NumT> & input,
+                const Nessi::Vector<NumT> & axis_out,
+                Nessi::SpectrumBlock<NumT> & output,
+                void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.12 applied to every
+   * spectrum of a block with an execution policy
+   *
+   * This function rebins all spectra of a block that share the same
+   * initial axis onto the same target axis in one call. Spectrum \f$p\f$ of
+   * the output is the result of the vector version of this function for
+   * spectrum \f$p\f$ of the input. As in the vector version the rebinned
+   * portions are added to the output, which should be zero filled.
+   *
+   * The spectra are distributed as selected by \p policy, see
+   * Nessi::ExecutionPolicy. The result does not depend on the policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param axis_in (INPUT) is the initial data axis of every spectrum
+   * \param input (INPUT) is the block of spectra associated with the
+   * initial axis
+   * \param axis_out (INPUT) is the target axis for rebinning
+   * \param output (OUTPUT) is the block of rebinned spectra
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the size of axis_in
+   * is not one more than the number of bins of input.
+   * \exception std::invalid_argument is thrown if the size of axis_out
+   * is not one more than the number of bins of output.
+   * \exception std::invalid_argument is thrown if input and output do not
+   * have the same number of spectra.
+   */
+  template <typename NumT>
+  std::string
+  rebin_axis_1D(const Nessi::ExecutionPolicy & policy,
+                const Nessi::Vector<NumT> & axis_in,
+                const Nessi::SpectrumBlock<NumT> & input,
+                const Nessi::Vector<NumT> & axis_out,
+                Nessi::SpectrumBlock<NumT> & output,
+                void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.12 applied to views
+   *
+   * This function is the same as the vector version, but the data arrays
+   * are Nessi::VectorView objects. A row or a column of a larger array can
+   * therefore be rebinned in place. As in the vector version the rebinned
+   * portions are added to the output, which should be zero filled.
+   *
+   * \param axis_in (INPUT) is the initial data axis
+   * \param input (INPUT) is the data associated with the initial axis
+   * \param input_err2 (INPUT) is the square of the uncertainty associated
+   * with the data
+   * \param axis_out (INPUT) is the target axis for rebinning
+   * \param output (OUTPUT) is the rebinned data according to the target axis
+   * \param output_err2 (OUTPUT) is the square of the uncertainty associated
+   * with the rebinned data
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the size of axis_in
+   * is not one more than the size of input and input_err2.
+   * \exception std::invalid_argument is thrown if the size of
+   * axis_out is not one more than the size of output and output_err2.
+   */
+  template <typename NumT>
+  std::string
+  rebin_axis_1D(const Nessi::Vector<NumT> & axis_in,
+                const Nessi::VectorView<const NumT> & input,
+                const Nessi::VectorView<const NumT> & input_err2,
+                const Nessi::Vector<NumT> & axis_out,
+                const Nessi::VectorView<NumT> & output,
+                const Nessi::VectorView<NumT> & output_err2,
+                void *temp=NULL);
+
   /**
    * \}
    */ // end of rebin_axis_1D group
@@ -380,6 +1011,200 @@ namespace AxisManip
    * \}
    */ // end of rebin_axis_1D_frac group
 
+  /**
+   * \defgroup rebin_plan_1D AxisManip::RebinPlan1D
+   * \{
+   */
+
+  template <typename NumT>
+  class __RebinPlan1DBlock;
+
+  template <typename NumT>
+  class __RebinAxis2DRows;
+
+  /**
+   * \brief Precomputed overlap weights between two one-dimensional axes
+   *
+   * rebin_axis_1D() and rebin_axis_1D_frac() walk both axes to find the
+   * overlapping bins on every call. When many spectra share the same pair
+   * of axes, a RebinPlan1D does the walk once, when it is constructed, and
+   * stores for every target bin \f$k\f$ the initial bins \f$j\f$ that
+   * overlap it together with their weight \f$w_{jk}\f$. Applying the plan
+   * to a spectrum is then
+   *
+   * \f[
+   * data_{out}[k] = data_{out}[k] + \sum_j data_{in}[j] \times w_{jk}
+   * \f]
+   * \f[
+   * \sigma_{out}^2[k] = \sigma_{out}^2[k] + \sum_j \sigma_{in}^2[j]
+   * \times w_{jk}^2
+   * \f]
+   *
+   * where the terms are added in the order of the walk, so the result is
+   * identical to the one of the function the plan was built for:
+   * - RebinPlan1D::REBIN_AXIS_1D uses the fraction of the initial bin
+   * covered by the target bin as weight, like rebin_axis_1D().
+   * - RebinPlan1D::REBIN_AXIS_1D_FRAC uses the width of the overlap as
+   * weight and ignores the initial bins whose value or uncertainty is
+   * <em>nan</em> or <em>inf</em>, like rebin_axis_1D_frac(). The weights
+   * are also added to the fractional area when one is given.
+   *
+   * As in the functions, the output is not reset before the rebinned
+   * portions are added. The plan keeps no reference to the axes.
+   */
+  template <typename NumT>
+  class RebinPlan1D
+  {
+  public:
+    /// The functions a plan can reproduce
+    enum Mode
+      {
+        /// Weights and comparisons of rebin_axis_1D()
+        REBIN_AXIS_1D,
+        /// Weights and comparisons of rebin_axis_1D_frac()
+        REBIN_AXIS_1D_FRAC
+      };
+
+    /**
+     * \brief Constructor computing the weights between two axes
+     *
+     * \param axis_in (INPUT) is the initial data axis
+     * \param axis_out (INPUT) is the target axis for rebinning
+     * \param mode (INPUT) selects the function the plan reproduces
+     *
+     * \exception std::invalid_argument is thrown if an axis is empty
+     */
+    RebinPlan1D(const Nessi::Vector<NumT> & axis_in,
+                const Nessi::Vector<NumT> & axis_out,
+                const Mode mode=REBIN_AXIS_1D);
+
+    /**
+     * \brief Returns the function the plan reproduces
+     */
+    Mode mode() const;
+
+    /**
+     * \brief Returns the number of bins of the initial axis
+     */
+    std::size_t num_bins_in() const;
+
+    /**
+     * \brief Returns the number of bins of the target axis
+     */
+    std::size_t num_bins_out() const;
+
+    /**
+     * \brief Returns the number of overlapping pairs of bins
+     */
+    std::size_t num_weights() const;
+
+    /**
+     * \brief Rebins one spectrum
+     *
+     * \param input (INPUT) is the data associated with the initial axis
+     * \param input_err2 (INPUT) is the square of the uncertainty associated
+     * with the data
+     * \param output (OUTPUT) is the rebinned data
+     * \param output_err2 (OUTPUT) is the square of the uncertainty
+     * associated with the rebinned data
+     *
+     * \param temp holds temporary memory to be passed to the function
+     *
+     * \return A set of warnings generated by the function
+     *
+     * \exception std::invalid_argument is thrown if input and input_err2
+     * do not have num_bins_in() elements or if output and output_err2 do
+     * not have num_bins_out() elements
+     */
+    std::string apply(const Nessi::Vector<NumT> & input,
+                      const Nessi::Vector<NumT> & input_err2,
+                      Nessi::Vector<NumT> & output,
+                      Nessi::Vector<NumT> & output_err2,
+                      void *temp=NULL) const;
+
+    /**
+     * \brief Rebins one spectrum and accumulates the fractional area
+     *
+     * This is the same as the previous function, but the weights are also
+     * added to \p frac_area. With a RebinPlan1D::REBIN_AXIS_1D_FRAC plan
+     * this is the equivalent of rebin_axis_1D_frac().
+     *
+     * \param frac_area (OUTPUT) is the fractional area of every target bin
+     *
+     * \exception std::invalid_argument is thrown if frac_area does not have
+     * num_bins_out() elements
+     */
+    std::string apply(const Nessi::Vector<NumT> & input,
+                      const Nessi::Vector<NumT> & input_err2,
+                      Nessi::Vector<NumT> & output,
+                      Nessi::Vector<NumT> & output_err2,
+                      Nessi::Vector<NumT> & frac_area,
+                      void *temp=NULL) const;
+
+    /**
+     * \brief Rebins every spectrum of a block
+     *
+     * \param input (INPUT) is the block of spectra associated with the
+     * initial axis
+     * \param output (OUTPUT) is the block of rebinned spectra
+     *
+     * \param temp holds temporary memory to be passed to the function
+     *
+     * \return A set of warnings generated by the function
+     *
+     * \exception std::invalid_argument is thrown if input does not have
+     * num_bins_in() bins, if output does not have num_bins_out() bins or if
+     * they do not have the same number of spectra
+     */
+    std::string apply(const Nessi::SpectrumBlock<NumT> & input,
+                      Nessi::SpectrumBlock<NumT> & output,
+                      void *temp=NULL) const;
+
+    /**
+     * \brief Rebins every spectrum of a block with an execution policy
+     *
+     * This is the same as the previous function. The spectra are
+     * distributed as selected by \p policy, see Nessi::ExecutionPolicy.
+     * The result does not depend on the policy.
+     *
+     * \param policy (INPUT) is the execution policy
+     */
+    std::string apply(const Nessi::ExecutionPolicy & policy,
+                      const Nessi::SpectrumBlock<NumT> & input,
+                      Nessi::SpectrumBlock<NumT> & output,
+                      void *temp=NULL) const;
+
+  private:
+    friend class __RebinPlan1DBlock<NumT>;
+    friend class __RebinAxis2DRows<NumT>;
+
+    /// Checks the sizes of the arrays of one spectrum
+    void check_sizes(const Nessi::Vector<NumT> & input,
+                     const Nessi::Vector<NumT> & input_err2,
+                     const Nessi::Vector<NumT> & output,
+                     const Nessi::Vector<NumT> & output_err2) const;
+
+    /// Rebins one spectrum, the sizes must have been checked
+    void apply_spectrum(const NumT * input, const NumT * input_err2,
+                        NumT * output, NumT * output_err2,
+                        NumT * frac_area) const;
+
+    /// The function the plan reproduces
+    Mode mode_;
+    /// Number of bins of the initial axis
+    std::size_t num_bins_in_;
+    /// First weight of every target bin, one more than the target bins
+    Nessi::Vector<std::size_t> offset_;
+    /// Initial bin of every weight
+    Nessi::Vector<std::size_t> index_;
+    /// The weights
+    Nessi::Vector<NumT> weight_;
+  };
+
+  /**
+   * \}
+   */ // end of rebin_plan_1D group
+
   /**
    * \defgroup rebin_axis_2D AxisManip::rebin_axis_2D
    * \{
@@ -480,6 +1305,14 @@ namespace AxisManip
    * this example. This is due to the loss of information when performing a
    * rebin on data. Therefore, rebin your data thoughtfully and carefully!
    *
+   * The overlaps of both axes are computed once per call with a
+   * RebinPlan1D. The rows are rebinned along the 2nd axis, the result is
+   * transposed in square tiles and its rows are rebinned along the 1st
+   * axis before a last transpose into the output. Both passes read and
+   * write contiguous rows and no memory is allocated per row. The scratch
+   * arrays are taken from \p temp when it is a Nessi::Workspace, and the
+   * version taking the plans avoids building them on every call.
+   *
    * \param axis_in_1 (INPUT) is the 1st initial data axis
    * \param axis_in_2 (INPUT) is the 2nd initial data axis
    * \param input (INPUT) is the data associated with the initial axis
@@ -491,7 +1324,8 @@ namespace AxisManip
    * \param output_err2 (OUTPUT) is the square of the uncertainty associated
    * with the rebinned data
    *
-   * \param temp holds temporary memory to be passed to the function
+   * \param temp is NULL or a Nessi::Workspace providing the scratch memory
+   * of the function
    *
    * \return A set of warnings generated by the function
    *
@@ -512,6 +1346,112 @@ namespace AxisManip
                 Nessi::Vector<NumT> & output_err2,
                 void *temp=NULL);
 
+  /**
+   * \brief This function is described in section 3.13.
+   *
+   * This is the version of rebin_axis_2D() taking an execution policy.
+   * With a parallel policy the rows of each rebinning pass and the tiles
+   * of each transpose are distributed over the threads. Every element is
+   * computed by one thread with the same operations as the sequential
+   * version, so the result is identical for any number of threads.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param axis_in_1 (INPUT) is the 1st initial data axis
+   * \param axis_in_2 (INPUT) is the 2nd initial data axis
+   * \param input (INPUT) is the data associated with the initial axis
+   * \param input_err2 (INPUT) is the square of the uncertainty associated
+   * with the data
+   * \param axis_out_1 (INPUT) is the 1st target axis for rebinning
+   * \param axis_out_2 (INPUT) is the 2nd target axis for rebinning
+   * \param output (OUTPUT) is the rebinned data according to the target axis
+   * \param output_err2 (OUTPUT) is the square of the uncertainty associated
+   * with the rebinned data
+   *
+   * \param temp is NULL or a Nessi::Workspace providing the scratch memory
+   * of the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the size of axis_in
+   * is not one more than the size of input and input_err2.
+   * \exception std::invalid_argument is thrown if the size of
+   * axis_out is not one more than the size of output and output_err2.
+   */
+  template <typename NumT>
+  std::string
+  rebin_axis_2D(const Nessi::ExecutionPolicy & policy,
+                const Nessi::Vector<NumT> & axis_in_1,
+                const Nessi::Vector<NumT> & axis_in_2,
+                const Nessi::Vector<NumT> & input,
+                const Nessi::Vector<NumT> & input_err2,
+                const Nessi::Vector<NumT> & axis_out_1,
+                const Nessi::Vector<NumT> & axis_out_2,
+                Nessi::Vector<NumT> & output,
+                Nessi::Vector<NumT> & output_err2,
+                void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.13.
+   *
+   * This is the version of rebin_axis_2D() taking the plans of both axes
+   * instead of the axes. A caller rebinning many histograms between the
+   * same axes builds the plans once, so that no memory other than the
+   * scratch arrays, taken from \p temp, is allocated per call.
+   *
+   * \param plan_1 (INPUT) is the plan from the 1st initial axis to the 1st
+   * target axis
+   * \param plan_2 (INPUT) is the plan from the 2nd initial axis to the 2nd
+   * target axis
+   * \param input (INPUT) is the data associated with the initial axis
+   * \param input_err2 (INPUT) is the square of the uncertainty associated
+   * with the data
+   * \param output (OUTPUT) is the rebinned data according to the target axis
+   * \param output_err2 (OUTPUT) is the square of the uncertainty associated
+   * with the rebinned data
+   *
+   * \param temp is NULL or a Nessi::Workspace providing the scratch memory
+   * of the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if a plan is not a
+   * RebinPlan1D::REBIN_AXIS_1D plan.
+   * \exception std::invalid_argument is thrown if the sizes of input and
+   * input_err2 are not the product of the numbers of initial bins of the
+   * plans.
+   * \exception std::invalid_argument is thrown if the sizes of output and
+   * output_err2 are not the product of the numbers of target bins of the
+   * plans.
+   */
+  template <typename NumT>
+  std::string
+  rebin_axis_2D(const RebinPlan1D<NumT> & plan_1,
+                const RebinPlan1D<NumT> & plan_2,
+                const Nessi::Vector<NumT> & input,
+                const Nessi::Vector<NumT> & input_err2,
+                Nessi::Vector<NumT> & output,
+                Nessi::Vector<NumT> & output_err2,
+                void *temp=NULL);
+
+  /**
+   * \brief This function is described in section 3.13.
+   *
+   * This is the version of rebin_axis_2D() taking the plans of both axes
+   * and an execution policy.
+   *
+   * \param policy (INPUT) is the execution policy
+   */
+  template <typename NumT>
+  std::string
+  rebin_axis_2D(const Nessi::ExecutionPolicy & policy,
+                const RebinPlan1D<NumT> & plan_1,
+                const RebinPlan1D<NumT> & plan_2,
+                const Nessi::Vector<NumT> & input,
+                const Nessi::Vector<NumT> & input_err2,
+                Nessi::Vector<NumT> & output,
+                Nessi::Vector<NumT> & output_err2,
+                void *temp=NULL);
+
   /**
    * \}
    */ // end of rebin_axis_2D group
@@ -524,7 +1464,55 @@ namespace AxisManip
   /**
    * \brief This function is described in section 3.14.
    *
-   * THIS FUNCTION IS NOT DEFINED
+   * This function rebins data and its associated errors from four axes to
+   * four different axes. Like rebin_axis_2D(), it uses the fractional
+   * overlap of the bins along every axis and assumes that the data is
+   * represented by a histogram model. The fraction of initial bin
+   * \f$(i, j, k, l)\f$ that falls in target bin \f$(a, b, c, d)\f$ is the
+   * product of the fractions along the four axes, as calculated by
+   * rebin_axis_1D():
+   *
+   * \f[
+   * data_{out}[a,b,c,d] = \sum_{i,j,k,l} data_{in}[i,j,k,l] \times
+   * w_1[i,a] \times w_2[j,b] \times w_3[k,c] \times w_4[l,d]
+   * \f]
+   * \f[
+   * \sigma^2_{out}[a,b,c,d] = \sum_{i,j,k,l} \sigma^2_{in}[i,j,k,l]
+   * \times (w_1[i,a] \times w_2[j,b] \times w_3[k,c] \times w_4[l,d])^2
+   * \f]
+   *
+   * The histograms are stored with the 4th axis running fastest, bin
+   * \f$(i, j, k, l)\f$ being element
+   * \f$((i \times n_2 + j) \times n_3 + k) \times n_4 + l\f$. Initial
+   * bins whose value and uncertainty are both zero are skipped, so the
+   * cost grows with the occupied bins of the input. For grids too large
+   * to be held densely, use the version filling a
+   * Nessi::SparseHistogram4D.
+   *
+   * \param axis_in_1 (INPUT) is the 1st initial data axis
+   * \param axis_in_2 (INPUT) is the 2nd initial data axis
+   * \param axis_in_3 (INPUT) is the 3rd initial data axis
+   * \param axis_in_4 (INPUT) is the 4th initial data axis
+   * \param input (INPUT) is the data associated with the initial axes
+   * \param input_err2 (INPUT) is the square of the uncertainty associated
+   * with the data
+   * \param axis_out_1 (INPUT) is the 1st target axis for rebinning
+   * \param axis_out_2 (INPUT) is the 2nd target axis for rebinning
+   * \param axis_out_3 (INPUT) is the 3rd target axis for rebinning
+   * \param axis_out_4 (INPUT) is the 4th target axis for rebinning
+   * \param output (OUTPUT) is the rebinned data according to the target axes
+   * \param output_err2 (OUTPUT) is the square of the uncertainty associated
+   * with the rebinned data
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if an axis is empty
+   * \exception std::invalid_argument is thrown if the sizes of input and
+   * input_err2 are not the number of bins given by the initial axes
+   * \exception std::invalid_argument is thrown if the sizes of output and
+   * output_err2 are not the number of bins given by the target axes
    */
   template <typename NumT>
   std::string
@@ -542,6 +1530,63 @@ namespace AxisManip
                 Nessi::Vector<NumT> & output_err2,
                 void *temp=NULL);
 
+  /**
+   * \brief This function is described in section 3.14.
+   *
+   * This function is the same as rebin_axis_4D() but fills a
+   * Nessi::SparseHistogram4D, so only the bricks of the target grid that
+   * receive data are held in memory. The histogram is cleared first and
+   * keeps its brick size. Use Nessi::SparseHistogram4D::to_dense() to get
+   * the arrays of rebin_axis_4D() for a small grid.
+   *
+   * The slabs of bricks along the 1st target axis are distributed over
+   * the threads of the library according to \p policy. Every thread fills
+   * its own bricks, which are then moved into \p output, and every bin
+   * receives the contributions of the initial bins in the same order as in
+   * the sequential version. The result is therefore identical for any
+   * number of threads.
+   *
+   * \param policy (INPUT) is the execution policy of the call
+   * \param axis_in_1 (INPUT) is the 1st initial data axis
+   * \param axis_in_2 (INPUT) is the 2nd initial data axis
+   * \param axis_in_3 (INPUT) is the 3rd initial data axis
+   * \param axis_in_4 (INPUT) is the 4th initial data axis
+   * \param input (INPUT) is the data associated with the initial axes
+   * \param input_err2 (INPUT) is the square of the uncertainty associated
+   * with the data
+   * \param axis_out_1 (INPUT) is the 1st target axis for rebinning
+   * \param axis_out_2 (INPUT) is the 2nd target axis for rebinning
+   * \param axis_out_3 (INPUT) is the 3rd target axis for rebinning
+   * \param axis_out_4 (INPUT) is the 4th target axis for rebinning
+   * \param output (OUTPUT) is the rebinned histogram, its shape must be
+   * given by the target axes
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if an axis is empty
+   * \exception std::invalid_argument is thrown if the sizes of input and
+   * input_err2 are not the number of bins given by the initial axes
+   * \exception std::invalid_argument is thrown if the shape of output is
+   * not the one given by the target axes
+   */
+  template <typename NumT>
+  std::string
+  rebin_axis_4D(const Nessi::ExecutionPolicy & policy,
+                const Nessi::Vector<NumT> & axis_in_1,
+                const Nessi::Vector<NumT> & axis_in_2,
+                const Nessi::Vector<NumT> & axis_in_3,
+                const Nessi::Vector<NumT> & axis_in_4,
+                const Nessi::Vector<NumT> & input,
+                const Nessi::Vector<NumT> & input_err2,
+                const Nessi::Vector<NumT> & axis_out_1,
+                const Nessi::Vector<NumT> & axis_out_2,
+                const Nessi::Vector<NumT> & axis_out_3,
+                const Nessi::Vector<NumT> & axis_out_4,
+                Nessi::SparseHistogram4D<NumT> & output,
+                void *temp=NULL);
+
   /**
    * \}
    */ // end of rebin_axis_4D group
@@ -570,6 +1615,11 @@ namespace AxisManip
    * 
    * <IMG SRC="../images/Rebin_Diagonal_RebinHist.png">
    *
+   * The target bins overlapped by every original bin are found with
+   * cursors on the target axes that start from the previous original bin,
+   * so an increasing sequence of original bins costs constant time per bin
+   * instead of four bisections. Any other order gives the same result.
+   *
    * \param axis_in_1 (INPUT) is the 1st initial data axis
    * \param axis_in_2 (INPUT) is the 2nd initial data axis
    * \param input (INPUT) is the data associated with the initial axis
@@ -605,6 +1655,59 @@ namespace AxisManip
                  Nessi::Vector<NumT> & output_err2,
                  void *temp=NULL);
 
+  /**
+   * \brief This function is described in section 3.53.
+   *
+   * This is the version of rebin_diagonal() taking an execution policy.
+   * With a parallel policy the original bins are split into one range of
+   * consecutive bins per thread. Every range is rebinned into a private
+   * tile covering only the target bins it overlaps, which is small for a
+   * diagonal spectrum. The tiles are then added to the output in the order
+   * of the ranges, the rows of the output being distributed over the
+   * threads.
+   *
+   * The result does not depend on the scheduling of the threads. It may
+   * differ from the sequential result in the last bits, since the
+   * contributions of a range are summed before they are added to the
+   * output, and is identical to it with one thread.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param axis_in_1 (INPUT) is the 1st initial data axis
+   * \param axis_in_2 (INPUT) is the 2nd initial data axis
+   * \param input (INPUT) is the data associated with the initial axis
+   * \param input_err2 (INPUT) is the square of the uncertainty associated
+   * with the data
+   * \param axis_out_1 (INPUT) is the 1st target axis for rebinning
+   * \param axis_out_2 (INPUT) is the 2nd target axis for rebinning
+   * \param output (OUTPUT) is the rebinned data according to the target axis
+   * \param output_err2 (OUTPUT) is the square of the uncertainty associated
+   * with the rebinned data
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the sizes of axis_in_1,
+   * input and input_err2 are not that of a histogram dataset
+   * \exception std::invalid_argument is thrown is the sizes of axis_in_1 and
+   * axis_in_2 are not the same
+   * \exception std::invalid_argument is thrown if the sizes of
+   * axis_out_1, axis_out_2, output and output_err2 are not that of a
+   * histogram dataset
+   */
+  template <typename NumT>
+  std::string
+  rebin_diagonal(const Nessi::ExecutionPolicy & policy,
+                 const Nessi::Vector<NumT> & axis_in_1,
+                 const Nessi::Vector<NumT> & axis_in_2,
+                 const Nessi::Vector<NumT> & input,
+                 const Nessi::Vector<NumT> & input_err2,
+                 const Nessi::Vector<NumT> & axis_out_1,
+                 const Nessi::Vector<NumT> & axis_out_2,
+                 Nessi::Vector<NumT> & output,
+                 Nessi::Vector<NumT> & output_err2,
+                 void *temp=NULL);
+
   /**
    * \}
    */ // end of rebin_diagonal group
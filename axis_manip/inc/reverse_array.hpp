@@ -31,6 +31,7 @@
 #define _REVERSE_ARRAY_HPP 1
 
 #include "nessi.hpp"
+#include "nessi_view.hpp"
 #include <string>
 
 namespace AxisManip
@@ -59,6 +60,29 @@ namespace AxisManip
                    Nessi::Vector<NumT> & output,
                    void *temp=NULL);
 
+  /**
+   * \brief This function is described in section 3.11 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be reversed into another one. The views must not overlap.
+   *
+   * \param input (INPUT) is a view of the array to be reversed
+   * \param output (OUTPUT) is a view of the reversed array
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not the
+   * same size.
+   */
+  template <typename NumT>
+  std::string
+  reverse_array_cp(const Nessi::VectorView<const NumT> & input,
+                   const Nessi::VectorView<NumT> & output,
+                   void *temp=NULL);
+
   /**
    * \}
    */ // end of reverse_array_cp group
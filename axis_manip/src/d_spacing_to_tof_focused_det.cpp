@@ -102,4 +102,109 @@ namespace AxisManip
                                   double & tof,
                                   double & tof_err2,
                                   void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.39 for
+   * blocks
+   *
+   * \ingroup d_spacing_to_tof_focused_det
+   */
+  template std::string
+  d_spacing_to_tof_focused_det<float>(const Nessi::SpectrumBlock<float> &
+                                      d_spacing,
+                                      const float pathlength_focused,
+                                      const float pathlength_focused_err2,
+                                      const float polar_focused,
+                                      const float polar_focused_err2,
+                                      Nessi::SpectrumBlock<float> & tof,
+                                      void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.39 for
+   * blocks with an execution policy
+   *
+   * \ingroup d_spacing_to_tof_focused_det
+   */
+  template std::string
+  d_spacing_to_tof_focused_det<float>(const Nessi::ExecutionPolicy & policy,
+                                      const Nessi::SpectrumBlock<float> &
+                                      d_spacing,
+                                      const float pathlength_focused,
+                                      const float pathlength_focused_err2,
+                                      const float polar_focused,
+                                      const float polar_focused_err2,
+                                      Nessi::SpectrumBlock<float> & tof,
+                                      void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.39 for blocks
+   *
+   * \ingroup d_spacing_to_tof_focused_det
+   */
+  template std::string
+  d_spacing_to_tof_focused_det<double>(const Nessi::SpectrumBlock<double> &
+                                       d_spacing,
+                                       const double pathlength_focused,
+                                       const double pathlength_focused_err2,
+                                       const double polar_focused,
+                                       const double polar_focused_err2,
+                                       Nessi::SpectrumBlock<double> & tof,
+                                       void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.39 for blocks with an execution policy
+   *
+   * \ingroup d_spacing_to_tof_focused_det
+   */
+  template std::string
+  d_spacing_to_tof_focused_det<double>(const Nessi::ExecutionPolicy & policy,
+                                       const Nessi::SpectrumBlock<double> &
+                                       d_spacing,
+                                       const double pathlength_focused,
+                                       const double pathlength_focused_err2,
+                                       const double polar_focused,
+                                       const double polar_focused_err2,
+                                       Nessi::SpectrumBlock<double> & tof,
+                                       void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.39 for views
+   *
+   * \ingroup d_spacing_to_tof_focused_det
+   */
+  template std::string
+  d_spacing_to_tof_focused_det<float>(const Nessi::VectorView<const float> &
+                                      d_spacing,
+                                      const Nessi::VectorView<const float> &
+                                      d_spacing_err2,
+                                      const float pathlength_focused,
+                                      const float pathlength_focused_err2,
+                                      const float polar_focused,
+                                      const float polar_focused_err2,
+                                      const Nessi::VectorView<float> & tof,
+                                      const Nessi::VectorView<float> &
+                                      tof_err2,
+                                      void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.39 for views
+   *
+   * \ingroup d_spacing_to_tof_focused_det
+   */
+  template std::string
+  d_spacing_to_tof_focused_det<double>(const Nessi::VectorView<const double> &
+                                       d_spacing,
+                                       const Nessi::VectorView<const double> &
+                                       d_spacing_err2,
+                                       const double pathlength_focused,
+                                       const double pathlength_focused_err2,
+                                       const double polar_focused,
+                                       const double polar_focused_err2,
+                                       const Nessi::VectorView<double> & tof,
+                                       const Nessi::VectorView<double> &
+                                       tof_err2,
+                                       void *temp);
 } // AxisManip
@@ -32,6 +32,7 @@
 
 #include "constants.hpp"
 #include "conversions.hpp"
+#include "map_kernel.hpp"
 #include "nessi_warn.hpp"
 #include "size_checks.hpp"
 #include <cmath>
@@ -42,6 +43,86 @@ namespace AxisManip
   /// String for holding the d_spacing_to_tof_focused_det function name
   const std::string dsttfd_func_str = "AxisManip::d_spacing_to_tof_focused_det";
 
+  /**
+   * \ingroup d_spacing_to_tof_focused_det
+   *
+   * This is a PRIVATE map kernel (see \ref map_kernel) converting
+   * d-spacing to time-of-flight for the focused detector. The constants
+   * are the same for every pixel.
+   */
+  template <typename NumT>
+  class __DSpacingToTofFocusedDetKernel
+  {
+  public:
+    /// Type of the elements
+    typedef NumT value_type;
+
+    /// Constructor keeping the parameters of the focused detector
+    __DSpacingToTofFocusedDetKernel(const NumT pathlength_focused,
+                                    const NumT pathlength_focused_err2,
+                                    const NumT polar_focused,
+                                    const NumT polar_focused_err2)
+      : pathlength_focused_(pathlength_focused),
+        pathlength_focused_err2_(pathlength_focused_err2),
+        polar_focused_(polar_focused),
+        polar_focused_err2_(polar_focused_err2),
+        mh_(0), mh2_(0), sin_(0), sin2_(0), cos_(0), cos2_(0), lf2_(0)
+    { }
+
+    /// Returns true, the conversion does not depend on the pixel
+    bool is_uniform() const
+    {
+      return true;
+    }
+
+    /// Calculates the constants
+    std::string setup(const std::size_t)
+    {
+      return __d_spacing_to_tof_focused_det_static(pathlength_focused_,
+                                                   polar_focused_, mh_, mh2_,
+                                                   sin_, sin2_, cos_, cos2_,
+                                                   lf2_);
+    }
+
+    /// Converts one bin
+    template <typename SinkT>
+    void operator()(const NumT d_spacing, const NumT d_spacing_err2,
+                    NumT & tof, NumT & tof_err2, SinkT & warnings) const
+    {
+      __d_spacing_to_tof_focused_det_dynamic(d_spacing, d_spacing_err2,
+                                             pathlength_focused_,
+                                             pathlength_focused_err2_,
+                                             polar_focused_err2_, mh_, mh2_,
+                                             sin_, sin2_, cos_, cos2_, lf2_,
+                                             tof, tof_err2, warnings);
+    }
+
+  private:
+    /// The total flight path of the focused neutron
+    NumT pathlength_focused_;
+    /// The squared uncertainty of the total flight path
+    NumT pathlength_focused_err2_;
+    /// The polar angle of the focused neutron
+    NumT polar_focused_;
+    /// The squared uncertainty of the polar angle
+    NumT polar_focused_err2_;
+    /// The mass of the neutron divided by Planck's constant
+    NumT mh_;
+    /// The square of mh_
+    NumT mh2_;
+    /// The sine of half the polar angle
+    NumT sin_;
+    /// The square of sin_
+    NumT sin2_;
+    /// The cosine of half the polar angle
+    NumT cos_;
+    /// The square of cos_
+    NumT cos2_;
+    /// The square of the total flight path
+    NumT lf2_;
+  };
+
+
   // 3.39
   template <typename NumT>
   std::string
@@ -85,39 +166,13 @@ namespace AxisManip
         throw std::invalid_argument(dsttfd_func_str+" (v,v): tof "+e.what());
       }
 
-    std::string retstr(Nessi::EMPTY_WARN); // the warning string
-
-    // allocate local variables
-    NumT mh;
-    NumT mh2;
-    NumT sin;
-    NumT sin2;
-    NumT cos;
-    NumT cos2;
-    NumT lf2;
-
-    // fill the local variables
-    retstr += __d_spacing_to_tof_focused_det_static(pathlength_focused, 
-                                                    polar_angle_focused,
-                                                    mh, mh2, sin, sin2, 
-                                                    cos, cos2, lf2);
-
-    // do the calculation
-    size_t size_d_spacing = d_spacing.size();
-    for (size_t i = 0; i < size_d_spacing; ++i)
-      {
-        retstr += __d_spacing_to_tof_focused_det_dynamic(d_spacing[i], 
-                                                         d_spacing_err2[i],
-                                                         pathlength_focused,
-                                                         pathlength_focused_err2,
-                                                         polar_angle_focused_err2,
-                                                         mh, mh2, sin, sin2,
-                                                         cos, cos2, lf2,
-                                                         tof[i],
-                                                         tof_err2[i]);
-      }
-
-    return retstr;
+    return __map_kernel(__DSpacingToTofFocusedDetKernel<NumT>(
+                                      pathlength_focused,
+                                      pathlength_focused_err2,
+                                      polar_angle_focused,
+                                      polar_angle_focused_err2),
+                        d_spacing.begin(), d_spacing_err2.begin(),
+                        tof.begin(), tof_err2.begin(), d_spacing.size());
   }
 
   // 3.39
@@ -133,34 +188,41 @@ namespace AxisManip
                                  NumT & tof_err2,
                                  void *temp=NULL)
   {
-    std::string retstr(Nessi::EMPTY_WARN); // the warning string
+    return __map_kernel(__DSpacingToTofFocusedDetKernel<NumT>(
+                                      pathlength_focused,
+                                      pathlength_focused_err2,
+                                      polar_focused, polar_focused_err2),
+                        &d_spacing, &d_spacing_err2, &tof, &tof_err2, 1);
+  }
 
-    // allocate local variables
-    NumT mh;
-    NumT mh2;
-    NumT sin;
-    NumT sin2;
-    NumT cos;
-    NumT cos2;
-    NumT lf2;
+  // 3.39
+  template <typename NumT>
+  std::string
+  d_spacing_to_tof_focused_det(const Nessi::VectorView<const NumT> & d_spacing,
+                               const Nessi::VectorView<const NumT> &
+                               d_spacing_err2,
+                               const NumT pathlength_focused,
+                               const NumT pathlength_focused_err2,
+                               const NumT polar_focused,
+                               const NumT polar_focused_err2,
+                               const Nessi::VectorView<NumT> & tof,
+                               const Nessi::VectorView<NumT> & tof_err2,
+                               void *temp=NULL)
+  {
+    // check that the views are of proper size
+    size_t sz = d_spacing.size();
+    if (d_spacing_err2.size() != sz || tof.size() != sz
+        || tof_err2.size() != sz)
+      {
+        throw std::invalid_argument(dsttfd_func_str+" (view): views not the "
+                                    +"same size");
+      }
 
-    // fill the local variables
-    retstr += __d_spacing_to_tof_focused_det_static(pathlength_focused, 
-                                                    polar_focused,
-                                                    mh, mh2, sin, sin2,
-                                                    cos, cos2, lf2);
-                                                   
-    // do the calculation
-    retstr += __d_spacing_to_tof_focused_det_dynamic(d_spacing, 
-                                                     d_spacing_err2,
-                                                     pathlength_focused,
-                                                     pathlength_focused_err2,
-                                                     polar_focused_err2,
-                                                     mh, mh2, sin, sin2,
-                                                     cos, cos2, lf2,
-                                                     tof,
-                                                     tof_err2);
-    return retstr;
+    return __map_kernel(__DSpacingToTofFocusedDetKernel<NumT>(
+                                      pathlength_focused,
+                                      pathlength_focused_err2,
+                                      polar_focused, polar_focused_err2),
+                        d_spacing, d_spacing_err2, tof, tof_err2, sz);
   }
 
 /**
@@ -246,23 +308,25 @@ namespace AxisManip
    * d_spacing_to_tof_focused_det()
    * \param  tof_err2 (OUTPUT) same as the parameter in
    * d_spacing_to_tof_focused_det()
+   * \param warnings (OUTPUT) is the sink receiving the warnings
    */
-  template <typename NumT>
-  std::string  
-  __d_spacing_to_tof_focused_det_dynamic(const NumT d_spacing, 
+  template <typename NumT, typename SinkT>
+  void
+  __d_spacing_to_tof_focused_det_dynamic(const NumT d_spacing,
                                          const NumT d_spacing_err2,
                                          const NumT pathlength_focused,
                                          const NumT pathlength_focused_err2,
-                                         const NumT polar_focused_err2, 
-                                         const NumT mh, 
+                                         const NumT polar_focused_err2,
+                                         const NumT mh,
                                          const NumT mh2,
-                                         const NumT sin, 
-                                         const NumT sin2, 
-                                         const NumT cos, 
+                                         const NumT sin,
+                                         const NumT sin2,
+                                         const NumT cos,
                                          const NumT cos2,
                                          const NumT lf2,
                                          NumT & tof,
-                                         NumT & tof_err2)
+                                         NumT & tof_err2,
+                                         SinkT & warnings)
 
   {
     NumT d2 = d_spacing * d_spacing;
@@ -275,8 +339,51 @@ namespace AxisManip
                                   pathlength_focused_err2)
                                  + (mh2 * lf2 * cos2 * d2 * polar_focused_err2)
                                  + (4.0 * mh2 * lf2 * sin2 * d_spacing_err2));
+  }
 
-    return Nessi::EMPTY_WARN;
+  // 3.39
+  template <typename NumT>
+  std::string
+  d_spacing_to_tof_focused_det(const Nessi::SpectrumBlock<NumT> & d_spacing,
+                               const NumT pathlength_focused,
+                               const NumT pathlength_focused_err2,
+                               const NumT polar_focused,
+                               const NumT polar_focused_err2,
+                               Nessi::SpectrumBlock<NumT> & tof,
+                               void *temp=NULL)
+  {
+    return d_spacing_to_tof_focused_det(Nessi::execution::seq, d_spacing,
+                                        pathlength_focused,
+                                        pathlength_focused_err2, polar_focused,
+                                        polar_focused_err2, tof, temp);
+  }
+
+  // 3.39
+  template <typename NumT>
+  std::string
+  d_spacing_to_tof_focused_det(const Nessi::ExecutionPolicy & policy,
+                               const Nessi::SpectrumBlock<NumT> & d_spacing,
+                               const NumT pathlength_focused,
+                               const NumT pathlength_focused_err2,
+                               const NumT polar_focused,
+                               const NumT polar_focused_err2,
+                               Nessi::SpectrumBlock<NumT> & tof,
+                               void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!d_spacing.same_shape(tof))
+      {
+        throw std::invalid_argument(dsttfd_func_str+" (b): blocks not the "
+                                    +"same shape");
+      }
+
+    // blocks without padding are converted as a single array
+    return __map_kernel(policy,
+                        __DSpacingToTofFocusedDetKernel<NumT>(
+                                      pathlength_focused,
+                                      pathlength_focused_err2,
+                                      polar_focused, polar_focused_err2),
+                        d_spacing, tof);
   }
 
 } // AxisManip
@@ -82,4 +82,78 @@ namespace AxisManip
                                double & wavelength,
                                double & wavelength_err2,
                                void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.51 for
+   * blocks
+   *
+   * \ingroup energy_to_wavelength
+   */
+  template std::string
+  energy_to_wavelength<float>(const Nessi::SpectrumBlock<float> & energy,
+                              Nessi::SpectrumBlock<float> & wavelength,
+                              void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.51 for
+   * blocks with an execution policy
+   *
+   * \ingroup energy_to_wavelength
+   */
+  template std::string
+  energy_to_wavelength<float>(const Nessi::ExecutionPolicy & policy,
+                              const Nessi::SpectrumBlock<float> & energy,
+                              Nessi::SpectrumBlock<float> & wavelength,
+                              void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.51 for blocks
+   *
+   * \ingroup energy_to_wavelength
+   */
+  template std::string
+  energy_to_wavelength<double>(const Nessi::SpectrumBlock<double> & energy,
+                               Nessi::SpectrumBlock<double> & wavelength,
+                               void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.51 for blocks with an execution policy
+   *
+   * \ingroup energy_to_wavelength
+   */
+  template std::string
+  energy_to_wavelength<double>(const Nessi::ExecutionPolicy & policy,
+                               const Nessi::SpectrumBlock<double> & energy,
+                               Nessi::SpectrumBlock<double> & wavelength,
+                               void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.51 for views
+   *
+   * \ingroup energy_to_wavelength
+   */
+  template std::string
+  energy_to_wavelength<float>(const Nessi::VectorView<const float> & energy,
+                              const Nessi::VectorView<const float> &
+                              energy_err2,
+                              const Nessi::VectorView<float> & wavelength,
+                              const Nessi::VectorView<float> & wavelength_err2,
+                              void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.51 for views
+   *
+   * \ingroup energy_to_wavelength
+   */
+  template std::string
+  energy_to_wavelength<double>(const Nessi::VectorView<const double> & energy,
+                               const Nessi::VectorView<const double> &
+                               energy_err2,
+                               const Nessi::VectorView<double> & wavelength,
+                               const Nessi::VectorView<double> &
+                               wavelength_err2,
+                               void *temp);
 } // AxisManip
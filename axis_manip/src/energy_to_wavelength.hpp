@@ -32,9 +32,10 @@
 
 #include "constants.hpp"
 #include "conversions.hpp"
+#include "map_kernel.hpp"
 #include "nessi_warn.hpp"
 #include "size_checks.hpp"
-#include <cmath>
+#include "vector_math.hpp"
 #include <stdexcept>
 
 namespace AxisManip
@@ -42,6 +43,83 @@ namespace AxisManip
   /// String for holding the energy_to_wavelength function name
   const std::string etw_func_str = "AxisManip::energy_to_wavelength";
 
+  /**
+   * \ingroup energy_to_wavelength
+   *
+   * This is a PRIVATE map kernel (see \ref map_kernel) converting energy
+   * to wavelength. The constant is the same for every pixel. Arrays given
+   * as pointers are converted by the overload of __map_kernel_loop()
+   * below, which keeps the square roots in one call per array.
+   */
+  template <typename NumT>
+  class __EnergyToWavelengthKernel
+  {
+  public:
+    /// Type of the elements
+    typedef NumT value_type;
+
+    /// Constructor clearing the constant until setup() runs
+    __EnergyToWavelengthKernel()
+      : a_(0)
+    { }
+
+    /// Returns true, the conversion does not depend on the pixel
+    bool is_uniform() const
+    {
+      return true;
+    }
+
+    /// Calculates the constant
+    std::string setup(const std::size_t)
+    {
+      return __energy_to_wavelength_static(a_);
+    }
+
+    /// Converts one bin
+    template <typename SinkT>
+    void operator()(const NumT energy, const NumT energy_err2,
+                    NumT & wavelength, NumT & wavelength_err2,
+                    SinkT & warnings) const
+    {
+      __energy_to_wavelength_dynamic(&energy, &energy_err2, &wavelength,
+                                     &wavelength_err2, a_, 1, warnings);
+    }
+
+    /// Converts \p size bins
+    template <typename SinkT>
+    void convert(const NumT * energy, const NumT * energy_err2,
+                 NumT * wavelength, NumT * wavelength_err2,
+                 const std::size_t size, SinkT & warnings) const
+    {
+      __energy_to_wavelength_dynamic(energy, energy_err2, wavelength,
+                                     wavelength_err2, a_, size, warnings);
+    }
+
+  private:
+    /// The factor \f$h^2/8m_n\f$
+    NumT a_;
+  };
+
+  /**
+   * \ingroup energy_to_wavelength
+   *
+   * This is a PRIVATE overload of __map_kernel_loop() handing whole
+   * arrays to the energy_to_wavelength kernel.
+   */
+  template <typename NumT, typename SinkT>
+  inline void
+  __map_kernel_loop(const __EnergyToWavelengthKernel<NumT> & kernel,
+                    const NumT * input,
+                    const NumT * input_err2,
+                    NumT * output,
+                    NumT * output_err2,
+                    const std::size_t size,
+                    SinkT & warnings)
+  {
+    kernel.convert(input, input_err2, output, output_err2, size, warnings);
+  }
+
+
   // 3.51
   template <typename NumT>
   std::string
@@ -82,23 +160,15 @@ namespace AxisManip
                                     +e.what());
       }
 
-    std::string retstr(Nessi::EMPTY_WARN);
-
-    NumT a;
-
-    retstr += __energy_to_wavelength_static(a);
-
     size_t sz = energy.size();
-    for (size_t i = 0; i < sz; ++i)
+    if (sz == 0)
       {
-        retstr += __energy_to_wavelength_dynamic(energy[i],
-                                                 energy_err2[i],
-                                                 wavelength[i],
-                                                 wavelength_err2[i],
-                                                 a);
+        return Nessi::EMPTY_WARN;
       }
 
-    return retstr;
+    return __map_kernel(__EnergyToWavelengthKernel<NumT>(), &energy[0],
+                        &energy_err2[0], &wavelength[0], &wavelength_err2[0],
+                        sz);
   }
 
   // 3.51
@@ -110,16 +180,30 @@ namespace AxisManip
                        NumT & wavelength_err2,
                        void *temp=NULL)
   {
-    std::string retstr(Nessi::EMPTY_WARN);
-
-    NumT a;
-
-    retstr += __energy_to_wavelength_static(a);
+    return __map_kernel(__EnergyToWavelengthKernel<NumT>(), &energy,
+                        &energy_err2, &wavelength, &wavelength_err2, 1);
+  }
 
-    retstr += __energy_to_wavelength_dynamic(energy, energy_err2,
-                                             wavelength, wavelength_err2, a);
+  // 3.51
+  template <typename NumT>
+  std::string
+  energy_to_wavelength(const Nessi::VectorView<const NumT> & energy,
+                       const Nessi::VectorView<const NumT> & energy_err2,
+                       const Nessi::VectorView<NumT> & wavelength,
+                       const Nessi::VectorView<NumT> & wavelength_err2,
+                       void *temp=NULL)
+  {
+    // check that the views are of proper size
+    size_t sz = energy.size();
+    if (energy_err2.size() != sz || wavelength.size() != sz
+        || wavelength_err2.size() != sz)
+      {
+        throw std::invalid_argument(etw_func_str+" (view): views not the "
+                                    +"same size");
+      }
 
-    return retstr;
+    return __map_kernel(__EnergyToWavelengthKernel<NumT>(), energy,
+                        energy_err2, wavelength, wavelength_err2, sz);
   }
 
   /**
@@ -142,34 +226,71 @@ namespace AxisManip
    * \ingroup energy_to_wavelength
    *
    * This is a PRIVATE helper function for energy_to_wavelength that
-   * calculates the energy and its uncertainty.
+   * calculates the wavelength and its uncertainty for an array of
+   * energies. The square roots of the whole array are taken in one call
+   * to Utils::__vec_sqrt().
    *
-   * \param energy (INPUT) same as the parameter in
-   * energy_to_wavelength()
-   * \param energy_err2 (INPUT) same as the parameter in
-   * energy_to_wavelength()
-   * \param wavelength (OUTPUT) same as the parameter in
-   * energy_to_wavelength()
-   * \param wavelength_err2 (OUTPUT) same as the parameter in
-   * energy_to_wavelength()
+   * \param energy (INPUT) is the first of the energies
+   * \param energy_err2 (INPUT) is the first of the squares of the
+   * uncertainties in the energies
+   * \param wavelength (OUTPUT) is the first of the wavelengths
+   * \param wavelength_err2 (OUTPUT) is the first of the squares of the
+   * uncertainties in the wavelengths
    * \param a (INPUT) same as the parameter in
    * __energy_to_wavelength_static()
+   * \param size (INPUT) is the number of energies
+   * \param warnings (OUTPUT) is the sink receiving the warnings
    */
+  template <typename NumT, typename SinkT>
+  void
+  __energy_to_wavelength_dynamic(const NumT * energy,
+                                 const NumT * energy_err2,
+                                 NumT * wavelength,
+                                 NumT * wavelength_err2,
+                                 const NumT a,
+                                 const std::size_t size,
+                                 SinkT & warnings)
+  {
+    for (std::size_t i = 0; i < size; ++i)
+      {
+        // the energy is read first as the output may be the input array
+        NumT e = energy[i];
+        wavelength_err2[i] = (a * energy_err2[i]) / (e * e * e);
+        wavelength[i] = static_cast<NumT>(PhysConst::H2_OVER_2MNEUT) / e;
+      }
+
+    Utils::__vec_sqrt(wavelength, wavelength, size);
+  }
+
+  // 3.51
   template <typename NumT>
   std::string
-  __energy_to_wavelength_dynamic(const NumT energy,
-                                 const NumT energy_err2,
-                                 NumT & wavelength,
-                                 NumT & wavelength_err2,
-                                 const NumT a)
+  energy_to_wavelength(const Nessi::SpectrumBlock<NumT> & energy,
+                       Nessi::SpectrumBlock<NumT> & wavelength,
+                       void *temp=NULL)
   {
-    NumT arg = static_cast<NumT>(PhysConst::H2_OVER_2MNEUT) / energy;
-    wavelength = static_cast<NumT>(std::sqrt(static_cast<double>(arg)));
-    
-    wavelength_err2 = (a * energy_err2);
-    wavelength_err2 /= (energy * energy * energy);
+    return energy_to_wavelength(Nessi::execution::seq, energy, wavelength,
+                                temp);
+  }
 
-    return Nessi::EMPTY_WARN;
+  // 3.51
+  template <typename NumT>
+  std::string
+  energy_to_wavelength(const Nessi::ExecutionPolicy & policy,
+                       const Nessi::SpectrumBlock<NumT> & energy,
+                       Nessi::SpectrumBlock<NumT> & wavelength,
+                       void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!energy.same_shape(wavelength))
+      {
+        throw std::invalid_argument(etw_func_str+" (b): blocks not the "
+                                    +"same shape");
+      }
+
+    // blocks without padding are converted as a single array
+    return __map_kernel(policy, __EnergyToWavelengthKernel<NumT>(), energy,
+                        wavelength);
   }
 
 } // AxisManip
@@ -148,4 +148,90 @@ namespace AxisManip
                           double & energy_transfer,
                           double & energy_transfer_err2,
                           void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.30 for
+   * blocks
+   *
+   * \ingroup energy_transfer
+   */
+  template std::string
+  energy_transfer<float>(const float initial_energy,
+                         const float initial_energy_err2,
+                         const Nessi::SpectrumBlock<float> & final_energy,
+                         Nessi::SpectrumBlock<float> & energy_transfer,
+                         void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.30 for
+   * blocks with an execution policy
+   *
+   * \ingroup energy_transfer
+   */
+  template std::string
+  energy_transfer<float>(const Nessi::ExecutionPolicy & policy,
+                         const float initial_energy,
+                         const float initial_energy_err2,
+                         const Nessi::SpectrumBlock<float> & final_energy,
+                         Nessi::SpectrumBlock<float> & energy_transfer,
+                         void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.30 for blocks
+   *
+   * \ingroup energy_transfer
+   */
+  template std::string
+  energy_transfer<double>(const double initial_energy,
+                          const double initial_energy_err2,
+                          const Nessi::SpectrumBlock<double> & final_energy,
+                          Nessi::SpectrumBlock<double> & energy_transfer,
+                          void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.30 for blocks with an execution policy
+   *
+   * \ingroup energy_transfer
+   */
+  template std::string
+  energy_transfer<double>(const Nessi::ExecutionPolicy & policy,
+                          const double initial_energy,
+                          const double initial_energy_err2,
+                          const Nessi::SpectrumBlock<double> & final_energy,
+                          Nessi::SpectrumBlock<double> & energy_transfer,
+                          void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.30 for views
+   *
+   * \ingroup energy_transfer
+   */
+  template std::string
+  energy_transfer<float>(const float initial_energy,
+                         const float initial_energy_err2,
+                         const Nessi::VectorView<const float> & final_energy,
+                         const Nessi::VectorView<const float> &
+                         final_energy_err2,
+                         const Nessi::VectorView<float> & energy_transfer,
+                         const Nessi::VectorView<float> & energy_transfer_err2,
+                         void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.30 for views
+   *
+   * \ingroup energy_transfer
+   */
+  template std::string
+  energy_transfer<double>(const double initial_energy,
+                          const double initial_energy_err2,
+                          const Nessi::VectorView<const double> & final_energy,
+                          const Nessi::VectorView<const double> &
+                          final_energy_err2,
+                          const Nessi::VectorView<double> & energy_transfer,
+                          const Nessi::VectorView<double> &
+                          energy_transfer_err2,
+                          void *temp);
 } // AxisManip
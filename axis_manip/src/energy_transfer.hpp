@@ -32,6 +32,7 @@
 
 #include "constants.hpp"
 #include "conversions.hpp"
+#include "map_kernel.hpp"
 #include "nessi_warn.hpp"
 #include "size_checks.hpp"
 #include <stdexcept>
@@ -41,6 +42,120 @@ namespace AxisManip
   /// String for holding the energy_transfer function name
   const std::string et_func_str = "AxisManip::energy_transfer";
 
+  /**
+   * \ingroup energy_transfer
+   *
+   * This is a PRIVATE helper function for energy_transfer that
+   * calculates parameters invariant across array calculation.
+   *
+   * \param h (OUTPUT) the value of Planck's constant casted to
+   * appropriate type.
+   * \param h2 (OUTPUT) the value of Planck's constant square casted
+   * to appropriate type.
+   */
+  template <typename NumT>
+  std::string
+  __energy_transfer_static(NumT & h,
+                           NumT & h2)
+  {
+    h=static_cast<NumT>(PhysConst::H);
+    h2=h*h;
+
+    return Nessi::EMPTY_WARN;
+  }
+
+  /**
+   * \ingroup energy_transfer
+   *
+   * This is a PRIVATE helper function for energy_transfer that
+   * calculates the energy_transfer and its uncertainty
+   *
+   * \param initial_energy (INPUT) same as parameter in energy_transfer()
+   * \param initial_energy_err2 (INPUT) same as parameter in energy_transfer()
+   * \param final_energy (INPUT) same as parameter in energy_transfer()
+   * \param final_energy_err2 (INPUT) same as parameter in energy_transfer()
+   * \param h (INPUT) the value of Planck's constant
+   * \param h2 (INPUT) the value of Planck's constant squared
+   * \param energy_transfer (OUTPUT) same as parameter in energy_transfer()
+   * \param energy_transfer_err2 (OUTPUT) same as parameter in
+   * energy_transfer()
+   * \param warnings (OUTPUT) is the sink receiving the warnings
+   */
+  template <typename NumT, typename SinkT>
+  void
+  __energy_transfer_dynamic(const NumT initial_energy,
+                            const NumT initial_energy_err2,
+                            const NumT final_energy,
+                            const NumT final_energy_err2,
+                            const NumT h,
+                            const NumT h2,
+                            NumT & energy_transfer,
+                            NumT & energy_transfer_err2,
+                            SinkT & warnings)
+  {
+    // the result
+    energy_transfer = (initial_energy - final_energy) / h;
+
+    // the uncertainty in the result
+    energy_transfer_err2 = (initial_energy_err2 + final_energy_err2) / h2;
+  }
+
+  /**
+   * \ingroup energy_transfer
+   *
+   * This is a PRIVATE map kernel (see \ref map_kernel) converting the
+   * final energy to energy transfer with one initial energy. The constants
+   * are the same for every pixel.
+   */
+  template <typename NumT>
+  class __EnergyTransferKernel
+  {
+  public:
+    /// Type of the elements
+    typedef NumT value_type;
+
+    /// Constructor keeping the initial energy
+    __EnergyTransferKernel(const NumT initial_energy,
+                           const NumT initial_energy_err2)
+      : initial_energy_(initial_energy),
+        initial_energy_err2_(initial_energy_err2), h_(0), h2_(0)
+    { }
+
+    /// Returns true, the conversion does not depend on the pixel
+    bool is_uniform() const
+    {
+      return true;
+    }
+
+    /// Calculates the constants
+    std::string setup(const std::size_t)
+    {
+      return __energy_transfer_static(h_, h2_);
+    }
+
+    /// Converts one bin
+    template <typename SinkT>
+    void operator()(const NumT final_energy, const NumT final_energy_err2,
+                    NumT & energy_transfer, NumT & energy_transfer_err2,
+                    SinkT & warnings) const
+    {
+      __energy_transfer_dynamic(initial_energy_, initial_energy_err2_,
+                                final_energy, final_energy_err2, h_, h2_,
+                                energy_transfer, energy_transfer_err2,
+                                warnings);
+    }
+
+  private:
+    /// The initial energy
+    NumT initial_energy_;
+    /// The square of the uncertainty in the initial energy
+    NumT initial_energy_err2_;
+    /// Planck's constant
+    NumT h_;
+    /// The square of Planck's constant
+    NumT h2_;
+  };
+
   // 3.30
   template <typename NumT>
   std::string
@@ -85,29 +200,29 @@ namespace AxisManip
                                     +e.what());
       }
 
-    std::string retstr(Nessi::EMPTY_WARN); // the warning string
+    Nessi::DefaultWarningSink warnings;
 
     // allocate local variables
     NumT h;
     NumT h2;
 
     // fill the local variables
-    retstr += __energy_transfer_static(h,h2);
+    warnings.report(__energy_transfer_static(h,h2));
 
     // do the calculation
     size_t size_energy = initial_energy.size();
     for (size_t i = 0; i < size_energy ; ++i )
       {
-        retstr += __energy_transfer_dynamic(initial_energy[i],
-                                       initial_energy_err2[i],
-                                       final_energy[i],
-                                       final_energy_err2[i],
-                                       h, h2,
-                                       energy_transfer[i],
-                                       energy_transfer_err2[i]);
+        __energy_transfer_dynamic(initial_energy[i],
+                                  initial_energy_err2[i],
+                                  final_energy[i],
+                                  final_energy_err2[i],
+                                  h, h2,
+                                  energy_transfer[i],
+                                  energy_transfer_err2[i], warnings);
       }
 
-    return retstr;
+    return warnings.str();
   }
 
   template <typename NumT>
@@ -150,29 +265,29 @@ namespace AxisManip
         throw std::invalid_argument(et_func_str+" (v,s): initial_energy "
                                     +e.what());
       }
-    std::string retstr(Nessi::EMPTY_WARN); // the warning string
+    Nessi::DefaultWarningSink warnings;
 
     // allocate local variables
     NumT h;
     NumT h2;
 
     // fill the local variables
-    retstr += __energy_transfer_static(h,h2);
+    warnings.report(__energy_transfer_static(h,h2));
 
     // do the calculation
     size_t size_energy = initial_energy.size();
     for (size_t i = 0; i < size_energy ; ++i )
       {
-        retstr += __energy_transfer_dynamic(initial_energy[i],
-                                            initial_energy_err2[i],
-                                            final_energy,
-                                            final_energy_err2,
-                                            h, h2,
-                                            energy_transfer[i],
-                                            energy_transfer_err2[i]);
+        __energy_transfer_dynamic(initial_energy[i],
+                                  initial_energy_err2[i],
+                                  final_energy,
+                                  final_energy_err2,
+                                  h, h2,
+                                  energy_transfer[i],
+                                  energy_transfer_err2[i], warnings);
       }
 
-    return retstr;
+    return warnings.str();
   }
 
   template <typename NumT>
@@ -215,29 +330,48 @@ namespace AxisManip
         throw std::invalid_argument(et_func_str+" (s,v): final_energy "
                                     +e.what());
       }
-    std::string retstr(Nessi::EMPTY_WARN); // the warning string
 
-    // allocate local variables
-    NumT h;
-    NumT h2;
+    return __map_kernel(__EnergyTransferKernel<NumT>(initial_energy,
+                                                     initial_energy_err2),
+                        final_energy.begin(), final_energy_err2.begin(),
+                        energy_transfer.begin(),
+                        energy_transfer_err2.begin(), final_energy.size());
+  }
 
-    // fill the local variables
-    retstr += __energy_transfer_static(h,h2);
+  template <typename NumT>
+  std::string
+  energy_transfer(const NumT initial_energy,
+                  const NumT initial_energy_err2,
+                  const Nessi::SpectrumBlock<NumT> & final_energy,
+                  Nessi::SpectrumBlock<NumT> & energy_transfer,
+                  void *temp=NULL)
+  {
+    return AxisManip::energy_transfer(Nessi::execution::seq, initial_energy,
+                                      initial_energy_err2, final_energy,
+                                      energy_transfer, temp);
+  }
 
-    // do the calculation
-    size_t size_energy = final_energy.size();
-    for (size_t i = 0; i < size_energy ; ++i )
+  template <typename NumT>
+  std::string
+  energy_transfer(const Nessi::ExecutionPolicy & policy,
+                  const NumT initial_energy,
+                  const NumT initial_energy_err2,
+                  const Nessi::SpectrumBlock<NumT> & final_energy,
+                  Nessi::SpectrumBlock<NumT> & energy_transfer,
+                  void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!final_energy.same_shape(energy_transfer))
       {
-        retstr += __energy_transfer_dynamic(initial_energy,
-                                            initial_energy_err2,
-                                            final_energy[i],
-                                            final_energy_err2[i],
-                                            h, h2,
-                                            energy_transfer[i],
-                                            energy_transfer_err2[i]);
+        throw std::invalid_argument(et_func_str+" (s,b): blocks not the "
+                                    +"same shape");
       }
 
-    return retstr;
+    // blocks without padding are converted as a single array
+    return __map_kernel(policy,
+                        __EnergyTransferKernel<NumT>(initial_energy,
+                                                     initial_energy_err2),
+                        final_energy, energy_transfer);
   }
 
   template <typename NumT>
@@ -250,81 +384,38 @@ namespace AxisManip
                   NumT & energy_transfer_err2,
                   void *temp=NULL)
   {
-    std::string retstr(Nessi::EMPTY_WARN); // the warning string
-
-    // allocate local variables
-    NumT h;
-    NumT h2;
-
-    // fill the local variables
-    retstr += __energy_transfer_static(h,h2);
-
-    // do the calculation
-    retstr += __energy_transfer_dynamic(initial_energy, initial_energy_err2,
-                                        final_energy, final_energy_err2,
-                                        h, h2,
-                                        energy_transfer, energy_transfer_err2);
-
-    return retstr;
+    return __map_kernel(__EnergyTransferKernel<NumT>(initial_energy,
+                                                     initial_energy_err2),
+                        &final_energy, &final_energy_err2, &energy_transfer,
+                        &energy_transfer_err2, 1);
   }
 
-  /**
-   * \ingroup energy_transfer
-   *
-   * This is a PRIVATE helper function for energy_transfer that
-   * calculates parameters invariant across array calculation.
-   *
-   * \param h (OUTPUT) the value of Planck's constant casted to
-   * appropriate type.
-   * \param h2 (OUTPUT) the value of Planck's constant square casted
-   * to appropriate type.
-   */
+  // 3.30
   template <typename NumT>
   std::string
-  __energy_transfer_static(NumT & h,
-                           NumT & h2)
+  energy_transfer(const NumT initial_energy,
+                  const NumT initial_energy_err2,
+                  const Nessi::VectorView<const NumT> & final_energy,
+                  const Nessi::VectorView<const NumT> & final_energy_err2,
+                  const Nessi::VectorView<NumT> & energy_transfer,
+                  const Nessi::VectorView<NumT> & energy_transfer_err2,
+                  void *temp=NULL)
   {
-    h=static_cast<NumT>(PhysConst::H);
-    h2=h*h;
+    // check that the views are of proper size
+    size_t sz = final_energy.size();
+    if (final_energy_err2.size() != sz || energy_transfer.size() != sz
+        || energy_transfer_err2.size() != sz)
+      {
+        throw std::invalid_argument(et_func_str+" (view): views not the "
+                                    +"same size");
+      }
 
-    return Nessi::EMPTY_WARN;
+    return __map_kernel(__EnergyTransferKernel<NumT>(initial_energy,
+                                                     initial_energy_err2),
+                        final_energy, final_energy_err2, energy_transfer,
+                        energy_transfer_err2, sz);
   }
 
-  /**
-   * \ingroup energy_transfer
-   *
-   * This is a PRIVATE helper function for energy_transfer that
-   * calculates the energy_transfer and its uncertainty
-   *
-   * \param initial_energy (INPUT) same as parameter in energy_transfer()
-   * \param initial_energy_err2 (INPUT) same as parameter in energy_transfer()
-   * \param final_energy (INPUT) same as parameter in energy_transfer()
-   * \param final_energy_err2 (INPUT) same as parameter in energy_transfer()
-   * \param h (INPUT) the value of Planck's constant
-   * \param h2 (INPUT) the value of Planck's constant squared
-   * \param energy_transfer (OUTPUT) same as parameter in energy_transfer()
-   * \param energy_transfer_err2 (OUTPUT) same as parameter in
-   * energy_transfer()
-   */
-  template <typename NumT>
-  std::string
-  __energy_transfer_dynamic(const NumT initial_energy,
-                            const NumT initial_energy_err2,
-                            const NumT final_energy,
-                            const NumT final_energy_err2,
-                            const NumT h,
-                            const NumT h2,
-                            NumT & energy_transfer,
-                            NumT & energy_transfer_err2)
-  {
-    // the result
-    energy_transfer = (initial_energy - final_energy) / h;
-
-    // the uncertainty in the result
-    energy_transfer_err2 = (initial_energy_err2 + final_energy_err2) / h2;
-
-    return Nessi::EMPTY_WARN;
-  }
 } // AxisManip
 
 #endif // _ENERGY_TRANSFER_HPP
@@ -84,4 +84,92 @@ namespace AxisManip
                                          double & angular_frequency,
                                          double & angular_frequency_err2,
                                          void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.31 for
+   * blocks
+   *
+   * \ingroup frequency_to_angular_frequency
+   */
+  template std::string
+  frequency_to_angular_frequency<float>(const Nessi::SpectrumBlock<float> &
+                                        frequency,
+                                        Nessi::SpectrumBlock<float> &
+                                        angular_frequency,
+                                        void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.31 for
+   * blocks with an execution policy
+   *
+   * \ingroup frequency_to_angular_frequency
+   */
+  template std::string
+  frequency_to_angular_frequency<float>(const Nessi::ExecutionPolicy & policy,
+                                        const Nessi::SpectrumBlock<float> &
+                                        frequency,
+                                        Nessi::SpectrumBlock<float> &
+                                        angular_frequency,
+                                        void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.31 for blocks
+   *
+   * \ingroup frequency_to_angular_frequency
+   */
+  template std::string
+  frequency_to_angular_frequency<double>(const Nessi::SpectrumBlock<double> &
+                                         frequency,
+                                         Nessi::SpectrumBlock<double> &
+                                         angular_frequency,
+                                         void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.31 for blocks with an execution policy
+   *
+   * \ingroup frequency_to_angular_frequency
+   */
+  template std::string
+  frequency_to_angular_frequency<double>(const Nessi::ExecutionPolicy & policy,
+                                         const Nessi::SpectrumBlock<double> &
+                                         frequency,
+                                         Nessi::SpectrumBlock<double> &
+                                         angular_frequency,
+                                         void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.31 for views
+   *
+   * \ingroup frequency_to_angular_frequency
+   */
+  template std::string
+  frequency_to_angular_frequency<float>(const Nessi::VectorView<const float> &
+                                        frequency,
+                                        const Nessi::VectorView<const float> &
+                                        frequency_err2,
+                                        const Nessi::VectorView<float> &
+                                        angular_frequency,
+                                        const Nessi::VectorView<float> &
+                                        angular_frequency_err2,
+                                        void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.31 for views
+   *
+   * \ingroup frequency_to_angular_frequency
+   */
+  template std::string
+  frequency_to_angular_frequency<double>(
+                                const Nessi::VectorView<const double> &
+                                frequency,
+                                const Nessi::VectorView<const double> &
+                                frequency_err2,
+                                const Nessi::VectorView<double> &
+                                angular_frequency,
+                                const Nessi::VectorView<double> &
+                                angular_frequency_err2,
+                                void *temp);
 } // AxisManip
@@ -32,6 +32,7 @@
 
 #include "constants.hpp"
 #include "conversions.hpp"
+#include "map_kernel.hpp"
 #include "nessi_warn.hpp"
 #include "size_checks.hpp"
 #include <stdexcept>
@@ -41,6 +42,55 @@ namespace AxisManip
   /// String for holding the frequency_to_angular_frequency function name
   const std::string ftaf_func_str = "AxisManip::frequency_to_angular_frequency";
 
+  /**
+   * \ingroup frequency_to_angular_frequency
+   *
+   * This is a PRIVATE map kernel (see \ref map_kernel) converting frequency
+   * to angular frequency. The constants are the same for every pixel.
+   */
+  template <typename NumT>
+  class __FrequencyToAngularFrequencyKernel
+  {
+  public:
+    /// Type of the elements
+    typedef NumT value_type;
+
+    /// Constructor clearing the constants until setup() runs
+    __FrequencyToAngularFrequencyKernel()
+      : a_(0), a2_(0)
+    { }
+
+    /// Returns true, the conversion does not depend on the pixel
+    bool is_uniform() const
+    {
+      return true;
+    }
+
+    /// Calculates the constants
+    std::string setup(const std::size_t)
+    {
+      return __frequency_to_angular_frequency_static(a_, a2_);
+    }
+
+    /// Converts one bin
+    template <typename SinkT>
+    void operator()(const NumT frequency, const NumT frequency_err2,
+                    NumT & angular_frequency, NumT & angular_frequency_err2,
+                    SinkT & warnings) const
+    {
+      __frequency_to_angular_frequency_dynamic(frequency, frequency_err2,
+                                               angular_frequency,
+                                               angular_frequency_err2, a_, a2_,
+                                               warnings);
+    }
+
+  private:
+    /// The factor \f$2\pi\times 10^{12}\f$
+    NumT a_;
+    /// The square of the factor
+    NumT a2_;
+  };
+
   // 3.31
   template <typename NumT>
   std::string
@@ -80,26 +130,11 @@ namespace AxisManip
         throw std::invalid_argument(ftaf_func_str+" (v,v): frequency "
                                     +e.what());
       }
-    std::string retstr(Nessi::EMPTY_WARN);
-
-    NumT a;
-    NumT a2;
-
-    retstr += __frequency_to_angular_frequency_static(a,a2);
-
-    size_t sz = frequency.size();
-    for (size_t i=0; i < sz; ++i)
-      {
-        retstr += __frequency_to_angular_frequency_dynamic(frequency[i],
-                                                           frequency_err2[i],
-                                                           angular_frequency[i],
-                                                           angular_frequency_err2[i],
-                                                           a,
-                                                           a2);
-      }
-
-    return retstr;
 
+    return __map_kernel(__FrequencyToAngularFrequencyKernel<NumT>(),
+                        frequency.begin(), frequency_err2.begin(),
+                        angular_frequency.begin(),
+                        angular_frequency_err2.begin(), frequency.size());
   }
 
   // 3.31
@@ -111,21 +146,36 @@ namespace AxisManip
                                  NumT & angular_frequency_err2,
                                  void *temp=NULL)
   {
-    std::string retstr(Nessi::EMPTY_WARN);
-
-    NumT a;
-    NumT a2;
-
-    retstr += __frequency_to_angular_frequency_static(a,a2);
+    return __map_kernel(__FrequencyToAngularFrequencyKernel<NumT>(),
+                        &frequency, &frequency_err2, &angular_frequency,
+                        &angular_frequency_err2, 1);
+  }
 
-    retstr += __frequency_to_angular_frequency_dynamic(frequency,
-                                                       frequency_err2,
-                                                       angular_frequency,
-                                                       angular_frequency_err2,
-                                                       a,
-                                                       a2);
+  // 3.31
+  template <typename NumT>
+  std::string
+  frequency_to_angular_frequency(const Nessi::VectorView<const NumT> &
+                                 frequency,
+                                 const Nessi::VectorView<const NumT> &
+                                 frequency_err2,
+                                 const Nessi::VectorView<NumT> &
+                                 angular_frequency,
+                                 const Nessi::VectorView<NumT> &
+                                 angular_frequency_err2,
+                                 void *temp=NULL)
+  {
+    // check that the views are of proper size
+    size_t sz = frequency.size();
+    if (frequency_err2.size() != sz || angular_frequency.size() != sz
+        || angular_frequency_err2.size() != sz)
+      {
+        throw std::invalid_argument(ftaf_func_str+" (view): views not the "
+                                    +"same size");
+      }
 
-    return retstr;  
+    return __map_kernel(__FrequencyToAngularFrequencyKernel<NumT>(),
+                        frequency, frequency_err2, angular_frequency,
+                        angular_frequency_err2, sz);
   }
 
  /**
@@ -166,20 +216,53 @@ namespace AxisManip
    * _static()
    * \param a2 (INPUT) same as parameter in __frequency_to_angular_frequency
    * _static()
+   * \param warnings (OUTPUT) is the sink receiving the warnings
    */
-  template <typename NumT>
-  std::string
+  template <typename NumT, typename SinkT>
+  void
   __frequency_to_angular_frequency_dynamic(const NumT frequency,
                                            const NumT frequency_err2,
                                            NumT & angular_frequency,
                                            NumT & angular_frequency_err2,
                                            const NumT a,
-                                           const NumT a2)
+                                           const NumT a2,
+                                           SinkT & warnings)
   {
     angular_frequency = frequency * a;
     angular_frequency_err2 = a2 * frequency_err2;
+  }
 
-    return Nessi::EMPTY_WARN;
+  // 3.31
+  template <typename NumT>
+  std::string
+  frequency_to_angular_frequency(const Nessi::SpectrumBlock<NumT> & frequency,
+                                 Nessi::SpectrumBlock<NumT> &
+                                 angular_frequency,
+                                 void *temp=NULL)
+  {
+    return frequency_to_angular_frequency(Nessi::execution::seq, frequency,
+                                          angular_frequency, temp);
+  }
+
+  // 3.31
+  template <typename NumT>
+  std::string
+  frequency_to_angular_frequency(const Nessi::ExecutionPolicy & policy,
+                                 const Nessi::SpectrumBlock<NumT> & frequency,
+                                 Nessi::SpectrumBlock<NumT> &
+                                 angular_frequency,
+                                 void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!frequency.same_shape(angular_frequency))
+      {
+        throw std::invalid_argument(ftaf_func_str+" (b): blocks not the "
+                                    +"same shape");
+      }
+
+    // blocks without padding are converted as a single array
+    return __map_kernel(policy, __FrequencyToAngularFrequencyKernel<NumT>(),
+                        frequency, angular_frequency);
   }
 
 } // AxisManip
@@ -84,4 +84,78 @@ namespace AxisManip
                               double & energy,
                               double & energy_err2,
                               void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.47 for
+   * blocks
+   *
+   * \ingroup frequency_to_energy
+   */
+  template std::string
+  frequency_to_energy<float>(const Nessi::SpectrumBlock<float> & frequency,
+                             Nessi::SpectrumBlock<float> & energy,
+                             void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.47 for
+   * blocks with an execution policy
+   *
+   * \ingroup frequency_to_energy
+   */
+  template std::string
+  frequency_to_energy<float>(const Nessi::ExecutionPolicy & policy,
+                             const Nessi::SpectrumBlock<float> & frequency,
+                             Nessi::SpectrumBlock<float> & energy,
+                             void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.47 for blocks
+   *
+   * \ingroup frequency_to_energy
+   */
+  template std::string
+  frequency_to_energy<double>(const Nessi::SpectrumBlock<double> & frequency,
+                              Nessi::SpectrumBlock<double> & energy,
+                              void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.47 for blocks with an execution policy
+   *
+   * \ingroup frequency_to_energy
+   */
+  template std::string
+  frequency_to_energy<double>(const Nessi::ExecutionPolicy & policy,
+                              const Nessi::SpectrumBlock<double> & frequency,
+                              Nessi::SpectrumBlock<double> & energy,
+                              void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.47 for views
+   *
+   * \ingroup frequency_to_energy
+   */
+  template std::string
+  frequency_to_energy<float>(const Nessi::VectorView<const float> & frequency,
+                             const Nessi::VectorView<const float> &
+                             frequency_err2,
+                             const Nessi::VectorView<float> & energy,
+                             const Nessi::VectorView<float> & energy_err2,
+                             void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.47 for views
+   *
+   * \ingroup frequency_to_energy
+   */
+  template std::string
+  frequency_to_energy<double>(const Nessi::VectorView<const double> &
+                              frequency,
+                              const Nessi::VectorView<const double> &
+                              frequency_err2,
+                              const Nessi::VectorView<double> & energy,
+                              const Nessi::VectorView<double> & energy_err2,
+                              void *temp);
 } // AxisManip
@@ -32,6 +32,7 @@
 
 #include "constants.hpp"
 #include "conversions.hpp"
+#include "map_kernel.hpp"
 #include "nessi_warn.hpp"
 #include "size_checks.hpp"
 #include <stdexcept>
@@ -41,6 +42,52 @@ namespace AxisManip
   /// String for holding the frequency_to_energy function name
   const std::string fte_func_str = "AxisManip::frequency_to_energy";
 
+  /**
+   * \ingroup frequency_to_energy
+   *
+   * This is a PRIVATE map kernel (see \ref map_kernel) converting frequency
+   * to energy. The constants are the same for every pixel.
+   */
+  template <typename NumT>
+  class __FrequencyToEnergyKernel
+  {
+  public:
+    /// Type of the elements
+    typedef NumT value_type;
+
+    /// Constructor clearing the constants until setup() runs
+    __FrequencyToEnergyKernel()
+      : h_(0), h2_(0)
+    { }
+
+    /// Returns true, the conversion does not depend on the pixel
+    bool is_uniform() const
+    {
+      return true;
+    }
+
+    /// Calculates the constants
+    std::string setup(const std::size_t)
+    {
+      return __frequency_to_energy_static(h_, h2_);
+    }
+
+    /// Converts one bin
+    template <typename SinkT>
+    void operator()(const NumT frequency, const NumT frequency_err2,
+                    NumT & energy, NumT & energy_err2, SinkT & warnings) const
+    {
+      __frequency_to_energy_dynamic(frequency, frequency_err2, energy,
+                                    energy_err2, h_, h2_, warnings);
+    }
+
+  private:
+    /// Planck's constant
+    NumT h_;
+    /// The square of Planck's constant
+    NumT h2_;
+  };
+
   // 3.47
   template <typename NumT>
   std::string
@@ -80,25 +127,10 @@ namespace AxisManip
         throw std::invalid_argument(fte_func_str+" (v,v): frequency "
                                     +e.what());
       }
-    std::string retstr(Nessi::EMPTY_WARN);
-
-    NumT h;
-    NumT h2;
-
-    retstr += __frequency_to_energy_static(h,h2);
-
-    size_t sz = frequency.size();
-    for (size_t i=0; i < sz; ++i)
-      {
-        retstr += __frequency_to_energy_dynamic(frequency[i],
-                                                frequency_err2[i],
-                                                energy[i],
-                                                energy_err2[i],
-                                                h,
-                                                h2);
-      }
 
-    return retstr;
+    return __map_kernel(__FrequencyToEnergyKernel<NumT>(), frequency.begin(),
+                        frequency_err2.begin(), energy.begin(),
+                        energy_err2.begin(), frequency.size());
   }
 
   // 3.47
@@ -110,21 +142,30 @@ namespace AxisManip
                       NumT & energy_err2,
                       void *temp=NULL)
   {
-    std::string retstr(Nessi::EMPTY_WARN);
-
-    NumT h;
-    NumT h2;
-
-    retstr += __frequency_to_energy_static(h,h2);
+    return __map_kernel(__FrequencyToEnergyKernel<NumT>(), &frequency,
+                        &frequency_err2, &energy, &energy_err2, 1);
+  }
 
-    retstr += __frequency_to_energy_dynamic(frequency,
-                                            frequency_err2,
-                                            energy,
-                                            energy_err2,
-                                            h,
-                                            h2);
+  // 3.47
+  template <typename NumT>
+  std::string
+  frequency_to_energy(const Nessi::VectorView<const NumT> & frequency,
+                      const Nessi::VectorView<const NumT> & frequency_err2,
+                      const Nessi::VectorView<NumT> & energy,
+                      const Nessi::VectorView<NumT> & energy_err2,
+                      void *temp=NULL)
+  {
+    // check that the views are of proper size
+    size_t sz = frequency.size();
+    if (frequency_err2.size() != sz || energy.size() != sz
+        || energy_err2.size() != sz)
+      {
+        throw std::invalid_argument(fte_func_str+" (view): views not the "
+                                    +"same size");
+      }
 
-    return retstr;
+    return __map_kernel(__FrequencyToEnergyKernel<NumT>(), frequency,
+                        frequency_err2, energy, energy_err2, sz);
   }
 
   /**
@@ -159,20 +200,50 @@ namespace AxisManip
    * \param energy_err2 (OUTPUT) same as parameter in frequency_to_energy()
    * \param h (INPUT) same as parameter in __frequency_to_energy_static()
    * \param h2 (INPUT) same as parameter in __frequency_to_energy_static()
+   * \param warnings (OUTPUT) is the sink receiving the warnings
    */
-  template <typename NumT>
-  std::string
+  template <typename NumT, typename SinkT>
+  void
   __frequency_to_energy_dynamic(const NumT frequency,
                                 const NumT frequency_err2,
                                 NumT & energy,
                                 NumT & energy_err2,
                                 const NumT h,
-                                const NumT h2)
+                                const NumT h2,
+                                SinkT & warnings)
   {
     energy = frequency * h;
     energy_err2 = h2 * frequency_err2;
+  }
 
-    return Nessi::EMPTY_WARN;
+  // 3.47
+  template <typename NumT>
+  std::string
+  frequency_to_energy(const Nessi::SpectrumBlock<NumT> & frequency,
+                      Nessi::SpectrumBlock<NumT> & energy,
+                      void *temp=NULL)
+  {
+    return frequency_to_energy(Nessi::execution::seq, frequency, energy, temp);
+  }
+
+  // 3.47
+  template <typename NumT>
+  std::string
+  frequency_to_energy(const Nessi::ExecutionPolicy & policy,
+                      const Nessi::SpectrumBlock<NumT> & frequency,
+                      Nessi::SpectrumBlock<NumT> & energy,
+                      void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!frequency.same_shape(energy))
+      {
+        throw std::invalid_argument(fte_func_str+" (b): blocks not the "
+                                    +"same shape");
+      }
+
+    // blocks without padding are converted as a single array
+    return __map_kernel(policy, __FrequencyToEnergyKernel<NumT>(), frequency,
+                        energy);
   }
 
 } // AxisManip
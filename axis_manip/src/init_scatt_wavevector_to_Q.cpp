@@ -220,4 +220,129 @@ namespace AxisManip
                          double & Qz,
                          double & Qz_err2,
                          void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.32 for
+   * blocks with a geometry cache
+   *
+   * \ingroup init_scatt_wavevector_to_Q
+   */
+  template std::string
+  init_scatt_wavevector_to_Q<float>(const float initial_wavevector,
+                                    const float initial_wavevector_err2,
+                                    const Nessi::SpectrumBlock<float> &
+                                    final_wavevector,
+                                    const InstrumentGeometryCache<float> &
+                                    geometry,
+                                    Nessi::SpectrumBlock<float> & Qx,
+                                    Nessi::SpectrumBlock<float> & Qy,
+                                    Nessi::SpectrumBlock<float> & Qz,
+                                    void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.32 for
+   * blocks with a geometry cache and an execution
+   * policy
+   *
+   * \ingroup init_scatt_wavevector_to_Q
+   */
+  template std::string
+  init_scatt_wavevector_to_Q<float>(const Nessi::ExecutionPolicy & policy,
+                                    const float initial_wavevector,
+                                    const float initial_wavevector_err2,
+                                    const Nessi::SpectrumBlock<float> &
+                                    final_wavevector,
+                                    const InstrumentGeometryCache<float> &
+                                    geometry,
+                                    Nessi::SpectrumBlock<float> & Qx,
+                                    Nessi::SpectrumBlock<float> & Qy,
+                                    Nessi::SpectrumBlock<float> & Qz,
+                                    void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.32 for blocks with a geometry cache
+   *
+   * \ingroup init_scatt_wavevector_to_Q
+   */
+  template std::string
+  init_scatt_wavevector_to_Q<double>(const double initial_wavevector,
+                                     const double initial_wavevector_err2,
+                                     const Nessi::SpectrumBlock<double> &
+                                     final_wavevector,
+                                     const InstrumentGeometryCache<double> &
+                                     geometry,
+                                     Nessi::SpectrumBlock<double> & Qx,
+                                     Nessi::SpectrumBlock<double> & Qy,
+                                     Nessi::SpectrumBlock<double> & Qz,
+                                     void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.32 for blocks with a geometry cache and an execution
+   * policy
+   *
+   * \ingroup init_scatt_wavevector_to_Q
+   */
+  template std::string
+  init_scatt_wavevector_to_Q<double>(const Nessi::ExecutionPolicy & policy,
+                                     const double initial_wavevector,
+                                     const double initial_wavevector_err2,
+                                     const Nessi::SpectrumBlock<double> &
+                                     final_wavevector,
+                                     const InstrumentGeometryCache<double> &
+                                     geometry,
+                                     Nessi::SpectrumBlock<double> & Qx,
+                                     Nessi::SpectrumBlock<double> & Qy,
+                                     Nessi::SpectrumBlock<double> & Qz,
+                                     void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.32 for views
+   *
+   * \ingroup init_scatt_wavevector_to_Q
+   */
+  template std::string
+  init_scatt_wavevector_to_Q<float>(const float initial_wavevector,
+                                    const float initial_wavevector_err2,
+                                    const Nessi::VectorView<const float> &
+                                    final_wavevector,
+                                    const Nessi::VectorView<const float> &
+                                    final_wavevector_err2,
+                                    const float azimuthal,
+                                    const float azimuthal_err2,
+                                    const float polar,
+                                    const float polar_err2,
+                                    const Nessi::VectorView<float> & Qx,
+                                    const Nessi::VectorView<float> & Qx_err2,
+                                    const Nessi::VectorView<float> & Qy,
+                                    const Nessi::VectorView<float> & Qy_err2,
+                                    const Nessi::VectorView<float> & Qz,
+                                    const Nessi::VectorView<float> & Qz_err2,
+                                    void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.32 for views
+   *
+   * \ingroup init_scatt_wavevector_to_Q
+   */
+  template std::string
+  init_scatt_wavevector_to_Q<double>(const double initial_wavevector,
+                                     const double initial_wavevector_err2,
+                                     const Nessi::VectorView<const double> &
+                                     final_wavevector,
+                                     const Nessi::VectorView<const double> &
+                                     final_wavevector_err2,
+                                     const double azimuthal,
+                                     const double azimuthal_err2,
+                                     const double polar,
+                                     const double polar_err2,
+                                     const Nessi::VectorView<double> & Qx,
+                                     const Nessi::VectorView<double> & Qx_err2,
+                                     const Nessi::VectorView<double> & Qy,
+                                     const Nessi::VectorView<double> & Qy_err2,
+                                     const Nessi::VectorView<double> & Qz,
+                                     const Nessi::VectorView<double> & Qz_err2,
+                                     void *temp);
 } // AxisManip
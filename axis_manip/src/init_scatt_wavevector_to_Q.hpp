@@ -31,10 +31,12 @@
 #define _INIT_SCATT_WAVEVECTOR_TO_Q_HPP 1
 
 #include "conversions.hpp"
+#include "nessi_exec.hpp"
 #include "nessi_warn.hpp"
 #include "size_checks.hpp"
 #include <cmath>
 #include <stdexcept>
+#include <vector>
 
 namespace AxisManip
 {
@@ -42,6 +44,151 @@ namespace AxisManip
   const std::string
   iswtq_func_str = "AxisManip::init_scatt_wavevector_to_Q";
 
+  /**
+   * \ingroup init_scatt_wavevector_to_Q
+   *
+   * This is a PRIVATE helper function for
+   * init_scatt_wavevector_to_Q that calculates parameters
+   * invariant across array calculation.
+   * 
+   * \param azimuthal (INPUT) same as parameter in
+   * init_scatt_wavevector_to_Q()
+   * \param polar (INPUT) same as parameter in
+   * init_scatt_wavevector_to_Q()
+   * \param a (OUTPUT) \f$=\cos(azimuthal)\f$
+   * \param a2 (OUTPUT) \f$=a*a\f$
+   * \param b (OUTPUT) \f$=\sin(azimuthal)\f$
+   * \param b2 (OUTPUT) \f$=b*b\f$
+   * \param c (OUTPUT) \f$=\cos(polar)\f$
+   * \param c2 (OUTPUT) \f$=c*c\f$
+   * \param d (OUTPUT) \f$=\sin(polar)\f$
+   * \param d2 (OUTPUT) \f$=d*d\f$
+   */
+  template <typename NumT>
+  std::string
+  __init_scatt_wavevector_to_Q_static(const NumT azimuthal, 
+                                      const NumT polar, 
+                                      NumT & a, 
+                                      NumT & a2, 
+                                      NumT & b, 
+                                      NumT & b2,
+                                      NumT & c, 
+                                      NumT & c2, 
+                                      NumT & d, 
+                                      NumT & d2)
+
+  {
+    a = static_cast<NumT>(std::cos(static_cast<double>(azimuthal)));
+    a2 = a * a;
+    b = static_cast<NumT>(std::sin(static_cast<double>(azimuthal)));
+    b2 = b * b;
+    c = static_cast<NumT>(std::cos(static_cast<double>(polar)));
+    c2 = c * c;
+    d = static_cast<NumT>(std::sin(static_cast<double>(polar)));
+    d2 = d * d;
+
+    return Nessi::EMPTY_WARN;
+  }
+
+  /**
+   * \ingroup init_scatt_wavevector_to_Q
+   *
+   * This is a PRIVATE helper function for
+   * init_scatt_wavevector_to_Q that calculates the 
+   * momentum transfer and its uncertainty
+   *
+   * \param initial_wavevector (INPUT) same as parameter in
+   * init_scatt_wavevector_to_Q()
+   * \param initial_wavevector_err2 (INPUT) same as parameter in
+   * init_scatt_wavevector_to_Q()
+   * \param final_wavevector (INPUT) same as parameter in
+   * init_scatt_wavevector_to_Q()
+   * \param final_wavevector_err2 (INPUT) same as parameter in
+   * init_scatt_wavevector_to_Q()
+   * \param azimuthal (INPUT) same as parameter in init_scatt_wavevector_to_Q()
+   * \param azimuthal_err2 (INPUT) same as parameter in
+   * init_scatt_wavevector_to_Q()
+   * \param polar (INPUT) same as parameter in init_scatt_wavevector_to_Q()
+   * \param polar_err2 (INPUT) same as parameter in
+   * init_scatt_wavevector_to_Q()
+   * \param a (INPUT) same as a parameter of
+   * __init_scatt_wavevector_to_Q_static()
+   * \param a2 (INPUT) same as a2 parameter of
+   * __init_scatt_wavevector_to_Q_static()
+   * \param b (INPUT) same as b parameter of
+   * __init_scatt_wavevector_to_Q_static()
+   * \param b2 (INPUT) same as b2 parameter of
+   * __init_scatt_wavevector_to_Q_static()
+   * \param c (INPUT) same as c parameter of
+   * __init_scatt_wavevector_to_Q_static()
+   * \param c2 (INPUT) same as c2 parameter of
+   * __init_scatt_wavevector_to_Q_static()
+   * \param d (INPUT) same as d parameter of
+   * __init_scatt_wavevector_to_Q_static()
+   * \param d2 (INPUT) same as d2 parameter of
+   * __init_scatt_wavevector_to_Q_static()
+   * \param Qx (OUTPUT) same as parameter in
+   * init_scatt_wavevector_to_Q()
+   * \param Qx_err2 (OUTPUT) same as parameter in
+   * init_scatt_wavevector_to_Q()
+   * \param Qy (OUTPUT) same as parameter in
+   * init_scatt_wavevector_to_Q()
+   * \param Qy_err2 (OUTPUT) same as parameter in
+   * init_scatt_wavevector_to_Q()
+   * \param Qz (OUTPUT) same as parameter in
+   * init_scatt_wavevector_to_Q()
+   * \param Qz_err2 (OUTPUT) same as parameter in
+   * init_scatt_wavevector_to_Q()
+   * \param warnings (OUTPUT) is the sink receiving the warnings
+   *
+   */
+  template <typename NumT, typename SinkT>
+  void
+  __init_scatt_wavevector_to_Q_dynamic(const NumT initial_wavevector,
+                                       const NumT initial_wavevector_err2,
+                                       const NumT final_wavevector,
+                                       const NumT final_wavevector_err2,
+                                       const NumT azimuthal,
+                                       const NumT azimuthal_err2,
+                                       const NumT polar,
+                                       const NumT polar_err2,
+                                       const NumT a,
+                                       const NumT a2,
+                                       const NumT b,
+                                       const NumT b2,
+                                       const NumT c,
+                                       const NumT c2,
+                                       const NumT d,
+                                       const NumT d2,
+                                       NumT & Qx,
+                                       NumT & Qx_err2,
+                                       NumT & Qy,
+                                       NumT & Qy_err2,
+                                       NumT & Qz,
+                                       NumT & Qz_err2,
+                                       SinkT & warnings)
+  
+  {
+    NumT kf = final_wavevector;
+    NumT kf2 = kf * kf;
+
+    Qx = static_cast<NumT>(-kf * a * d);
+    Qy = static_cast<NumT>(-kf * b * d);
+    Qz = static_cast<NumT>(initial_wavevector - (kf * c));
+
+    Qx_err2 = static_cast<NumT>((a2 * d2 * final_wavevector_err2)
+                                + (kf2 * b2 * d2 * azimuthal_err2)
+                                + (kf2 * a2 * c2 * polar_err2));
+    
+    Qy_err2 = static_cast<NumT>((b2 * d2 * final_wavevector_err2)
+                                + (kf2 * a2 * d2 * azimuthal_err2)
+                                + (kf2 * b2 * c2 * polar_err2));
+
+    Qz_err2 = static_cast<NumT>((initial_wavevector_err2)
+                                + (c2 * final_wavevector_err2)
+                                + (kf2 * d2 * polar_err2));
+  }
+
   // 3.32
   template <typename NumT>
   std::string
@@ -112,7 +259,7 @@ namespace AxisManip
                                     +" (v,v): initial_wavevector "+e.what());
      }
 
-   std::string retstr(Nessi::EMPTY_WARN); // the warning string
+   Nessi::DefaultWarningSink warnings;
 
    // allocate local variables
    NumT a;
@@ -125,35 +272,35 @@ namespace AxisManip
    NumT d2;
 
    // fill the local variables
-   retstr += __init_scatt_wavevector_to_Q_static(azimuthal_angle, 
-                                                 polar_angle, 
-                                                 a, a2, b, b2,
-                                                 c, c2, d, d2);
+   warnings.report(__init_scatt_wavevector_to_Q_static(azimuthal_angle,
+                                                       polar_angle,
+                                                       a, a2, b, b2,
+                                                       c, c2, d, d2));
 
    // do the calculation
    size_t size_wavevector=initial_wavevector.size();
    for (size_t i = 0 ; i < size_wavevector ; ++i)
      {
-       retstr +=
-         __init_scatt_wavevector_to_Q_dynamic(initial_wavevector[i],
-                                              initial_wavevector_err2[i],
-                                              final_wavevector[i],
-                                              final_wavevector_err2[i],
-                                              azimuthal_angle,
-                                              azimuthal_angle_err2,
-                                              polar_angle,
-                                              polar_angle_err2, 
-                                              a, a2, b, b2,
-                                              c, c2, d, d2,
-                                              Qx[i], 
-                                              Qx_err2[i],
-                                              Qy[i],
-                                              Qy_err2[i],
-                                              Qz[i],
-                                              Qz_err2[i]);
+       __init_scatt_wavevector_to_Q_dynamic(initial_wavevector[i],
+                                            initial_wavevector_err2[i],
+                                            final_wavevector[i],
+                                            final_wavevector_err2[i],
+                                            azimuthal_angle,
+                                            azimuthal_angle_err2,
+                                            polar_angle,
+                                            polar_angle_err2, 
+                                            a, a2, b, b2,
+                                            c, c2, d, d2,
+                                            Qx[i], 
+                                            Qx_err2[i],
+                                            Qy[i],
+                                            Qy_err2[i],
+                                            Qz[i],
+                                            Qz_err2[i],
+                                            warnings);
      }
 
-   return retstr;
+   return warnings.str();
  }
 
   template <typename NumT>
@@ -222,7 +369,7 @@ namespace AxisManip
                                     +" (s,v): final_wavevector "+e.what());
       }
 
-    std::string retstr(Nessi::EMPTY_WARN); // the warning string
+    Nessi::DefaultWarningSink warnings;
 
     // allocate local variables
     NumT a;
@@ -235,35 +382,35 @@ namespace AxisManip
     NumT d2;
 
     // fill the local variables
-    retstr += __init_scatt_wavevector_to_Q_static(azimuthal, 
-                                                  polar, 
-                                                  a, a2, b, b2,
-                                                  c, c2, d, d2);
+    warnings.report(__init_scatt_wavevector_to_Q_static(azimuthal,
+                                                        polar,
+                                                        a, a2, b, b2,
+                                                        c, c2, d, d2));
 
     // do the calculation
     size_t size_wavevector=final_wavevector.size();
     for (size_t i = 0 ; i < size_wavevector ; ++i)
       {
-        retstr +=
-          __init_scatt_wavevector_to_Q_dynamic(initial_wavevector,
-                                               initial_wavevector_err2,
-                                               final_wavevector[i],
-                                               final_wavevector_err2[i],
-                                               azimuthal,
-                                               azimuthal_err2,
-                                               polar,
-                                               polar_err2, 
-                                               a, a2, b, b2,
-                                               c, c2, d, d2,
-                                               Qx[i], 
-                                               Qx_err2[i],
-                                               Qy[i],
-                                               Qy_err2[i],
-                                               Qz[i],
-                                               Qz_err2[i]);
+        __init_scatt_wavevector_to_Q_dynamic(initial_wavevector,
+                                             initial_wavevector_err2,
+                                             final_wavevector[i],
+                                             final_wavevector_err2[i],
+                                             azimuthal,
+                                             azimuthal_err2,
+                                             polar,
+                                             polar_err2, 
+                                             a, a2, b, b2,
+                                             c, c2, d, d2,
+                                             Qx[i], 
+                                             Qx_err2[i],
+                                             Qy[i],
+                                             Qy_err2[i],
+                                             Qz[i],
+                                             Qz_err2[i],
+                                             warnings);
       }
 
-    return retstr; 
+    return warnings.str();
   }
 
   template <typename NumT>
@@ -333,7 +480,7 @@ namespace AxisManip
                                     +" (v,s): initial_wavevector "+e.what());
       }
 
-    std::string retstr(Nessi::EMPTY_WARN); // the warning string
+    Nessi::DefaultWarningSink warnings;
 
     // allocate local variables
     NumT a;
@@ -346,34 +493,34 @@ namespace AxisManip
     NumT d2;
 
     // fill the local variables
-    retstr += __init_scatt_wavevector_to_Q_static(azimuthal, 
-                                                  polar, 
-                                                  a, a2, b, b2,
-                                                  c, c2, d, d2);
+    warnings.report(__init_scatt_wavevector_to_Q_static(azimuthal,
+                                                        polar,
+                                                        a, a2, b, b2,
+                                                        c, c2, d, d2));
     // do the calculation
     size_t size_wavevector=initial_wavevector.size();
     for (size_t i = 0 ; i < size_wavevector ; ++i)
       {
-        retstr +=
-          __init_scatt_wavevector_to_Q_dynamic(initial_wavevector[i],
-                                               initial_wavevector_err2[i],
-                                               final_wavevector,
-                                               final_wavevector_err2,
-                                               azimuthal,
-                                               azimuthal_err2,
-                                               polar,
-                                               polar_err2, 
-                                               a, a2, b, b2,
-                                               c, c2, d, d2,
-                                               Qx[i], 
-                                               Qx_err2[i],
-                                               Qy[i],
-                                               Qy_err2[i],
-                                               Qz[i],
-                                               Qz_err2[i]);
+        __init_scatt_wavevector_to_Q_dynamic(initial_wavevector[i],
+                                             initial_wavevector_err2[i],
+                                             final_wavevector,
+                                             final_wavevector_err2,
+                                             azimuthal,
+                                             azimuthal_err2,
+                                             polar,
+                                             polar_err2, 
+                                             a, a2, b, b2,
+                                             c, c2, d, d2,
+                                             Qx[i], 
+                                             Qx_err2[i],
+                                             Qy[i],
+                                             Qy_err2[i],
+                                             Qz[i],
+                                             Qz_err2[i],
+                                             warnings);
       }
 
-    return retstr;
+    return warnings.str();
   }
 
   template <typename NumT>
@@ -394,7 +541,7 @@ namespace AxisManip
                              NumT & Qz_err2,
                              void *temp=NULL)
   {
-    std::string retstr(Nessi::EMPTY_WARN); // the warning string
+    Nessi::DefaultWarningSink warnings;
 
     // allocate local variables
     NumT a;
@@ -407,181 +554,269 @@ namespace AxisManip
     NumT d2;
 
     // fill the local variables
-    retstr += __init_scatt_wavevector_to_Q_static(azimuthal, 
-                                                  polar, 
-                                                  a, a2, b, b2,
-                                                  c, c2, d, d2);
+    warnings.report(__init_scatt_wavevector_to_Q_static(azimuthal,
+                                                        polar,
+                                                        a, a2, b, b2,
+                                                        c, c2, d, d2));
     
     // do the calculation
-    retstr +=
-      __init_scatt_wavevector_to_Q_dynamic(initial_wavevector,
-                                           initial_wavevector_err2,
-                                           final_wavevector,
-                                           final_wavevector_err2,
-                                           azimuthal,
-                                           azimuthal_err2,
-                                           polar,
-                                           polar_err2, 
-                                           a, a2, b, b2,
-                                           c, c2, d, d2,
-                                           Qx, 
-                                           Qx_err2,
-                                           Qy,
-                                           Qy_err2,
-                                           Qz,
-                                           Qz_err2);
-
-    return retstr;
+    __init_scatt_wavevector_to_Q_dynamic(initial_wavevector,
+                                         initial_wavevector_err2,
+                                         final_wavevector,
+                                         final_wavevector_err2,
+                                         azimuthal,
+                                         azimuthal_err2,
+                                         polar,
+                                         polar_err2, 
+                                         a, a2, b, b2,
+                                         c, c2, d, d2,
+                                         Qx, 
+                                         Qx_err2,
+                                         Qy,
+                                         Qy_err2,
+                                         Qz,
+                                         Qz_err2,
+                                         warnings);
+
+    return warnings.str();
   }
-  
-  /**
-   * \ingroup init_scatt_wavevector_to_Q
-   *
-   * This is a PRIVATE helper function for
-   * init_scatt_wavevector_to_Q that calculates parameters
-   * invariant across array calculation.
-   * 
-   * \param azimuthal (INPUT) same as parameter in
-   * init_scatt_wavevector_to_Q()
-   * \param polar (INPUT) same as parameter in
-   * init_scatt_wavevector_to_Q()
-   * \param a (OUTPUT) \f$=\cos(azimuthal)\f$
-   * \param a2 (OUTPUT) \f$=a*a\f$
-   * \param b (OUTPUT) \f$=\sin(azimuthal)\f$
-   * \param b2 (OUTPUT) \f$=b*b\f$
-   * \param c (OUTPUT) \f$=\cos(polar)\f$
-   * \param c2 (OUTPUT) \f$=c*c\f$
-   * \param d (OUTPUT) \f$=\sin(polar)\f$
-   * \param d2 (OUTPUT) \f$=d*d\f$
-   */
+
+  // 3.32
   template <typename NumT>
   std::string
-  __init_scatt_wavevector_to_Q_static(const NumT azimuthal, 
-                                      const NumT polar, 
-                                      NumT & a, 
-                                      NumT & a2, 
-                                      NumT & b, 
-                                      NumT & b2,
-                                      NumT & c, 
-                                      NumT & c2, 
-                                      NumT & d, 
-                                      NumT & d2)
-
+  init_scatt_wavevector_to_Q(const NumT initial_wavevector,
+                             const NumT initial_wavevector_err2,
+                             const Nessi::VectorView<const NumT> &
+                             final_wavevector,
+                             const Nessi::VectorView<const NumT> &
+                             final_wavevector_err2,
+                             const NumT azimuthal,
+                             const NumT azimuthal_err2,
+                             const NumT polar,
+                             const NumT polar_err2,
+                             const Nessi::VectorView<NumT> & Qx,
+                             const Nessi::VectorView<NumT> & Qx_err2,
+                             const Nessi::VectorView<NumT> & Qy,
+                             const Nessi::VectorView<NumT> & Qy_err2,
+                             const Nessi::VectorView<NumT> & Qz,
+                             const Nessi::VectorView<NumT> & Qz_err2,
+                             void *temp=NULL)
   {
-    a = static_cast<NumT>(std::cos(static_cast<double>(azimuthal)));
-    a2 = a * a;
-    b = static_cast<NumT>(std::sin(static_cast<double>(azimuthal)));
-    b2 = b * b;
-    c = static_cast<NumT>(std::cos(static_cast<double>(polar)));
-    c2 = c * c;
-    d = static_cast<NumT>(std::sin(static_cast<double>(polar)));
-    d2 = d * d;
+    // check that the views are of proper size
+    size_t sz = final_wavevector.size();
+    if (final_wavevector_err2.size() != sz || Qx.size() != sz
+        || Qx_err2.size() != sz || Qy.size() != sz || Qy_err2.size() != sz
+        || Qz.size() != sz || Qz_err2.size() != sz)
+      {
+        throw std::invalid_argument(iswtq_func_str+" (view): views not the "
+                                    +"same size");
+      }
 
-    return Nessi::EMPTY_WARN;
+    Nessi::DefaultWarningSink warnings;
+
+    // allocate local variables
+    NumT a;
+    NumT a2;
+    NumT b;
+    NumT b2;
+    NumT c;
+    NumT c2;
+    NumT d;
+    NumT d2;
+
+    // fill the local variables
+    warnings.report(__init_scatt_wavevector_to_Q_static(azimuthal,
+                                                        polar,
+                                                        a, a2, b, b2,
+                                                        c, c2, d, d2));
+
+    // do the calculation
+    for (size_t i = 0 ; i < sz ; ++i)
+      {
+        __init_scatt_wavevector_to_Q_dynamic(initial_wavevector,
+                                             initial_wavevector_err2,
+                                             final_wavevector[i],
+                                             final_wavevector_err2[i],
+                                             azimuthal,
+                                             azimuthal_err2,
+                                             polar,
+                                             polar_err2,
+                                             a, a2, b, b2,
+                                             c, c2, d, d2,
+                                             Qx[i],
+                                             Qx_err2[i],
+                                             Qy[i],
+                                             Qy_err2[i],
+                                             Qz[i],
+                                             Qz_err2[i],
+                                             warnings);
+      }
+
+    return warnings.str();
   }
 
   /**
    * \ingroup init_scatt_wavevector_to_Q
    *
-   * This is a PRIVATE helper function for
-   * init_scatt_wavevector_to_Q that calculates the 
-   * momentum transfer and its uncertainty
-   *
-   * \param initial_wavevector (INPUT) same as parameter in
-   * init_scatt_wavevector_to_Q()
-   * \param initial_wavevector_err2 (INPUT) same as parameter in
-   * init_scatt_wavevector_to_Q()
-   * \param final_wavevector (INPUT) same as parameter in
-   * init_scatt_wavevector_to_Q()
-   * \param final_wavevector_err2 (INPUT) same as parameter in
-   * init_scatt_wavevector_to_Q()
-   * \param azimuthal (INPUT) same as parameter in init_scatt_wavevector_to_Q()
-   * \param azimuthal_err2 (INPUT) same as parameter in
-   * init_scatt_wavevector_to_Q()
-   * \param polar (INPUT) same as parameter in init_scatt_wavevector_to_Q()
-   * \param polar_err2 (INPUT) same as parameter in
-   * init_scatt_wavevector_to_Q()
-   * \param a (INPUT) same as a parameter of
-   * __init_scatt_wavevector_to_Q_static()
-   * \param a2 (INPUT) same as a2 parameter of
-   * __init_scatt_wavevector_to_Q_static()
-   * \param b (INPUT) same as b parameter of
-   * __init_scatt_wavevector_to_Q_static()
-   * \param b2 (INPUT) same as b2 parameter of
-   * __init_scatt_wavevector_to_Q_static()
-   * \param c (INPUT) same as c parameter of
-   * __init_scatt_wavevector_to_Q_static()
-   * \param c2 (INPUT) same as c2 parameter of
-   * __init_scatt_wavevector_to_Q_static()
-   * \param d (INPUT) same as d parameter of
-   * __init_scatt_wavevector_to_Q_static()
-   * \param d2 (INPUT) same as d2 parameter of
-   * __init_scatt_wavevector_to_Q_static()
-   * \param Qx (OUTPUT) same as parameter in
-   * init_scatt_wavevector_to_Q()
-   * \param Qx_err2 (OUTPUT) same as parameter in
-   * init_scatt_wavevector_to_Q()
-   * \param Qy (OUTPUT) same as parameter in
-   * init_scatt_wavevector_to_Q()
-   * \param Qy_err2 (OUTPUT) same as parameter in
-   * init_scatt_wavevector_to_Q()
-   * \param Qz (OUTPUT) same as parameter in
-   * init_scatt_wavevector_to_Q()
-   * \param Qz_err2 (OUTPUT) same as parameter in
-   * init_scatt_wavevector_to_Q()
-   *
+   * This is a PRIVATE function object for the block version of
+   * init_scatt_wavevector_to_Q that converts a range of pixels with the
+   * constants of an InstrumentGeometryCache. The shapes must have been
+   * checked.
    */
   template <typename NumT>
-  std::string
-  __init_scatt_wavevector_to_Q_dynamic(const NumT initial_wavevector,
-                                       const NumT initial_wavevector_err2,
-                                       const NumT final_wavevector,
-                                       const NumT final_wavevector_err2,
-                                       const NumT azimuthal,
-                                       const NumT azimuthal_err2,
-                                       const NumT polar,
-                                       const NumT polar_err2,
-                                       const NumT a,
-                                       const NumT a2,
-                                       const NumT b,
-                                       const NumT b2,
-                                       const NumT c,
-                                       const NumT c2,
-                                       const NumT d,
-                                       const NumT d2,
-                                       NumT & Qx,
-                                       NumT & Qx_err2,
-                                       NumT & Qy,
-                                       NumT & Qy_err2,
-                                       NumT & Qz,
-                                       NumT & Qz_err2)
-  
+  class __InitScattWavevectorToQBlock
   {
-    NumT kf = final_wavevector;
-    NumT kf2 = kf * kf;
-
-    Qx = static_cast<NumT>(-kf * a * d);
-    Qy = static_cast<NumT>(-kf * b * d);
-    Qz = static_cast<NumT>(initial_wavevector - (kf * c));
-
-    Qx_err2 = static_cast<NumT>((a2 * d2 * final_wavevector_err2)
-                                + (kf2 * b2 * d2 * azimuthal_err2)
-                                + (kf2 * a2 * c2 * polar_err2));
-    
-    Qy_err2 = static_cast<NumT>((b2 * d2 * final_wavevector_err2)
-                                + (kf2 * a2 * d2 * azimuthal_err2)
-                                + (kf2 * b2 * c2 * polar_err2));
+  public:
+    /// Type of the geometry cache
+    typedef InstrumentGeometryCache<NumT> Cache;
+
+    /// Constructor keeping the arguments of init_scatt_wavevector_to_Q()
+    __InitScattWavevectorToQBlock(const NumT initial_wavevector,
+                                  const NumT initial_wavevector_err2,
+                                  const Nessi::SpectrumBlock<NumT> &
+                                  final_wavevector,
+                                  const Cache & geometry,
+                                  Nessi::SpectrumBlock<NumT> & Qx,
+                                  Nessi::SpectrumBlock<NumT> & Qy,
+                                  Nessi::SpectrumBlock<NumT> & Qz,
+                                  std::vector<Nessi::DefaultWarningSink> &
+                                  warnings)
+      : ki_(initial_wavevector), ki_err2_(initial_wavevector_err2),
+        kf_(final_wavevector), geometry_(geometry), Qx_(Qx), Qy_(Qy),
+        Qz_(Qz), warnings_(warnings)
+    { }
+
+    /// Converts the pixels [begin, end) into the sink of \p chunk
+    void operator()(const std::size_t chunk, const std::size_t begin,
+                    const std::size_t end) const
+    {
+      Nessi::DefaultWarningSink & warnings = warnings_[chunk];
+      const NumT * azimuthal = geometry_.column(Cache::AZIMUTHAL);
+      const NumT * azimuthal_err2 = geometry_.column(Cache::AZIMUTHAL_ERR2);
+      const NumT * polar = geometry_.column(Cache::POLAR);
+      const NumT * polar_err2 = geometry_.column(Cache::POLAR_ERR2);
+      const NumT * a = geometry_.column(Cache::ISWTQ_A);
+      const NumT * a2 = geometry_.column(Cache::ISWTQ_A2);
+      const NumT * b = geometry_.column(Cache::ISWTQ_B);
+      const NumT * b2 = geometry_.column(Cache::ISWTQ_B2);
+      const NumT * c = geometry_.column(Cache::ISWTQ_C);
+      const NumT * c2 = geometry_.column(Cache::ISWTQ_C2);
+      const NumT * d = geometry_.column(Cache::ISWTQ_D);
+      const NumT * d2 = geometry_.column(Cache::ISWTQ_D2);
+
+      std::size_t num_bins = kf_.num_bins();
+      for (std::size_t p = begin; p < end; ++p)
+        {
+          const NumT * kf = kf_.value(p);
+          const NumT * kf_err2 = kf_.err2(p);
+          NumT * Qx = Qx_.value(p);
+          NumT * Qx_err2 = Qx_.err2(p);
+          NumT * Qy = Qy_.value(p);
+          NumT * Qy_err2 = Qy_.err2(p);
+          NumT * Qz = Qz_.value(p);
+          NumT * Qz_err2 = Qz_.err2(p);
+          for (std::size_t i = 0; i < num_bins; ++i)
+            {
+              __init_scatt_wavevector_to_Q_dynamic(ki_, ki_err2_, kf[i],
+                                                   kf_err2[i], azimuthal[p],
+                                                   azimuthal_err2[p],
+                                                   polar[p], polar_err2[p],
+                                                   a[p], a2[p], b[p], b2[p],
+                                                   c[p], c2[p], d[p], d2[p],
+                                                   Qx[i], Qx_err2[i], Qy[i],
+                                                   Qy_err2[i], Qz[i],
+                                                   Qz_err2[i], warnings);
+            }
+        }
+    }
+
+  private:
+    /// The initial wavevector
+    NumT ki_;
+    /// The square of the uncertainty in the initial wavevector
+    NumT ki_err2_;
+    /// The final wavevectors
+    const Nessi::SpectrumBlock<NumT> & kf_;
+    /// The constants of the pixels
+    const Cache & geometry_;
+    /// The x components of the momentum transfer
+    Nessi::SpectrumBlock<NumT> & Qx_;
+    /// The y components of the momentum transfer
+    Nessi::SpectrumBlock<NumT> & Qy_;
+    /// The z components of the momentum transfer
+    Nessi::SpectrumBlock<NumT> & Qz_;
+    /// The warnings of every chunk
+    std::vector<Nessi::DefaultWarningSink> & warnings_;
+  };
 
-    Qz_err2 = static_cast<NumT>((initial_wavevector_err2)
-                                + (c2 * final_wavevector_err2)
-                                + (kf2 * d2 * polar_err2));
+  // 3.32
+  template <typename NumT>
+  std::string
+  init_scatt_wavevector_to_Q(const Nessi::ExecutionPolicy & policy,
+                             const NumT initial_wavevector,
+                             const NumT initial_wavevector_err2,
+                             const Nessi::SpectrumBlock<NumT> &
+                             final_wavevector,
+                             const InstrumentGeometryCache<NumT> & geometry,
+                             Nessi::SpectrumBlock<NumT> & Qx,
+                             Nessi::SpectrumBlock<NumT> & Qy,
+                             Nessi::SpectrumBlock<NumT> & Qz,
+                             void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!final_wavevector.same_shape(Qx) || !final_wavevector.same_shape(Qy)
+        || !final_wavevector.same_shape(Qz))
+      {
+        throw std::invalid_argument(iswtq_func_str+" (s,b): blocks not the "
+                                    +"same shape");
+      }
 
-    
+    // check that the cache describes the pixels
+    std::size_t num_pixels = final_wavevector.num_spectra();
+    if (geometry.num_pixels() != num_pixels)
+      {
+        throw std::invalid_argument(iswtq_func_str+" (s,b): geometry not "
+                                    +"the number of spectra");
+      }
 
-   
+    // every chunk collects its own warnings
+    std::vector<Nessi::DefaultWarningSink>
+      warnings(Nessi::num_chunks(policy, num_pixels));
+    Nessi::for_each_chunk(policy, num_pixels,
+                          __InitScattWavevectorToQBlock<NumT>(
+                                                     initial_wavevector,
+                                                     initial_wavevector_err2,
+                                                     final_wavevector,
+                                                     geometry, Qx, Qy, Qz,
+                                                     warnings));
+
+    for (std::size_t c = 1; c < warnings.size(); ++c)
+      {
+        warnings[0].merge(warnings[c]);
+      }
+    return warnings.empty() ? Nessi::EMPTY_WARN : warnings[0].str();
+  }
 
-    return Nessi::EMPTY_WARN;
+  // 3.32
+  template <typename NumT>
+  std::string
+  init_scatt_wavevector_to_Q(const NumT initial_wavevector,
+                             const NumT initial_wavevector_err2,
+                             const Nessi::SpectrumBlock<NumT> &
+                             final_wavevector,
+                             const InstrumentGeometryCache<NumT> & geometry,
+                             Nessi::SpectrumBlock<NumT> & Qx,
+                             Nessi::SpectrumBlock<NumT> & Qy,
+                             Nessi::SpectrumBlock<NumT> & Qz,
+                             void *temp=NULL)
+  {
+    return init_scatt_wavevector_to_Q(Nessi::execution::seq,
+                                      initial_wavevector,
+                                      initial_wavevector_err2,
+                                      final_wavevector, geometry, Qx, Qy,
+                                      Qz, temp);
   }
+
 } // AxisManip
 
 #endif // _INIT_SCATT_WAVEVECTOR_TO_Q_HPP
@@ -32,7 +32,9 @@
 
 #include "conversions.hpp"
 #include "nessi_warn.hpp"
+#include "nessi_workspace.hpp"
 #include "size_checks.hpp"
+#include "vector_math.hpp"
 #include <cmath>
 #include <stdexcept>
 
@@ -99,8 +101,18 @@ namespace AxisManip
     retstr += __init_scatt_wavevector_to_scalar_Q_static(polar_angle, a, b,
                                                          sang);
 
-    // do the calculation
+    // do the calculation, the square roots are taken in one pass before
+    // the uncertainties so that Q may be one of the input arrays
     size_t size_wavevector=initial_wavevector.size();
+    Nessi::Scratch<NumT> root(temp, size_wavevector);
+    for (size_t i = 0 ; i < size_wavevector ; ++i)
+      {
+        root[i] =
+          __init_scatt_wavevector_to_scalar_Q_square(initial_wavevector[i],
+                                                     final_wavevector[i], a);
+      }
+    Utils::__vec_sqrt(root.data(), root.data(), size_wavevector);
+
     for (size_t i = 0 ; i < size_wavevector ; ++i)
       {
         retstr +=
@@ -109,8 +121,9 @@ namespace AxisManip
                                                       initial_wavevector_err2[i],
                                                       final_wavevector[i],
                                                       final_wavevector_err2[i],
-                                                      polar_angle_err2, a, b,
-                                                      sang, Q[i], Q_err2[i]);
+                                                      polar_angle_err2, b,
+                                                      sang, root[i],
+                                                      Q[i], Q_err2[i]);
       }
 
     return retstr;
@@ -172,8 +185,18 @@ namespace AxisManip
     retstr += __init_scatt_wavevector_to_scalar_Q_static(polar_angle, a, b,
                                                          sang);
 
-    // do the calculation
+    // do the calculation, the square roots are taken in one pass before
+    // the uncertainties so that Q may be one of the input arrays
     size_t size_wavevector=final_wavevector.size();
+    Nessi::Scratch<NumT> root(temp, size_wavevector);
+    for (size_t i = 0 ; i < size_wavevector ; ++i)
+      {
+        root[i] =
+          __init_scatt_wavevector_to_scalar_Q_square(initial_wavevector,
+                                                     final_wavevector[i], a);
+      }
+    Utils::__vec_sqrt(root.data(), root.data(), size_wavevector);
+
     for (size_t i = 0 ; i < size_wavevector ; ++i)
       {
         retstr +=
@@ -182,8 +205,9 @@ namespace AxisManip
                                                       initial_wavevector_err2,
                                                       final_wavevector[i],
                                                       final_wavevector_err2[i],
-                                                      polar_angle_err2, a, b,
-                                                      sang, Q[i], Q_err2[i]);
+                                                      polar_angle_err2, b,
+                                                      sang, root[i],
+                                                      Q[i], Q_err2[i]);
       }
 
     return retstr;
@@ -244,8 +268,18 @@ namespace AxisManip
     // fill the local variables
     retstr += __init_scatt_wavevector_to_scalar_Q_static(polar_angle, a, b,
                                                          c);
-    // do the calculation
+    // do the calculation, the square roots are taken in one pass before
+    // the uncertainties so that Q may be one of the input arrays
     size_t size_wavevector=initial_wavevector.size();
+    Nessi::Scratch<NumT> root(temp, size_wavevector);
+    for (size_t i = 0 ; i < size_wavevector ; ++i)
+      {
+        root[i] =
+          __init_scatt_wavevector_to_scalar_Q_square(initial_wavevector[i],
+                                                     final_wavevector, a);
+      }
+    Utils::__vec_sqrt(root.data(), root.data(), size_wavevector);
+
     for (size_t i = 0 ; i < size_wavevector ; ++i)
       {
         retstr +=
@@ -254,8 +288,9 @@ namespace AxisManip
                                                       initial_wavevector_err2[i],
                                                       final_wavevector,
                                                       final_wavevector_err2,
-                                                      polar_angle_err2, a, b,
-                                                      c, Q[i], Q_err2[i]);
+                                                      polar_angle_err2, b,
+                                                      c, root[i],
+                                                      Q[i], Q_err2[i]);
       }
 
     return retstr;
@@ -286,13 +321,18 @@ namespace AxisManip
     retstr += __init_scatt_wavevector_to_scalar_Q_static(polar_angle, a, b,
                                                          c);
     // do the calculation
+    NumT root =
+      __init_scatt_wavevector_to_scalar_Q_square(initial_wavevector,
+                                                 final_wavevector, a);
+    Utils::__vec_sqrt(&root, &root, 1);
+
     retstr +=
       __init_scatt_wavevector_to_scalar_Q_dynamic(initial_wavevector,
                                                   initial_wavevector_err2,
                                                   final_wavevector,
                                                   final_wavevector_err2,
-                                                  polar_angle_err2, a, b,
-                                                  c, Q, Q_err2);
+                                                  polar_angle_err2, b, c,
+                                                  root, Q, Q_err2);
 
     return retstr;
   }
@@ -328,8 +368,38 @@ namespace AxisManip
    * \ingroup init_scatt_wavevector_to_scalar_Q
    *
    * This is a PRIVATE helper function for
-   * init_scatt_wavevector_to_scalar_Q that calculates the scalar
-   * momentum transfer and its uncertainty
+   * init_scatt_wavevector_to_scalar_Q that calculates the square of the
+   * scalar momentum transfer. The square roots are taken by the caller
+   * for the whole array with Utils::__vec_sqrt().
+   *
+   * \param initial_wavevector (INPUT) same as parameter in
+   * init_scatt_wavevector_to_scalar_Q()
+   * \param final_wavevector (INPUT) same as parameter in
+   * init_scatt_wavevector_to_scalar_Q()
+   * \param a (INPUT) same as a parameter of
+   * __init_scatt_wavevector_to_scalar_Q_static()
+   *
+   * \return \f$k_i^2+k_f^2-a k_i k_f\f$
+   */
+  template <typename NumT>
+  NumT
+  __init_scatt_wavevector_to_scalar_Q_square(const NumT initial_wavevector,
+                                             const NumT final_wavevector,
+                                             const NumT a)
+  {
+    NumT ki2 = initial_wavevector * initial_wavevector;
+    NumT kf2 = final_wavevector * final_wavevector;
+    NumT akikf = a * initial_wavevector * final_wavevector;
+
+    return ki2 + kf2 - akikf;
+  }
+
+  /**
+   * \ingroup init_scatt_wavevector_to_scalar_Q
+   *
+   * This is a PRIVATE helper function for
+   * init_scatt_wavevector_to_scalar_Q that stores the scalar momentum
+   * transfer and calculates its uncertainty
    *
    * \param initial_wavevector (INPUT) same as parameter in
    * init_scatt_wavevector_to_scalar_Q()
@@ -341,12 +411,12 @@ namespace AxisManip
    * init_scatt_wavevector_to_scalar_Q()
    * \param polar_angle_err2 (INPUT) same as parameter in
    * init_scatt_wavevector_to_scalar_Q()
-   * \param a (INPUT) same as a parameter of
-   * __init_scatt_wavevector_to_scalar_Q_static()
    * \param b (INPUT) same as b parameter of
    * __init_scatt_wavevector_to_scalar_Q_static()
    * \param c (INPUT) same as c parameter of
    * __init_scatt_wavevector_to_scalar_Q_static()
+   * \param root (INPUT) is the square root of the value returned by
+   * __init_scatt_wavevector_to_scalar_Q_square()
    * \param Q (OUTPUT) same as parameter in
    * init_scatt_wavevector_to_scalar_Q()
    * \param Q_err2 (OUTPUT) same as parameter in
@@ -360,19 +430,12 @@ namespace AxisManip
                                             const NumT final_wavevector,
                                             const NumT final_wavevector_err2,
                                             const NumT polar_angle_err2,
-                                            const NumT a,
                                             const NumT b,
                                             const NumT c,
+                                            const NumT root,
                                             NumT & Q,
                                             NumT & Q_err2)
   {
-    NumT ki2 = initial_wavevector * initial_wavevector;
-    NumT kf2 = final_wavevector * final_wavevector;
-    NumT akikf = a * initial_wavevector * final_wavevector;
-
-    Q = static_cast<NumT>
-      (std::sqrt(static_cast<double>(ki2 + kf2 - akikf)));
-
     NumT termi2 = initial_wavevector - (final_wavevector * b);
     termi2 = termi2 * termi2;
     NumT termf2 = final_wavevector - (initial_wavevector * b);
@@ -382,13 +445,15 @@ namespace AxisManip
     e2 = e2 * c;
     e2 = e2 * e2;
 
-    NumT front = static_cast<NumT>(1.) / (Q * Q);
+    NumT front = static_cast<NumT>(1.) / (root * root);
 
     Q_err2 = final_wavevector_err2 * termf2;
     Q_err2 += initial_wavevector_err2 * termi2;
     Q_err2 += (polar_angle_err2 * e2);
     Q_err2 *= front;
 
+    Q = root;
+
     return Nessi::EMPTY_WARN;
   }
 } // AxisManip
@@ -0,0 +1,357 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file axis_manip/src/instrument_geometry_cache.hpp
+ */
+#ifndef _INSTRUMENT_GEOMETRY_CACHE_HPP
+#define _INSTRUMENT_GEOMETRY_CACHE_HPP 1
+
+#include "conversions.hpp"
+#include "init_scatt_wavevector_to_Q.hpp"
+#include "nessi_warn.hpp"
+#include "nessi_workspace.hpp"
+#include "size_checks.hpp"
+#include "tof_to_scalar_Q.hpp"
+#include "tof_to_wavelength.hpp"
+#include "wavelength_to_scalar_Q.hpp"
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+namespace AxisManip
+{
+  /// String for holding the InstrumentGeometryCache class name
+  const std::string igc_func_str = "AxisManip::InstrumentGeometryCache";
+
+  /**
+   * \ingroup instrument_geometry_cache
+   *
+   * Tag at the start of a file written by InstrumentGeometryCache::save().
+   * It reads differently on a machine of the other byte order.
+   */
+  const unsigned int __IGC_MAGIC = 0x4E494743;
+
+  /**
+   * \ingroup instrument_geometry_cache
+   *
+   * Version of the file format of InstrumentGeometryCache::save()
+   */
+  const unsigned int __IGC_VERSION = 1;
+
+  /**
+   * \ingroup instrument_geometry_cache
+   *
+   * Number of unsigned integers before the numbers of a file written by
+   * InstrumentGeometryCache::save(): the tag, the version, the size of
+   * the floating point type, the number of arrays and the two halves of
+   * the number of pixels.
+   */
+  const std::size_t __IGC_HEADER_SIZE = 6;
+
+  template <typename NumT>
+  InstrumentGeometryCache<NumT>::InstrumentGeometryCache()
+    : num_pixels_(0), ttsq_a2_(0), wtsq_4Pi_(0)
+  { }
+
+  template <typename NumT>
+  InstrumentGeometryCache<NumT>::InstrumentGeometryCache(
+                                  const Nessi::Vector<NumT> & pathlength,
+                                  const Nessi::Vector<NumT> & pathlength_err2,
+                                  const Nessi::Vector<NumT> & polar,
+                                  const Nessi::Vector<NumT> & polar_err2,
+                                  const Nessi::Vector<NumT> & azimuthal,
+                                  const Nessi::Vector<NumT> & azimuthal_err2,
+                                  void *temp)
+    : num_pixels_(pathlength.size()), ttsq_a2_(0), wtsq_4Pi_(0)
+  {
+    // check that the geometry of every pixel is complete
+    try
+      {
+        Utils::check_sizes_square(pathlength, pathlength_err2);
+      }
+    catch (std::invalid_argument &e)
+      {
+        throw std::invalid_argument(igc_func_str+": pathlength and "
+                                    +"pathlength_err2 "+e.what());
+      }
+
+    try
+      {
+        Utils::check_sizes_square(pathlength, polar);
+      }
+    catch (std::invalid_argument &e)
+      {
+        throw std::invalid_argument(igc_func_str+": pathlength and polar "
+                                    +e.what());
+      }
+
+    try
+      {
+        Utils::check_sizes_square(polar, polar_err2);
+      }
+    catch (std::invalid_argument &e)
+      {
+        throw std::invalid_argument(igc_func_str+": polar and polar_err2 "
+                                    +e.what());
+      }
+
+    try
+      {
+        Utils::check_sizes_square(polar, azimuthal);
+      }
+    catch (std::invalid_argument &e)
+      {
+        throw std::invalid_argument(igc_func_str+": polar and azimuthal "
+                                    +e.what());
+      }
+
+    try
+      {
+        Utils::check_sizes_square(azimuthal, azimuthal_err2);
+      }
+    catch (std::invalid_argument &e)
+      {
+        throw std::invalid_argument(igc_func_str+": azimuthal and "
+                                    +"azimuthal_err2 "+e.what());
+      }
+
+    columns_.assign(NUM_COLUMNS * num_pixels_, static_cast<NumT>(0));
+    if (num_pixels_ == 0)
+      {
+        return;
+      }
+
+    // A constructor cannot return the warnings of the helpers, but none of
+    // the prologues reports any.
+    Nessi::NoWarnings warnings;
+
+    Nessi::VectorView<const NumT> pathlength_view(pathlength);
+    Nessi::VectorView<const NumT> pathlength_err2_view(pathlength_err2);
+    Nessi::VectorView<const NumT> polar_view(polar);
+    Nessi::VectorView<const NumT> polar_err2_view(polar_err2);
+
+    __tof_to_wavelength_prologue(pathlength_view, pathlength_err2_view,
+                                 this->column(TTW_A), this->column(TTW_A2),
+                                 this->column(TTW_A_ERR2), warnings);
+
+    // the sine and cosine of the half angles are shared by two prologues
+    Nessi::Scratch<double> work(temp, 2 * num_pixels_);
+    __tof_to_scalar_Q_prologue(pathlength_view, pathlength_err2_view,
+                               polar_view, polar_err2_view, ttsq_a2_,
+                               this->column(TTSQ_B),
+                               this->column(TTSQ_TERM1),
+                               this->column(TTSQ_TERM2), work.data(),
+                               warnings);
+    __wavelength_to_scalar_Q_prologue(polar_view, polar_err2_view,
+                                      wtsq_4Pi_, this->column(WTSQ_SIN),
+                                      this->column(WTSQ_SIN2),
+                                      this->column(WTSQ_TERM), work.data(),
+                                      warnings);
+
+    NumT * azimuthal_column = this->column(AZIMUTHAL);
+    NumT * azimuthal_err2_column = this->column(AZIMUTHAL_ERR2);
+    NumT * polar_column = this->column(POLAR);
+    NumT * polar_err2_column = this->column(POLAR_ERR2);
+    NumT * a = this->column(ISWTQ_A);
+    NumT * a2 = this->column(ISWTQ_A2);
+    NumT * b = this->column(ISWTQ_B);
+    NumT * b2 = this->column(ISWTQ_B2);
+    NumT * c = this->column(ISWTQ_C);
+    NumT * c2 = this->column(ISWTQ_C2);
+    NumT * d = this->column(ISWTQ_D);
+    NumT * d2 = this->column(ISWTQ_D2);
+    for (std::size_t p = 0; p < num_pixels_; ++p)
+      {
+        azimuthal_column[p] = azimuthal[p];
+        azimuthal_err2_column[p] = azimuthal_err2[p];
+        polar_column[p] = polar[p];
+        polar_err2_column[p] = polar_err2[p];
+        __init_scatt_wavevector_to_Q_static(azimuthal[p], polar[p],
+                                            a[p], a2[p], b[p], b2[p],
+                                            c[p], c2[p], d[p], d2[p]);
+      }
+  }
+
+  template <typename NumT>
+  std::size_t
+  InstrumentGeometryCache<NumT>::num_pixels() const
+  {
+    return num_pixels_;
+  }
+
+  template <typename NumT>
+  NumT *
+  InstrumentGeometryCache<NumT>::column(const Column column)
+  {
+    if (num_pixels_ == 0)
+      {
+        return 0;
+      }
+    return &columns_[0] + column * num_pixels_;
+  }
+
+  template <typename NumT>
+  const NumT *
+  InstrumentGeometryCache<NumT>::column(const Column column) const
+  {
+    if (num_pixels_ == 0)
+      {
+        return 0;
+      }
+    return &columns_[0] + column * num_pixels_;
+  }
+
+  template <typename NumT>
+  void
+  InstrumentGeometryCache<NumT>::save(const std::string & filename) const
+  {
+    std::ofstream file(filename.c_str(),
+                       std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file)
+      {
+        throw std::runtime_error(igc_func_str+": cannot open "+filename
+                                 +" for writing");
+      }
+
+    // The number of pixels is split so the header does not depend on the
+    // size of std::size_t. The shift is done twice since shifting a 32 bit
+    // std::size_t by 32 is undefined.
+    unsigned int header[__IGC_HEADER_SIZE] =
+      {
+        __IGC_MAGIC,
+        __IGC_VERSION,
+        static_cast<unsigned int>(sizeof(NumT)),
+        static_cast<unsigned int>(NUM_COLUMNS),
+        static_cast<unsigned int>(num_pixels_ & 0xFFFFFFFFUL),
+        static_cast<unsigned int>((num_pixels_ >> 16) >> 16)
+      };
+    NumT constants[2] = { ttsq_a2_, wtsq_4Pi_ };
+
+    file.write(reinterpret_cast<const char *>(header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(constants), sizeof(constants));
+    if (!columns_.empty())
+      {
+        file.write(reinterpret_cast<const char *>(&columns_[0]),
+                   columns_.size() * sizeof(NumT));
+      }
+    file.close();
+    if (!file)
+      {
+        throw std::runtime_error(igc_func_str+": cannot write "
+                                 +filename);
+      }
+  }
+
+  template <typename NumT>
+  void
+  InstrumentGeometryCache<NumT>::load(const std::string & filename)
+  {
+    std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!file)
+      {
+        throw std::runtime_error(igc_func_str+": cannot open "+filename
+                                 +" for reading");
+      }
+
+    unsigned int header[__IGC_HEADER_SIZE];
+    if (!file.read(reinterpret_cast<char *>(header), sizeof(header)))
+      {
+        throw std::invalid_argument(igc_func_str+": "+filename
+                                    +" is truncated");
+      }
+    if (header[0] != __IGC_MAGIC)
+      {
+        throw std::invalid_argument(igc_func_str+": "+filename+" is not "
+                                    +"a geometry cache of this byte order");
+      }
+    if (header[1] != __IGC_VERSION)
+      {
+        throw std::invalid_argument(igc_func_str+": "+filename+" has an "
+                                    +"unknown version");
+      }
+    if (header[2] != sizeof(NumT) || header[3] != NUM_COLUMNS)
+      {
+        throw std::invalid_argument(igc_func_str+": "+filename+" does not "
+                                    +"hold a cache of this type");
+      }
+
+    std::size_t num_pixels = ((static_cast<std::size_t>(header[5]) << 16)
+                              << 16) | header[4];
+    // the size of the cache in bytes is computed below, it must not
+    // overflow std::size_t nor the signed std::streamoff
+    std::size_t max_pixels =
+      (std::numeric_limits<std::size_t>::max() / 2 / sizeof(NumT) - 2)
+      / NUM_COLUMNS;
+    if (((num_pixels >> 16) >> 16) != header[5] || num_pixels > max_pixels)
+      {
+        throw std::invalid_argument(igc_func_str+": "+filename+" holds "
+                                    +"too many pixels");
+      }
+
+    // compare the size of the file with the header before allocating, a
+    // damaged header must not request a huge array
+    std::streampos start = file.tellg();
+    file.seekg(0, std::ios::end);
+    std::streamoff remaining = file.tellg() - start;
+    file.seekg(start);
+    std::streamoff expected = static_cast<std::streamoff>(
+                          (2 + NUM_COLUMNS * num_pixels) * sizeof(NumT));
+    if (remaining < expected)
+      {
+        throw std::invalid_argument(igc_func_str+": "+filename
+                                    +" is truncated");
+      }
+    if (remaining > expected)
+      {
+        throw std::invalid_argument(igc_func_str+": "+filename+" is longer "
+                                    +"than the cache it holds");
+      }
+
+    // read into new storage so a bad file leaves the cache alone
+    NumT constants[2];
+    Nessi::Vector<NumT> columns(NUM_COLUMNS * num_pixels,
+                                Nessi::uninitialized);
+    file.read(reinterpret_cast<char *>(constants), sizeof(constants));
+    if (file && !columns.empty())
+      {
+        file.read(reinterpret_cast<char *>(&columns[0]),
+                  columns.size() * sizeof(NumT));
+      }
+    if (!file)
+      {
+        throw std::runtime_error(igc_func_str+": cannot read "
+                                 +filename);
+      }
+
+    num_pixels_ = num_pixels;
+    ttsq_a2_ = constants[0];
+    wtsq_4Pi_ = constants[1];
+    columns_.swap(columns);
+  }
+} // AxisManip
+
+#endif // _INSTRUMENT_GEOMETRY_CACHE_HPP
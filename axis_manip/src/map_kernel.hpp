@@ -0,0 +1,399 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+
+/**
+ * $Id$
+ *
+ * \file axis_manip/src/map_kernel.hpp
+ */
+#ifndef _MAP_KERNEL_HPP
+#define _MAP_KERNEL_HPP 1
+
+#include "nessi.hpp"
+#include "nessi_block.hpp"
+#include "nessi_exec.hpp"
+#include "nessi_view.hpp"
+#include "nessi_warn.hpp"
+#include <cmath>
+#include <vector>
+
+namespace AxisManip
+{
+  /**
+   * \defgroup map_kernel AxisManip map kernels
+   * \{
+   *
+   * Most conversions are written as a static helper, which calculates the
+   * constants of a pixel from its geometry, and a dynamic helper, which
+   * converts one bin with those constants. A map kernel binds such a pair
+   * so that the PRIVATE drivers below can apply it to vectors, views and
+   * blocks of spectra. The element loops, the execution policy and the
+   * collection of the warnings are then written once instead of once per
+   * conversion.
+   *
+   * A kernel is a copyable class providing
+   * - <tt>value_type</tt>, the type of the elements;
+   * - <tt>bool is_uniform() const</tt>, true when every pixel uses the
+   *   same constants;
+   * - <tt>std::string setup(const std::size_t p)</tt>, which calls the
+   *   static helper for pixel \f$p\f$ and keeps its results;
+   * - <tt>template <typename SinkT> void operator()(x, x_err2, y, y_err2,
+   *   SinkT & warnings) const</tt>, which calls the dynamic helper for one
+   *   bin.
+   *
+   * The dynamic helpers report into a sink (see Nessi::WarningSink)
+   * instead of returning a string, so the element loops contain nothing
+   * but the arithmetic and are vectorized by the compiler. The chunks of
+   * a parallel call each work on their own copy of the kernel.
+   *
+   * The block versions taking the geometry of every pixel calculate the
+   * constants of all pixels in a prologue before the conversion. The
+   * prologue fills one array per constant, so each of its loops runs
+   * over the whole instrument, and the kernel only reads the constants
+   * of pixel \f$p\f$ in its <tt>setup()</tt>. The versions converting a
+   * single pixel run the same prologue on one element, so both give the
+   * same results.
+   *
+   * Conversions that are usually applied one after the other, like the
+   * steps from time-of-flight to energy transfer, are fused with
+   * __compose() into a single kernel. The chain then needs no
+   * intermediate arrays.
+   */
+
+  /**
+   * This is a PRIVATE prologue calculating \f$\sin(polar/2)\f$ and
+   * \f$\cos(polar/2)\f$ for every element of \p polar. The functions are
+   * evaluated in double precision by the standard library, like the
+   * static helpers always did, whatever the type of the angles. They run
+   * once per pixel, so the vector math functions, which are not correctly
+   * rounded, would save little and change the last bit of the results.
+   *
+   * \param polar (INPUT) is the polar angles in radians
+   * \param sin_half (OUTPUT) is the first of the sines
+   * \param cos_half (OUTPUT) is the first of the cosines
+   */
+  template <typename NumT>
+  void
+  __half_angle_sin_cos(const Nessi::VectorView<const NumT> & polar,
+                       double * sin_half,
+                       double * cos_half)
+  {
+    std::size_t size = polar.size();
+    for (std::size_t p = 0; p < size; ++p)
+      {
+        double half = polar[p] / 2.0;
+        sin_half[p] = std::sin(half);
+        cos_half[p] = std::cos(half);
+      }
+  }
+
+  /**
+   * This is a PRIVATE helper applying \p kernel to \p size elements. The
+   * arrays may be pointers, iterators or Nessi::VectorView objects, and
+   * the output may be the input.
+   */
+  template <typename KernelT, typename InT, typename OutT, typename SinkT>
+  inline void
+  __map_kernel_loop(const KernelT & kernel,
+                    InT input,
+                    InT input_err2,
+                    OutT output,
+                    OutT output_err2,
+                    const std::size_t size,
+                    SinkT & warnings)
+  {
+    for (std::size_t i = 0; i < size; ++i)
+      {
+        kernel(input[i], input_err2[i], output[i], output_err2[i],
+               warnings);
+      }
+  }
+
+  /**
+   * This is a PRIVATE driver applying \p kernel, set up for pixel zero,
+   * to one array. The sizes must have been checked.
+   *
+   * \param kernel (INPUT) is the kernel of the conversion
+   * \param input (INPUT) is the first element of the input
+   * \param input_err2 (INPUT) is the first element of the square of the
+   * uncertainty in the input
+   * \param output (OUTPUT) is the first element of the output
+   * \param output_err2 (OUTPUT) is the first element of the square of the
+   * uncertainty in the output
+   * \param size (INPUT) is the number of elements
+   *
+   * \return The warnings of the conversion
+   */
+  template <typename KernelT, typename InT, typename OutT>
+  std::string
+  __map_kernel(KernelT kernel,
+               InT input,
+               InT input_err2,
+               OutT output,
+               OutT output_err2,
+               const std::size_t size)
+  {
+    Nessi::DefaultWarningSink warnings;
+
+    warnings.report(kernel.setup(0));
+    __map_kernel_loop(kernel, input, input_err2, output, output_err2, size,
+                      warnings);
+
+    return warnings.str();
+  }
+
+  /**
+   * This is a PRIVATE overload of __map_kernel() for views. When every
+   * view has unit stride the arrays are passed on as pointers, so the
+   * overloads of __map_kernel_loop() for pointers apply. Otherwise the
+   * elements are addressed through the views.
+   */
+  template <typename KernelT, typename NumT>
+  std::string
+  __map_kernel(KernelT kernel,
+               Nessi::VectorView<const NumT> input,
+               Nessi::VectorView<const NumT> input_err2,
+               Nessi::VectorView<NumT> output,
+               Nessi::VectorView<NumT> output_err2,
+               const std::size_t size)
+  {
+    if (input.is_contiguous() && input_err2.is_contiguous()
+        && output.is_contiguous() && output_err2.is_contiguous())
+      {
+        return __map_kernel(kernel, input.data(), input_err2.data(),
+                            output.data(), output_err2.data(), size);
+      }
+
+    Nessi::DefaultWarningSink warnings;
+
+    warnings.report(kernel.setup(0));
+    __map_kernel_loop(kernel, input, input_err2, output, output_err2, size,
+                      warnings);
+
+    return warnings.str();
+  }
+
+  /**
+   * This is a PRIVATE function object converting a range of items of a
+   * block for __map_kernel(). The items are the elements of the whole
+   * block when \p flat is true and the spectra otherwise. A uniform kernel
+   * must already be set up, a kernel that is not is set up for every
+   * pixel.
+   */
+  template <typename KernelT>
+  class __MapKernelBlock
+  {
+  public:
+    /// Type of the elements
+    typedef typename KernelT::value_type NumT;
+
+    /// Constructor keeping the arguments of __map_kernel()
+    __MapKernelBlock(const KernelT & kernel,
+                     const Nessi::SpectrumBlock<NumT> & input,
+                     Nessi::SpectrumBlock<NumT> & output,
+                     const bool flat,
+                     std::vector<Nessi::DefaultWarningSink> & warnings)
+      : kernel_(kernel), input_(input), output_(output), flat_(flat),
+        warnings_(warnings)
+    { }
+
+    /// Converts the items [begin, end) into the sink of \p chunk
+    void operator()(const std::size_t chunk, const std::size_t begin,
+                    const std::size_t end) const
+    {
+      Nessi::DefaultWarningSink & warnings = warnings_[chunk];
+      KernelT kernel(kernel_);
+
+      if (flat_)
+        {
+          __map_kernel_loop(kernel, input_.value(0) + begin,
+                            input_.err2(0) + begin,
+                            output_.value(0) + begin,
+                            output_.err2(0) + begin, end - begin,
+                            warnings);
+          return;
+        }
+
+      for (std::size_t p = begin; p < end; ++p)
+        {
+          // fill the constants of the pixel
+          if (!kernel.is_uniform())
+            {
+              warnings.report(kernel.setup(p));
+            }
+          __map_kernel_loop(kernel, input_.value(p), input_.err2(p),
+                            output_.value(p), output_.err2(p),
+                            input_.num_bins(), warnings);
+        }
+    }
+
+  private:
+    /// The kernel of the conversion
+    const KernelT & kernel_;
+    /// The input spectra
+    const Nessi::SpectrumBlock<NumT> & input_;
+    /// The output spectra
+    Nessi::SpectrumBlock<NumT> & output_;
+    /// True if the items are the elements of the whole block
+    bool flat_;
+    /// The warnings of every chunk
+    std::vector<Nessi::DefaultWarningSink> & warnings_;
+  };
+
+  /**
+   * This is a PRIVATE driver applying \p kernel to every spectrum of a
+   * block, set up for the pixel of each spectrum. The shapes of the blocks
+   * must have been checked. A uniform kernel is set up once before the
+   * chunks, as the single array drivers do, and on two blocks without
+   * padding it converts the block as a single array.
+   *
+   * \param policy (INPUT) is the execution policy
+   * \param kernel (INPUT) is the kernel of the conversion
+   * \param input (INPUT) is the block to convert
+   * \param output (OUTPUT) is the converted block, it may be the input
+   *
+   * \return The warnings of the conversion, in the order of the spectra
+   */
+  template <typename KernelT>
+  std::string
+  __map_kernel(const Nessi::ExecutionPolicy & policy,
+               const KernelT & kernel,
+               const Nessi::SpectrumBlock<typename KernelT::value_type> &
+               input,
+               Nessi::SpectrumBlock<typename KernelT::value_type> & output)
+  {
+    std::size_t num_bins = input.num_bins();
+    if (num_bins == 0)
+      {
+        return Nessi::EMPTY_WARN;
+      }
+
+    // the chunks share the set up copy of a uniform kernel, so the
+    // warnings of its setup are reported once
+    Nessi::DefaultWarningSink setup_warnings;
+    KernelT shared(kernel);
+    if (shared.is_uniform())
+      {
+        setup_warnings.report(shared.setup(0));
+      }
+
+    bool flat = shared.is_uniform() && input.is_contiguous()
+      && output.is_contiguous();
+    std::size_t size = input.num_spectra();
+    if (flat)
+      {
+        size *= num_bins;
+      }
+
+    // every chunk collects its own warnings
+    std::vector<Nessi::DefaultWarningSink>
+      warnings(Nessi::num_chunks(policy, size));
+    Nessi::for_each_chunk(policy, size,
+                          __MapKernelBlock<KernelT>(shared, input, output,
+                                                    flat, warnings));
+
+    for (std::size_t c = 0; c < warnings.size(); ++c)
+      {
+        setup_warnings.merge(warnings[c]);
+      }
+    return setup_warnings.str();
+  }
+
+  /**
+   * This is a PRIVATE map kernel applying \p FirstT and then \p SecondT
+   * to every bin, so that a chain of conversions runs as one. The result
+   * of the first kernel stays in a local variable and is converted by the
+   * second one with the same operations as if it had been read back from
+   * an intermediate array, so the results are identical to those of the
+   * conversions called one after the other. The uncertainty is carried
+   * through both steps, which is the propagation through the derivative
+   * of the composition. Kernels of longer chains are composed again.
+   *
+   * The composition is uniform when both kernels are, and setting it up
+   * for a pixel sets up both kernels.
+   */
+  template <typename FirstT, typename SecondT>
+  class __ComposedKernel
+  {
+  public:
+    /// Type of the elements
+    typedef typename FirstT::value_type value_type;
+
+    /// Constructor keeping the kernels in the order they are applied
+    __ComposedKernel(const FirstT & first, const SecondT & second)
+      : first_(first), second_(second)
+    { }
+
+    /// Returns true if neither kernel depends on the pixel
+    bool is_uniform() const
+    {
+      return first_.is_uniform() && second_.is_uniform();
+    }
+
+    /// Sets up both kernels for pixel \p p
+    std::string setup(const std::size_t p)
+    {
+      std::string warn = first_.setup(p);
+      warn += second_.setup(p);
+      return warn;
+    }
+
+    /// Converts one bin with both kernels
+    template <typename SinkT>
+    void operator()(const value_type input, const value_type input_err2,
+                    value_type & output, value_type & output_err2,
+                    SinkT & warnings) const
+    {
+      value_type middle;
+      value_type middle_err2;
+      first_(input, input_err2, middle, middle_err2, warnings);
+      second_(middle, middle_err2, output, output_err2, warnings);
+    }
+
+  private:
+    /// The kernel applied first
+    FirstT first_;
+    /// The kernel applied to the results of the first one
+    SecondT second_;
+  };
+
+  /**
+   * This is a PRIVATE helper returning the kernel applying \p first and
+   * then \p second, see __ComposedKernel.
+   */
+  template <typename FirstT, typename SecondT>
+  inline __ComposedKernel<FirstT, SecondT>
+  __compose(const FirstT & first, const SecondT & second)
+  {
+    return __ComposedKernel<FirstT, SecondT>(first, second);
+  }
+
+  /**
+   * \}
+   */ // end of map_kernel group
+
+} // AxisManip
+
+#endif // _MAP_KERNEL_HPP
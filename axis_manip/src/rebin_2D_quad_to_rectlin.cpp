@@ -93,4 +93,104 @@ namespace AxisManip
                                    Nessi::Vector<double> & frac_area,
                                    Nessi::Vector<double> & bin_count,
                                    void *temp);
+
+  /**
+   * This is the float declaration of the parallel version of the
+   * function defined in 3.61.
+   *
+   * \ingroup rebin_2D_quad_to_rectlin
+   */
+  template std::string
+  rebin_2D_quad_to_rectlin<float>(const Nessi::ExecutionPolicy & policy,
+                                  const Nessi::Vector<float> & axis_in_x1,
+                                  const Nessi::Vector<float> & axis_in_y1,
+                                  const Nessi::Vector<float> & axis_in_x2,
+                                  const Nessi::Vector<float> & axis_in_y2,
+                                  const Nessi::Vector<float> & axis_in_x3,
+                                  const Nessi::Vector<float> & axis_in_y3,
+                                  const Nessi::Vector<float> & axis_in_x4,
+                                  const Nessi::Vector<float> & axis_in_y4,
+                                  const Nessi::Vector<float> & input,
+                                  const Nessi::Vector<float> & input_err2,
+                                  const Nessi::Vector<float> & axis_out_1,
+                                  const Nessi::Vector<float> & axis_out_2,
+                                  Nessi::Vector<float> & output,
+                                  Nessi::Vector<float> & output_err2,
+                                  Nessi::Vector<float> & frac_area,
+                                  Nessi::Vector<float> & bin_count,
+                                  void *temp);
+
+  /**
+   * This is the double precision float declaration of the parallel
+   * version of the function defined in 3.61.
+   *
+   * \ingroup rebin_2D_quad_to_rectlin
+   */
+  template std::string
+  rebin_2D_quad_to_rectlin<double>(const Nessi::ExecutionPolicy & policy,
+                                   const Nessi::Vector<double> & axis_in_x1,
+                                   const Nessi::Vector<double> & axis_in_y1,
+                                   const Nessi::Vector<double> & axis_in_x2,
+                                   const Nessi::Vector<double> & axis_in_y2,
+                                   const Nessi::Vector<double> & axis_in_x3,
+                                   const Nessi::Vector<double> & axis_in_y3,
+                                   const Nessi::Vector<double> & axis_in_x4,
+                                   const Nessi::Vector<double> & axis_in_y4,
+                                   const Nessi::Vector<double> & input,
+                                   const Nessi::Vector<double> & input_err2,
+                                   const Nessi::Vector<double> & axis_out_1,
+                                   const Nessi::Vector<double> & axis_out_2,
+                                   Nessi::Vector<double> & output,
+                                   Nessi::Vector<double> & output_err2,
+                                   Nessi::Vector<double> & frac_area,
+                                   Nessi::Vector<double> & bin_count,
+                                   void *temp);
+
+  /**
+   * This is the float declaration of the validated step of the function
+   * defined in 3.61.
+   *
+   * \ingroup rebin_2D_quad_to_rectlin
+   */
+  template class Rebin2DQuadToRectlinStep<float>;
+
+  /**
+   * This is the double precision float declaration of the validated step
+   * of the function defined in 3.61.
+   *
+   * \ingroup rebin_2D_quad_to_rectlin
+   */
+  template class Rebin2DQuadToRectlinStep<double>;
+
+  /**
+   * This is the float declaration of the plan of the function defined in
+   * 3.61.
+   *
+   * \ingroup rebin_2D_quad_to_rectlin
+   */
+  template class Rebin2DQuadToRectlinPlan<float>;
+
+  /**
+   * This is the double precision float declaration of the plan of the
+   * function defined in 3.61.
+   *
+   * \ingroup rebin_2D_quad_to_rectlin
+   */
+  template class Rebin2DQuadToRectlinPlan<double>;
+
+  /**
+   * This is the float declaration of the tiling of the function defined
+   * in 3.61.
+   *
+   * \ingroup rebin_2D_quad_to_rectlin
+   */
+  template class Rebin2DQuadToRectlinTiling<float>;
+
+  /**
+   * This is the double precision float declaration of the tiling of the
+   * function defined in 3.61.
+   *
+   * \ingroup rebin_2D_quad_to_rectlin
+   */
+  template class Rebin2DQuadToRectlinTiling<double>;
 } // AxisManip
@@ -37,9 +37,12 @@
 #include "size_checks.hpp"
 #include "utils.hpp"
 #include <algorithm>
+#include <istream>
 #include <limits>
+#include <ostream>
 #include <sstream>
 #include <stdexcept>
+#include <vector>
 
 namespace AxisManip
 {
@@ -55,32 +58,317 @@ namespace AxisManip
   /// Minimum size of a polygon is 3 points
   static const std::size_t MIN_SIZE_POLY = 3;
 
-  // 3.61
+  /**
+   * \ingroup rebin_2D_quad_to_rectlin
+   *
+   * This is a PRIVATE accumulator for __rebin_2D_quad_to_rectlin() that
+   * adds every overlap to the rebinned histogram.
+   */
   template <typename NumT>
-  std::string
-  rebin_2D_quad_to_rectlin(const Nessi::Vector<NumT> & axis_in_x1,
-                           const Nessi::Vector<NumT> & axis_in_y1,
-                           const Nessi::Vector<NumT> & axis_in_x2,
-                           const Nessi::Vector<NumT> & axis_in_y2,
-                           const Nessi::Vector<NumT> & axis_in_x3,
-                           const Nessi::Vector<NumT> & axis_in_y3,
-                           const Nessi::Vector<NumT> & axis_in_x4,
-                           const Nessi::Vector<NumT> & axis_in_y4,
-                           const Nessi::Vector<NumT> & input,
+  class __QuadRebinAccumulator
+  {
+  public:
+    /// Constructor keeping the data and the rebinned arrays
+    __QuadRebinAccumulator(const Nessi::Vector<NumT> & input,
                            const Nessi::Vector<NumT> & input_err2,
-                           const Nessi::Vector<NumT> & axis_out_1,
-                           const Nessi::Vector<NumT> & axis_out_2,
-                           Nessi::Vector<NumT> & orig_bin_x,
-                           Nessi::Vector<NumT> & orig_bin_y,
-                           Nessi::Vector<NumT> & rebin_bin_x,
-                           Nessi::Vector<NumT> & rebin_bin_y,
-                           Nessi::Vector<NumT> & frac_bin_x,
-                           Nessi::Vector<NumT> & frac_bin_y,
                            Nessi::Vector<NumT> & output,
                            Nessi::Vector<NumT> & output_err2,
                            Nessi::Vector<NumT> & frac_area,
-                           Nessi::Vector<NumT> & bin_count,
-                           void *temp=NULL)
+                           Nessi::Vector<NumT> & bin_count)
+      : input_(input), input_err2_(input_err2), output_(output),
+        output_err2_(output_err2), frac_area_(frac_area),
+        bin_count_(bin_count)
+    { }
+
+    /// Adds the portion of quadrilateral \p k that falls in \p channel
+    void operator()(const std::size_t k, const std::size_t channel,
+                    const NumT portion)
+    {
+      output_[channel] += input_[k] * portion;
+      output_err2_[channel] += input_err2_[k] * portion * portion;
+      frac_area_[channel] += portion;
+      bin_count_[channel] = 1.0;
+    }
+
+  private:
+    /// The data of the quadrilaterals
+    const Nessi::Vector<NumT> & input_;
+    /// The square of the uncertainty of the data
+    const Nessi::Vector<NumT> & input_err2_;
+    /// The rebinned data
+    Nessi::Vector<NumT> & output_;
+    /// The square of the uncertainty of the rebinned data
+    Nessi::Vector<NumT> & output_err2_;
+    /// The accumulated fractional area
+    Nessi::Vector<NumT> & frac_area_;
+    /// The contribution of the data to the rebinned data
+    Nessi::Vector<NumT> & bin_count_;
+  };
+
+  /**
+   * \ingroup rebin_2D_quad_to_rectlin
+   *
+   * This is a PRIVATE exception thrown by __rebin_2D_quad_to_rectlin()
+   * that keeps the index of the quadrilateral that could not be clipped.
+   */
+  class __QuadClipError : public std::invalid_argument
+  {
+  public:
+    /// Constructor keeping the message and the quadrilateral
+    __QuadClipError(const std::string & what, const std::size_t quad)
+      : std::invalid_argument(what), quad_(quad)
+    { }
+
+    /// Returns the index of the quadrilateral
+    std::size_t quad() const
+    {
+      return quad_;
+    }
+
+  private:
+    /// Index of the quadrilateral
+    std::size_t quad_;
+  };
+
+  /**
+   * \ingroup rebin_2D_quad_to_rectlin
+   *
+   * This is a PRIVATE helper function for __rebin_2D_quad_to_rectlin and
+   * Rebin2DQuadToRectlinTiling that copies the corners of quadrilateral
+   * \p k into \p quad_x and \p quad_y and finds the grid bins covered by
+   * its bounding box. They are [range[0], range[1]] on the 1st target axis
+   * and [range[2], range[3]] on the 2nd one, both inclusive. The target
+   * axes are given by their descriptors, so the bins are computed in
+   * constant time on linear and logarithmic grids. The function returns
+   * false if the quadrilateral is outside the grid.
+   */
+  template <typename NumT>
+  bool
+  __quad_grid_range(const std::size_t k,
+                    const Nessi::Vector<NumT> & axis_in_x1,
+                    const Nessi::Vector<NumT> & axis_in_y1,
+                    const Nessi::Vector<NumT> & axis_in_x2,
+                    const Nessi::Vector<NumT> & axis_in_y2,
+                    const Nessi::Vector<NumT> & axis_in_x3,
+                    const Nessi::Vector<NumT> & axis_in_y3,
+                    const Nessi::Vector<NumT> & axis_in_x4,
+                    const Nessi::Vector<NumT> & axis_in_y4,
+                    const Utils::AxisDescriptor<NumT> & grid_1,
+                    const Utils::AxisDescriptor<NumT> & grid_2,
+                    NumT * quad_x,
+                    NumT * quad_y,
+                    std::size_t * range)
+  {
+    const Nessi::Vector<NumT> & axis_out_1 = grid_1.axis();
+    const Nessi::Vector<NumT> & axis_out_2 = grid_2.axis();
+    std::size_t length_axis_out[2];
+    length_axis_out[0] = axis_out_1.size() - 1;
+    length_axis_out[1] = axis_out_2.size() - 1;
+
+    // Get the bin boundaries in out of the original axes
+    quad_x[0] = axis_in_x1[k];
+    quad_x[1] = axis_in_x2[k];
+    quad_x[2] = axis_in_x3[k];
+    quad_x[3] = axis_in_x4[k];
+
+    quad_y[0] = axis_in_y1[k];
+    quad_y[1] = axis_in_y2[k];
+    quad_y[2] = axis_in_y3[k];
+    quad_y[3] = axis_in_y4[k];
+
+    // Find the minimum and maximum values for the x and y coordinates
+    NumT x_min = *std::min_element(quad_x, quad_x + SIZE_QUAD);
+    NumT x_max = *std::max_element(quad_x, quad_x + SIZE_QUAD);
+
+    NumT y_min = *std::min_element(quad_y, quad_y + SIZE_QUAD);
+    NumT y_max = *std::max_element(quad_y, quad_y + SIZE_QUAD);
+
+    // Check to see if the original bin boundaries are outside the 
+    // rebinned axes boundaries
+    bool check1 = (x_min < axis_out_1[0] && 
+                   x_max < axis_out_1[0]);
+    bool check2 = (x_min > axis_out_1[length_axis_out[0]] && 
+                   x_max > axis_out_1[length_axis_out[0]]);
+    bool check3 = (y_min < axis_out_2[0] && 
+                   y_max < axis_out_2[0]);
+    bool check4 = (y_min > axis_out_2[length_axis_out[1]] && 
+                   y_max > axis_out_2[length_axis_out[1]]);
+
+    if(check1 || check2 || check3 || check4)
+      {
+        return false;
+      }
+
+    // Determine the range of indices to rebin over
+    Utils::bisect_helper(grid_1, x_min, range[0]);
+    Utils::bisect_helper(grid_1, x_max, range[1]);
+    Utils::bisect_helper(grid_2, y_min, range[2]);
+    Utils::bisect_helper(grid_2, y_max, range[3]);
+
+    return (range[0] != std::numeric_limits<std::size_t>::max() &&
+            range[2] != std::numeric_limits<std::size_t>::max());
+  }
+
+  /**
+   * \ingroup rebin_2D_quad_to_rectlin
+   *
+   * This is a PRIVATE helper function for __rebin_2D_quad_to_rectlin and
+   * Rebin2DQuadToRectlinTiling that clips quadrilateral \p k, given by
+   * \p quad_x and \p quad_y, against the grid bins of \p range as found
+   * by __quad_grid_range(). Every overlap is passed to \p accum as
+   * accum(k, channel, portion), in the order of the grid bins.
+   */
+  template <typename NumT, typename AccumT>
+  void
+  __clip_quad_to_grid(const std::size_t k,
+                      const NumT * quad_x,
+                      const NumT * quad_y,
+                      const Nessi::Vector<NumT> & axis_out_1,
+                      const Nessi::Vector<NumT> & axis_out_2,
+                      const std::size_t * range,
+                      AccumT & accum)
+  {
+    std::size_t length_axis_out_2 = axis_out_2.size() - 1;
+
+    // The grid bins are axis-aligned rectangles, so the quadrilateral is
+    // clipped against their edges. All coordinates live on the stack.
+    NumT frac_bin_x[Utils::CLIP_QUAD_MAX_POINTS + 2];
+    NumT frac_bin_y[Utils::CLIP_QUAD_MAX_POINTS + 2];
+
+    for(std::size_t i = range[0]; i <= range[1]; ++i)
+      {
+        for(std::size_t j = range[2]; j <= range[3]; ++j)
+          {
+            std::size_t length_poly;
+            try
+              {
+                length_poly =
+                  Utils::__clip_quad_to_rectangle(quad_x, quad_y,
+                                                  axis_out_1[i],
+                                                  axis_out_1[i+1],
+                                                  axis_out_2[j],
+                                                  axis_out_2[j+1],
+                                                  frac_bin_x, frac_bin_y);
+              }
+            catch (std::exception &e)
+              {
+                std::ostringstream bad_index;
+                bad_index << "[" << k << "] ";
+
+                throw __QuadClipError(r2qtl_func_str + " index"
+                                      + bad_index.str() + ": "
+                                      + e.what(), k);
+              }
+
+            if (length_poly < MIN_SIZE_POLY)
+              {
+                // Overlap is not a polygon, so area can't be calculated
+                continue;
+              }
+
+            // The overlap already has its first two points repeated at the
+            // end for the area calculation
+            NumT portion = Utils::__calc_area_2D_polygon(frac_bin_x,
+                                                         frac_bin_y,
+                                                         length_poly,
+                                                         false);
+
+            std::size_t channel = j + i * length_axis_out_2;
+
+            accum(k, channel, portion);
+          }
+      }
+  }
+
+  /**
+   * \ingroup rebin_2D_quad_to_rectlin
+   *
+   * This is a PRIVATE helper function for rebin_2D_quad_to_rectlin,
+   * Rebin2DQuadToRectlinStep and Rebin2DQuadToRectlinPlan that intersects
+   * the quadrilaterals with the grid without checking the sizes of the
+   * arrays. Only the grid bins with a first index in [row_begin, row_end)
+   * are considered. Every overlap is passed to \p accum as accum(k,
+   * channel, portion), in the order of the quadrilaterals and then of the
+   * grid bins. The other parameters are the same as the ones of
+   * rebin_2D_quad_to_rectlin().
+   */
+  template <typename NumT, typename AccumT>
+  void
+  __rebin_2D_quad_to_rectlin(const Nessi::Vector<NumT> & axis_in_x1,
+                             const Nessi::Vector<NumT> & axis_in_y1,
+                             const Nessi::Vector<NumT> & axis_in_x2,
+                             const Nessi::Vector<NumT> & axis_in_y2,
+                             const Nessi::Vector<NumT> & axis_in_x3,
+                             const Nessi::Vector<NumT> & axis_in_y3,
+                             const Nessi::Vector<NumT> & axis_in_x4,
+                             const Nessi::Vector<NumT> & axis_in_y4,
+                             const Nessi::Vector<NumT> & axis_out_1,
+                             const Nessi::Vector<NumT> & axis_out_2,
+                             const std::size_t row_begin,
+                             const std::size_t row_end,
+                             AccumT & accum,
+                             void *temp)
+  {
+    std::size_t input_size = axis_in_x1.size();
+
+    NumT orig_bin_x[SIZE_QUAD];
+    NumT orig_bin_y[SIZE_QUAD];
+    std::size_t range[4];
+
+    Utils::AxisDescriptor<NumT> grid_1(axis_out_1);
+    Utils::AxisDescriptor<NumT> grid_2(axis_out_2);
+
+    for(std::size_t k = 0; k < input_size; ++k)
+      {
+        if (!__quad_grid_range(k, axis_in_x1, axis_in_y1, axis_in_x2,
+                               axis_in_y2, axis_in_x3, axis_in_y3,
+                               axis_in_x4, axis_in_y4, grid_1, grid_2,
+                               orig_bin_x, orig_bin_y, range))
+          {
+            continue;
+          }
+
+        // Keep the grid bins of the requested rows
+        range[0] = std::max(range[0], row_begin);
+        if (range[1] >= row_end)
+          {
+            range[1] = row_end - 1;
+          }
+        if (row_begin >= row_end || range[0] > range[1])
+          {
+            continue;
+          }
+
+        __clip_quad_to_grid(k, orig_bin_x, orig_bin_y, axis_out_1,
+                            axis_out_2, range, accum);
+      }
+  }
+
+  /**
+   * \ingroup rebin_2D_quad_to_rectlin
+   *
+   * This is a PRIVATE helper function for rebin_2D_quad_to_rectlin that
+   * checks the sizes of the quadrilaterals, of their data and of the
+   * rebinned histogram. The parameters are the same as the ones of
+   * rebin_2D_quad_to_rectlin().
+   */
+  template <typename NumT>
+  void
+  __check_rebin_2D_quad_to_rectlin(const Nessi::Vector<NumT> & axis_in_x1,
+                                   const Nessi::Vector<NumT> & axis_in_y1,
+                                   const Nessi::Vector<NumT> & axis_in_x2,
+                                   const Nessi::Vector<NumT> & axis_in_y2,
+                                   const Nessi::Vector<NumT> & axis_in_x3,
+                                   const Nessi::Vector<NumT> & axis_in_y3,
+                                   const Nessi::Vector<NumT> & axis_in_x4,
+                                   const Nessi::Vector<NumT> & axis_in_y4,
+                                   const Nessi::Vector<NumT> & input,
+                                   const Nessi::Vector<NumT> & input_err2,
+                                   const Nessi::Vector<NumT> & axis_out_1,
+                                   const Nessi::Vector<NumT> & axis_out_2,
+                                   const Nessi::Vector<NumT> & output,
+                                   const Nessi::Vector<NumT> & output_err2,
+                                   const Nessi::Vector<NumT> & bin_count)
   {
     // check that the coordinate pair arrays for the 1st corner are the proper 
     // size
@@ -193,6 +481,40 @@ namespace AxisManip
     // check that the output array and the bin count array are the proper size
     Utils::check_sizes_square(r2qtl_func_str+": bin count array ", 
                               output, bin_count);
+  }
+
+  // 3.61
+  template <typename NumT>
+  std::string
+  rebin_2D_quad_to_rectlin(const Nessi::Vector<NumT> & axis_in_x1,
+                           const Nessi::Vector<NumT> & axis_in_y1,
+                           const Nessi::Vector<NumT> & axis_in_x2,
+                           const Nessi::Vector<NumT> & axis_in_y2,
+                           const Nessi::Vector<NumT> & axis_in_x3,
+                           const Nessi::Vector<NumT> & axis_in_y3,
+                           const Nessi::Vector<NumT> & axis_in_x4,
+                           const Nessi::Vector<NumT> & axis_in_y4,
+                           const Nessi::Vector<NumT> & input,
+                           const Nessi::Vector<NumT> & input_err2,
+                           const Nessi::Vector<NumT> & axis_out_1,
+                           const Nessi::Vector<NumT> & axis_out_2,
+                           Nessi::Vector<NumT> & orig_bin_x,
+                           Nessi::Vector<NumT> & orig_bin_y,
+                           Nessi::Vector<NumT> & rebin_bin_x,
+                           Nessi::Vector<NumT> & rebin_bin_y,
+                           Nessi::Vector<NumT> & frac_bin_x,
+                           Nessi::Vector<NumT> & frac_bin_y,
+                           Nessi::Vector<NumT> & output,
+                           Nessi::Vector<NumT> & output_err2,
+                           Nessi::Vector<NumT> & frac_area,
+                           Nessi::Vector<NumT> & bin_count,
+                           void *temp=NULL)
+  {
+    __check_rebin_2D_quad_to_rectlin(axis_in_x1, axis_in_y1, axis_in_x2,
+                                     axis_in_y2, axis_in_x3, axis_in_y3,
+                                     axis_in_x4, axis_in_y4, input,
+                                     input_err2, axis_out_1, axis_out_2,
+                                     output, output_err2, bin_count);
 
     // check that the coordinate pair arrays for the original bin placehoder 
     // are the proper size
@@ -249,179 +571,872 @@ namespace AxisManip
                                     +"size 8 (2*4)");
       }
 
-    std::string retstr(Nessi::EMPTY_WARN);
+    __QuadRebinAccumulator<NumT> accum(input, input_err2, output,
+                                       output_err2, frac_area, bin_count);
+    __rebin_2D_quad_to_rectlin(axis_in_x1, axis_in_y1, axis_in_x2,
+                               axis_in_y2, axis_in_x3, axis_in_y3,
+                               axis_in_x4, axis_in_y4, axis_out_1,
+                               axis_out_2, 0, axis_out_1.size() - 1,
+                               accum, temp);
+
+    return Nessi::EMPTY_WARN;
+  }
+
+  template <typename NumT>
+  Rebin2DQuadToRectlinStep<NumT>::
+  Rebin2DQuadToRectlinStep(const std::size_t num_quads,
+                           const Nessi::Vector<NumT> & axis_out_1,
+                           const Nessi::Vector<NumT> & axis_out_2,
+                           Nessi::Vector<NumT> & output,
+                           Nessi::Vector<NumT> & output_err2,
+                           Nessi::Vector<NumT> & frac_area,
+                           Nessi::Vector<NumT> & bin_count)
+    : num_quads_(num_quads), axis_out_1_(&axis_out_1),
+      axis_out_2_(&axis_out_2), output_(&output),
+      output_err2_(&output_err2), frac_area_(&frac_area),
+      bin_count_(&bin_count)
+  {
+    // check that the rebinned histogram is of the proper size
+    try
+      {
+        Utils::check_histo_sizes(output, output_err2, axis_out_1, axis_out_2);
+      }
+    catch(std::invalid_argument &e)
+      {
+        throw std::invalid_argument(r2qtl_func_str+" (step): rebinned "
+                                    +"histogram "+e.what());
+      }
+    // check that the accumulation arrays are the size of the output
+    Utils::check_sizes_square(r2qtl_func_str+" (step): fractional area "
+                              +"array ", output, frac_area);
+    Utils::check_sizes_square(r2qtl_func_str+" (step): bin count array ",
+                              output, bin_count);
+  }
+
+  template <typename NumT>
+  std::size_t
+  Rebin2DQuadToRectlinStep<NumT>::num_quads() const
+  {
+    return num_quads_;
+  }
+
+  template <typename NumT>
+  std::string
+  Rebin2DQuadToRectlinStep<NumT>::
+  execute(const Nessi::Vector<NumT> & axis_in_x1,
+          const Nessi::Vector<NumT> & axis_in_y1,
+          const Nessi::Vector<NumT> & axis_in_x2,
+          const Nessi::Vector<NumT> & axis_in_y2,
+          const Nessi::Vector<NumT> & axis_in_x3,
+          const Nessi::Vector<NumT> & axis_in_y3,
+          const Nessi::Vector<NumT> & axis_in_x4,
+          const Nessi::Vector<NumT> & axis_in_y4,
+          const Nessi::Vector<NumT> & input,
+          const Nessi::Vector<NumT> & input_err2,
+          void *temp)
+  {
+    // the grid and the output were checked by the constructor, only the
+    // number of quadrilaterals is left
+    if (axis_in_x1.size() != num_quads_ || axis_in_y1.size() != num_quads_
+        || axis_in_x2.size() != num_quads_ || axis_in_y2.size() != num_quads_
+        || axis_in_x3.size() != num_quads_ || axis_in_y3.size() != num_quads_
+        || axis_in_x4.size() != num_quads_ || axis_in_y4.size() != num_quads_)
+      {
+        throw std::invalid_argument(r2qtl_func_str+" (step): input axes "
+                                    +"not the number of quadrilaterals");
+      }
+    if (input.size() != num_quads_ || input_err2.size() != num_quads_)
+      {
+        throw std::invalid_argument(r2qtl_func_str+" (step): original "
+                                    +"histogram not the number of "
+                                    +"quadrilaterals");
+      }
+
+    __QuadRebinAccumulator<NumT> accum(input, input_err2, *output_,
+                                       *output_err2_, *frac_area_,
+                                       *bin_count_);
+    __rebin_2D_quad_to_rectlin(axis_in_x1, axis_in_y1, axis_in_x2,
+                               axis_in_y2, axis_in_x3, axis_in_y3,
+                               axis_in_x4, axis_in_y4, *axis_out_1_,
+                               *axis_out_2_, 0, axis_out_1_->size() - 1,
+                               accum, temp);
+
+    return Nessi::EMPTY_WARN;
+  }
 
-    std::size_t input_size = input.size();
+  /**
+   * \ingroup rebin_2D_quad_to_rectlin
+   *
+   * This is a PRIVATE accumulator for __rebin_2D_quad_to_rectlin() that
+   * records every overlap in the arrays of a Rebin2DQuadToRectlinPlan.
+   */
+  template <typename NumT>
+  class __QuadPlanRecorder
+  {
+  public:
+    /// Constructor keeping the arrays of the plan
+    __QuadPlanRecorder(Nessi::Vector<std::size_t> & offset,
+                       Nessi::Vector<std::size_t> & channel,
+                       Nessi::Vector<NumT> & weight)
+      : offset_(offset), channel_(channel), weight_(weight)
+    { }
 
-    std::vector<std::size_t> length_axis_out;
-    length_axis_out.push_back(axis_out_1.size() - 1);
-    length_axis_out.push_back(axis_out_2.size() - 1);
+    /// Records the portion of quadrilateral \p k that falls in \p channel
+    void operator()(const std::size_t k, const std::size_t channel,
+                    const NumT portion)
+    {
+      channel_.push_back(channel);
+      weight_.push_back(portion);
+      offset_[k + 1] = weight_.size();
+    }
 
-    NumT orig_area;
-    Nessi::Vector<NumT> orig_cp_x(SIZE_QUAD + 2);
-    Nessi::Vector<NumT> orig_cp_y(SIZE_QUAD + 2);
+  private:
+    /// First weight of every quadrilateral
+    Nessi::Vector<std::size_t> & offset_;
+    /// Grid bin of every weight
+    Nessi::Vector<std::size_t> & channel_;
+    /// The overlap areas
+    Nessi::Vector<NumT> & weight_;
+  };
 
-    NumT rebin_area;
-    Nessi::Vector<NumT> rebin_cp_x(SIZE_QUAD + 2);
-    Nessi::Vector<NumT> rebin_cp_y(SIZE_QUAD + 2);
+  /// Tag starting a Rebin2DQuadToRectlinPlan written by save()
+  const std::string r2qtl_plan_tag = "Rebin2DQuadToRectlinPlan";
 
-    for(std::size_t k = 0; k < input_size; ++k)
+  /// Version of the format written by Rebin2DQuadToRectlinPlan::save()
+  const int r2qtl_plan_version = 1;
+
+  template <typename NumT>
+  Rebin2DQuadToRectlinPlan<NumT>::Rebin2DQuadToRectlinPlan()
+    : num_bins_out_1_(0), num_bins_out_2_(0), offset_(1)
+  {
+  }
+
+  template <typename NumT>
+  Rebin2DQuadToRectlinPlan<NumT>::
+  Rebin2DQuadToRectlinPlan(const Nessi::Vector<NumT> & axis_in_x1,
+                           const Nessi::Vector<NumT> & axis_in_y1,
+                           const Nessi::Vector<NumT> & axis_in_x2,
+                           const Nessi::Vector<NumT> & axis_in_y2,
+                           const Nessi::Vector<NumT> & axis_in_x3,
+                           const Nessi::Vector<NumT> & axis_in_y3,
+                           const Nessi::Vector<NumT> & axis_in_x4,
+                           const Nessi::Vector<NumT> & axis_in_y4,
+                           const Nessi::Vector<NumT> & axis_out_1,
+                           const Nessi::Vector<NumT> & axis_out_2,
+                           void *temp)
+  {
+    // check that all corners have one coordinate per quadrilateral
+    std::size_t num_quads = axis_in_x1.size();
+    if (axis_in_y1.size() != num_quads || axis_in_x2.size() != num_quads
+        || axis_in_y2.size() != num_quads || axis_in_x3.size() != num_quads
+        || axis_in_y3.size() != num_quads || axis_in_x4.size() != num_quads
+        || axis_in_y4.size() != num_quads)
       {
-        // Get the bin boundaries in out of the original axes
-        orig_bin_x[0] = axis_in_x1[k];
-        orig_bin_x[1] = axis_in_x2[k];
-        orig_bin_x[2] = axis_in_x3[k];
-        orig_bin_x[3] = axis_in_x4[k];
-
-        orig_bin_y[0] = axis_in_y1[k];
-        orig_bin_y[1] = axis_in_y2[k];
-        orig_bin_y[2] = axis_in_y3[k];
-        orig_bin_y[3] = axis_in_y4[k];
-
-        std::copy(orig_bin_x.begin(), orig_bin_x.end(), orig_cp_x.begin());
-        orig_cp_x[4] = orig_bin_x[0];
-        orig_cp_x[5] = orig_bin_x[1];
-
-        std::copy(orig_bin_y.begin(), orig_bin_y.end(), orig_cp_y.begin());
-        orig_cp_y[4] = orig_bin_y[0];
-        orig_cp_y[5] = orig_bin_y[1];
-
-        Utils::calc_area_2D_polygon(orig_cp_x, orig_cp_y, SIZE_QUAD, false,
-                                    orig_area);
-
-        // Find the minimum and maximum values for the x and y coordinates
-        NumT x_min = *std::min_element(orig_bin_x.begin(), orig_bin_x.end());
-        NumT x_max = *std::max_element(orig_bin_x.begin(), orig_bin_x.end());
-
-        NumT y_min = *std::min_element(orig_bin_y.begin(), orig_bin_y.end());
-        NumT y_max = *std::max_element(orig_bin_y.begin(), orig_bin_y.end());
-
-        // Check to see if the original bin boundaries are outside the 
-        // rebinned axes boundaries
-        bool check1 = (x_min < axis_out_1[0] && 
-                       x_max < axis_out_1[0]);
-        bool check2 = (x_min > axis_out_1[length_axis_out[0]] && 
-                       x_max > axis_out_1[length_axis_out[0]]);
-        bool check3 = (y_min < axis_out_2[0] && 
-                       y_max < axis_out_2[0]);
-        bool check4 = (y_min > axis_out_2[length_axis_out[1]] && 
-                       y_max > axis_out_2[length_axis_out[1]]);
-
-        if(check1 || check2 || check3 || check4)
-          {
-            continue;
-          }
-        
-        // Determine the range of indices to rebin over
-        std::size_t index_x_left;
-        std::size_t index_x_right;
-        std::size_t index_y_left;
-        std::size_t index_y_right;
-
-        Utils::bisect_helper(axis_out_1, x_min, index_x_left);
-        Utils::bisect_helper(axis_out_1, x_max, index_x_right);
-        Utils::bisect_helper(axis_out_2, y_min, index_y_left);
-        Utils::bisect_helper(axis_out_2, y_max, index_y_right);
-        
-        if(index_x_left == std::numeric_limits<std::size_t>::max() || 
-           index_y_left == std::numeric_limits<std::size_t>::max())
+        throw std::invalid_argument(r2qtl_func_str+" (plan): input axes "
+                                    +"not the same size");
+      }
+    if (axis_out_1.empty() || axis_out_2.empty())
+      {
+        throw std::invalid_argument(r2qtl_func_str+" (plan): empty target "
+                                    +"axis");
+      }
+
+    num_bins_out_1_ = axis_out_1.size() - 1;
+    num_bins_out_2_ = axis_out_2.size() - 1;
+    offset_.assign(num_quads + 1, 0);
+
+    __QuadPlanRecorder<NumT> accum(offset_, channel_, weight_);
+    __rebin_2D_quad_to_rectlin(axis_in_x1, axis_in_y1, axis_in_x2,
+                               axis_in_y2, axis_in_x3, axis_in_y3,
+                               axis_in_x4, axis_in_y4, axis_out_1,
+                               axis_out_2, 0, axis_out_1.size() - 1,
+                               accum, temp);
+
+    // quadrilaterals without overlap end where the previous one ended
+    for (std::size_t k = 1; k <= num_quads; ++k)
+      {
+        offset_[k] = std::max(offset_[k], offset_[k - 1]);
+      }
+  }
+
+  template <typename NumT>
+  std::size_t
+  Rebin2DQuadToRectlinPlan<NumT>::num_quads() const
+  {
+    return offset_.size() - 1;
+  }
+
+  template <typename NumT>
+  std::size_t
+  Rebin2DQuadToRectlinPlan<NumT>::num_bins_out_1() const
+  {
+    return num_bins_out_1_;
+  }
+
+  template <typename NumT>
+  std::size_t
+  Rebin2DQuadToRectlinPlan<NumT>::num_bins_out_2() const
+  {
+    return num_bins_out_2_;
+  }
+
+  template <typename NumT>
+  std::size_t
+  Rebin2DQuadToRectlinPlan<NumT>::num_weights() const
+  {
+    return weight_.size();
+  }
+
+  template <typename NumT>
+  std::string
+  Rebin2DQuadToRectlinPlan<NumT>::
+  apply(const Nessi::Vector<NumT> & input,
+        const Nessi::Vector<NumT> & input_err2,
+        Nessi::Vector<NumT> & output,
+        Nessi::Vector<NumT> & output_err2,
+        Nessi::Vector<NumT> & frac_area,
+        Nessi::Vector<NumT> & bin_count,
+        void *temp) const
+  {
+    // check that the arrays are the sizes of the plan
+    std::size_t num_quads = this->num_quads();
+    if (input.size() != num_quads || input_err2.size() != num_quads)
+      {
+        throw std::invalid_argument(r2qtl_func_str+" (plan): original "
+                                    +"histogram not the number of "
+                                    +"quadrilaterals");
+      }
+    std::size_t num_bins = num_bins_out_1_ * num_bins_out_2_;
+    if (output.size() != num_bins || output_err2.size() != num_bins
+        || frac_area.size() != num_bins || bin_count.size() != num_bins)
+      {
+        throw std::invalid_argument(r2qtl_func_str+" (plan): rebinned "
+                                    +"histogram not the size of the grid");
+      }
+
+    for (std::size_t k = 0; k < num_quads; ++k)
+      {
+        for (std::size_t e = offset_[k]; e < offset_[k + 1]; ++e)
           {
-            continue;
+            std::size_t channel = channel_[e];
+            NumT portion = weight_[e];
+
+            output[channel] += input[k] * portion;
+            output_err2[channel] += input_err2[k] * portion * portion;
+            frac_area[channel] += portion;
+            bin_count[channel] = 1.0;
           }
+      }
+
+    return Nessi::EMPTY_WARN;
+  }
+
+  template <typename NumT>
+  void
+  Rebin2DQuadToRectlinPlan<NumT>::save(std::ostream & out) const
+  {
+    // enough digits for the areas to read back exactly
+    std::streamsize precision = out.precision(
+                                 std::numeric_limits<NumT>::digits10 + 3);
+
+    out << r2qtl_plan_tag << " " << r2qtl_plan_version << "\n"
+        << this->num_quads() << " " << num_bins_out_1_ << " "
+        << num_bins_out_2_ << " " << weight_.size() << "\n";
+    for (std::size_t k = 0; k < offset_.size(); ++k)
+      {
+        out << offset_[k] << "\n";
+      }
+    for (std::size_t e = 0; e < weight_.size(); ++e)
+      {
+        out << channel_[e] << " " << weight_[e] << "\n";
+      }
+
+    out.precision(precision);
+  }
+
+  template <typename NumT>
+  void
+  Rebin2DQuadToRectlinPlan<NumT>::load(std::istream & in)
+  {
+    std::string tag;
+    int version = 0;
+    in >> tag >> version;
+    if (!in || tag != r2qtl_plan_tag || version != r2qtl_plan_version)
+      {
+        throw std::invalid_argument(r2qtl_func_str+" (plan): stream does "
+                                    +"not hold a plan");
+      }
+
+    std::size_t num_quads = 0;
+    std::size_t num_bins_out_1 = 0;
+    std::size_t num_bins_out_2 = 0;
+    std::size_t num_weights = 0;
+    in >> num_quads >> num_bins_out_1 >> num_bins_out_2 >> num_weights;
+
+    Nessi::Vector<std::size_t> offset(num_quads + 1);
+    for (std::size_t k = 0; in && k <= num_quads; ++k)
+      {
+        in >> offset[k];
+      }
+    Nessi::Vector<std::size_t> channel(num_weights);
+    Nessi::Vector<NumT> weight(num_weights);
+    for (std::size_t e = 0; in && e < num_weights; ++e)
+      {
+        in >> channel[e] >> weight[e];
+      }
+    if (!in)
+      {
+        throw std::invalid_argument(r2qtl_func_str+" (plan): truncated "
+                                    +"stream");
+      }
+
+    // the offsets and the grid bins must stay in range in apply()
+    bool valid = (offset[0] == 0 && offset[num_quads] == num_weights);
+    for (std::size_t k = 0; valid && k < num_quads; ++k)
+      {
+        valid = (offset[k] <= offset[k + 1]);
+      }
+    std::size_t num_bins = num_bins_out_1 * num_bins_out_2;
+    for (std::size_t e = 0; valid && e < num_weights; ++e)
+      {
+        valid = (channel[e] < num_bins);
+      }
+    if (!valid)
+      {
+        throw std::invalid_argument(r2qtl_func_str+" (plan): inconsistent "
+                                    +"plan in stream");
+      }
+
+    num_bins_out_1_ = num_bins_out_1;
+    num_bins_out_2_ = num_bins_out_2;
+    offset_.swap(offset);
+    channel_.swap(channel);
+    weight_.swap(weight);
+  }
+
+  /**
+   * \ingroup rebin_2D_quad_to_rectlin
+   *
+   * This is a PRIVATE accumulator for Rebin2DQuadToRectlinTiling that adds
+   * every overlap to the arrays of a single tile.
+   */
+  template <typename NumT>
+  class __QuadTileAccumulator
+  {
+  public:
+    /// Constructor keeping the data, the arrays and the place of the tile
+    __QuadTileAccumulator(const Nessi::Vector<NumT> & input,
+                          const Nessi::Vector<NumT> & input_err2,
+                          Nessi::Vector<NumT> & output,
+                          Nessi::Vector<NumT> & output_err2,
+                          Nessi::Vector<NumT> & frac_area,
+                          Nessi::Vector<NumT> & bin_count,
+                          const std::size_t num_bins_out_2,
+                          const std::size_t begin_1,
+                          const std::size_t begin_2,
+                          const std::size_t width)
+      : input_(input), input_err2_(input_err2), output_(output),
+        output_err2_(output_err2), frac_area_(frac_area),
+        bin_count_(bin_count), num_bins_out_2_(num_bins_out_2),
+        begin_1_(begin_1), begin_2_(begin_2), width_(width)
+    { }
+
+    /// Adds the portion of quadrilateral \p k that falls in \p channel
+    void operator()(const std::size_t k, const std::size_t channel,
+                    const NumT portion)
+    {
+      std::size_t i = channel / num_bins_out_2_ - begin_1_;
+      std::size_t j = channel % num_bins_out_2_ - begin_2_;
+      std::size_t index = j + i * width_;
+
+      output_[index] += input_[k] * portion;
+      output_err2_[index] += input_err2_[k] * portion * portion;
+      frac_area_[index] += portion;
+      bin_count_[index] = 1.0;
+    }
+
+  private:
+    /// The data of the quadrilaterals
+    const Nessi::Vector<NumT> & input_;
+    /// The square of the uncertainty of the data
+    const Nessi::Vector<NumT> & input_err2_;
+    /// The rebinned data of the tile
+    Nessi::Vector<NumT> & output_;
+    /// The square of the uncertainty of the rebinned data of the tile
+    Nessi::Vector<NumT> & output_err2_;
+    /// The accumulated fractional area of the tile
+    Nessi::Vector<NumT> & frac_area_;
+    /// The contribution of the data to the tile
+    Nessi::Vector<NumT> & bin_count_;
+    /// Number of bins of the 2nd target axis
+    std::size_t num_bins_out_2_;
+    /// First bin of the tile on the 1st target axis
+    std::size_t begin_1_;
+    /// First bin of the tile on the 2nd target axis
+    std::size_t begin_2_;
+    /// Number of bins of the tile along the 2nd target axis
+    std::size_t width_;
+  };
+
+  template <typename NumT>
+  Rebin2DQuadToRectlinTiling<NumT>::
+  Rebin2DQuadToRectlinTiling(const Nessi::Vector<NumT> & axis_in_x1,
+                             const Nessi::Vector<NumT> & axis_in_y1,
+                             const Nessi::Vector<NumT> & axis_in_x2,
+                             const Nessi::Vector<NumT> & axis_in_y2,
+                             const Nessi::Vector<NumT> & axis_in_x3,
+                             const Nessi::Vector<NumT> & axis_in_y3,
+                             const Nessi::Vector<NumT> & axis_in_x4,
+                             const Nessi::Vector<NumT> & axis_in_y4,
+                             const Nessi::Vector<NumT> & axis_out_1,
+                             const Nessi::Vector<NumT> & axis_out_2,
+                             const std::size_t tile_size_1,
+                             const std::size_t tile_size_2)
+    : axis_in_x1_(&axis_in_x1), axis_in_y1_(&axis_in_y1),
+      axis_in_x2_(&axis_in_x2), axis_in_y2_(&axis_in_y2),
+      axis_in_x3_(&axis_in_x3), axis_in_y3_(&axis_in_y3),
+      axis_in_x4_(&axis_in_x4), axis_in_y4_(&axis_in_y4),
+      axis_out_1_(&axis_out_1), axis_out_2_(&axis_out_2),
+      tile_size_1_(tile_size_1), tile_size_2_(tile_size_2), num_tiles_2_(0)
+  {
+    // check that all corners have one coordinate per quadrilateral
+    std::size_t num_quads = axis_in_x1.size();
+    if (axis_in_y1.size() != num_quads || axis_in_x2.size() != num_quads
+        || axis_in_y2.size() != num_quads || axis_in_x3.size() != num_quads
+        || axis_in_y3.size() != num_quads || axis_in_x4.size() != num_quads
+        || axis_in_y4.size() != num_quads)
+      {
+        throw std::invalid_argument(r2qtl_func_str+" (tiling): input axes "
+                                    +"not the same size");
+      }
+    if (axis_out_1.empty() || axis_out_2.empty())
+      {
+        throw std::invalid_argument(r2qtl_func_str+" (tiling): empty "
+                                    +"target axis");
+      }
+    if (tile_size_1 == 0 || tile_size_2 == 0)
+      {
+        throw std::invalid_argument(r2qtl_func_str+" (tiling): tile size "
+                                    +"of zero");
+      }
+
+    std::size_t num_bins_out_1 = axis_out_1.size() - 1;
+    std::size_t num_bins_out_2 = axis_out_2.size() - 1;
+    std::size_t num_tiles_1 = (num_bins_out_1 + tile_size_1 - 1)
+      / tile_size_1;
+    num_tiles_2_ = (num_bins_out_2 + tile_size_2 - 1) / tile_size_2;
+    std::size_t num_tiles = num_tiles_1 * num_tiles_2_;
+
+    NumT quad_x[SIZE_QUAD];
+    NumT quad_y[SIZE_QUAD];
+    std::size_t range[4];
+
+    Utils::AxisDescriptor<NumT> grid_1(axis_out_1);
+    Utils::AxisDescriptor<NumT> grid_2(axis_out_2);
 
-        // Actually do the rebinning
-        for(std::size_t i = index_x_left; i <= index_x_right; ++i)
+    // count the quadrilaterals of every tile, then list them in order
+    offset_.assign(num_tiles + 1, 0);
+    Nessi::Vector<std::size_t> next;
+    for (int pass = 0; pass < 2; ++pass)
+      {
+        for (std::size_t k = 0; k < num_quads; ++k)
           {
-            for(std::size_t j = index_y_left; j <= index_y_right; ++j)
+            if (!__quad_grid_range(k, axis_in_x1, axis_in_y1, axis_in_x2,
+                                   axis_in_y2, axis_in_x3, axis_in_y3,
+                                   axis_in_x4, axis_in_y4, grid_1, grid_2,
+                                   quad_x, quad_y, range))
+              {
+                continue;
+              }
+            for (std::size_t t1 = range[0] / tile_size_1;
+                 t1 <= range[1] / tile_size_1; ++t1)
               {
-                // Construct the rectlinear grid bin
-                rebin_bin_x[0] = axis_out_1[i];
-                rebin_bin_x[1] = axis_out_1[i];
-                rebin_bin_x[2] = axis_out_1[i+1];
-                rebin_bin_x[3] = axis_out_1[i+1];
-
-                rebin_bin_y[0] = axis_out_2[j];
-                rebin_bin_y[1] = axis_out_2[j+1];
-                rebin_bin_y[2] = axis_out_2[j+1];
-                rebin_bin_y[3] = axis_out_2[j];
-
-                std::copy(rebin_bin_x.begin(), rebin_bin_x.end(), 
-                          rebin_cp_x.begin());
-                rebin_cp_x[4] = rebin_bin_x[0];
-                rebin_cp_x[5] = rebin_bin_x[1];
-                
-                std::copy(rebin_bin_y.begin(), rebin_bin_y.end(), 
-                          rebin_cp_y.begin());
-                rebin_cp_y[4] = rebin_bin_y[0];
-                rebin_cp_y[5] = rebin_bin_y[1];
-                
-                Utils::calc_area_2D_polygon(rebin_cp_x, rebin_cp_y, 
-                                            SIZE_QUAD, false,
-                                            rebin_area);
-                
-                try
+                for (std::size_t t2 = range[2] / tile_size_2;
+                     t2 <= range[3] / tile_size_2; ++t2)
                   {
-                    if (Utils::compare(rebin_area, orig_area) == 1)
-                      { 
-                        Utils::convex_polygon_intersect(rebin_bin_x, 
-                                                        rebin_bin_y,
-                                                        orig_bin_x, orig_bin_y,
-                                                        frac_bin_x, 
-                                                        frac_bin_y);
+                    std::size_t tile = t2 + t1 * num_tiles_2_;
+                    if (pass == 0)
+                      {
+                        ++offset_[tile + 1];
                       }
                     else
                       {
-                        Utils::convex_polygon_intersect(orig_bin_x, orig_bin_y,
-                                                        rebin_bin_x, 
-                                                        rebin_bin_y,
-                                                        frac_bin_x, 
-                                                        frac_bin_y);
+                        quad_[next[tile]++] = k;
                       }
                   }
-                catch (std::exception &e)
-                  {
-                    std::ostringstream bad_index;
-                    bad_index << "[" << k << "] ";
+              }
+          }
 
-                    throw std::invalid_argument(r2qtl_func_str + " index"
-                                                + bad_index.str() + ": "
-                                                + e.what());
-                  }
+        if (pass == 0)
+          {
+            for (std::size_t t = 0; t < num_tiles; ++t)
+              {
+                offset_[t + 1] += offset_[t];
+              }
+            quad_.assign(offset_[num_tiles], 0);
+            next = offset_;
+          }
+      }
+  }
 
-                std::size_t length_poly = frac_bin_x.size();
-                if (length_poly < MIN_SIZE_POLY)
-                  {
-                    // Overlap is not a polygon, so area can't be calculated
-                    continue;
-                  }
+  template <typename NumT>
+  std::size_t
+  Rebin2DQuadToRectlinTiling<NumT>::num_quads() const
+  {
+    return axis_in_x1_->size();
+  }
 
-                // Add first two coordinates back into the coordinate arrays 
-                // for area calculation
-                frac_bin_x.push_back(frac_bin_x[0]);
-                frac_bin_x.push_back(frac_bin_x[1]);
+  template <typename NumT>
+  std::size_t
+  Rebin2DQuadToRectlinTiling<NumT>::num_tiles() const
+  {
+    return offset_.size() - 1;
+  }
 
-                frac_bin_y.push_back(frac_bin_y[0]);
-                frac_bin_y.push_back(frac_bin_y[1]);
+  template <typename NumT>
+  std::size_t
+  Rebin2DQuadToRectlinTiling<NumT>::num_quads(const std::size_t tile) const
+  {
+    if (tile >= this->num_tiles())
+      {
+        throw std::invalid_argument(r2qtl_func_str+" (tiling): tile out "
+                                    +"of range");
+      }
+    return offset_[tile + 1] - offset_[tile];
+  }
 
-                NumT portion;
+  template <typename NumT>
+  void
+  Rebin2DQuadToRectlinTiling<NumT>::tile_bounds(const std::size_t tile,
+                                                std::size_t & begin_1,
+                                                std::size_t & end_1,
+                                                std::size_t & begin_2,
+                                                std::size_t & end_2) const
+  {
+    if (tile >= this->num_tiles())
+      {
+        throw std::invalid_argument(r2qtl_func_str+" (tiling): tile out "
+                                    +"of range");
+      }
+    begin_1 = (tile / num_tiles_2_) * tile_size_1_;
+    end_1 = std::min(begin_1 + tile_size_1_, axis_out_1_->size() - 1);
+    begin_2 = (tile % num_tiles_2_) * tile_size_2_;
+    end_2 = std::min(begin_2 + tile_size_2_, axis_out_2_->size() - 1);
+  }
 
-                Utils::calc_area_2D_polygon(frac_bin_x, frac_bin_y, 
-                                            length_poly, false,
-                                            portion);
+  template <typename NumT>
+  void
+  Rebin2DQuadToRectlinTiling<NumT>::
+  check_input(const Nessi::Vector<NumT> & input,
+              const Nessi::Vector<NumT> & input_err2) const
+  {
+    if (input.size() != this->num_quads()
+        || input_err2.size() != this->num_quads())
+      {
+        throw std::invalid_argument(r2qtl_func_str+" (tiling): original "
+                                    +"histogram not the size of the "
+                                    +"quadrilaterals");
+      }
+  }
 
-                std::size_t channel = j + i * length_axis_out[1];
+  template <typename NumT>
+  template <typename AccumT>
+  void
+  Rebin2DQuadToRectlinTiling<NumT>::rebin_tile(const std::size_t tile,
+                                               AccumT & accum) const
+  {
+    std::size_t begin_1;
+    std::size_t end_1;
+    std::size_t begin_2;
+    std::size_t end_2;
+    this->tile_bounds(tile, begin_1, end_1, begin_2, end_2);
 
-                output[channel] += input[k] * portion;                
-                output_err2[channel] += input_err2[k] * portion * portion;
-                frac_area[channel] += portion;
-                bin_count[channel] = 1.0;
-              }
-          }
+    NumT quad_x[SIZE_QUAD];
+    NumT quad_y[SIZE_QUAD];
+    std::size_t range[4];
+
+    Utils::AxisDescriptor<NumT> grid_1(*axis_out_1_);
+    Utils::AxisDescriptor<NumT> grid_2(*axis_out_2_);
+
+    for (std::size_t e = offset_[tile]; e < offset_[tile + 1]; ++e)
+      {
+        std::size_t k = quad_[e];
+        __quad_grid_range(k, *axis_in_x1_, *axis_in_y1_, *axis_in_x2_,
+                          *axis_in_y2_, *axis_in_x3_, *axis_in_y3_,
+                          *axis_in_x4_, *axis_in_y4_, grid_1, grid_2,
+                          quad_x, quad_y, range);
+
+        // keep the bins of the tile
+        range[0] = std::max(range[0], begin_1);
+        range[1] = std::min(range[1], end_1 - 1);
+        range[2] = std::max(range[2], begin_2);
+        range[3] = std::min(range[3], end_2 - 1);
+
+        __clip_quad_to_grid(k, quad_x, quad_y, *axis_out_1_, *axis_out_2_,
+                            range, accum);
       }
-    
-    return retstr;
   }
 
+  template <typename NumT>
+  std::string
+  Rebin2DQuadToRectlinTiling<NumT>::
+  apply(const Nessi::Vector<NumT> & input,
+        const Nessi::Vector<NumT> & input_err2,
+        Nessi::Vector<NumT> & output,
+        Nessi::Vector<NumT> & output_err2,
+        Nessi::Vector<NumT> & frac_area,
+        Nessi::Vector<NumT> & bin_count,
+        void *temp) const
+  {
+    this->check_input(input, input_err2);
+    // check that the rebinned histogram is of the proper size
+    try
+      {
+        Utils::check_histo_sizes(output, output_err2, *axis_out_1_,
+                                 *axis_out_2_);
+      }
+    catch(std::invalid_argument &e)
+      {
+        throw std::invalid_argument(r2qtl_func_str+" (tiling): rebinned "
+                                    +"histogram "+e.what());
+      }
+    Utils::check_sizes_square(r2qtl_func_str+" (tiling): fractional area "
+                              +"array ", output, frac_area);
+    Utils::check_sizes_square(r2qtl_func_str+" (tiling): bin count array ",
+                              output, bin_count);
+
+    __QuadRebinAccumulator<NumT> accum(input, input_err2, output,
+                                       output_err2, frac_area, bin_count);
+    for (std::size_t t = 0; t < this->num_tiles(); ++t)
+      {
+        this->rebin_tile(t, accum);
+      }
+
+    return Nessi::EMPTY_WARN;
+  }
+
+  template <typename NumT>
+  std::string
+  Rebin2DQuadToRectlinTiling<NumT>::
+  apply_tile(const std::size_t tile,
+             const Nessi::Vector<NumT> & input,
+             const Nessi::Vector<NumT> & input_err2,
+             Nessi::Vector<NumT> & tile_output,
+             Nessi::Vector<NumT> & tile_output_err2,
+             Nessi::Vector<NumT> & tile_frac_area,
+             Nessi::Vector<NumT> & tile_bin_count,
+             void *temp) const
+  {
+    std::size_t begin_1;
+    std::size_t end_1;
+    std::size_t begin_2;
+    std::size_t end_2;
+    this->tile_bounds(tile, begin_1, end_1, begin_2, end_2);
+    this->check_input(input, input_err2);
+
+    // check that the arrays of the tile have one element per bin
+    std::size_t width = end_2 - begin_2;
+    std::size_t num_bins = (end_1 - begin_1) * width;
+    if (tile_output.size() != num_bins
+        || tile_output_err2.size() != num_bins
+        || tile_frac_area.size() != num_bins
+        || tile_bin_count.size() != num_bins)
+      {
+        throw std::invalid_argument(r2qtl_func_str+" (tiling): arrays not "
+                                    +"the size of the tile");
+      }
+
+    __QuadTileAccumulator<NumT> accum(input, input_err2, tile_output,
+                                      tile_output_err2, tile_frac_area,
+                                      tile_bin_count,
+                                      axis_out_2_->size() - 1, begin_1,
+                                      begin_2, width);
+    this->rebin_tile(tile, accum);
+
+    return Nessi::EMPTY_WARN;
+  }
+
+  /**
+   * \ingroup rebin_2D_quad_to_rectlin
+   *
+   * This is a PRIVATE function object for the parallel
+   * rebin_2D_quad_to_rectlin that rebins all quadrilaterals into the grid
+   * bins of the rows [begin, end) of the first target axis. The rows of a
+   * chunk are a contiguous part of the rebinned arrays that no other chunk
+   * writes, and every grid bin receives the overlaps in the order of the
+   * quadrilaterals, as in the sequential version. The first quadrilateral
+   * that cannot be clipped is recorded for the chunk instead of being
+   * thrown.
+   */
+  template <typename NumT>
+  class __Rebin2DQuadToRectlinRows
+  {
+  public:
+    /// Constructor keeping the arguments of rebin_2D_quad_to_rectlin
+    __Rebin2DQuadToRectlinRows(const Nessi::Vector<NumT> & axis_in_x1,
+                               const Nessi::Vector<NumT> & axis_in_y1,
+                               const Nessi::Vector<NumT> & axis_in_x2,
+                               const Nessi::Vector<NumT> & axis_in_y2,
+                               const Nessi::Vector<NumT> & axis_in_x3,
+                               const Nessi::Vector<NumT> & axis_in_y3,
+                               const Nessi::Vector<NumT> & axis_in_x4,
+                               const Nessi::Vector<NumT> & axis_in_y4,
+                               const Nessi::Vector<NumT> & input,
+                               const Nessi::Vector<NumT> & input_err2,
+                               const Nessi::Vector<NumT> & axis_out_1,
+                               const Nessi::Vector<NumT> & axis_out_2,
+                               Nessi::Vector<NumT> & output,
+                               Nessi::Vector<NumT> & output_err2,
+                               Nessi::Vector<NumT> & frac_area,
+                               Nessi::Vector<NumT> & bin_count,
+                               std::vector<std::size_t> & bad_quad,
+                               std::vector<std::string> & message)
+      : axis_in_x1_(axis_in_x1), axis_in_y1_(axis_in_y1),
+        axis_in_x2_(axis_in_x2), axis_in_y2_(axis_in_y2),
+        axis_in_x3_(axis_in_x3), axis_in_y3_(axis_in_y3),
+        axis_in_x4_(axis_in_x4), axis_in_y4_(axis_in_y4), input_(input),
+        input_err2_(input_err2), axis_out_1_(axis_out_1),
+        axis_out_2_(axis_out_2), output_(output), output_err2_(output_err2),
+        frac_area_(frac_area), bin_count_(bin_count), bad_quad_(bad_quad),
+        message_(message)
+    { }
+
+    /// Rebins into the rows [begin, end) and records errors for \p chunk
+    void operator()(const std::size_t chunk, const std::size_t begin,
+                    const std::size_t end) const
+    {
+      __QuadRebinAccumulator<NumT> accum(input_, input_err2_, output_,
+                                         output_err2_, frac_area_,
+                                         bin_count_);
+      try
+        {
+          __rebin_2D_quad_to_rectlin(axis_in_x1_, axis_in_y1_, axis_in_x2_,
+                                     axis_in_y2_, axis_in_x3_, axis_in_y3_,
+                                     axis_in_x4_, axis_in_y4_, axis_out_1_,
+                                     axis_out_2_, begin, end, accum, NULL);
+        }
+      catch (__QuadClipError &e)
+        {
+          bad_quad_[chunk] = e.quad();
+          message_[chunk] = e.what();
+        }
+    }
+
+  private:
+    /// The x-coordinate of the 1st corners
+    const Nessi::Vector<NumT> & axis_in_x1_;
+    /// The y-coordinate of the 1st corners
+    const Nessi::Vector<NumT> & axis_in_y1_;
+    /// The x-coordinate of the 2nd corners
+    const Nessi::Vector<NumT> & axis_in_x2_;
+    /// The y-coordinate of the 2nd corners
+    const Nessi::Vector<NumT> & axis_in_y2_;
+    /// The x-coordinate of the 3rd corners
+    const Nessi::Vector<NumT> & axis_in_x3_;
+    /// The y-coordinate of the 3rd corners
+    const Nessi::Vector<NumT> & axis_in_y3_;
+    /// The x-coordinate of the 4th corners
+    const Nessi::Vector<NumT> & axis_in_x4_;
+    /// The y-coordinate of the 4th corners
+    const Nessi::Vector<NumT> & axis_in_y4_;
+    /// The data of the quadrilaterals
+    const Nessi::Vector<NumT> & input_;
+    /// The square of the uncertainty of the data
+    const Nessi::Vector<NumT> & input_err2_;
+    /// The 1st target axis
+    const Nessi::Vector<NumT> & axis_out_1_;
+    /// The 2nd target axis
+    const Nessi::Vector<NumT> & axis_out_2_;
+    /// The rebinned data
+    Nessi::Vector<NumT> & output_;
+    /// The square of the uncertainty of the rebinned data
+    Nessi::Vector<NumT> & output_err2_;
+    /// The accumulated fractional area
+    Nessi::Vector<NumT> & frac_area_;
+    /// The contribution of the data to the rebinned data
+    Nessi::Vector<NumT> & bin_count_;
+    /// The first quadrilateral that could not be clipped in every chunk
+    std::vector<std::size_t> & bad_quad_;
+    /// The error message of that quadrilateral
+    std::vector<std::string> & message_;
+  };
+
+  // 3.61
+  template <typename NumT>
+  std::string
+  rebin_2D_quad_to_rectlin(const Nessi::ExecutionPolicy & policy,
+                           const Nessi::Vector<NumT> & axis_in_x1,
+                           const Nessi::Vector<NumT> & axis_in_y1,
+                           const Nessi::Vector<NumT> & axis_in_x2,
+                           const Nessi::Vector<NumT> & axis_in_y2,
+                           const Nessi::Vector<NumT> & axis_in_x3,
+                           const Nessi::Vector<NumT> & axis_in_y3,
+                           const Nessi::Vector<NumT> & axis_in_x4,
+                           const Nessi::Vector<NumT> & axis_in_y4,
+                           const Nessi::Vector<NumT> & input,
+                           const Nessi::Vector<NumT> & input_err2,
+                           const Nessi::Vector<NumT> & axis_out_1,
+                           const Nessi::Vector<NumT> & axis_out_2,
+                           Nessi::Vector<NumT> & output,
+                           Nessi::Vector<NumT> & output_err2,
+                           Nessi::Vector<NumT> & frac_area,
+                           Nessi::Vector<NumT> & bin_count,
+                           void *temp)
+  {
+    __check_rebin_2D_quad_to_rectlin(axis_in_x1, axis_in_y1, axis_in_x2,
+                                     axis_in_y2, axis_in_x3, axis_in_y3,
+                                     axis_in_x4, axis_in_y4, input,
+                                     input_err2, axis_out_1, axis_out_2,
+                                     output, output_err2, bin_count);
+    // check that the fractional area array is the proper size, the
+    // chunks write into it
+    Utils::check_sizes_square(r2qtl_func_str+": fractional area array ",
+                              output, frac_area);
+
+    std::size_t num_rows = axis_out_1.size() - 1;
+    std::size_t chunks = Nessi::num_chunks(policy, num_rows);
+    std::vector<std::size_t>
+      bad_quad(chunks, std::numeric_limits<std::size_t>::max());
+    std::vector<std::string> message(chunks);
+
+    Nessi::for_each_chunk(policy, num_rows,
+                          __Rebin2DQuadToRectlinRows<NumT>(axis_in_x1,
+                                                           axis_in_y1,
+                                                           axis_in_x2,
+                                                           axis_in_y2,
+                                                           axis_in_x3,
+                                                           axis_in_y3,
+                                                           axis_in_x4,
+                                                           axis_in_y4,
+                                                           input,
+                                                           input_err2,
+                                                           axis_out_1,
+                                                           axis_out_2,
+                                                           output,
+                                                           output_err2,
+                                                           frac_area,
+                                                           bin_count,
+                                                           bad_quad,
+                                                           message));
+
+    // report the lowest quadrilateral that failed, as the sequential
+    // version does
+    std::size_t first = chunks;
+    for (std::size_t c = 0; c < chunks; ++c)
+      {
+        if (bad_quad[c] != std::numeric_limits<std::size_t>::max()
+            && (first == chunks || bad_quad[c] < bad_quad[first]))
+          {
+            first = c;
+          }
+      }
+    if (first != chunks)
+      {
+        throw std::invalid_argument(message[first]);
+      }
+
+    return Nessi::EMPTY_WARN;
+  }
 } // AxisManip
 
 #endif // _REBIN_2D_QUAD_TO_RECTLIN_HPP
@@ -61,4 +61,88 @@ namespace AxisManip
                         Nessi::Vector<double> & output,
                         Nessi::Vector<double> & output_err2,
                         void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.12 for
+   * blocks
+   *
+   * \ingroup rebin_axis_1D
+   */
+  template std::string
+  rebin_axis_1D<float>(const Nessi::Vector<float> & axis_in,
+                       const Nessi::SpectrumBlock<float> & input,
+                       const Nessi::Vector<float> & axis_out,
+                       Nessi::SpectrumBlock<float> & output,
+                       void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.12 for
+   * blocks with an execution policy
+   *
+   * \ingroup rebin_axis_1D
+   */
+  template std::string
+  rebin_axis_1D<float>(const Nessi::ExecutionPolicy & policy,
+                       const Nessi::Vector<float> & axis_in,
+                       const Nessi::SpectrumBlock<float> & input,
+                       const Nessi::Vector<float> & axis_out,
+                       Nessi::SpectrumBlock<float> & output,
+                       void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.12 for blocks
+   *
+   * \ingroup rebin_axis_1D
+   */
+  template std::string
+  rebin_axis_1D<double>(const Nessi::Vector<double> & axis_in,
+                        const Nessi::SpectrumBlock<double> & input,
+                        const Nessi::Vector<double> & axis_out,
+                        Nessi::SpectrumBlock<double> & output,
+                        void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.12 for blocks with an execution policy
+   *
+   * \ingroup rebin_axis_1D
+   */
+  template std::string
+  rebin_axis_1D<double>(const Nessi::ExecutionPolicy & policy,
+                        const Nessi::Vector<double> & axis_in,
+                        const Nessi::SpectrumBlock<double> & input,
+                        const Nessi::Vector<double> & axis_out,
+                        Nessi::SpectrumBlock<double> & output,
+                        void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.12 for
+   * views
+   *
+   * \ingroup rebin_axis_1D
+   */
+  template std::string
+  rebin_axis_1D<float>(const Nessi::Vector<float> & axis_in,
+                       const Nessi::VectorView<const float> & input,
+                       const Nessi::VectorView<const float> & input_err2,
+                       const Nessi::Vector<float> & axis_out,
+                       const Nessi::VectorView<float> & output,
+                       const Nessi::VectorView<float> & output_err2,
+                       void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.12 for views
+   *
+   * \ingroup rebin_axis_1D
+   */
+  template std::string
+  rebin_axis_1D<double>(const Nessi::Vector<double> & axis_in,
+                        const Nessi::VectorView<const double> & input,
+                        const Nessi::VectorView<const double> & input_err2,
+                        const Nessi::Vector<double> & axis_out,
+                        const Nessi::VectorView<double> & output,
+                        const Nessi::VectorView<double> & output_err2,
+                        void *temp);
 } // AxisManip
@@ -31,6 +31,7 @@
 #define _REBIN_AXIS_1D_HPP 1
 
 #include "nessi_warn.hpp"
+#include "rebin_plan_1D.hpp"
 #include "rebinning.hpp"
 #include "size_checks.hpp"
 #include <stdexcept>
@@ -40,44 +41,38 @@ namespace AxisManip
   /// String for holding the rebin_axis_1D function name
   const std::string ra1_func_str = "AxisManip::rebin_axis_1D";
 
-  // 3.12
-  template <typename NumT>
-  std::string
-  rebin_axis_1D(const Nessi::Vector<NumT> & axis_in,
-                const Nessi::Vector<NumT> & input,
-                const Nessi::Vector<NumT> & input_err2,
-                const Nessi::Vector<NumT> & axis_out,
-                Nessi::Vector<NumT> & output,
-                Nessi::Vector<NumT> & output_err2,
-                void *temp=NULL)
+  /**
+   * \ingroup rebin_axis_1D
+   *
+   * This is a PRIVATE helper function for rebin_axis_1D that rebins one
+   * spectrum. The data arrays are pointers or Nessi::VectorView objects.
+   * The rebinned portions are added to the output, which is not reset.
+   *
+   * \param axis_in (INPUT) is the initial data axis (nold + 1 elements)
+   * \param input (INPUT) is the data associated with the initial axis
+   * \param input_err2 (INPUT) is the square of the uncertainty associated
+   * with the data
+   * \param nold (INPUT) is the number of bins of the initial axis
+   * \param axis_out (INPUT) is the target axis (nnew + 1 elements)
+   * \param output (OUTPUT) is the rebinned data
+   * \param output_err2 (OUTPUT) is the square of the uncertainty associated
+   * with the rebinned data
+   * \param nnew (INPUT) is the number of bins of the target axis
+   */
+  template <typename NumT, typename InArrayT, typename OutArrayT>
+  void
+  __rebin_axis_1D(const NumT * axis_in,
+                  const InArrayT & input,
+                  const InArrayT & input_err2,
+                  const size_t nold,
+                  const NumT * axis_out,
+                  const OutArrayT & output,
+                  const OutArrayT & output_err2,
+                  const size_t nnew)
   {
-    // check that the original histogram is of the proper size
-    try
-      {
-        Utils::check_histo_sizes(input, input_err2, axis_in);
-      }
-    catch(std::invalid_argument &e)
-      {
-        throw std::invalid_argument(ra1_func_str+": original histogram "
-                                    +e.what());
-      }
-    // check that the rebinned histogram is of the proper size
-    try
-      {
-        Utils::check_histo_sizes(output, output_err2, axis_out);
-      }
-    catch(std::invalid_argument &e)
-      {
-        throw std::invalid_argument(ra1_func_str+": rebinned histogram "
-                                    +e.what());
-      }
-
     size_t iold = 0;
     size_t inew = 0;
 
-    size_t nold = input.size();
-    size_t nnew = output.size();
-
     // Traverse both sets of bin edges, and if there is an overlap, add the
     // portion of the overlapping old bin to the new bin.
     while (inew < nnew && iold < nold)
@@ -117,6 +112,132 @@ namespace AxisManip
               }
           }
       }
+  }
+
+  // 3.12
+  template <typename NumT>
+  std::string
+  rebin_axis_1D(const Nessi::Vector<NumT> & axis_in,
+                const Nessi::Vector<NumT> & input,
+                const Nessi::Vector<NumT> & input_err2,
+                const Nessi::Vector<NumT> & axis_out,
+                Nessi::Vector<NumT> & output,
+                Nessi::Vector<NumT> & output_err2,
+                void *temp=NULL)
+  {
+    // check that the original histogram is of the proper size
+    try
+      {
+        Utils::check_histo_sizes(input, input_err2, axis_in);
+      }
+    catch(std::invalid_argument &e)
+      {
+        throw std::invalid_argument(ra1_func_str+": original histogram "
+                                    +e.what());
+      }
+    // check that the rebinned histogram is of the proper size
+    try
+      {
+        Utils::check_histo_sizes(output, output_err2, axis_out);
+      }
+    catch(std::invalid_argument &e)
+      {
+        throw std::invalid_argument(ra1_func_str+": rebinned histogram "
+                                    +e.what());
+      }
+
+    if (!output.empty() && !input.empty())
+      {
+        __rebin_axis_1D(&axis_in[0], &input[0], &input_err2[0],
+                        input.size(), &axis_out[0], &output[0],
+                        &output_err2[0], output.size());
+      }
+
+    return Nessi::EMPTY_WARN;
+  }
+
+  // 3.12
+  template <typename NumT>
+  std::string
+  rebin_axis_1D(const Nessi::ExecutionPolicy & policy,
+                const Nessi::Vector<NumT> & axis_in,
+                const Nessi::SpectrumBlock<NumT> & input,
+                const Nessi::Vector<NumT> & axis_out,
+                Nessi::SpectrumBlock<NumT> & output,
+                void *temp=NULL)
+  {
+    // check that the original histograms are of the proper size
+    if (axis_in.size() != input.num_bins() + 1)
+      {
+        throw std::invalid_argument(ra1_func_str+" (b): original histogram "
+                                    +"axis not one more than the number of "
+                                    +"bins");
+      }
+    // check that the rebinned histograms are of the proper size
+    if (axis_out.size() != output.num_bins() + 1)
+      {
+        throw std::invalid_argument(ra1_func_str+" (b): rebinned histogram "
+                                    +"axis not one more than the number of "
+                                    +"bins");
+      }
+    // check that both blocks hold the same pixels
+    if (input.num_spectra() != output.num_spectra())
+      {
+        throw std::invalid_argument(ra1_func_str+" (b): blocks do not have "
+                                    +"the same number of spectra");
+      }
+
+    // the overlaps are found once and applied to every spectrum
+    RebinPlan1D<NumT> plan(axis_in, axis_out);
+    return plan.apply(policy, input, output, temp);
+  }
+
+  // 3.12
+  template <typename NumT>
+  std::string
+  rebin_axis_1D(const Nessi::Vector<NumT> & axis_in,
+                const Nessi::SpectrumBlock<NumT> & input,
+                const Nessi::Vector<NumT> & axis_out,
+                Nessi::SpectrumBlock<NumT> & output,
+                void *temp=NULL)
+  {
+    return rebin_axis_1D(Nessi::execution::seq, axis_in, input, axis_out,
+                         output, temp);
+  }
+
+  // 3.12
+  template <typename NumT>
+  std::string
+  rebin_axis_1D(const Nessi::Vector<NumT> & axis_in,
+                const Nessi::VectorView<const NumT> & input,
+                const Nessi::VectorView<const NumT> & input_err2,
+                const Nessi::Vector<NumT> & axis_out,
+                const Nessi::VectorView<NumT> & output,
+                const Nessi::VectorView<NumT> & output_err2,
+                void *temp=NULL)
+  {
+    // check that the original histogram is of the proper size
+    if (input.size() != input_err2.size()
+        || axis_in.size() != input.size() + 1)
+      {
+        throw std::invalid_argument(ra1_func_str+" (view): original "
+                                    +"histogram views not consistent with "
+                                    +"the axis");
+      }
+    // check that the rebinned histogram is of the proper size
+    if (output.size() != output_err2.size()
+        || axis_out.size() != output.size() + 1)
+      {
+        throw std::invalid_argument(ra1_func_str+" (view): rebinned "
+                                    +"histogram views not consistent with "
+                                    +"the axis");
+      }
+
+    if (!output.empty() && !input.empty())
+      {
+        __rebin_axis_1D(&axis_in[0], input, input_err2, input.size(),
+                        &axis_out[0], output, output_err2, output.size());
+      }
 
     return Nessi::EMPTY_WARN;
   }
@@ -65,4 +65,102 @@ namespace AxisManip
                         Nessi::Vector<double> & output,
                         Nessi::Vector<double> & output_err2,
                         void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.13 with an
+   * execution policy.
+   *
+   * \ingroup rebin_axis_2D
+   */
+  template std::string
+  rebin_axis_2D<float>(const Nessi::ExecutionPolicy & policy,
+                       const Nessi::Vector<float> & axis_in_1,
+                       const Nessi::Vector<float> & axis_in_2,
+                       const Nessi::Vector<float> & input,
+                       const Nessi::Vector<float> & input_err2,
+                       const Nessi::Vector<float> & axis_out_1,
+                       const Nessi::Vector<float> & axis_out_2,
+                       Nessi::Vector<float> & output,
+                       Nessi::Vector<float> & output_err2,
+                       void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.13 with an execution policy.
+   *
+   * \ingroup rebin_axis_2D
+   */
+  template std::string
+  rebin_axis_2D<double>(const Nessi::ExecutionPolicy & policy,
+                        const Nessi::Vector<double> & axis_in_1,
+                        const Nessi::Vector<double> & axis_in_2,
+                        const Nessi::Vector<double> & input,
+                        const Nessi::Vector<double> & input_err2,
+                        const Nessi::Vector<double> & axis_out_1,
+                        const Nessi::Vector<double> & axis_out_2,
+                        Nessi::Vector<double> & output,
+                        Nessi::Vector<double> & output_err2,
+                        void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.13 with
+   * rebinning plans.
+   *
+   * \ingroup rebin_axis_2D
+   */
+  template std::string
+  rebin_axis_2D<float>(const RebinPlan1D<float> & plan_1,
+                       const RebinPlan1D<float> & plan_2,
+                       const Nessi::Vector<float> & input,
+                       const Nessi::Vector<float> & input_err2,
+                       Nessi::Vector<float> & output,
+                       Nessi::Vector<float> & output_err2,
+                       void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.13 with rebinning plans.
+   *
+   * \ingroup rebin_axis_2D
+   */
+  template std::string
+  rebin_axis_2D<double>(const RebinPlan1D<double> & plan_1,
+                        const RebinPlan1D<double> & plan_2,
+                        const Nessi::Vector<double> & input,
+                        const Nessi::Vector<double> & input_err2,
+                        Nessi::Vector<double> & output,
+                        Nessi::Vector<double> & output_err2,
+                        void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.13 with
+   * rebinning plans and an execution policy.
+   *
+   * \ingroup rebin_axis_2D
+   */
+  template std::string
+  rebin_axis_2D<float>(const Nessi::ExecutionPolicy & policy,
+                       const RebinPlan1D<float> & plan_1,
+                       const RebinPlan1D<float> & plan_2,
+                       const Nessi::Vector<float> & input,
+                       const Nessi::Vector<float> & input_err2,
+                       Nessi::Vector<float> & output,
+                       Nessi::Vector<float> & output_err2,
+                       void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.13 with rebinning plans and an execution policy.
+   *
+   * \ingroup rebin_axis_2D
+   */
+  template std::string
+  rebin_axis_2D<double>(const Nessi::ExecutionPolicy & policy,
+                        const RebinPlan1D<double> & plan_1,
+                        const RebinPlan1D<double> & plan_2,
+                        const Nessi::Vector<double> & input,
+                        const Nessi::Vector<double> & input_err2,
+                        Nessi::Vector<double> & output,
+                        Nessi::Vector<double> & output_err2,
+                        void *temp);
 } // AxisManip
@@ -30,9 +30,13 @@
 #ifndef _REBIN_AXIS_2D_HPP
 #define _REBIN_AXIS_2D_HPP 1
 
+#include "nessi_exec.hpp"
 #include "nessi_warn.hpp"
+#include "nessi_workspace.hpp"
+#include "rebin_plan_1D.hpp"
 #include "rebinning.hpp"
 #include "size_checks.hpp"
+#include <algorithm>
 #include <stdexcept>
 
 namespace AxisManip
@@ -40,6 +44,147 @@ namespace AxisManip
   /// String for holding the rebin_axis_1D function name
   const std::string ra2_func_str = "AxisManip::rebin_axis_2D";
 
+  /// Side of the square tiles of the transpose in rebin_axis_2D
+  const std::size_t REBIN_2D_TILE = 32;
+
+  /**
+   * \ingroup rebin_axis_2D
+   *
+   * This is a PRIVATE function object for rebin_axis_2D that rebins the
+   * rows [begin, end) of a row-major array with a RebinPlan1D. The rows of
+   * the output are reset before they are rebinned.
+   */
+  template <typename NumT>
+  class __RebinAxis2DRows
+  {
+  public:
+    /// Constructor keeping the plan and the arrays
+    __RebinAxis2DRows(const RebinPlan1D<NumT> & plan,
+                      const NumT * input,
+                      const NumT * input_err2,
+                      NumT * output,
+                      NumT * output_err2)
+      : plan_(plan), input_(input), input_err2_(input_err2),
+        output_(output), output_err2_(output_err2)
+    { }
+
+    /// Rebins the rows [begin, end)
+    void operator()(const std::size_t, const std::size_t begin,
+                    const std::size_t end) const
+    {
+      std::size_t nold = plan_.num_bins_in();
+      std::size_t nnew = plan_.num_bins_out();
+      std::fill(output_ + begin * nnew, output_ + end * nnew,
+                static_cast<NumT>(0));
+      std::fill(output_err2_ + begin * nnew, output_err2_ + end * nnew,
+                static_cast<NumT>(0));
+      for (std::size_t i = begin; i < end; ++i)
+        {
+          plan_.apply_spectrum(input_ + i * nold, input_err2_ + i * nold,
+                               output_ + i * nnew, output_err2_ + i * nnew,
+                               NULL);
+        }
+    }
+
+  private:
+    /// The plan rebinning a row
+    const RebinPlan1D<NumT> & plan_;
+    /// The rows to rebin
+    const NumT * input_;
+    /// The square of the uncertainty of the rows to rebin
+    const NumT * input_err2_;
+    /// The rebinned rows
+    NumT * output_;
+    /// The square of the uncertainty of the rebinned rows
+    NumT * output_err2_;
+  };
+
+  /**
+   * \ingroup rebin_axis_2D
+   *
+   * This is a PRIVATE function object for rebin_axis_2D that transposes
+   * the columns of a row-major array falling in the tiles [begin, end) of
+   * REBIN_2D_TILE columns. The tiles are square, so both the reads and the
+   * writes of a tile stay within a few cache lines per row.
+   */
+  template <typename NumT>
+  class __Transpose2DTiles
+  {
+  public:
+    /// Constructor keeping the arrays and their shape
+    __Transpose2DTiles(const NumT * input,
+                       const NumT * input_err2,
+                       const std::size_t num_rows,
+                       const std::size_t num_cols,
+                       NumT * output,
+                       NumT * output_err2)
+      : input_(input), input_err2_(input_err2), num_rows_(num_rows),
+        num_cols_(num_cols), output_(output), output_err2_(output_err2)
+    { }
+
+    /// Transposes the tiles of columns [begin, end)
+    void operator()(const std::size_t, const std::size_t begin,
+                    const std::size_t end) const
+    {
+      std::size_t col_end = std::min(end * REBIN_2D_TILE, num_cols_);
+      for (std::size_t j0 = begin * REBIN_2D_TILE; j0 < col_end;
+           j0 += REBIN_2D_TILE)
+        {
+          std::size_t j1 = std::min(j0 + REBIN_2D_TILE, col_end);
+          for (std::size_t i0 = 0; i0 < num_rows_; i0 += REBIN_2D_TILE)
+            {
+              std::size_t i1 = std::min(i0 + REBIN_2D_TILE, num_rows_);
+              for (std::size_t j = j0; j < j1; ++j)
+                {
+                  for (std::size_t i = i0; i < i1; ++i)
+                    {
+                      output_[j * num_rows_ + i] = input_[i * num_cols_ + j];
+                      output_err2_[j * num_rows_ + i] =
+                        input_err2_[i * num_cols_ + j];
+                    }
+                }
+            }
+        }
+    }
+
+  private:
+    /// The array to transpose
+    const NumT * input_;
+    /// The square of the uncertainty of the array to transpose
+    const NumT * input_err2_;
+    /// Number of rows of the input
+    std::size_t num_rows_;
+    /// Number of columns of the input
+    std::size_t num_cols_;
+    /// The transposed array
+    NumT * output_;
+    /// The square of the uncertainty of the transposed array
+    NumT * output_err2_;
+  };
+
+  /**
+   * \ingroup rebin_axis_2D
+   *
+   * This is a PRIVATE helper function for rebin_axis_2D that transposes a
+   * row-major array of \p num_rows rows and \p num_cols columns.
+   */
+  template <typename NumT>
+  void
+  __transpose_2D(const Nessi::ExecutionPolicy & policy,
+                 const NumT * input,
+                 const NumT * input_err2,
+                 const std::size_t num_rows,
+                 const std::size_t num_cols,
+                 NumT * output,
+                 NumT * output_err2)
+  {
+    std::size_t num_tiles = (num_cols + REBIN_2D_TILE - 1) / REBIN_2D_TILE;
+    Nessi::for_each_chunk(policy, num_tiles,
+                          __Transpose2DTiles<NumT>(input, input_err2,
+                                                   num_rows, num_cols,
+                                                   output, output_err2));
+  }
+
   // 3.13
   template <typename NumT>
   std::string
@@ -52,6 +197,25 @@ namespace AxisManip
                 Nessi::Vector<NumT> & output,
                 Nessi::Vector<NumT> & output_err2,
                 void *temp=NULL)
+  {
+    return rebin_axis_2D(Nessi::execution::seq, axis_in_1, axis_in_2, input,
+                         input_err2, axis_out_1, axis_out_2, output,
+                         output_err2, temp);
+  }
+
+  // 3.13
+  template <typename NumT>
+  std::string
+  rebin_axis_2D(const Nessi::ExecutionPolicy & policy,
+                const Nessi::Vector<NumT> & axis_in_1,
+                const Nessi::Vector<NumT> & axis_in_2,
+                const Nessi::Vector<NumT> & input,
+                const Nessi::Vector<NumT> & input_err2,
+                const Nessi::Vector<NumT> & axis_out_1,
+                const Nessi::Vector<NumT> & axis_out_2,
+                Nessi::Vector<NumT> & output,
+                Nessi::Vector<NumT> & output_err2,
+                void *temp=NULL)
   {
     // check that the original histogram is of the proper size
     try
@@ -74,127 +238,101 @@ namespace AxisManip
                                     +e.what());
       }
 
-    std::string retstr(Nessi::EMPTY_WARN);
-
-    size_t nold_input1 = axis_in_1.size() - 1;
-    size_t nold_input2 = axis_in_2.size() - 1;
-    size_t nnew_input1 = axis_out_1.size() - 1;
-    size_t nnew_input2 = axis_out_2.size() - 1;
-
-    // Create space for series of rebinned 2nd axes
-    Nessi::Vector<NumT> stage1;
-    stage1.reserve(nnew_input2 * nold_input1);
+    // the overlaps of every axis are found once, not once per row
+    RebinPlan1D<NumT> plan_1(axis_in_1, axis_out_1);
+    RebinPlan1D<NumT> plan_2(axis_in_2, axis_out_2);
+    return rebin_axis_2D(policy, plan_1, plan_2, input, input_err2, output,
+                         output_err2, temp);
+  }
 
-    Nessi::Vector<NumT> stage1_err2;
-    stage1_err2.reserve(nnew_input2 * nold_input1);
+  // 3.13
+  template <typename NumT>
+  std::string
+  rebin_axis_2D(const RebinPlan1D<NumT> & plan_1,
+                const RebinPlan1D<NumT> & plan_2,
+                const Nessi::Vector<NumT> & input,
+                const Nessi::Vector<NumT> & input_err2,
+                Nessi::Vector<NumT> & output,
+                Nessi::Vector<NumT> & output_err2,
+                void *temp=NULL)
+  {
+    return rebin_axis_2D(Nessi::execution::seq, plan_1, plan_2, input,
+                         input_err2, output, output_err2, temp);
+  }
 
-    for(size_t i = 0; i < nold_input1; ++i)
+  // 3.13
+  template <typename NumT>
+  std::string
+  rebin_axis_2D(const Nessi::ExecutionPolicy & policy,
+                const RebinPlan1D<NumT> & plan_1,
+                const RebinPlan1D<NumT> & plan_2,
+                const Nessi::Vector<NumT> & input,
+                const Nessi::Vector<NumT> & input_err2,
+                Nessi::Vector<NumT> & output,
+                Nessi::Vector<NumT> & output_err2,
+                void *temp=NULL)
+  {
+    // the plans must reproduce rebin_axis_1D
+    if (plan_1.mode() != RebinPlan1D<NumT>::REBIN_AXIS_1D
+        || plan_2.mode() != RebinPlan1D<NumT>::REBIN_AXIS_1D)
       {
-        // Create space and fill a 2nd axis for data and err2 for both
-        // input and output
-
-        Nessi::Vector<NumT> tmp_in;
-        tmp_in.reserve(nold_input2);
-        tmp_in.insert(tmp_in.begin(), input.begin()+(i * nold_input2),
-                      input.begin()+((i+1) * nold_input2));
-
-        Nessi::Vector<NumT> tmp_in_err2;
-        tmp_in_err2.reserve(nold_input2);
-        tmp_in_err2.insert(tmp_in_err2.begin(),
-                           input_err2.begin()+(i * nold_input2),
-                           input_err2.begin()+((i+1) * nold_input2));
-
-        Nessi::Vector<NumT> tmp_out(nnew_input2);
-        Nessi::Vector<NumT> tmp_out_err2(nnew_input2);
-
-        try
-          {
-            retstr += rebin_axis_1D(axis_in_2, tmp_in, tmp_in_err2, axis_out_2,
-                                    tmp_out, tmp_out_err2);
-          }
-        catch(std::invalid_argument &e)
-          {
-            throw std::invalid_argument(ra2_func_str+" rebin axis 2: "
-                                        +e.what());
-          }
-
-        // Fill returned information into temporary storage
-
-        stage1.insert(stage1.begin()+(i*nnew_input2), tmp_out.begin(),
-                      tmp_out.end());
-
-        stage1_err2.insert(stage1_err2.begin()+(i*nnew_input2),
-                           tmp_out_err2.begin(),
-                           tmp_out_err2.end());
-
+        throw std::invalid_argument(ra2_func_str+" (p): plans do not "
+                                    +"reproduce rebin_axis_1D");
       }
 
-    typename Nessi::Vector<NumT>::iterator iter;
-    typename Nessi::Vector<NumT>::iterator iter_err2;
+    size_t nold_input1 = plan_1.num_bins_in();
+    size_t nold_input2 = plan_2.num_bins_in();
+    size_t nnew_input1 = plan_1.num_bins_out();
+    size_t nnew_input2 = plan_2.num_bins_out();
 
-    typename Nessi::Vector<NumT>::iterator t_iter;
-    typename Nessi::Vector<NumT>::iterator t_iter_err2;
-
-    for(size_t j = 0; j < nnew_input2; ++j)
+    // check that the histograms are the sizes of the axes of the plans
+    if (input.size() != nold_input1 * nold_input2
+        || input_err2.size() != input.size())
       {
-        Nessi::Vector<NumT> tmp_in(nold_input1);
-        tmp_in.reserve(nold_input1);
-
-        Nessi::Vector<NumT> tmp_in_err2(nold_input1);
-        tmp_in_err2.reserve(nold_input1);
-
-        iter = stage1.begin()+j;
-        iter_err2 = stage1_err2.begin()+j;
-
-        t_iter = tmp_in.begin();
-        t_iter_err2 = tmp_in_err2.begin();
-
-        while(iter < stage1.end() && iter_err2 < stage1_err2.end())
-          {
-            *t_iter = *iter;
-            *t_iter_err2 = *iter_err2;
-
-            advance(iter, nnew_input2);
-            advance(iter_err2, nnew_input2);
-
-            ++t_iter;
-            ++t_iter_err2;
-          }
-
-        Nessi::Vector<NumT> tmp_out(nnew_input1);
-        Nessi::Vector<NumT> tmp_out_err2(nnew_input1);
-
-        try
-          {
-            retstr += rebin_axis_1D(axis_in_1, tmp_in, tmp_in_err2, axis_out_1,
-                                    tmp_out, tmp_out_err2);
-          }
-        catch(std::invalid_argument &e)
-          {
-            throw std::invalid_argument(ra2_func_str+" rebin axis 1: "
-                                        +e.what());
-          }
-
-        iter = output.begin()+j;
-        iter_err2 = output_err2.begin()+j;
-
-        t_iter = tmp_out.begin();
-        t_iter_err2 = tmp_out_err2.begin();
-
-        while(iter < output.end() && iter_err2 < output_err2.end())
-          {
-            *iter = *t_iter;
-            *iter_err2 = *t_iter_err2;
-
-            advance(iter, nnew_input2);
-            advance(iter_err2, nnew_input2);
+        throw std::invalid_argument(ra2_func_str+" (p): original histogram "
+                                    +"not the size of the initial axes");
+      }
+    if (output.size() != nnew_input1 * nnew_input2
+        || output_err2.size() != output.size())
+      {
+        throw std::invalid_argument(ra2_func_str+" (p): rebinned histogram "
+                                    +"not the size of the target axes");
+      }
 
-            ++t_iter;
-            ++t_iter_err2;
-          }
+    // an empty input has no counts to rebin into the output
+    if (output.empty() || input.empty())
+      {
+        std::fill(output.begin(), output.end(), static_cast<NumT>(0));
+        std::fill(output_err2.begin(), output_err2.end(),
+                  static_cast<NumT>(0));
+        return Nessi::EMPTY_WARN;
       }
 
-    return retstr;
+    // The rows are rebinned along the 2nd axis into stage, transposed into
+    // stage_t, rebinned along the 1st axis back into stage and transposed
+    // into the output, so both rebinning passes read contiguous rows.
+    size_t stage_rows = std::max(nold_input1, nnew_input1);
+    Nessi::Scratch<NumT> stage(temp, stage_rows * nnew_input2);
+    Nessi::Scratch<NumT> stage_err2(temp, stage_rows * nnew_input2);
+    Nessi::Scratch<NumT> stage_t(temp, nnew_input2 * nold_input1);
+    Nessi::Scratch<NumT> stage_t_err2(temp, nnew_input2 * nold_input1);
+
+    Nessi::for_each_chunk(policy, nold_input1,
+                          __RebinAxis2DRows<NumT>(plan_2, &input[0],
+                                                  &input_err2[0],
+                                                  stage.data(),
+                                                  stage_err2.data()));
+    __transpose_2D(policy, stage.data(), stage_err2.data(), nold_input1,
+                   nnew_input2, stage_t.data(), stage_t_err2.data());
+    Nessi::for_each_chunk(policy, nnew_input2,
+                          __RebinAxis2DRows<NumT>(plan_1, stage_t.data(),
+                                                  stage_t_err2.data(),
+                                                  stage.data(),
+                                                  stage_err2.data()));
+    __transpose_2D(policy, stage.data(), stage_err2.data(), nnew_input2,
+                   nnew_input1, &output[0], &output_err2[0]);
+
+    return Nessi::EMPTY_WARN;
   }
 } // AxisManip
 
@@ -73,4 +73,46 @@ namespace AxisManip
                         Nessi::Vector<double> & output,
                         Nessi::Vector<double> & output_err2,
                         void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.14 for a
+   * sparse output.
+   *
+   * \ingroup rebin_axis_4D
+   */
+  template std::string
+  rebin_axis_4D<float>(const Nessi::ExecutionPolicy & policy,
+                       const Nessi::Vector<float> & axis_in_1,
+                       const Nessi::Vector<float> & axis_in_2,
+                       const Nessi::Vector<float> & axis_in_3,
+                       const Nessi::Vector<float> & axis_in_4,
+                       const Nessi::Vector<float> & input,
+                       const Nessi::Vector<float> & input_err2,
+                       const Nessi::Vector<float> & axis_out_1,
+                       const Nessi::Vector<float> & axis_out_2,
+                       const Nessi::Vector<float> & axis_out_3,
+                       const Nessi::Vector<float> & axis_out_4,
+                       Nessi::SparseHistogram4D<float> & output,
+                       void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.14 for a sparse output.
+   *
+   * \ingroup rebin_axis_4D
+   */
+  template std::string
+  rebin_axis_4D<double>(const Nessi::ExecutionPolicy & policy,
+                        const Nessi::Vector<double> & axis_in_1,
+                        const Nessi::Vector<double> & axis_in_2,
+                        const Nessi::Vector<double> & axis_in_3,
+                        const Nessi::Vector<double> & axis_in_4,
+                        const Nessi::Vector<double> & input,
+                        const Nessi::Vector<double> & input_err2,
+                        const Nessi::Vector<double> & axis_out_1,
+                        const Nessi::Vector<double> & axis_out_2,
+                        const Nessi::Vector<double> & axis_out_3,
+                        const Nessi::Vector<double> & axis_out_4,
+                        Nessi::SparseHistogram4D<double> & output,
+                        void *temp);
 } // AxisManip
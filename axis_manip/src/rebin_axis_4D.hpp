@@ -30,11 +30,333 @@
 #ifndef _REBIN_AXIS_4D_HPP
 #define _REBIN_AXIS_4D_HPP 1
 
+#include "nessi_warn.hpp"
 #include "rebinning.hpp"
+#include <algorithm>
+#include <new>
 #include <stdexcept>
+#include <vector>
 
 namespace AxisManip
 {
+  /// String for holding the rebin_axis_4D function name
+  const std::string ra4_func_str = "AxisManip::rebin_axis_4D";
+
+  /**
+   * \ingroup rebin_axis_4D
+   *
+   * This is a PRIVATE helper holding the fractional overlaps of every bin
+   * of an initial axis with the bins of a target axis. The overlaps of
+   * initial bin \f$i\f$ are [offset[i], offset[i + 1]) and their target
+   * bins increase. They are found by the same traversal and with the same
+   * operations as in rebin_axis_1D().
+   */
+  template <typename NumT>
+  struct __AxisOverlaps
+  {
+    /// Constructor finding the overlaps of the two axes
+    __AxisOverlaps(const Nessi::Vector<NumT> & axis_in,
+                   const Nessi::Vector<NumT> & axis_out)
+      : offset(axis_in.size())
+    {
+      std::size_t nold = axis_in.size() - 1;
+      std::size_t nnew = axis_out.size() - 1;
+      std::size_t iold = 0;
+      std::size_t inew = 0;
+
+      while (inew < nnew && iold < nold)
+        {
+          const NumT axis_in_lo = axis_in[iold];
+          const NumT axis_in_hi = axis_in[iold + 1];
+          const NumT axis_out_lo = axis_out[inew];
+          const NumT axis_out_hi = axis_out[inew + 1];
+
+          if (axis_out_hi <= axis_in_lo)
+            {
+              inew++;
+            }
+          else if (axis_in_hi <= axis_out_lo)
+            {
+              iold++;
+            }
+          else
+            {
+              // delta is the overlap of the bins on the axis
+              const NumT delta = std::min(axis_in_hi, axis_out_hi) -
+                std::max(axis_in_lo, axis_out_lo);
+              const NumT width = axis_in_hi - axis_in_lo;
+
+              index.push_back(inew);
+              weight.push_back(delta / width);
+              offset[iold + 1] = index.size();
+              if (axis_out_hi > axis_in_hi)
+                {
+                  iold++;
+                }
+              else
+                {
+                  inew++;
+                }
+            }
+        }
+
+      // bins without overlap end where the previous one ended
+      for (std::size_t i = 0; i < nold; ++i)
+        {
+          offset[i + 1] = std::max(offset[i + 1], offset[i]);
+        }
+    }
+
+    /// First overlap of every initial bin, one more than the bins
+    Nessi::Vector<std::size_t> offset;
+    /// Target bin of every overlap
+    Nessi::Vector<std::size_t> index;
+    /// Fraction of the initial bin in the target bin
+    Nessi::Vector<NumT> weight;
+  };
+
+  /**
+   * \ingroup rebin_axis_4D
+   *
+   * This is a PRIVATE helper function for rebin_axis_4D that returns the
+   * number of bins given by four histogram axes.
+   *
+   * \exception std::invalid_argument is thrown if an axis is empty
+   */
+  template <typename NumT>
+  std::size_t
+  __num_bins_4D(const Nessi::Vector<NumT> & axis_1,
+                const Nessi::Vector<NumT> & axis_2,
+                const Nessi::Vector<NumT> & axis_3,
+                const Nessi::Vector<NumT> & axis_4)
+  {
+    if (axis_1.empty() || axis_2.empty() || axis_3.empty() || axis_4.empty())
+      {
+        throw std::invalid_argument(ra4_func_str+": empty axis");
+      }
+    return (axis_1.size() - 1) * (axis_2.size() - 1) * (axis_3.size() - 1)
+      * (axis_4.size() - 1);
+  }
+
+  /**
+   * \ingroup rebin_axis_4D
+   *
+   * This is a PRIVATE helper function for rebin_axis_4D that checks the
+   * sizes of the original histogram.
+   */
+  template <typename NumT>
+  void
+  __check_rebin_axis_4D_input(const Nessi::Vector<NumT> & axis_in_1,
+                              const Nessi::Vector<NumT> & axis_in_2,
+                              const Nessi::Vector<NumT> & axis_in_3,
+                              const Nessi::Vector<NumT> & axis_in_4,
+                              const Nessi::Vector<NumT> & input,
+                              const Nessi::Vector<NumT> & input_err2)
+  {
+    std::size_t num_bins = __num_bins_4D(axis_in_1, axis_in_2, axis_in_3,
+                                         axis_in_4);
+    if (input.size() != num_bins || input_err2.size() != num_bins)
+      {
+        throw std::invalid_argument(ra4_func_str+": original histogram not "
+                                    +"the size given by the axes");
+      }
+  }
+
+  /**
+   * \ingroup rebin_axis_4D
+   *
+   * This is a PRIVATE accumulator for __rebin_axis_4D() that adds to dense
+   * arrays.
+   */
+  template <typename NumT>
+  class __Dense4DAccumulator
+  {
+  public:
+    /// Constructor keeping the arrays and the number of target bins
+    __Dense4DAccumulator(Nessi::Vector<NumT> & output,
+                         Nessi::Vector<NumT> & output_err2,
+                         const std::size_t num_bins_2,
+                         const std::size_t num_bins_3,
+                         const std::size_t num_bins_4)
+      : output_(output), output_err2_(output_err2),
+        num_bins_2_(num_bins_2), num_bins_3_(num_bins_3),
+        num_bins_4_(num_bins_4)
+    { }
+
+    /// Adds to target bin (a, b, c, d)
+    void operator()(const std::size_t a, const std::size_t b,
+                    const std::size_t c, const std::size_t d,
+                    const NumT value, const NumT err2)
+    {
+      std::size_t index = ((a * num_bins_2_ + b) * num_bins_3_ + c)
+        * num_bins_4_ + d;
+      output_[index] += value;
+      output_err2_[index] += err2;
+    }
+
+  private:
+    /// The rebinned data
+    Nessi::Vector<NumT> & output_;
+    /// The square of the uncertainty of the rebinned data
+    Nessi::Vector<NumT> & output_err2_;
+    /// Number of bins of the 2nd target axis
+    std::size_t num_bins_2_;
+    /// Number of bins of the 3rd target axis
+    std::size_t num_bins_3_;
+    /// Number of bins of the 4th target axis
+    std::size_t num_bins_4_;
+  };
+
+  /**
+   * \ingroup rebin_axis_4D
+   *
+   * This is a PRIVATE accumulator for __rebin_axis_4D() that adds to a
+   * Nessi::SparseHistogram4D.
+   */
+  template <typename NumT>
+  class __Sparse4DAccumulator
+  {
+  public:
+    /// Constructor keeping the histogram
+    explicit __Sparse4DAccumulator(Nessi::SparseHistogram4D<NumT> & output)
+      : output_(output)
+    { }
+
+    /// Adds to target bin (a, b, c, d)
+    void operator()(const std::size_t a, const std::size_t b,
+                    const std::size_t c, const std::size_t d,
+                    const NumT value, const NumT err2)
+    {
+      output_.add(a, b, c, d, value, err2);
+    }
+
+  private:
+    /// The rebinned histogram
+    Nessi::SparseHistogram4D<NumT> & output_;
+  };
+
+  /**
+   * \ingroup rebin_axis_4D
+   *
+   * This is a PRIVATE helper function for rebin_axis_4D that passes the
+   * contribution of every initial bin to the target bins with a 1st index
+   * in [row_begin, row_end) to \p accum as accum(a, b, c, d, value, err2).
+   * The initial bins are visited in the order of the input, so every
+   * target bin receives its contributions in that order. The sizes are not
+   * checked.
+   *
+   * \param overlaps (INPUT) are the overlaps along the four axes
+   * \param input (INPUT) is the data associated with the initial axes
+   * \param input_err2 (INPUT) is the square of the uncertainty of the data
+   * \param row_begin (INPUT) is the first target bin along the 1st axis
+   * \param row_end (INPUT) is one past the last target bin along the 1st
+   * axis
+   * \param accum (OUTPUT) receives the contributions
+   */
+  template <typename NumT, typename AccumT>
+  void
+  __rebin_axis_4D(const std::vector<__AxisOverlaps<NumT> > & overlaps,
+                  const Nessi::Vector<NumT> & input,
+                  const Nessi::Vector<NumT> & input_err2,
+                  const std::size_t row_begin,
+                  const std::size_t row_end,
+                  AccumT & accum)
+  {
+    const __AxisOverlaps<NumT> & ov1 = overlaps[0];
+    const __AxisOverlaps<NumT> & ov2 = overlaps[1];
+    const __AxisOverlaps<NumT> & ov3 = overlaps[2];
+    const __AxisOverlaps<NumT> & ov4 = overlaps[3];
+
+    std::size_t nold_1 = ov1.offset.size() - 1;
+    std::size_t nold_2 = ov2.offset.size() - 1;
+    std::size_t nold_3 = ov3.offset.size() - 1;
+    std::size_t nold_4 = ov4.offset.size() - 1;
+
+    for (std::size_t i = 0; i < nold_1; ++i)
+      {
+        // keep the overlaps of the requested rows
+        std::size_t e1_begin = ov1.offset[i];
+        std::size_t e1_end = ov1.offset[i + 1];
+        while (e1_begin < e1_end && ov1.index[e1_begin] < row_begin)
+          {
+            ++e1_begin;
+          }
+        while (e1_end > e1_begin && ov1.index[e1_end - 1] >= row_end)
+          {
+            --e1_end;
+          }
+        if (e1_begin == e1_end)
+          {
+            continue;
+          }
+
+        std::size_t p = i * nold_2 * nold_3 * nold_4;
+        for (std::size_t j = 0; j < nold_2; ++j)
+          {
+            for (std::size_t k = 0; k < nold_3; ++k)
+              {
+                for (std::size_t l = 0; l < nold_4; ++l, ++p)
+                  {
+                    const NumT value = input[p];
+                    const NumT err2 = input_err2[p];
+                    if (value == static_cast<NumT>(0)
+                        && err2 == static_cast<NumT>(0))
+                      {
+                        continue;
+                      }
+
+                    for (std::size_t e1 = e1_begin; e1 < e1_end; ++e1)
+                      {
+                        for (std::size_t e2 = ov2.offset[j];
+                             e2 < ov2.offset[j + 1]; ++e2)
+                          {
+                            const NumT w12 = ov1.weight[e1] * ov2.weight[e2];
+                            for (std::size_t e3 = ov3.offset[k];
+                                 e3 < ov3.offset[k + 1]; ++e3)
+                              {
+                                const NumT w123 = w12 * ov3.weight[e3];
+                                for (std::size_t e4 = ov4.offset[l];
+                                     e4 < ov4.offset[l + 1]; ++e4)
+                                  {
+                                    const NumT w = w123 * ov4.weight[e4];
+                                    accum(ov1.index[e1], ov2.index[e2],
+                                          ov3.index[e3], ov4.index[e4],
+                                          value * w, err2 * w * w);
+                                  }
+                              }
+                          }
+                      }
+                  }
+              }
+          }
+      }
+  }
+
+  /**
+   * \ingroup rebin_axis_4D
+   *
+   * This is a PRIVATE helper function for rebin_axis_4D that returns the
+   * overlaps along the four axes.
+   */
+  template <typename NumT>
+  std::vector<__AxisOverlaps<NumT> >
+  __rebin_axis_4D_overlaps(const Nessi::Vector<NumT> & axis_in_1,
+                           const Nessi::Vector<NumT> & axis_in_2,
+                           const Nessi::Vector<NumT> & axis_in_3,
+                           const Nessi::Vector<NumT> & axis_in_4,
+                           const Nessi::Vector<NumT> & axis_out_1,
+                           const Nessi::Vector<NumT> & axis_out_2,
+                           const Nessi::Vector<NumT> & axis_out_3,
+                           const Nessi::Vector<NumT> & axis_out_4)
+  {
+    std::vector<__AxisOverlaps<NumT> > overlaps;
+    overlaps.push_back(__AxisOverlaps<NumT>(axis_in_1, axis_out_1));
+    overlaps.push_back(__AxisOverlaps<NumT>(axis_in_2, axis_out_2));
+    overlaps.push_back(__AxisOverlaps<NumT>(axis_in_3, axis_out_3));
+    overlaps.push_back(__AxisOverlaps<NumT>(axis_in_4, axis_out_4));
+    return overlaps;
+  }
+
   // 3.14
   template <typename NumT>
   std::string
@@ -52,7 +374,157 @@ namespace AxisManip
                 Nessi::Vector<NumT> & output_err2,
                 void *temp=NULL)
   {
-    throw std::runtime_error("Function [rebin_axis_4D] not implemented");
+    // check that the original histogram is of the proper size
+    __check_rebin_axis_4D_input(axis_in_1, axis_in_2, axis_in_3, axis_in_4,
+                                input, input_err2);
+    // check that the rebinned histogram is of the proper size
+    std::size_t num_bins = __num_bins_4D(axis_out_1, axis_out_2, axis_out_3,
+                                         axis_out_4);
+    if (output.size() != num_bins || output_err2.size() != num_bins)
+      {
+        throw std::invalid_argument(ra4_func_str+": rebinned histogram not "
+                                    +"the size given by the axes");
+      }
+
+    // Rebinned values are added to the output, so it starts from zero
+    std::fill(output.begin(), output.end(), static_cast<NumT>(0));
+    std::fill(output_err2.begin(), output_err2.end(), static_cast<NumT>(0));
+
+    __Dense4DAccumulator<NumT> accum(output, output_err2,
+                                     axis_out_2.size() - 1,
+                                     axis_out_3.size() - 1,
+                                     axis_out_4.size() - 1);
+    __rebin_axis_4D(__rebin_axis_4D_overlaps(axis_in_1, axis_in_2,
+                                             axis_in_3, axis_in_4,
+                                             axis_out_1, axis_out_2,
+                                             axis_out_3, axis_out_4),
+                    input, input_err2, 0, axis_out_1.size() - 1, accum);
+
+    return Nessi::EMPTY_WARN;
+  }
+
+  /**
+   * \ingroup rebin_axis_4D
+   *
+   * This is a PRIVATE function object for the parallel rebin_axis_4D that
+   * fills the slabs of bricks [begin, end) along the 1st target axis into
+   * the histogram of \p chunk. Adding to the histogram allocates its
+   * bricks, and an allocation failure is recorded for the chunk instead of
+   * leaving the parallel loop.
+   */
+  template <typename NumT>
+  class __RebinAxis4DSlabs
+  {
+  public:
+    /// Constructor keeping the arguments of rebin_axis_4D
+    __RebinAxis4DSlabs(const std::vector<__AxisOverlaps<NumT> > & overlaps,
+                       const Nessi::Vector<NumT> & input,
+                       const Nessi::Vector<NumT> & input_err2,
+                       const std::size_t num_bins_1,
+                       std::vector<Nessi::SparseHistogram4D<NumT> > & part,
+                       std::vector<char> & failed)
+      : overlaps_(overlaps), input_(input), input_err2_(input_err2),
+        num_bins_1_(num_bins_1), part_(part), failed_(failed)
+    { }
+
+    /// Fills the slabs [begin, end) into the histogram of \p chunk
+    void operator()(const std::size_t chunk, const std::size_t begin,
+                    const std::size_t end) const
+    {
+      std::size_t brick_size = part_[chunk].brick_size();
+      __Sparse4DAccumulator<NumT> accum(part_[chunk]);
+      try
+        {
+          __rebin_axis_4D(overlaps_, input_, input_err2_, begin * brick_size,
+                          std::min(end * brick_size, num_bins_1_), accum);
+        }
+      catch (std::bad_alloc &)
+        {
+          failed_[chunk] = 1;
+        }
+    }
+
+  private:
+    /// The overlaps along the four axes
+    const std::vector<__AxisOverlaps<NumT> > & overlaps_;
+    /// The data associated with the initial axes
+    const Nessi::Vector<NumT> & input_;
+    /// The square of the uncertainty of the data
+    const Nessi::Vector<NumT> & input_err2_;
+    /// Number of bins of the 1st target axis
+    std::size_t num_bins_1_;
+    /// The histogram of every chunk
+    std::vector<Nessi::SparseHistogram4D<NumT> > & part_;
+    /// Non-zero for every chunk that ran out of memory
+    std::vector<char> & failed_;
+  };
+
+  // 3.14
+  template <typename NumT>
+  std::string
+  rebin_axis_4D(const Nessi::ExecutionPolicy & policy,
+                const Nessi::Vector<NumT> & axis_in_1,
+                const Nessi::Vector<NumT> & axis_in_2,
+                const Nessi::Vector<NumT> & axis_in_3,
+                const Nessi::Vector<NumT> & axis_in_4,
+                const Nessi::Vector<NumT> & input,
+                const Nessi::Vector<NumT> & input_err2,
+                const Nessi::Vector<NumT> & axis_out_1,
+                const Nessi::Vector<NumT> & axis_out_2,
+                const Nessi::Vector<NumT> & axis_out_3,
+                const Nessi::Vector<NumT> & axis_out_4,
+                Nessi::SparseHistogram4D<NumT> & output,
+                void *temp=NULL)
+  {
+    // check that the original histogram is of the proper size
+    __check_rebin_axis_4D_input(axis_in_1, axis_in_2, axis_in_3, axis_in_4,
+                                input, input_err2);
+    // check that the rebinned histogram is of the proper shape
+    __num_bins_4D(axis_out_1, axis_out_2, axis_out_3, axis_out_4);
+    if (output.num_bins(0) != axis_out_1.size() - 1
+        || output.num_bins(1) != axis_out_2.size() - 1
+        || output.num_bins(2) != axis_out_3.size() - 1
+        || output.num_bins(3) != axis_out_4.size() - 1)
+      {
+        throw std::invalid_argument(ra4_func_str+": rebinned histogram not "
+                                    +"the shape given by the axes");
+      }
+
+    output.clear();
+    std::vector<__AxisOverlaps<NumT> > overlaps =
+      __rebin_axis_4D_overlaps(axis_in_1, axis_in_2, axis_in_3, axis_in_4,
+                               axis_out_1, axis_out_2, axis_out_3,
+                               axis_out_4);
+
+    // the chunks are slabs of whole bricks, so they never share a brick
+    std::size_t num_bins_1 = output.num_bins(0);
+    std::size_t num_slabs = (num_bins_1 + output.brick_size() - 1)
+      / output.brick_size();
+    std::size_t chunks = Nessi::num_chunks(policy, num_slabs);
+    if (chunks <= 1)
+      {
+        __Sparse4DAccumulator<NumT> accum(output);
+        __rebin_axis_4D(overlaps, input, input_err2, 0, num_bins_1, accum);
+        return Nessi::EMPTY_WARN;
+      }
+
+    std::vector<Nessi::SparseHistogram4D<NumT> > part(chunks, output);
+    std::vector<char> failed(chunks, 0);
+    Nessi::for_each_chunk(policy, num_slabs,
+                          __RebinAxis4DSlabs<NumT>(overlaps, input,
+                                                   input_err2, num_bins_1,
+                                                   part, failed));
+    // the allocation failure of a chunk is thrown outside the parallel loop
+    if (std::find(failed.begin(), failed.end(), 1) != failed.end())
+      {
+        throw std::bad_alloc();
+      }
+    for (std::size_t c = 0; c < chunks; ++c)
+      {
+        output.merge(part[c]);
+      }
+
+    return Nessi::EMPTY_WARN;
   }
 } // AxisManip
 
@@ -30,6 +30,7 @@
 #ifndef _REBIN_DIAGONAL_HPP
 #define _REBIN_DIAGONAL_HPP 1
 
+#include "nessi_exec.hpp"
 #include "nessi_warn.hpp"
 #include "rebinning.hpp"
 #include "size_checks.hpp"
@@ -37,12 +38,273 @@
 #include <algorithm>
 #include <limits>
 #include <stdexcept>
+#include <vector>
 
 namespace AxisManip
 {
   /// String for holding the rebin_diagonal function name
   const std::string rd_func_str = "AxisManip::rebin_diagonal";
 
+  /**
+   * \ingroup rebin_diagonal
+   *
+   * This is a PRIVATE helper for rebin_diagonal that finds the position of
+   * values in the edges of a target axis, like std::upper_bound() and
+   * std::lower_bound(). On an irregular axis the search starts from the
+   * previous result, so the values of a monotonic sequence are found in
+   * constant time on average. Linear and logarithmic axes compute the
+   * position directly.
+   */
+  template <typename NumT>
+  class __EdgeCursor
+  {
+  public:
+    /// Constructor for a cursor on the first edge
+    explicit __EdgeCursor(const Utils::AxisDescriptor<NumT> & grid)
+      : grid_(grid), pos_(0)
+    { }
+
+    /// Returns the index of the first edge greater than \p value
+    std::size_t upper_bound(const NumT value)
+    {
+      pos_ = grid_.upper_bound(value, pos_);
+      return pos_;
+    }
+
+    /// Returns the index of the first edge not less than \p value
+    std::size_t lower_bound(const NumT value)
+    {
+      pos_ = grid_.lower_bound(value, pos_);
+      return pos_;
+    }
+
+  private:
+    /// The target axis
+    const Utils::AxisDescriptor<NumT> & grid_;
+    /// Result of the previous search
+    std::size_t pos_;
+  };
+
+  /**
+   * \ingroup rebin_diagonal
+   *
+   * This is a PRIVATE helper function for rebin_diagonal that finds the
+   * target bins overlapped by initial bin \p k. The rows are
+   * [patch[0], patch[1]) and the columns [patch[2], patch[3]). The cursors
+   * search the lower and upper edges of the 1st axis and of the 2nd axis,
+   * in that order.
+   *
+   * \return false if the initial bin is outside of the target axes
+   */
+  template <typename NumT>
+  bool
+  __rebin_diagonal_patch(const Nessi::Vector<NumT> & axis_in_1,
+                         const Nessi::Vector<NumT> & axis_in_2,
+                         const Nessi::Vector<NumT> & axis_out_1,
+                         const Nessi::Vector<NumT> & axis_out_2,
+                         const std::size_t k,
+                         std::vector<__EdgeCursor<NumT> > & cursor,
+                         std::size_t * patch)
+  {
+    std::size_t length_axis_out_1 = axis_out_1.size() - 1;
+    std::size_t length_axis_out_2 = axis_out_2.size() - 1;
+
+    NumT x_orig_lo = axis_in_1[k];
+    NumT x_orig_hi = axis_in_1[k+1];
+    NumT y_orig_lo = axis_in_2[k];
+    NumT y_orig_hi = axis_in_2[k+1];
+
+    // Check to see if the original bin boundaries are outside the
+    // rebinned axes boundaries
+    bool check1 = (x_orig_lo < axis_out_1[0] &&
+                   x_orig_hi < axis_out_1[0]);
+    bool check2 = (x_orig_lo > axis_out_1[length_axis_out_1] &&
+                   x_orig_hi > axis_out_1[length_axis_out_1]);
+    bool check3 = (y_orig_lo < axis_out_2[0] &&
+                   y_orig_hi < axis_out_2[0]);
+    bool check4 = (y_orig_lo > axis_out_2[length_axis_out_2] &&
+                   y_orig_hi > axis_out_2[length_axis_out_2]);
+
+    if(check1 || check2 || check3 || check4)
+      {
+        return false;
+      }
+
+    // The first target bin starts at the last edge not greater than the
+    // lower original edge and the last one ends at the first edge not
+    // less than the upper original edge
+    patch[0] = Utils::__fix_index(cursor[0].upper_bound(x_orig_lo) - 1,
+                                  length_axis_out_1);
+    patch[1] = Utils::__fix_index(cursor[1].lower_bound(x_orig_hi),
+                                  length_axis_out_1);
+    patch[2] = Utils::__fix_index(cursor[2].upper_bound(y_orig_lo) - 1,
+                                  length_axis_out_2);
+    patch[3] = Utils::__fix_index(cursor[3].lower_bound(y_orig_hi),
+                                  length_axis_out_2);
+
+    return true;
+  }
+
+  /**
+   * \ingroup rebin_diagonal
+   *
+   * This is a PRIVATE helper function for rebin_diagonal that returns the
+   * four cursors used by __rebin_diagonal_patch().
+   */
+  template <typename NumT>
+  std::vector<__EdgeCursor<NumT> >
+  __rebin_diagonal_cursors(const Utils::AxisDescriptor<NumT> & grid_1,
+                           const Utils::AxisDescriptor<NumT> & grid_2)
+  {
+    std::vector<__EdgeCursor<NumT> > cursor;
+    cursor.push_back(__EdgeCursor<NumT>(grid_1));
+    cursor.push_back(__EdgeCursor<NumT>(grid_1));
+    cursor.push_back(__EdgeCursor<NumT>(grid_2));
+    cursor.push_back(__EdgeCursor<NumT>(grid_2));
+    return cursor;
+  }
+
+  /**
+   * \ingroup rebin_diagonal
+   *
+   * This is a PRIVATE helper function for rebin_diagonal that adds every
+   * initial bin to the rows [row_begin, row_end) of the rebinned
+   * histogram, the target axes being given by their descriptors. The
+   * initial bins are added in order, so every target bin receives its
+   * contributions in the same order whatever the range of rows. The sizes
+   * are not checked.
+   */
+  template <typename NumT>
+  void
+  __rebin_diagonal(const Nessi::Vector<NumT> & axis_in_1,
+                   const Nessi::Vector<NumT> & axis_in_2,
+                   const Nessi::Vector<NumT> & input,
+                   const Nessi::Vector<NumT> & input_err2,
+                   const Utils::AxisDescriptor<NumT> & grid_1,
+                   const Utils::AxisDescriptor<NumT> & grid_2,
+                   const std::size_t row_begin,
+                   const std::size_t row_end,
+                   Nessi::Vector<NumT> & output,
+                   Nessi::Vector<NumT> & output_err2)
+  {
+    const Nessi::Vector<NumT> & axis_out_1 = grid_1.axis();
+    const Nessi::Vector<NumT> & axis_out_2 = grid_2.axis();
+    std::size_t num_cols = axis_out_2.size() - 1;
+    std::vector<__EdgeCursor<NumT> > cursor =
+      __rebin_diagonal_cursors(grid_1, grid_2);
+    std::size_t patch[4];
+
+    std::size_t input_size = input.size();
+    for(std::size_t k = 0; k < input_size; ++k)
+      {
+        if(!__rebin_diagonal_patch(axis_in_1, axis_in_2, axis_out_1,
+                                   axis_out_2, k, cursor, patch))
+          {
+            continue;
+          }
+
+        // only the rows of this range are written
+        std::size_t i_begin = std::max(patch[0], row_begin);
+        std::size_t i_end = std::min(patch[1], row_end);
+        if(i_begin >= i_end)
+          {
+            continue;
+          }
+
+        NumT x_orig_lo = axis_in_1[k];
+        NumT x_orig_hi = axis_in_1[k+1];
+        NumT y_orig_lo = axis_in_2[k];
+        NumT y_orig_hi = axis_in_2[k+1];
+
+        NumT dx_orig = x_orig_hi - x_orig_lo;
+        NumT dy_orig = y_orig_hi - y_orig_lo;
+
+        NumT width = dx_orig * dy_orig;
+
+        // Actually do the rebinning
+        for(std::size_t i = i_begin; i < i_end; ++i)
+          {
+            NumT x_rebin_lo = axis_out_1[i];
+            NumT x_rebin_hi = axis_out_1[i+1];
+
+            NumT delta_x = std::min(x_orig_hi, x_rebin_hi) -
+              std::max(x_orig_lo, x_rebin_lo);
+
+            for(std::size_t j = patch[2]; j < patch[3]; ++j)
+              {
+                NumT y_rebin_lo = axis_out_2[j];
+                NumT y_rebin_hi = axis_out_2[j+1];
+
+                NumT delta_y = std::min(y_orig_hi, y_rebin_hi) -
+                  std::max(y_orig_lo, y_rebin_lo);
+
+                NumT delta = delta_x * delta_y;
+
+                NumT portion = delta / width;
+
+                std::size_t channel = j + i * num_cols;
+
+                output[channel] += input[k] * portion;
+                output_err2[channel] += input_err2[k] * portion * portion;
+              }
+          }
+      }
+  }
+
+  /**
+   * \ingroup rebin_diagonal
+   *
+   * This is a PRIVATE function object for the parallel rebin_diagonal that
+   * rebins all initial bins into the rows [begin, end) of the first target
+   * axis. The rows of a chunk are a contiguous part of the rebinned arrays
+   * that no other chunk writes, and every target bin receives the initial
+   * bins in order, as in the sequential version.
+   */
+  template <typename NumT>
+  class __RebinDiagonalRows
+  {
+  public:
+    /// Constructor keeping the arguments of rebin_diagonal
+    __RebinDiagonalRows(const Nessi::Vector<NumT> & axis_in_1,
+                        const Nessi::Vector<NumT> & axis_in_2,
+                        const Nessi::Vector<NumT> & input,
+                        const Nessi::Vector<NumT> & input_err2,
+                        const Utils::AxisDescriptor<NumT> & grid_1,
+                        const Utils::AxisDescriptor<NumT> & grid_2,
+                        Nessi::Vector<NumT> & output,
+                        Nessi::Vector<NumT> & output_err2)
+      : axis_in_1_(axis_in_1), axis_in_2_(axis_in_2), input_(input),
+        input_err2_(input_err2), grid_1_(grid_1), grid_2_(grid_2),
+        output_(output), output_err2_(output_err2)
+    { }
+
+    /// Rebins into the rows [begin, end)
+    void operator()(const std::size_t, const std::size_t begin,
+                    const std::size_t end) const
+    {
+      __rebin_diagonal(axis_in_1_, axis_in_2_, input_, input_err2_, grid_1_,
+                       grid_2_, begin, end, output_, output_err2_);
+    }
+
+  private:
+    /// The 1st initial data axis
+    const Nessi::Vector<NumT> & axis_in_1_;
+    /// The 2nd initial data axis
+    const Nessi::Vector<NumT> & axis_in_2_;
+    /// The data associated with the initial axes
+    const Nessi::Vector<NumT> & input_;
+    /// The square of the uncertainty of the data
+    const Nessi::Vector<NumT> & input_err2_;
+    /// The descriptor of the 1st target axis
+    const Utils::AxisDescriptor<NumT> & grid_1_;
+    /// The descriptor of the 2nd target axis
+    const Utils::AxisDescriptor<NumT> & grid_2_;
+    /// The rebinned data
+    Nessi::Vector<NumT> & output_;
+    /// The square of the uncertainty of the rebinned data
+    Nessi::Vector<NumT> & output_err2_;
+  };
+
   // 3.53
   template <typename NumT>
   std::string
@@ -55,6 +317,25 @@ namespace AxisManip
                  Nessi::Vector<NumT> & output,
                  Nessi::Vector<NumT> & output_err2,
                  void *temp=NULL)
+  {
+    return rebin_diagonal(Nessi::execution::seq, axis_in_1, axis_in_2,
+                          input, input_err2, axis_out_1, axis_out_2, output,
+                          output_err2, temp);
+  }
+
+  // 3.53
+  template <typename NumT>
+  std::string
+  rebin_diagonal(const Nessi::ExecutionPolicy & policy,
+                 const Nessi::Vector<NumT> & axis_in_1,
+                 const Nessi::Vector<NumT> & axis_in_2,
+                 const Nessi::Vector<NumT> & input,
+                 const Nessi::Vector<NumT> & input_err2,
+                 const Nessi::Vector<NumT> & axis_out_1,
+                 const Nessi::Vector<NumT> & axis_out_2,
+                 Nessi::Vector<NumT> & output,
+                 Nessi::Vector<NumT> & output_err2,
+                 void *temp=NULL)
   {
     // check that the original histogram is of the proper size
     try
@@ -89,119 +370,22 @@ namespace AxisManip
 
     std::string retstr(Nessi::EMPTY_WARN);
 
-    std::size_t input_size = input.size();
-
-    std::vector<std::size_t> length_axis_out;
-    length_axis_out.push_back(axis_out_1.size() - 1);
-    length_axis_out.push_back(axis_out_2.size() - 1);
-
-    for(std::size_t k = 0; k < input_size; ++k)
+    if (output.empty() || input.empty())
       {
-        // Get the bin boundaries in out of the original axes
-        NumT x_orig_lo = axis_in_1[k];
-        NumT x_orig_hi = axis_in_1[k+1];
-        NumT y_orig_lo = axis_in_2[k];
-        NumT y_orig_hi = axis_in_2[k+1];
-
-        NumT dx_orig = x_orig_hi - x_orig_lo;
-        NumT dy_orig = y_orig_hi - y_orig_lo;
-
-        NumT width = dx_orig * dy_orig;
-
-        // Check to see if the original bin boundaries are outside the 
-        // rebinned axes boundaries
-        bool check1 = (x_orig_lo < axis_out_1[0] && 
-                       x_orig_hi < axis_out_1[0]);
-        bool check2 = (x_orig_lo > axis_out_1[length_axis_out[0]] && 
-                       x_orig_hi > axis_out_1[length_axis_out[0]]);
-        bool check3 = (y_orig_lo < axis_out_2[0] && 
-                       y_orig_hi < axis_out_2[0]);
-        bool check4 = (y_orig_lo > axis_out_2[length_axis_out[1]] && 
-                       y_orig_hi > axis_out_2[length_axis_out[1]]);
-
-        if(check1 || check2 || check3 || check4)
-          {
-            continue;
-          }
-        
-        std::pair<typename Nessi::Vector<NumT>::const_iterator, 
-          typename Nessi::Vector<NumT>::const_iterator> range1;
-        std::pair<typename Nessi::Vector<NumT>::const_iterator, 
-          typename Nessi::Vector<NumT>::const_iterator> range2;
-        std::pair<typename Nessi::Vector<NumT>::const_iterator, 
-          typename Nessi::Vector<NumT>::const_iterator> range3;
-        std::pair<typename Nessi::Vector<NumT>::const_iterator, 
-          typename Nessi::Vector<NumT>::const_iterator> range4;
-
-        // Find the bin boundary indicies in the rebinned axes that correspond 
-        // to the location of the original bin boundaries
-        range1 = std::equal_range(axis_out_1.begin(), axis_out_1.end(), 
-                                  x_orig_lo);
-        range2 = std::equal_range(axis_out_1.begin(), axis_out_1.end(), 
-                                  x_orig_hi);
-        range3 = std::equal_range(axis_out_2.begin(), axis_out_2.end(), 
-                                  y_orig_lo);
-        range4 = std::equal_range(axis_out_2.begin(), axis_out_2.end(), 
-                                  y_orig_hi);
-
-        std::size_t index1 = range1.second - axis_out_1.begin();
-        std::size_t index2 = range2.second - axis_out_1.begin();
-        std::size_t index3 = range3.second - axis_out_2.begin();
-        std::size_t index4 = range4.second - axis_out_2.begin();
-        std::size_t index5 = range1.first - axis_out_1.begin();
-        std::size_t index6 = range2.first - axis_out_1.begin();
-        std::size_t index7 = range3.first - axis_out_2.begin();
-        std::size_t index8 = range4.first - axis_out_2.begin();
-        
-        // Determine the range of indices to rebin over
-        std::size_t index_x_left = Utils::__fix_index(std::max(index1,
-                                                               index5) - 1, 
-                                                      length_axis_out[0]);
-        std::size_t index_x_right = Utils::__fix_index(std::min(index2, 
-                                                                index6),
-                                                       length_axis_out[0]);
-        std::size_t index_y_left = Utils::__fix_index(std::max(index3, 
-                                                               index7) - 1,
-                                                      length_axis_out[1]);
-        std::size_t index_y_right = Utils::__fix_index(std::min(index4, 
-                                                                index8),
-                                                       length_axis_out[1]);
-        
-        if(index_x_left == std::numeric_limits<std::size_t>::max() || 
-           index_y_left == std::numeric_limits<std::size_t>::max())
-          {
-            continue;
-          }
-
-        // Actually do the rebinning
-        for(std::size_t i = index_x_left; i < index_x_right; ++i)
-          {
-            NumT x_rebin_lo = axis_out_1[i];
-            NumT x_rebin_hi = axis_out_1[i+1];
-
-            NumT delta_x = std::min(x_orig_hi, x_rebin_hi) - 
-              std::max(x_orig_lo, x_rebin_lo);
-
-            for(std::size_t j = index_y_left; j < index_y_right; ++j)
-              {
-                NumT y_rebin_lo = axis_out_2[j];
-                NumT y_rebin_hi = axis_out_2[j+1];
-
-                NumT delta_y = std::min(y_orig_hi, y_rebin_hi) - 
-                  std::max(y_orig_lo, y_rebin_lo);
+        return retstr;
+      }
 
-                NumT delta = delta_x * delta_y;
-                
-                NumT portion = delta / width;
+    Utils::AxisDescriptor<NumT> grid_1(axis_out_1);
+    Utils::AxisDescriptor<NumT> grid_2(axis_out_2);
 
-                std::size_t channel = j + i * length_axis_out[1];
+    // Every chunk rebins all initial bins into its own rows of the target
+    // histogram, so the result does not depend on the number of chunks
+    Nessi::for_each_chunk(policy, axis_out_1.size() - 1,
+                          __RebinDiagonalRows<NumT>(axis_in_1, axis_in_2,
+                                                    input, input_err2,
+                                                    grid_1, grid_2, output,
+                                                    output_err2));
 
-                output[channel] += input[k] * portion;                
-                output_err2[channel] += input_err2[k] * portion * portion;
-              }
-          }
-      }
-    
     return retstr;
   }
 
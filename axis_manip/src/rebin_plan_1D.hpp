@@ -0,0 +1,345 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file axis_manip/src/rebin_plan_1D.hpp
+ */
+#ifndef _REBIN_PLAN_1D_HPP
+#define _REBIN_PLAN_1D_HPP 1
+
+#include "nessi_exec.hpp"
+#include "nessi_warn.hpp"
+#include "num_comparison.hpp"
+#include "rebinning.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace AxisManip
+{
+  /// String for holding the RebinPlan1D class name
+  const std::string rp1_func_str = "AxisManip::RebinPlan1D";
+
+  /**
+   * \ingroup rebin_plan_1D
+   *
+   * This is a PRIVATE function object for the block version of
+   * RebinPlan1D::apply() that rebins a range of spectra. The sizes must
+   * have been checked.
+   */
+  template <typename NumT>
+  class __RebinPlan1DBlock
+  {
+  public:
+    /// Constructor keeping the plan and the blocks
+    __RebinPlan1DBlock(const RebinPlan1D<NumT> & plan,
+                       const Nessi::SpectrumBlock<NumT> & input,
+                       Nessi::SpectrumBlock<NumT> & output)
+      : plan_(plan), input_(input), output_(output)
+    { }
+
+    /// Rebins the spectra [begin, end)
+    void operator()(const std::size_t, const std::size_t begin,
+                    const std::size_t end) const
+    {
+      for (std::size_t p = begin; p < end; ++p)
+        {
+          plan_.apply_spectrum(input_.value(p), input_.err2(p),
+                               output_.value(p), output_.err2(p), NULL);
+        }
+    }
+
+  private:
+    /// The plan to apply
+    const RebinPlan1D<NumT> & plan_;
+    /// The original spectra
+    const Nessi::SpectrumBlock<NumT> & input_;
+    /// The rebinned spectra
+    Nessi::SpectrumBlock<NumT> & output_;
+  };
+
+  template <typename NumT>
+  RebinPlan1D<NumT>::RebinPlan1D(const Nessi::Vector<NumT> & axis_in,
+                                 const Nessi::Vector<NumT> & axis_out,
+                                 const Mode mode)
+    : mode_(mode)
+  {
+    if (axis_in.empty() || axis_out.empty())
+      {
+        throw std::invalid_argument(rp1_func_str+": empty axis");
+      }
+
+    size_t nold = axis_in.size() - 1;
+    size_t nnew = axis_out.size() - 1;
+    num_bins_in_ = nold;
+    offset_.assign(nnew + 1, 0);
+
+    bool frac = (mode == REBIN_AXIS_1D_FRAC);
+    size_t iold = 0;
+    size_t inew = 0;
+
+    // The same walk as in rebin_axis_1D and rebin_axis_1D_frac, but the
+    // weights are stored instead of applied. The weights of a target bin
+    // are consecutive since inew never decreases.
+    while (inew < nnew && iold < nold)
+      {
+        const NumT axis_in_lo = axis_in[iold];
+        const NumT axis_in_hi = axis_in[iold + 1];
+        const NumT axis_out_lo = axis_out[inew];
+        const NumT axis_out_hi = axis_out[inew + 1];
+
+        bool out_below = frac ? Utils::compare(axis_out_hi, axis_in_lo) <= 0
+          : axis_out_hi <= axis_in_lo;
+        bool in_below = frac ? Utils::compare(axis_in_hi, axis_out_lo) <= 0
+          : axis_in_hi <= axis_out_lo;
+
+        if (out_below)
+          {
+            inew++;
+          }
+        else if (in_below)
+          {
+            iold++;
+          }
+        else
+          {
+            // delta is the overlap of the bins on the axis
+            const NumT delta = std::min(axis_in_hi, axis_out_hi) -
+              std::max(axis_in_lo, axis_out_lo);
+
+            index_.push_back(iold);
+            if (frac)
+              {
+                weight_.push_back(delta);
+              }
+            else
+              {
+                const NumT width = axis_in_hi - axis_in_lo;
+                weight_.push_back(delta / width);
+              }
+            offset_[inew + 1] = index_.size();
+
+            if (axis_out_hi > axis_in_hi)
+              {
+                iold++;
+              }
+            else
+              {
+                inew++;
+              }
+          }
+      }
+
+    // target bins without any weight end where the previous one ended
+    for (size_t k = 1; k <= nnew; ++k)
+      {
+        offset_[k] = std::max(offset_[k], offset_[k - 1]);
+      }
+  }
+
+  template <typename NumT>
+  typename RebinPlan1D<NumT>::Mode
+  RebinPlan1D<NumT>::mode() const
+  {
+    return mode_;
+  }
+
+  template <typename NumT>
+  std::size_t
+  RebinPlan1D<NumT>::num_bins_in() const
+  {
+    return num_bins_in_;
+  }
+
+  template <typename NumT>
+  std::size_t
+  RebinPlan1D<NumT>::num_bins_out() const
+  {
+    return offset_.size() - 1;
+  }
+
+  template <typename NumT>
+  std::size_t
+  RebinPlan1D<NumT>::num_weights() const
+  {
+    return weight_.size();
+  }
+
+  template <typename NumT>
+  void
+  RebinPlan1D<NumT>::apply_spectrum(const NumT * input,
+                                    const NumT * input_err2,
+                                    NumT * output,
+                                    NumT * output_err2,
+                                    NumT * frac_area) const
+  {
+    size_t nnew = this->num_bins_out();
+    bool frac = (mode_ == REBIN_AXIS_1D_FRAC);
+
+    for (size_t k = 0; k < nnew; ++k)
+      {
+        NumT value = output[k];
+        NumT value_err2 = output_err2[k];
+        NumT area = (frac_area != NULL) ? frac_area[k]
+          : static_cast<NumT>(0);
+
+        for (size_t e = offset_[k]; e < offset_[k + 1]; ++e)
+          {
+            const NumT in = input[index_[e]];
+            const NumT in_err2 = input_err2[index_[e]];
+            if (frac && (std::isnan(in) || std::isnan(in_err2)
+                         || std::isinf(in) || std::isinf(in_err2)))
+              {
+                continue;
+              }
+            const NumT w = weight_[e];
+            value += in * w;
+            value_err2 += in_err2 * w * w;
+            area += w;
+          }
+
+        output[k] = value;
+        output_err2[k] = value_err2;
+        if (frac_area != NULL)
+          {
+            frac_area[k] = area;
+          }
+      }
+  }
+
+  template <typename NumT>
+  void
+  RebinPlan1D<NumT>::check_sizes(const Nessi::Vector<NumT> & input,
+                                 const Nessi::Vector<NumT> & input_err2,
+                                 const Nessi::Vector<NumT> & output,
+                                 const Nessi::Vector<NumT> & output_err2)
+    const
+  {
+    // check that the arrays are the sizes of the axes of the plan
+    if (input.size() != num_bins_in_ || input_err2.size() != num_bins_in_)
+      {
+        throw std::invalid_argument(rp1_func_str+": original histogram not "
+                                    +"the size of the initial axis");
+      }
+    size_t nnew = this->num_bins_out();
+    if (output.size() != nnew || output_err2.size() != nnew)
+      {
+        throw std::invalid_argument(rp1_func_str+": rebinned histogram not "
+                                    +"the size of the target axis");
+      }
+  }
+
+  template <typename NumT>
+  std::string
+  RebinPlan1D<NumT>::apply(const Nessi::Vector<NumT> & input,
+                           const Nessi::Vector<NumT> & input_err2,
+                           Nessi::Vector<NumT> & output,
+                           Nessi::Vector<NumT> & output_err2,
+                           void *temp) const
+  {
+    this->check_sizes(input, input_err2, output, output_err2);
+
+    if (!output.empty() && !input.empty())
+      {
+        this->apply_spectrum(&input[0], &input_err2[0], &output[0],
+                             &output_err2[0], NULL);
+      }
+
+    return Nessi::EMPTY_WARN;
+  }
+
+  template <typename NumT>
+  std::string
+  RebinPlan1D<NumT>::apply(const Nessi::Vector<NumT> & input,
+                           const Nessi::Vector<NumT> & input_err2,
+                           Nessi::Vector<NumT> & output,
+                           Nessi::Vector<NumT> & output_err2,
+                           Nessi::Vector<NumT> & frac_area,
+                           void *temp) const
+  {
+    this->check_sizes(input, input_err2, output, output_err2);
+    if (frac_area.size() != output.size())
+      {
+        throw std::invalid_argument(rp1_func_str+": fractional area not "
+                                    +"the size of the target axis");
+      }
+
+    if (!output.empty() && !input.empty())
+      {
+        this->apply_spectrum(&input[0], &input_err2[0], &output[0],
+                             &output_err2[0], &frac_area[0]);
+      }
+
+    return Nessi::EMPTY_WARN;
+  }
+
+  template <typename NumT>
+  std::string
+  RebinPlan1D<NumT>::apply(const Nessi::SpectrumBlock<NumT> & input,
+                           Nessi::SpectrumBlock<NumT> & output,
+                           void *temp) const
+  {
+    return this->apply(Nessi::execution::seq, input, output, temp);
+  }
+
+  template <typename NumT>
+  std::string
+  RebinPlan1D<NumT>::apply(const Nessi::ExecutionPolicy & policy,
+                           const Nessi::SpectrumBlock<NumT> & input,
+                           Nessi::SpectrumBlock<NumT> & output,
+                           void *temp) const
+  {
+    // check that the blocks are the sizes of the axes of the plan
+    if (input.num_bins() != num_bins_in_)
+      {
+        throw std::invalid_argument(rp1_func_str+" (b): original block not "
+                                    +"the size of the initial axis");
+      }
+    if (output.num_bins() != this->num_bins_out())
+      {
+        throw std::invalid_argument(rp1_func_str+" (b): rebinned block not "
+                                    +"the size of the target axis");
+      }
+    if (input.num_spectra() != output.num_spectra())
+      {
+        throw std::invalid_argument(rp1_func_str+" (b): blocks not the "
+                                    +"same number of spectra");
+      }
+
+    if (num_bins_in_ == 0 || output.num_bins() == 0)
+      {
+        return Nessi::EMPTY_WARN;
+      }
+
+    Nessi::for_each_chunk(policy, output.num_spectra(),
+                          __RebinPlan1DBlock<NumT>(*this, input, output));
+
+    return Nessi::EMPTY_WARN;
+  }
+
+} // AxisManip
+
+#endif // _REBIN_PLAN_1D_HPP
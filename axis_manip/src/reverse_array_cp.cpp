@@ -75,4 +75,50 @@ namespace AxisManip
                                  Nessi::Vector<unsigned int> & output,
                                  void *temp);
 
+  /**
+   * This is the float declaration for the function defined in 3.11 for
+   * views.
+   *
+   * \ingroup reverse_array_cp
+   */
+  template std::string
+  reverse_array_cp<float>(const Nessi::VectorView<const float> & input,
+                          const Nessi::VectorView<float> & output,
+                          void *temp);
+
+  /**
+   * This is the double precision float declaration for the function
+   * defined in 3.11 for views.
+   *
+   * \ingroup reverse_array_cp
+   */
+  template std::string
+  reverse_array_cp<double>(const Nessi::VectorView<const double> & input,
+                           const Nessi::VectorView<double> & output,
+                           void *temp);
+
+  /**
+   * This is the integer declaration for the function defined in 3.11 for
+   * views.
+   *
+   * \ingroup reverse_array_cp
+   */
+  template std::string
+  reverse_array_cp<int>(const Nessi::VectorView<const int> & input,
+                        const Nessi::VectorView<int> & output,
+                        void *temp);
+
+  /**
+   * This is the unsigned integer declaration for the function defined
+   * in 3.11 for views.
+   *
+   * \ingroup reverse_array_cp
+   */
+  template std::string
+  reverse_array_cp<unsigned int>(const Nessi::VectorView<const unsigned int> &
+                                 input,
+                                 const Nessi::VectorView<unsigned int> &
+                                 output,
+                                 void *temp);
+
 } // AxisManip
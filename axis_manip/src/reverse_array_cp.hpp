@@ -33,9 +33,13 @@
 #include "nessi_warn.hpp"
 #include "reverse_array.hpp"
 #include <algorithm>
+#include <stdexcept>
 
 namespace AxisManip
 {
+  /// String for holding the reverse_array_cp function name
+  const std::string rac_func_str = "AxisManip::reverse_array_cp";
+
   // 3.11
   template <typename NumT>
   std::string
@@ -47,6 +51,29 @@ namespace AxisManip
 
     return Nessi::EMPTY_WARN;
   }
+
+  // 3.11
+  template <typename NumT>
+  std::string
+  reverse_array_cp(const Nessi::VectorView<const NumT> & input,
+                   const Nessi::VectorView<NumT> & output,
+                   void *temp=NULL)
+  {
+    // check that the views are of proper size
+    std::size_t size = input.size();
+    if (output.size() != size)
+      {
+        throw std::invalid_argument(rac_func_str+" (view): views not the "
+                                    +"same size");
+      }
+
+    for (std::size_t i = 0; i < size; ++i)
+      {
+        output[i] = input[size - 1 - i];
+      }
+
+    return Nessi::EMPTY_WARN;
+  }
 } // AxisManip
 
 #endif // _REVERSE_ARRAY_CP_HPP
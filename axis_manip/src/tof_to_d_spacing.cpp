@@ -0,0 +1,197 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file axis_manip/src/tof_to_d_spacing.cpp
+ */
+#include "tof_to_d_spacing.hpp"
+
+namespace AxisManip
+{
+  // explicit instantiations
+
+  /**
+   * This is the float declaration of the tof_to_d_spacing() function
+   *
+   * \ingroup tof_to_d_spacing
+   */
+  template std::string
+  tof_to_d_spacing<float>(const Nessi::Vector<float> & tof,
+                          const Nessi::Vector<float> & tof_err2,
+                          const float pathlength,
+                          const float pathlength_err2,
+                          const float polar_angle,
+                          const float polar_angle_err2,
+                          Nessi::Vector<float> & d_spacing,
+                          Nessi::Vector<float> & d_spacing_err2,
+                          void *temp);
+
+  /**
+   * This is the float declaration of the tof_to_d_spacing() function
+   *
+   * \ingroup tof_to_d_spacing
+   */
+  template std::string
+  tof_to_d_spacing<float>(const float tof,
+                          const float tof_err2,
+                          const float pathlength,
+                          const float pathlength_err2,
+                          const float polar_angle,
+                          const float polar_angle_err2,
+                          float & d_spacing,
+                          float & d_spacing_err2,
+                          void *temp);
+
+  /**
+   * This is the float declaration of the tof_to_d_spacing() function for
+   * blocks
+   *
+   * \ingroup tof_to_d_spacing
+   */
+  template std::string
+  tof_to_d_spacing<float>(const Nessi::SpectrumBlock<float> & tof,
+                          const Nessi::Vector<float> & pathlength,
+                          const Nessi::Vector<float> & pathlength_err2,
+                          const Nessi::Vector<float> & polar_angle,
+                          const Nessi::Vector<float> & polar_angle_err2,
+                          Nessi::SpectrumBlock<float> & d_spacing,
+                          void *temp);
+
+  /**
+   * This is the float declaration of the tof_to_d_spacing() function for
+   * blocks with an execution policy
+   *
+   * \ingroup tof_to_d_spacing
+   */
+  template std::string
+  tof_to_d_spacing<float>(const Nessi::ExecutionPolicy & policy,
+                          const Nessi::SpectrumBlock<float> & tof,
+                          const Nessi::Vector<float> & pathlength,
+                          const Nessi::Vector<float> & pathlength_err2,
+                          const Nessi::Vector<float> & polar_angle,
+                          const Nessi::Vector<float> & polar_angle_err2,
+                          Nessi::SpectrumBlock<float> & d_spacing,
+                          void *temp);
+
+  /**
+   * This is the double precision float declaration of the
+   * tof_to_d_spacing() function
+   *
+   * \ingroup tof_to_d_spacing
+   */
+  template std::string
+  tof_to_d_spacing<double>(const Nessi::Vector<double> & tof,
+                           const Nessi::Vector<double> & tof_err2,
+                           const double pathlength,
+                           const double pathlength_err2,
+                           const double polar_angle,
+                           const double polar_angle_err2,
+                           Nessi::Vector<double> & d_spacing,
+                           Nessi::Vector<double> & d_spacing_err2,
+                           void *temp);
+
+  /**
+   * This is the double precision float declaration of the
+   * tof_to_d_spacing() function
+   *
+   * \ingroup tof_to_d_spacing
+   */
+  template std::string
+  tof_to_d_spacing<double>(const double tof,
+                           const double tof_err2,
+                           const double pathlength,
+                           const double pathlength_err2,
+                           const double polar_angle,
+                           const double polar_angle_err2,
+                           double & d_spacing,
+                           double & d_spacing_err2,
+                           void *temp);
+
+  /**
+   * This is the double precision float declaration of the
+   * tof_to_d_spacing() function for blocks
+   *
+   * \ingroup tof_to_d_spacing
+   */
+  template std::string
+  tof_to_d_spacing<double>(const Nessi::SpectrumBlock<double> & tof,
+                           const Nessi::Vector<double> & pathlength,
+                           const Nessi::Vector<double> & pathlength_err2,
+                           const Nessi::Vector<double> & polar_angle,
+                           const Nessi::Vector<double> & polar_angle_err2,
+                           Nessi::SpectrumBlock<double> & d_spacing,
+                           void *temp);
+
+  /**
+   * This is the double precision float declaration of the
+   * tof_to_d_spacing() function for blocks with an execution policy
+   *
+   * \ingroup tof_to_d_spacing
+   */
+  template std::string
+  tof_to_d_spacing<double>(const Nessi::ExecutionPolicy & policy,
+                           const Nessi::SpectrumBlock<double> & tof,
+                           const Nessi::Vector<double> & pathlength,
+                           const Nessi::Vector<double> & pathlength_err2,
+                           const Nessi::Vector<double> & polar_angle,
+                           const Nessi::Vector<double> & polar_angle_err2,
+                           Nessi::SpectrumBlock<double> & d_spacing,
+                           void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.15 and 3.25
+   * for views
+   *
+   * \ingroup tof_to_d_spacing
+   */
+  template std::string
+  tof_to_d_spacing<float>(const Nessi::VectorView<const float> & tof,
+                          const Nessi::VectorView<const float> & tof_err2,
+                          const float pathlength,
+                          const float pathlength_err2,
+                          const float polar_angle,
+                          const float polar_angle_err2,
+                          const Nessi::VectorView<float> & d_spacing,
+                          const Nessi::VectorView<float> & d_spacing_err2,
+                          void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.15 and 3.25 for views
+   *
+   * \ingroup tof_to_d_spacing
+   */
+  template std::string
+  tof_to_d_spacing<double>(const Nessi::VectorView<const double> & tof,
+                           const Nessi::VectorView<const double> & tof_err2,
+                           const double pathlength,
+                           const double pathlength_err2,
+                           const double polar_angle,
+                           const double polar_angle_err2,
+                           const Nessi::VectorView<double> & d_spacing,
+                           const Nessi::VectorView<double> & d_spacing_err2,
+                           void *temp);
+} // AxisManip
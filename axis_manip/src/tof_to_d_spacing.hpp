@@ -0,0 +1,285 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file axis_manip/src/tof_to_d_spacing.hpp
+ */
+#ifndef _TOF_TO_D_SPACING_HPP
+#define _TOF_TO_D_SPACING_HPP 1
+
+#include "conversions.hpp"
+#include "map_kernel.hpp"
+#include "nessi_view.hpp"
+#include "nessi_warn.hpp"
+#include "nessi_workspace.hpp"
+#include "size_checks.hpp"
+#include "tof_to_wavelength.hpp"
+#include "wavelength_to_d_spacing.hpp"
+#include <stdexcept>
+
+namespace AxisManip
+{
+  /// String for holding the tof_to_d_spacing function name
+  const std::string ttds_func_str = "AxisManip::tof_to_d_spacing";
+
+  // 3.15 and 3.25
+  template <typename NumT>
+  std::string
+  tof_to_d_spacing(const Nessi::Vector<NumT> & tof,
+                   const Nessi::Vector<NumT> & tof_err2,
+                   const NumT pathlength,
+                   const NumT pathlength_err2,
+                   const NumT polar_angle,
+                   const NumT polar_angle_err2,
+                   Nessi::Vector<NumT> & d_spacing,
+                   Nessi::Vector<NumT> & d_spacing_err2,
+                   void *temp=NULL)
+  {
+    // check that the values are of proper size
+    try
+      {
+        Utils::check_sizes_square(tof, d_spacing);
+      }
+    catch(std::invalid_argument &e)
+      {
+        throw std::invalid_argument(ttds_func_str+" (v,v): data "+e.what());
+      }
+
+    // check that the uncertainties are of proper size
+    try
+      {
+        Utils::check_sizes_square(tof_err2, d_spacing_err2);
+      }
+    catch(std::invalid_argument &e)
+      {
+        throw std::invalid_argument(ttds_func_str+" (v,v): err2 "+e.what());
+      }
+
+    // check that the tof arrays are of proper size
+    try
+      {
+        Utils::check_sizes_square(tof, tof_err2);
+      }
+    catch(std::invalid_argument &e)
+      {
+        throw std::invalid_argument(ttds_func_str+" (v,v): tof "+e.what());
+      }
+
+    Nessi::DefaultWarningSink warnings;
+
+    // calculate the constants of the pixel
+    NumT a;
+    NumT a2;
+    NumT a_err2;
+    __tof_to_wavelength_prologue(Nessi::VectorView<const NumT>(&pathlength, 1),
+                                 Nessi::VectorView<const NumT>(
+                                                        &pathlength_err2, 1),
+                                 &a, &a2, &a_err2, warnings);
+
+    // the wavelength of a bin is converted without being stored
+    __TofToWavelengthKernel<NumT> to_wavelength(&a, &a2, &a_err2);
+    __WavelengthToDSpacingKernel<NumT>
+      to_d_spacing(Nessi::VectorView<const NumT>(&polar_angle, 1),
+                   Nessi::VectorView<const NumT>(&polar_angle_err2, 1));
+    warnings.report(__map_kernel(__compose(to_wavelength, to_d_spacing),
+                                 tof.begin(), tof_err2.begin(),
+                                 d_spacing.begin(), d_spacing_err2.begin(),
+                                 tof.size()));
+
+    return warnings.str();
+  }
+
+  // 3.15 and 3.25
+  template <typename NumT>
+  std::string
+  tof_to_d_spacing(const NumT tof,
+                   const NumT tof_err2,
+                   const NumT pathlength,
+                   const NumT pathlength_err2,
+                   const NumT polar_angle,
+                   const NumT polar_angle_err2,
+                   NumT & d_spacing,
+                   NumT & d_spacing_err2,
+                   void *temp=NULL)
+  {
+    Nessi::DefaultWarningSink warnings;
+
+    // calculate the constants of the pixel
+    NumT a;
+    NumT a2;
+    NumT a_err2;
+    __tof_to_wavelength_prologue(Nessi::VectorView<const NumT>(&pathlength, 1),
+                                 Nessi::VectorView<const NumT>(
+                                                        &pathlength_err2, 1),
+                                 &a, &a2, &a_err2, warnings);
+
+    // the wavelength of a bin is converted without being stored
+    __TofToWavelengthKernel<NumT> to_wavelength(&a, &a2, &a_err2);
+    __WavelengthToDSpacingKernel<NumT>
+      to_d_spacing(Nessi::VectorView<const NumT>(&polar_angle, 1),
+                   Nessi::VectorView<const NumT>(&polar_angle_err2, 1));
+    warnings.report(__map_kernel(__compose(to_wavelength, to_d_spacing),
+                                 &tof, &tof_err2, &d_spacing,
+                                 &d_spacing_err2, 1));
+
+    return warnings.str();
+  }
+
+  // 3.15 and 3.25
+  template <typename NumT>
+  std::string
+  tof_to_d_spacing(const Nessi::VectorView<const NumT> & tof,
+                   const Nessi::VectorView<const NumT> & tof_err2,
+                   const NumT pathlength,
+                   const NumT pathlength_err2,
+                   const NumT polar_angle,
+                   const NumT polar_angle_err2,
+                   const Nessi::VectorView<NumT> & d_spacing,
+                   const Nessi::VectorView<NumT> & d_spacing_err2,
+                   void *temp=NULL)
+  {
+    // check that the views are of proper size
+    size_t sz = tof.size();
+    if (tof_err2.size() != sz || d_spacing.size() != sz
+        || d_spacing_err2.size() != sz)
+      {
+        throw std::invalid_argument(ttds_func_str+" (view): views not the "
+                                    +"same size");
+      }
+
+    Nessi::DefaultWarningSink warnings;
+
+    // calculate the constants of the pixel
+    NumT a;
+    NumT a2;
+    NumT a_err2;
+    __tof_to_wavelength_prologue(Nessi::VectorView<const NumT>(&pathlength, 1),
+                                 Nessi::VectorView<const NumT>(
+                                                        &pathlength_err2, 1),
+                                 &a, &a2, &a_err2, warnings);
+
+    // the wavelength of a bin is converted without being stored
+    __TofToWavelengthKernel<NumT> to_wavelength(&a, &a2, &a_err2);
+    __WavelengthToDSpacingKernel<NumT>
+      to_d_spacing(Nessi::VectorView<const NumT>(&polar_angle, 1),
+                   Nessi::VectorView<const NumT>(&polar_angle_err2, 1));
+    warnings.report(__map_kernel(__compose(to_wavelength, to_d_spacing),
+                                 tof, tof_err2, d_spacing,
+                                 d_spacing_err2, sz));
+
+    return warnings.str();
+  }
+
+  // 3.15 and 3.25
+  template <typename NumT>
+  std::string
+  tof_to_d_spacing(const Nessi::ExecutionPolicy & policy,
+                   const Nessi::SpectrumBlock<NumT> & tof,
+                   const Nessi::Vector<NumT> & pathlength,
+                   const Nessi::Vector<NumT> & pathlength_err2,
+                   const Nessi::Vector<NumT> & polar_angle,
+                   const Nessi::Vector<NumT> & polar_angle_err2,
+                   Nessi::SpectrumBlock<NumT> & d_spacing,
+                   void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!tof.same_shape(d_spacing))
+      {
+        throw std::invalid_argument(ttds_func_str+" (b,v): blocks not the "
+                                    +"same shape");
+      }
+
+    // check that the geometry arrays are of proper size
+    try
+      {
+        Utils::check_sizes_square(pathlength, pathlength_err2);
+      }
+    catch(std::invalid_argument &e)
+      {
+        throw std::invalid_argument(ttds_func_str+" (b,v): pathlength "
+                                    +e.what());
+      }
+    try
+      {
+        Utils::check_sizes_square(polar_angle, polar_angle_err2);
+      }
+    catch(std::invalid_argument &e)
+      {
+        throw std::invalid_argument(ttds_func_str+" (b,v): polar_angle "
+                                    +e.what());
+      }
+    std::size_t num_pixels = tof.num_spectra();
+    if (pathlength.size() != num_pixels || polar_angle.size() != num_pixels)
+      {
+        throw std::invalid_argument(ttds_func_str+" (b,v): geometry not "
+                                    +"the number of spectra");
+      }
+
+    Nessi::DefaultWarningSink warnings;
+
+    // calculate the constants of all pixels
+    Nessi::Scratch<NumT> a(temp, num_pixels);
+    Nessi::Scratch<NumT> a2(temp, num_pixels);
+    Nessi::Scratch<NumT> a_err2(temp, num_pixels);
+    __tof_to_wavelength_prologue(Nessi::VectorView<const NumT>(pathlength),
+                                 Nessi::VectorView<const NumT>(
+                                                           pathlength_err2),
+                                 a.data(), a2.data(), a_err2.data(),
+                                 warnings);
+
+    // every pixel is converted with its own flight path and angle, the
+    // wavelength of a bin is converted without being stored
+    __TofToWavelengthKernel<NumT> to_wavelength(a.data(), a2.data(),
+                                                a_err2.data());
+    Nessi::VectorView<const NumT> polar_angle_view(polar_angle);
+    Nessi::VectorView<const NumT> polar_angle_err2_view(polar_angle_err2);
+    __WavelengthToDSpacingKernel<NumT> to_d_spacing(polar_angle_view,
+                                                    polar_angle_err2_view);
+    warnings.report(__map_kernel(policy,
+                                 __compose(to_wavelength, to_d_spacing),
+                                 tof, d_spacing));
+
+    return warnings.str();
+  }
+
+  // 3.15 and 3.25
+  template <typename NumT>
+  std::string
+  tof_to_d_spacing(const Nessi::SpectrumBlock<NumT> & tof,
+                   const Nessi::Vector<NumT> & pathlength,
+                   const Nessi::Vector<NumT> & pathlength_err2,
+                   const Nessi::Vector<NumT> & polar_angle,
+                   const Nessi::Vector<NumT> & polar_angle_err2,
+                   Nessi::SpectrumBlock<NumT> & d_spacing,
+                   void *temp=NULL)
+  {
+    return tof_to_d_spacing(Nessi::execution::seq, tof, pathlength,
+                            pathlength_err2, polar_angle, polar_angle_err2,
+                            d_spacing, temp);
+  }
+} // AxisManip
+
+#endif // _TOF_TO_D_SPACING_HPP
@@ -0,0 +1,281 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file axis_manip/src/tof_to_energy_transfer_dgs.cpp
+ */
+#include "tof_to_energy_transfer_dgs.hpp"
+
+namespace AxisManip
+{
+  // explicit instantiations
+
+  /**
+   * This is the float declaration of the tof_to_energy_transfer_dgs()
+   * function
+   *
+   * \ingroup tof_to_energy_transfer_dgs
+   */
+  template std::string
+  tof_to_energy_transfer_dgs<float>(const Nessi::Vector<float> & tof,
+                                    const Nessi::Vector<float> & tof_err2,
+                                    const float initial_velocity,
+                                    const float initial_velocity_err2,
+                                    const float time_offset,
+                                    const float time_offset_err2,
+                                    const float dist_source_sample,
+                                    const float dist_source_sample_err2,
+                                    const float dist_sample_detector,
+                                    const float dist_sample_detector_err2,
+                                    const float initial_energy,
+                                    const float initial_energy_err2,
+                                    Nessi::Vector<float> & energy_transfer,
+                                    Nessi::Vector<float> &
+                                    energy_transfer_err2,
+                                    void *temp);
+
+  /**
+   * This is the float declaration of the tof_to_energy_transfer_dgs()
+   * function
+   *
+   * \ingroup tof_to_energy_transfer_dgs
+   */
+  template std::string
+  tof_to_energy_transfer_dgs<float>(const float tof,
+                                    const float tof_err2,
+                                    const float initial_velocity,
+                                    const float initial_velocity_err2,
+                                    const float time_offset,
+                                    const float time_offset_err2,
+                                    const float dist_source_sample,
+                                    const float dist_source_sample_err2,
+                                    const float dist_sample_detector,
+                                    const float dist_sample_detector_err2,
+                                    const float initial_energy,
+                                    const float initial_energy_err2,
+                                    float & energy_transfer,
+                                    float & energy_transfer_err2,
+                                    void *temp);
+
+  /**
+   * This is the float declaration of the tof_to_energy_transfer_dgs()
+   * function for blocks
+   *
+   * \ingroup tof_to_energy_transfer_dgs
+   */
+  template std::string
+  tof_to_energy_transfer_dgs<float>(const Nessi::SpectrumBlock<float> & tof,
+                                    const float initial_velocity,
+                                    const float initial_velocity_err2,
+                                    const float time_offset,
+                                    const float time_offset_err2,
+                                    const float dist_source_sample,
+                                    const float dist_source_sample_err2,
+                                    const Nessi::Vector<float> &
+                                    dist_sample_detector,
+                                    const Nessi::Vector<float> &
+                                    dist_sample_detector_err2,
+                                    const float initial_energy,
+                                    const float initial_energy_err2,
+                                    Nessi::SpectrumBlock<float> &
+                                    energy_transfer,
+                                    void *temp);
+
+  /**
+   * This is the float declaration of the tof_to_energy_transfer_dgs()
+   * function for blocks with an execution policy
+   *
+   * \ingroup tof_to_energy_transfer_dgs
+   */
+  template std::string
+  tof_to_energy_transfer_dgs<float>(const Nessi::ExecutionPolicy & policy,
+                                    const Nessi::SpectrumBlock<float> & tof,
+                                    const float initial_velocity,
+                                    const float initial_velocity_err2,
+                                    const float time_offset,
+                                    const float time_offset_err2,
+                                    const float dist_source_sample,
+                                    const float dist_source_sample_err2,
+                                    const Nessi::Vector<float> &
+                                    dist_sample_detector,
+                                    const Nessi::Vector<float> &
+                                    dist_sample_detector_err2,
+                                    const float initial_energy,
+                                    const float initial_energy_err2,
+                                    Nessi::SpectrumBlock<float> &
+                                    energy_transfer,
+                                    void *temp);
+
+  /**
+   * This is the double precision float declaration of the
+   * tof_to_energy_transfer_dgs() function
+   *
+   * \ingroup tof_to_energy_transfer_dgs
+   */
+  template std::string
+  tof_to_energy_transfer_dgs<double>(const Nessi::Vector<double> & tof,
+                                     const Nessi::Vector<double> & tof_err2,
+                                     const double initial_velocity,
+                                     const double initial_velocity_err2,
+                                     const double time_offset,
+                                     const double time_offset_err2,
+                                     const double dist_source_sample,
+                                     const double dist_source_sample_err2,
+                                     const double dist_sample_detector,
+                                     const double dist_sample_detector_err2,
+                                     const double initial_energy,
+                                     const double initial_energy_err2,
+                                     Nessi::Vector<double> & energy_transfer,
+                                     Nessi::Vector<double> &
+                                     energy_transfer_err2,
+                                     void *temp);
+
+  /**
+   * This is the double precision float declaration of the
+   * tof_to_energy_transfer_dgs() function
+   *
+   * \ingroup tof_to_energy_transfer_dgs
+   */
+  template std::string
+  tof_to_energy_transfer_dgs<double>(const double tof,
+                                     const double tof_err2,
+                                     const double initial_velocity,
+                                     const double initial_velocity_err2,
+                                     const double time_offset,
+                                     const double time_offset_err2,
+                                     const double dist_source_sample,
+                                     const double dist_source_sample_err2,
+                                     const double dist_sample_detector,
+                                     const double dist_sample_detector_err2,
+                                     const double initial_energy,
+                                     const double initial_energy_err2,
+                                     double & energy_transfer,
+                                     double & energy_transfer_err2,
+                                     void *temp);
+
+  /**
+   * This is the double precision float declaration of the
+   * tof_to_energy_transfer_dgs() function for blocks
+   *
+   * \ingroup tof_to_energy_transfer_dgs
+   */
+  template std::string
+  tof_to_energy_transfer_dgs<double>(const Nessi::SpectrumBlock<double> & tof,
+                                     const double initial_velocity,
+                                     const double initial_velocity_err2,
+                                     const double time_offset,
+                                     const double time_offset_err2,
+                                     const double dist_source_sample,
+                                     const double dist_source_sample_err2,
+                                     const Nessi::Vector<double> &
+                                     dist_sample_detector,
+                                     const Nessi::Vector<double> &
+                                     dist_sample_detector_err2,
+                                     const double initial_energy,
+                                     const double initial_energy_err2,
+                                     Nessi::SpectrumBlock<double> &
+                                     energy_transfer,
+                                     void *temp);
+
+  /**
+   * This is the double precision float declaration of the
+   * tof_to_energy_transfer_dgs() function for blocks with an execution
+   * policy
+   *
+   * \ingroup tof_to_energy_transfer_dgs
+   */
+  template std::string
+  tof_to_energy_transfer_dgs<double>(const Nessi::ExecutionPolicy & policy,
+                                     const Nessi::SpectrumBlock<double> & tof,
+                                     const double initial_velocity,
+                                     const double initial_velocity_err2,
+                                     const double time_offset,
+                                     const double time_offset_err2,
+                                     const double dist_source_sample,
+                                     const double dist_source_sample_err2,
+                                     const Nessi::Vector<double> &
+                                     dist_sample_detector,
+                                     const Nessi::Vector<double> &
+                                     dist_sample_detector_err2,
+                                     const double initial_energy,
+                                     const double initial_energy_err2,
+                                     Nessi::SpectrumBlock<double> &
+                                     energy_transfer,
+                                     void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.27, 3.21 and
+   * 3.30 for views
+   *
+   * \ingroup tof_to_energy_transfer_dgs
+   */
+  template std::string
+  tof_to_energy_transfer_dgs<float>(const Nessi::VectorView<const float> & tof,
+                                    const Nessi::VectorView<const float> &
+                                    tof_err2,
+                                    const float initial_velocity,
+                                    const float initial_velocity_err2,
+                                    const float time_offset,
+                                    const float time_offset_err2,
+                                    const float dist_source_sample,
+                                    const float dist_source_sample_err2,
+                                    const float dist_sample_detector,
+                                    const float dist_sample_detector_err2,
+                                    const float initial_energy,
+                                    const float initial_energy_err2,
+                                    const Nessi::VectorView<float> &
+                                    energy_transfer,
+                                    const Nessi::VectorView<float> &
+                                    energy_transfer_err2,
+                                    void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.27, 3.21 and 3.30 for views
+   *
+   * \ingroup tof_to_energy_transfer_dgs
+   */
+  template std::string
+  tof_to_energy_transfer_dgs<double>(const Nessi::VectorView<const double> &
+                                     tof,
+                                     const Nessi::VectorView<const double> &
+                                     tof_err2,
+                                     const double initial_velocity,
+                                     const double initial_velocity_err2,
+                                     const double time_offset,
+                                     const double time_offset_err2,
+                                     const double dist_source_sample,
+                                     const double dist_source_sample_err2,
+                                     const double dist_sample_detector,
+                                     const double dist_sample_detector_err2,
+                                     const double initial_energy,
+                                     const double initial_energy_err2,
+                                     const Nessi::VectorView<double> &
+                                     energy_transfer,
+                                     const Nessi::VectorView<double> &
+                                     energy_transfer_err2,
+                                     void *temp);
+} // AxisManip
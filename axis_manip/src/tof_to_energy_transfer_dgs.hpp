@@ -0,0 +1,300 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file axis_manip/src/tof_to_energy_transfer_dgs.hpp
+ */
+#ifndef _TOF_TO_ENERGY_TRANSFER_DGS_HPP
+#define _TOF_TO_ENERGY_TRANSFER_DGS_HPP 1
+
+#include "conversions.hpp"
+#include "energy_transfer.hpp"
+#include "map_kernel.hpp"
+#include "nessi_view.hpp"
+#include "nessi_warn.hpp"
+#include "size_checks.hpp"
+#include "tof_to_final_velocity_dgs.hpp"
+#include "velocity_to_energy.hpp"
+#include <stdexcept>
+
+namespace AxisManip
+{
+  /// String for holding the tof_to_energy_transfer_dgs function name
+  const std::string
+  ttetd_func_str = "AxisManip::tof_to_energy_transfer_dgs";
+
+  // 3.27, 3.21 and 3.30
+  template <typename NumT>
+  std::string
+  tof_to_energy_transfer_dgs(const Nessi::Vector<NumT> & tof,
+                             const Nessi::Vector<NumT> & tof_err2,
+                             const NumT initial_velocity,
+                             const NumT initial_velocity_err2,
+                             const NumT time_offset,
+                             const NumT time_offset_err2,
+                             const NumT dist_source_sample,
+                             const NumT dist_source_sample_err2,
+                             const NumT dist_sample_detector,
+                             const NumT dist_sample_detector_err2,
+                             const NumT initial_energy,
+                             const NumT initial_energy_err2,
+                             Nessi::Vector<NumT> & energy_transfer,
+                             Nessi::Vector<NumT> & energy_transfer_err2,
+                             void *temp=NULL)
+  {
+    // check that the values are of proper size
+    try
+      {
+        Utils::check_sizes_square(tof, energy_transfer);
+      }
+    catch(std::invalid_argument &e)
+      {
+        throw std::invalid_argument(ttetd_func_str+" (v,v): data "
+                                    +e.what());
+      }
+
+    // check that the uncertainties are of proper size
+    try
+      {
+        Utils::check_sizes_square(tof_err2, energy_transfer_err2);
+      }
+    catch(std::invalid_argument &e)
+      {
+        throw std::invalid_argument(ttetd_func_str+" (v,v): err2 "
+                                    +e.what());
+      }
+
+    // check that the tof arrays are of proper size
+    try
+      {
+        Utils::check_sizes_square(tof, tof_err2);
+      }
+    catch(std::invalid_argument &e)
+      {
+        throw std::invalid_argument(ttetd_func_str+" (v,v): tof "
+                                    +e.what());
+      }
+
+    // the final velocity and energy of a bin are converted without being
+    // stored
+    __TofToFinalVelocityDgsKernel<NumT>
+      to_final_velocity(initial_velocity, initial_velocity_err2,
+                        time_offset, time_offset_err2, dist_source_sample,
+                        dist_source_sample_err2,
+                        Nessi::VectorView<const NumT>(&dist_sample_detector,
+                                                      1),
+                        Nessi::VectorView<const NumT>(
+                                             &dist_sample_detector_err2, 1));
+    __VelocityToEnergyKernel<NumT> to_final_energy;
+    __EnergyTransferKernel<NumT> to_energy_transfer(initial_energy,
+                                                    initial_energy_err2);
+    return __map_kernel(__compose(__compose(to_final_velocity,
+                                            to_final_energy),
+                                  to_energy_transfer),
+                        tof.begin(), tof_err2.begin(),
+                        energy_transfer.begin(),
+                        energy_transfer_err2.begin(), tof.size());
+  }
+
+  // 3.27, 3.21 and 3.30
+  template <typename NumT>
+  std::string
+  tof_to_energy_transfer_dgs(const NumT tof,
+                             const NumT tof_err2,
+                             const NumT initial_velocity,
+                             const NumT initial_velocity_err2,
+                             const NumT time_offset,
+                             const NumT time_offset_err2,
+                             const NumT dist_source_sample,
+                             const NumT dist_source_sample_err2,
+                             const NumT dist_sample_detector,
+                             const NumT dist_sample_detector_err2,
+                             const NumT initial_energy,
+                             const NumT initial_energy_err2,
+                             NumT & energy_transfer,
+                             NumT & energy_transfer_err2,
+                             void *temp=NULL)
+  {
+    __TofToFinalVelocityDgsKernel<NumT>
+      to_final_velocity(initial_velocity, initial_velocity_err2,
+                        time_offset, time_offset_err2, dist_source_sample,
+                        dist_source_sample_err2,
+                        Nessi::VectorView<const NumT>(&dist_sample_detector,
+                                                      1),
+                        Nessi::VectorView<const NumT>(
+                                             &dist_sample_detector_err2, 1));
+    __VelocityToEnergyKernel<NumT> to_final_energy;
+    __EnergyTransferKernel<NumT> to_energy_transfer(initial_energy,
+                                                    initial_energy_err2);
+    return __map_kernel(__compose(__compose(to_final_velocity,
+                                            to_final_energy),
+                                  to_energy_transfer),
+                        &tof, &tof_err2, &energy_transfer,
+                        &energy_transfer_err2, 1);
+  }
+
+  // 3.27, 3.21 and 3.30
+  template <typename NumT>
+  std::string
+  tof_to_energy_transfer_dgs(const Nessi::VectorView<const NumT> & tof,
+                             const Nessi::VectorView<const NumT> & tof_err2,
+                             const NumT initial_velocity,
+                             const NumT initial_velocity_err2,
+                             const NumT time_offset,
+                             const NumT time_offset_err2,
+                             const NumT dist_source_sample,
+                             const NumT dist_source_sample_err2,
+                             const NumT dist_sample_detector,
+                             const NumT dist_sample_detector_err2,
+                             const NumT initial_energy,
+                             const NumT initial_energy_err2,
+                             const Nessi::VectorView<NumT> & energy_transfer,
+                             const Nessi::VectorView<NumT> &
+                             energy_transfer_err2,
+                             void *temp=NULL)
+  {
+    // check that the views are of proper size
+    size_t sz = tof.size();
+    if (tof_err2.size() != sz || energy_transfer.size() != sz
+        || energy_transfer_err2.size() != sz)
+      {
+        throw std::invalid_argument(ttetd_func_str+" (view): views not the "
+                                    +"same size");
+      }
+
+    __TofToFinalVelocityDgsKernel<NumT>
+      to_final_velocity(initial_velocity, initial_velocity_err2,
+                        time_offset, time_offset_err2, dist_source_sample,
+                        dist_source_sample_err2,
+                        Nessi::VectorView<const NumT>(&dist_sample_detector,
+                                                      1),
+                        Nessi::VectorView<const NumT>(
+                                             &dist_sample_detector_err2, 1));
+    __VelocityToEnergyKernel<NumT> to_final_energy;
+    __EnergyTransferKernel<NumT> to_energy_transfer(initial_energy,
+                                                    initial_energy_err2);
+    return __map_kernel(__compose(__compose(to_final_velocity,
+                                            to_final_energy),
+                                  to_energy_transfer),
+                        tof, tof_err2, energy_transfer,
+                        energy_transfer_err2, sz);
+  }
+
+  // 3.27, 3.21 and 3.30
+  template <typename NumT>
+  std::string
+  tof_to_energy_transfer_dgs(const Nessi::ExecutionPolicy & policy,
+                             const Nessi::SpectrumBlock<NumT> & tof,
+                             const NumT initial_velocity,
+                             const NumT initial_velocity_err2,
+                             const NumT time_offset,
+                             const NumT time_offset_err2,
+                             const NumT dist_source_sample,
+                             const NumT dist_source_sample_err2,
+                             const Nessi::Vector<NumT> &
+                             dist_sample_detector,
+                             const Nessi::Vector<NumT> &
+                             dist_sample_detector_err2,
+                             const NumT initial_energy,
+                             const NumT initial_energy_err2,
+                             Nessi::SpectrumBlock<NumT> & energy_transfer,
+                             void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!tof.same_shape(energy_transfer))
+      {
+        throw std::invalid_argument(ttetd_func_str+" (b,v): blocks not the "
+                                    +"same shape");
+      }
+
+    // check that the distance arrays are of proper size
+    try
+      {
+        Utils::check_sizes_square(dist_sample_detector,
+                                  dist_sample_detector_err2);
+      }
+    catch(std::invalid_argument &e)
+      {
+        throw std::invalid_argument(ttetd_func_str+" (b,v): "
+                                    +"dist_sample_detector "+e.what());
+      }
+    if (dist_sample_detector.size() != tof.num_spectra())
+      {
+        throw std::invalid_argument(ttetd_func_str+" (b,v): geometry not "
+                                    +"the number of spectra");
+      }
+
+    // every pixel is converted with its own detector distance, the final
+    // velocity and energy of a bin are converted without being stored
+    __TofToFinalVelocityDgsKernel<NumT>
+      to_final_velocity(initial_velocity, initial_velocity_err2,
+                        time_offset, time_offset_err2, dist_source_sample,
+                        dist_source_sample_err2,
+                        Nessi::VectorView<const NumT>(dist_sample_detector),
+                        Nessi::VectorView<const NumT>(
+                                                dist_sample_detector_err2));
+    __VelocityToEnergyKernel<NumT> to_final_energy;
+    __EnergyTransferKernel<NumT> to_energy_transfer(initial_energy,
+                                                    initial_energy_err2);
+    return __map_kernel(policy,
+                        __compose(__compose(to_final_velocity,
+                                            to_final_energy),
+                                  to_energy_transfer),
+                        tof, energy_transfer);
+  }
+
+  // 3.27, 3.21 and 3.30
+  template <typename NumT>
+  std::string
+  tof_to_energy_transfer_dgs(const Nessi::SpectrumBlock<NumT> & tof,
+                             const NumT initial_velocity,
+                             const NumT initial_velocity_err2,
+                             const NumT time_offset,
+                             const NumT time_offset_err2,
+                             const NumT dist_source_sample,
+                             const NumT dist_source_sample_err2,
+                             const Nessi::Vector<NumT> &
+                             dist_sample_detector,
+                             const Nessi::Vector<NumT> &
+                             dist_sample_detector_err2,
+                             const NumT initial_energy,
+                             const NumT initial_energy_err2,
+                             Nessi::SpectrumBlock<NumT> & energy_transfer,
+                             void *temp=NULL)
+  {
+    return tof_to_energy_transfer_dgs(Nessi::execution::seq, tof,
+                                      initial_velocity,
+                                      initial_velocity_err2, time_offset,
+                                      time_offset_err2, dist_source_sample,
+                                      dist_source_sample_err2,
+                                      dist_sample_detector,
+                                      dist_sample_detector_err2,
+                                      initial_energy, initial_energy_err2,
+                                      energy_transfer, temp);
+  }
+} // AxisManip
+
+#endif // _TOF_TO_ENERGY_TRANSFER_DGS_HPP
@@ -52,6 +52,7 @@ namespace AxisManip
                                    Nessi::Vector<float> & final_velocity,
                                    Nessi::Vector<float> & final_velocity_err2,
                                    void *temp);
+
   /**
    * This is the float declaration of the function defined in 3.27.
    *
@@ -114,4 +115,142 @@ namespace AxisManip
                                     double & final_velocity,
                                     double & final_velocity_err2,
                                     void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.27 for
+   * blocks
+   *
+   * \ingroup tof_to_final_velocity_dgs
+   */
+  template std::string
+  tof_to_final_velocity_dgs<float>(const Nessi::SpectrumBlock<float> & tof,
+                                   const float initial_velocity,
+                                   const float initial_velocity_err2,
+                                   const float time_offset,
+                                   const float time_offset_err2,
+                                   const float dist_source_sample,
+                                   const float dist_source_sample_err2,
+                                   const Nessi::Vector<float> &
+                                   dist_sample_detector,
+                                   const Nessi::Vector<float> &
+                                   dist_sample_detector_err2,
+                                   Nessi::SpectrumBlock<float> &
+                                   final_velocity,
+                                   void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.27 for
+   * blocks with an execution policy
+   *
+   * \ingroup tof_to_final_velocity_dgs
+   */
+  template std::string
+  tof_to_final_velocity_dgs<float>(const Nessi::ExecutionPolicy & policy,
+                                   const Nessi::SpectrumBlock<float> & tof,
+                                   const float initial_velocity,
+                                   const float initial_velocity_err2,
+                                   const float time_offset,
+                                   const float time_offset_err2,
+                                   const float dist_source_sample,
+                                   const float dist_source_sample_err2,
+                                   const Nessi::Vector<float> &
+                                   dist_sample_detector,
+                                   const Nessi::Vector<float> &
+                                   dist_sample_detector_err2,
+                                   Nessi::SpectrumBlock<float> &
+                                   final_velocity,
+                                   void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.27 for blocks
+   *
+   * \ingroup tof_to_final_velocity_dgs
+   */
+  template std::string
+  tof_to_final_velocity_dgs<double>(const Nessi::SpectrumBlock<double> & tof,
+                                    const double initial_velocity,
+                                    const double initial_velocity_err2,
+                                    const double time_offset,
+                                    const double time_offset_err2,
+                                    const double dist_source_sample,
+                                    const double dist_source_sample_err2,
+                                    const Nessi::Vector<double> &
+                                    dist_sample_detector,
+                                    const Nessi::Vector<double> &
+                                    dist_sample_detector_err2,
+                                    Nessi::SpectrumBlock<double> &
+                                    final_velocity,
+                                    void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.27 for blocks with an execution policy
+   *
+   * \ingroup tof_to_final_velocity_dgs
+   */
+  template std::string
+  tof_to_final_velocity_dgs<double>(const Nessi::ExecutionPolicy & policy,
+                                    const Nessi::SpectrumBlock<double> & tof,
+                                    const double initial_velocity,
+                                    const double initial_velocity_err2,
+                                    const double time_offset,
+                                    const double time_offset_err2,
+                                    const double dist_source_sample,
+                                    const double dist_source_sample_err2,
+                                    const Nessi::Vector<double> &
+                                    dist_sample_detector,
+                                    const Nessi::Vector<double> &
+                                    dist_sample_detector_err2,
+                                    Nessi::SpectrumBlock<double> &
+                                    final_velocity,
+                                    void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.27 for views
+   *
+   * \ingroup tof_to_final_velocity_dgs
+   */
+  template std::string
+  tof_to_final_velocity_dgs<float>(const Nessi::VectorView<const float> & tof,
+                                   const Nessi::VectorView<const float> &
+                                   tof_err2,
+                                   const float initial_velocity,
+                                   const float initial_velocity_err2,
+                                   const float time_offset,
+                                   const float time_offset_err2,
+                                   const float dist_source_sample,
+                                   const float dist_source_sample_err2,
+                                   const float dist_sample_detector,
+                                   const float dist_sample_detector_err2,
+                                   const Nessi::VectorView<float> &
+                                   final_velocity,
+                                   const Nessi::VectorView<float> &
+                                   final_velocity_err2,
+                                   void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.27 for views
+   *
+   * \ingroup tof_to_final_velocity_dgs
+   */
+  template std::string
+  tof_to_final_velocity_dgs<double>(const Nessi::VectorView<const double> &
+                                    tof,
+                                    const Nessi::VectorView<const double> &
+                                    tof_err2,
+                                    const double initial_velocity,
+                                    const double initial_velocity_err2,
+                                    const double time_offset,
+                                    const double time_offset_err2,
+                                    const double dist_source_sample,
+                                    const double dist_source_sample_err2,
+                                    const double dist_sample_detector,
+                                    const double dist_sample_detector_err2,
+                                    const Nessi::VectorView<double> &
+                                    final_velocity,
+                                    const Nessi::VectorView<double> &
+                                    final_velocity_err2,
+                                    void *temp);
 } // AxisManip
@@ -31,6 +31,8 @@
 #define _TOF_TO_FINAL_VELOCITY_DGS_HPP 1
 
 #include "conversions.hpp"
+#include "map_kernel.hpp"
+#include "nessi_view.hpp"
 #include "nessi_warn.hpp"
 #include "size_checks.hpp"
 #include <stdexcept>
@@ -40,6 +42,108 @@ namespace AxisManip
   /// String for holding the tof_to_final_velocity_dgs function name
   const std::string ttfvd_func_str = "AxisManip::tof_to_final_velocity_dgs";
 
+  /**
+   * \ingroup tof_to_final_velocity_dgs
+   *
+   * This is a PRIVATE map kernel (see \ref map_kernel) converting the
+   * time-of-flight of pixel \f$p\f$ with the sample to detector distance
+   * \f$L_D[p]\f$. The other parameters are shared by all pixels.
+   */
+  template <typename NumT>
+  class __TofToFinalVelocityDgsKernel
+  {
+  public:
+    /// Type of the elements
+    typedef NumT value_type;
+
+    /// Constructor keeping the parameters of the conversion
+    __TofToFinalVelocityDgsKernel(const NumT initial_velocity,
+                                  const NumT initial_velocity_err2,
+                                  const NumT time_offset,
+                                  const NumT time_offset_err2,
+                                  const NumT dist_source_sample,
+                                  const NumT dist_source_sample_err2,
+                                  const Nessi::VectorView<const NumT> &
+                                  dist_sample_detector,
+                                  const Nessi::VectorView<const NumT> &
+                                  dist_sample_detector_err2)
+      : initial_velocity_(initial_velocity),
+        initial_velocity_err2_(initial_velocity_err2),
+        time_offset_(time_offset), time_offset_err2_(time_offset_err2),
+        dist_source_sample_(dist_source_sample),
+        dist_source_sample_err2_(dist_source_sample_err2),
+        dist_sample_detector_(dist_sample_detector),
+        dist_sample_detector_err2_(dist_sample_detector_err2),
+        ld_(0), ld_err2_(0), a_(0), a2_(0), b_(0), c_(0), c2_(0), ld2_(0)
+    { }
+
+    /// Returns false, every pixel has its own detector distance
+    bool is_uniform() const
+    {
+      return false;
+    }
+
+    /// Calculates the constants of pixel \p p
+    std::string setup(const std::size_t p)
+    {
+      ld_ = dist_sample_detector_[p];
+      ld_err2_ = dist_sample_detector_err2_[p];
+      return __tof_to_final_velocity_dgs_static(initial_velocity_,
+                                                dist_source_sample_,
+                                                time_offset_, ld_, a_, a2_,
+                                                b_, c_, c2_, ld2_);
+    }
+
+    /// Converts one bin
+    template <typename SinkT>
+    void operator()(const NumT tof, const NumT tof_err2,
+                    NumT & final_velocity, NumT & final_velocity_err2,
+                    SinkT & warnings) const
+    {
+      __tof_to_final_velocity_dgs_dynamic(tof, tof_err2,
+                                          initial_velocity_err2_,
+                                          time_offset_err2_,
+                                          dist_source_sample_err2_, ld_,
+                                          ld_err2_, final_velocity,
+                                          final_velocity_err2, a_, a2_, b_,
+                                          c_, c2_, ld2_, warnings);
+    }
+
+  private:
+    /// The parameters shared by all pixels
+    NumT initial_velocity_;
+    /// The parameters shared by all pixels
+    NumT initial_velocity_err2_;
+    /// The parameters shared by all pixels
+    NumT time_offset_;
+    /// The parameters shared by all pixels
+    NumT time_offset_err2_;
+    /// The parameters shared by all pixels
+    NumT dist_source_sample_;
+    /// The parameters shared by all pixels
+    NumT dist_source_sample_err2_;
+    /// The sample to detector distance of every pixel
+    Nessi::VectorView<const NumT> dist_sample_detector_;
+    /// The square of the uncertainty in the distances
+    Nessi::VectorView<const NumT> dist_sample_detector_err2_;
+    /// The sample to detector distance of the current pixel
+    NumT ld_;
+    /// The square of the uncertainty in the distance of the pixel
+    NumT ld_err2_;
+    /// The constants of __tof_to_final_velocity_dgs_static()
+    NumT a_;
+    /// The constants of __tof_to_final_velocity_dgs_static()
+    NumT a2_;
+    /// The constants of __tof_to_final_velocity_dgs_static()
+    NumT b_;
+    /// The constants of __tof_to_final_velocity_dgs_static()
+    NumT c_;
+    /// The constants of __tof_to_final_velocity_dgs_static()
+    NumT c2_;
+    /// The constants of __tof_to_final_velocity_dgs_static()
+    NumT ld2_;
+  };
+
   // 3.27
   template <typename NumT>
   std::string
@@ -87,42 +191,14 @@ namespace AxisManip
         throw std::invalid_argument(ttfvd_func_str+" (v,v): err2 "+e.what());
       }
 
-    std::string retstr(Nessi::EMPTY_WARN);    // the warning string
-
-    // allocate local variables
-    NumT a;
-    NumT a2;
-    NumT b;
-    NumT c;
-    NumT c2;
-    NumT ld2;
-   
-    // calculate static paramters
-    retstr +=__tof_to_final_velocity_dgs_static(initial_velocity,
-                                                dist_source_sample,
-                                                time_offset,
-                                                dist_sample_detector,
-                                                a, a2, b, c, c2, ld2);
-
-    // fill the results array
-    size_t size_tof = tof.size();
-    for (size_t i = 0 ; i < size_tof ; ++i)
-      {
-        retstr +=
-          __tof_to_final_velocity_dgs_dynamic(tof[i], 
-                                              tof_err2[i],
-                                              initial_velocity_err2,
-                                              time_offset_err2,
-                                              dist_source_sample_err2,
-                                              dist_sample_detector,
-                                              dist_sample_detector_err2,
-                                              final_velocity[i],
-                                              final_velocity_err2[i],
-                                              a, a2, b, c, c2, ld2);
-      }
-
-    // send back all warnings
-    return retstr;
+    __TofToFinalVelocityDgsKernel<NumT>
+      kernel(initial_velocity, initial_velocity_err2, time_offset,
+             time_offset_err2, dist_source_sample, dist_source_sample_err2,
+             Nessi::VectorView<const NumT>(&dist_sample_detector, 1),
+             Nessi::VectorView<const NumT>(&dist_sample_detector_err2, 1));
+    return __map_kernel(kernel, tof.begin(), tof_err2.begin(),
+                        final_velocity.begin(), final_velocity_err2.begin(),
+                        tof.size());
   }
 
   // 3.27
@@ -142,38 +218,126 @@ namespace AxisManip
                             NumT & final_velocity_err2,
                             void *temp=NULL)
   {
-   // define some parameters that are static across the array calculation
-    NumT a;
-    NumT a2;
-    NumT b;
-    NumT c;
-    NumT c2;
-    NumT ld2;
+    __TofToFinalVelocityDgsKernel<NumT>
+      kernel(initial_velocity, initial_velocity_err2, time_offset,
+             time_offset_err2, dist_source_sample, dist_source_sample_err2,
+             Nessi::VectorView<const NumT>(&dist_sample_detector, 1),
+             Nessi::VectorView<const NumT>(&dist_sample_detector_err2, 1));
+    return __map_kernel(kernel, &tof, &tof_err2, &final_velocity,
+                        &final_velocity_err2, 1);
+  }
+
+  // 3.27
+  template <typename NumT>
+  std::string
+  tof_to_final_velocity_dgs(const Nessi::VectorView<const NumT> & tof,
+                            const Nessi::VectorView<const NumT> & tof_err2,
+                            const NumT initial_velocity,
+                            const NumT initial_velocity_err2,
+                            const NumT time_offset,
+                            const NumT time_offset_err2,
+                            const NumT dist_source_sample,
+                            const NumT dist_source_sample_err2,
+                            const NumT dist_sample_detector,
+                            const NumT dist_sample_detector_err2,
+                            const Nessi::VectorView<NumT> & final_velocity,
+                            const Nessi::VectorView<NumT> &
+                            final_velocity_err2,
+                            void *temp=NULL)
+  {
+    // check that the views are of proper size
+    size_t sz = tof.size();
+    if (tof_err2.size() != sz || final_velocity.size() != sz
+        || final_velocity_err2.size() != sz)
+      {
+        throw std::invalid_argument(ttfvd_func_str+" (view): views not the "
+                                    +"same size");
+      }
+
+    __TofToFinalVelocityDgsKernel<NumT>
+      kernel(initial_velocity, initial_velocity_err2, time_offset,
+             time_offset_err2, dist_source_sample, dist_source_sample_err2,
+             Nessi::VectorView<const NumT>(&dist_sample_detector, 1),
+             Nessi::VectorView<const NumT>(&dist_sample_detector_err2, 1));
+    return __map_kernel(kernel, tof, tof_err2, final_velocity,
+                        final_velocity_err2, sz);
+  }
 
-    // some string parameters for dealing with warnings
-    std::string retstr(Nessi::EMPTY_WARN);
+  // 3.27
+  template <typename NumT>
+  std::string
+  tof_to_final_velocity_dgs(const Nessi::ExecutionPolicy & policy,
+                            const Nessi::SpectrumBlock<NumT> & tof,
+                            const NumT initial_velocity,
+                            const NumT initial_velocity_err2,
+                            const NumT time_offset,
+                            const NumT time_offset_err2,
+                            const NumT dist_source_sample,
+                            const NumT dist_source_sample_err2,
+                            const Nessi::Vector<NumT> & dist_sample_detector,
+                            const Nessi::Vector<NumT> &
+                            dist_sample_detector_err2,
+                            Nessi::SpectrumBlock<NumT> & final_velocity,
+                            void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!tof.same_shape(final_velocity))
+      {
+        throw std::invalid_argument(ttfvd_func_str+" (b,v): blocks not the "
+                                    +"same shape");
+      }
 
-    // calculate static paramters
-    retstr +=__tof_to_final_velocity_dgs_static(initial_velocity,
-                                                dist_source_sample,
-                                                time_offset,
-                                                dist_sample_detector,
-                                                a, a2, b, c, c2, ld2);       
+    // check that the distance arrays are of proper size
+    try
+      {
+        Utils::check_sizes_square(dist_sample_detector,
+                                  dist_sample_detector_err2);
+      }
+    catch(std::invalid_argument &e)
+      {
+        throw std::invalid_argument(ttfvd_func_str+" (b,v): "
+                                    +"dist_sample_detector "+e.what());
+      }
+    if (dist_sample_detector.size() != tof.num_spectra())
+      {
+        throw std::invalid_argument(ttfvd_func_str+" (b,v): geometry not "
+                                    +"the number of spectra");
+      }
 
-    // fill the results
-    retstr +=__tof_to_final_velocity_dgs_dynamic(tof, 
-                                                 tof_err2,
-                                                 initial_velocity_err2,
-                                                 time_offset_err2,
-                                                 dist_source_sample_err2,
-                                                 dist_sample_detector,
-                                                 dist_sample_detector_err2,
-                                                 final_velocity,
-                                                 final_velocity_err2,
-                                                 a, a2, b, c, c2, ld2);
+    // every pixel is converted with its own detector distance
+    Nessi::VectorView<const NumT> ld(dist_sample_detector);
+    Nessi::VectorView<const NumT> ld_err2(dist_sample_detector_err2);
+    __TofToFinalVelocityDgsKernel<NumT>
+      kernel(initial_velocity, initial_velocity_err2, time_offset,
+             time_offset_err2, dist_source_sample, dist_source_sample_err2,
+             ld, ld_err2);
+    return __map_kernel(policy, kernel, tof, final_velocity);
+  }
 
-    // send back all warnings
-    return retstr;
+  // 3.27
+  template <typename NumT>
+  std::string
+  tof_to_final_velocity_dgs(const Nessi::SpectrumBlock<NumT> & tof,
+                            const NumT initial_velocity,
+                            const NumT initial_velocity_err2,
+                            const NumT time_offset,
+                            const NumT time_offset_err2,
+                            const NumT dist_source_sample,
+                            const NumT dist_source_sample_err2,
+                            const Nessi::Vector<NumT> & dist_sample_detector,
+                            const Nessi::Vector<NumT> &
+                            dist_sample_detector_err2,
+                            Nessi::SpectrumBlock<NumT> & final_velocity,
+                            void *temp=NULL)
+  {
+    return tof_to_final_velocity_dgs(Nessi::execution::seq, tof,
+                                     initial_velocity, initial_velocity_err2,
+                                     time_offset, time_offset_err2,
+                                     dist_source_sample,
+                                     dist_source_sample_err2,
+                                     dist_sample_detector,
+                                     dist_sample_detector_err2,
+                                     final_velocity, temp);
   }
 
  /**
@@ -258,9 +422,10 @@ namespace AxisManip
    * __tof_to_final_velocity_dgs_static()
    * \param ld2 (INPUT) same as parameter in
    * __tof_to_final_velocity_dgs_static()
+   * \param warnings (OUTPUT) is the sink receiving the warnings
    */
-  template <typename NumT>
-  std::string __tof_to_final_velocity_dgs_dynamic(const NumT tof,
+  template <typename NumT, typename SinkT>
+  void __tof_to_final_velocity_dgs_dynamic(const NumT tof,
                                                   const NumT tof_err2,
                                                   const NumT initial_velocity_err2,
                                                   const NumT time_offset_err2,
@@ -274,7 +439,8 @@ namespace AxisManip
                                                   const NumT b,
                                                   const NumT c,
                                                   const NumT c2,
-                                                  const NumT ld2)
+                                                  const NumT ld2,
+                                                  SinkT & warnings)
   {
     NumT tb = tof - b;
     NumT tb2 = tb * tb;
@@ -289,8 +455,6 @@ namespace AxisManip
     final_velocity_err2 += (c2 * ld2 * initial_velocity_err2 / tb4);
     final_velocity_err2 += (ld2 * time_offset_err2 / tb4);
     final_velocity_err2 += (ld2 * tof_err2 / tb4);
-
-    return Nessi::EMPTY_WARN;
   }
 } // AxisManip
 
@@ -32,6 +32,7 @@
 
 #include "constants.hpp"
 #include "conversions.hpp"
+#include "map_kernel.hpp"
 #include "nessi_warn.hpp"
 #include "size_checks.hpp"
 #include <stdexcept>
@@ -41,6 +42,112 @@ namespace AxisManip
   /// String for holding the tof_to_initial_wavelength_igs function name
   const std::string ttiwi_func_str = "AxisManip::tof_to_initial_wavelength_igs";
 
+  /**
+   * \ingroup tof_to_initial_wavelength_igs
+   *
+   * This is a PRIVATE map kernel (see \ref map_kernel) converting the
+   * time-of-flight of pixel \f$p\f$ with the sample to detector distance
+   * \f$L_d[p]\f$. The other parameters are shared by all pixels.
+   */
+  template <typename NumT>
+  class __TofToInitialWavelengthIgsKernel
+  {
+  public:
+    /// Type of the elements
+    typedef NumT value_type;
+
+    /// Constructor keeping the parameters of the conversion
+    __TofToInitialWavelengthIgsKernel(const NumT final_wavelength,
+                                      const NumT final_wavelength_err2,
+                                      const NumT time_offset,
+                                      const NumT time_offset_err2,
+                                      const NumT dist_source_sample,
+                                      const NumT dist_source_sample_err2,
+                                      const Nessi::VectorView<const NumT> &
+                                      dist_sample_detector,
+                                      const Nessi::VectorView<const NumT> &
+                                      dist_sample_detector_err2)
+      : final_wavelength_(final_wavelength),
+        final_wavelength_err2_(final_wavelength_err2),
+        time_offset_(time_offset), time_offset_err2_(time_offset_err2),
+        dist_source_sample_(dist_source_sample),
+        dist_source_sample_err2_(dist_source_sample_err2),
+        dist_sample_detector_(dist_sample_detector),
+        dist_sample_detector_err2_(dist_sample_detector_err2),
+        ld_err2_(0), a_(0), b_(0), c_(0), ls2_(0), inv_ls2_(0), ld2_(0),
+        wf2_(0)
+    { }
+
+    /// Returns false, every pixel has its own detector distance
+    bool is_uniform() const
+    {
+      return false;
+    }
+
+    /// Calculates the constants of pixel \p p
+    std::string setup(const std::size_t p)
+    {
+      ld_err2_ = dist_sample_detector_err2_[p];
+      return __tof_to_initial_wavelength_igs_static(final_wavelength_,
+                                                    time_offset_,
+                                                    dist_source_sample_,
+                                                    dist_sample_detector_[p],
+                                                    a_, b_, c_, ls2_,
+                                                    inv_ls2_, ld2_, wf2_);
+    }
+
+    /// Converts one bin
+    template <typename SinkT>
+    void operator()(const NumT tof, const NumT tof_err2,
+                    NumT & initial_wavelength,
+                    NumT & initial_wavelength_err2,
+                    SinkT & warnings) const
+    {
+      __tof_to_initial_wavelength_igs_dynamic(tof, tof_err2,
+                                              final_wavelength_err2_,
+                                              time_offset_err2_,
+                                              dist_source_sample_err2_,
+                                              ld_err2_, initial_wavelength,
+                                              initial_wavelength_err2,
+                                              a_, b_, c_, ls2_, inv_ls2_,
+                                              ld2_, wf2_, warnings);
+    }
+
+  private:
+    /// The parameters shared by all pixels
+    NumT final_wavelength_;
+    /// The parameters shared by all pixels
+    NumT final_wavelength_err2_;
+    /// The parameters shared by all pixels
+    NumT time_offset_;
+    /// The parameters shared by all pixels
+    NumT time_offset_err2_;
+    /// The parameters shared by all pixels
+    NumT dist_source_sample_;
+    /// The parameters shared by all pixels
+    NumT dist_source_sample_err2_;
+    /// The sample to detector distance of every pixel
+    Nessi::VectorView<const NumT> dist_sample_detector_;
+    /// The squared uncertainty of every sample to detector distance
+    Nessi::VectorView<const NumT> dist_sample_detector_err2_;
+    /// The constants of the current pixel
+    NumT ld_err2_;
+    /// The constants of the current pixel
+    NumT a_;
+    /// The constants of the current pixel
+    NumT b_;
+    /// The constants of the current pixel
+    NumT c_;
+    /// The constants of the current pixel
+    NumT ls2_;
+    /// The constants of the current pixel
+    NumT inv_ls2_;
+    /// The constants of the current pixel
+    NumT ld2_;
+    /// The constants of the current pixel
+    NumT wf2_;
+  };
+
   // 3.29
   template <typename NumT>
   std::string
@@ -79,44 +186,19 @@ namespace AxisManip
         throw std::invalid_argument(ttiwi_func_str+" (v,v): err2 "+e.what());
       }
 
-    std::string retstr(Nessi::EMPTY_WARN);    // the warning string
-
-    // alloacate local variables
-    NumT a;
-    NumT b;
-    NumT c;
-    NumT ls2;
-    NumT inv_ls2;
-    NumT ld2;
-    NumT wf2;
-
-    // calculate static paramters
-    retstr +=__tof_to_initial_wavelength_igs_static(final_wavelength,
-                                                    time_offset,
-                                                    dist_source_sample,
-                                                    dist_sample_detector, a,
-                                                    b, c, ls2, inv_ls2, ld2,
-                                                    wf2);
-
-    // fill the results array
-    size_t size_tof = tof.size();
-    for (size_t i = 0 ; i < size_tof ; ++i)
-      {
-        retstr +=
-          __tof_to_initial_wavelength_igs_dynamic(
-                                                  tof[i], tof_err2[i],
-                                                  final_wavelength_err2,
-                                                  time_offset_err2,
-                                                  dist_source_sample_err2,
-                                                  dist_sample_detector_err2,
-                                                  initial_wavelength[i],
-                                                  initial_wavelength_err2[i],
-                                                  a, b, c, ls2, inv_ls2,
-                                                  ld2, wf2);
-      }
-
-    // send back all warnings
-    return retstr;
+    // do the calculation
+    return __map_kernel(__TofToInitialWavelengthIgsKernel<NumT>(
+                          final_wavelength, final_wavelength_err2,
+                          time_offset, time_offset_err2,
+                          dist_source_sample, dist_source_sample_err2,
+                          Nessi::VectorView<const NumT>(&dist_sample_detector,
+                                                        1),
+                          Nessi::VectorView<const NumT>(
+                                                 &dist_sample_detector_err2,
+                                                 1)),
+                        tof.begin(), tof_err2.begin(),
+                        initial_wavelength.begin(),
+                        initial_wavelength_err2.begin(), tof.size());
   }
 
   // 3.29
@@ -136,40 +218,89 @@ namespace AxisManip
                                 NumT & initial_wavelength_err2,
                                 void *temp=NULL)
   {
-    // define some parameters that are static across the array calculation
-    NumT a;
-    NumT b;
-    NumT c;
-    NumT ls2;
-    NumT inv_ls2;
-    NumT ld2;
-    NumT wf2;
-
-    // some string parameters for dealing with warnings
-    std::string retstr(Nessi::EMPTY_WARN);
+    // do the calculation
+    return __map_kernel(__TofToInitialWavelengthIgsKernel<NumT>(
+                          final_wavelength, final_wavelength_err2,
+                          time_offset, time_offset_err2,
+                          dist_source_sample, dist_source_sample_err2,
+                          Nessi::VectorView<const NumT>(&dist_sample_detector,
+                                                        1),
+                          Nessi::VectorView<const NumT>(
+                                                 &dist_sample_detector_err2,
+                                                 1)),
+                        &tof, &tof_err2, &initial_wavelength,
+                        &initial_wavelength_err2, 1);
+  }
 
-    // calculate static paramters
-    retstr +=__tof_to_initial_wavelength_igs_static(final_wavelength,
-                                                    time_offset,
-                                                    dist_source_sample,
-                                                    dist_sample_detector, a,
-                                                    b, c, ls2, inv_ls2, ld2,
-                                                    wf2);
+  // 3.29
+  template <typename NumT>
+  std::string
+  tof_to_initial_wavelength_igs(const Nessi::VectorView<const NumT> & tof,
+                                const Nessi::VectorView<const NumT> & tof_err2,
+                                const NumT final_wavelength,
+                                const NumT final_wavelength_err2,
+                                const NumT time_offset,
+                                const NumT time_offset_err2,
+                                const NumT dist_source_sample,
+                                const NumT dist_source_sample_err2,
+                                const NumT dist_sample_detector,
+                                const NumT dist_sample_detector_err2,
+                                const Nessi::VectorView<NumT> &
+                                initial_wavelength,
+                                const Nessi::VectorView<NumT> &
+                                initial_wavelength_err2,
+                                void *temp=NULL)
+  {
+    // check that the views are of proper size
+    size_t sz = tof.size();
+    if (tof_err2.size() != sz || initial_wavelength.size() != sz
+        || initial_wavelength_err2.size() != sz)
+      {
+        throw std::invalid_argument(ttiwi_func_str+" (view): views not the "
+                                    +"same size");
+      }
 
-    // fill the results
-    retstr +=
-      __tof_to_initial_wavelength_igs_dynamic(tof, tof_err2,
-                                              final_wavelength_err2,
-                                              time_offset_err2,
-                                              dist_source_sample_err2,
-                                              dist_sample_detector_err2,
-                                              initial_wavelength,
-                                              initial_wavelength_err2,
-                                              a, b, c, ls2, inv_ls2, ld2,
-                                              wf2);
+    // do the calculation
+    return __map_kernel(__TofToInitialWavelengthIgsKernel<NumT>(
+                          final_wavelength, final_wavelength_err2,
+                          time_offset, time_offset_err2,
+                          dist_source_sample, dist_source_sample_err2,
+                          Nessi::VectorView<const NumT>(&dist_sample_detector,
+                                                        1),
+                          Nessi::VectorView<const NumT>(
+                                                 &dist_sample_detector_err2,
+                                                 1)),
+                        tof, tof_err2, initial_wavelength,
+                        initial_wavelength_err2, sz);
+  }
 
-    // send back all warnings
-    return retstr;
+  // 3.29
+  template <typename NumT>
+  std::string
+  tof_to_initial_wavelength_igs(const Nessi::SpectrumBlock<NumT> & tof,
+                                const NumT final_wavelength,
+                                const NumT final_wavelength_err2,
+                                const NumT time_offset,
+                                const NumT time_offset_err2,
+                                const NumT dist_source_sample,
+                                const NumT dist_source_sample_err2,
+                                const Nessi::Vector<NumT> &
+                                dist_sample_detector,
+                                const Nessi::Vector<NumT> &
+                                dist_sample_detector_err2,
+                                Nessi::SpectrumBlock<NumT> &
+                                initial_wavelength,
+                                void *temp=NULL)
+  {
+    return tof_to_initial_wavelength_igs(Nessi::execution::seq, tof,
+                                         final_wavelength,
+                                         final_wavelength_err2,
+                                         time_offset, time_offset_err2,
+                                         dist_source_sample,
+                                         dist_source_sample_err2,
+                                         dist_sample_detector,
+                                         dist_sample_detector_err2,
+                                         initial_wavelength, temp);
   }
 
   /**
@@ -264,9 +395,10 @@ namespace AxisManip
    * __tof_to_initial_wavelength_igs_static()
    * \param wf2 (INPUT) same as parameter in
    * __tof_to_initial_wavelength_igs_static()
+   * \param warnings (OUTPUT) is the sink receiving the warnings
    */
-  template <typename NumT>
-  std::string __tof_to_initial_wavelength_igs_dynamic(
+  template <typename NumT, typename SinkT>
+  void __tof_to_initial_wavelength_igs_dynamic(
                                           const NumT tof,
                                           const NumT tof_err2,
                                           const NumT final_wavelength_err2,
@@ -281,7 +413,8 @@ namespace AxisManip
                                           const NumT ls2,
                                           const NumT inv_ls2,
                                           const NumT ld2,
-                                          const NumT wf2)
+                                          const NumT wf2,
+                                          SinkT & warnings)
   {
     // the result
     initial_wavelength = a * tof - b;
@@ -293,8 +426,64 @@ namespace AxisManip
     initial_wavelength_err2 += c*(tof_err2+time_offset_err2);
     initial_wavelength_err2 += wf2*dist_sample_detector_err2;
     initial_wavelength_err2 *= inv_ls2;
+  }
 
-    return Nessi::EMPTY_WARN;
+  // 3.29
+  template <typename NumT>
+  std::string
+  tof_to_initial_wavelength_igs(const Nessi::ExecutionPolicy & policy,
+                                const Nessi::SpectrumBlock<NumT> & tof,
+                                const NumT final_wavelength,
+                                const NumT final_wavelength_err2,
+                                const NumT time_offset,
+                                const NumT time_offset_err2,
+                                const NumT dist_source_sample,
+                                const NumT dist_source_sample_err2,
+                                const Nessi::Vector<NumT> &
+                                dist_sample_detector,
+                                const Nessi::Vector<NumT> &
+                                dist_sample_detector_err2,
+                                Nessi::SpectrumBlock<NumT> &
+                                initial_wavelength,
+                                void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!tof.same_shape(initial_wavelength))
+      {
+        throw std::invalid_argument(ttiwi_func_str+" (b,v): blocks not the "
+                                    +"same shape");
+      }
+
+    // check that the distance arrays are of proper size
+    try
+      {
+        Utils::check_sizes_square(dist_sample_detector,
+                                  dist_sample_detector_err2);
+      }
+    catch(std::invalid_argument &e)
+      {
+        throw std::invalid_argument(ttiwi_func_str+" (b,v): "
+                                    +"dist_sample_detector "+e.what());
+      }
+    if (dist_sample_detector.size() != tof.num_spectra())
+      {
+        throw std::invalid_argument(ttiwi_func_str+" (b,v): "
+                                    +"dist_sample_detector not the number "
+                                    +"of spectra");
+      }
+
+    // every pixel is converted with its own detector distance
+    return __map_kernel(policy,
+                        __TofToInitialWavelengthIgsKernel<NumT>(
+                                                  final_wavelength,
+                                                  final_wavelength_err2,
+                                                  time_offset,
+                                                  time_offset_err2,
+                                                  dist_source_sample,
+                                                  dist_source_sample_err2,
+                                                  dist_sample_detector,
+                                                  dist_sample_detector_err2),
+                        tof, initial_wavelength);
   }
 } // AxisManip
 
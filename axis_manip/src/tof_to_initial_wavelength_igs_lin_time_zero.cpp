@@ -126,4 +126,159 @@ namespace AxisManip
                                double & initial_wavelength,
                                double & initial_wavelength_err2,
                                void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.48 for
+   * blocks
+   *
+   * \ingroup tof_to_initial_wavelength_igs_lin_time_zero
+   */
+  template std::string
+  tof_to_initial_wavelength_igs_lin_time_zero<float>(
+                                const Nessi::SpectrumBlock<float> & tof,
+                                const float final_wavelength,
+                                const float final_wavelength_err2,
+                                const float time_0_slope,
+                                const float time_0_slope_err2,
+                                const float time_0_offset,
+                                const float time_0_offset_err2,
+                                const float dist_source_sample,
+                                const float dist_source_sample_err2,
+                                const Nessi::Vector<float> &
+                                dist_sample_detector,
+                                const Nessi::Vector<float> &
+                                dist_sample_detector_err2,
+                                Nessi::SpectrumBlock<float> &
+                                initial_wavelength,
+                                void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.48 for
+   * blocks with an execution policy
+   *
+   * \ingroup tof_to_initial_wavelength_igs_lin_time_zero
+   */
+  template std::string
+  tof_to_initial_wavelength_igs_lin_time_zero<float>(
+                                const Nessi::ExecutionPolicy & policy,
+                                const Nessi::SpectrumBlock<float> & tof,
+                                const float final_wavelength,
+                                const float final_wavelength_err2,
+                                const float time_0_slope,
+                                const float time_0_slope_err2,
+                                const float time_0_offset,
+                                const float time_0_offset_err2,
+                                const float dist_source_sample,
+                                const float dist_source_sample_err2,
+                                const Nessi::Vector<float> &
+                                dist_sample_detector,
+                                const Nessi::Vector<float> &
+                                dist_sample_detector_err2,
+                                Nessi::SpectrumBlock<float> &
+                                initial_wavelength,
+                                void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.48 for blocks
+   *
+   * \ingroup tof_to_initial_wavelength_igs_lin_time_zero
+   */
+  template std::string
+  tof_to_initial_wavelength_igs_lin_time_zero<double>(
+                                const Nessi::SpectrumBlock<double> & tof,
+                                const double final_wavelength,
+                                const double final_wavelength_err2,
+                                const double time_0_slope,
+                                const double time_0_slope_err2,
+                                const double time_0_offset,
+                                const double time_0_offset_err2,
+                                const double dist_source_sample,
+                                const double dist_source_sample_err2,
+                                const Nessi::Vector<double> &
+                                dist_sample_detector,
+                                const Nessi::Vector<double> &
+                                dist_sample_detector_err2,
+                                Nessi::SpectrumBlock<double> &
+                                initial_wavelength,
+                                void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.48 for blocks with an execution policy
+   *
+   * \ingroup tof_to_initial_wavelength_igs_lin_time_zero
+   */
+  template std::string
+  tof_to_initial_wavelength_igs_lin_time_zero<double>(
+                                const Nessi::ExecutionPolicy & policy,
+                                const Nessi::SpectrumBlock<double> & tof,
+                                const double final_wavelength,
+                                const double final_wavelength_err2,
+                                const double time_0_slope,
+                                const double time_0_slope_err2,
+                                const double time_0_offset,
+                                const double time_0_offset_err2,
+                                const double dist_source_sample,
+                                const double dist_source_sample_err2,
+                                const Nessi::Vector<double> &
+                                dist_sample_detector,
+                                const Nessi::Vector<double> &
+                                dist_sample_detector_err2,
+                                Nessi::SpectrumBlock<double> &
+                                initial_wavelength,
+                                void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.48 for views
+   *
+   * \ingroup tof_to_initial_wavelength_igs_lin_time_zero
+   */
+  template std::string
+  tof_to_initial_wavelength_igs_lin_time_zero<float>(
+                                const Nessi::VectorView<const float> & tof,
+                                const Nessi::VectorView<const float> &
+                                tof_err2,
+                                const float final_wavelength,
+                                const float final_wavelength_err2,
+                                const float time_0_slope,
+                                const float time_0_slope_err2,
+                                const float time_0_offset,
+                                const float time_0_offset_err2,
+                                const float dist_source_sample,
+                                const float dist_source_sample_err2,
+                                const float dist_sample_detector,
+                                const float dist_sample_detector_err2,
+                                const Nessi::VectorView<float> &
+                                initial_wavelength,
+                                const Nessi::VectorView<float> &
+                                initial_wavelength_err2,
+                                void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.48 for views
+   *
+   * \ingroup tof_to_initial_wavelength_igs_lin_time_zero
+   */
+  template std::string
+  tof_to_initial_wavelength_igs_lin_time_zero<double>(
+                                const Nessi::VectorView<const double> & tof,
+                                const Nessi::VectorView<const double> &
+                                tof_err2,
+                                const double final_wavelength,
+                                const double final_wavelength_err2,
+                                const double time_0_slope,
+                                const double time_0_slope_err2,
+                                const double time_0_offset,
+                                const double time_0_offset_err2,
+                                const double dist_source_sample,
+                                const double dist_source_sample_err2,
+                                const double dist_sample_detector,
+                                const double dist_sample_detector_err2,
+                                const Nessi::VectorView<double> &
+                                initial_wavelength,
+                                const Nessi::VectorView<double> &
+                                initial_wavelength_err2,
+                                void *temp);
 } // AxisManip
@@ -32,6 +32,7 @@
 
 #include "constants.hpp"
 #include "conversions.hpp"
+#include "map_kernel.hpp"
 #include "nessi_warn.hpp"
 #include "size_checks.hpp"
 #include <stdexcept>
@@ -43,6 +44,116 @@ namespace AxisManip
   const std::string ttiwiltz_func_str = \
   "AxisManip::tof_to_initial_wavelength_igs_lin_time_zero";
 
+  /**
+   * \ingroup tof_to_initial_wavelength_igs_lin_time_zero
+   *
+   * This is a PRIVATE map kernel (see \ref map_kernel) converting the
+   * time-of-flight of pixel \f$p\f$ with the sample to detector distance
+   * \f$L_d[p]\f$. The other parameters are shared by all pixels.
+   */
+  template <typename NumT>
+  class __TofToInitialWavelengthIgsLinTimeZeroKernel
+  {
+  public:
+    /// Type of the elements
+    typedef NumT value_type;
+
+    /// Constructor keeping the parameters of the conversion
+    __TofToInitialWavelengthIgsLinTimeZeroKernel(
+                                      const NumT final_wavelength,
+                                      const NumT final_wavelength_err2,
+                                      const NumT time_0_slope,
+                                      const NumT time_0_slope_err2,
+                                      const NumT time_0_offset,
+                                      const NumT time_0_offset_err2,
+                                      const NumT dist_source_sample,
+                                      const NumT dist_source_sample_err2,
+                                      const Nessi::VectorView<const NumT> &
+                                      dist_sample_detector,
+                                      const Nessi::VectorView<const NumT> &
+                                      dist_sample_detector_err2)
+      : final_wavelength_(final_wavelength),
+        final_wavelength_err2_(final_wavelength_err2),
+        time_0_slope_(time_0_slope), time_0_slope_err2_(time_0_slope_err2),
+        time_0_offset_(time_0_offset),
+        time_0_offset_err2_(time_0_offset_err2),
+        dist_source_sample_(dist_source_sample),
+        dist_source_sample_err2_(dist_source_sample_err2),
+        dist_sample_detector_(dist_sample_detector),
+        dist_sample_detector_err2_(dist_sample_detector_err2),
+        a_(0), a2_(0), b_(0), c_(0), d_(0)
+    { }
+
+    /// Returns false, every pixel has its own detector distance
+    bool is_uniform() const
+    {
+      return false;
+    }
+
+    /// Calculates the constants of pixel \p p
+    std::string setup(const std::size_t p)
+    {
+      return __tof_to_initial_wavelength_igs_lin_time_zero_static(
+                                              final_wavelength_,
+                                              final_wavelength_err2_,
+                                              time_0_slope_,
+                                              time_0_slope_err2_,
+                                              time_0_offset_,
+                                              time_0_offset_err2_,
+                                              dist_source_sample_,
+                                              dist_source_sample_err2_,
+                                              dist_sample_detector_[p],
+                                              dist_sample_detector_err2_[p],
+                                              a_, a2_, b_, c_, d_);
+    }
+
+    /// Converts one bin
+    template <typename SinkT>
+    void operator()(const NumT tof, const NumT tof_err2,
+                    NumT & initial_wavelength,
+                    NumT & initial_wavelength_err2,
+                    SinkT & warnings) const
+    {
+      __tof_to_initial_wavelength_igs_lin_time_zero_dynamic(
+                                              tof, tof_err2,
+                                              initial_wavelength,
+                                              initial_wavelength_err2,
+                                              a_, a2_, b_, c_, d_, warnings);
+    }
+
+  private:
+    /// The parameters shared by all pixels
+    NumT final_wavelength_;
+    /// The parameters shared by all pixels
+    NumT final_wavelength_err2_;
+    /// The parameters shared by all pixels
+    NumT time_0_slope_;
+    /// The parameters shared by all pixels
+    NumT time_0_slope_err2_;
+    /// The parameters shared by all pixels
+    NumT time_0_offset_;
+    /// The parameters shared by all pixels
+    NumT time_0_offset_err2_;
+    /// The parameters shared by all pixels
+    NumT dist_source_sample_;
+    /// The parameters shared by all pixels
+    NumT dist_source_sample_err2_;
+    /// The sample to detector distance of every pixel
+    Nessi::VectorView<const NumT> dist_sample_detector_;
+    /// The squared uncertainty of every sample to detector distance
+    Nessi::VectorView<const NumT> dist_sample_detector_err2_;
+    /// The constants of the current pixel
+    NumT a_;
+    /// The constants of the current pixel
+    NumT a2_;
+    /// The constants of the current pixel
+    NumT b_;
+    /// The constants of the current pixel
+    NumT c_;
+    /// The constants of the current pixel
+    NumT d_;
+  };
+
   // 3.48
   template <typename NumT>
   std::string
@@ -85,45 +196,20 @@ namespace AxisManip
                                     +e.what());
       }
 
-    std::string retstr(Nessi::EMPTY_WARN);    // the warning string
-
-    // alloacate local variables
-    NumT a;
-    NumT a2;
-    NumT b;
-    NumT c;
-    NumT d;
-
-    // calculate static paramters
-    retstr += 
-      __tof_to_initial_wavelength_igs_lin_time_zero_static(
-                                                    final_wavelength,
-                                                    final_wavelength_err2,
-                                                    time_0_slope,
-                                                    time_0_slope_err2,
-                                                    time_0_offset,
-                                                    time_0_offset_err2,
-                                                    dist_source_sample,
-                                                    dist_source_sample_err2,
-                                                    dist_sample_detector, 
-                                                    dist_sample_detector_err2, 
-                                                    a, a2, b, c, d);
-
-    // fill the results array
-    size_t size_tof = tof.size();
-    for (size_t i = 0 ; i < size_tof ; ++i)
-      {
-        retstr +=
-          __tof_to_initial_wavelength_igs_lin_time_zero_dynamic(
-                                                  tof[i], 
-                                                  tof_err2[i],
-                                                  initial_wavelength[i],
-                                                  initial_wavelength_err2[i],
-                                                  a, a2, b, c, d);
-      }
-
-    // send back all warnings
-    return retstr;
+    // do the calculation
+    return __map_kernel(__TofToInitialWavelengthIgsLinTimeZeroKernel<NumT>(
+                          final_wavelength, final_wavelength_err2,
+                          time_0_slope, time_0_slope_err2,
+                          time_0_offset, time_0_offset_err2,
+                          dist_source_sample, dist_source_sample_err2,
+                          Nessi::VectorView<const NumT>(&dist_sample_detector,
+                                                        1),
+                          Nessi::VectorView<const NumT>(
+                                                 &dist_sample_detector_err2,
+                                                 1)),
+                        tof.begin(), tof_err2.begin(),
+                        initial_wavelength.begin(),
+                        initial_wavelength_err2.begin(), tof.size());
   }
 
   // 3.48
@@ -145,42 +231,65 @@ namespace AxisManip
                                 NumT & initial_wavelength_err2,
                                 void *temp=NULL)
   {
-    // define some parameters that are static across the array calculation
-    NumT a;
-    NumT a2;
-    NumT b;
-    NumT c;
-    NumT d;
-
-    // some string parameters for dealing with warnings
-    std::string retstr(Nessi::EMPTY_WARN);
-
-    // calculate static paramters
-    retstr += 
-      __tof_to_initial_wavelength_igs_lin_time_zero_static(
-                                                    final_wavelength,
-                                                    final_wavelength_err2,
-                                                    time_0_slope,
-                                                    time_0_slope_err2,
-                                                    time_0_offset,
-                                                    time_0_offset_err2,
-                                                    dist_source_sample,
-                                                    dist_source_sample_err2,
-                                                    dist_sample_detector, 
-                                                    dist_sample_detector_err2, 
-                                                    a, a2, b, c, d);
+    // do the calculation
+    return __map_kernel(__TofToInitialWavelengthIgsLinTimeZeroKernel<NumT>(
+                          final_wavelength, final_wavelength_err2,
+                          time_0_slope, time_0_slope_err2,
+                          time_0_offset, time_0_offset_err2,
+                          dist_source_sample, dist_source_sample_err2,
+                          Nessi::VectorView<const NumT>(&dist_sample_detector,
+                                                        1),
+                          Nessi::VectorView<const NumT>(
+                                                 &dist_sample_detector_err2,
+                                                 1)),
+                        &tof, &tof_err2, &initial_wavelength,
+                        &initial_wavelength_err2, 1);
+  }
 
-    // fill the results
-    retstr +=
-      __tof_to_initial_wavelength_igs_lin_time_zero_dynamic(
-                                                       tof, 
-                                                       tof_err2,
-                                                       initial_wavelength,
-                                                       initial_wavelength_err2,
-                                                       a, a2, b, c, d);
+  // 3.48
+  template <typename NumT>
+  std::string
+  tof_to_initial_wavelength_igs_lin_time_zero(
+                                const Nessi::VectorView<const NumT> & tof,
+                                const Nessi::VectorView<const NumT> & tof_err2,
+                                const NumT final_wavelength,
+                                const NumT final_wavelength_err2,
+                                const NumT time_0_slope,
+                                const NumT time_0_slope_err2,
+                                const NumT time_0_offset,
+                                const NumT time_0_offset_err2,
+                                const NumT dist_source_sample,
+                                const NumT dist_source_sample_err2,
+                                const NumT dist_sample_detector,
+                                const NumT dist_sample_detector_err2,
+                                const Nessi::VectorView<NumT> &
+                                initial_wavelength,
+                                const Nessi::VectorView<NumT> &
+                                initial_wavelength_err2,
+                                void *temp=NULL)
+  {
+    // check that the views are of proper size
+    size_t sz = tof.size();
+    if (tof_err2.size() != sz || initial_wavelength.size() != sz
+        || initial_wavelength_err2.size() != sz)
+      {
+        throw std::invalid_argument(ttiwiltz_func_str+" (view): views not the "
+                                    +"same size");
+      }
 
-    // send back all warnings
-    return retstr;
+    // do the calculation
+    return __map_kernel(__TofToInitialWavelengthIgsLinTimeZeroKernel<NumT>(
+                          final_wavelength, final_wavelength_err2,
+                          time_0_slope, time_0_slope_err2,
+                          time_0_offset, time_0_offset_err2,
+                          dist_source_sample, dist_source_sample_err2,
+                          Nessi::VectorView<const NumT>(&dist_sample_detector,
+                                                        1),
+                          Nessi::VectorView<const NumT>(
+                                                 &dist_sample_detector_err2,
+                                                 1)),
+                        tof, tof_err2, initial_wavelength,
+                        initial_wavelength_err2, sz);
   }
 
   /**
@@ -284,9 +393,10 @@ namespace AxisManip
    * __tof_to_initial_wavelength_igs_lin_time_zero_static()
    * \param d (INPUT) same as parameter in
    * __tof_to_initial_wavelength_igs_lin_time_zero_static()
+   * \param warnings (OUTPUT) is the sink receiving the warnings
    */
-  template <typename NumT>
-  std::string __tof_to_initial_wavelength_igs_lin_time_zero_dynamic(
+  template <typename NumT, typename SinkT>
+  void __tof_to_initial_wavelength_igs_lin_time_zero_dynamic(
                                          const NumT tof,
                                          const NumT tof_err2,
                                          NumT & initial_wavelength,
@@ -295,7 +405,8 @@ namespace AxisManip
                                          const NumT a2,
                                          const NumT b,
                                          const NumT c,
-                                         const NumT d)
+                                         const NumT d,
+                                         SinkT & warnings)
   {
     // the result
     initial_wavelength = a * tof - b;
@@ -304,8 +415,104 @@ namespace AxisManip
     initial_wavelength_err2 = initial_wavelength * initial_wavelength * c;
     initial_wavelength_err2 += tof_err2 + d;
     initial_wavelength_err2 *= a2;
+  }
 
-    return Nessi::EMPTY_WARN;
+  // 3.48
+  template <typename NumT>
+  std::string
+  tof_to_initial_wavelength_igs_lin_time_zero(
+                                const Nessi::SpectrumBlock<NumT> & tof,
+                                const NumT final_wavelength,
+                                const NumT final_wavelength_err2,
+                                const NumT time_0_slope,
+                                const NumT time_0_slope_err2,
+                                const NumT time_0_offset,
+                                const NumT time_0_offset_err2,
+                                const NumT dist_source_sample,
+                                const NumT dist_source_sample_err2,
+                                const Nessi::Vector<NumT> &
+                                dist_sample_detector,
+                                const Nessi::Vector<NumT> &
+                                dist_sample_detector_err2,
+                                Nessi::SpectrumBlock<NumT> &
+                                initial_wavelength,
+                                void *temp=NULL)
+  {
+    return tof_to_initial_wavelength_igs_lin_time_zero(
+                                                  Nessi::execution::seq, tof,
+                                                  final_wavelength,
+                                                  final_wavelength_err2,
+                                                  time_0_slope,
+                                                  time_0_slope_err2,
+                                                  time_0_offset,
+                                                  time_0_offset_err2,
+                                                  dist_source_sample,
+                                                  dist_source_sample_err2,
+                                                  dist_sample_detector,
+                                                  dist_sample_detector_err2,
+                                                  initial_wavelength, temp);
+  }
+
+  // 3.48
+  template <typename NumT>
+  std::string
+  tof_to_initial_wavelength_igs_lin_time_zero(
+                                const Nessi::ExecutionPolicy & policy,
+                                const Nessi::SpectrumBlock<NumT> & tof,
+                                const NumT final_wavelength,
+                                const NumT final_wavelength_err2,
+                                const NumT time_0_slope,
+                                const NumT time_0_slope_err2,
+                                const NumT time_0_offset,
+                                const NumT time_0_offset_err2,
+                                const NumT dist_source_sample,
+                                const NumT dist_source_sample_err2,
+                                const Nessi::Vector<NumT> &
+                                dist_sample_detector,
+                                const Nessi::Vector<NumT> &
+                                dist_sample_detector_err2,
+                                Nessi::SpectrumBlock<NumT> &
+                                initial_wavelength,
+                                void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!tof.same_shape(initial_wavelength))
+      {
+        throw std::invalid_argument(ttiwiltz_func_str+" (b,v): blocks not the "
+                                    +"same shape");
+      }
+
+    // check that the dist_sample_detector arrays are of proper size
+    try
+      {
+        Utils::check_sizes_square(dist_sample_detector,
+                                  dist_sample_detector_err2);
+      }
+    catch(std::invalid_argument &e)
+      {
+        throw std::invalid_argument(ttiwiltz_func_str+" (b,v): "
+                                    +"dist_sample_detector "+e.what());
+      }
+    if (dist_sample_detector.size() != tof.num_spectra())
+      {
+        throw std::invalid_argument(ttiwiltz_func_str+" (b,v): geometry not "
+                                    +"the number of spectra");
+      }
+
+    // every pixel is converted with its own detector distance
+    return __map_kernel(policy,
+                        __TofToInitialWavelengthIgsLinTimeZeroKernel<NumT>(
+                                                  final_wavelength,
+                                                  final_wavelength_err2,
+                                                  time_0_slope,
+                                                  time_0_slope_err2,
+                                                  time_0_offset,
+                                                  time_0_offset_err2,
+                                                  dist_source_sample,
+                                                  dist_source_sample_err2,
+                                                  dist_sample_detector,
+                                                  dist_sample_detector_err2),
+                        tof, initial_wavelength);
   }
 } // AxisManip
 
@@ -98,4 +98,150 @@ namespace AxisManip
                           double & Q,
                           double & Q_err2,
                           void *temp);
+  /**
+   * This is the float declaration of the function defined in 3.17 for
+   * blocks
+   *
+   * \ingroup tof_to_scalar_Q
+   */
+  template std::string
+  tof_to_scalar_Q<float>(const Nessi::SpectrumBlock<float> & tof,
+                         const Nessi::Vector<float> & pathlength,
+                         const Nessi::Vector<float> & pathlength_err2,
+                         const Nessi::Vector<float> & polar,
+                         const Nessi::Vector<float> & polar_err2,
+                         Nessi::SpectrumBlock<float> & Q,
+                         void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.17 for
+   * blocks with an execution policy
+   *
+   * \ingroup tof_to_scalar_Q
+   */
+  template std::string
+  tof_to_scalar_Q<float>(const Nessi::ExecutionPolicy & policy,
+                         const Nessi::SpectrumBlock<float> & tof,
+                         const Nessi::Vector<float> & pathlength,
+                         const Nessi::Vector<float> & pathlength_err2,
+                         const Nessi::Vector<float> & polar,
+                         const Nessi::Vector<float> & polar_err2,
+                         Nessi::SpectrumBlock<float> & Q,
+                         void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.17 for blocks
+   *
+   * \ingroup tof_to_scalar_Q
+   */
+  template std::string
+  tof_to_scalar_Q<double>(const Nessi::SpectrumBlock<double> & tof,
+                          const Nessi::Vector<double> & pathlength,
+                          const Nessi::Vector<double> & pathlength_err2,
+                          const Nessi::Vector<double> & polar,
+                          const Nessi::Vector<double> & polar_err2,
+                          Nessi::SpectrumBlock<double> & Q,
+                          void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.17 for blocks with an execution policy
+   *
+   * \ingroup tof_to_scalar_Q
+   */
+  template std::string
+  tof_to_scalar_Q<double>(const Nessi::ExecutionPolicy & policy,
+                          const Nessi::SpectrumBlock<double> & tof,
+                          const Nessi::Vector<double> & pathlength,
+                          const Nessi::Vector<double> & pathlength_err2,
+                          const Nessi::Vector<double> & polar,
+                          const Nessi::Vector<double> & polar_err2,
+                          Nessi::SpectrumBlock<double> & Q,
+                          void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.17 for
+   * blocks with a geometry cache
+   *
+   * \ingroup tof_to_scalar_Q
+   */
+  template std::string
+  tof_to_scalar_Q<float>(const Nessi::SpectrumBlock<float> & tof,
+                         const InstrumentGeometryCache<float> & geometry,
+                         Nessi::SpectrumBlock<float> & Q,
+                         void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.17 for
+   * blocks with a geometry cache and an execution
+   * policy
+   *
+   * \ingroup tof_to_scalar_Q
+   */
+  template std::string
+  tof_to_scalar_Q<float>(const Nessi::ExecutionPolicy & policy,
+                         const Nessi::SpectrumBlock<float> & tof,
+                         const InstrumentGeometryCache<float> & geometry,
+                         Nessi::SpectrumBlock<float> & Q,
+                         void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.17 for blocks with a geometry cache
+   *
+   * \ingroup tof_to_scalar_Q
+   */
+  template std::string
+  tof_to_scalar_Q<double>(const Nessi::SpectrumBlock<double> & tof,
+                          const InstrumentGeometryCache<double> & geometry,
+                          Nessi::SpectrumBlock<double> & Q,
+                          void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.17 for blocks with a geometry cache and an execution
+   * policy
+   *
+   * \ingroup tof_to_scalar_Q
+   */
+  template std::string
+  tof_to_scalar_Q<double>(const Nessi::ExecutionPolicy & policy,
+                          const Nessi::SpectrumBlock<double> & tof,
+                          const InstrumentGeometryCache<double> & geometry,
+                          Nessi::SpectrumBlock<double> & Q,
+                          void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.17 for views
+   *
+   * \ingroup tof_to_scalar_Q
+   */
+  template std::string
+  tof_to_scalar_Q<float>(const Nessi::VectorView<const float> & tof,
+                         const Nessi::VectorView<const float> & tof_err2,
+                         const float pathlength,
+                         const float pathlength_err2,
+                         const float polar,
+                         const float polar_err2,
+                         const Nessi::VectorView<float> & Q,
+                         const Nessi::VectorView<float> & Q_err2,
+                         void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.17 for views
+   *
+   * \ingroup tof_to_scalar_Q
+   */
+  template std::string
+  tof_to_scalar_Q<double>(const Nessi::VectorView<const double> & tof,
+                          const Nessi::VectorView<const double> & tof_err2,
+                          const double pathlength,
+                          const double pathlength_err2,
+                          const double polar,
+                          const double polar_err2,
+                          const Nessi::VectorView<double> & Q,
+                          const Nessi::VectorView<double> & Q_err2,
+                          void *temp);
 } // AxisManip
@@ -32,95 +32,16 @@
 
 #include "constants.hpp"
 #include "conversions.hpp"
+#include "map_kernel.hpp"
 #include "nessi_warn.hpp"
-#include <cmath>
+#include "nessi_workspace.hpp"
+#include "size_checks.hpp"
 #include <stdexcept>
 
 namespace AxisManip
 {
-  // 3.17
-  template <typename NumT>
-  std::string
-  tof_to_scalar_Q(const Nessi::Vector<NumT> & tof,
-                  const Nessi::Vector<NumT> & tof_err2,
-                  const NumT pathlength,
-                  const NumT pathlength_err2,
-                  const NumT polar,
-                  const NumT polar_err2,
-                  Nessi::Vector<NumT> & Q,
-                  Nessi::Vector<NumT> & Q_err2,
-                  void *temp=NULL)
-  {
-    std::string retstr(Nessi::EMPTY_WARN);
-    std::string warn;
-
-    NumT a2;
-    NumT b;
-    NumT term1;
-    NumT term2;
-
-    warn = __tof_to_scalar_Q_static(pathlength, pathlength_err2, polar,
-                                    polar_err2, a2, b, term1, term2);
-    if (!warn.empty())
-      {
-        retstr += warn;
-      }
-
-    size_t size_tof = tof.size();
-    for (size_t i = 0; i < size_tof; ++i)
-      {
-        warn = __tof_to_scalar_Q_dynamic(tof[i], tof_err2[i], Q[i], Q_err2[i], 
-                                         a2, b, term1, term2);
-
-        if (!warn.empty())
-          {
-            retstr += warn;
-          }
-      }
-
-
-
-    return retstr;
-  }
-
-  // 3.17
-  template <typename NumT>
-  std::string
-  tof_to_scalar_Q(const NumT tof,
-                  const NumT tof_err2,
-                  const NumT pathlength,
-                  const NumT pathlength_err2,
-                  const NumT polar,
-                  const NumT polar_err2,
-                  NumT & Q,
-                  NumT & Q_err2,
-                  void *temp=NULL)
-  {
-    std::string retstr(Nessi::EMPTY_WARN);
-    std::string warn;
-
-    NumT a2;
-    NumT b;
-    NumT term1;
-    NumT term2;
-
-    warn = __tof_to_scalar_Q_static(pathlength, pathlength_err2, polar,
-                                    polar_err2, a2, b, term1, term2);
-    if (!warn.empty())
-      {
-        retstr += warn;
-      }
-
-    warn = __tof_to_scalar_Q_dynamic(tof, tof_err2, Q, Q_err2, a2, b, 
-                                     term1, term2);
-
-    if (!warn.empty())
-      {
-        retstr += warn;
-      }
-
-    return retstr;
-  }
+  /// String for holding the tof_to_scalar_Q function name
+  const std::string ttsq_func_str = "AxisManip::tof_to_scalar_Q";
 
   /**
    * \ingroup tof_to_scalar_Q
@@ -130,7 +51,10 @@ namespace AxisManip
    *
    * \param pathlength (INPUT) same as the parameter in tof_to_scalar_Q()
    * \param pathlength_err2 (INPUT) same as the parameter in tof_to_scalar_Q()
-   * \param polar (INPUT) same as the parameter in tof_to_scalar_Q()
+   * \param sin_half (INPUT) is \f$\sin(polar/2)\f$ calculated by
+   * __half_angle_sin_cos()
+   * \param cos_half (INPUT) is \f$\cos(polar/2)\f$ calculated by
+   * __half_angle_sin_cos()
    * \param polar_err2 (INPUT) same as the parameter in tof_to_scalar_Q()
    * \param a2 (OUTPUT) \f$=(4\pi m_n/h)^2\f$
    * \param b (OUTPUT) \f$=4\pi m_n\times pathlength\times 
@@ -144,7 +68,8 @@ namespace AxisManip
   std::string
   __tof_to_scalar_Q_static(const NumT pathlength,
                            const NumT pathlength_err2,
-                           const NumT polar,
+                           const double sin_half,
+                           const double cos_half,
                            const NumT polar_err2,
                            NumT & a2,
                            NumT & b,
@@ -155,9 +80,9 @@ namespace AxisManip
     a *= static_cast<NumT>(4. * PhysConst::PI);
     a2 = a * a;
 
-    NumT cang = static_cast<NumT>(std::cos(static_cast<double>(polar / 2.0)));
+    NumT cang = static_cast<NumT>(cos_half);
     NumT cang2 = cang * cang;
-    NumT sang = static_cast<NumT>(std::sin(static_cast<double>(polar / 2.0)));
+    NumT sang = static_cast<NumT>(sin_half);
     NumT sang2 = sang * sang;
 
     b = a * pathlength * sang;
@@ -172,6 +97,58 @@ namespace AxisManip
     return std::string(Nessi::EMPTY_WARN);
   }
 
+  /**
+   * \ingroup tof_to_scalar_Q
+   *
+   * This is a PRIVATE prologue (see \ref map_kernel) calculating the
+   * parameters of every pixel with __tof_to_scalar_Q_static(). The sines
+   * and cosines of all pixels are evaluated together.
+   *
+   * \param pathlength (INPUT) is the flight path of every pixel
+   * \param pathlength_err2 (INPUT) is the square of the uncertainty in
+   * every flight path
+   * \param polar (INPUT) is the polar angle of every pixel
+   * \param polar_err2 (INPUT) is the square of the uncertainty in every
+   * polar angle
+   * \param a2 (OUTPUT) same as the parameter in __tof_to_scalar_Q_static()
+   * \param b (OUTPUT) is the first of the parameters b of the pixels
+   * \param term1 (OUTPUT) is the first of the parameters term1 of the
+   * pixels
+   * \param term2 (OUTPUT) is the first of the parameters term2 of the
+   * pixels
+   * \param work (INPUT/OUTPUT) holds twice as many elements as there are
+   * pixels
+   * \param warnings (OUTPUT) is the sink receiving the warnings
+   */
+  template <typename NumT, typename SinkT>
+  void
+  __tof_to_scalar_Q_prologue(const Nessi::VectorView<const NumT> & pathlength,
+                             const Nessi::VectorView<const NumT> &
+                             pathlength_err2,
+                             const Nessi::VectorView<const NumT> & polar,
+                             const Nessi::VectorView<const NumT> & polar_err2,
+                             NumT & a2,
+                             NumT * b,
+                             NumT * term1,
+                             NumT * term2,
+                             double * work,
+                             SinkT & warnings)
+  {
+    std::size_t num_pixels = polar.size();
+    double * sin_half = work;
+    double * cos_half = work + num_pixels;
+    __half_angle_sin_cos(polar, sin_half, cos_half);
+
+    for (std::size_t p = 0; p < num_pixels; ++p)
+      {
+        warnings.report(__tof_to_scalar_Q_static(pathlength[p],
+                                                 pathlength_err2[p],
+                                                 sin_half[p], cos_half[p],
+                                                 polar_err2[p], a2, b[p],
+                                                 term1[p], term2[p]));
+      }
+  }
+
   /**
    * \ingroup tof_to_scalar_Q
    *
@@ -186,9 +163,10 @@ namespace AxisManip
    * \param b (INPUT) same as the parameter in __tof_to_scalar_Q_static()
    * \param term1 (INPUT) same as the parameter in __tof_to_scalar_Q_static()
    * \param term2 (INPUT) same as the parameter in __tof_to_scalar_Q_static()
+   * \param warnings (OUTPUT) is the sink receiving the warnings
    */
-  template <typename NumT>
-  std::string
+  template <typename NumT, typename SinkT>
+  void
   __tof_to_scalar_Q_dynamic(const NumT tof,
                             const NumT tof_err2,
                             NumT & Q,
@@ -196,7 +174,8 @@ namespace AxisManip
                             const NumT a2,
                             const NumT b,
                             const NumT term1,
-                            const NumT term2)
+                            const NumT term2,
+                            SinkT & warnings)
   {
     Q = b / tof;
 
@@ -205,8 +184,326 @@ namespace AxisManip
     Q_err2 = (term2 * tof_err2) / tof2;
     Q_err2 += term1;
     Q_err2 *= (a2 / tof2);
+  }
+
+  /**
+   * \ingroup tof_to_scalar_Q
+   *
+   * This is a PRIVATE map kernel (see \ref map_kernel) converting the
+   * time-of-flight of pixel \f$p\f$ with the parameters calculated for it
+   * by __tof_to_scalar_Q_prologue().
+   */
+  template <typename NumT>
+  class __TofToScalarQKernel
+  {
+  public:
+    /// Type of the elements
+    typedef NumT value_type;
+    /// Type of the geometry cache
+    typedef InstrumentGeometryCache<NumT> Cache;
+
+    /// Constructor keeping the parameters of the pixels
+    __TofToScalarQKernel(const NumT a2,
+                         const NumT * b,
+                         const NumT * term1,
+                         const NumT * term2)
+      : a2_(a2), b_array_(b), term1_array_(term1), term2_array_(term2),
+        b_(0), term1_(0), term2_(0)
+    { }
+
+    /// Constructor reading the parameters of the pixels from \p geometry
+    explicit
+    __TofToScalarQKernel(const Cache & geometry)
+      : a2_(geometry.ttsq_a2_),
+        b_array_(geometry.column(Cache::TTSQ_B)),
+        term1_array_(geometry.column(Cache::TTSQ_TERM1)),
+        term2_array_(geometry.column(Cache::TTSQ_TERM2)),
+        b_(0), term1_(0), term2_(0)
+    { }
+
+    /// Returns false, every pixel has its own geometry
+    bool is_uniform() const
+    {
+      return false;
+    }
+
+    /// Reads the parameters of pixel \p p
+    std::string setup(const std::size_t p)
+    {
+      b_ = b_array_[p];
+      term1_ = term1_array_[p];
+      term2_ = term2_array_[p];
+      return Nessi::EMPTY_WARN;
+    }
+
+    /// Converts one bin
+    template <typename SinkT>
+    void operator()(const NumT tof, const NumT tof_err2, NumT & Q,
+                    NumT & Q_err2, SinkT & warnings) const
+    {
+      __tof_to_scalar_Q_dynamic(tof, tof_err2, Q, Q_err2, a2_, b_, term1_,
+                                term2_, warnings);
+    }
+
+  private:
+    /// The parameter shared by all pixels
+    NumT a2_;
+    /// The parameters of every pixel
+    const NumT * b_array_;
+    /// The parameters of every pixel
+    const NumT * term1_array_;
+    /// The parameters of every pixel
+    const NumT * term2_array_;
+    /// The parameters of the current pixel
+    NumT b_;
+    /// The parameters of the current pixel
+    NumT term1_;
+    /// The parameters of the current pixel
+    NumT term2_;
+  };
+
+  // 3.17
+  template <typename NumT>
+  std::string
+  tof_to_scalar_Q(const Nessi::Vector<NumT> & tof,
+                  const Nessi::Vector<NumT> & tof_err2,
+                  const NumT pathlength,
+                  const NumT pathlength_err2,
+                  const NumT polar,
+                  const NumT polar_err2,
+                  Nessi::Vector<NumT> & Q,
+                  Nessi::Vector<NumT> & Q_err2,
+                  void *temp=NULL)
+  {
+    Nessi::DefaultWarningSink warnings;
+
+    // calculate the parameters of the pixel
+    NumT a2;
+    NumT b;
+    NumT term1;
+    NumT term2;
+    double work[2];
+    __tof_to_scalar_Q_prologue(Nessi::VectorView<const NumT>(&pathlength, 1),
+                               Nessi::VectorView<const NumT>(&pathlength_err2,
+                                                             1),
+                               Nessi::VectorView<const NumT>(&polar, 1),
+                               Nessi::VectorView<const NumT>(&polar_err2, 1),
+                               a2, &b, &term1, &term2, work, warnings);
+
+    // do the calculation
+    warnings.report(__map_kernel(__TofToScalarQKernel<NumT>(a2, &b, &term1,
+                                                            &term2),
+                                 tof.begin(), tof_err2.begin(), Q.begin(),
+                                 Q_err2.begin(), tof.size()));
+
+    return warnings.str();
+  }
+
+  // 3.17
+  template <typename NumT>
+  std::string
+  tof_to_scalar_Q(const NumT tof,
+                  const NumT tof_err2,
+                  const NumT pathlength,
+                  const NumT pathlength_err2,
+                  const NumT polar,
+                  const NumT polar_err2,
+                  NumT & Q,
+                  NumT & Q_err2,
+                  void *temp=NULL)
+  {
+    Nessi::DefaultWarningSink warnings;
+
+    // calculate the parameters of the pixel
+    NumT a2;
+    NumT b;
+    NumT term1;
+    NumT term2;
+    double work[2];
+    __tof_to_scalar_Q_prologue(Nessi::VectorView<const NumT>(&pathlength, 1),
+                               Nessi::VectorView<const NumT>(&pathlength_err2,
+                                                             1),
+                               Nessi::VectorView<const NumT>(&polar, 1),
+                               Nessi::VectorView<const NumT>(&polar_err2, 1),
+                               a2, &b, &term1, &term2, work, warnings);
+
+    // do the calculation
+    warnings.report(__map_kernel(__TofToScalarQKernel<NumT>(a2, &b, &term1,
+                                                            &term2),
+                                 &tof, &tof_err2, &Q, &Q_err2, 1));
+
+    return warnings.str();
+  }
+
+  // 3.17
+  template <typename NumT>
+  std::string
+  tof_to_scalar_Q(const Nessi::VectorView<const NumT> & tof,
+                  const Nessi::VectorView<const NumT> & tof_err2,
+                  const NumT pathlength,
+                  const NumT pathlength_err2,
+                  const NumT polar,
+                  const NumT polar_err2,
+                  const Nessi::VectorView<NumT> & Q,
+                  const Nessi::VectorView<NumT> & Q_err2,
+                  void *temp=NULL)
+  {
+    // check that the views are of proper size
+    size_t sz = tof.size();
+    if (tof_err2.size() != sz || Q.size() != sz || Q_err2.size() != sz)
+      {
+        throw std::invalid_argument(ttsq_func_str+" (view): views not the "
+                                    +"same size");
+      }
+
+    Nessi::DefaultWarningSink warnings;
+
+    // calculate the parameters of the pixel
+    NumT a2;
+    NumT b;
+    NumT term1;
+    NumT term2;
+    double work[2];
+    __tof_to_scalar_Q_prologue(Nessi::VectorView<const NumT>(&pathlength, 1),
+                               Nessi::VectorView<const NumT>(&pathlength_err2,
+                                                             1),
+                               Nessi::VectorView<const NumT>(&polar, 1),
+                               Nessi::VectorView<const NumT>(&polar_err2, 1),
+                               a2, &b, &term1, &term2, work, warnings);
+
+    // do the calculation
+    warnings.report(__map_kernel(__TofToScalarQKernel<NumT>(a2, &b, &term1,
+                                                            &term2),
+                                 tof, tof_err2, Q, Q_err2, sz));
+
+    return warnings.str();
+  }
 
-    return Nessi::EMPTY_WARN;
+  // 3.17
+  template <typename NumT>
+  std::string
+  tof_to_scalar_Q(const Nessi::ExecutionPolicy & policy,
+                  const Nessi::SpectrumBlock<NumT> & tof,
+                  const Nessi::Vector<NumT> & pathlength,
+                  const Nessi::Vector<NumT> & pathlength_err2,
+                  const Nessi::Vector<NumT> & polar,
+                  const Nessi::Vector<NumT> & polar_err2,
+                  Nessi::SpectrumBlock<NumT> & Q,
+                  void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!tof.same_shape(Q))
+      {
+        throw std::invalid_argument(ttsq_func_str+" (b,v): blocks not the "
+                                    +"same shape");
+      }
+
+    // check that the geometry arrays are of proper size
+    try
+      {
+        Utils::check_sizes_square(pathlength, pathlength_err2);
+      }
+    catch(std::invalid_argument &e)
+      {
+        throw std::invalid_argument(ttsq_func_str+" (b,v): pathlength "
+                                    +e.what());
+      }
+    try
+      {
+        Utils::check_sizes_square(polar, polar_err2);
+      }
+    catch(std::invalid_argument &e)
+      {
+        throw std::invalid_argument(ttsq_func_str+" (b,v): polar "
+                                    +e.what());
+      }
+    std::size_t num_pixels = tof.num_spectra();
+    if (pathlength.size() != num_pixels || polar.size() != num_pixels)
+      {
+        throw std::invalid_argument(ttsq_func_str+" (b,v): geometry not "
+                                    +"the number of spectra");
+      }
+
+    Nessi::DefaultWarningSink warnings;
+
+    // calculate the parameters of all pixels
+    NumT a2 = static_cast<NumT>(0.);
+    Nessi::Scratch<NumT> b(temp, num_pixels);
+    Nessi::Scratch<NumT> term1(temp, num_pixels);
+    Nessi::Scratch<NumT> term2(temp, num_pixels);
+    {
+      Nessi::Scratch<double> work(temp, 2 * num_pixels);
+      __tof_to_scalar_Q_prologue(Nessi::VectorView<const NumT>(pathlength),
+                                 Nessi::VectorView<const NumT>(
+                                                             pathlength_err2),
+                                 Nessi::VectorView<const NumT>(polar),
+                                 Nessi::VectorView<const NumT>(polar_err2),
+                                 a2, b.data(), term1.data(), term2.data(),
+                                 work.data(), warnings);
+    }
+
+    // every pixel is converted with its own geometry
+    warnings.report(__map_kernel(policy,
+                                 __TofToScalarQKernel<NumT>(a2, b.data(),
+                                                            term1.data(),
+                                                            term2.data()),
+                                 tof, Q));
+
+    return warnings.str();
+  }
+
+  // 3.17
+  template <typename NumT>
+  std::string
+  tof_to_scalar_Q(const Nessi::ExecutionPolicy & policy,
+                  const Nessi::SpectrumBlock<NumT> & tof,
+                  const InstrumentGeometryCache<NumT> & geometry,
+                  Nessi::SpectrumBlock<NumT> & Q,
+                  void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!tof.same_shape(Q))
+      {
+        throw std::invalid_argument(ttsq_func_str+" (b,c): blocks not the "
+                                    +"same shape");
+      }
+
+    // check that the cache describes the pixels
+    if (geometry.num_pixels() != tof.num_spectra())
+      {
+        throw std::invalid_argument(ttsq_func_str+" (b,c): geometry not "
+                                    +"the number of spectra");
+      }
+
+    // every pixel is converted with the parameters of the cache
+    return __map_kernel(policy, __TofToScalarQKernel<NumT>(geometry), tof,
+                        Q);
+  }
+
+  // 3.17
+  template <typename NumT>
+  std::string
+  tof_to_scalar_Q(const Nessi::SpectrumBlock<NumT> & tof,
+                  const InstrumentGeometryCache<NumT> & geometry,
+                  Nessi::SpectrumBlock<NumT> & Q,
+                  void *temp=NULL)
+  {
+    return tof_to_scalar_Q(Nessi::execution::seq, tof, geometry, Q, temp);
+  }
+
+  // 3.17
+  template <typename NumT>
+  std::string
+  tof_to_scalar_Q(const Nessi::SpectrumBlock<NumT> & tof,
+                  const Nessi::Vector<NumT> & pathlength,
+                  const Nessi::Vector<NumT> & pathlength_err2,
+                  const Nessi::Vector<NumT> & polar,
+                  const Nessi::Vector<NumT> & polar_err2,
+                  Nessi::SpectrumBlock<NumT> & Q,
+                  void *temp=NULL)
+  {
+    return tof_to_scalar_Q(Nessi::execution::seq, tof, pathlength,
+                           pathlength_err2, polar, polar_err2, Q, temp);
   }
 
 } // AxisManip
@@ -90,4 +90,141 @@ namespace AxisManip
                             double & wavelength,
                             double & wavelength_err2,
                             void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.15 for
+   * blocks
+   *
+   * \ingroup tof_to_wavelength
+   */
+  template std::string
+  tof_to_wavelength<float>(const Nessi::SpectrumBlock<float> & tof,
+                           const Nessi::Vector<float> & pathlength,
+                           const Nessi::Vector<float> & pathlength_err2,
+                           Nessi::SpectrumBlock<float> & wavelength,
+                           void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.15 for
+   * blocks with an execution policy
+   *
+   * \ingroup tof_to_wavelength
+   */
+  template std::string
+  tof_to_wavelength<float>(const Nessi::ExecutionPolicy & policy,
+                           const Nessi::SpectrumBlock<float> & tof,
+                           const Nessi::Vector<float> & pathlength,
+                           const Nessi::Vector<float> & pathlength_err2,
+                           Nessi::SpectrumBlock<float> & wavelength,
+                           void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.15 for blocks
+   *
+   * \ingroup tof_to_wavelength
+   */
+  template std::string
+  tof_to_wavelength<double>(const Nessi::SpectrumBlock<double> & tof,
+                            const Nessi::Vector<double> & pathlength,
+                            const Nessi::Vector<double> & pathlength_err2,
+                            Nessi::SpectrumBlock<double> & wavelength,
+                            void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.15 for blocks with an execution policy
+   *
+   * \ingroup tof_to_wavelength
+   */
+  template std::string
+  tof_to_wavelength<double>(const Nessi::ExecutionPolicy & policy,
+                            const Nessi::SpectrumBlock<double> & tof,
+                            const Nessi::Vector<double> & pathlength,
+                            const Nessi::Vector<double> & pathlength_err2,
+                            Nessi::SpectrumBlock<double> & wavelength,
+                            void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.15 for
+   * views
+   *
+   * \ingroup tof_to_wavelength
+   */
+  template std::string
+  tof_to_wavelength<float>(const Nessi::VectorView<const float> & tof,
+                           const Nessi::VectorView<const float> & tof_err2,
+                           const float pathlength,
+                           const float pathlength_err2,
+                           const Nessi::VectorView<float> & wavelength,
+                           const Nessi::VectorView<float> & wavelength_err2,
+                           void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.15 for views
+   *
+   * \ingroup tof_to_wavelength
+   */
+  template std::string
+  tof_to_wavelength<double>(const Nessi::VectorView<const double> & tof,
+                            const Nessi::VectorView<const double> & tof_err2,
+                            const double pathlength,
+                            const double pathlength_err2,
+                            const Nessi::VectorView<double> & wavelength,
+                            const Nessi::VectorView<double> &
+                            wavelength_err2,
+                            void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.15 for
+   * blocks with a geometry cache
+   *
+   * \ingroup tof_to_wavelength
+   */
+  template std::string
+  tof_to_wavelength<float>(const Nessi::SpectrumBlock<float> & tof,
+                           const InstrumentGeometryCache<float> & geometry,
+                           Nessi::SpectrumBlock<float> & wavelength,
+                           void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.15 for
+   * blocks with a geometry cache and an execution
+   * policy
+   *
+   * \ingroup tof_to_wavelength
+   */
+  template std::string
+  tof_to_wavelength<float>(const Nessi::ExecutionPolicy & policy,
+                           const Nessi::SpectrumBlock<float> & tof,
+                           const InstrumentGeometryCache<float> & geometry,
+                           Nessi::SpectrumBlock<float> & wavelength,
+                           void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.15 for blocks with a geometry cache
+   *
+   * \ingroup tof_to_wavelength
+   */
+  template std::string
+  tof_to_wavelength<double>(const Nessi::SpectrumBlock<double> & tof,
+                            const InstrumentGeometryCache<double> & geometry,
+                            Nessi::SpectrumBlock<double> & wavelength,
+                            void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.15 for blocks with a geometry cache and an execution
+   * policy
+   *
+   * \ingroup tof_to_wavelength
+   */
+  template std::string
+  tof_to_wavelength<double>(const Nessi::ExecutionPolicy & policy,
+                            const Nessi::SpectrumBlock<double> & tof,
+                            const InstrumentGeometryCache<double> & geometry,
+                            Nessi::SpectrumBlock<double> & wavelength,
+                            void *temp);
 } // AxisManip
@@ -32,7 +32,9 @@
 
 #include "constants.hpp"
 #include "conversions.hpp"
+#include "map_kernel.hpp"
 #include "nessi_warn.hpp"
+#include "nessi_workspace.hpp"
 #include "size_checks.hpp"
 #include <stdexcept>
 
@@ -41,6 +43,78 @@ namespace AxisManip
   /// String for holding the tof_to_wavelength function name
   const std::string ttw_func_str = "AxisManip::tof_to_wavelength";
 
+  /**
+   * \ingroup tof_to_wavelength
+   *
+   * This is a PRIVATE map kernel (see \ref map_kernel) converting the
+   * time-of-flight of pixel \f$p\f$ with the constants calculated for it
+   * by __tof_to_wavelength_prologue().
+   */
+  template <typename NumT>
+  class __TofToWavelengthKernel
+  {
+  public:
+    /// Type of the elements
+    typedef NumT value_type;
+    /// Type of the geometry cache
+    typedef InstrumentGeometryCache<NumT> Cache;
+
+    /// Constructor keeping the constants of the pixels
+    __TofToWavelengthKernel(const NumT * a,
+                            const NumT * a2,
+                            const NumT * a_err2)
+      : a_array_(a), a2_array_(a2), a_err2_array_(a_err2), a_(0), a2_(0),
+        a_err2_(0)
+    { }
+
+    /// Constructor reading the constants of the pixels from \p geometry
+    explicit
+    __TofToWavelengthKernel(const Cache & geometry)
+      : a_array_(geometry.column(Cache::TTW_A)),
+        a2_array_(geometry.column(Cache::TTW_A2)),
+        a_err2_array_(geometry.column(Cache::TTW_A_ERR2)),
+        a_(0), a2_(0), a_err2_(0)
+    { }
+
+    /// Returns false, every pixel has its own flight path
+    bool is_uniform() const
+    {
+      return false;
+    }
+
+    /// Reads the constants of pixel \p p
+    std::string setup(const std::size_t p)
+    {
+      a_ = a_array_[p];
+      a2_ = a2_array_[p];
+      a_err2_ = a_err2_array_[p];
+      return Nessi::EMPTY_WARN;
+    }
+
+    /// Converts one bin
+    template <typename SinkT>
+    void operator()(const NumT tof, const NumT tof_err2, NumT & wavelength,
+                    NumT & wavelength_err2, SinkT & warnings) const
+    {
+      __tof_to_wavelength_dynamic(tof, tof_err2, a_, a2_, a_err2_,
+                                  wavelength, wavelength_err2, warnings);
+    }
+
+  private:
+    /// The constants of every pixel
+    const NumT * a_array_;
+    /// The constants of every pixel
+    const NumT * a2_array_;
+    /// The constants of every pixel
+    const NumT * a_err2_array_;
+    /// The constants of the current pixel
+    NumT a_;
+    /// The constants of the current pixel
+    NumT a2_;
+    /// The constants of the current pixel
+    NumT a_err2_;
+  };
+
   // 3.15
   template <typename NumT>
   std::string
@@ -82,28 +156,25 @@ namespace AxisManip
         throw std::invalid_argument(ttw_func_str+" (v,v): tof "+e.what());
       }
 
-    std::string retstr(Nessi::EMPTY_WARN); // the warning string
+    Nessi::DefaultWarningSink warnings;
 
-    // allocate local variables
+    // calculate the constants of the pixel
     NumT a;
     NumT a2;
     NumT a_err2;
-
-    // fill the local variables
-    retstr += __tof_to_wavelength_static(pathlength, pathlength_err2,
-                                         a, a2, a_err2);
+    __tof_to_wavelength_prologue(Nessi::VectorView<const NumT>(&pathlength, 1),
+                                 Nessi::VectorView<const NumT>(
+                                                        &pathlength_err2, 1),
+                                 &a, &a2, &a_err2, warnings);
 
     // do the calculation
-    size_t size_tof = tof.size();
-    for (size_t i = 0; i < size_tof; ++i)
-      {
-        retstr += __tof_to_wavelength_dynamic(tof[i], tof_err2[i],
-                                              a, a2, a_err2,
-                                              wavelength[i],
-                                              wavelength_err2[i]);
-      }
+    warnings.report(__map_kernel(__TofToWavelengthKernel<NumT>(&a, &a2,
+                                                               &a_err2),
+                                 tof.begin(), tof_err2.begin(),
+                                 wavelength.begin(), wavelength_err2.begin(),
+                                 tof.size()));
 
-    return retstr;
+    return warnings.str();
   }
 
   // 3.15
@@ -117,22 +188,77 @@ namespace AxisManip
                     NumT & wavelength_err2,
                     void *temp=NULL)
   {
-    std::string retstr(Nessi::EMPTY_WARN); // the warning string
+    Nessi::DefaultWarningSink warnings;
 
-    // allocate local variables
+    // calculate the constants of the pixel
     NumT a;
     NumT a2;
     NumT a_err2;
+    __tof_to_wavelength_prologue(Nessi::VectorView<const NumT>(&pathlength, 1),
+                                 Nessi::VectorView<const NumT>(
+                                                        &pathlength_err2, 1),
+                                 &a, &a2, &a_err2, warnings);
+
+    // do the calculation
+    warnings.report(__map_kernel(__TofToWavelengthKernel<NumT>(&a, &a2,
+                                                               &a_err2),
+                                 &tof, &tof_err2, &wavelength,
+                                 &wavelength_err2, 1));
+
+    return warnings.str();
+  }
+
+  // 3.15
+  template <typename NumT>
+  std::string
+  tof_to_wavelength(const Nessi::SpectrumBlock<NumT> & tof,
+                    const Nessi::Vector<NumT> & pathlength,
+                    const Nessi::Vector<NumT> & pathlength_err2,
+                    Nessi::SpectrumBlock<NumT> & wavelength,
+                    void *temp=NULL)
+  {
+    return tof_to_wavelength(Nessi::execution::seq, tof, pathlength,
+                             pathlength_err2, wavelength, temp);
+  }
+
+  // 3.15
+  template <typename NumT>
+  std::string
+  tof_to_wavelength(const Nessi::VectorView<const NumT> & tof,
+                    const Nessi::VectorView<const NumT> & tof_err2,
+                    const NumT pathlength,
+                    const NumT pathlength_err2,
+                    const Nessi::VectorView<NumT> & wavelength,
+                    const Nessi::VectorView<NumT> & wavelength_err2,
+                    void *temp=NULL)
+  {
+    // check that the views are of proper size
+    size_t size_tof = tof.size();
+    if (tof_err2.size() != size_tof || wavelength.size() != size_tof
+        || wavelength_err2.size() != size_tof)
+      {
+        throw std::invalid_argument(ttw_func_str+" (view): views not the "
+                                    +"same size");
+      }
 
-    // fill the local variables
-    retstr += __tof_to_wavelength_static(pathlength, pathlength_err2,
-                                         a, a2, a_err2);
+    Nessi::DefaultWarningSink warnings;
+
+    // calculate the constants of the pixel
+    NumT a;
+    NumT a2;
+    NumT a_err2;
+    __tof_to_wavelength_prologue(Nessi::VectorView<const NumT>(&pathlength, 1),
+                                 Nessi::VectorView<const NumT>(
+                                                        &pathlength_err2, 1),
+                                 &a, &a2, &a_err2, warnings);
 
     // do the calculation
-    retstr += __tof_to_wavelength_dynamic(tof, tof_err2, a, a2, a_err2,
-                                          wavelength, wavelength_err2);
+    warnings.report(__map_kernel(__TofToWavelengthKernel<NumT>(&a, &a2,
+                                                               &a_err2),
+                                 tof, tof_err2, wavelength,
+                                 wavelength_err2, size_tof));
 
-    return retstr;
+    return warnings.str();
   }
 
   /**
@@ -168,6 +294,42 @@ namespace AxisManip
     return Nessi::EMPTY_WARN;
   }
 
+  /**
+   * \ingroup tof_to_wavelength
+   *
+   * This is a PRIVATE prologue (see \ref map_kernel) calculating the
+   * constants of every pixel with __tof_to_wavelength_static().
+   *
+   * \param pathlength (INPUT) is the flight path of every pixel
+   * \param pathlength_err2 (INPUT) is the square of the uncertainty in
+   * every flight path
+   * \param a (OUTPUT) is the first of the constants a of the pixels
+   * \param a2 (OUTPUT) is the first of the constants a2 of the pixels
+   * \param a_err2 (OUTPUT) is the first of the constants a_err2 of the
+   * pixels
+   * \param warnings (OUTPUT) is the sink receiving the warnings
+   */
+  template <typename NumT, typename SinkT>
+  void
+  __tof_to_wavelength_prologue(const Nessi::VectorView<const NumT> &
+                               pathlength,
+                               const Nessi::VectorView<const NumT> &
+                               pathlength_err2,
+                               NumT * a,
+                               NumT * a2,
+                               NumT * a_err2,
+                               SinkT & warnings)
+  {
+    std::size_t num_pixels = pathlength.size();
+    for (std::size_t p = 0; p < num_pixels; ++p)
+      {
+        warnings.report(__tof_to_wavelength_static(pathlength[p],
+                                                   pathlength_err2[p],
+                                                   a[p], a2[p],
+                                                   a_err2[p]));
+      }
+  }
+
   /**
    * \ingroup tof_to_wavelength
    *
@@ -188,23 +350,116 @@ namespace AxisManip
    * tof_to_wavelength()
    * \param  wavelength_err2 (OUTPUT) same as the parameter in
    * tof_to_wavelength()
+   * \param warnings (OUTPUT) is the sink receiving the warnings
    */
-  template <typename NumT>
-  std::string  __tof_to_wavelength_dynamic(const NumT tof,
-                                           const NumT tof_err2,
-                                           const NumT a,
-                                           const NumT a2,
-                                           const NumT a_err2,
-                                           NumT & wavelength,
-                                           NumT & wavelength_err2)
+  template <typename NumT, typename SinkT>
+  void __tof_to_wavelength_dynamic(const NumT tof,
+                                   const NumT tof_err2,
+                                   const NumT a,
+                                   const NumT a2,
+                                   const NumT a_err2,
+                                   NumT & wavelength,
+                                   NumT & wavelength_err2,
+                                   SinkT & warnings)
   {
     // calculate the value
     wavelength = a * tof;
 
     // calculate the uncertainty
     wavelength_err2 = (a2*tof_err2) + ((tof*tof)*a_err2);
+  }
 
-    return Nessi::EMPTY_WARN;
+  // 3.15
+  template <typename NumT>
+  std::string
+  tof_to_wavelength(const Nessi::ExecutionPolicy & policy,
+                    const Nessi::SpectrumBlock<NumT> & tof,
+                    const Nessi::Vector<NumT> & pathlength,
+                    const Nessi::Vector<NumT> & pathlength_err2,
+                    Nessi::SpectrumBlock<NumT> & wavelength,
+                    void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!tof.same_shape(wavelength))
+      {
+        throw std::invalid_argument(ttw_func_str+" (b,v): blocks not the "
+                                    +"same shape");
+      }
+
+    // check that the pathlength arrays are of proper size
+    try
+      {
+        Utils::check_sizes_square(pathlength, pathlength_err2);
+      }
+    catch(std::invalid_argument &e)
+      {
+        throw std::invalid_argument(ttw_func_str+" (b,v): pathlength "
+                                    +e.what());
+      }
+    if (pathlength.size() != tof.num_spectra())
+      {
+        throw std::invalid_argument(ttw_func_str+" (b,v): pathlength not "
+                                    +"the number of spectra");
+      }
+
+    Nessi::DefaultWarningSink warnings;
+
+    // calculate the constants of all pixels
+    std::size_t num_pixels = tof.num_spectra();
+    Nessi::Scratch<NumT> a(temp, num_pixels);
+    Nessi::Scratch<NumT> a2(temp, num_pixels);
+    Nessi::Scratch<NumT> a_err2(temp, num_pixels);
+    __tof_to_wavelength_prologue(Nessi::VectorView<const NumT>(pathlength),
+                                 Nessi::VectorView<const NumT>(
+                                                           pathlength_err2),
+                                 a.data(), a2.data(), a_err2.data(),
+                                 warnings);
+
+    // every pixel is converted with its own flight path
+    __TofToWavelengthKernel<NumT> kernel(a.data(), a2.data(), a_err2.data());
+    warnings.report(__map_kernel(policy, kernel, tof, wavelength));
+
+    return warnings.str();
+  }
+
+  // 3.15
+  template <typename NumT>
+  std::string
+  tof_to_wavelength(const Nessi::ExecutionPolicy & policy,
+                    const Nessi::SpectrumBlock<NumT> & tof,
+                    const InstrumentGeometryCache<NumT> & geometry,
+                    Nessi::SpectrumBlock<NumT> & wavelength,
+                    void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!tof.same_shape(wavelength))
+      {
+        throw std::invalid_argument(ttw_func_str+" (b,c): blocks not the "
+                                    +"same shape");
+      }
+
+    // check that the cache describes the pixels
+    if (geometry.num_pixels() != tof.num_spectra())
+      {
+        throw std::invalid_argument(ttw_func_str+" (b,c): geometry not "
+                                    +"the number of spectra");
+      }
+
+    // every pixel is converted with the constants of the cache
+    return __map_kernel(policy, __TofToWavelengthKernel<NumT>(geometry),
+                        tof, wavelength);
+  }
+
+  // 3.15
+  template <typename NumT>
+  std::string
+  tof_to_wavelength(const Nessi::SpectrumBlock<NumT> & tof,
+                    const InstrumentGeometryCache<NumT> & geometry,
+                    Nessi::SpectrumBlock<NumT> & wavelength,
+                    void *temp=NULL)
+  {
+    return tof_to_wavelength(Nessi::execution::seq, tof, geometry,
+                             wavelength, temp);
   }
 } // AxisManip
 
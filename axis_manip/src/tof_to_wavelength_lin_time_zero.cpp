@@ -108,4 +108,135 @@ namespace AxisManip
                                           double & wavelength,
                                           double & wavelength_err2,
                                           void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.50 for
+   * blocks
+   *
+   * \ingroup tof_to_wavelength_lin_time_zero
+   */
+  template std::string
+  tof_to_wavelength_lin_time_zero<float>(const Nessi::SpectrumBlock<float> &
+                                         tof,
+                                         const Nessi::Vector<float> &
+                                         pathlength,
+                                         const Nessi::Vector<float> &
+                                         pathlength_err2,
+                                         const float time_0_slope,
+                                         const float time_0_slope_err2,
+                                         const float time_0_offset,
+                                         const float time_0_offset_err2,
+                                         Nessi::SpectrumBlock<float> &
+                                         wavelength,
+                                         void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.50 for
+   * blocks with an execution policy
+   *
+   * \ingroup tof_to_wavelength_lin_time_zero
+   */
+  template std::string
+  tof_to_wavelength_lin_time_zero<float>(const Nessi::ExecutionPolicy & policy,
+                                         const Nessi::SpectrumBlock<float> &
+                                         tof,
+                                         const Nessi::Vector<float> &
+                                         pathlength,
+                                         const Nessi::Vector<float> &
+                                         pathlength_err2,
+                                         const float time_0_slope,
+                                         const float time_0_slope_err2,
+                                         const float time_0_offset,
+                                         const float time_0_offset_err2,
+                                         Nessi::SpectrumBlock<float> &
+                                         wavelength,
+                                         void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.50 for blocks
+   *
+   * \ingroup tof_to_wavelength_lin_time_zero
+   */
+  template std::string
+  tof_to_wavelength_lin_time_zero<double>(const Nessi::SpectrumBlock<double> &
+                                          tof,
+                                          const Nessi::Vector<double> &
+                                          pathlength,
+                                          const Nessi::Vector<double> &
+                                          pathlength_err2,
+                                          const double time_0_slope,
+                                          const double time_0_slope_err2,
+                                          const double time_0_offset,
+                                          const double time_0_offset_err2,
+                                          Nessi::SpectrumBlock<double> &
+                                          wavelength,
+                                          void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.50 for blocks with an execution policy
+   *
+   * \ingroup tof_to_wavelength_lin_time_zero
+   */
+  template std::string
+  tof_to_wavelength_lin_time_zero<double>(const Nessi::ExecutionPolicy &
+                                          policy,
+                                          const Nessi::SpectrumBlock<double> &
+                                          tof,
+                                          const Nessi::Vector<double> &
+                                          pathlength,
+                                          const Nessi::Vector<double> &
+                                          pathlength_err2,
+                                          const double time_0_slope,
+                                          const double time_0_slope_err2,
+                                          const double time_0_offset,
+                                          const double time_0_offset_err2,
+                                          Nessi::SpectrumBlock<double> &
+                                          wavelength,
+                                          void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.50 for views
+   *
+   * \ingroup tof_to_wavelength_lin_time_zero
+   */
+  template std::string
+  tof_to_wavelength_lin_time_zero<float>(const Nessi::VectorView<const float> &
+                                         tof,
+                                         const Nessi::VectorView<const float> &
+                                         tof_err2,
+                                         const float pathlength,
+                                         const float pathlength_err2,
+                                         const float time_0_slope,
+                                         const float time_0_slope_err2,
+                                         const float time_0_offset,
+                                         const float time_0_offset_err2,
+                                         const Nessi::VectorView<float> &
+                                         wavelength,
+                                         const Nessi::VectorView<float> &
+                                         wavelength_err2,
+                                         void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.50 for views
+   *
+   * \ingroup tof_to_wavelength_lin_time_zero
+   */
+  template std::string
+  tof_to_wavelength_lin_time_zero<double>(
+                                const Nessi::VectorView<const double> & tof,
+                                const Nessi::VectorView<const double> &
+                                tof_err2,
+                                const double pathlength,
+                                const double pathlength_err2,
+                                const double time_0_slope,
+                                const double time_0_slope_err2,
+                                const double time_0_offset,
+                                const double time_0_offset_err2,
+                                const Nessi::VectorView<double> & wavelength,
+                                const Nessi::VectorView<double> &
+                                wavelength_err2,
+                                void *temp);
 } // AxisManip
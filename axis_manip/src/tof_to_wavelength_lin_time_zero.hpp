@@ -32,6 +32,7 @@
 
 #include "constants.hpp"
 #include "conversions.hpp"
+#include "map_kernel.hpp"
 #include "nessi_warn.hpp"
 #include "size_checks.hpp"
 #include <stdexcept>
@@ -42,6 +43,87 @@ namespace AxisManip
   const std::string ttwltz_func_str = \
   "AxisManip::tof_to_wavelength_lin_time_zero";
 
+  /**
+   * \ingroup tof_to_wavelength_lin_time_zero
+   *
+   * This is a PRIVATE map kernel (see \ref map_kernel) converting the
+   * time-of-flight of pixel \f$p\f$ with the flight path \f$L[p]\f$. The
+   * time zero parameters are shared by all pixels.
+   */
+  template <typename NumT>
+  class __TofToWavelengthLinTimeZeroKernel
+  {
+  public:
+    /// Type of the elements
+    typedef NumT value_type;
+
+    /// Constructor keeping the parameters of the conversion
+    __TofToWavelengthLinTimeZeroKernel(const Nessi::VectorView<const NumT> &
+                                       pathlength,
+                                       const Nessi::VectorView<const NumT> &
+                                       pathlength_err2,
+                                       const NumT time_0_slope,
+                                       const NumT time_0_slope_err2,
+                                       const NumT time_0_offset,
+                                       const NumT time_0_offset_err2)
+      : pathlength_(pathlength), pathlength_err2_(pathlength_err2),
+        time_0_slope_(time_0_slope), time_0_slope_err2_(time_0_slope_err2),
+        time_0_offset_(time_0_offset),
+        time_0_offset_err2_(time_0_offset_err2),
+        a_(0), a2_(0), b_(0), c_(0)
+    { }
+
+    /// Returns false, every pixel has its own flight path
+    bool is_uniform() const
+    {
+      return false;
+    }
+
+    /// Calculates the constants of pixel \p p
+    std::string setup(const std::size_t p)
+    {
+      return __tof_to_wavelength_lin_time_zero_static(pathlength_[p],
+                                                      pathlength_err2_[p],
+                                                      time_0_slope_,
+                                                      time_0_slope_err2_,
+                                                      time_0_offset_,
+                                                      a_, a2_, b_, c_);
+    }
+
+    /// Converts one bin
+    template <typename SinkT>
+    void operator()(const NumT tof, const NumT tof_err2, NumT & wavelength,
+                    NumT & wavelength_err2, SinkT & warnings) const
+    {
+      __tof_to_wavelength_lin_time_zero_dynamic(tof, tof_err2,
+                                                time_0_offset_err2_,
+                                                a_, a2_, b_, c_, wavelength,
+                                                wavelength_err2, warnings);
+    }
+
+  private:
+    /// The flight path of every pixel
+    Nessi::VectorView<const NumT> pathlength_;
+    /// The squared uncertainty of every flight path
+    Nessi::VectorView<const NumT> pathlength_err2_;
+    /// The slope of the time zero shared by all pixels
+    NumT time_0_slope_;
+    /// The squared uncertainty of the slope
+    NumT time_0_slope_err2_;
+    /// The offset of the time zero shared by all pixels
+    NumT time_0_offset_;
+    /// The squared uncertainty of the offset
+    NumT time_0_offset_err2_;
+    /// The constants of the current pixel
+    NumT a_;
+    /// The constants of the current pixel
+    NumT a2_;
+    /// The constants of the current pixel
+    NumT b_;
+    /// The constants of the current pixel
+    NumT c_;
+  };
+
   // 3.50
   template <typename NumT>
   std::string
@@ -87,36 +169,14 @@ namespace AxisManip
         throw std::invalid_argument(ttwltz_func_str+" (v,v): tof "+e.what());
       }
 
-    std::string retstr(Nessi::EMPTY_WARN); // the warning string
-
-    // allocate local variables
-    NumT a;
-    NumT a2;
-    NumT b;
-    NumT c;
-
-    // fill the local variables
-    retstr += __tof_to_wavelength_lin_time_zero_static(pathlength, 
-                                                       pathlength_err2,
-                                                       time_0_slope,
-                                                       time_0_slope_err2,
-                                                       time_0_offset,
-                                                       a, a2, b, c);
-
     // do the calculation
-    size_t size_tof = tof.size();
-    for (size_t i = 0; i < size_tof; ++i)
-      {
-        retstr += __tof_to_wavelength_lin_time_zero_dynamic(
-                                                         tof[i], 
-                                                         tof_err2[i],
-                                                         time_0_offset_err2,
-                                                         a, a2, b, c,
-                                                         wavelength[i],
-                                                         wavelength_err2[i]);
-      }
-
-    return retstr;
+    return __map_kernel(__TofToWavelengthLinTimeZeroKernel<NumT>(
+                          Nessi::VectorView<const NumT>(&pathlength, 1),
+                          Nessi::VectorView<const NumT>(&pathlength_err2, 1),
+                          time_0_slope, time_0_slope_err2,
+                          time_0_offset, time_0_offset_err2),
+                        tof.begin(), tof_err2.begin(), wavelength.begin(),
+                        wavelength_err2.begin(), tof.size());
   }
 
   // 3.50
@@ -134,30 +194,48 @@ namespace AxisManip
                                   NumT & wavelength_err2,
                                   void *temp=NULL)
   {
-    std::string retstr(Nessi::EMPTY_WARN); // the warning string
-
-    // allocate local variables
-    NumT a;
-    NumT a2;
-    NumT b;
-    NumT c;
+    // do the calculation
+    return __map_kernel(__TofToWavelengthLinTimeZeroKernel<NumT>(
+                          Nessi::VectorView<const NumT>(&pathlength, 1),
+                          Nessi::VectorView<const NumT>(&pathlength_err2, 1),
+                          time_0_slope, time_0_slope_err2,
+                          time_0_offset, time_0_offset_err2),
+                        &tof, &tof_err2, &wavelength, &wavelength_err2, 1);
+  }
 
-    // fill the local variables
-    retstr += __tof_to_wavelength_lin_time_zero_static(pathlength, 
-                                                       pathlength_err2,
-                                                       time_0_slope,
-                                                       time_0_slope_err2,
-                                                       time_0_offset,
-                                                       a, a2, b, c);
+  // 3.50
+  template <typename NumT>
+  std::string
+  tof_to_wavelength_lin_time_zero(const Nessi::VectorView<const NumT> & tof,
+                                  const Nessi::VectorView<const NumT> &
+                                  tof_err2,
+                                  const NumT pathlength,
+                                  const NumT pathlength_err2,
+                                  const NumT time_0_slope,
+                                  const NumT time_0_slope_err2,
+                                  const NumT time_0_offset,
+                                  const NumT time_0_offset_err2,
+                                  const Nessi::VectorView<NumT> & wavelength,
+                                  const Nessi::VectorView<NumT> &
+                                  wavelength_err2,
+                                  void *temp=NULL)
+  {
+    // check that the views are of proper size
+    size_t sz = tof.size();
+    if (tof_err2.size() != sz || wavelength.size() != sz
+        || wavelength_err2.size() != sz)
+      {
+        throw std::invalid_argument(ttwltz_func_str+" (view): views not the "
+                                    +"same size");
+      }
 
     // do the calculation
-    retstr += __tof_to_wavelength_lin_time_zero_dynamic(tof, tof_err2, 
-                                                        time_0_offset_err2,
-                                                        a, a2, b, c,
-                                                        wavelength, 
-                                                        wavelength_err2);
-
-    return retstr;
+    return __map_kernel(__TofToWavelengthLinTimeZeroKernel<NumT>(
+                          Nessi::VectorView<const NumT>(&pathlength, 1),
+                          Nessi::VectorView<const NumT>(&pathlength_err2, 1),
+                          time_0_slope, time_0_slope_err2,
+                          time_0_offset, time_0_offset_err2),
+                        tof, tof_err2, wavelength, wavelength_err2, sz);
   }
 
   /**
@@ -234,18 +312,20 @@ namespace AxisManip
    * tof_to_wavelength_lin_time_zero()
    * \param wavelength_err2 (OUTPUT) same as the parameter in
    * tof_to_wavelength_lin_time_zero()
+   * \param warnings (OUTPUT) is the sink receiving the warnings
    */
-  template <typename NumT>
-  std::string  __tof_to_wavelength_lin_time_zero_dynamic(
-                                                const NumT tof,
-                                                const NumT tof_err2,
-                                                const NumT time_0_offset_err2,
-                                                const NumT a,
-                                                const NumT a2,
-                                                const NumT b,
-                                                const NumT c,
-                                                NumT & wavelength,
-                                                NumT & wavelength_err2)
+  template <typename NumT, typename SinkT>
+  void
+  __tof_to_wavelength_lin_time_zero_dynamic(const NumT tof,
+                                            const NumT tof_err2,
+                                            const NumT time_0_offset_err2,
+                                            const NumT a,
+                                            const NumT a2,
+                                            const NumT b,
+                                            const NumT c,
+                                            NumT & wavelength,
+                                            NumT & wavelength_err2,
+                                            SinkT & warnings)
   {
     // calculate the value
     wavelength = a * tof - b;
@@ -254,8 +334,74 @@ namespace AxisManip
     NumT wavelength2 = wavelength * wavelength;
     wavelength_err2 = tof_err2 + time_0_offset_err2 + (wavelength2 * c);
     wavelength_err2 *= a2;
+  }
 
-    return Nessi::EMPTY_WARN;
+  // 3.50
+  template <typename NumT>
+  std::string
+  tof_to_wavelength_lin_time_zero(const Nessi::SpectrumBlock<NumT> & tof,
+                                  const Nessi::Vector<NumT> & pathlength,
+                                  const Nessi::Vector<NumT> & pathlength_err2,
+                                  const NumT time_0_slope,
+                                  const NumT time_0_slope_err2,
+                                  const NumT time_0_offset,
+                                  const NumT time_0_offset_err2,
+                                  Nessi::SpectrumBlock<NumT> & wavelength,
+                                  void *temp=NULL)
+  {
+    return tof_to_wavelength_lin_time_zero(Nessi::execution::seq, tof,
+                                           pathlength, pathlength_err2,
+                                           time_0_slope, time_0_slope_err2,
+                                           time_0_offset, time_0_offset_err2,
+                                           wavelength, temp);
+  }
+
+  // 3.50
+  template <typename NumT>
+  std::string
+  tof_to_wavelength_lin_time_zero(const Nessi::ExecutionPolicy & policy,
+                                  const Nessi::SpectrumBlock<NumT> & tof,
+                                  const Nessi::Vector<NumT> & pathlength,
+                                  const Nessi::Vector<NumT> & pathlength_err2,
+                                  const NumT time_0_slope,
+                                  const NumT time_0_slope_err2,
+                                  const NumT time_0_offset,
+                                  const NumT time_0_offset_err2,
+                                  Nessi::SpectrumBlock<NumT> & wavelength,
+                                  void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!tof.same_shape(wavelength))
+      {
+        throw std::invalid_argument(ttwltz_func_str+" (b,v): blocks not the "
+                                    +"same shape");
+      }
+
+    // check that the pathlength arrays are of proper size
+    try
+      {
+        Utils::check_sizes_square(pathlength, pathlength_err2);
+      }
+    catch(std::invalid_argument &e)
+      {
+        throw std::invalid_argument(ttwltz_func_str+" (b,v): "
+                                    +"pathlength "+e.what());
+      }
+    if (pathlength.size() != tof.num_spectra())
+      {
+        throw std::invalid_argument(ttwltz_func_str+" (b,v): geometry not "
+                                    +"the number of spectra");
+      }
+
+    // every pixel is converted with its own flight path
+    return __map_kernel(policy,
+                        __TofToWavelengthLinTimeZeroKernel<NumT>(
+                                                  pathlength, pathlength_err2,
+                                                  time_0_slope,
+                                                  time_0_slope_err2,
+                                                  time_0_offset,
+                                                  time_0_offset_err2),
+                        tof, wavelength);
   }
 } // AxisManip
 
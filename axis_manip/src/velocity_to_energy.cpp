@@ -82,4 +82,76 @@ namespace AxisManip
                              double & energy,
                              double & energy_err2,
                              void *temp);
+  /**
+   * This is the float declaration of the function defined in 3.21 for
+   * blocks
+   *
+   * \ingroup velocity_to_energy
+   */
+  template std::string
+  velocity_to_energy<float>(const Nessi::SpectrumBlock<float> & velocity,
+                            Nessi::SpectrumBlock<float> & energy,
+                            void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.21 for
+   * blocks with an execution policy
+   *
+   * \ingroup velocity_to_energy
+   */
+  template std::string
+  velocity_to_energy<float>(const Nessi::ExecutionPolicy & policy,
+                            const Nessi::SpectrumBlock<float> & velocity,
+                            Nessi::SpectrumBlock<float> & energy,
+                            void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.21 for blocks
+   *
+   * \ingroup velocity_to_energy
+   */
+  template std::string
+  velocity_to_energy<double>(const Nessi::SpectrumBlock<double> & velocity,
+                             Nessi::SpectrumBlock<double> & energy,
+                             void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.21 for blocks with an execution policy
+   *
+   * \ingroup velocity_to_energy
+   */
+  template std::string
+  velocity_to_energy<double>(const Nessi::ExecutionPolicy & policy,
+                             const Nessi::SpectrumBlock<double> & velocity,
+                             Nessi::SpectrumBlock<double> & energy,
+                             void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.21 for views
+   *
+   * \ingroup velocity_to_energy
+   */
+  template std::string
+  velocity_to_energy<float>(const Nessi::VectorView<const float> & velocity,
+                            const Nessi::VectorView<const float> &
+                            velocity_err2,
+                            const Nessi::VectorView<float> & energy,
+                            const Nessi::VectorView<float> & energy_err2,
+                            void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.21 for views
+   *
+   * \ingroup velocity_to_energy
+   */
+  template std::string
+  velocity_to_energy<double>(const Nessi::VectorView<const double> & velocity,
+                             const Nessi::VectorView<const double> &
+                             velocity_err2,
+                             const Nessi::VectorView<double> & energy,
+                             const Nessi::VectorView<double> & energy_err2,
+                             void *temp);
 } // AxisManip
@@ -32,6 +32,7 @@
 
 #include "constants.hpp"
 #include "conversions.hpp"
+#include "map_kernel.hpp"
 #include "nessi_warn.hpp"
 #include "size_checks.hpp"
 #include <stdexcept>
@@ -41,6 +42,53 @@ namespace AxisManip
   /// String for holding the velocity_to_energy function name
   const std::string vte_func_str = "AxisManip::velocity_to_energy";
 
+  /**
+   * \ingroup velocity_to_energy
+   *
+   * This is a PRIVATE map kernel (see \ref map_kernel) converting
+   * velocity to energy. The constants are the same for every pixel.
+   */
+  template <typename NumT>
+  class __VelocityToEnergyKernel
+  {
+  public:
+    /// Type of the elements
+    typedef NumT value_type;
+
+    /// Constructor clearing the constants until setup() runs
+    __VelocityToEnergyKernel()
+      : a_(0), b2_(0)
+    { }
+
+    /// Returns true, the conversion does not depend on the pixel
+    bool is_uniform() const
+    {
+      return true;
+    }
+
+    /// Calculates the constants
+    std::string setup(const std::size_t)
+    {
+      return __velocity_to_energy_static(a_, b2_);
+    }
+
+    /// Converts one bin
+    template <typename SinkT>
+    void operator()(const NumT velocity, const NumT velocity_err2,
+                    NumT & energy, NumT & energy_err2,
+                    SinkT & warnings) const
+    {
+      __velocity_to_energy_dynamic(velocity, velocity_err2, energy,
+                                   energy_err2, a_, b2_, warnings);
+    }
+
+  private:
+    /// Half the mass of the neutron
+    NumT a_;
+    /// The square of the mass of the neutron
+    NumT b2_;
+  };
+
   // 3.21
   template <typename NumT>
   std::string
@@ -81,24 +129,10 @@ namespace AxisManip
                                     +e.what());
       }
 
-    std::string retstr(Nessi::EMPTY_WARN);
-
-    NumT a;
-    NumT b2;
-
-    retstr += __velocity_to_energy_static(a, b2);
-
-    size_t sz = velocity.size();
-    for (size_t i = 0; i < sz; ++i)
-      {
-        retstr += __velocity_to_energy_dynamic(velocity[i],
-                                               velocity_err2[i],
-                                               energy[i],
-                                               energy_err2[i],
-                                               a, b2);
-      }
-
-    return retstr;
+    return __map_kernel(__VelocityToEnergyKernel<NumT>(),
+                        velocity.begin(), velocity_err2.begin(),
+                        energy.begin(), energy_err2.begin(),
+                        velocity.size());
   }
 
   // 3.21
@@ -110,18 +144,61 @@ namespace AxisManip
                      NumT & energy_err2,
                      void *temp=NULL)
   {
-    std::string retstr(Nessi::EMPTY_WARN);
+    return __map_kernel(__VelocityToEnergyKernel<NumT>(), &velocity,
+                        &velocity_err2, &energy, &energy_err2, 1);
+  }
 
-    NumT a;
-    NumT b2;
+  // 3.21
+  template <typename NumT>
+  std::string
+  velocity_to_energy(const Nessi::VectorView<const NumT> & velocity,
+                     const Nessi::VectorView<const NumT> & velocity_err2,
+                     const Nessi::VectorView<NumT> & energy,
+                     const Nessi::VectorView<NumT> & energy_err2,
+                     void *temp=NULL)
+  {
+    // check that the views are of proper size
+    size_t sz = velocity.size();
+    if (velocity_err2.size() != sz || energy.size() != sz
+        || energy_err2.size() != sz)
+      {
+        throw std::invalid_argument(vte_func_str+" (view): views not the "
+                                    +"same size");
+      }
 
-    retstr += __velocity_to_energy_static(a, b2);
+    return __map_kernel(__VelocityToEnergyKernel<NumT>(), velocity,
+                        velocity_err2, energy, energy_err2, sz);
+  }
 
-    retstr += __velocity_to_energy_dynamic(velocity,velocity_err2,
-                                           energy, energy_err2, 
-                                           a, b2);
+  // 3.21
+  template <typename NumT>
+  std::string
+  velocity_to_energy(const Nessi::SpectrumBlock<NumT> & velocity,
+                     Nessi::SpectrumBlock<NumT> & energy,
+                     void *temp=NULL)
+  {
+    return velocity_to_energy(Nessi::execution::seq, velocity, energy,
+                              temp);
+  }
 
-    return retstr;
+  // 3.21
+  template <typename NumT>
+  std::string
+  velocity_to_energy(const Nessi::ExecutionPolicy & policy,
+                     const Nessi::SpectrumBlock<NumT> & velocity,
+                     Nessi::SpectrumBlock<NumT> & energy,
+                     void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!velocity.same_shape(energy))
+      {
+        throw std::invalid_argument(vte_func_str+" (b): blocks not the "
+                                    +"same shape");
+      }
+
+    // blocks without padding are converted as a single array
+    return __map_kernel(policy, __VelocityToEnergyKernel<NumT>(), velocity,
+                        energy);
   }
 
  /**
@@ -165,22 +242,22 @@ namespace AxisManip
    * __velocity_to_energy_static()
    * \param b2 (INPUT) same as the parameter in
    * __velocity_to_energy_static()
+   * \param warnings (OUTPUT) is the sink receiving the warnings
    */
-  template <typename NumT>
-  std::string
+  template <typename NumT, typename SinkT>
+  void
   __velocity_to_energy_dynamic(const NumT velocity,
                                const NumT velocity_err2,
                                NumT & energy,
                                NumT & energy_err2,
                                const NumT a,
-                               const NumT b2)
+                               const NumT b2,
+                               SinkT & warnings)
   {
     NumT velocity2 = velocity * velocity;
 
     energy = static_cast<NumT>(a * velocity2);
     energy_err2 = b2 * velocity2 * velocity_err2;
-
-    return Nessi::EMPTY_WARN;
   }
 
 } // AxisManip
@@ -83,4 +83,79 @@ namespace AxisManip
                                double & wavevector,
                                double & wavevector_err2,
                                void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.23 for
+   * blocks
+   *
+   * \ingroup velocity_to_scalar_k
+   */
+  template std::string
+  velocity_to_scalar_k<float>(const Nessi::SpectrumBlock<float> & velocity,
+                              Nessi::SpectrumBlock<float> & wavevector,
+                              void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.23 for
+   * blocks with an execution policy
+   *
+   * \ingroup velocity_to_scalar_k
+   */
+  template std::string
+  velocity_to_scalar_k<float>(const Nessi::ExecutionPolicy & policy,
+                              const Nessi::SpectrumBlock<float> & velocity,
+                              Nessi::SpectrumBlock<float> & wavevector,
+                              void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.23 for blocks
+   *
+   * \ingroup velocity_to_scalar_k
+   */
+  template std::string
+  velocity_to_scalar_k<double>(const Nessi::SpectrumBlock<double> & velocity,
+                               Nessi::SpectrumBlock<double> & wavevector,
+                               void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.23 for blocks with an execution policy
+   *
+   * \ingroup velocity_to_scalar_k
+   */
+  template std::string
+  velocity_to_scalar_k<double>(const Nessi::ExecutionPolicy & policy,
+                               const Nessi::SpectrumBlock<double> & velocity,
+                               Nessi::SpectrumBlock<double> & wavevector,
+                               void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.23 for views
+   *
+   * \ingroup velocity_to_scalar_k
+   */
+  template std::string
+  velocity_to_scalar_k<float>(const Nessi::VectorView<const float> & velocity,
+                              const Nessi::VectorView<const float> &
+                              velocity_err2,
+                              const Nessi::VectorView<float> & wavevector,
+                              const Nessi::VectorView<float> & wavevector_err2,
+                              void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.23 for views
+   *
+   * \ingroup velocity_to_scalar_k
+   */
+  template std::string
+  velocity_to_scalar_k<double>(const Nessi::VectorView<const double> &
+                               velocity,
+                               const Nessi::VectorView<const double> &
+                               velocity_err2,
+                               const Nessi::VectorView<double> & wavevector,
+                               const Nessi::VectorView<double> &
+                               wavevector_err2,
+                               void *temp);
 } // AxisManip
@@ -32,6 +32,7 @@
 
 #include "constants.hpp"
 #include "conversions.hpp"
+#include "map_kernel.hpp"
 #include "nessi_warn.hpp"
 #include "size_checks.hpp"
 #include <stdexcept>
@@ -41,6 +42,53 @@ namespace AxisManip
   /// String for holding the velocity_to_scalar_k function name
   const std::string vtsk_func_str = "AxisManip::velocity_to_scalar_k";
 
+  /**
+   * \ingroup velocity_to_scalar_k
+   *
+   * This is a PRIVATE map kernel (see \ref map_kernel) converting velocity
+   * to scalar wavevector. The constants are the same for every pixel.
+   */
+  template <typename NumT>
+  class __VelocityToScalarKKernel
+  {
+  public:
+    /// Type of the elements
+    typedef NumT value_type;
+
+    /// Constructor clearing the constants until setup() runs
+    __VelocityToScalarKKernel()
+      : mh_(0), mh2_(0)
+    { }
+
+    /// Returns true, the conversion does not depend on the pixel
+    bool is_uniform() const
+    {
+      return true;
+    }
+
+    /// Calculates the constants
+    std::string setup(const std::size_t)
+    {
+      return __velocity_to_scalar_k_static(mh_, mh2_);
+    }
+
+    /// Converts one bin
+    template <typename SinkT>
+    void operator()(const NumT velocity, const NumT velocity_err2,
+                    NumT & wavevector, NumT & wavevector_err2,
+                    SinkT & warnings) const
+    {
+      __velocity_to_scalar_k_dynamic(velocity, velocity_err2, wavevector,
+                                     wavevector_err2, mh_, mh2_, warnings);
+    }
+
+  private:
+    /// The factor \f$2\pi m_n/h\f$
+    NumT mh_;
+    /// The square of the factor
+    NumT mh2_;
+  };
+
   // 3.23
   template <typename NumT>
   std::string
@@ -80,25 +128,10 @@ namespace AxisManip
         throw std::invalid_argument(vtsk_func_str+" (v,v): velocity "
                                     +e.what());
       }
-    std::string retstr(Nessi::EMPTY_WARN);
-
-    NumT mh;
-    NumT mh2;
-
-    retstr += __velocity_to_scalar_k_static(mh,mh2);
-
-    size_t sz = velocity.size();
-    for (size_t i=0; i < sz; ++i)
-      {
-        retstr += __velocity_to_scalar_k_dynamic(velocity[i],
-                                                 velocity_err2[i],
-                                                 wavevector[i],
-                                                 wavevector_err2[i],
-                                                 mh,
-                                                 mh2);
-      }
 
-    return retstr;
+    return __map_kernel(__VelocityToScalarKKernel<NumT>(), velocity.begin(),
+                        velocity_err2.begin(), wavevector.begin(),
+                        wavevector_err2.begin(), velocity.size());
   }
 
   // 3.23
@@ -110,21 +143,30 @@ namespace AxisManip
                        NumT & wavevector_err2,
                        void *temp=NULL)
   {
-    std::string retstr(Nessi::EMPTY_WARN);
-
-    NumT mh;
-    NumT mh2;
-
-    retstr += __velocity_to_scalar_k_static(mh,mh2);
+    return __map_kernel(__VelocityToScalarKKernel<NumT>(), &velocity,
+                        &velocity_err2, &wavevector, &wavevector_err2, 1);
+  }
 
-    retstr += __velocity_to_scalar_k_dynamic(velocity,
-                                             velocity_err2,
-                                             wavevector,
-                                             wavevector_err2,
-                                             mh,
-                                             mh2);
+  // 3.23
+  template <typename NumT>
+  std::string
+  velocity_to_scalar_k(const Nessi::VectorView<const NumT> & velocity,
+                       const Nessi::VectorView<const NumT> & velocity_err2,
+                       const Nessi::VectorView<NumT> & wavevector,
+                       const Nessi::VectorView<NumT> & wavevector_err2,
+                       void *temp=NULL)
+  {
+    // check that the views are of proper size
+    size_t sz = velocity.size();
+    if (velocity_err2.size() != sz || wavevector.size() != sz
+        || wavevector_err2.size() != sz)
+      {
+        throw std::invalid_argument(vtsk_func_str+" (view): views not the "
+                                    +"same size");
+      }
 
-    return retstr;
+    return __map_kernel(__VelocityToScalarKKernel<NumT>(), velocity,
+                        velocity_err2, wavevector, wavevector_err2, sz);
   }
 
   /**
@@ -161,20 +203,51 @@ namespace AxisManip
    * \param wavevector_err2 (OUTPUT) same as parameter in velocity_to_scalar_k()
    * \param mh (INPUT) same as parameter in __velocity_to_scalar_k_static()
    * \param mh2 (INPUT) same as parameter in __velocity_to_scalar_k_static()
+   * \param warnings (OUTPUT) is the sink receiving the warnings
    */
-  template <typename NumT>
-  std::string
+  template <typename NumT, typename SinkT>
+  void
   __velocity_to_scalar_k_dynamic(const NumT velocity,
                                  const NumT velocity_err2,
                                  NumT & wavevector,
                                  NumT & wavevector_err2,
                                  const NumT mh,
-                                 const NumT mh2)
+                                 const NumT mh2,
+                                 SinkT & warnings)
   {
     wavevector = velocity * mh;
     wavevector_err2 = mh2 * velocity_err2;
+  }
 
-    return Nessi::EMPTY_WARN;
+  // 3.23
+  template <typename NumT>
+  std::string
+  velocity_to_scalar_k(const Nessi::SpectrumBlock<NumT> & velocity,
+                       Nessi::SpectrumBlock<NumT> & wavevector,
+                       void *temp=NULL)
+  {
+    return velocity_to_scalar_k(Nessi::execution::seq, velocity, wavevector,
+                                temp);
+  }
+
+  // 3.23
+  template <typename NumT>
+  std::string
+  velocity_to_scalar_k(const Nessi::ExecutionPolicy & policy,
+                       const Nessi::SpectrumBlock<NumT> & velocity,
+                       Nessi::SpectrumBlock<NumT> & wavevector,
+                       void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!velocity.same_shape(wavevector))
+      {
+        throw std::invalid_argument(vtsk_func_str+" (b): blocks not the "
+                                    +"same shape");
+      }
+
+    // blocks without padding are converted as a single array
+    return __map_kernel(policy, __VelocityToScalarKKernel<NumT>(), velocity,
+                        wavevector);
   }
 } // AxisManip
 
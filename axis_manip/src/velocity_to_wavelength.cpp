@@ -79,4 +79,81 @@ namespace AxisManip
                                  double & wavelength,
                                  double & wavelength_err2,
                                  void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.58 for
+   * blocks
+   *
+   * \ingroup velocity_to_wavelength
+   */
+  template std::string
+  velocity_to_wavelength<float>(const Nessi::SpectrumBlock<float> & velocity,
+                                Nessi::SpectrumBlock<float> & wavelength,
+                                void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.58 for
+   * blocks with an execution policy
+   *
+   * \ingroup velocity_to_wavelength
+   */
+  template std::string
+  velocity_to_wavelength<float>(const Nessi::ExecutionPolicy & policy,
+                                const Nessi::SpectrumBlock<float> & velocity,
+                                Nessi::SpectrumBlock<float> & wavelength,
+                                void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.58 for blocks
+   *
+   * \ingroup velocity_to_wavelength
+   */
+  template std::string
+  velocity_to_wavelength<double>(const Nessi::SpectrumBlock<double> & velocity,
+                                 Nessi::SpectrumBlock<double> & wavelength,
+                                 void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.58 for blocks with an execution policy
+   *
+   * \ingroup velocity_to_wavelength
+   */
+  template std::string
+  velocity_to_wavelength<double>(const Nessi::ExecutionPolicy & policy,
+                                 const Nessi::SpectrumBlock<double> & velocity,
+                                 Nessi::SpectrumBlock<double> & wavelength,
+                                 void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.58 for views
+   *
+   * \ingroup velocity_to_wavelength
+   */
+  template std::string
+  velocity_to_wavelength<float>(const Nessi::VectorView<const float> &
+                                velocity,
+                                const Nessi::VectorView<const float> &
+                                velocity_err2,
+                                const Nessi::VectorView<float> & wavelength,
+                                const Nessi::VectorView<float> &
+                                wavelength_err2,
+                                void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.58 for views
+   *
+   * \ingroup velocity_to_wavelength
+   */
+  template std::string
+  velocity_to_wavelength<double>(const Nessi::VectorView<const double> &
+                                 velocity,
+                                 const Nessi::VectorView<const double> &
+                                 velocity_err2,
+                                 const Nessi::VectorView<double> & wavelength,
+                                 const Nessi::VectorView<double> &
+                                 wavelength_err2,
+                                 void *temp);
 } // AxisManip
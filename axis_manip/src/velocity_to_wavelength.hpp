@@ -32,6 +32,7 @@
 
 #include "constants.hpp"
 #include "conversions.hpp"
+#include "map_kernel.hpp"
 #include "nessi_warn.hpp"
 #include "size_checks.hpp"
 #include <stdexcept>
@@ -41,6 +42,42 @@ namespace AxisManip
   /// String for holding the velocity_to_wavelength function name
   const std::string vtw_func_str = "AxisManip::velocity_to_wavelength";
 
+  /**
+   * \ingroup velocity_to_wavelength
+   *
+   * This is a PRIVATE map kernel (see \ref map_kernel) converting velocity
+   * to wavelength. The conversion has no constants.
+   */
+  template <typename NumT>
+  class __VelocityToWavelengthKernel
+  {
+  public:
+    /// Type of the elements
+    typedef NumT value_type;
+
+    /// Returns true, the conversion does not depend on the pixel
+    bool is_uniform() const
+    {
+      return true;
+    }
+
+    /// Calculates the constants
+    std::string setup(const std::size_t)
+    {
+      return Nessi::EMPTY_WARN;
+    }
+
+    /// Converts one bin
+    template <typename SinkT>
+    void operator()(const NumT velocity, const NumT velocity_err2,
+                    NumT & wavelength, NumT & wavelength_err2,
+                    SinkT & warnings) const
+    {
+      __velocity_to_wavelength_dynamic(velocity, velocity_err2, wavelength,
+                                       wavelength_err2, warnings);
+    }
+  };
+
   // 3.58
   template <typename NumT>
   std::string
@@ -81,20 +118,9 @@ namespace AxisManip
                                     +e.what());
       }
 
-    std::string retstr(Nessi::EMPTY_WARN); // the warning string
-    
-    
-    // do the calculation
-    size_t size_velocity = velocity.size();
-    for(size_t i = 0; i < size_velocity; ++i)
-      {
-        retstr += __velocity_to_wavelength_dynamic(velocity[i],
-                                                   velocity_err2[i],
-                                                   wavelength[i],
-                                                   wavelength_err2[i]);
-      }
-
-    return retstr;
+    return __map_kernel(__VelocityToWavelengthKernel<NumT>(), velocity.begin(),
+                        velocity_err2.begin(), wavelength.begin(),
+                        wavelength_err2.begin(), velocity.size());
   }
 
   // 3.58
@@ -106,15 +132,30 @@ namespace AxisManip
                          NumT & wavelength_err2,
                          void *temp=NULL)
   {
-    std::string retstr(Nessi::EMPTY_WARN); // the warning string
+    return __map_kernel(__VelocityToWavelengthKernel<NumT>(), &velocity,
+                        &velocity_err2, &wavelength, &wavelength_err2, 1);
+  }
 
-    // do the calculation
-    retstr += __velocity_to_wavelength_dynamic(velocity,
-                                               velocity_err2,
-                                               wavelength,
-                                               wavelength_err2);
+  // 3.58
+  template <typename NumT>
+  std::string
+  velocity_to_wavelength(const Nessi::VectorView<const NumT> & velocity,
+                         const Nessi::VectorView<const NumT> & velocity_err2,
+                         const Nessi::VectorView<NumT> & wavelength,
+                         const Nessi::VectorView<NumT> & wavelength_err2,
+                         void *temp=NULL)
+  {
+    // check that the views are of proper size
+    size_t sz = velocity.size();
+    if (velocity_err2.size() != sz || wavelength.size() != sz
+        || wavelength_err2.size() != sz)
+      {
+        throw std::invalid_argument(vtw_func_str+" (view): views not the "
+                                    +"same size");
+      }
 
-    return retstr;
+    return __map_kernel(__VelocityToWavelengthKernel<NumT>(), velocity,
+                        velocity_err2, wavelength, wavelength_err2, sz);
   }
 
   /**
@@ -131,12 +172,15 @@ namespace AxisManip
    * velocity_to_wavelength()
    * \param wavelength_err2 (OUTPUT) same as the parameter in
    * velocity_to_wavelength() 
+   * \param warnings (OUTPUT) is the sink receiving the warnings
    */
-  template <typename NumT>
-  std::string __velocity_to_wavelength_dynamic(const NumT velocity,
-                                               const NumT velocity_err2,
-                                               NumT & wavelength,
-                                               NumT & wavelength_err2)
+  template <typename NumT, typename SinkT>
+  void
+  __velocity_to_wavelength_dynamic(const NumT velocity,
+                                   const NumT velocity_err2,
+                                   NumT & wavelength,
+                                   NumT & wavelength_err2,
+                                   SinkT & warnings)
   {
     // calculate the value
     wavelength = PhysConst::H_OVER_MNEUT / velocity;
@@ -144,8 +188,37 @@ namespace AxisManip
     // calculate the uncertainty
     wavelength_err2 = ((wavelength * wavelength) / (velocity * velocity)) 
       * velocity_err2;
-    
-    return Nessi::EMPTY_WARN;
+  }
+
+  // 3.58
+  template <typename NumT>
+  std::string
+  velocity_to_wavelength(const Nessi::SpectrumBlock<NumT> & velocity,
+                         Nessi::SpectrumBlock<NumT> & wavelength,
+                         void *temp=NULL)
+  {
+    return velocity_to_wavelength(Nessi::execution::seq, velocity, wavelength,
+                                  temp);
+  }
+
+  // 3.58
+  template <typename NumT>
+  std::string
+  velocity_to_wavelength(const Nessi::ExecutionPolicy & policy,
+                         const Nessi::SpectrumBlock<NumT> & velocity,
+                         Nessi::SpectrumBlock<NumT> & wavelength,
+                         void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!velocity.same_shape(wavelength))
+      {
+        throw std::invalid_argument(vtw_func_str+" (b): blocks not the "
+                                    +"same shape");
+      }
+
+    // blocks without padding are converted as a single array
+    return __map_kernel(policy, __VelocityToWavelengthKernel<NumT>(), velocity,
+                        wavelength);
   }
 } // AxisManip
 
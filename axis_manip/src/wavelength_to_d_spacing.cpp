@@ -91,4 +91,99 @@ namespace AxisManip
                                   double & d_spacing,
                                   double & d_spacing_err2,
                                   void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.25 for
+   * blocks
+   *
+   * \ingroup wavelength_to_d_spacing
+   */
+  template std::string
+  wavelength_to_d_spacing<float>(
+                                const Nessi::SpectrumBlock<float> & wavelength,
+                                const Nessi::Vector<float> & polar_angle,
+                                const Nessi::Vector<float> & polar_angle_err2,
+                                Nessi::SpectrumBlock<float> & d_spacing,
+                                void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.25 for
+   * blocks with an execution policy
+   *
+   * \ingroup wavelength_to_d_spacing
+   */
+  template std::string
+  wavelength_to_d_spacing<float>(
+                                const Nessi::ExecutionPolicy & policy,
+                                const Nessi::SpectrumBlock<float> & wavelength,
+                                const Nessi::Vector<float> & polar_angle,
+                                const Nessi::Vector<float> & polar_angle_err2,
+                                Nessi::SpectrumBlock<float> & d_spacing,
+                                void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.25 for blocks
+   *
+   * \ingroup wavelength_to_d_spacing
+   */
+  template std::string
+  wavelength_to_d_spacing<double>(
+                                const Nessi::SpectrumBlock<double> &
+                                wavelength,
+                                const Nessi::Vector<double> & polar_angle,
+                                const Nessi::Vector<double> & polar_angle_err2,
+                                Nessi::SpectrumBlock<double> & d_spacing,
+                                void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.25 for blocks with an execution policy
+   *
+   * \ingroup wavelength_to_d_spacing
+   */
+  template std::string
+  wavelength_to_d_spacing<double>(
+                                const Nessi::ExecutionPolicy & policy,
+                                const Nessi::SpectrumBlock<double> &
+                                wavelength,
+                                const Nessi::Vector<double> & polar_angle,
+                                const Nessi::Vector<double> & polar_angle_err2,
+                                Nessi::SpectrumBlock<double> & d_spacing,
+                                void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.25 for views
+   *
+   * \ingroup wavelength_to_d_spacing
+   */
+  template std::string
+  wavelength_to_d_spacing<float>(const Nessi::VectorView<const float> &
+                                 wavelength,
+                                 const Nessi::VectorView<const float> &
+                                 wavelength_err2,
+                                 const float polar_angle,
+                                 const float polar_angle_err2,
+                                 const Nessi::VectorView<float> & d_spacing,
+                                 const Nessi::VectorView<float> &
+                                 d_spacing_err2,
+                                 void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.25 for views
+   *
+   * \ingroup wavelength_to_d_spacing
+   */
+  template std::string
+  wavelength_to_d_spacing<double>(const Nessi::VectorView<const double> &
+                                  wavelength,
+                                  const Nessi::VectorView<const double> &
+                                  wavelength_err2,
+                                  const double polar_angle,
+                                  const double polar_angle_err2,
+                                  const Nessi::VectorView<double> & d_spacing,
+                                  const Nessi::VectorView<double> &
+                                  d_spacing_err2,
+                                  void *temp);
 } // AxisManip
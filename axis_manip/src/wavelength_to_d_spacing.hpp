@@ -31,6 +31,8 @@
 #define _WAVELENGTH_TO_D_SPACING_HPP 1
 
 #include "conversions.hpp"
+#include "map_kernel.hpp"
+#include "nessi_view.hpp"
 #include "nessi_warn.hpp"
 #include "size_checks.hpp"
 #include <cmath>
@@ -41,6 +43,71 @@ namespace AxisManip
   /// String for holding the wavelength_to_d_spacing function name
   const std::string wtds_func_str = "AxisManip::wavelength_to_d_spacing";
 
+  /**
+   * \ingroup wavelength_to_d_spacing
+   *
+   * This is a PRIVATE map kernel (see \ref map_kernel) converting the
+   * wavelength of pixel \f$p\f$ with its polar angle.
+   */
+  template <typename NumT>
+  class __WavelengthToDSpacingKernel
+  {
+  public:
+    /// Type of the elements
+    typedef NumT value_type;
+
+    /// Constructor keeping the polar angles of the pixels
+    __WavelengthToDSpacingKernel(const Nessi::VectorView<const NumT> &
+                                 polar_angle,
+                                 const Nessi::VectorView<const NumT> &
+                                 polar_angle_err2)
+      : polar_angle_(polar_angle), polar_angle_err2_(polar_angle_err2),
+        angle_(0), angle_err2_(0), a_(0), a2_(0), b2_(0)
+    { }
+
+    /// Returns false, every pixel has its own polar angle
+    bool is_uniform() const
+    {
+      return false;
+    }
+
+    /// Calculates the constants of pixel \p p
+    std::string setup(const std::size_t p)
+    {
+      angle_ = polar_angle_[p];
+      angle_err2_ = polar_angle_err2_[p];
+      return __wavelength_to_d_spacing_static(angle_, a_, a2_, b2_);
+    }
+
+    /// Converts one bin
+    template <typename SinkT>
+    void operator()(const NumT wavelength, const NumT wavelength_err2,
+                    NumT & d_spacing, NumT & d_spacing_err2,
+                    SinkT & warnings) const
+    {
+      __wavelength_to_d_spacing_dynamic(wavelength, wavelength_err2,
+                                        angle_, angle_err2_, a_, a2_, b2_,
+                                        d_spacing, d_spacing_err2,
+                                        warnings);
+    }
+
+  private:
+    /// The polar angle of every pixel
+    Nessi::VectorView<const NumT> polar_angle_;
+    /// The square of the uncertainty in the polar angles
+    Nessi::VectorView<const NumT> polar_angle_err2_;
+    /// The polar angle of the current pixel
+    NumT angle_;
+    /// The square of the uncertainty in the polar angle of the pixel
+    NumT angle_err2_;
+    /// Twice the sine of half the polar angle
+    NumT a_;
+    /// The square of a
+    NumT a2_;
+    /// The square of the cotangent of half the polar angle
+    NumT b2_;
+  };
+
   // 3.25
   template <typename NumT>
   std::string
@@ -83,30 +150,12 @@ namespace AxisManip
                                     +e.what());
       }
 
-    std::string retstr(Nessi::EMPTY_WARN); // the warning string
-
-    // allocate local variables
-    NumT a;
-    NumT a2;
-    NumT b2;
-
-    // fill the local variables
-    retstr += __wavelength_to_d_spacing_static(polar_angle, a, a2, b2);
-
-    // do the calculation
-    size_t size_wavelength = wavelength.size();
-    for (size_t i=0; i < size_wavelength ; ++i)
-      {
-        retstr += __wavelength_to_d_spacing_dynamic(wavelength[i],
-                                                    wavelength_err2[i],
-                                                    polar_angle,
-                                                    polar_angle_err2,
-                                                    a, a2, b2,
-                                                    d_spacing[i],
-                                                    d_spacing_err2[i]);
-      }
-
-    return retstr;
+    __WavelengthToDSpacingKernel<NumT>
+      kernel(Nessi::VectorView<const NumT>(&polar_angle, 1),
+             Nessi::VectorView<const NumT>(&polar_angle_err2, 1));
+    return __map_kernel(kernel, wavelength.begin(), wavelength_err2.begin(),
+                        d_spacing.begin(), d_spacing_err2.begin(),
+                        wavelength.size());
   }
 
   // 3.25
@@ -120,26 +169,39 @@ namespace AxisManip
                           NumT & d_spacing_err2,
                           void *temp=NULL)
   {
-    std::string retstr(Nessi::EMPTY_WARN); // the warning string
-
-    // allocate local variables
-    NumT a;
-    NumT a2;
-    NumT b2;
-
-    // fill the local variables
-    retstr += __wavelength_to_d_spacing_static(polar_angle, a, a2, b2);
-
-    // do the calculation
-    retstr += __wavelength_to_d_spacing_dynamic(wavelength,
-                                                wavelength_err2,
-                                                polar_angle,
-                                                polar_angle_err2,
-                                                a, a2, b2,
-                                                d_spacing,
-                                                d_spacing_err2);
-
-    return retstr;
+    __WavelengthToDSpacingKernel<NumT>
+      kernel(Nessi::VectorView<const NumT>(&polar_angle, 1),
+             Nessi::VectorView<const NumT>(&polar_angle_err2, 1));
+    return __map_kernel(kernel, &wavelength, &wavelength_err2, &d_spacing,
+                        &d_spacing_err2, 1);
+  }
+
+  // 3.25
+  template <typename NumT>
+  std::string
+  wavelength_to_d_spacing(const Nessi::VectorView<const NumT> & wavelength,
+                          const Nessi::VectorView<const NumT> &
+                          wavelength_err2,
+                          const NumT polar_angle,
+                          const NumT polar_angle_err2,
+                          const Nessi::VectorView<NumT> & d_spacing,
+                          const Nessi::VectorView<NumT> & d_spacing_err2,
+                          void *temp=NULL)
+  {
+    // check that the views are of proper size
+    size_t sz = wavelength.size();
+    if (wavelength_err2.size() != sz || d_spacing.size() != sz
+        || d_spacing_err2.size() != sz)
+      {
+        throw std::invalid_argument(wtds_func_str+" (view): views not the "
+                                    +"same size");
+      }
+
+    __WavelengthToDSpacingKernel<NumT>
+      kernel(Nessi::VectorView<const NumT>(&polar_angle, 1),
+             Nessi::VectorView<const NumT>(&polar_angle_err2, 1));
+    return __map_kernel(kernel, wavelength, wavelength_err2, d_spacing,
+                        d_spacing_err2, sz);
   }
 
  /**
@@ -191,9 +253,10 @@ namespace AxisManip
    * \param d_spacing (OUTPUT) same as parameter in wavelength_to_d_spacing()
    * \param d_spacing_err2 (OUTPUT) same as parameter
    * in wavelength_to_d_spacing()
+   * \param warnings (OUTPUT) is the sink receiving the warnings
    */
-  template <typename NumT>
-  std::string
+  template <typename NumT, typename SinkT>
+  void
   __wavelength_to_d_spacing_dynamic(const NumT wavelength,
                                     const NumT wavelength_err2,
                                     const NumT polar_angle,
@@ -202,7 +265,8 @@ namespace AxisManip
                                     const NumT a2,
                                     const NumT b2,
                                     NumT & d_spacing,
-                                    NumT & d_spacing_err2)
+                                    NumT & d_spacing_err2,
+                                    SinkT & warnings)
   {
     NumT wl = wavelength;
     NumT wl2 = static_cast<NumT>(wl * wl / 4.0);
@@ -213,8 +277,60 @@ namespace AxisManip
     // the uncertainty in the result
     d_spacing_err2 = (wavelength_err2 / a2) + 
       (wl2 * b2 * polar_angle_err2 / a2);
+  }
 
-    return Nessi::EMPTY_WARN;
+  // 3.25
+  template <typename NumT>
+  std::string
+  wavelength_to_d_spacing(const Nessi::SpectrumBlock<NumT> & wavelength,
+                          const Nessi::Vector<NumT> & polar_angle,
+                          const Nessi::Vector<NumT> & polar_angle_err2,
+                          Nessi::SpectrumBlock<NumT> & d_spacing,
+                          void *temp=NULL)
+  {
+    return wavelength_to_d_spacing(Nessi::execution::seq, wavelength,
+                                   polar_angle, polar_angle_err2, d_spacing,
+                                   temp);
+  }
+
+  // 3.25
+  template <typename NumT>
+  std::string
+  wavelength_to_d_spacing(const Nessi::ExecutionPolicy & policy,
+                          const Nessi::SpectrumBlock<NumT> & wavelength,
+                          const Nessi::Vector<NumT> & polar_angle,
+                          const Nessi::Vector<NumT> & polar_angle_err2,
+                          Nessi::SpectrumBlock<NumT> & d_spacing,
+                          void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!wavelength.same_shape(d_spacing))
+      {
+        throw std::invalid_argument(wtds_func_str+" (b,v): blocks not the "
+                                    +"same shape");
+      }
+
+    // check that the polar_angle arrays are of proper size
+    try
+      {
+        Utils::check_sizes_square(polar_angle, polar_angle_err2);
+      }
+    catch(std::invalid_argument &e)
+      {
+        throw std::invalid_argument(wtds_func_str+" (b,v): "
+                                    +"polar_angle "+e.what());
+      }
+    if (polar_angle.size() != wavelength.num_spectra())
+      {
+        throw std::invalid_argument(wtds_func_str+" (b,v): geometry not "
+                                    +"the number of spectra");
+      }
+
+    // every pixel is converted with its own polar angle
+    return __map_kernel(policy,
+                        __WavelengthToDSpacingKernel<NumT>(polar_angle,
+                                                           polar_angle_err2),
+                        wavelength, d_spacing);
   }
 } // AxisManip
 
@@ -82,4 +82,82 @@ namespace AxisManip
                                double & energy,
                                double & energy_err2,
                                void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.22 for
+   * blocks
+   *
+   * \ingroup wavelength_to_energy
+   */
+  template std::string
+  wavelength_to_energy<float>(const Nessi::SpectrumBlock<float> & wavelength,
+                              Nessi::SpectrumBlock<float> & energy,
+                              void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.22 for
+   * blocks with an execution policy
+   *
+   * \ingroup wavelength_to_energy
+   */
+  template std::string
+  wavelength_to_energy<float>(const Nessi::ExecutionPolicy & policy,
+                              const Nessi::SpectrumBlock<float> & wavelength,
+                              Nessi::SpectrumBlock<float> & energy,
+                              void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.22 for blocks
+   *
+   * \ingroup wavelength_to_energy
+   */
+  template std::string
+  wavelength_to_energy<double>(const Nessi::SpectrumBlock<double> &
+                               wavelength,
+                               Nessi::SpectrumBlock<double> & energy,
+                               void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.22 for blocks with an execution policy
+   *
+   * \ingroup wavelength_to_energy
+   */
+  template std::string
+  wavelength_to_energy<double>(const Nessi::ExecutionPolicy & policy,
+                               const Nessi::SpectrumBlock<double> &
+                               wavelength,
+                               Nessi::SpectrumBlock<double> & energy,
+                               void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.22 for
+   * views
+   *
+   * \ingroup wavelength_to_energy
+   */
+  template std::string
+  wavelength_to_energy<float>(const Nessi::VectorView<const float> &
+                              wavelength,
+                              const Nessi::VectorView<const float> &
+                              wavelength_err2,
+                              const Nessi::VectorView<float> & energy,
+                              const Nessi::VectorView<float> & energy_err2,
+                              void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.22 for views
+   *
+   * \ingroup wavelength_to_energy
+   */
+  template std::string
+  wavelength_to_energy<double>(const Nessi::VectorView<const double> &
+                               wavelength,
+                               const Nessi::VectorView<const double> &
+                               wavelength_err2,
+                               const Nessi::VectorView<double> & energy,
+                               const Nessi::VectorView<double> & energy_err2,
+                               void *temp);
 } // AxisManip
@@ -32,6 +32,7 @@
 
 #include "constants.hpp"
 #include "conversions.hpp"
+#include "map_kernel.hpp"
 #include "nessi_warn.hpp"
 #include "size_checks.hpp"
 #include <stdexcept>
@@ -41,6 +42,51 @@ namespace AxisManip
   /// String for holding the wavelength_to_energy function name
   const std::string wte_func_str = "AxisManip::wavelength_to_energy";
 
+  /**
+   * \ingroup wavelength_to_energy
+   *
+   * This is a PRIVATE map kernel (see \ref map_kernel) converting
+   * wavelength to energy. The constants are the same for every pixel.
+   */
+  template <typename NumT>
+  class __WavelengthToEnergyKernel
+  {
+  public:
+    /// Type of the elements
+    typedef NumT value_type;
+
+    /// Constructor clearing the constant until setup() runs
+    __WavelengthToEnergyKernel()
+      : a2_(0)
+    { }
+
+    /// Returns true, the conversion does not depend on the pixel
+    bool is_uniform() const
+    {
+      return true;
+    }
+
+    /// Calculates the constants
+    std::string setup(const std::size_t)
+    {
+      return __wavelength_to_energy_static(a2_);
+    }
+
+    /// Converts one bin
+    template <typename SinkT>
+    void operator()(const NumT wavelength, const NumT wavelength_err2,
+                    NumT & energy, NumT & energy_err2,
+                    SinkT & warnings) const
+    {
+      __wavelength_to_energy_dynamic(wavelength, wavelength_err2, energy,
+                                     energy_err2, a2_, warnings);
+    }
+
+  private:
+    /// The constant of the uncertainty
+    NumT a2_;
+  };
+
   // 3.22
   template <typename NumT>
   std::string
@@ -81,23 +127,10 @@ namespace AxisManip
                                     +e.what());
       }
 
-    std::string retstr(Nessi::EMPTY_WARN);
-
-    NumT a2;
-
-    retstr += __wavelength_to_energy_static(a2);
-
-    size_t sz = wavelength.size();
-    for (size_t i = 0; i < sz; ++i)
-      {
-        retstr += __wavelength_to_energy_dynamic(wavelength[i],
-                                              wavelength_err2[i],
-                                              energy[i],
-                                              energy_err2[i],
-                                              a2);
-      }
-
-    return retstr;
+    return __map_kernel(__WavelengthToEnergyKernel<NumT>(),
+                        wavelength.begin(), wavelength_err2.begin(),
+                        energy.begin(), energy_err2.begin(),
+                        wavelength.size());
   }
 
   // 3.22
@@ -109,16 +142,41 @@ namespace AxisManip
                        NumT & energy_err2,
                        void *temp=NULL)
   {
-    std::string retstr(Nessi::EMPTY_WARN);
-
-    NumT a2;
+    return __map_kernel(__WavelengthToEnergyKernel<NumT>(), &wavelength,
+                        &wavelength_err2, &energy, &energy_err2, 1);
+  }
 
-    retstr += __wavelength_to_energy_static(a2);
+  // 3.22
+  template <typename NumT>
+  std::string
+  wavelength_to_energy(const Nessi::SpectrumBlock<NumT> & wavelength,
+                       Nessi::SpectrumBlock<NumT> & energy,
+                       void *temp=NULL)
+  {
+    return wavelength_to_energy(Nessi::execution::seq, wavelength, energy,
+                                temp);
+  }
 
-    retstr += __wavelength_to_energy_dynamic(wavelength,wavelength_err2,
-                                             energy, energy_err2, a2);
+  // 3.22
+  template <typename NumT>
+  std::string
+  wavelength_to_energy(const Nessi::VectorView<const NumT> & wavelength,
+                       const Nessi::VectorView<const NumT> & wavelength_err2,
+                       const Nessi::VectorView<NumT> & energy,
+                       const Nessi::VectorView<NumT> & energy_err2,
+                       void *temp=NULL)
+  {
+    // check that the views are of proper size
+    size_t sz = wavelength.size();
+    if (wavelength_err2.size() != sz || energy.size() != sz
+        || energy_err2.size() != sz)
+      {
+        throw std::invalid_argument(wte_func_str+" (view): views not the "
+                                    +"same size");
+      }
 
-    return retstr;
+    return __map_kernel(__WavelengthToEnergyKernel<NumT>(), wavelength,
+                        wavelength_err2, energy, energy_err2, sz);
   }
 
   /**
@@ -154,22 +212,42 @@ namespace AxisManip
    * wavelength_to_energy()
    * \param a2 (INPUT) same as the parameter in
    * __wavelength_to_energy_static()
+   * \param warnings (OUTPUT) is the sink receiving the warnings
    */
-  template <typename NumT>
-  std::string
+  template <typename NumT, typename SinkT>
+  void
   __wavelength_to_energy_dynamic(const NumT wavelength,
                                  const NumT wavelength_err2,
                                  NumT & energy,
                                  NumT & energy_err2,
-                                 const NumT a2)
+                                 const NumT a2,
+                                 SinkT & warnings)
   {
     NumT wavelength2 = wavelength * wavelength;
 
     energy = static_cast<NumT>(PhysConst::H2_OVER_2MNEUT) / wavelength2;
     energy_err2 = (a2 * wavelength_err2);
     energy_err2 /= (wavelength2 * wavelength2 * wavelength2);
+  }
 
-    return Nessi::EMPTY_WARN;
+  // 3.22
+  template <typename NumT>
+  std::string
+  wavelength_to_energy(const Nessi::ExecutionPolicy & policy,
+                       const Nessi::SpectrumBlock<NumT> & wavelength,
+                       Nessi::SpectrumBlock<NumT> & energy,
+                       void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!wavelength.same_shape(energy))
+      {
+        throw std::invalid_argument(wte_func_str+" (b): blocks not the "
+                                    +"same shape");
+      }
+
+    // blocks without padding are converted as a single array
+    return __map_kernel(policy, __WavelengthToEnergyKernel<NumT>(),
+                        wavelength, energy);
   }
 
 } // AxisManip
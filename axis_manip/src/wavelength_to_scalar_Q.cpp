@@ -90,4 +90,152 @@ namespace AxisManip
                                  double & Q,
                                  double & Q_err2,
                                  void *temp);
+  /**
+   * This is the float declaration of the function defined in 3.18 for
+   * blocks
+   *
+   * \ingroup wavelength_to_scalar_Q
+   */
+  template std::string
+  wavelength_to_scalar_Q<float>(const Nessi::SpectrumBlock<float> & wavelength,
+                                const Nessi::Vector<float> & polar_angle,
+                                const Nessi::Vector<float> & polar_angle_err2,
+                                Nessi::SpectrumBlock<float> & Q,
+                                void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.18 for
+   * blocks with an execution policy
+   *
+   * \ingroup wavelength_to_scalar_Q
+   */
+  template std::string
+  wavelength_to_scalar_Q<float>(const Nessi::ExecutionPolicy & policy,
+                                const Nessi::SpectrumBlock<float> & wavelength,
+                                const Nessi::Vector<float> & polar_angle,
+                                const Nessi::Vector<float> & polar_angle_err2,
+                                Nessi::SpectrumBlock<float> & Q,
+                                void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.18 for blocks
+   *
+   * \ingroup wavelength_to_scalar_Q
+   */
+  template std::string
+  wavelength_to_scalar_Q<double>(const Nessi::SpectrumBlock<double> &
+                                 wavelength,
+                                 const Nessi::Vector<double> & polar_angle,
+                                 const Nessi::Vector<double> &
+                                 polar_angle_err2,
+                                 Nessi::SpectrumBlock<double> & Q,
+                                 void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.18 for blocks with an execution policy
+   *
+   * \ingroup wavelength_to_scalar_Q
+   */
+  template std::string
+  wavelength_to_scalar_Q<double>(const Nessi::ExecutionPolicy & policy,
+                                 const Nessi::SpectrumBlock<double> &
+                                 wavelength,
+                                 const Nessi::Vector<double> & polar_angle,
+                                 const Nessi::Vector<double> &
+                                 polar_angle_err2,
+                                 Nessi::SpectrumBlock<double> & Q,
+                                 void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.18 for
+   * blocks with a geometry cache
+   *
+   * \ingroup wavelength_to_scalar_Q
+   */
+  template std::string
+  wavelength_to_scalar_Q<float>(const Nessi::SpectrumBlock<float> & wavelength,
+                                const InstrumentGeometryCache<float> &
+                                geometry,
+                                Nessi::SpectrumBlock<float> & Q,
+                                void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.18 for
+   * blocks with a geometry cache and an execution
+   * policy
+   *
+   * \ingroup wavelength_to_scalar_Q
+   */
+  template std::string
+  wavelength_to_scalar_Q<float>(const Nessi::ExecutionPolicy & policy,
+                                const Nessi::SpectrumBlock<float> & wavelength,
+                                const InstrumentGeometryCache<float> &
+                                geometry,
+                                Nessi::SpectrumBlock<float> & Q,
+                                void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.18 for blocks with a geometry cache
+   *
+   * \ingroup wavelength_to_scalar_Q
+   */
+  template std::string
+  wavelength_to_scalar_Q<double>(const Nessi::SpectrumBlock<double> &
+                                 wavelength,
+                                 const InstrumentGeometryCache<double> &
+                                 geometry,
+                                 Nessi::SpectrumBlock<double> & Q,
+                                 void *temp);
+
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.18 for blocks with a geometry cache and an execution
+   * policy
+   *
+   * \ingroup wavelength_to_scalar_Q
+   */
+  template std::string
+  wavelength_to_scalar_Q<double>(const Nessi::ExecutionPolicy & policy,
+                                 const Nessi::SpectrumBlock<double> &
+                                 wavelength,
+                                 const InstrumentGeometryCache<double> &
+                                 geometry,
+                                 Nessi::SpectrumBlock<double> & Q,
+                                 void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.18 for views
+   *
+   * \ingroup wavelength_to_scalar_Q
+   */
+  template std::string
+  wavelength_to_scalar_Q<float>(const Nessi::VectorView<const float> &
+                                wavelength,
+                                const Nessi::VectorView<const float> &
+                                wavelength_err2,
+                                const float polar_angle,
+                                const float polar_angle_err2,
+                                const Nessi::VectorView<float> & Q,
+                                const Nessi::VectorView<float> & Q_err2,
+                                void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.18 for views
+   *
+   * \ingroup wavelength_to_scalar_Q
+   */
+  template std::string
+  wavelength_to_scalar_Q<double>(const Nessi::VectorView<const double> &
+                                 wavelength,
+                                 const Nessi::VectorView<const double> &
+                                 wavelength_err2,
+                                 const double polar_angle,
+                                 const double polar_angle_err2,
+                                 const Nessi::VectorView<double> & Q,
+                                 const Nessi::VectorView<double> & Q_err2,
+                                 void *temp);
 } // AxisManip
@@ -32,9 +32,10 @@
 
 #include "constants.hpp"
 #include "conversions.hpp"
+#include "map_kernel.hpp"
 #include "nessi_warn.hpp"
+#include "nessi_workspace.hpp"
 #include "size_checks.hpp"
-#include <cmath>
 #include <stdexcept>
 
 namespace AxisManip
@@ -42,6 +43,83 @@ namespace AxisManip
   /// String for holding the wavelength_to_scalar_Q function name
   const std::string wtsq_func_str = "AxisManip::wavelength_to_scalar_Q";
 
+  /**
+   * \ingroup wavelength_to_scalar_Q
+   *
+   * This is a PRIVATE map kernel (see \ref map_kernel) converting the
+   * wavelength of pixel \f$p\f$ with the constants calculated for it by
+   * __wavelength_to_scalar_Q_prologue().
+   */
+  template <typename NumT>
+  class __WavelengthToScalarQKernel
+  {
+  public:
+    /// Type of the elements
+    typedef NumT value_type;
+    /// Type of the geometry cache
+    typedef InstrumentGeometryCache<NumT> Cache;
+
+    /// Constructor keeping the constants of the pixels
+    __WavelengthToScalarQKernel(const NumT _4Pi,
+                                const NumT * sin,
+                                const NumT * sin2,
+                                const NumT * term)
+      : _4Pi_(_4Pi), sin_array_(sin), sin2_array_(sin2), term_array_(term),
+        sin_(0), sin2_(0), term_(0)
+    { }
+
+    /// Constructor reading the constants of the pixels from \p geometry
+    explicit
+    __WavelengthToScalarQKernel(const Cache & geometry)
+      : _4Pi_(geometry.wtsq_4Pi_),
+        sin_array_(geometry.column(Cache::WTSQ_SIN)),
+        sin2_array_(geometry.column(Cache::WTSQ_SIN2)),
+        term_array_(geometry.column(Cache::WTSQ_TERM)),
+        sin_(0), sin2_(0), term_(0)
+    { }
+
+    /// Returns false, every pixel has its own polar angle
+    bool is_uniform() const
+    {
+      return false;
+    }
+
+    /// Reads the constants of pixel \p p
+    std::string setup(const std::size_t p)
+    {
+      sin_ = sin_array_[p];
+      sin2_ = sin2_array_[p];
+      term_ = term_array_[p];
+      return Nessi::EMPTY_WARN;
+    }
+
+    /// Converts one bin
+    template <typename SinkT>
+    void operator()(const NumT wavelength, const NumT wavelength_err2,
+                    NumT & Q, NumT & Q_err2, SinkT & warnings) const
+    {
+      __wavelength_to_scalar_Q_dynamic(wavelength, wavelength_err2, _4Pi_,
+                                       sin_, sin2_, term_, Q, Q_err2,
+                                       warnings);
+    }
+
+  private:
+    /// The constant shared by all pixels
+    NumT _4Pi_;
+    /// The constants of every pixel
+    const NumT * sin_array_;
+    /// The constants of every pixel
+    const NumT * sin2_array_;
+    /// The constants of every pixel
+    const NumT * term_array_;
+    /// The constants of the current pixel
+    NumT sin_;
+    /// The constants of the current pixel
+    NumT sin2_;
+    /// The constants of the current pixel
+    NumT term_;
+  };
+
   // 3.18
   template <typename NumT>
   std::string
@@ -84,30 +162,30 @@ namespace AxisManip
                                     +e.what());
       }
 
-    std::string retstr(Nessi::EMPTY_WARN); // the warning string
+    Nessi::DefaultWarningSink warnings;
 
-    // allocate local variables
+    // calculate the constants of the pixel
     NumT _4Pi;
     NumT sin;
     NumT sin2;
     NumT term;
-
-    // fill the local variables
-    retstr += __wavelength_to_scalar_Q_static(polar_angle, polar_angle_err2, 
-                                              _4Pi, sin, sin2, term);
+    double work[2];
+    __wavelength_to_scalar_Q_prologue(
+                          Nessi::VectorView<const NumT>(&polar_angle, 1),
+                          Nessi::VectorView<const NumT>(&polar_angle_err2,
+                                                        1),
+                          _4Pi, &sin, &sin2, &term, work, warnings);
 
     // do the calculation
-    size_t size_wavelength = wavelength.size();
-    for (size_t i=0; i < size_wavelength ; ++i)
-      {
-        retstr += __wavelength_to_scalar_Q_dynamic(wavelength[i],
-                                                   wavelength_err2[i],
-                                                   _4Pi, sin, sin2, term,
-                                                   Q[i], 
-                                                   Q_err2[i]);
-      }
+    warnings.report(__map_kernel(__WavelengthToScalarQKernel<NumT>(_4Pi,
+                                                                   &sin,
+                                                                   &sin2,
+                                                                   &term),
+                                 wavelength.begin(), wavelength_err2.begin(),
+                                 Q.begin(), Q_err2.begin(),
+                                 wavelength.size()));
 
-    return retstr;
+    return warnings.str();
   }
 
   template <typename NumT>
@@ -120,26 +198,86 @@ namespace AxisManip
                          NumT & Q_err2,
                          void *temp=NULL)
   {
-    std::string retstr(Nessi::EMPTY_WARN); // the warning string
+    Nessi::DefaultWarningSink warnings;
 
-    // allocate local variables
+    // calculate the constants of the pixel
     NumT _4Pi;
     NumT sin;
     NumT sin2;
     NumT term;
+    double work[2];
+    __wavelength_to_scalar_Q_prologue(
+                          Nessi::VectorView<const NumT>(&polar_angle, 1),
+                          Nessi::VectorView<const NumT>(&polar_angle_err2,
+                                                        1),
+                          _4Pi, &sin, &sin2, &term, work, warnings);
 
-    // fill the local variables
-    retstr += __wavelength_to_scalar_Q_static(polar_angle, polar_angle_err2,
-                                              _4Pi, sin, sin2, term);
+    // do the calculation
+    warnings.report(__map_kernel(__WavelengthToScalarQKernel<NumT>(_4Pi,
+                                                                   &sin,
+                                                                   &sin2,
+                                                                   &term),
+                                 &wavelength, &wavelength_err2, &Q, &Q_err2,
+                                 1));
+
+    return warnings.str();
+  }
+
+  // 3.18
+  template <typename NumT>
+  std::string
+  wavelength_to_scalar_Q(const Nessi::VectorView<const NumT> & wavelength,
+                         const Nessi::VectorView<const NumT> & wavelength_err2,
+                         const NumT polar_angle,
+                         const NumT polar_angle_err2,
+                         const Nessi::VectorView<NumT> & Q,
+                         const Nessi::VectorView<NumT> & Q_err2,
+                         void *temp=NULL)
+  {
+    // check that the views are of proper size
+    size_t sz = wavelength.size();
+    if (wavelength_err2.size() != sz || Q.size() != sz || Q_err2.size() != sz)
+      {
+        throw std::invalid_argument(wtsq_func_str+" (view): views not the "
+                                    +"same size");
+      }
+
+    Nessi::DefaultWarningSink warnings;
+
+    // calculate the constants of the pixel
+    NumT _4Pi;
+    NumT sin;
+    NumT sin2;
+    NumT term;
+    double work[2];
+    __wavelength_to_scalar_Q_prologue(
+                          Nessi::VectorView<const NumT>(&polar_angle, 1),
+                          Nessi::VectorView<const NumT>(&polar_angle_err2,
+                                                        1),
+                          _4Pi, &sin, &sin2, &term, work, warnings);
 
     // do the calculation
-    retstr += __wavelength_to_scalar_Q_dynamic(wavelength,
-                                               wavelength_err2,
-                                               _4Pi, sin, sin2, term,
-                                               Q,
-                                               Q_err2);
+    warnings.report(__map_kernel(__WavelengthToScalarQKernel<NumT>(_4Pi,
+                                                                   &sin,
+                                                                   &sin2,
+                                                                   &term),
+                                 wavelength, wavelength_err2, Q, Q_err2,
+                                 sz));
+
+    return warnings.str();
+  }
 
-    return retstr;
+  // 3.18
+  template <typename NumT>
+  std::string
+  wavelength_to_scalar_Q(const Nessi::SpectrumBlock<NumT> & wavelength,
+                         const Nessi::Vector<NumT> & polar_angle,
+                         const Nessi::Vector<NumT> & polar_angle_err2,
+                         Nessi::SpectrumBlock<NumT> & Q,
+                         void *temp=NULL)
+  {
+    return wavelength_to_scalar_Q(Nessi::execution::seq, wavelength,
+                                  polar_angle, polar_angle_err2, Q, temp);
   }
 
   /**
@@ -148,9 +286,12 @@ namespace AxisManip
    * This is a PRIVATE helper function for wavelength_to_scalar_Q that
    * calculates parameters invariant across array calculation
    *
-   * \param polar_angle (INPUT) same as parameter in wavelength_to_scalar_Q()
    * \param polar_angle_err2 (INPUT) same as parameter in 
    * wavelength_to_scalar_Q()
+   * \param sin_half (INPUT) is \f$\sin(polar/2)\f$ calculated by
+   * __half_angle_sin_cos()
+   * \param cos_half (INPUT) is \f$\cos(polar/2)\f$ calculated by
+   * __half_angle_sin_cos()
    * \param _4Pi (OUTPUT) the value of 4 times Pi
    * \param sin (OUTPUT) the sinus of the angle between positive z axis
    * and direction of the scattered neutrons
@@ -160,23 +301,71 @@ namespace AxisManip
    */
   template <typename NumT>
   std::string
-  __wavelength_to_scalar_Q_static(const NumT polar_angle,
-                                  const NumT polar_angle_err2,
+  __wavelength_to_scalar_Q_static(const NumT polar_angle_err2,
+                                  const double sin_half,
+                                  const double cos_half,
                                   NumT & _4Pi,
                                   NumT & sin,
                                   NumT & sin2,
                                   NumT & term)
   {
     _4Pi = 4.*static_cast<NumT>(PhysConst::PI);
-    sin=static_cast<NumT>(std::sin(static_cast<double>(polar_angle/2.0)));
+    sin = static_cast<NumT>(sin_half);
     sin2=sin*sin;
-    NumT cos
-      = static_cast<NumT>(std::cos(static_cast<double>(polar_angle/2.0)));
+    NumT cos = static_cast<NumT>(cos_half);
     term = ((cos * cos) / static_cast<NumT>(4.0)) * polar_angle_err2;
 
     return Nessi::EMPTY_WARN;
   }
 
+  /**
+   * \ingroup wavelength_to_scalar_Q
+   *
+   * This is a PRIVATE prologue (see \ref map_kernel) calculating the
+   * constants of every pixel with __wavelength_to_scalar_Q_static(). The
+   * sines and cosines of all pixels are evaluated together.
+   *
+   * \param polar_angle (INPUT) is the polar angle of every pixel
+   * \param polar_angle_err2 (INPUT) is the square of the uncertainty in
+   * every polar angle
+   * \param _4Pi (OUTPUT) same as parameter in
+   * __wavelength_to_scalar_Q_static()
+   * \param sin (OUTPUT) is the first of the sines of the pixels
+   * \param sin2 (OUTPUT) is the first of the squared sines of the pixels
+   * \param term (OUTPUT) is the first of the uncertainty terms of the
+   * pixels
+   * \param work (INPUT/OUTPUT) holds twice as many elements as there are
+   * pixels
+   * \param warnings (OUTPUT) is the sink receiving the warnings
+   */
+  template <typename NumT, typename SinkT>
+  void
+  __wavelength_to_scalar_Q_prologue(const Nessi::VectorView<const NumT> &
+                                    polar_angle,
+                                    const Nessi::VectorView<const NumT> &
+                                    polar_angle_err2,
+                                    NumT & _4Pi,
+                                    NumT * sin,
+                                    NumT * sin2,
+                                    NumT * term,
+                                    double * work,
+                                    SinkT & warnings)
+  {
+    std::size_t num_pixels = polar_angle.size();
+    double * sin_half = work;
+    double * cos_half = work + num_pixels;
+    __half_angle_sin_cos(polar_angle, sin_half, cos_half);
+
+    for (std::size_t p = 0; p < num_pixels; ++p)
+      {
+        warnings.report(__wavelength_to_scalar_Q_static(polar_angle_err2[p],
+                                                        sin_half[p],
+                                                        cos_half[p], _4Pi,
+                                                        sin[p], sin2[p],
+                                                        term[p]));
+      }
+  }
+
   /**
    * \ingroup wavelength_to_scalar_Q
    *
@@ -192,9 +381,10 @@ namespace AxisManip
    * \param term (INPUT) same as parameter in __wavelength_to_scalar_Q_static()
    * \param Q (OUTPUT) same as parameter in wavelength_to_scalar_Q()
    * \param Q_err2 (OUTPUT) same as parameter in wavelength_to_scalar_Q()
+   * \param warnings (OUTPUT) is the sink receiving the warnings
    */
-  template <typename NumT>
-  std::string
+  template <typename NumT, typename SinkT>
+  void
   __wavelength_to_scalar_Q_dynamic(const NumT wavelength,
                                    const NumT wavelength_err2,
                                    const NumT _4Pi,
@@ -202,7 +392,8 @@ namespace AxisManip
                                    const NumT sin2,
                                    const NumT term,
                                    NumT & Q,
-                                   NumT & Q_err2)
+                                   NumT & Q_err2,
+                                   SinkT & warnings)
   {
     NumT _4Pi_wave = _4Pi / wavelength;
 
@@ -213,8 +404,108 @@ namespace AxisManip
     Q_err2 = term;
     Q_err2 += (sin2 * wavelength_err2)/(wavelength*wavelength);
     Q_err2 *= _4Pi_wave*_4Pi_wave;
+  }
 
-    return Nessi::EMPTY_WARN;
+  // 3.18
+  template <typename NumT>
+  std::string
+  wavelength_to_scalar_Q(const Nessi::ExecutionPolicy & policy,
+                         const Nessi::SpectrumBlock<NumT> & wavelength,
+                         const Nessi::Vector<NumT> & polar_angle,
+                         const Nessi::Vector<NumT> & polar_angle_err2,
+                         Nessi::SpectrumBlock<NumT> & Q,
+                         void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!wavelength.same_shape(Q))
+      {
+        throw std::invalid_argument(wtsq_func_str+" (b,v): blocks not the "
+                                    +"same shape");
+      }
+
+    // check that the polar angle arrays are of proper size
+    try
+      {
+        Utils::check_sizes_square(polar_angle, polar_angle_err2);
+      }
+    catch(std::invalid_argument &e)
+      {
+        throw std::invalid_argument(wtsq_func_str+" (b,v): polar_angle "
+                                    +e.what());
+      }
+    std::size_t num_pixels = wavelength.num_spectra();
+    if (polar_angle.size() != num_pixels)
+      {
+        throw std::invalid_argument(wtsq_func_str+" (b,v): polar_angle not "
+                                    +"the number of spectra");
+      }
+
+    Nessi::DefaultWarningSink warnings;
+
+    // calculate the constants of all pixels
+    NumT _4Pi = static_cast<NumT>(0.);
+    Nessi::Scratch<NumT> sin(temp, num_pixels);
+    Nessi::Scratch<NumT> sin2(temp, num_pixels);
+    Nessi::Scratch<NumT> term(temp, num_pixels);
+    {
+      Nessi::Scratch<double> work(temp, 2 * num_pixels);
+      __wavelength_to_scalar_Q_prologue(
+                               Nessi::VectorView<const NumT>(polar_angle),
+                               Nessi::VectorView<const NumT>(polar_angle_err2),
+                               _4Pi, sin.data(), sin2.data(), term.data(),
+                               work.data(), warnings);
+    }
+
+    // every pixel is converted with its own polar angle
+    warnings.report(__map_kernel(policy,
+                                 __WavelengthToScalarQKernel<NumT>(
+                                                             _4Pi,
+                                                             sin.data(),
+                                                             sin2.data(),
+                                                             term.data()),
+                                 wavelength, Q));
+
+    return warnings.str();
+  }
+
+  // 3.18
+  template <typename NumT>
+  std::string
+  wavelength_to_scalar_Q(const Nessi::ExecutionPolicy & policy,
+                         const Nessi::SpectrumBlock<NumT> & wavelength,
+                         const InstrumentGeometryCache<NumT> & geometry,
+                         Nessi::SpectrumBlock<NumT> & Q,
+                         void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!wavelength.same_shape(Q))
+      {
+        throw std::invalid_argument(wtsq_func_str+" (b,c): blocks not the "
+                                    +"same shape");
+      }
+
+    // check that the cache describes the pixels
+    if (geometry.num_pixels() != wavelength.num_spectra())
+      {
+        throw std::invalid_argument(wtsq_func_str+" (b,c): geometry not "
+                                    +"the number of spectra");
+      }
+
+    // every pixel is converted with the constants of the cache
+    return __map_kernel(policy, __WavelengthToScalarQKernel<NumT>(geometry),
+                        wavelength, Q);
+  }
+
+  // 3.18
+  template <typename NumT>
+  std::string
+  wavelength_to_scalar_Q(const Nessi::SpectrumBlock<NumT> & wavelength,
+                         const InstrumentGeometryCache<NumT> & geometry,
+                         Nessi::SpectrumBlock<NumT> & Q,
+                         void *temp=NULL)
+  {
+    return wavelength_to_scalar_Q(Nessi::execution::seq, wavelength,
+                                  geometry, Q, temp);
   }
 } // AxisManip
 
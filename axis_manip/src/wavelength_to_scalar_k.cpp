@@ -82,4 +82,83 @@ namespace AxisManip
                                  double & wavevector,
                                  double & wavevector_err2,
                                  void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.24 for
+   * blocks
+   *
+   * \ingroup wavelength_to_scalar_k
+   */
+  template std::string
+  wavelength_to_scalar_k<float>(const Nessi::SpectrumBlock<float> & wavelength,
+                                Nessi::SpectrumBlock<float> & wavevector,
+                                void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.24 for
+   * blocks with an execution policy
+   *
+   * \ingroup wavelength_to_scalar_k
+   */
+  template std::string
+  wavelength_to_scalar_k<float>(const Nessi::ExecutionPolicy & policy,
+                                const Nessi::SpectrumBlock<float> & wavelength,
+                                Nessi::SpectrumBlock<float> & wavevector,
+                                void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.24 for blocks
+   *
+   * \ingroup wavelength_to_scalar_k
+   */
+  template std::string
+  wavelength_to_scalar_k<double>(const Nessi::SpectrumBlock<double> &
+                                 wavelength,
+                                 Nessi::SpectrumBlock<double> & wavevector,
+                                 void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.24 for blocks with an execution policy
+   *
+   * \ingroup wavelength_to_scalar_k
+   */
+  template std::string
+  wavelength_to_scalar_k<double>(const Nessi::ExecutionPolicy & policy,
+                                 const Nessi::SpectrumBlock<double> &
+                                 wavelength,
+                                 Nessi::SpectrumBlock<double> & wavevector,
+                                 void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.24 for views
+   *
+   * \ingroup wavelength_to_scalar_k
+   */
+  template std::string
+  wavelength_to_scalar_k<float>(const Nessi::VectorView<const float> &
+                                wavelength,
+                                const Nessi::VectorView<const float> &
+                                wavelength_err2,
+                                const Nessi::VectorView<float> & wavevector,
+                                const Nessi::VectorView<float> &
+                                wavevector_err2,
+                                void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.24 for views
+   *
+   * \ingroup wavelength_to_scalar_k
+   */
+  template std::string
+  wavelength_to_scalar_k<double>(const Nessi::VectorView<const double> &
+                                 wavelength,
+                                 const Nessi::VectorView<const double> &
+                                 wavelength_err2,
+                                 const Nessi::VectorView<double> & wavevector,
+                                 const Nessi::VectorView<double> &
+                                 wavevector_err2,
+                                 void *temp);
 } // AxisManip
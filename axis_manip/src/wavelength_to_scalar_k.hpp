@@ -32,6 +32,7 @@
 
 #include "constants.hpp"
 #include "conversions.hpp"
+#include "map_kernel.hpp"
 #include "nessi_warn.hpp"
 #include "size_checks.hpp"
 #include <stdexcept>
@@ -41,6 +42,54 @@ namespace AxisManip
   /// String for holding the wavelength_to_scalar_k function name
   const std::string wtsk_func_str = "AxisManip::wavelength_to_scalar_k";
 
+  /**
+   * \ingroup wavelength_to_scalar_k
+   *
+   * This is a PRIVATE map kernel (see \ref map_kernel) converting
+   * wavelength to scalar wavevector. The constants are the same for every
+   * pixel.
+   */
+  template <typename NumT>
+  class __WavelengthToScalarKKernel
+  {
+  public:
+    /// Type of the elements
+    typedef NumT value_type;
+
+    /// Constructor clearing the constants until setup() runs
+    __WavelengthToScalarKKernel()
+      : a_(0), a2_(0)
+    { }
+
+    /// Returns true, the conversion does not depend on the pixel
+    bool is_uniform() const
+    {
+      return true;
+    }
+
+    /// Calculates the constants
+    std::string setup(const std::size_t)
+    {
+      return __wavelength_to_scalar_k_static(a_, a2_);
+    }
+
+    /// Converts one bin
+    template <typename SinkT>
+    void operator()(const NumT wavelength, const NumT wavelength_err2,
+                    NumT & wavevector, NumT & wavevector_err2,
+                    SinkT & warnings) const
+    {
+      __wavelength_to_scalar_k_dynamic(wavelength, wavelength_err2, wavevector,
+                                       wavevector_err2, a_, a2_, warnings);
+    }
+
+  private:
+    /// The factor \f$2\pi\f$
+    NumT a_;
+    /// The square of the factor
+    NumT a2_;
+  };
+
   // 3.24
   template <typename NumT>
   std::string
@@ -81,24 +130,10 @@ namespace AxisManip
                                     +e.what());
       }
 
-    std::string retstr(Nessi::EMPTY_WARN);
-
-    NumT a;
-    NumT a2;
-
-    retstr += __wavelength_to_scalar_k_static(a, a2);
-
-    size_t size_wavelength = wavelength.size();
-    for (size_t i = 0 ; i < size_wavelength ; ++i)
-      {
-        retstr += __wavelength_to_scalar_k_dynamic(wavelength[i],
-                                                wavelength_err2[i],
-                                                wavevector[i],
-                                                wavevector_err2[i],
-                                                a, a2);
-      }
-
-    return retstr;
+    return __map_kernel(__WavelengthToScalarKKernel<NumT>(),
+                        wavelength.begin(), wavelength_err2.begin(),
+                        wavevector.begin(), wavevector_err2.begin(),
+                        wavelength.size());
   }
 
   // 3.24
@@ -110,18 +145,30 @@ namespace AxisManip
                          NumT & wavevector_err2,
                          void *temp=NULL)
   {
-    std::string retstr(Nessi::EMPTY_WARN);
-
-    NumT a;
-    NumT a2;
-
-    retstr += __wavelength_to_scalar_k_static(a, a2);
+    return __map_kernel(__WavelengthToScalarKKernel<NumT>(), &wavelength,
+                        &wavelength_err2, &wavevector, &wavevector_err2, 1);
+  }
 
-    retstr += __wavelength_to_scalar_k_dynamic(wavelength, wavelength_err2,
-                                               wavevector, wavevector_err2,
-                                               a, a2);
+  // 3.24
+  template <typename NumT>
+  std::string
+  wavelength_to_scalar_k(const Nessi::VectorView<const NumT> & wavelength,
+                         const Nessi::VectorView<const NumT> & wavelength_err2,
+                         const Nessi::VectorView<NumT> & wavevector,
+                         const Nessi::VectorView<NumT> & wavevector_err2,
+                         void *temp=NULL)
+  {
+    // check that the views are of proper size
+    size_t sz = wavelength.size();
+    if (wavelength_err2.size() != sz || wavevector.size() != sz
+        || wavevector_err2.size() != sz)
+      {
+        throw std::invalid_argument(wtsk_func_str+" (view): views not the "
+                                    +"same size");
+      }
 
-    return retstr;
+    return __map_kernel(__WavelengthToScalarKKernel<NumT>(), wavelength,
+                        wavelength_err2, wavevector, wavevector_err2, sz);
   }
 
   /**
@@ -162,21 +209,52 @@ namespace AxisManip
    * __wavelength_to_scalar_k_static()
    * \param a2 (INPUT) same as the parameter in
    * __wavelength_to_scalar_k_static()
+   * \param warnings (OUTPUT) is the sink receiving the warnings
    */
-  template <typename NumT>
-  std::string
+  template <typename NumT, typename SinkT>
+  void
   __wavelength_to_scalar_k_dynamic(const NumT wavelength,
                                    const NumT wavelength_err2,
                                    NumT & wavevector,
                                    NumT & wavevector_err2,
                                    const NumT a,
-                                   const NumT a2)
+                                   const NumT a2,
+                                   SinkT & warnings)
   {
     wavevector = a / wavelength;
     wavevector_err2 = (a2 * wavelength_err2)
       / (wavelength * wavelength * wavelength * wavelength);
+  }
 
-    return Nessi::EMPTY_WARN;
+  // 3.24
+  template <typename NumT>
+  std::string
+  wavelength_to_scalar_k(const Nessi::SpectrumBlock<NumT> & wavelength,
+                         Nessi::SpectrumBlock<NumT> & wavevector,
+                         void *temp=NULL)
+  {
+    return wavelength_to_scalar_k(Nessi::execution::seq, wavelength,
+                                  wavevector, temp);
+  }
+
+  // 3.24
+  template <typename NumT>
+  std::string
+  wavelength_to_scalar_k(const Nessi::ExecutionPolicy & policy,
+                         const Nessi::SpectrumBlock<NumT> & wavelength,
+                         Nessi::SpectrumBlock<NumT> & wavevector,
+                         void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!wavelength.same_shape(wavevector))
+      {
+        throw std::invalid_argument(wtsk_func_str+" (b): blocks not the "
+                                    +"same shape");
+      }
+
+    // blocks without padding are converted as a single array
+    return __map_kernel(policy, __WavelengthToScalarKKernel<NumT>(),
+                        wavelength, wavevector);
   }
 
 } // AxisManip
@@ -90,4 +90,89 @@ namespace AxisManip
                             double & tof,
                             double & tof_err2,
                             void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.16 for
+   * blocks
+   *
+   * \ingroup wavelength_to_tof
+   */
+  template std::string
+  wavelength_to_tof<float>(const Nessi::SpectrumBlock<float> & wavelength,
+                           const Nessi::Vector<float> & pathlength,
+                           const Nessi::Vector<float> & pathlength_err2,
+                           Nessi::SpectrumBlock<float> & tof,
+                           void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.16 for
+   * blocks with an execution policy
+   *
+   * \ingroup wavelength_to_tof
+   */
+  template std::string
+  wavelength_to_tof<float>(const Nessi::ExecutionPolicy & policy,
+                           const Nessi::SpectrumBlock<float> & wavelength,
+                           const Nessi::Vector<float> & pathlength,
+                           const Nessi::Vector<float> & pathlength_err2,
+                           Nessi::SpectrumBlock<float> & tof,
+                           void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.16 for blocks
+   *
+   * \ingroup wavelength_to_tof
+   */
+  template std::string
+  wavelength_to_tof<double>(const Nessi::SpectrumBlock<double> & wavelength,
+                            const Nessi::Vector<double> & pathlength,
+                            const Nessi::Vector<double> & pathlength_err2,
+                            Nessi::SpectrumBlock<double> & tof,
+                            void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.16 for blocks with an execution policy
+   *
+   * \ingroup wavelength_to_tof
+   */
+  template std::string
+  wavelength_to_tof<double>(const Nessi::ExecutionPolicy & policy,
+                            const Nessi::SpectrumBlock<double> & wavelength,
+                            const Nessi::Vector<double> & pathlength,
+                            const Nessi::Vector<double> & pathlength_err2,
+                            Nessi::SpectrumBlock<double> & tof,
+                            void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.16 for views
+   *
+   * \ingroup wavelength_to_tof
+   */
+  template std::string
+  wavelength_to_tof<float>(const Nessi::VectorView<const float> & wavelength,
+                           const Nessi::VectorView<const float> &
+                           wavelength_err2,
+                           const float pathlength,
+                           const float pathlength_err2,
+                           const Nessi::VectorView<float> & tof,
+                           const Nessi::VectorView<float> & tof_err2,
+                           void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.16 for views
+   *
+   * \ingroup wavelength_to_tof
+   */
+  template std::string
+  wavelength_to_tof<double>(const Nessi::VectorView<const double> & wavelength,
+                            const Nessi::VectorView<const double> &
+                            wavelength_err2,
+                            const double pathlength,
+                            const double pathlength_err2,
+                            const Nessi::VectorView<double> & tof,
+                            const Nessi::VectorView<double> & tof_err2,
+                            void *temp);
 } // AxisManip
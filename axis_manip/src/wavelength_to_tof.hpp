@@ -32,6 +32,7 @@
 
 #include "constants.hpp"
 #include "conversions.hpp"
+#include "map_kernel.hpp"
 #include "nessi_warn.hpp"
 #include "size_checks.hpp"
 #include <stdexcept>
@@ -41,6 +42,63 @@ namespace AxisManip
   /// String for holding the wavelength_to_tof function name
   const std::string wtt_func_str = "AxisManip::wavelength_to_tof";
 
+  /**
+   * \ingroup wavelength_to_tof
+   *
+   * This is a PRIVATE map kernel (see \ref map_kernel) converting the
+   * wavelength of pixel \f$p\f$ with the flight path \f$L[p]\f$.
+   */
+  template <typename NumT>
+  class __WavelengthToTofKernel
+  {
+  public:
+    /// Type of the elements
+    typedef NumT value_type;
+
+    /// Constructor keeping the flight paths of the pixels
+    __WavelengthToTofKernel(const Nessi::VectorView<const NumT> & pathlength,
+                            const Nessi::VectorView<const NumT> &
+                            pathlength_err2)
+      : pathlength_(pathlength), pathlength_err2_(pathlength_err2),
+        a_(0), a2_(0), a_err2_(0)
+    { }
+
+    /// Returns false, every pixel has its own flight path
+    bool is_uniform() const
+    {
+      return false;
+    }
+
+    /// Calculates the constants of pixel \p p
+    std::string setup(const std::size_t p)
+    {
+      return __wavelength_to_tof_static(pathlength_[p], pathlength_err2_[p],
+                                        a_, a2_, a_err2_);
+    }
+
+    /// Converts one bin
+    template <typename SinkT>
+    void operator()(const NumT wavelength, const NumT wavelength_err2,
+                    NumT & tof, NumT & tof_err2, SinkT & warnings) const
+    {
+      __wavelength_to_tof_dynamic(wavelength, wavelength_err2, a_, a2_,
+                                  a_err2_, tof, tof_err2, warnings);
+    }
+
+  private:
+    /// The flight path of every pixel
+    Nessi::VectorView<const NumT> pathlength_;
+    /// The squared uncertainty of every flight path
+    Nessi::VectorView<const NumT> pathlength_err2_;
+    /// The constants of the current pixel
+    NumT a_;
+    /// The constants of the current pixel
+    NumT a2_;
+    /// The constants of the current pixel
+    NumT a_err2_;
+  };
+
+
   // 3.16
   template <typename NumT>
   std::string
@@ -83,28 +141,12 @@ namespace AxisManip
                                     +e.what());
       }
 
-    std::string retstr(Nessi::EMPTY_WARN); // the warning string
-
-    // allocate local variables
-    NumT a;
-    NumT a2;
-    NumT a_err2;
-
-    // fill the local variables
-    retstr += __wavelength_to_tof_static(pathlength, pathlength_err2,
-                                         a, a2, a_err2);
     // do the calculation
-    size_t size_wavelength = wavelength.size();
-    for (size_t i = 0; i < size_wavelength; ++i)
-      {
-        retstr += __wavelength_to_tof_dynamic(wavelength[i], 
-                                              wavelength_err2[i],
-                                              a, a2, a_err2,
-                                              tof[i],
-                                              tof_err2[i]);
-      }
-
-    return retstr;
+    return __map_kernel(__WavelengthToTofKernel<NumT>(
+                          Nessi::VectorView<const NumT>(&pathlength, 1),
+                          Nessi::VectorView<const NumT>(&pathlength_err2, 1)),
+                        wavelength.begin(), wavelength_err2.begin(),
+                        tof.begin(), tof_err2.begin(), wavelength.size());
   }
 
   // 3.16
@@ -118,23 +160,38 @@ namespace AxisManip
                     NumT & tof_err2,
                     void *temp=NULL)
   {
-    std::string retstr(Nessi::EMPTY_WARN); // the warning string
-
-    // allocate local variables
-    NumT a;
-    NumT a2;
-    NumT a_err2;
+    // do the calculation
+    return __map_kernel(__WavelengthToTofKernel<NumT>(
+                          Nessi::VectorView<const NumT>(&pathlength, 1),
+                          Nessi::VectorView<const NumT>(&pathlength_err2, 1)),
+                        &wavelength, &wavelength_err2, &tof, &tof_err2, 1);
+  }
 
-    // fill the local variables
-    retstr += __wavelength_to_tof_static(pathlength, pathlength_err2,
-                                         a, a2, a_err2);
+  // 3.16
+  template <typename NumT>
+  std::string
+  wavelength_to_tof(const Nessi::VectorView<const NumT> & wavelength,
+                    const Nessi::VectorView<const NumT> & wavelength_err2,
+                    const NumT pathlength,
+                    const NumT pathlength_err2,
+                    const Nessi::VectorView<NumT> & tof,
+                    const Nessi::VectorView<NumT> & tof_err2,
+                    void *temp=NULL)
+  {
+    // check that the views are of proper size
+    size_t sz = wavelength.size();
+    if (wavelength_err2.size() != sz || tof.size() != sz
+        || tof_err2.size() != sz)
+      {
+        throw std::invalid_argument(wtt_func_str+" (view): views not the "
+                                    +"same size");
+      }
 
     // do the calculation
-    retstr += __wavelength_to_tof_dynamic(wavelength, wavelength_err2, 
-                                          a, a2, a_err2,
-                                          tof, tof_err2);
-
-    return retstr;
+    return __map_kernel(__WavelengthToTofKernel<NumT>(
+                          Nessi::VectorView<const NumT>(&pathlength, 1),
+                          Nessi::VectorView<const NumT>(&pathlength_err2, 1)),
+                        wavelength, wavelength_err2, tof, tof_err2, sz);
   }
 
   /**
@@ -191,23 +248,77 @@ namespace AxisManip
    * wavelength_to_tof()
    * \param  tof_err2 (OUTPUT) same as the parameter in
    * wavelength_to_tof()
+   * \param warnings (OUTPUT) is the sink receiving the warnings
    */
-  template <typename NumT>
-  std::string  __wavelength_to_tof_dynamic(const NumT wavelength,
-                                           const NumT wavelength_err2,
-                                           const NumT a,
-                                           const NumT a2,
-                                           const NumT a_err2,
-                                           NumT & tof,
-                                           NumT & tof_err2)
+  template <typename NumT, typename SinkT>
+  void
+  __wavelength_to_tof_dynamic(const NumT wavelength,
+                              const NumT wavelength_err2,
+                              const NumT a,
+                              const NumT a2,
+                              const NumT a_err2,
+                              NumT & tof,
+                              NumT & tof_err2,
+                              SinkT & warnings)
   {
     // calculate the value
     tof = a * wavelength;
 
     // calculate the uncertainty
     tof_err2 = (a2 * wavelength_err2) + ((wavelength * wavelength) * a_err2);
+  }
 
-    return Nessi::EMPTY_WARN;
+  // 3.16
+  template <typename NumT>
+  std::string
+  wavelength_to_tof(const Nessi::SpectrumBlock<NumT> & wavelength,
+                    const Nessi::Vector<NumT> & pathlength,
+                    const Nessi::Vector<NumT> & pathlength_err2,
+                    Nessi::SpectrumBlock<NumT> & tof,
+                    void *temp=NULL)
+  {
+    return wavelength_to_tof(Nessi::execution::seq, wavelength, pathlength,
+                             pathlength_err2, tof, temp);
+  }
+
+  // 3.16
+  template <typename NumT>
+  std::string
+  wavelength_to_tof(const Nessi::ExecutionPolicy & policy,
+                    const Nessi::SpectrumBlock<NumT> & wavelength,
+                    const Nessi::Vector<NumT> & pathlength,
+                    const Nessi::Vector<NumT> & pathlength_err2,
+                    Nessi::SpectrumBlock<NumT> & tof,
+                    void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!wavelength.same_shape(tof))
+      {
+        throw std::invalid_argument(wtt_func_str+" (b,v): blocks not the "
+                                    +"same shape");
+      }
+
+    // check that the pathlength arrays are of proper size
+    try
+      {
+        Utils::check_sizes_square(pathlength, pathlength_err2);
+      }
+    catch(std::invalid_argument &e)
+      {
+        throw std::invalid_argument(wtt_func_str+" (b,v): "
+                                    +"pathlength "+e.what());
+      }
+    if (pathlength.size() != wavelength.num_spectra())
+      {
+        throw std::invalid_argument(wtt_func_str+" (b,v): geometry not "
+                                    +"the number of spectra");
+      }
+
+    // every pixel is converted with its own flight path
+    return __map_kernel(policy,
+                        __WavelengthToTofKernel<NumT>(pathlength,
+                                                      pathlength_err2),
+                        wavelength, tof);
   }
 } // AxisManip
 
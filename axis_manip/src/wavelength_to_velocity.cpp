@@ -79,4 +79,82 @@ namespace AxisManip
                                  double & velocity,
                                  double & velocity_err2,
                                  void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.20 for
+   * blocks
+   *
+   * \ingroup wavelength_to_velocity
+   */
+  template std::string
+  wavelength_to_velocity<float>(const Nessi::SpectrumBlock<float> & wavelength,
+                                Nessi::SpectrumBlock<float> & velocity,
+                                void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.20 for
+   * blocks with an execution policy
+   *
+   * \ingroup wavelength_to_velocity
+   */
+  template std::string
+  wavelength_to_velocity<float>(const Nessi::ExecutionPolicy & policy,
+                                const Nessi::SpectrumBlock<float> & wavelength,
+                                Nessi::SpectrumBlock<float> & velocity,
+                                void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.20 for blocks
+   *
+   * \ingroup wavelength_to_velocity
+   */
+  template std::string
+  wavelength_to_velocity<double>(const Nessi::SpectrumBlock<double> &
+                                 wavelength,
+                                 Nessi::SpectrumBlock<double> & velocity,
+                                 void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.20 for blocks with an execution policy
+   *
+   * \ingroup wavelength_to_velocity
+   */
+  template std::string
+  wavelength_to_velocity<double>(const Nessi::ExecutionPolicy & policy,
+                                 const Nessi::SpectrumBlock<double> &
+                                 wavelength,
+                                 Nessi::SpectrumBlock<double> & velocity,
+                                 void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.20 for views
+   *
+   * \ingroup wavelength_to_velocity
+   */
+  template std::string
+  wavelength_to_velocity<float>(const Nessi::VectorView<const float> &
+                                wavelength,
+                                const Nessi::VectorView<const float> &
+                                wavelength_err2,
+                                const Nessi::VectorView<float> & velocity,
+                                const Nessi::VectorView<float> & velocity_err2,
+                                void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.20 for views
+   *
+   * \ingroup wavelength_to_velocity
+   */
+  template std::string
+  wavelength_to_velocity<double>(const Nessi::VectorView<const double> &
+                                 wavelength,
+                                 const Nessi::VectorView<const double> &
+                                 wavelength_err2,
+                                 const Nessi::VectorView<double> & velocity,
+                                 const Nessi::VectorView<double> &
+                                 velocity_err2,
+                                 void *temp);
 } // AxisManip
@@ -32,6 +32,7 @@
 
 #include "constants.hpp"
 #include "conversions.hpp"
+#include "map_kernel.hpp"
 #include "nessi_warn.hpp"
 #include "size_checks.hpp"
 #include <stdexcept>
@@ -41,6 +42,42 @@ namespace AxisManip
   /// String for holding the wavelength_to_velocity function name
   const std::string wtv_func_str = "AxisManip::wavelength_to_velocity";
 
+  /**
+   * \ingroup wavelength_to_velocity
+   *
+   * This is a PRIVATE map kernel (see \ref map_kernel) converting
+   * wavelength to velocity. The conversion has no constants.
+   */
+  template <typename NumT>
+  class __WavelengthToVelocityKernel
+  {
+  public:
+    /// Type of the elements
+    typedef NumT value_type;
+
+    /// Returns true, the conversion does not depend on the pixel
+    bool is_uniform() const
+    {
+      return true;
+    }
+
+    /// Calculates the constants
+    std::string setup(const std::size_t)
+    {
+      return Nessi::EMPTY_WARN;
+    }
+
+    /// Converts one bin
+    template <typename SinkT>
+    void operator()(const NumT wavelength, const NumT wavelength_err2,
+                    NumT & velocity, NumT & velocity_err2,
+                    SinkT & warnings) const
+    {
+      __wavelength_to_velocity_dynamic(wavelength, wavelength_err2, velocity,
+                                       velocity_err2, warnings);
+    }
+  };
+
   // 3.20
   template <typename NumT>
   std::string
@@ -81,20 +118,10 @@ namespace AxisManip
                                     +e.what());
       }
 
-    std::string retstr(Nessi::EMPTY_WARN); // the warning string
-    
-    
-    // do the calculation
-    size_t size_wavelength = wavelength.size();
-    for(size_t i = 0; i < size_wavelength; ++i)
-      {
-        retstr += __wavelength_to_velocity_dynamic(wavelength[i],
-                                                   wavelength_err2[i],
-                                                   velocity[i],
-                                                   velocity_err2[i]);
-      }
-
-    return retstr;
+    return __map_kernel(__WavelengthToVelocityKernel<NumT>(),
+                        wavelength.begin(), wavelength_err2.begin(),
+                        velocity.begin(), velocity_err2.begin(),
+                        wavelength.size());
   }
 
   // 3.20
@@ -106,15 +133,30 @@ namespace AxisManip
                          NumT & velocity_err2,
                          void *temp=NULL)
   {
-    std::string retstr(Nessi::EMPTY_WARN); // the warning string
+    return __map_kernel(__WavelengthToVelocityKernel<NumT>(), &wavelength,
+                        &wavelength_err2, &velocity, &velocity_err2, 1);
+  }
 
-    // do the calculation
-    retstr += __wavelength_to_velocity_dynamic(wavelength,
-                                               wavelength_err2,
-                                               velocity,
-                                               velocity_err2);
+  // 3.20
+  template <typename NumT>
+  std::string
+  wavelength_to_velocity(const Nessi::VectorView<const NumT> & wavelength,
+                         const Nessi::VectorView<const NumT> & wavelength_err2,
+                         const Nessi::VectorView<NumT> & velocity,
+                         const Nessi::VectorView<NumT> & velocity_err2,
+                         void *temp=NULL)
+  {
+    // check that the views are of proper size
+    size_t sz = wavelength.size();
+    if (wavelength_err2.size() != sz || velocity.size() != sz
+        || velocity_err2.size() != sz)
+      {
+        throw std::invalid_argument(wtv_func_str+" (view): views not the "
+                                    +"same size");
+      }
 
-    return retstr;
+    return __map_kernel(__WavelengthToVelocityKernel<NumT>(), wavelength,
+                        wavelength_err2, velocity, velocity_err2, sz);
   }
 
   /**
@@ -131,12 +173,15 @@ namespace AxisManip
    * wavelength_to_velocity()
    * \param velocity_err2 (OUTPUT) same as the parameter in
    * wavelength_to_velocity() 
+   * \param warnings (OUTPUT) is the sink receiving the warnings
    */
-  template <typename NumT>
-  std::string __wavelength_to_velocity_dynamic(const NumT wavelength,
-                                               const NumT wavelength_err2,
-                                               NumT & velocity,
-                                               NumT & velocity_err2)
+  template <typename NumT, typename SinkT>
+  void
+  __wavelength_to_velocity_dynamic(const NumT wavelength,
+                                   const NumT wavelength_err2,
+                                   NumT & velocity,
+                                   NumT & velocity_err2,
+                                   SinkT & warnings)
   {
     // calculate the value
     velocity = PhysConst::H_OVER_MNEUT / wavelength;
@@ -144,8 +189,37 @@ namespace AxisManip
     // calculate the uncertainty
     velocity_err2 = ((velocity * velocity) / (wavelength * wavelength)) 
       * wavelength_err2;
-    
-    return Nessi::EMPTY_WARN;
+  }
+
+  // 3.20
+  template <typename NumT>
+  std::string
+  wavelength_to_velocity(const Nessi::SpectrumBlock<NumT> & wavelength,
+                         Nessi::SpectrumBlock<NumT> & velocity,
+                         void *temp=NULL)
+  {
+    return wavelength_to_velocity(Nessi::execution::seq, wavelength, velocity,
+                                  temp);
+  }
+
+  // 3.20
+  template <typename NumT>
+  std::string
+  wavelength_to_velocity(const Nessi::ExecutionPolicy & policy,
+                         const Nessi::SpectrumBlock<NumT> & wavelength,
+                         Nessi::SpectrumBlock<NumT> & velocity,
+                         void *temp=NULL)
+  {
+    // check that the blocks are of proper shape
+    if (!wavelength.same_shape(velocity))
+      {
+        throw std::invalid_argument(wtv_func_str+" (b): blocks not the "
+                                    +"same shape");
+      }
+
+    // blocks without padding are converted as a single array
+    return __map_kernel(policy, __WavelengthToVelocityKernel<NumT>(),
+                        wavelength, velocity);
   }
 } // AxisManip
 
@@ -0,0 +1,787 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file axis_manip/test/cpp/conversion_block_test.cpp
+ */
+
+#include "conversions.hpp"
+#include "test_common.hpp"
+#include <stdexcept>
+
+using namespace std;
+
+/// Number of pixels of the blocks
+const size_t NUM_SPECTRA = 5;
+/// Number of bins in every spectrum
+const size_t NUM_BINS = 6;
+/// Stride of the padded blocks
+const size_t STRIDE = 8;
+
+/**
+ * \defgroup conversion_block_test conversion_block_test
+ * \{
+ *
+ * This test compares the block versions of the conversions written as map
+ * kernels with their vector versions applied to every spectrum. The
+ * numbers must be the same, not only close. The parallel execution policy
+ * must give the same blocks as the sequential one for any number of
+ * threads, and the versions taking the geometry of every pixel must reject
+ * a geometry without one element per spectrum.
+ */
+
+/**
+ * This class holds the geometry of the pixels of the tests.
+ */
+template <typename NumT>
+struct Geometry
+{
+  /// Flight path of every pixel
+  Nessi::Vector<NumT> pathlength;
+  /// Square of the uncertainty in the flight paths
+  Nessi::Vector<NumT> pathlength_err2;
+  /// Polar angle of every pixel
+  Nessi::Vector<NumT> polar;
+  /// Square of the uncertainty in the polar angles
+  Nessi::Vector<NumT> polar_err2;
+
+  /// Constructor filling the arrays for \p num_pixels pixels
+  explicit Geometry(const size_t num_pixels)
+  {
+    for (size_t p = 0; p < num_pixels; ++p)
+      {
+        pathlength.push_back(static_cast<NumT>(20. + 1.5 * p));
+        pathlength_err2.push_back(static_cast<NumT>(0.01 * (p + 1)));
+        polar.push_back(static_cast<NumT>(0.3 + 0.5 * p));
+        polar_err2.push_back(static_cast<NumT>(0.001 * (p + 1)));
+      }
+  }
+
+  /// Adds a pixel to every array
+  void add_pixel()
+  {
+    pathlength.push_back(pathlength.back());
+    pathlength_err2.push_back(pathlength_err2.back());
+    polar.push_back(polar.back());
+    polar_err2.push_back(polar_err2.back());
+  }
+};
+
+/**
+ * This class calls frequency_to_angular_frequency.
+ */
+template <typename NumT>
+struct FrequencyToAngularFrequency
+{
+  /// True if the conversion takes the geometry of every pixel
+  static const bool PER_PIXEL = false;
+
+  /// Returns the name of the conversion
+  static string name()
+  {
+    return "frequency_to_angular_frequency";
+  }
+
+  /// Converts a block
+  string operator()(const Nessi::ExecutionPolicy & policy,
+                    const Nessi::SpectrumBlock<NumT> & input,
+                    const Geometry<NumT> & geometry,
+                    Nessi::SpectrumBlock<NumT> & output) const
+  {
+    return AxisManip::frequency_to_angular_frequency(policy, input, output);
+  }
+
+  /// Converts the spectrum of pixel \p p
+  string operator()(const Nessi::Vector<NumT> & input,
+                    const Nessi::Vector<NumT> & input_err2,
+                    const Geometry<NumT> & geometry, const size_t p,
+                    Nessi::Vector<NumT> & output,
+                    Nessi::Vector<NumT> & output_err2) const
+  {
+    return AxisManip::frequency_to_angular_frequency(input, input_err2,
+                                                     output, output_err2);
+  }
+};
+
+/**
+ * This class calls frequency_to_energy.
+ */
+template <typename NumT>
+struct FrequencyToEnergy
+{
+  /// True if the conversion takes the geometry of every pixel
+  static const bool PER_PIXEL = false;
+
+  /// Returns the name of the conversion
+  static string name()
+  {
+    return "frequency_to_energy";
+  }
+
+  /// Converts a block
+  string operator()(const Nessi::ExecutionPolicy & policy,
+                    const Nessi::SpectrumBlock<NumT> & input,
+                    const Geometry<NumT> & geometry,
+                    Nessi::SpectrumBlock<NumT> & output) const
+  {
+    return AxisManip::frequency_to_energy(policy, input, output);
+  }
+
+  /// Converts the spectrum of pixel \p p
+  string operator()(const Nessi::Vector<NumT> & input,
+                    const Nessi::Vector<NumT> & input_err2,
+                    const Geometry<NumT> & geometry, const size_t p,
+                    Nessi::Vector<NumT> & output,
+                    Nessi::Vector<NumT> & output_err2) const
+  {
+    return AxisManip::frequency_to_energy(input, input_err2, output,
+                                          output_err2);
+  }
+};
+
+/**
+ * This class calls velocity_to_scalar_k.
+ */
+template <typename NumT>
+struct VelocityToScalarK
+{
+  /// True if the conversion takes the geometry of every pixel
+  static const bool PER_PIXEL = false;
+
+  /// Returns the name of the conversion
+  static string name()
+  {
+    return "velocity_to_scalar_k";
+  }
+
+  /// Converts a block
+  string operator()(const Nessi::ExecutionPolicy & policy,
+                    const Nessi::SpectrumBlock<NumT> & input,
+                    const Geometry<NumT> & geometry,
+                    Nessi::SpectrumBlock<NumT> & output) const
+  {
+    return AxisManip::velocity_to_scalar_k(policy, input, output);
+  }
+
+  /// Converts the spectrum of pixel \p p
+  string operator()(const Nessi::Vector<NumT> & input,
+                    const Nessi::Vector<NumT> & input_err2,
+                    const Geometry<NumT> & geometry, const size_t p,
+                    Nessi::Vector<NumT> & output,
+                    Nessi::Vector<NumT> & output_err2) const
+  {
+    return AxisManip::velocity_to_scalar_k(input, input_err2, output,
+                                           output_err2);
+  }
+};
+
+/**
+ * This class calls wavelength_to_scalar_k.
+ */
+template <typename NumT>
+struct WavelengthToScalarK
+{
+  /// True if the conversion takes the geometry of every pixel
+  static const bool PER_PIXEL = false;
+
+  /// Returns the name of the conversion
+  static string name()
+  {
+    return "wavelength_to_scalar_k";
+  }
+
+  /// Converts a block
+  string operator()(const Nessi::ExecutionPolicy & policy,
+                    const Nessi::SpectrumBlock<NumT> & input,
+                    const Geometry<NumT> & geometry,
+                    Nessi::SpectrumBlock<NumT> & output) const
+  {
+    return AxisManip::wavelength_to_scalar_k(policy, input, output);
+  }
+
+  /// Converts the spectrum of pixel \p p
+  string operator()(const Nessi::Vector<NumT> & input,
+                    const Nessi::Vector<NumT> & input_err2,
+                    const Geometry<NumT> & geometry, const size_t p,
+                    Nessi::Vector<NumT> & output,
+                    Nessi::Vector<NumT> & output_err2) const
+  {
+    return AxisManip::wavelength_to_scalar_k(input, input_err2, output,
+                                             output_err2);
+  }
+};
+
+/**
+ * This class calls velocity_to_wavelength.
+ */
+template <typename NumT>
+struct VelocityToWavelength
+{
+  /// True if the conversion takes the geometry of every pixel
+  static const bool PER_PIXEL = false;
+
+  /// Returns the name of the conversion
+  static string name()
+  {
+    return "velocity_to_wavelength";
+  }
+
+  /// Converts a block
+  string operator()(const Nessi::ExecutionPolicy & policy,
+                    const Nessi::SpectrumBlock<NumT> & input,
+                    const Geometry<NumT> & geometry,
+                    Nessi::SpectrumBlock<NumT> & output) const
+  {
+    return AxisManip::velocity_to_wavelength(policy, input, output);
+  }
+
+  /// Converts the spectrum of pixel \p p
+  string operator()(const Nessi::Vector<NumT> & input,
+                    const Nessi::Vector<NumT> & input_err2,
+                    const Geometry<NumT> & geometry, const size_t p,
+                    Nessi::Vector<NumT> & output,
+                    Nessi::Vector<NumT> & output_err2) const
+  {
+    return AxisManip::velocity_to_wavelength(input, input_err2, output,
+                                             output_err2);
+  }
+};
+
+/**
+ * This class calls wavelength_to_velocity.
+ */
+template <typename NumT>
+struct WavelengthToVelocity
+{
+  /// True if the conversion takes the geometry of every pixel
+  static const bool PER_PIXEL = false;
+
+  /// Returns the name of the conversion
+  static string name()
+  {
+    return "wavelength_to_velocity";
+  }
+
+  /// Converts a block
+  string operator()(const Nessi::ExecutionPolicy & policy,
+                    const Nessi::SpectrumBlock<NumT> & input,
+                    const Geometry<NumT> & geometry,
+                    Nessi::SpectrumBlock<NumT> & output) const
+  {
+    return AxisManip::wavelength_to_velocity(policy, input, output);
+  }
+
+  /// Converts the spectrum of pixel \p p
+  string operator()(const Nessi::Vector<NumT> & input,
+                    const Nessi::Vector<NumT> & input_err2,
+                    const Geometry<NumT> & geometry, const size_t p,
+                    Nessi::Vector<NumT> & output,
+                    Nessi::Vector<NumT> & output_err2) const
+  {
+    return AxisManip::wavelength_to_velocity(input, input_err2, output,
+                                             output_err2);
+  }
+};
+
+/**
+ * This class calls energy_to_wavelength.
+ */
+template <typename NumT>
+struct EnergyToWavelength
+{
+  /// True if the conversion takes the geometry of every pixel
+  static const bool PER_PIXEL = false;
+
+  /// Returns the name of the conversion
+  static string name()
+  {
+    return "energy_to_wavelength";
+  }
+
+  /// Converts a block
+  string operator()(const Nessi::ExecutionPolicy & policy,
+                    const Nessi::SpectrumBlock<NumT> & input,
+                    const Geometry<NumT> & geometry,
+                    Nessi::SpectrumBlock<NumT> & output) const
+  {
+    return AxisManip::energy_to_wavelength(policy, input, output);
+  }
+
+  /// Converts the spectrum of pixel \p p
+  string operator()(const Nessi::Vector<NumT> & input,
+                    const Nessi::Vector<NumT> & input_err2,
+                    const Geometry<NumT> & geometry, const size_t p,
+                    Nessi::Vector<NumT> & output,
+                    Nessi::Vector<NumT> & output_err2) const
+  {
+    return AxisManip::energy_to_wavelength(input, input_err2, output,
+                                           output_err2);
+  }
+};
+
+/**
+ * This class calls d_spacing_to_tof_focused_det with the geometry of the
+ * first pixel as the focused detector.
+ */
+template <typename NumT>
+struct DSpacingToTofFocusedDet
+{
+  /// True if the conversion takes the geometry of every pixel
+  static const bool PER_PIXEL = false;
+
+  /// Returns the name of the conversion
+  static string name()
+  {
+    return "d_spacing_to_tof_focused_det";
+  }
+
+  /// Converts a block
+  string operator()(const Nessi::ExecutionPolicy & policy,
+                    const Nessi::SpectrumBlock<NumT> & input,
+                    const Geometry<NumT> & geometry,
+                    Nessi::SpectrumBlock<NumT> & output) const
+  {
+    return AxisManip::d_spacing_to_tof_focused_det(policy, input,
+                                                   geometry.pathlength[0],
+                                                   geometry.pathlength_err2[0],
+                                                   geometry.polar[0],
+                                                   geometry.polar_err2[0],
+                                                   output);
+  }
+
+  /// Converts the spectrum of pixel \p p
+  string operator()(const Nessi::Vector<NumT> & input,
+                    const Nessi::Vector<NumT> & input_err2,
+                    const Geometry<NumT> & geometry, const size_t p,
+                    Nessi::Vector<NumT> & output,
+                    Nessi::Vector<NumT> & output_err2) const
+  {
+    return AxisManip::d_spacing_to_tof_focused_det(input, input_err2,
+                                                   geometry.pathlength[0],
+                                                   geometry.pathlength_err2[0],
+                                                   geometry.polar[0],
+                                                   geometry.polar_err2[0],
+                                                   output, output_err2);
+  }
+};
+
+/**
+ * This class calls wavelength_to_tof.
+ */
+template <typename NumT>
+struct WavelengthToTof
+{
+  /// True if the conversion takes the geometry of every pixel
+  static const bool PER_PIXEL = true;
+
+  /// Returns the name of the conversion
+  static string name()
+  {
+    return "wavelength_to_tof";
+  }
+
+  /// Converts a block
+  string operator()(const Nessi::ExecutionPolicy & policy,
+                    const Nessi::SpectrumBlock<NumT> & input,
+                    const Geometry<NumT> & geometry,
+                    Nessi::SpectrumBlock<NumT> & output) const
+  {
+    return AxisManip::wavelength_to_tof(policy, input, geometry.pathlength,
+                                        geometry.pathlength_err2, output);
+  }
+
+  /// Converts the spectrum of pixel \p p
+  string operator()(const Nessi::Vector<NumT> & input,
+                    const Nessi::Vector<NumT> & input_err2,
+                    const Geometry<NumT> & geometry, const size_t p,
+                    Nessi::Vector<NumT> & output,
+                    Nessi::Vector<NumT> & output_err2) const
+  {
+    return AxisManip::wavelength_to_tof(input, input_err2,
+                                        geometry.pathlength[p],
+                                        geometry.pathlength_err2[p],
+                                        output, output_err2);
+  }
+};
+
+/**
+ * This class calls tof_to_wavelength_lin_time_zero with a time zero shared
+ * by all pixels.
+ */
+template <typename NumT>
+struct TofToWavelengthLinTimeZero
+{
+  /// True if the conversion takes the geometry of every pixel
+  static const bool PER_PIXEL = true;
+
+  /// Returns the name of the conversion
+  static string name()
+  {
+    return "tof_to_wavelength_lin_time_zero";
+  }
+
+  /// Converts a block
+  string operator()(const Nessi::ExecutionPolicy & policy,
+                    const Nessi::SpectrumBlock<NumT> & input,
+                    const Geometry<NumT> & geometry,
+                    Nessi::SpectrumBlock<NumT> & output) const
+  {
+    return AxisManip::tof_to_wavelength_lin_time_zero(policy, input,
+                                                      geometry.pathlength,
+                                                      geometry.pathlength_err2,
+                                                      static_cast<NumT>(0.5),
+                                                      static_cast<NumT>(0.01),
+                                                      static_cast<NumT>(2.),
+                                                      static_cast<NumT>(0.1),
+                                                      output);
+  }
+
+  /// Converts the spectrum of pixel \p p
+  string operator()(const Nessi::Vector<NumT> & input,
+                    const Nessi::Vector<NumT> & input_err2,
+                    const Geometry<NumT> & geometry, const size_t p,
+                    Nessi::Vector<NumT> & output,
+                    Nessi::Vector<NumT> & output_err2) const
+  {
+    return AxisManip::tof_to_wavelength_lin_time_zero(input, input_err2,
+                                                  geometry.pathlength[p],
+                                                  geometry.pathlength_err2[p],
+                                                  static_cast<NumT>(0.5),
+                                                  static_cast<NumT>(0.01),
+                                                  static_cast<NumT>(2.),
+                                                  static_cast<NumT>(0.1),
+                                                  output, output_err2);
+  }
+};
+
+/**
+ * This class calls tof_to_initial_wavelength_igs_lin_time_zero with the
+ * flight paths as the sample to detector distances.
+ */
+template <typename NumT>
+struct TofToInitialWavelengthIgsLinTimeZero
+{
+  /// True if the conversion takes the geometry of every pixel
+  static const bool PER_PIXEL = true;
+
+  /// Returns the name of the conversion
+  static string name()
+  {
+    return "tof_to_initial_wavelength_igs_lin_time_zero";
+  }
+
+  /// Converts a block
+  string operator()(const Nessi::ExecutionPolicy & policy,
+                    const Nessi::SpectrumBlock<NumT> & input,
+                    const Geometry<NumT> & geometry,
+                    Nessi::SpectrumBlock<NumT> & output) const
+  {
+    return AxisManip::tof_to_initial_wavelength_igs_lin_time_zero(policy,
+                                                  input,
+                                                  static_cast<NumT>(6.7),
+                                                  static_cast<NumT>(0.02),
+                                                  static_cast<NumT>(0.5),
+                                                  static_cast<NumT>(0.01),
+                                                  static_cast<NumT>(2.),
+                                                  static_cast<NumT>(0.1),
+                                                  static_cast<NumT>(15.),
+                                                  static_cast<NumT>(0.03),
+                                                  geometry.pathlength,
+                                                  geometry.pathlength_err2,
+                                                  output);
+  }
+
+  /// Converts the spectrum of pixel \p p
+  string operator()(const Nessi::Vector<NumT> & input,
+                    const Nessi::Vector<NumT> & input_err2,
+                    const Geometry<NumT> & geometry, const size_t p,
+                    Nessi::Vector<NumT> & output,
+                    Nessi::Vector<NumT> & output_err2) const
+  {
+    return AxisManip::tof_to_initial_wavelength_igs_lin_time_zero(input,
+                                                  input_err2,
+                                                  static_cast<NumT>(6.7),
+                                                  static_cast<NumT>(0.02),
+                                                  static_cast<NumT>(0.5),
+                                                  static_cast<NumT>(0.01),
+                                                  static_cast<NumT>(2.),
+                                                  static_cast<NumT>(0.1),
+                                                  static_cast<NumT>(15.),
+                                                  static_cast<NumT>(0.03),
+                                                  geometry.pathlength[p],
+                                                  geometry.pathlength_err2[p],
+                                                  output, output_err2);
+  }
+};
+
+/**
+ * This class calls wavelength_to_d_spacing.
+ */
+template <typename NumT>
+struct WavelengthToDSpacing
+{
+  /// True if the conversion takes the geometry of every pixel
+  static const bool PER_PIXEL = true;
+
+  /// Returns the name of the conversion
+  static string name()
+  {
+    return "wavelength_to_d_spacing";
+  }
+
+  /// Converts a block
+  string operator()(const Nessi::ExecutionPolicy & policy,
+                    const Nessi::SpectrumBlock<NumT> & input,
+                    const Geometry<NumT> & geometry,
+                    Nessi::SpectrumBlock<NumT> & output) const
+  {
+    return AxisManip::wavelength_to_d_spacing(policy, input, geometry.polar,
+                                              geometry.polar_err2, output);
+  }
+
+  /// Converts the spectrum of pixel \p p
+  string operator()(const Nessi::Vector<NumT> & input,
+                    const Nessi::Vector<NumT> & input_err2,
+                    const Geometry<NumT> & geometry, const size_t p,
+                    Nessi::Vector<NumT> & output,
+                    Nessi::Vector<NumT> & output_err2) const
+  {
+    return AxisManip::wavelength_to_d_spacing(input, input_err2,
+                                              geometry.polar[p],
+                                              geometry.polar_err2[p],
+                                              output, output_err2);
+  }
+};
+
+/**
+ * This function fills every spectrum of a block with positive values.
+ *
+ * \param block (OUTPUT) is the block to fill
+ */
+template <typename NumT>
+void initialize_block(Nessi::SpectrumBlock<NumT> & block)
+{
+  Nessi::Vector<NumT> value(block.num_bins());
+  Nessi::Vector<NumT> err2(block.num_bins());
+  for (size_t p = 0; p < block.num_spectra(); ++p)
+    {
+      for (size_t i = 0; i < block.num_bins(); ++i)
+        {
+          value[i] = static_cast<NumT>(1000. + 250. * i + 35. * p);
+          err2[i] = static_cast<NumT>(1. + 0.5 * i + 0.25 * p);
+        }
+      block.set_spectrum(p, value, err2);
+    }
+}
+
+/**
+ * Function that compares the block version of a conversion with its
+ * vector version for one layout of the blocks.
+ *
+ * \param conversion (INPUT) is the conversion to test
+ * \param stride (INPUT) is the stride of the blocks
+ * \param debug (INPUT) is any string that launches the debug mode
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT, typename ConvT>
+bool test_layout(const ConvT & conversion, const size_t stride,
+                 string debug)
+{
+  Geometry<NumT> geometry(NUM_SPECTRA);
+  Nessi::SpectrumBlock<NumT> input(NUM_SPECTRA, NUM_BINS, stride);
+  initialize_block(input);
+  Nessi::SpectrumBlock<NumT> output(NUM_SPECTRA, NUM_BINS, stride);
+  conversion(Nessi::execution::seq, input, geometry, output);
+
+  Nessi::Vector<NumT> in(NUM_BINS);
+  Nessi::Vector<NumT> in_err2(NUM_BINS);
+  Nessi::Vector<NumT> true_output(NUM_BINS);
+  Nessi::Vector<NumT> true_output_err2(NUM_BINS);
+  Nessi::Vector<NumT> out(NUM_BINS);
+  Nessi::Vector<NumT> out_err2(NUM_BINS);
+
+  for (size_t p = 0; p < NUM_SPECTRA; ++p)
+    {
+      input.get_spectrum(p, in, in_err2);
+      conversion(in, in_err2, geometry, p, true_output, true_output_err2);
+      output.get_spectrum(p, out, out_err2);
+
+      if (!debug.empty())
+        {
+          print(out, true_output, conversion.name(), debug);
+          print(out_err2, true_output_err2, ERROR + conversion.name(),
+                debug);
+        }
+
+      if (!Utils::vector_is_equals(out, true_output)
+          || !Utils::vector_is_equals(out_err2, true_output_err2))
+        {
+          cout << "(" << type_string(out) << " " << conversion.name()
+               << ", pixel " << p << ") FAILED....Block different from "
+               << "the vector version" << endl;
+          return false;
+        }
+    }
+
+  for (int num_threads = 1; num_threads <= 3; ++num_threads)
+    {
+      Nessi::set_num_threads(num_threads);
+      Nessi::SpectrumBlock<NumT> par_out(NUM_SPECTRA, NUM_BINS, stride);
+      conversion(Nessi::execution::par, input, geometry, par_out);
+      if (par_out.value() != output.value()
+          || par_out.err2() != output.err2())
+        {
+          cout << "(" << type_string(in) << " " << conversion.name() << ", "
+               << num_threads << " threads) FAILED....Parallel output "
+               << "different from sequential" << endl;
+          return false;
+        }
+    }
+  Nessi::set_num_threads(0);
+
+  return true;
+}
+
+/**
+ * Function that runs the tests of one conversion for contiguous and padded
+ * blocks and checks that blocks and geometry of the wrong size are
+ * rejected.
+ *
+ * \param conversion (INPUT) is the conversion to test
+ * \param debug (INPUT) is any string that launches the debug mode
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT, typename ConvT>
+bool test_conversion(const ConvT & conversion, string debug)
+{
+  if (!test_layout<NumT>(conversion, NUM_BINS, debug)
+      || !test_layout<NumT>(conversion, STRIDE, debug))
+    {
+      return false;
+    }
+
+  Geometry<NumT> geometry(NUM_SPECTRA);
+  Nessi::SpectrumBlock<NumT> input(NUM_SPECTRA, NUM_BINS);
+  initialize_block(input);
+  Nessi::SpectrumBlock<NumT> wrong(NUM_SPECTRA + 1, NUM_BINS);
+  try
+    {
+      conversion(Nessi::execution::seq, input, geometry, wrong);
+      cout << "(" << conversion.name() << ") FAILED....No exception "
+           << "thrown for the blocks" << endl;
+      return false;
+    }
+  catch (std::invalid_argument &)
+    {
+    }
+
+  if (ConvT::PER_PIXEL)
+    {
+      Nessi::SpectrumBlock<NumT> output(NUM_SPECTRA, NUM_BINS);
+      geometry.add_pixel();
+      try
+        {
+          conversion(Nessi::execution::seq, input, geometry, output);
+          cout << "(" << conversion.name() << ") FAILED....No exception "
+               << "thrown for the geometry" << endl;
+          return false;
+        }
+      catch (std::invalid_argument &)
+        {
+        }
+    }
+
+  return true;
+}
+
+/**
+ * Function that runs the tests of every conversion.
+ *
+ * \param key (INPUT) key that permits to launch the correct test
+ * \param debug (INPUT) is any string that launches the debug mode (print all
+ * the array created and calculated)
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_func(NumT key, string debug)
+{
+  return test_conversion<NumT>(FrequencyToAngularFrequency<NumT>(), debug)
+    && test_conversion<NumT>(FrequencyToEnergy<NumT>(), debug)
+    && test_conversion<NumT>(VelocityToScalarK<NumT>(), debug)
+    && test_conversion<NumT>(WavelengthToScalarK<NumT>(), debug)
+    && test_conversion<NumT>(VelocityToWavelength<NumT>(), debug)
+    && test_conversion<NumT>(WavelengthToVelocity<NumT>(), debug)
+    && test_conversion<NumT>(EnergyToWavelength<NumT>(), debug)
+    && test_conversion<NumT>(DSpacingToTofFocusedDet<NumT>(), debug)
+    && test_conversion<NumT>(WavelengthToTof<NumT>(), debug)
+    && test_conversion<NumT>(TofToWavelengthLinTimeZero<NumT>(), debug)
+    && test_conversion<NumT>(TofToInitialWavelengthIgsLinTimeZero<NumT>(),
+                             debug)
+    && test_conversion<NumT>(WavelengthToDSpacing<NumT>(), debug);
+}
+
+/**
+ * Main function that tests the block conversions for float and double.
+ *
+ * \param argc The number of command-line arguments present
+ * \param argv The list of command-line arguments
+ */
+int main(int argc, char *argv[])
+{
+  cout << "conversion_block_test.cpp..........";
+
+  string debug;
+  if (argc >1)
+    {
+      debug = argv[1];
+    }
+
+  int value = 0;
+
+  if(!test_func(static_cast<float>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(!test_func(static_cast<double>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(value == 0)
+    {
+      cout << "Functionality OK" << endl;
+    }
+
+  return value;
+}
+
+/**
+ * \}
+ */   //end of conversion_block_test group
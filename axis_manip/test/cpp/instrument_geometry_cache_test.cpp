@@ -0,0 +1,538 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file axis_manip/test/cpp/instrument_geometry_cache_test.cpp
+ */
+
+#include "conversions.hpp"
+#include "test_common.hpp"
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+using namespace std;
+
+/// Number of pixels of the instrument
+const size_t NUM_SPECTRA = 5;
+/// Number of bins in every spectrum
+const size_t NUM_BINS = 6;
+/// Stride of the padded blocks
+const size_t STRIDE = 8;
+/// Initial wavevector of the init_scatt_wavevector_to_Q tests
+const double INITIAL_WAVEVECTOR = 2.5;
+/// Square of the uncertainty in the initial wavevector
+const double INITIAL_WAVEVECTOR_ERR2 = 0.01;
+
+/**
+ * \defgroup instrument_geometry_cache_test instrument_geometry_cache_test
+ * \{
+ *
+ * This test runs the block versions of <i>tof_to_wavelength</i>,
+ * <i>tof_to_scalar_Q</i>, <i>wavelength_to_scalar_Q</i> and
+ * <i>init_scatt_wavevector_to_Q</i> taking an InstrumentGeometryCache
+ * and compares every spectrum of the result with the version of the
+ * function for one spectrum and the geometry of its pixel. The parallel
+ * execution policy must give the same blocks as the sequential one, and a
+ * cache read back from a file must give the same blocks as the cache it
+ * was saved from. Damaged files must be rejected.
+ *
+ * <b>Notation used:</b>
+ * - VV = "v,v"
+ * - ERROR = "Error"
+ */
+
+/**
+ * This class holds the geometry of the pixels of the tests.
+ */
+template <typename NumT>
+struct Geometry
+{
+  /// Flight path of every pixel
+  Nessi::Vector<NumT> pathlength;
+  /// Square of the uncertainty in the flight paths
+  Nessi::Vector<NumT> pathlength_err2;
+  /// Polar angle of every pixel
+  Nessi::Vector<NumT> polar;
+  /// Square of the uncertainty in the polar angles
+  Nessi::Vector<NumT> polar_err2;
+  /// Azimuthal angle of every pixel
+  Nessi::Vector<NumT> azimuthal;
+  /// Square of the uncertainty in the azimuthal angles
+  Nessi::Vector<NumT> azimuthal_err2;
+
+  /// Constructor filling the arrays for \p num_pixels pixels
+  explicit Geometry(const size_t num_pixels)
+  {
+    for (size_t p = 0; p < num_pixels; ++p)
+      {
+        pathlength.push_back(static_cast<NumT>(20. + 1.5 * p));
+        pathlength_err2.push_back(static_cast<NumT>(0.01 * (p + 1)));
+        polar.push_back(static_cast<NumT>(0.3 + 0.5 * p));
+        polar_err2.push_back(static_cast<NumT>(0.001 * (p + 1)));
+        azimuthal.push_back(static_cast<NumT>(-1.2 + 0.6 * p));
+        azimuthal_err2.push_back(static_cast<NumT>(0.002 * (p + 1)));
+      }
+  }
+
+  /// Returns the cache of the pixels
+  AxisManip::InstrumentGeometryCache<NumT> cache() const
+  {
+    return AxisManip::InstrumentGeometryCache<NumT>(pathlength,
+                                                    pathlength_err2,
+                                                    polar, polar_err2,
+                                                    azimuthal,
+                                                    azimuthal_err2);
+  }
+};
+
+/**
+ * This function fills every spectrum of a block with positive values.
+ *
+ * \param block (OUTPUT) is the block to fill
+ */
+template <typename NumT>
+void initialize_block(Nessi::SpectrumBlock<NumT> & block)
+{
+  Nessi::Vector<NumT> value(block.num_bins());
+  Nessi::Vector<NumT> err2(block.num_bins());
+  for (size_t p = 0; p < block.num_spectra(); ++p)
+    {
+      for (size_t i = 0; i < block.num_bins(); ++i)
+        {
+          value[i] = static_cast<NumT>(1000. + 250. * i + 35. * p);
+          err2[i] = static_cast<NumT>(1. + 0.5 * i + 0.25 * p);
+        }
+      block.set_spectrum(p, value, err2);
+    }
+}
+
+/**
+ * Function that compares spectrum \p p of a block with the expected
+ * arrays.
+ *
+ * \param block (INPUT) is the block created by the block version
+ * \param p (INPUT) is the spectrum to compare
+ * \param true_output (INPUT) is the value expected
+ * \param true_output_err2 (INPUT) is the squared uncertainty expected
+ * \param what (INPUT) is the name of the function for the error message
+ * \param debug (INPUT) is any string that launches the debug mode
+ */
+template <typename NumT>
+bool test_okay(const Nessi::SpectrumBlock<NumT> & block, const size_t p,
+               Nessi::Vector<NumT> & true_output,
+               Nessi::Vector<NumT> & true_output_err2,
+               const string & what, string debug)
+{
+  Nessi::Vector<NumT> output(block.num_bins());
+  Nessi::Vector<NumT> output_err2(block.num_bins());
+  block.get_spectrum(p, output, output_err2);
+
+  if (!debug.empty())
+    {
+      print(output, true_output, VV, debug);
+      print(output_err2, true_output_err2, ERROR + VV, debug);
+    }
+
+  if (!Utils::vector_is_equals(output, true_output)
+      || !Utils::vector_is_equals(output_err2, true_output_err2))
+    {
+      cout << "(" << type_string(output) << " " << what << ", spectrum "
+           << p << ") FAILED....Output different from vector expected"
+           << endl;
+      return false;
+    }
+  return true;
+}
+
+/**
+ * Function that returns true if two blocks hold the same numbers.
+ */
+template <typename NumT>
+bool same_block(const Nessi::SpectrumBlock<NumT> & block1,
+                const Nessi::SpectrumBlock<NumT> & block2)
+{
+  return block1.value() == block2.value() && block1.err2() == block2.err2();
+}
+
+/**
+ * This class holds the results of all conversions with one cache.
+ */
+template <typename NumT>
+struct Results
+{
+  /// Result of tof_to_wavelength
+  Nessi::SpectrumBlock<NumT> wavelength;
+  /// Result of tof_to_scalar_Q
+  Nessi::SpectrumBlock<NumT> tof_Q;
+  /// Result of wavelength_to_scalar_Q
+  Nessi::SpectrumBlock<NumT> wavelength_Q;
+  /// Results of init_scatt_wavevector_to_Q
+  Nessi::SpectrumBlock<NumT> Qx;
+  /// Results of init_scatt_wavevector_to_Q
+  Nessi::SpectrumBlock<NumT> Qy;
+  /// Results of init_scatt_wavevector_to_Q
+  Nessi::SpectrumBlock<NumT> Qz;
+
+  /// Constructor running the conversions of \p input
+  Results(const Nessi::ExecutionPolicy & policy,
+          const Nessi::SpectrumBlock<NumT> & input,
+          const AxisManip::InstrumentGeometryCache<NumT> & cache,
+          const size_t stride)
+    : wavelength(NUM_SPECTRA, NUM_BINS, stride),
+      tof_Q(NUM_SPECTRA, NUM_BINS, stride),
+      wavelength_Q(NUM_SPECTRA, NUM_BINS, stride),
+      Qx(NUM_SPECTRA, NUM_BINS, stride),
+      Qy(NUM_SPECTRA, NUM_BINS, stride),
+      Qz(NUM_SPECTRA, NUM_BINS, stride)
+  {
+    AxisManip::tof_to_wavelength(policy, input, cache, wavelength);
+    AxisManip::tof_to_scalar_Q(policy, input, cache, tof_Q);
+    AxisManip::wavelength_to_scalar_Q(policy, wavelength, cache,
+                                      wavelength_Q);
+    AxisManip::init_scatt_wavevector_to_Q(policy,
+                                   static_cast<NumT>(INITIAL_WAVEVECTOR),
+                                   static_cast<NumT>(INITIAL_WAVEVECTOR_ERR2),
+                                   input, cache, Qx, Qy, Qz);
+  }
+
+  /// Returns true if all blocks are the same as the ones of \p other
+  bool operator==(const Results & other) const
+  {
+    return same_block(wavelength, other.wavelength)
+      && same_block(tof_Q, other.tof_Q)
+      && same_block(wavelength_Q, other.wavelength_Q)
+      && same_block(Qx, other.Qx) && same_block(Qy, other.Qy)
+      && same_block(Qz, other.Qz);
+  }
+};
+
+/**
+ * Function that compares the conversions with a cache with the versions
+ * for one spectrum.
+ *
+ * \param stride (INPUT) is the stride of the blocks
+ * \param debug (INPUT) is any string that launches the debug mode
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_layout(const size_t stride, string debug)
+{
+  Geometry<NumT> geometry(NUM_SPECTRA);
+  AxisManip::InstrumentGeometryCache<NumT> cache = geometry.cache();
+  if (cache.num_pixels() != NUM_SPECTRA)
+    {
+      cout << "(" << type_string(geometry.polar) << ") FAILED....Wrong "
+           << "number of pixels" << endl;
+      return false;
+    }
+
+  Nessi::SpectrumBlock<NumT> input(NUM_SPECTRA, NUM_BINS, stride);
+  initialize_block(input);
+  Results<NumT> results(Nessi::execution::seq, input, cache, stride);
+
+  Nessi::Vector<NumT> in(NUM_BINS);
+  Nessi::Vector<NumT> in_err2(NUM_BINS);
+  Nessi::Vector<NumT> true_output(NUM_BINS);
+  Nessi::Vector<NumT> true_output_err2(NUM_BINS);
+  Nessi::Vector<NumT> true_Qx(NUM_BINS);
+  Nessi::Vector<NumT> true_Qx_err2(NUM_BINS);
+  Nessi::Vector<NumT> true_Qy(NUM_BINS);
+  Nessi::Vector<NumT> true_Qy_err2(NUM_BINS);
+  Nessi::Vector<NumT> true_Qz(NUM_BINS);
+  Nessi::Vector<NumT> true_Qz_err2(NUM_BINS);
+
+  for (size_t p = 0; p < NUM_SPECTRA; ++p)
+    {
+      input.get_spectrum(p, in, in_err2);
+      AxisManip::tof_to_wavelength(in, in_err2, geometry.pathlength[p],
+                                   geometry.pathlength_err2[p],
+                                   true_output, true_output_err2);
+      if (!test_okay(results.wavelength, p, true_output, true_output_err2,
+                     "tof_to_wavelength", debug))
+        {
+          return false;
+        }
+
+      AxisManip::tof_to_scalar_Q(in, in_err2, geometry.pathlength[p],
+                                 geometry.pathlength_err2[p],
+                                 geometry.polar[p], geometry.polar_err2[p],
+                                 true_output, true_output_err2);
+      if (!test_okay(results.tof_Q, p, true_output, true_output_err2,
+                     "tof_to_scalar_Q", debug))
+        {
+          return false;
+        }
+
+      for (size_t i = 0; i < NUM_BINS; ++i)
+        {
+          AxisManip::init_scatt_wavevector_to_Q(
+                                  static_cast<NumT>(INITIAL_WAVEVECTOR),
+                                  static_cast<NumT>(INITIAL_WAVEVECTOR_ERR2),
+                                  in[i], in_err2[i],
+                                  geometry.azimuthal[p],
+                                  geometry.azimuthal_err2[p],
+                                  geometry.polar[p], geometry.polar_err2[p],
+                                  true_Qx[i], true_Qx_err2[i],
+                                  true_Qy[i], true_Qy_err2[i],
+                                  true_Qz[i], true_Qz_err2[i]);
+        }
+      if (!test_okay(results.Qx, p, true_Qx, true_Qx_err2,
+                     "init_scatt_wavevector_to_Q", debug)
+          || !test_okay(results.Qy, p, true_Qy, true_Qy_err2,
+                        "init_scatt_wavevector_to_Q", debug)
+          || !test_okay(results.Qz, p, true_Qz, true_Qz_err2,
+                        "init_scatt_wavevector_to_Q", debug))
+        {
+          return false;
+        }
+
+      results.wavelength.get_spectrum(p, in, in_err2);
+      AxisManip::wavelength_to_scalar_Q(in, in_err2, geometry.polar[p],
+                                        geometry.polar_err2[p],
+                                        true_output, true_output_err2);
+      if (!test_okay(results.wavelength_Q, p, true_output, true_output_err2,
+                     "wavelength_to_scalar_Q", debug))
+        {
+          return false;
+        }
+    }
+
+  // the parallel policy gives the same result for any number of threads
+  for (int num_threads = 1; num_threads <= 3; ++num_threads)
+    {
+      Nessi::set_num_threads(num_threads);
+      Results<NumT> par_results(Nessi::execution::par, input, cache, stride);
+      if (!(par_results == results))
+        {
+          cout << "(" << type_string(in) << ", " << num_threads
+               << " threads) FAILED....Parallel output different from "
+               << "sequential" << endl;
+          return false;
+        }
+    }
+  Nessi::set_num_threads(0);
+
+  return true;
+}
+
+/**
+ * Function that returns true if loading \p filename into a cache throws
+ * an ErrorT and leaves the cache alone.
+ */
+template <typename NumT, typename ErrorT>
+bool load_fails(const string & filename)
+{
+  AxisManip::InstrumentGeometryCache<NumT> cache =
+    Geometry<NumT>(2).cache();
+  try
+    {
+      cache.load(filename);
+      return false;
+    }
+  catch (ErrorT &)
+    {
+    }
+  return cache.num_pixels() == 2;
+}
+
+/**
+ * Function that saves a cache, loads it back and checks that damaged
+ * files are rejected.
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_file()
+{
+  const string filename = "instrument_geometry_cache_test.tmp";
+  const string damaged = "instrument_geometry_cache_test.bad";
+  Geometry<NumT> geometry(NUM_SPECTRA);
+  AxisManip::InstrumentGeometryCache<NumT> cache = geometry.cache();
+  cache.save(filename);
+
+  AxisManip::InstrumentGeometryCache<NumT> loaded;
+  loaded.load(filename);
+
+  Nessi::SpectrumBlock<NumT> input(NUM_SPECTRA, NUM_BINS);
+  initialize_block(input);
+  if (loaded.num_pixels() != NUM_SPECTRA
+      || !(Results<NumT>(Nessi::execution::seq, input, loaded, NUM_BINS)
+           == Results<NumT>(Nessi::execution::seq, input, cache, NUM_BINS)))
+    {
+      cout << "(" << type_string(geometry.polar) << ") FAILED....Loaded "
+           << "cache different from saved" << endl;
+      std::remove(filename.c_str());
+      return false;
+    }
+
+  // read the file to build the damaged copies from it
+  string content;
+  {
+    ifstream file(filename.c_str(), ios::in | ios::binary);
+    char c;
+    while (file.get(c))
+      {
+        content += c;
+      }
+  }
+  std::remove(filename.c_str());
+
+  bool okay = load_fails<NumT, std::runtime_error>(
+                                       "instrument_geometry_cache_test.none");
+  {
+    ofstream file(damaged.c_str(), ios::out | ios::binary | ios::trunc);
+    file.write(content.data(), content.size() - 1);
+  }
+  okay = okay && load_fails<NumT, std::invalid_argument>(damaged);
+  {
+    ofstream file(damaged.c_str(), ios::out | ios::binary | ios::trunc);
+    file.write(content.data(), content.size());
+    file.put(0);
+  }
+  okay = okay && load_fails<NumT, std::invalid_argument>(damaged);
+  {
+    // the size of the floating point type does not match
+    string wrong_type = content;
+    wrong_type[2 * sizeof(unsigned int)] ^= 0x0C;
+    ofstream file(damaged.c_str(), ios::out | ios::binary | ios::trunc);
+    file.write(wrong_type.data(), wrong_type.size());
+  }
+  okay = okay && load_fails<NumT, std::invalid_argument>(damaged);
+  {
+    // the number of pixels would overflow the size of the cache
+    string huge = content;
+    for (size_t i = 4 * sizeof(unsigned int); i < 6 * sizeof(unsigned int);
+         ++i)
+      {
+        huge[i] = static_cast<char>(0xFF);
+      }
+    ofstream file(damaged.c_str(), ios::out | ios::binary | ios::trunc);
+    file.write(huge.data(), huge.size());
+  }
+  okay = okay && load_fails<NumT, std::invalid_argument>(damaged);
+  std::remove(damaged.c_str());
+
+  if (!okay)
+    {
+      cout << "(" << type_string(geometry.polar) << ") FAILED....Damaged "
+           << "file accepted" << endl;
+      return false;
+    }
+  return true;
+}
+
+/**
+ * Function that runs the tests for contiguous and padded blocks and checks
+ * that a geometry of the wrong size is rejected.
+ *
+ * \param key (INPUT) key that permits to launch the correct test
+ * \param debug (INPUT) is any string that launches the debug mode (print all
+ * the array created and calculated)
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_func(NumT key, string debug)
+{
+  if (!test_layout<NumT>(NUM_BINS, debug) || !test_layout<NumT>(STRIDE, debug)
+      || !test_file<NumT>())
+    {
+      return false;
+    }
+
+  Geometry<NumT> geometry(NUM_SPECTRA);
+  geometry.azimuthal.push_back(0);
+  try
+    {
+      geometry.cache();
+      cout << "(" << type_string(geometry.polar) << ") FAILED....No "
+           << "exception thrown for the geometry" << endl;
+      return false;
+    }
+  catch (std::invalid_argument &)
+    {
+    }
+
+  AxisManip::InstrumentGeometryCache<NumT> cache =
+    Geometry<NumT>(NUM_SPECTRA - 1).cache();
+  Nessi::SpectrumBlock<NumT> tof(NUM_SPECTRA, NUM_BINS);
+  Nessi::SpectrumBlock<NumT> wavelength(NUM_SPECTRA, NUM_BINS);
+  try
+    {
+      AxisManip::tof_to_wavelength(tof, cache, wavelength);
+      cout << "(" << type_string(geometry.polar) << ") FAILED....No "
+           << "exception thrown for the cache" << endl;
+      return false;
+    }
+  catch (std::invalid_argument &)
+    {
+    }
+
+  return true;
+}
+
+/**
+ * Main function that tests the conversions with a geometry cache for
+ * float and double.
+ *
+ * \param argc The number of command-line arguments present
+ * \param argv The list of command-line arguments
+ */
+int main(int argc, char *argv[])
+{
+  cout << "instrument_geometry_cache_test.cpp..........";
+
+  string debug;
+  if (argc >1)
+    {
+      debug = argv[1];
+    }
+
+  int value = 0;
+
+  if(!test_func(static_cast<float>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(!test_func(static_cast<double>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(value == 0)
+    {
+      cout << "Functionality OK" << endl;
+    }
+
+  return value;
+}
+
+/**
+ * \}
+ */   //end of instrument_geometry_cache_test group
@@ -30,6 +30,8 @@
 
 #include "rebinning.hpp"
 #include "test_common.hpp"
+#include <sstream>
+#include <stdexcept>
 
 using namespace std;
 
@@ -49,6 +51,15 @@ const size_t SIZE_TWO_QUADS = 2 * SIZE_QUAD;
  * Any discrepancy between the outputs (\f$output\f$ and \f$true\_output\f$)
  * will generate in the testsuite.log file an error message that gives details
  * about the location and type of the error.
+ * The same rebinning is repeated with a
+ * <i>AxisManip::Rebin2DQuadToRectlinStep</i>, which must give the same
+ * result and must reject a bin count array and input arrays of the wrong
+ * size, and with a
+ * <i>AxisManip::Rebin2DQuadToRectlinPlan</i>, which must give identical
+ * arrays before and after being saved and loaded, with the parallel
+ * execution policy, which must give identical arrays for any number of
+ * threads, and with a <i>AxisManip::Rebin2DQuadToRectlinTiling</i>, which
+ * must give identical arrays for the whole grid and tile by tile.
  */
 
 /**
@@ -459,9 +470,190 @@ bool test_func(NumT key, string debug) // key forces correct test to happen
       print(bin_count, true_bin_count, VV, debug);
     }
 
-  return test_okay(output, output_err2, frac_area, bin_count,
-                   true_output, true_output_err2, true_frac_area, 
-                   true_bin_count);
+  bool value = test_okay(output, output_err2, frac_area, bin_count,
+                         true_output, true_output_err2, true_frac_area,
+                         true_bin_count);
+
+  // the validated step gives the same result
+  Nessi::Vector<NumT> step_output(output.size());
+  Nessi::Vector<NumT> step_output_err2(output.size());
+  Nessi::Vector<NumT> step_frac_area(output.size());
+  Nessi::Vector<NumT> step_bin_count(output.size());
+  AxisManip::Rebin2DQuadToRectlinStep<NumT> step(NUM_VAL, axis_out_1,
+                                                 axis_out_2, step_output,
+                                                 step_output_err2,
+                                                 step_frac_area,
+                                                 step_bin_count);
+  step.execute(axis_in_x1, axis_in_y1, axis_in_x2, axis_in_y2,
+               axis_in_x3, axis_in_y3, axis_in_x4, axis_in_y4,
+               input, input_err2);
+  if (!test_okay(step_output, step_output_err2, step_frac_area,
+                 step_bin_count, true_output, true_output_err2,
+                 true_frac_area, true_bin_count))
+    {
+      value = false;
+    }
+
+  // the step checks the shapes once
+  Nessi::Vector<NumT> short_bin_count(output.size() - 1);
+  try
+    {
+      AxisManip::Rebin2DQuadToRectlinStep<NumT> bad_step(NUM_VAL, axis_out_1,
+                                                         axis_out_2,
+                                                         step_output,
+                                                         step_output_err2,
+                                                         step_frac_area,
+                                                         short_bin_count);
+      cout << "(step) FAILED....No exception thrown" << endl;
+      value = false;
+    }
+  catch (std::invalid_argument &)
+    {
+    }
+
+  // every call checks the number of quadrilaterals
+  Nessi::Vector<NumT> short_input(input.size() - 1);
+  try
+    {
+      step.execute(axis_in_x1, axis_in_y1, axis_in_x2, axis_in_y2,
+                   axis_in_x3, axis_in_y3, axis_in_x4, axis_in_y4,
+                   short_input, input_err2);
+      cout << "(step execute) FAILED....No exception thrown" << endl;
+      value = false;
+    }
+  catch (std::invalid_argument &)
+    {
+    }
+  try
+    {
+      step.execute(axis_in_x1, axis_in_y1, axis_in_x2, axis_in_y2,
+                   axis_in_x3, short_input, axis_in_x4, axis_in_y4,
+                   input, input_err2);
+      cout << "(step execute) FAILED....No exception thrown" << endl;
+      value = false;
+    }
+  catch (std::invalid_argument &)
+    {
+    }
+
+  // the plan gives identical arrays, also after a round trip on a stream
+  AxisManip::Rebin2DQuadToRectlinPlan<NumT> plan(axis_in_x1, axis_in_y1,
+                                                 axis_in_x2, axis_in_y2,
+                                                 axis_in_x3, axis_in_y3,
+                                                 axis_in_x4, axis_in_y4,
+                                                 axis_out_1, axis_out_2);
+  std::stringstream stream;
+  plan.save(stream);
+  AxisManip::Rebin2DQuadToRectlinPlan<NumT> loaded;
+  loaded.load(stream);
+  for (int i = 0; i < 2; ++i)
+    {
+      Nessi::Vector<NumT> plan_output(output.size());
+      Nessi::Vector<NumT> plan_output_err2(output.size());
+      Nessi::Vector<NumT> plan_frac_area(output.size());
+      Nessi::Vector<NumT> plan_bin_count(output.size());
+      (i == 0 ? plan : loaded).apply(input, input_err2, plan_output,
+                                     plan_output_err2, plan_frac_area,
+                                     plan_bin_count);
+      if (plan_output != output || plan_output_err2 != output_err2
+          || plan_frac_area != frac_area || plan_bin_count != bin_count)
+        {
+          cout << "(plan " << i << ") FAILED....Output different from "
+               << "function" << endl;
+          value = false;
+        }
+    }
+
+  // the parallel version gives identical arrays for any number of threads
+  for (int num_threads = 1; num_threads <= 5; ++num_threads)
+    {
+      Nessi::set_num_threads(num_threads);
+      Nessi::Vector<NumT> par_output(output.size());
+      Nessi::Vector<NumT> par_output_err2(output.size());
+      Nessi::Vector<NumT> par_frac_area(output.size());
+      Nessi::Vector<NumT> par_bin_count(output.size());
+      AxisManip::rebin_2D_quad_to_rectlin(Nessi::execution::par,
+                                          axis_in_x1, axis_in_y1,
+                                          axis_in_x2, axis_in_y2,
+                                          axis_in_x3, axis_in_y3,
+                                          axis_in_x4, axis_in_y4,
+                                          input, input_err2,
+                                          axis_out_1, axis_out_2,
+                                          par_output, par_output_err2,
+                                          par_frac_area, par_bin_count);
+      if (par_output != output || par_output_err2 != output_err2
+          || par_frac_area != frac_area || par_bin_count != bin_count)
+        {
+          cout << "(" << num_threads << " threads) FAILED....Parallel "
+               << "output different from sequential" << endl;
+          value = false;
+        }
+    }
+  Nessi::set_num_threads(0);
+
+  // the tiling gives identical arrays for the whole grid and tile by tile
+  AxisManip::Rebin2DQuadToRectlinTiling<NumT> tiling(axis_in_x1, axis_in_y1,
+                                                     axis_in_x2, axis_in_y2,
+                                                     axis_in_x3, axis_in_y3,
+                                                     axis_in_x4, axis_in_y4,
+                                                     axis_out_1, axis_out_2,
+                                                     3, 2);
+  Nessi::Vector<NumT> tiled_output(output.size());
+  Nessi::Vector<NumT> tiled_output_err2(output.size());
+  Nessi::Vector<NumT> tiled_frac_area(output.size());
+  Nessi::Vector<NumT> tiled_bin_count(output.size());
+  tiling.apply(input, input_err2, tiled_output, tiled_output_err2,
+               tiled_frac_area, tiled_bin_count);
+  if (tiled_output != output || tiled_output_err2 != output_err2
+      || tiled_frac_area != frac_area || tiled_bin_count != bin_count)
+    {
+      cout << "(tiling) FAILED....Output different from function" << endl;
+      value = false;
+    }
+
+  size_t num_bins_2 = axis_out_2.size() - 1;
+  for (size_t t = 0; t < tiling.num_tiles(); ++t)
+    {
+      size_t begin_1, end_1, begin_2, end_2;
+      tiling.tile_bounds(t, begin_1, end_1, begin_2, end_2);
+      size_t width = end_2 - begin_2;
+      size_t num_bins = (end_1 - begin_1) * width;
+      Nessi::Vector<NumT> tile_output(num_bins);
+      Nessi::Vector<NumT> tile_output_err2(num_bins);
+      Nessi::Vector<NumT> tile_frac_area(num_bins);
+      Nessi::Vector<NumT> tile_bin_count(num_bins);
+      tiling.apply_tile(t, input, input_err2, tile_output, tile_output_err2,
+                        tile_frac_area, tile_bin_count);
+      for (size_t b = 0; b < num_bins; ++b)
+        {
+          size_t c = (begin_2 + b % width) + (begin_1 + b / width)
+            * num_bins_2;
+          if (tile_output[b] != output[c]
+              || tile_output_err2[b] != output_err2[c]
+              || tile_frac_area[b] != frac_area[c]
+              || tile_bin_count[b] != bin_count[c])
+            {
+              cout << "(tile " << t << ") FAILED....Output different from "
+                   << "function" << endl;
+              value = false;
+              break;
+            }
+        }
+    }
+
+  // a stream that does not hold a plan is rejected
+  std::stringstream bad_stream("Rebin2DQuadToRectlinPlan 1\n5 3");
+  try
+    {
+      loaded.load(bad_stream);
+      cout << "(plan) FAILED....No exception thrown" << endl;
+      value = false;
+    }
+  catch (std::invalid_argument &)
+    {
+    }
+
+  return value;
 }
 
 /**
@@ -33,6 +33,11 @@
 
 using namespace std;
 
+/// Number of rows of the larger histogram
+const size_t NUM_ROWS = 70;
+/// Number of columns of the larger histogram
+const size_t NUM_COLS = 45;
+
 /**
  * \defgroup rebin_array_2D_test rebin_array_2D_test
  * \{
@@ -41,7 +46,10 @@ using namespace std;
  * function <i>rebin_array_2D</i> and described in 3.13
  * of the <i>SNS 107030214-TD0001-R00, "Data Reduction Library Software
  * Requirements and Specifications"</i> with the true output data
- * \f$true\_output\f$ manually calculated.
+ * \f$true\_output\f$ manually calculated. A histogram larger than the
+ * tiles of the transpose is compared with rebin_axis_1D applied to every
+ * row and then to every column, and the parallel execution policy must
+ * give the same result for any number of threads.
  * Any discrepancy between the outputs (\f$output\f$ and \f$true\_output\f$)
  * will generate in the testsuite.log file an error message that gives details
  * about the location and type of the error.
@@ -168,6 +176,139 @@ bool test_okay(Nessi::Vector<NumT> & output,
   return value;
 }
 
+/**
+ * This function returns an axis of \f$n\f$ bins whose edges grow
+ * quadratically from \f$start\f$.
+ */
+template <typename NumT>
+Nessi::Vector<NumT> make_axis(const size_t n, const NumT start,
+                              const NumT scale)
+{
+  Nessi::Vector<NumT> axis;
+  for (size_t i = 0; i <= n; ++i)
+    {
+      axis.push_back(start + scale * static_cast<NumT>(i * (i + 3)));
+    }
+  return axis;
+}
+
+/**
+ * Function that rebins a histogram larger than the tiles of the transpose
+ * and compares it with <i>rebin_axis_1D</i> applied to the rows and then
+ * to the columns. The results must be identical, also with the parallel
+ * execution policy for any number of threads.
+ *
+ * \param debug (INPUT) is any string that launches the debug mode
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_large(string debug)
+{
+  Nessi::Vector<NumT> axis_in_1 = make_axis(NUM_ROWS, static_cast<NumT>(0.),
+                                            static_cast<NumT>(0.125));
+  Nessi::Vector<NumT> axis_in_2 = make_axis(NUM_COLS, static_cast<NumT>(0.),
+                                            static_cast<NumT>(0.25));
+  Nessi::Vector<NumT> axis_out_1 = make_axis(NUM_COLS,
+                                             static_cast<NumT>(-3.),
+                                             static_cast<NumT>(0.375));
+  Nessi::Vector<NumT> axis_out_2 = make_axis(NUM_ROWS,
+                                             static_cast<NumT>(5.),
+                                             static_cast<NumT>(0.0625));
+
+  Nessi::Vector<NumT> input(NUM_ROWS * NUM_COLS);
+  Nessi::Vector<NumT> input_err2(NUM_ROWS * NUM_COLS);
+  for (size_t p = 0; p < input.size(); ++p)
+    {
+      input[p] = static_cast<NumT>(p % 17 + 1);
+      input_err2[p] = static_cast<NumT>(p % 5 + 1);
+    }
+
+  // rebin the rows along the 2nd axis, then the columns along the 1st
+  Nessi::Vector<NumT> stage(NUM_ROWS * NUM_ROWS);
+  Nessi::Vector<NumT> stage_err2(NUM_ROWS * NUM_ROWS);
+  Nessi::Vector<NumT> in(NUM_COLS);
+  Nessi::Vector<NumT> in_err2(NUM_COLS);
+  Nessi::Vector<NumT> out(NUM_ROWS);
+  Nessi::Vector<NumT> out_err2(NUM_ROWS);
+  for (size_t i = 0; i < NUM_ROWS; ++i)
+    {
+      for (size_t j = 0; j < NUM_COLS; ++j)
+        {
+          in[j] = input[i * NUM_COLS + j];
+          in_err2[j] = input_err2[i * NUM_COLS + j];
+        }
+      out.assign(NUM_ROWS, static_cast<NumT>(0));
+      out_err2.assign(NUM_ROWS, static_cast<NumT>(0));
+      AxisManip::rebin_axis_1D(axis_in_2, in, in_err2, axis_out_2, out,
+                               out_err2);
+      for (size_t j = 0; j < NUM_ROWS; ++j)
+        {
+          stage[i * NUM_ROWS + j] = out[j];
+          stage_err2[i * NUM_ROWS + j] = out_err2[j];
+        }
+    }
+
+  Nessi::Vector<NumT> true_output(NUM_COLS * NUM_ROWS);
+  Nessi::Vector<NumT> true_output_err2(NUM_COLS * NUM_ROWS);
+  in.assign(NUM_ROWS, static_cast<NumT>(0));
+  in_err2.assign(NUM_ROWS, static_cast<NumT>(0));
+  for (size_t j = 0; j < NUM_ROWS; ++j)
+    {
+      for (size_t i = 0; i < NUM_ROWS; ++i)
+        {
+          in[i] = stage[i * NUM_ROWS + j];
+          in_err2[i] = stage_err2[i * NUM_ROWS + j];
+        }
+      out.assign(NUM_COLS, static_cast<NumT>(0));
+      out_err2.assign(NUM_COLS, static_cast<NumT>(0));
+      AxisManip::rebin_axis_1D(axis_in_1, in, in_err2, axis_out_1, out,
+                               out_err2);
+      for (size_t i = 0; i < NUM_COLS; ++i)
+        {
+          true_output[i * NUM_ROWS + j] = out[i];
+          true_output_err2[i * NUM_ROWS + j] = out_err2[i];
+        }
+    }
+
+  Nessi::Vector<NumT> output(NUM_COLS * NUM_ROWS);
+  Nessi::Vector<NumT> output_err2(NUM_COLS * NUM_ROWS);
+  AxisManip::rebin_axis_2D(axis_in_1, axis_in_2, input, input_err2,
+                           axis_out_1, axis_out_2, output, output_err2);
+
+  if (!debug.empty())
+    {
+      print(output, true_output, VV, debug);
+      print(output_err2, true_output_err2, ERROR + VV, debug);
+    }
+
+  if (output != true_output || output_err2 != true_output_err2)
+    {
+      cout << "(" << type_string(output) << ") FAILED....Output different "
+           << "from rebin_axis_1D" << endl;
+      return false;
+    }
+
+  // the parallel policy gives the same result for any number of threads
+  for (int num_threads = 1; num_threads <= 3; ++num_threads)
+    {
+      Nessi::set_num_threads(num_threads);
+      AxisManip::rebin_axis_2D(Nessi::execution::par, axis_in_1, axis_in_2,
+                               input, input_err2, axis_out_1, axis_out_2,
+                               output, output_err2);
+      if (output != true_output || output_err2 != true_output_err2)
+        {
+          cout << "(" << type_string(output) << ", " << num_threads
+               << " threads) FAILED....Parallel output different from "
+               << "sequential" << endl;
+          return false;
+        }
+    }
+  Nessi::set_num_threads(0);
+
+  return true;
+}
+
 /**
  * Function that generates the data using the <i>rebin_axis_2D</i> function
  * (as described in the documentation of the <i>rebin_axis_2D</i> function)
@@ -215,7 +356,12 @@ bool test_func(NumT key, string debug) // key forces correct test to happen
       print(output_err2, true_output_err2, ERROR+VV, debug);
     }
 
-  return test_okay(output, output_err2, true_output, true_output_err2);
+  if(!test_okay(output, output_err2, true_output, true_output_err2))
+    {
+      return false;
+    }
+
+  return test_large<NumT>(debug);
 }
 
 /**
@@ -0,0 +1,445 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+
+/**
+ * $Id$
+ *
+ * \file axis_manip/test/cpp/rebin_axis_4D_test.cpp
+ */
+
+#include "rebinning.hpp"
+#include "test_common.hpp"
+#include <stdexcept>
+
+using namespace std;
+
+/// Number of bins of the initial axes of the sparse histogram
+const size_t NUM_SPARSE_IN = 20;
+/// Number of bins of the target axes of the sparse histogram
+const size_t NUM_SPARSE_OUT = 12;
+/// Number of bins along every side of a brick
+const size_t BRICK_SIZE = 4;
+
+/**
+ * \defgroup rebin_axis_4D_test rebin_axis_4D_test
+ * \{
+ *
+ * This test compares the output data calculated by the library
+ * function <i>rebin_axis_4D</i> and described in 3.14
+ * of the <i>SNS 107030214-TD0001-R00, "Data Reduction Library Software
+ * Requirements and Specifications"</i> with the true output data
+ * \f$true\_output\f$ manually calculated. The sparse version must give the
+ * dense result, and the parallel execution policy must give the same
+ * histogram as the sequential one for any number of threads.
+ * Any discrepancy between the outputs (\f$output\f$ and \f$true\_output\f$)
+ * will generate in the testsuite.log file an error message that gives details
+ * about the location and type of the error.
+ */
+
+/**
+ * This function initializes the four axes of a histogram with the given
+ * edges.
+ *
+ * \param edges (INPUT) are the edges of every axis
+ * \param axis_1 (OUTPUT) is the 1st axis
+ * \param axis_2 (OUTPUT) is the 2nd axis
+ * \param axis_3 (OUTPUT) is the 3rd axis
+ * \param axis_4 (OUTPUT) is the 4th axis
+ */
+template <typename NumT>
+void initialize_axes(const Nessi::Vector<NumT> & edges,
+                     Nessi::Vector<NumT> & axis_1,
+                     Nessi::Vector<NumT> & axis_2,
+                     Nessi::Vector<NumT> & axis_3,
+                     Nessi::Vector<NumT> & axis_4)
+{
+  axis_1 = edges;
+  axis_2 = edges;
+  axis_3 = edges;
+  axis_4 = edges;
+}
+
+/**
+ * This function initializes the value of arrays, \f$axis\_in\_1\f$ to
+ * \f$axis\_in\_4\f$, \f$axis\_out\_1\f$ to \f$axis\_out\_4\f$, \f$input\f$,
+ * and \f$input\_err2\f$. The three initial bins of every axis are rebinned
+ * into two bins and the data only depend on the 4th axis.
+ *
+ * \param axis_in (OUTPUT) are the four initial axes
+ * \param axis_out (OUTPUT) are the four target axes
+ * \param input (OUTPUT) is the data associated with the initial axes
+ * \param input_err2 (OUTPUT) is the square of the uncertainty associated with
+ * the data
+ */
+template <typename NumT>
+void initialize_inputs(Nessi::Vector<NumT> * axis_in,
+                       Nessi::Vector<NumT> * axis_out,
+                       Nessi::Vector<NumT> & input,
+                       Nessi::Vector<NumT> & input_err2)
+{
+  Nessi::Vector<NumT> edges_in;
+  edges_in.push_back(static_cast<NumT>(0.));
+  edges_in.push_back(static_cast<NumT>(1.));
+  edges_in.push_back(static_cast<NumT>(2.));
+  edges_in.push_back(static_cast<NumT>(3.));
+  initialize_axes(edges_in, axis_in[0], axis_in[1], axis_in[2],
+                  axis_in[3]);
+
+  Nessi::Vector<NumT> edges_out;
+  edges_out.push_back(static_cast<NumT>(0.));
+  edges_out.push_back(static_cast<NumT>(1.5));
+  edges_out.push_back(static_cast<NumT>(3.));
+  initialize_axes(edges_out, axis_out[0], axis_out[1], axis_out[2],
+                  axis_out[3]);
+
+  for (size_t p = 0; p < 81; ++p)
+    {
+      input.push_back(static_cast<NumT>(10 * (p % 3 + 1)));
+      input_err2.push_back(static_cast<NumT>((p % 3 + 1) * (p % 3 + 1)));
+    }
+}
+
+/**
+ * This function sets the true outputs based on values contained in
+ * \f$axis\_in\_1\f$ to \f$axis\_in\_4\f$, \f$axis\_out\_1\f$ to
+ * \f$axis\_out\_4\f$, \f$input\f$, and \f$input\_err2\f$. Every target bin
+ * holds \f$1.5^3\f$ initial bins along the first three axes, whose squared
+ * weights add up to \f$1.25^3\f$.
+ *
+ * \param true_output (OUTPUT) is the true output
+ * \param true_output_err2 (OUTPUT) is the square of the uncertainty of the
+ * true output
+ */
+template <typename NumT>
+void initialize_true_outputs(Nessi::Vector<NumT> & true_output,
+                             Nessi::Vector<NumT> & true_output_err2)
+{
+  for (size_t p = 0; p < 16; ++p)
+    {
+      if (p % 2 == 0)
+        {
+          true_output.push_back(static_cast<NumT>(67.5));
+          true_output_err2.push_back(static_cast<NumT>(3.90625));
+        }
+      else
+        {
+          true_output.push_back(static_cast<NumT>(135.));
+          true_output_err2.push_back(static_cast<NumT>(19.53125));
+        }
+    }
+}
+
+/**
+ * This function initializes a larger histogram whose data are zero
+ * outside of a small region, and target axes of uneven bins.
+ *
+ * \param axis_in (OUTPUT) are the four initial axes
+ * \param axis_out (OUTPUT) are the four target axes
+ * \param input (OUTPUT) is the data associated with the initial axes
+ * \param input_err2 (OUTPUT) is the square of the uncertainty associated with
+ * the data
+ */
+template <typename NumT>
+void initialize_sparse_inputs(Nessi::Vector<NumT> * axis_in,
+                              Nessi::Vector<NumT> * axis_out,
+                              Nessi::Vector<NumT> & input,
+                              Nessi::Vector<NumT> & input_err2)
+{
+  Nessi::Vector<NumT> edges_in;
+  for (size_t i = 0; i <= NUM_SPARSE_IN; ++i)
+    {
+      edges_in.push_back(static_cast<NumT>(i));
+    }
+  initialize_axes(edges_in, axis_in[0], axis_in[1], axis_in[2],
+                  axis_in[3]);
+
+  Nessi::Vector<NumT> edges_out;
+  for (size_t i = 0; i <= NUM_SPARSE_OUT; ++i)
+    {
+      edges_out.push_back(static_cast<NumT>(-1.) +
+                          static_cast<NumT>(i * i) / static_cast<NumT>(6.));
+    }
+  initialize_axes(edges_out, axis_out[0], axis_out[1], axis_out[2],
+                  axis_out[3]);
+
+  size_t num_bins = NUM_SPARSE_IN * NUM_SPARSE_IN * NUM_SPARSE_IN
+    * NUM_SPARSE_IN;
+  input.assign(num_bins, static_cast<NumT>(0));
+  input_err2.assign(num_bins, static_cast<NumT>(0));
+  for (size_t i = 2; i < 9; ++i)
+    {
+      for (size_t j = 1; j < 6; ++j)
+        {
+          for (size_t k = 3; k < 7; ++k)
+            {
+              for (size_t l = 0; l < 5; ++l)
+                {
+                  size_t p = ((i * NUM_SPARSE_IN + j) * NUM_SPARSE_IN + k)
+                    * NUM_SPARSE_IN + l;
+                  input[p] = static_cast<NumT>(i + 2 * j + 3 * k + l + 1);
+                  input_err2[p] = static_cast<NumT>(i + j + k + l + 1);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Function that runs the sparse version of <i>rebin_axis_4D</i> and
+ * compares it with the dense version, then checks that the parallel
+ * execution policy gives the same histogram for any number of threads.
+ *
+ * \param debug (INPUT) is any string that launches the debug mode
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_sparse(string debug)
+{
+  Nessi::Vector<NumT> axis_in[4];
+  Nessi::Vector<NumT> axis_out[4];
+  Nessi::Vector<NumT> input;
+  Nessi::Vector<NumT> input_err2;
+  initialize_sparse_inputs(axis_in, axis_out, input, input_err2);
+
+  size_t num_bins = NUM_SPARSE_OUT * NUM_SPARSE_OUT * NUM_SPARSE_OUT
+    * NUM_SPARSE_OUT;
+  Nessi::Vector<NumT> true_output(num_bins);
+  Nessi::Vector<NumT> true_output_err2(num_bins);
+  AxisManip::rebin_axis_4D(axis_in[0], axis_in[1], axis_in[2], axis_in[3],
+                           input, input_err2,
+                           axis_out[0], axis_out[1], axis_out[2],
+                           axis_out[3], true_output, true_output_err2);
+
+  Nessi::SparseHistogram4D<NumT> sparse(NUM_SPARSE_OUT, NUM_SPARSE_OUT,
+                                        NUM_SPARSE_OUT, NUM_SPARSE_OUT,
+                                        BRICK_SIZE);
+  AxisManip::rebin_axis_4D(Nessi::execution::seq,
+                           axis_in[0], axis_in[1], axis_in[2], axis_in[3],
+                           input, input_err2,
+                           axis_out[0], axis_out[1], axis_out[2],
+                           axis_out[3], sparse);
+
+  Nessi::Vector<NumT> output;
+  Nessi::Vector<NumT> output_err2;
+  sparse.to_dense(output, output_err2);
+
+  if (!debug.empty())
+    {
+      cout << endl << sparse.num_bricks() << " bricks" << endl;
+      print(output, true_output, VV, debug);
+      print(output_err2, true_output_err2, ERROR + VV, debug);
+    }
+
+  if (output != true_output || output_err2 != true_output_err2)
+    {
+      cout << "(" << type_string(output) << ") FAILED....Sparse output "
+           << "different from dense output" << endl;
+      return false;
+    }
+
+  // only the bricks around the non-zero data are created
+  size_t num_bricks = NUM_SPARSE_OUT / BRICK_SIZE;
+  if (sparse.num_bricks() == 0 || sparse.num_bricks()
+      >= num_bricks * num_bricks * num_bricks * num_bricks)
+    {
+      cout << "(" << type_string(output) << ") FAILED....Wrong number of "
+           << "bricks" << endl;
+      return false;
+    }
+
+  // the parallel policy gives the same result for any number of threads
+  for (int num_threads = 1; num_threads <= 3; ++num_threads)
+    {
+      Nessi::set_num_threads(num_threads);
+      Nessi::SparseHistogram4D<NumT> par(NUM_SPARSE_OUT, NUM_SPARSE_OUT,
+                                         NUM_SPARSE_OUT, NUM_SPARSE_OUT,
+                                         BRICK_SIZE);
+      AxisManip::rebin_axis_4D(Nessi::execution::par,
+                               axis_in[0], axis_in[1], axis_in[2],
+                               axis_in[3], input, input_err2,
+                               axis_out[0], axis_out[1], axis_out[2],
+                               axis_out[3], par);
+      par.to_dense(output, output_err2);
+      if (output != true_output || output_err2 != true_output_err2)
+        {
+          cout << "(" << type_string(output) << ", " << num_threads
+               << " threads) FAILED....Parallel output different from "
+               << "sequential" << endl;
+          return false;
+        }
+    }
+  Nessi::set_num_threads(0);
+
+  // a histogram of another shape is rejected
+  Nessi::SparseHistogram4D<NumT> wrong(NUM_SPARSE_OUT, NUM_SPARSE_OUT,
+                                       NUM_SPARSE_OUT, NUM_SPARSE_OUT + 1);
+  try
+    {
+      AxisManip::rebin_axis_4D(Nessi::execution::seq,
+                               axis_in[0], axis_in[1], axis_in[2],
+                               axis_in[3], input, input_err2,
+                               axis_out[0], axis_out[1], axis_out[2],
+                               axis_out[3], wrong);
+      cout << "(" << type_string(output) << ") FAILED....No exception "
+           << "thrown" << endl;
+      return false;
+    }
+  catch (std::invalid_argument &)
+    {
+    }
+
+  return true;
+}
+
+/**
+ * Function that tests the discrepancies between the true outputs and the
+ * outputs generated by the <i>rebin_axis_4D</i> function.
+ *
+ * The function returns TRUE if the two arrays compared \f$output\f$ and
+ * \f$true\_output\f$ match, and returns FALSE if they do not match.
+ *
+ * \param output (INPUT) is the array created by <i>rebin_axis_4D</i>
+ * \param output_err2 (INPUT) is the square of the uncertainty in the array
+ * created by <i>rebin_axis_4D</i>
+ * \param true_output (INPUT) is the true array
+ * \param true_output_err2 (INPUT) is the square of the uncertainty in the true
+ * array
+ */
+template <typename NumT>
+bool test_okay(Nessi::Vector<NumT> & output,
+               Nessi::Vector<NumT> & output_err2,
+               Nessi::Vector<NumT> & true_output,
+               Nessi::Vector<NumT> & true_output_err2)
+{
+  bool value = true;
+
+  if(!test_okay(output,true_output,VV))
+    {
+      value = false;
+    }
+
+  if(!test_okay(output_err2,true_output_err2,VV))
+    {
+      value = false;
+    }
+
+  // everything okay
+  return value;
+}
+
+/**
+ * Function that generates the data using the <i>rebin_axis_4D</i> function
+ * (as described in the documentation of the <i>rebin_axis_4D</i> function)
+ * and launches the comparison of the data.
+ *
+ * \param key (INPUT) is a key that permits to launch the correct test
+ * \param debug (INPUT) is any string that launches the debug mode (print all
+ * the array created and calculated)
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_func(NumT key, string debug) // key forces correct test to happen
+{
+  // allocate arrays
+  Nessi::Vector<NumT>   axis_in[4];
+  Nessi::Vector<NumT>   axis_out[4];
+  Nessi::Vector<NumT>   input;
+  Nessi::Vector<NumT>   input_err2;
+  Nessi::Vector<NumT>   true_output;
+  Nessi::Vector<NumT>   true_output_err2;
+
+  // fill in values as appropriate
+  initialize_inputs(axis_in,axis_out,input,input_err2);
+  initialize_true_outputs(true_output,true_output_err2);
+
+  // allocate output arrays, the values are overwritten
+  Nessi::Vector<NumT>   output;
+  Nessi::Vector<NumT>   output_err2;
+  output.assign(16, static_cast<NumT>(1));
+  output_err2.assign(16, static_cast<NumT>(1));
+
+  // run the code being tested
+  AxisManip::rebin_axis_4D(axis_in[0],axis_in[1],axis_in[2],axis_in[3],
+                           input,input_err2,
+                           axis_out[0],axis_out[1],axis_out[2],axis_out[3],
+                           output,output_err2);
+
+  if(!debug.empty())
+    {
+      cout << endl;
+      cout << output.size() << " " << output_err2.size() << endl;
+      print(output, true_output, VV, debug);
+      print(output_err2, true_output_err2, ERROR+VV, debug);
+    }
+
+  if(!test_okay(output, output_err2, true_output, true_output_err2))
+    {
+      return false;
+    }
+
+  return test_sparse<NumT>(debug);
+}
+
+/**
+ * Main function that test rebin_axis_4D for float and double
+ *
+ * \param argc The number of command-line arguments present
+ * \param argv The list of command-line arguments
+ */
+int main(int argc, char *argv[])
+{
+  cout << "rebin_axis_4D_test.cpp..........";
+
+  string debug;
+  if(argc > 1)
+    {
+      debug = argv[1];
+    }
+
+  int value = 0;
+
+  if(!test_func(static_cast<float>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(!test_func(static_cast<double>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(value == 0)
+    {
+      cout << "Functionality OK" << endl;
+    }
+
+  return value;
+}
+
+/**
+ * \}
+ */  // end of rebin_axis_4D_test group
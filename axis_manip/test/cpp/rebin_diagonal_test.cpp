@@ -30,9 +30,13 @@
 
 #include "rebinning.hpp"
 #include "test_common.hpp"
+#include <cmath>
 
 using namespace std;
 
+/// Number of bins of the long diagonal spectrum
+const size_t NUM_DIAGONAL = 5000;
+
 /**
  * \defgroup rebin_diagonal_test rebin_diagonal_test
  * \{
@@ -41,7 +45,10 @@ using namespace std;
  * function <i>rebin_diagonal</i> and described in 3.53
  * of the <i>SNS 107030214-TD0001-R00, "Data Reduction Library Software
  * Requirements and Specifications"</i> with the true output data
- * \f$true\_output\f$ manually calculated.
+ * \f$true\_output\f$ manually calculated. A long diagonal spectrum must
+ * give the same result when its bins are rebinned one at a time in the
+ * reverse order, and exactly the same result with the parallel execution
+ * policy for any number of threads.
  * Any discrepancy between the outputs (\f$output\f$ and \f$true\_output\f$)
  * will generate in the testsuite.log file an error message that gives details
  * about the location and type of the error.
@@ -192,6 +199,133 @@ bool test_okay(Nessi::Vector<NumT> & output,
   return value;
 }
 
+/**
+ * This function returns true if the arrays agree to the relative
+ * tolerance \p tol.
+ */
+template <typename NumT>
+bool is_close(const Nessi::Vector<NumT> & value,
+              const Nessi::Vector<NumT> & true_value,
+              const NumT tol)
+{
+  if (value.size() != true_value.size())
+    {
+      return false;
+    }
+  for (size_t i = 0; i < value.size(); ++i)
+    {
+      NumT scale = std::max(std::fabs(true_value[i]), static_cast<NumT>(1));
+      if (!(std::fabs(value[i] - true_value[i]) <= tol * scale))
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+/**
+ * Function that rebins a long diagonal spectrum at once, one bin at a time
+ * in the reverse order and with the parallel execution policy, and
+ * compares the results.
+ *
+ * \param tol (INPUT) is the relative tolerance of the comparisons
+ * \param debug (INPUT) is any string that launches the debug mode
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_long(const NumT tol, string debug)
+{
+  Nessi::Vector<NumT> axis_in_1;
+  Nessi::Vector<NumT> axis_in_2;
+  Nessi::Vector<NumT> input;
+  Nessi::Vector<NumT> input_err2;
+  axis_in_1.push_back(static_cast<NumT>(0.));
+  axis_in_2.push_back(static_cast<NumT>(0.));
+  for (size_t k = 0; k < NUM_DIAGONAL; ++k)
+    {
+      axis_in_1.push_back(axis_in_1[k] + static_cast<NumT>(k % 3 + 1));
+      axis_in_2.push_back(axis_in_2[k] + static_cast<NumT>(k % 2 + 1));
+      input.push_back(static_cast<NumT>(k % 11 + 1));
+      input_err2.push_back(static_cast<NumT>(k % 7 + 1));
+    }
+
+  Nessi::Vector<NumT> axis_out_1;
+  Nessi::Vector<NumT> axis_out_2;
+  for (size_t i = 0; i <= 40; ++i)
+    {
+      axis_out_1.push_back(static_cast<NumT>(-10.) +
+                           static_cast<NumT>(i) * static_cast<NumT>(256.5));
+    }
+  for (size_t j = 0; j <= 30; ++j)
+    {
+      axis_out_2.push_back(static_cast<NumT>(-5.) +
+                           static_cast<NumT>(j) * static_cast<NumT>(255.25));
+    }
+
+  size_t size = (axis_out_1.size() - 1) * (axis_out_2.size() - 1);
+  Nessi::Vector<NumT> true_output(size);
+  Nessi::Vector<NumT> true_output_err2(size);
+  AxisManip::rebin_diagonal(axis_in_1, axis_in_2, input, input_err2,
+                            axis_out_1, axis_out_2, true_output,
+                            true_output_err2);
+
+  // rebin one bin at a time in the reverse order, every call searching
+  // the target axes from their start
+  Nessi::Vector<NumT> output(size);
+  Nessi::Vector<NumT> output_err2(size);
+  for (size_t k = NUM_DIAGONAL; k > 0; --k)
+    {
+      Nessi::Vector<NumT> x;
+      Nessi::Vector<NumT> y;
+      Nessi::Vector<NumT> in;
+      Nessi::Vector<NumT> in_err2;
+      x.push_back(axis_in_1[k - 1]);
+      x.push_back(axis_in_1[k]);
+      y.push_back(axis_in_2[k - 1]);
+      y.push_back(axis_in_2[k]);
+      in.push_back(input[k - 1]);
+      in_err2.push_back(input_err2[k - 1]);
+      AxisManip::rebin_diagonal(x, y, in, in_err2, axis_out_1, axis_out_2,
+                                output, output_err2);
+    }
+
+  if (!debug.empty())
+    {
+      print(output, true_output, VV, debug);
+      print(output_err2, true_output_err2, ERROR + VV, debug);
+    }
+
+  if (!is_close(output, true_output, tol)
+      || !is_close(output_err2, true_output_err2, tol))
+    {
+      cout << "(" << type_string(output) << ") FAILED....Single bins "
+           << "different from whole spectrum" << endl;
+      return false;
+    }
+
+  // the parallel policy gives exactly the sequential result
+  for (int num_threads = 1; num_threads <= 3; ++num_threads)
+    {
+      Nessi::set_num_threads(num_threads);
+      output.assign(size, static_cast<NumT>(0));
+      output_err2.assign(size, static_cast<NumT>(0));
+      AxisManip::rebin_diagonal(Nessi::execution::par, axis_in_1,
+                                axis_in_2, input, input_err2, axis_out_1,
+                                axis_out_2, output, output_err2);
+      if (output != true_output || output_err2 != true_output_err2)
+        {
+          cout << "(" << type_string(output) << ", " << num_threads
+               << " threads) FAILED....Parallel output different from "
+               << "sequential" << endl;
+          return false;
+        }
+    }
+  Nessi::set_num_threads(0);
+
+  return true;
+}
+
 /**
  * Function that generates the data using the <i>rebin_diagonal</i> function
  * (as described in the documentation of the <i>rebin_diagonal</i> function)
@@ -238,7 +372,13 @@ bool test_func(NumT key, string debug) // key forces correct test to happen
       print(output_err2, true_output_err2, ERROR+VV, debug);
     }
 
-  return test_okay(output, output_err2, true_output, true_output_err2);
+  if(!test_okay(output, output_err2, true_output, true_output_err2))
+    {
+      return false;
+    }
+
+  return test_long(static_cast<NumT>(sizeof(NumT) == sizeof(float) ?
+                                     1.e-5 : 1.e-12), debug);
 }
 
 /**
@@ -0,0 +1,264 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file axis_manip/test/cpp/rebin_plan_1D_test.cpp
+ */
+
+#include "rebinning.hpp"
+#include "test_common.hpp"
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+/// Number of bins of the initial axis
+const size_t NUM_BINS_IN = 6;
+/// Number of bins of the target axis
+const size_t NUM_BINS_OUT = 5;
+/// Number of spectra in the blocks
+const size_t NUM_SPECTRA = 5;
+
+/**
+ * \defgroup rebin_plan_1D_test rebin_plan_1D_test
+ * \{
+ *
+ * This test applies <i>AxisManip::RebinPlan1D</i> to single spectra and to
+ * blocks and compares the results with <i>rebin_axis_1D</i> and
+ * <i>rebin_axis_1D_frac</i>. The target axis extends past both ends of the
+ * initial axis, so some target bins have no weight.
+ *
+ * <b>Notation used:</b>
+ * - VV = "v,v"
+ * - ERROR = "Error"
+ */
+
+/**
+ * This function creates the axes and one spectrum.
+ *
+ * \param axis_in (OUTPUT) is the initial axis
+ * \param axis_out (OUTPUT) is the target axis
+ * \param input (OUTPUT) is the data
+ * \param input_err2 (OUTPUT) is the square of the uncertainty of the data
+ * \param p (INPUT) is the spectrum to create
+ */
+template <typename NumT>
+void initialize_inputs(Nessi::Vector<NumT> & axis_in,
+                       Nessi::Vector<NumT> & axis_out,
+                       Nessi::Vector<NumT> & input,
+                       Nessi::Vector<NumT> & input_err2,
+                       const size_t p)
+{
+  axis_in.clear();
+  axis_out.clear();
+  input.clear();
+  input_err2.clear();
+  for (size_t i = 0; i <= NUM_BINS_IN; ++i)
+    {
+      axis_in.push_back(static_cast<NumT>(1. + 1.5 * i + 0.25 * i * i));
+    }
+  for (size_t i = 0; i <= NUM_BINS_OUT; ++i)
+    {
+      axis_out.push_back(static_cast<NumT>(-2. + 4. * i));
+    }
+  for (size_t i = 0; i < NUM_BINS_IN; ++i)
+    {
+      input.push_back(static_cast<NumT>(10. + 3. * i + p));
+      input_err2.push_back(static_cast<NumT>(1. + 0.5 * i + 0.1 * p));
+    }
+}
+
+/**
+ * Function that compares two arrays exactly.
+ *
+ * \param output (INPUT) is the array created by the plan
+ * \param true_output (INPUT) is the array created by the function
+ * \param what (INPUT) names the comparison for the error message
+ * \param debug (INPUT) is any string that launches the debug mode
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool same_output(Nessi::Vector<NumT> & output,
+                 Nessi::Vector<NumT> & true_output,
+                 const string & what, string debug)
+{
+  if (!debug.empty())
+    {
+      print(output, true_output, VV, debug);
+    }
+
+  if (output != true_output)
+    {
+      cout << "(" << type_string(output) << " " << what
+           << ") FAILED....Output different from function" << endl;
+      return false;
+    }
+  return true;
+}
+
+/**
+ * Function that runs the plans and the functions.
+ *
+ * \param key (INPUT) key that permits to launch the correct test
+ * \param debug (INPUT) is any string that launches the debug mode (print all
+ * the array created and calculated)
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_func(NumT key, string debug)
+{
+  Nessi::Vector<NumT> axis_in;
+  Nessi::Vector<NumT> axis_out;
+  Nessi::Vector<NumT> input;
+  Nessi::Vector<NumT> input_err2;
+  initialize_inputs(axis_in, axis_out, input, input_err2, 0);
+
+  // rebin_axis_1D, applied twice to check the accumulation
+  AxisManip::RebinPlan1D<NumT> plan(axis_in, axis_out);
+  Nessi::Vector<NumT> output(NUM_BINS_OUT);
+  Nessi::Vector<NumT> output_err2(NUM_BINS_OUT);
+  Nessi::Vector<NumT> true_output(NUM_BINS_OUT);
+  Nessi::Vector<NumT> true_output_err2(NUM_BINS_OUT);
+  for (int i = 0; i < 2; ++i)
+    {
+      plan.apply(input, input_err2, output, output_err2);
+      AxisManip::rebin_axis_1D(axis_in, input, input_err2, axis_out,
+                               true_output, true_output_err2);
+    }
+  if (plan.num_bins_in() != NUM_BINS_IN
+      || plan.num_bins_out() != NUM_BINS_OUT
+      || !same_output(output, true_output, "rebin_axis_1D", debug)
+      || !same_output(output_err2, true_output_err2,
+                      ERROR + "rebin_axis_1D", debug))
+    {
+      return false;
+    }
+
+  // rebin_axis_1D_frac with a bin to ignore
+  input[2] = numeric_limits<NumT>::quiet_NaN();
+  AxisManip::RebinPlan1D<NumT>
+    frac_plan(axis_in, axis_out, AxisManip::RebinPlan1D<NumT>::
+              REBIN_AXIS_1D_FRAC);
+  Nessi::Vector<NumT> frac_area(NUM_BINS_OUT);
+  Nessi::Vector<NumT> true_frac_area(NUM_BINS_OUT);
+  output.assign(NUM_BINS_OUT, 0);
+  output_err2.assign(NUM_BINS_OUT, 0);
+  true_output.assign(NUM_BINS_OUT, 0);
+  true_output_err2.assign(NUM_BINS_OUT, 0);
+  frac_plan.apply(input, input_err2, output, output_err2, frac_area);
+  AxisManip::rebin_axis_1D_frac(axis_in, input, input_err2, axis_out,
+                                true_output, true_output_err2,
+                                true_frac_area);
+  if (!same_output(output, true_output, "rebin_axis_1D_frac", debug)
+      || !same_output(output_err2, true_output_err2,
+                      ERROR + "rebin_axis_1D_frac", debug)
+      || !same_output(frac_area, true_frac_area, "fractional area", debug))
+    {
+      return false;
+    }
+
+  // blocks with the parallel policy
+  Nessi::SpectrumBlock<NumT> block_in(NUM_SPECTRA, NUM_BINS_IN);
+  for (size_t p = 0; p < NUM_SPECTRA; ++p)
+    {
+      initialize_inputs(axis_in, axis_out, input, input_err2, p);
+      block_in.set_spectrum(p, input, input_err2);
+    }
+  Nessi::SpectrumBlock<NumT> block_out(NUM_SPECTRA, NUM_BINS_OUT);
+  plan.apply(Nessi::execution::par, block_in, block_out);
+  for (size_t p = 0; p < NUM_SPECTRA; ++p)
+    {
+      initialize_inputs(axis_in, axis_out, input, input_err2, p);
+      true_output.assign(NUM_BINS_OUT, 0);
+      true_output_err2.assign(NUM_BINS_OUT, 0);
+      AxisManip::rebin_axis_1D(axis_in, input, input_err2, axis_out,
+                               true_output, true_output_err2);
+      block_out.get_spectrum(p, output, output_err2);
+      if (!same_output(output, true_output, "block", debug)
+          || !same_output(output_err2, true_output_err2, ERROR + "block",
+                          debug))
+        {
+          return false;
+        }
+    }
+
+  // arrays not the size of the axes are rejected
+  Nessi::SpectrumBlock<NumT> wrong(NUM_SPECTRA, NUM_BINS_IN);
+  try
+    {
+      plan.apply(block_in, wrong);
+      cout << "(" << type_string(output) << ") FAILED....No exception "
+           << "thrown" << endl;
+      return false;
+    }
+  catch (std::invalid_argument &)
+    {
+    }
+
+  return true;
+}
+
+/**
+ * Main function that tests RebinPlan1D for float and double.
+ *
+ * \param argc The number of command-line arguments present
+ * \param argv The list of command-line arguments
+ */
+int main(int argc, char *argv[])
+{
+  cout << "rebin_plan_1D_test.cpp..........";
+
+  string debug;
+  if (argc >1)
+    {
+      debug = argv[1];
+    }
+
+  int value = 0;
+
+  if(!test_func(static_cast<float>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(!test_func(static_cast<double>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(value == 0)
+    {
+      cout << "Functionality OK" << endl;
+    }
+
+  return value;
+}
+
+/**
+ * \}
+ */   //end of rebin_plan_1D_test group
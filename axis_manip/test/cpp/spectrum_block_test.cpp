@@ -0,0 +1,481 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file axis_manip/test/cpp/spectrum_block_test.cpp
+ */
+
+#include "conversions.hpp"
+#include "rebinning.hpp"
+#include "test_common.hpp"
+#include <stdexcept>
+
+using namespace std;
+
+/// Number of spectra in the blocks
+const size_t NUM_SPECTRA = 4;
+/// Number of bins in every input spectrum
+const size_t NUM_BINS = 6;
+/// Number of bins in every rebinned spectrum
+const size_t NUM_BINS_OUT = 4;
+/// Stride of the padded blocks
+const size_t STRIDE = 8;
+
+/**
+ * \defgroup spectrum_block_test spectrum_block_test
+ * \{
+ *
+ * This test runs the block versions of <i>rebin_axis_1D</i>,
+ * <i>tof_to_wavelength</i>, <i>wavelength_to_energy</i>,
+ * <i>velocity_to_energy</i>, <i>tof_to_scalar_Q</i>,
+ * <i>wavelength_to_scalar_Q</i> and <i>tof_to_initial_wavelength_igs</i>
+ * on contiguous and on padded blocks and
+ * compares every spectrum of the result with the vector version of the
+ * function applied to that spectrum. The parallel execution policies must
+ * give the same blocks as the sequential one, and a conversion in place
+ * must give the same block as into a separate one.
+ *
+ * <b>Notation used:</b>
+ * - VV = "v,v"
+ * - ERROR = "Error"
+ */
+
+/**
+ * This function fills every spectrum of a block with positive values.
+ *
+ * \param block (OUTPUT) is the block to fill
+ */
+template <typename NumT>
+void initialize_block(Nessi::SpectrumBlock<NumT> & block)
+{
+  Nessi::Vector<NumT> value(block.num_bins());
+  Nessi::Vector<NumT> err2(block.num_bins());
+  for (size_t p = 0; p < block.num_spectra(); ++p)
+    {
+      for (size_t i = 0; i < block.num_bins(); ++i)
+        {
+          value[i] = static_cast<NumT>(1000. + 250. * i + 35. * p);
+          err2[i] = static_cast<NumT>(1. + 0.5 * i + 0.25 * p);
+        }
+      block.set_spectrum(p, value, err2);
+    }
+}
+
+/**
+ * Function that compares spectrum \p p of a block with the expected
+ * arrays.
+ *
+ * \param block (INPUT) is the block created by the block version
+ * \param p (INPUT) is the spectrum to compare
+ * \param true_output (INPUT) is the value expected
+ * \param true_output_err2 (INPUT) is the squared uncertainty expected
+ * \param what (INPUT) is the name of the function for the error message
+ * \param debug (INPUT) is any string that launches the debug mode
+ */
+template <typename NumT>
+bool test_okay(const Nessi::SpectrumBlock<NumT> & block, const size_t p,
+               Nessi::Vector<NumT> & true_output,
+               Nessi::Vector<NumT> & true_output_err2,
+               const string & what, string debug)
+{
+  Nessi::Vector<NumT> output(block.num_bins());
+  Nessi::Vector<NumT> output_err2(block.num_bins());
+  block.get_spectrum(p, output, output_err2);
+
+  if (!debug.empty())
+    {
+      print(output, true_output, VV, debug);
+      print(output_err2, true_output_err2, ERROR + VV, debug);
+    }
+
+  if (!Utils::vector_is_equals(output, true_output)
+      || !Utils::vector_is_equals(output_err2, true_output_err2))
+    {
+      cout << "(" << type_string(output) << " " << what << ", spectrum "
+           << p << ") FAILED....Output different from vector expected"
+           << endl;
+      return false;
+    }
+  return true;
+}
+
+/**
+ * Function that compares the blocks with the vector version of every
+ * function for one layout of the blocks.
+ *
+ * \param stride_in (INPUT) is the stride of the input blocks
+ * \param stride_out (INPUT) is the stride of the output blocks
+ * \param debug (INPUT) is any string that launches the debug mode
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_layout(const size_t stride_in, const size_t stride_out,
+                 string debug)
+{
+  Nessi::SpectrumBlock<NumT> input(NUM_SPECTRA, NUM_BINS, stride_in);
+  initialize_block(input);
+
+  Nessi::Vector<NumT> in(NUM_BINS);
+  Nessi::Vector<NumT> in_err2(NUM_BINS);
+  Nessi::Vector<NumT> true_output(NUM_BINS);
+  Nessi::Vector<NumT> true_output_err2(NUM_BINS);
+
+  // tof_to_wavelength with one flight path per pixel
+  Nessi::Vector<NumT> pathlength;
+  Nessi::Vector<NumT> pathlength_err2;
+  for (size_t p = 0; p < NUM_SPECTRA; ++p)
+    {
+      pathlength.push_back(static_cast<NumT>(10. + 0.5 * p));
+      pathlength_err2.push_back(static_cast<NumT>(0.01 * (p + 1)));
+    }
+  Nessi::SpectrumBlock<NumT> wavelength(NUM_SPECTRA, NUM_BINS, stride_out);
+  AxisManip::tof_to_wavelength(input, pathlength, pathlength_err2,
+                               wavelength);
+  for (size_t p = 0; p < NUM_SPECTRA; ++p)
+    {
+      input.get_spectrum(p, in, in_err2);
+      AxisManip::tof_to_wavelength(in, in_err2, pathlength[p],
+                                   pathlength_err2[p], true_output,
+                                   true_output_err2);
+      if (!test_okay(wavelength, p, true_output, true_output_err2,
+                     "tof_to_wavelength", debug))
+        {
+          return false;
+        }
+    }
+
+  // wavelength_to_energy
+  Nessi::SpectrumBlock<NumT> energy(NUM_SPECTRA, NUM_BINS, stride_in);
+  AxisManip::wavelength_to_energy(wavelength, energy);
+  for (size_t p = 0; p < NUM_SPECTRA; ++p)
+    {
+      wavelength.get_spectrum(p, in, in_err2);
+      AxisManip::wavelength_to_energy(in, in_err2, true_output,
+                                      true_output_err2);
+      if (!test_okay(energy, p, true_output, true_output_err2,
+                     "wavelength_to_energy", debug))
+        {
+          return false;
+        }
+    }
+
+  // velocity_to_energy, also in place
+  Nessi::SpectrumBlock<NumT> velocity_e(NUM_SPECTRA, NUM_BINS, stride_out);
+  AxisManip::velocity_to_energy(input, velocity_e);
+  Nessi::SpectrumBlock<NumT> in_place(input);
+  AxisManip::velocity_to_energy(Nessi::execution::par, in_place, in_place);
+  for (size_t p = 0; p < NUM_SPECTRA; ++p)
+    {
+      input.get_spectrum(p, in, in_err2);
+      AxisManip::velocity_to_energy(in, in_err2, true_output,
+                                    true_output_err2);
+      if (!test_okay(velocity_e, p, true_output, true_output_err2,
+                     "velocity_to_energy", debug)
+          || !test_okay(in_place, p, true_output, true_output_err2,
+                        "velocity_to_energy in place", debug))
+        {
+          return false;
+        }
+    }
+
+  // tof_to_scalar_Q with one flight path and polar angle per pixel
+  Nessi::Vector<NumT> polar;
+  Nessi::Vector<NumT> polar_err2;
+  for (size_t p = 0; p < NUM_SPECTRA; ++p)
+    {
+      polar.push_back(static_cast<NumT>(0.3 + 0.7 * p));
+      polar_err2.push_back(static_cast<NumT>(0.001 * (p + 1)));
+    }
+  Nessi::SpectrumBlock<NumT> tof_Q(NUM_SPECTRA, NUM_BINS, stride_out);
+  AxisManip::tof_to_scalar_Q(input, pathlength, pathlength_err2, polar,
+                             polar_err2, tof_Q);
+  for (size_t p = 0; p < NUM_SPECTRA; ++p)
+    {
+      input.get_spectrum(p, in, in_err2);
+      AxisManip::tof_to_scalar_Q(in, in_err2, pathlength[p],
+                                 pathlength_err2[p], polar[p], polar_err2[p],
+                                 true_output, true_output_err2);
+      if (!test_okay(tof_Q, p, true_output, true_output_err2,
+                     "tof_to_scalar_Q", debug))
+        {
+          return false;
+        }
+    }
+
+  // wavelength_to_scalar_Q with one polar angle per pixel
+  Nessi::SpectrumBlock<NumT> wavelength_Q(NUM_SPECTRA, NUM_BINS,
+                                          stride_in);
+  AxisManip::wavelength_to_scalar_Q(wavelength, polar, polar_err2,
+                                    wavelength_Q);
+  for (size_t p = 0; p < NUM_SPECTRA; ++p)
+    {
+      wavelength.get_spectrum(p, in, in_err2);
+      AxisManip::wavelength_to_scalar_Q(in, in_err2, polar[p],
+                                        polar_err2[p], true_output,
+                                        true_output_err2);
+      if (!test_okay(wavelength_Q, p, true_output, true_output_err2,
+                     "wavelength_to_scalar_Q", debug))
+        {
+          return false;
+        }
+    }
+
+  // tof_to_initial_wavelength_igs with one detector distance per pixel
+  Nessi::SpectrumBlock<NumT> initial_wl(NUM_SPECTRA, NUM_BINS, stride_out);
+  NumT final_wl = static_cast<NumT>(6.27);
+  NumT final_wl_err2 = static_cast<NumT>(0.01);
+  NumT offset = static_cast<NumT>(4.);
+  NumT offset_err2 = static_cast<NumT>(0.2);
+  NumT source_sample = static_cast<NumT>(80.);
+  NumT source_sample_err2 = static_cast<NumT>(0.3);
+  AxisManip::tof_to_initial_wavelength_igs(input, final_wl, final_wl_err2,
+                                           offset, offset_err2,
+                                           source_sample, source_sample_err2,
+                                           pathlength, pathlength_err2,
+                                           initial_wl);
+  for (size_t p = 0; p < NUM_SPECTRA; ++p)
+    {
+      input.get_spectrum(p, in, in_err2);
+      AxisManip::tof_to_initial_wavelength_igs(in, in_err2, final_wl,
+                                               final_wl_err2, offset,
+                                               offset_err2, source_sample,
+                                               source_sample_err2,
+                                               pathlength[p],
+                                               pathlength_err2[p],
+                                               true_output,
+                                               true_output_err2);
+      if (!test_okay(initial_wl, p, true_output, true_output_err2,
+                     "tof_to_initial_wavelength_igs", debug))
+        {
+          return false;
+        }
+    }
+
+  // rebin_axis_1D with axes shared by all pixels
+  Nessi::Vector<NumT> axis_in;
+  for (size_t i = 0; i <= NUM_BINS; ++i)
+    {
+      axis_in.push_back(static_cast<NumT>(2 * i));
+    }
+  Nessi::Vector<NumT> axis_out;
+  for (size_t i = 0; i <= NUM_BINS_OUT; ++i)
+    {
+      axis_out.push_back(static_cast<NumT>(1 + 2.5 * i));
+    }
+  Nessi::SpectrumBlock<NumT> rebinned(NUM_SPECTRA, NUM_BINS_OUT,
+                                      stride_out);
+  AxisManip::rebin_axis_1D(axis_in, input, axis_out, rebinned);
+  for (size_t p = 0; p < NUM_SPECTRA; ++p)
+    {
+      Nessi::Vector<NumT> rebin_output(NUM_BINS_OUT);
+      Nessi::Vector<NumT> rebin_output_err2(NUM_BINS_OUT);
+      input.get_spectrum(p, in, in_err2);
+      AxisManip::rebin_axis_1D(axis_in, in, in_err2, axis_out,
+                               rebin_output, rebin_output_err2);
+      if (!test_okay(rebinned, p, rebin_output, rebin_output_err2,
+                     "rebin_axis_1D", debug))
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+
+/**
+ * Function that checks that the parallel execution policy gives the same
+ * blocks as the sequential one for any number of threads.
+ *
+ * \param stride (INPUT) is the stride of the output blocks
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_parallel(const size_t stride)
+{
+  Nessi::SpectrumBlock<NumT> input(NUM_SPECTRA, NUM_BINS);
+  initialize_block(input);
+
+  Nessi::Vector<NumT> pathlength;
+  Nessi::Vector<NumT> pathlength_err2;
+  Nessi::Vector<NumT> polar;
+  Nessi::Vector<NumT> polar_err2;
+  for (size_t p = 0; p < NUM_SPECTRA; ++p)
+    {
+      pathlength.push_back(static_cast<NumT>(10. + 0.5 * p));
+      pathlength_err2.push_back(static_cast<NumT>(0.01 * (p + 1)));
+      polar.push_back(static_cast<NumT>(0.3 + 0.7 * p));
+      polar_err2.push_back(static_cast<NumT>(0.001 * (p + 1)));
+    }
+  Nessi::Vector<NumT> axis_in;
+  for (size_t i = 0; i <= NUM_BINS; ++i)
+    {
+      axis_in.push_back(static_cast<NumT>(2 * i));
+    }
+  Nessi::Vector<NumT> axis_out;
+  for (size_t i = 0; i <= NUM_BINS_OUT; ++i)
+    {
+      axis_out.push_back(static_cast<NumT>(1 + 2.5 * i));
+    }
+
+  Nessi::SpectrumBlock<NumT> seq_wl(NUM_SPECTRA, NUM_BINS, stride);
+  Nessi::SpectrumBlock<NumT> seq_e(NUM_SPECTRA, NUM_BINS, stride);
+  Nessi::SpectrumBlock<NumT> seq_rebin(NUM_SPECTRA, NUM_BINS_OUT, stride);
+  Nessi::SpectrumBlock<NumT> seq_Q(NUM_SPECTRA, NUM_BINS, stride);
+  AxisManip::tof_to_wavelength(Nessi::execution::seq, input, pathlength,
+                               pathlength_err2, seq_wl);
+  AxisManip::tof_to_scalar_Q(Nessi::execution::seq, input, pathlength,
+                             pathlength_err2, polar, polar_err2, seq_Q);
+  AxisManip::wavelength_to_energy(Nessi::execution::seq, input, seq_e);
+  AxisManip::rebin_axis_1D(Nessi::execution::seq, axis_in, input, axis_out,
+                           seq_rebin);
+
+  bool okay = true;
+  for (int num_threads = 1; num_threads <= 3 && okay; ++num_threads)
+    {
+      Nessi::set_num_threads(num_threads);
+      Nessi::SpectrumBlock<NumT> wl(NUM_SPECTRA, NUM_BINS, stride);
+      Nessi::SpectrumBlock<NumT> e(NUM_SPECTRA, NUM_BINS, stride);
+      Nessi::SpectrumBlock<NumT> rebin(NUM_SPECTRA, NUM_BINS_OUT, stride);
+      Nessi::SpectrumBlock<NumT> Q(NUM_SPECTRA, NUM_BINS, stride);
+      AxisManip::tof_to_wavelength(Nessi::execution::par, input,
+                                   pathlength, pathlength_err2, wl);
+      AxisManip::tof_to_scalar_Q(Nessi::execution::par, input, pathlength,
+                                 pathlength_err2, polar, polar_err2, Q);
+      AxisManip::wavelength_to_energy(Nessi::execution::par_unseq, input,
+                                      e);
+      AxisManip::rebin_axis_1D(Nessi::execution::par, axis_in, input,
+                               axis_out, rebin);
+      if (wl.value() != seq_wl.value() || wl.err2() != seq_wl.err2()
+          || e.value() != seq_e.value() || e.err2() != seq_e.err2()
+          || rebin.value() != seq_rebin.value()
+          || rebin.err2() != seq_rebin.err2()
+          || Q.value() != seq_Q.value() || Q.err2() != seq_Q.err2())
+        {
+          cout << "(" << type_string(pathlength) << ", " << num_threads
+               << " threads) FAILED....Parallel output different from "
+               << "sequential" << endl;
+          okay = false;
+        }
+    }
+  Nessi::set_num_threads(0);
+
+  return okay;
+}
+
+/**
+ * Function that runs the tests for contiguous and padded blocks and checks
+ * that inconsistent blocks are rejected.
+ *
+ * \param key (INPUT) key that permits to launch the correct test
+ * \param debug (INPUT) is any string that launches the debug mode (print all
+ * the array created and calculated)
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_func(NumT key, string debug)
+{
+  if (!test_layout<NumT>(NUM_BINS, NUM_BINS, debug)
+      || !test_layout<NumT>(STRIDE, NUM_BINS, debug)
+      || !test_layout<NumT>(NUM_BINS, STRIDE, debug)
+      || !test_parallel<NumT>(NUM_BINS) || !test_parallel<NumT>(STRIDE))
+    {
+      return false;
+    }
+
+  Nessi::SpectrumBlock<NumT> tof(NUM_SPECTRA, NUM_BINS);
+  Nessi::SpectrumBlock<NumT> wavelength(NUM_SPECTRA, NUM_BINS);
+  Nessi::Vector<NumT> pathlength(NUM_SPECTRA - 1);
+  try
+    {
+      AxisManip::tof_to_wavelength(tof, pathlength, pathlength, wavelength);
+      cout << "(" << type_string(pathlength) << ") FAILED....No exception "
+           << "thrown" << endl;
+      return false;
+    }
+  catch (std::invalid_argument &)
+    {
+    }
+
+  Nessi::Vector<NumT> geometry(NUM_SPECTRA);
+  Nessi::Vector<NumT> polar(NUM_SPECTRA + 1);
+  try
+    {
+      AxisManip::tof_to_scalar_Q(tof, geometry, geometry, polar, polar,
+                                 wavelength);
+      cout << "(" << type_string(pathlength) << ") FAILED....No exception "
+           << "thrown for the geometry" << endl;
+      return false;
+    }
+  catch (std::invalid_argument &)
+    {
+    }
+
+  return true;
+}
+
+/**
+ * Main function that tests the block versions of the axis functions for
+ * float and double.
+ *
+ * \param argc The number of command-line arguments present
+ * \param argv The list of command-line arguments
+ */
+int main(int argc, char *argv[])
+{
+  cout << "spectrum_block_test.cpp..........";
+
+  string debug;
+  if (argc >1)
+    {
+      debug = argv[1];
+    }
+
+  int value = 0;
+
+  if(!test_func(static_cast<float>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(!test_func(static_cast<double>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(value == 0)
+    {
+      cout << "Functionality OK" << endl;
+    }
+
+  return value;
+}
+
+/**
+ * \}
+ */   //end of spectrum_block_test group
@@ -0,0 +1,427 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file axis_manip/test/cpp/tof_to_energy_transfer_dgs_test.cpp
+ */
+
+#include "conversions.hpp"
+#include "test_common.hpp"
+#include <stdexcept>
+
+using namespace std;
+
+/// Number of pixels of the blocks
+const size_t NUM_SPECTRA = 5;
+/// Number of bins in every spectrum
+const size_t NUM_BINS = 6;
+/// Stride of the padded blocks
+const size_t STRIDE = 8;
+/// Initial velocity of the neutrons
+const double INITIAL_VELOCITY = 0.05;
+/// Square of the uncertainty in the initial velocity
+const double INITIAL_VELOCITY_ERR2 = 0.0001;
+/// Time offset of the neutrons
+const double TIME_OFFSET = 5.;
+/// Square of the uncertainty in the time offset
+const double TIME_OFFSET_ERR2 = 0.5;
+/// Distance from source to sample
+const double DIST_SOURCE_SAMPLE = 10.;
+/// Square of the uncertainty in the distance from source to sample
+const double DIST_SOURCE_SAMPLE_ERR2 = 0.02;
+/// Incident energy
+const double INITIAL_ENERGY = 50.;
+/// Square of the uncertainty in the incident energy
+const double INITIAL_ENERGY_ERR2 = 0.3;
+
+/**
+ * \defgroup tof_to_energy_transfer_dgs_test tof_to_energy_transfer_dgs_test
+ * \{
+ *
+ * This test compares every version of <i>tof_to_energy_transfer_dgs</i>
+ * with <i>tof_to_final_velocity_dgs</i> followed by
+ * <i>velocity_to_energy</i> and <i>energy_transfer</i>, both applied to
+ * one spectrum at a time and to the whole blocks.
+ * The numbers must be the same, not only close. The parallel execution
+ * policy must give the same blocks as the sequential one for any number
+ * of threads.
+ *
+ * <b>Notations used:</b>
+ * - VV = "v,v"
+ * - SS = "s,s"
+ * - ERROR = "Error"
+ */
+
+/**
+ * This class holds the geometry of the pixels of the tests.
+ */
+template <typename NumT>
+struct Geometry
+{
+  /// Distance from sample to every pixel
+  Nessi::Vector<NumT> dsd;
+  /// Square of the uncertainty in the distances from sample to pixel
+  Nessi::Vector<NumT> dsd_err2;
+
+  /// Constructor filling the arrays for \p num_pixels pixels
+  explicit Geometry(const size_t num_pixels)
+  {
+    for (size_t p = 0; p < num_pixels; ++p)
+      {
+        dsd.push_back(static_cast<NumT>(4. + 0.5 * p));
+        dsd_err2.push_back(static_cast<NumT>(0.01 * (p + 1)));
+      }
+  }
+};
+
+/**
+ * This function fills every spectrum of a block with positive values.
+ *
+ * \param block (OUTPUT) is the block to fill
+ */
+template <typename NumT>
+void initialize_block(Nessi::SpectrumBlock<NumT> & block)
+{
+  Nessi::Vector<NumT> value(block.num_bins());
+  Nessi::Vector<NumT> err2(block.num_bins());
+  for (size_t p = 0; p < block.num_spectra(); ++p)
+    {
+      for (size_t i = 0; i < block.num_bins(); ++i)
+        {
+          value[i] = static_cast<NumT>(1000. + 250. * i + 35. * p);
+          err2[i] = static_cast<NumT>(1. + 0.5 * i + 0.25 * p);
+        }
+      block.set_spectrum(p, value, err2);
+    }
+}
+
+/**
+ * Function that compares the arrays of a version with the expected
+ * arrays.
+ *
+ * \param output (INPUT) is the value calculated
+ * \param output_err2 (INPUT) is the squared uncertainty calculated
+ * \param true_output (INPUT) is the value expected
+ * \param true_output_err2 (INPUT) is the squared uncertainty expected
+ * \param what (INPUT) is the version for the error message
+ * \param p (INPUT) is the pixel for the error message
+ * \param debug (INPUT) is any string that launches the debug mode
+ */
+template <typename NumT>
+bool test_same(Nessi::Vector<NumT> & output,
+               Nessi::Vector<NumT> & output_err2,
+               Nessi::Vector<NumT> & true_output,
+               Nessi::Vector<NumT> & true_output_err2,
+               const string & what, const size_t p, string debug)
+{
+  if (!debug.empty())
+    {
+      print(output, true_output, what, debug);
+      print(output_err2, true_output_err2, ERROR + what, debug);
+    }
+
+  if (!Utils::vector_is_equals(output, true_output)
+      || !Utils::vector_is_equals(output_err2, true_output_err2))
+    {
+      cout << "(" << type_string(output) << " " << what << ", pixel " << p
+           << ") FAILED....Output different from the step-by-step "
+           << "conversion" << endl;
+      return false;
+    }
+  return true;
+}
+
+/**
+ * This function runs the block version with an execution policy.
+ *
+ * \param policy (INPUT) is the execution policy
+ * \param tof (INPUT) is the block of time-of-flight axes
+ * \param geometry (INPUT) is the geometry of the pixels
+ * \param energy_transfer (OUTPUT) is the block of energy transfer axes
+ */
+template <typename NumT>
+void run_block(const Nessi::ExecutionPolicy & policy,
+               const Nessi::SpectrumBlock<NumT> & tof,
+               const Geometry<NumT> & geometry,
+               Nessi::SpectrumBlock<NumT> & energy_transfer)
+{
+  AxisManip::tof_to_energy_transfer_dgs(policy, tof,
+                              static_cast<NumT>(INITIAL_VELOCITY),
+                              static_cast<NumT>(INITIAL_VELOCITY_ERR2),
+                              static_cast<NumT>(TIME_OFFSET),
+                              static_cast<NumT>(TIME_OFFSET_ERR2),
+                              static_cast<NumT>(DIST_SOURCE_SAMPLE),
+                              static_cast<NumT>(DIST_SOURCE_SAMPLE_ERR2),
+                              geometry.dsd, geometry.dsd_err2,
+                              static_cast<NumT>(INITIAL_ENERGY),
+                              static_cast<NumT>(INITIAL_ENERGY_ERR2),
+                              energy_transfer);
+}
+
+/**
+ * Function that compares every version with the step-by-step conversion
+ * for one layout of the blocks.
+ *
+ * \param stride (INPUT) is the stride of the blocks
+ * \param debug (INPUT) is any string that launches the debug mode
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_layout(const size_t stride, string debug)
+{
+  const NumT iv = static_cast<NumT>(INITIAL_VELOCITY);
+  const NumT iv_err2 = static_cast<NumT>(INITIAL_VELOCITY_ERR2);
+  const NumT to = static_cast<NumT>(TIME_OFFSET);
+  const NumT to_err2 = static_cast<NumT>(TIME_OFFSET_ERR2);
+  const NumT dss = static_cast<NumT>(DIST_SOURCE_SAMPLE);
+  const NumT dss_err2 = static_cast<NumT>(DIST_SOURCE_SAMPLE_ERR2);
+  const NumT ei = static_cast<NumT>(INITIAL_ENERGY);
+  const NumT ei_err2 = static_cast<NumT>(INITIAL_ENERGY_ERR2);
+
+  Geometry<NumT> geometry(NUM_SPECTRA);
+  Nessi::SpectrumBlock<NumT> tof(NUM_SPECTRA, NUM_BINS, stride);
+  initialize_block(tof);
+  Nessi::SpectrumBlock<NumT> energy_transfer(NUM_SPECTRA, NUM_BINS, stride);
+  AxisManip::tof_to_energy_transfer_dgs(tof, iv, iv_err2, to, to_err2, dss,
+                                        dss_err2, geometry.dsd,
+                                        geometry.dsd_err2, ei, ei_err2,
+                                        energy_transfer);
+
+  Nessi::SpectrumBlock<NumT> velocity_block(NUM_SPECTRA, NUM_BINS, stride);
+  Nessi::SpectrumBlock<NumT> energy_block(NUM_SPECTRA, NUM_BINS, stride);
+  Nessi::SpectrumBlock<NumT> steps(NUM_SPECTRA, NUM_BINS, stride);
+  AxisManip::tof_to_final_velocity_dgs(tof, iv, iv_err2, to, to_err2, dss,
+                                       dss_err2, geometry.dsd,
+                                       geometry.dsd_err2, velocity_block);
+  AxisManip::velocity_to_energy(Nessi::execution::par, velocity_block,
+                                energy_block);
+  AxisManip::energy_transfer(Nessi::execution::par, ei, ei_err2,
+                             energy_block, steps);
+
+  Nessi::Vector<NumT> in(NUM_BINS);
+  Nessi::Vector<NumT> in_err2(NUM_BINS);
+  Nessi::Vector<NumT> velocity(NUM_BINS);
+  Nessi::Vector<NumT> velocity_err2(NUM_BINS);
+  Nessi::Vector<NumT> energy(NUM_BINS);
+  Nessi::Vector<NumT> energy_err2(NUM_BINS);
+  Nessi::Vector<NumT> true_output(NUM_BINS);
+  Nessi::Vector<NumT> true_output_err2(NUM_BINS);
+  Nessi::Vector<NumT> output(NUM_BINS);
+  Nessi::Vector<NumT> output_err2(NUM_BINS);
+
+  for (size_t p = 0; p < NUM_SPECTRA; ++p)
+    {
+      tof.get_spectrum(p, in, in_err2);
+      AxisManip::tof_to_final_velocity_dgs(in, in_err2, iv, iv_err2, to,
+                                           to_err2, dss, dss_err2,
+                                           geometry.dsd[p],
+                                           geometry.dsd_err2[p], velocity,
+                                           velocity_err2);
+      AxisManip::velocity_to_energy(velocity, velocity_err2, energy,
+                                    energy_err2);
+      AxisManip::energy_transfer(ei, ei_err2, energy, energy_err2,
+                                 true_output, true_output_err2);
+
+      AxisManip::tof_to_energy_transfer_dgs(in, in_err2, iv, iv_err2, to,
+                                            to_err2, dss, dss_err2,
+                                            geometry.dsd[p],
+                                            geometry.dsd_err2[p], ei,
+                                            ei_err2, output, output_err2);
+      if (!test_same(output, output_err2, true_output, true_output_err2, VV,
+                     p, debug))
+        {
+          return false;
+        }
+
+      for (size_t i = 0; i < NUM_BINS; ++i)
+        {
+          AxisManip::tof_to_energy_transfer_dgs(in[i], in_err2[i], iv,
+                                                iv_err2, to, to_err2, dss,
+                                                dss_err2, geometry.dsd[p],
+                                                geometry.dsd_err2[p], ei,
+                                                ei_err2, output[i],
+                                                output_err2[i]);
+        }
+      if (!test_same(output, output_err2, true_output, true_output_err2, SS,
+                     p, debug))
+        {
+          return false;
+        }
+
+      energy_transfer.get_spectrum(p, output, output_err2);
+      if (!test_same(output, output_err2, true_output, true_output_err2,
+                     string("block"), p, debug))
+        {
+          return false;
+        }
+
+      steps.get_spectrum(p, output, output_err2);
+      if (!test_same(output, output_err2, true_output, true_output_err2,
+                     string("steps"), p, debug))
+        {
+          return false;
+        }
+    }
+
+  // the parallel policy gives the same result for any number of threads
+  for (int num_threads = 1; num_threads <= 3; ++num_threads)
+    {
+      Nessi::set_num_threads(num_threads);
+      Nessi::SpectrumBlock<NumT> par_out(NUM_SPECTRA, NUM_BINS, stride);
+      run_block(Nessi::execution::par, tof, geometry, par_out);
+      if (par_out.value() != energy_transfer.value()
+          || par_out.err2() != energy_transfer.err2())
+        {
+          cout << "(" << type_string(in) << ", " << num_threads
+               << " threads) FAILED....Parallel output different from "
+               << "sequential" << endl;
+          return false;
+        }
+    }
+  Nessi::set_num_threads(0);
+
+  return true;
+}
+
+/**
+ * Function that runs the tests for contiguous and padded blocks and checks
+ * that arrays of the wrong size are rejected.
+ *
+ * \param key (INPUT) key that permits to launch the correct test
+ * \param debug (INPUT) is any string that launches the debug mode (print all
+ * the array created and calculated)
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_func(NumT key, string debug)
+{
+  if (!test_layout<NumT>(NUM_BINS, debug) || !test_layout<NumT>(STRIDE, debug))
+    {
+      return false;
+    }
+
+  Nessi::Vector<NumT> tof(NUM_BINS);
+  Nessi::Vector<NumT> energy_transfer(NUM_BINS + 1);
+  try
+    {
+      AxisManip::tof_to_energy_transfer_dgs(tof, tof, key, key, key, key,
+                                            key, key, key, key, key, key,
+                                            energy_transfer,
+                                            energy_transfer);
+      cout << "(" << type_string(tof) << ") FAILED....No exception thrown "
+           << "for the arrays" << endl;
+      return false;
+    }
+  catch (std::invalid_argument &)
+    {
+    }
+
+  Geometry<NumT> geometry(NUM_SPECTRA);
+  Nessi::SpectrumBlock<NumT> tof_block(NUM_SPECTRA, NUM_BINS);
+  Nessi::SpectrumBlock<NumT> wrong(NUM_SPECTRA + 1, NUM_BINS);
+  try
+    {
+      run_block(Nessi::execution::seq, tof_block, geometry, wrong);
+      cout << "(" << type_string(tof) << ") FAILED....No exception thrown "
+           << "for the blocks" << endl;
+      return false;
+    }
+  catch (std::invalid_argument &)
+    {
+    }
+
+  Nessi::SpectrumBlock<NumT> energy_transfer_block(NUM_SPECTRA, NUM_BINS);
+  geometry.dsd_err2.push_back(0);
+  try
+    {
+      run_block(Nessi::execution::seq, tof_block, geometry,
+                energy_transfer_block);
+      cout << "(" << type_string(tof) << ") FAILED....No exception thrown "
+           << "for the geometry" << endl;
+      return false;
+    }
+  catch (std::invalid_argument &)
+    {
+    }
+
+  try
+    {
+      AxisManip::tof_to_final_velocity_dgs(tof_block, key, key, key, key,
+                                           key, key, geometry.dsd,
+                                           geometry.dsd_err2,
+                                           energy_transfer_block);
+      cout << "(" << type_string(tof) << ") FAILED....No exception thrown "
+           << "for the geometry of the final velocity" << endl;
+      return false;
+    }
+  catch (std::invalid_argument &)
+    {
+    }
+
+  return true;
+}
+
+/**
+ * Main function that tests tof_to_energy_transfer_dgs for float and double.
+ *
+ * \param argc The number of command-line arguments present
+ * \param argv The list of command-line arguments
+ */
+int main(int argc, char *argv[])
+{
+  cout << "tof_to_energy_transfer_dgs_test.cpp..........";
+
+  string debug;
+  if (argc >1)
+    {
+      debug = argv[1];
+    }
+
+  int value = 0;
+
+  if(!test_func(static_cast<float>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(!test_func(static_cast<double>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(value == 0)
+    {
+      cout << "Functionality OK" << endl;
+    }
+
+  return value;
+}
+
+/**
+ * \}
+ */   //end of tof_to_energy_transfer_dgs_test group
@@ -0,0 +1,484 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file axis_manip/test/cpp/vector_view_test.cpp
+ */
+
+
+#include "conversions.hpp"
+#include "rebinning.hpp"
+#include "reverse_array.hpp"
+#include "test_common.hpp"
+#include "utils.hpp"
+#include <stdexcept>
+
+using namespace std;
+
+/// Number of rows of the 2D arrays
+const size_t NUM_ROWS = 7;
+/// Number of columns of the 2D arrays
+const size_t NUM_COLS = 5;
+/// Number of rows of the rebinned 2D arrays
+const size_t NUM_ROWS_OUT = 4;
+
+/**
+ * \defgroup vector_view_test vector_view_test
+ * \{
+ *
+ * This test runs the view versions of <i>tof_to_wavelength</i>,
+ * <i>wavelength_to_energy</i>, <i>energy_to_wavelength</i>,
+ * <i>tof_to_d_spacing</i>, <i>init_scatt_wavevector_to_Q</i>,
+ * <i>reverse_array_cp</i>, <i>rebin_axis_1D</i>,
+ * <i>integrate_1D_hist</i> and <i>fit_linear_background</i> on the
+ * columns of 2D arrays stored row by row. Every result is compared with
+ * the vector version of the function applied to a copy of the column. The
+ * other columns of the output must not be touched.
+ *
+ * <b>Notation used:</b>
+ * - VV = "v,v"
+ * - ERROR = "Error"
+ */
+
+/**
+ * This function copies column \p c of a 2D array stored row by row.
+ *
+ * \param array (INPUT) is the 2D array
+ * \param num_cols (INPUT) is the number of columns of the 2D array
+ * \param c (INPUT) is the column to copy
+ * \param column (OUTPUT) is the copy of the column
+ */
+template <typename NumT>
+void copy_column(const Nessi::Vector<NumT> & array, const size_t num_cols,
+                 const size_t c, Nessi::Vector<NumT> & column)
+{
+  for (size_t i = 0; i < column.size(); ++i)
+    {
+      column[i] = array[i * num_cols + c];
+    }
+}
+
+/**
+ * Function that compares column \p c of a 2D array with the expected
+ * array and checks that the other columns are still zero.
+ *
+ * \param array (INPUT) is the 2D array created with the view version
+ * \param num_cols (INPUT) is the number of columns of the 2D array
+ * \param c (INPUT) is the column written by the view version
+ * \param true_output (INPUT) is the column expected
+ * \param what (INPUT) is the name of the function for the error message
+ * \param debug (INPUT) is any string that launches the debug mode
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_column(const Nessi::Vector<NumT> & array, const size_t num_cols,
+                 const size_t c, Nessi::Vector<NumT> & true_output,
+                 const string & what, string debug)
+{
+  Nessi::Vector<NumT> output(true_output.size());
+  copy_column(array, num_cols, c, output);
+
+  if (!debug.empty())
+    {
+      print(output, true_output, VV, debug);
+    }
+
+  if (!Utils::vector_is_equals(output, true_output))
+    {
+      cout << "(" << type_string(output) << " " << what << ", column " << c
+           << ") FAILED....Output different from vector expected" << endl;
+      return false;
+    }
+
+  for (size_t i = 0; i < array.size(); ++i)
+    {
+      if (i % num_cols != c && array[i] != static_cast<NumT>(0))
+        {
+          cout << "(" << type_string(output) << " " << what << ", column "
+               << c << ") FAILED....Other column overwritten" << endl;
+          return false;
+        }
+    }
+  return true;
+}
+
+/**
+ * Function that compares the view versions with the vector versions on
+ * one column.
+ *
+ * \param c (INPUT) is the column to process
+ * \param debug (INPUT) is any string that launches the debug mode
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_column_funcs(const size_t c, string debug)
+{
+  // the input 2D arrays
+  Nessi::Vector<NumT> tof(NUM_ROWS * NUM_COLS);
+  Nessi::Vector<NumT> tof_err2(NUM_ROWS * NUM_COLS);
+  for (size_t i = 0; i < NUM_ROWS; ++i)
+    {
+      for (size_t j = 0; j < NUM_COLS; ++j)
+        {
+          tof[i * NUM_COLS + j] = static_cast<NumT>(1000. + 150. * i
+                                                    + 40. * j);
+          tof_err2[i * NUM_COLS + j] = static_cast<NumT>(2. + 0.5 * i
+                                                         + 0.1 * j);
+        }
+    }
+  Nessi::VectorView<const NumT> tof_col(tof, c, NUM_ROWS, NUM_COLS);
+  Nessi::VectorView<const NumT> tof_col_err2(tof_err2, c, NUM_ROWS,
+                                             NUM_COLS);
+
+  // the copies of the column
+  Nessi::Vector<NumT> in(NUM_ROWS);
+  Nessi::Vector<NumT> in_err2(NUM_ROWS);
+  copy_column(tof, NUM_COLS, c, in);
+  copy_column(tof_err2, NUM_COLS, c, in_err2);
+  Nessi::Vector<NumT> true_output(NUM_ROWS);
+  Nessi::Vector<NumT> true_output_err2(NUM_ROWS);
+
+  // tof_to_wavelength
+  NumT pathlength = static_cast<NumT>(12.5);
+  NumT pathlength_err2 = static_cast<NumT>(0.02);
+  Nessi::Vector<NumT> wl(NUM_ROWS * NUM_COLS);
+  Nessi::Vector<NumT> wl_err2(NUM_ROWS * NUM_COLS);
+  Nessi::VectorView<NumT> wl_col(wl, c, NUM_ROWS, NUM_COLS);
+  Nessi::VectorView<NumT> wl_col_err2(wl_err2, c, NUM_ROWS, NUM_COLS);
+  AxisManip::tof_to_wavelength(tof_col, tof_col_err2, pathlength,
+                               pathlength_err2, wl_col, wl_col_err2);
+  AxisManip::tof_to_wavelength(in, in_err2, pathlength, pathlength_err2,
+                               true_output, true_output_err2);
+  if (!test_column(wl, NUM_COLS, c, true_output, "tof_to_wavelength", debug)
+      || !test_column(wl_err2, NUM_COLS, c, true_output_err2,
+                      "tof_to_wavelength err2", debug))
+    {
+      return false;
+    }
+
+  // wavelength_to_energy
+  Nessi::Vector<NumT> wl_in(true_output);
+  Nessi::Vector<NumT> wl_in_err2(true_output_err2);
+  Nessi::Vector<NumT> energy(NUM_ROWS * NUM_COLS);
+  Nessi::Vector<NumT> energy_err2(NUM_ROWS * NUM_COLS);
+  AxisManip::wavelength_to_energy(
+                  Nessi::VectorView<const NumT>(wl_col),
+                  Nessi::VectorView<const NumT>(wl_col_err2),
+                  Nessi::VectorView<NumT>(energy, c, NUM_ROWS, NUM_COLS),
+                  Nessi::VectorView<NumT>(energy_err2, c, NUM_ROWS,
+                                          NUM_COLS));
+  AxisManip::wavelength_to_energy(wl_in, wl_in_err2, true_output,
+                                  true_output_err2);
+  if (!test_column(energy, NUM_COLS, c, true_output, "wavelength_to_energy",
+                   debug)
+      || !test_column(energy_err2, NUM_COLS, c, true_output_err2,
+                      "wavelength_to_energy err2", debug))
+    {
+      return false;
+    }
+
+  // energy_to_wavelength back from the energy column
+  Nessi::Vector<NumT> e_in(true_output);
+  Nessi::Vector<NumT> e_in_err2(true_output_err2);
+  Nessi::Vector<NumT> wl_back(NUM_ROWS * NUM_COLS);
+  Nessi::Vector<NumT> wl_back_err2(NUM_ROWS * NUM_COLS);
+  AxisManip::energy_to_wavelength(
+                  Nessi::VectorView<const NumT>(energy, c, NUM_ROWS,
+                                                NUM_COLS),
+                  Nessi::VectorView<const NumT>(energy_err2, c, NUM_ROWS,
+                                                NUM_COLS),
+                  Nessi::VectorView<NumT>(wl_back, c, NUM_ROWS, NUM_COLS),
+                  Nessi::VectorView<NumT>(wl_back_err2, c, NUM_ROWS,
+                                          NUM_COLS));
+  AxisManip::energy_to_wavelength(e_in, e_in_err2, true_output,
+                                  true_output_err2);
+  if (!test_column(wl_back, NUM_COLS, c, true_output,
+                   "energy_to_wavelength", debug)
+      || !test_column(wl_back_err2, NUM_COLS, c, true_output_err2,
+                      "energy_to_wavelength err2", debug))
+    {
+      return false;
+    }
+
+  // tof_to_d_spacing
+  NumT polar = static_cast<NumT>(0.75);
+  NumT polar_err2 = static_cast<NumT>(0.001);
+  Nessi::Vector<NumT> d_spacing(NUM_ROWS * NUM_COLS);
+  Nessi::Vector<NumT> d_spacing_err2(NUM_ROWS * NUM_COLS);
+  AxisManip::tof_to_d_spacing(tof_col, tof_col_err2, pathlength,
+                              pathlength_err2, polar, polar_err2,
+                              Nessi::VectorView<NumT>(d_spacing, c,
+                                                      NUM_ROWS, NUM_COLS),
+                              Nessi::VectorView<NumT>(d_spacing_err2, c,
+                                                      NUM_ROWS, NUM_COLS));
+  AxisManip::tof_to_d_spacing(in, in_err2, pathlength, pathlength_err2,
+                              polar, polar_err2, true_output,
+                              true_output_err2);
+  if (!test_column(d_spacing, NUM_COLS, c, true_output, "tof_to_d_spacing",
+                   debug)
+      || !test_column(d_spacing_err2, NUM_COLS, c, true_output_err2,
+                      "tof_to_d_spacing err2", debug))
+    {
+      return false;
+    }
+
+  // init_scatt_wavevector_to_Q with the column as final wavevector
+  NumT ki = static_cast<NumT>(2.5);
+  NumT ki_err2 = static_cast<NumT>(0.01);
+  NumT azimuthal = static_cast<NumT>(0.3);
+  NumT azimuthal_err2 = static_cast<NumT>(0.002);
+  Nessi::Vector<NumT> Q[3];
+  Nessi::Vector<NumT> Q_err2[3];
+  Nessi::Vector<NumT> true_Q[3];
+  Nessi::Vector<NumT> true_Q_err2[3];
+  for (int k = 0; k < 3; ++k)
+    {
+      Q[k].assign(NUM_ROWS * NUM_COLS, static_cast<NumT>(0));
+      Q_err2[k].assign(NUM_ROWS * NUM_COLS, static_cast<NumT>(0));
+      true_Q[k].resize(NUM_ROWS);
+      true_Q_err2[k].resize(NUM_ROWS);
+    }
+  AxisManip::init_scatt_wavevector_to_Q(ki, ki_err2, tof_col, tof_col_err2,
+                                        azimuthal, azimuthal_err2, polar,
+                                        polar_err2,
+                                        Nessi::VectorView<NumT>(Q[0], c,
+                                                                NUM_ROWS,
+                                                                NUM_COLS),
+                                        Nessi::VectorView<NumT>(Q_err2[0], c,
+                                                                NUM_ROWS,
+                                                                NUM_COLS),
+                                        Nessi::VectorView<NumT>(Q[1], c,
+                                                                NUM_ROWS,
+                                                                NUM_COLS),
+                                        Nessi::VectorView<NumT>(Q_err2[1], c,
+                                                                NUM_ROWS,
+                                                                NUM_COLS),
+                                        Nessi::VectorView<NumT>(Q[2], c,
+                                                                NUM_ROWS,
+                                                                NUM_COLS),
+                                        Nessi::VectorView<NumT>(Q_err2[2], c,
+                                                                NUM_ROWS,
+                                                                NUM_COLS));
+  AxisManip::init_scatt_wavevector_to_Q(ki, ki_err2, in, in_err2, azimuthal,
+                                        azimuthal_err2, polar, polar_err2,
+                                        true_Q[0], true_Q_err2[0],
+                                        true_Q[1], true_Q_err2[1],
+                                        true_Q[2], true_Q_err2[2]);
+  for (int k = 0; k < 3; ++k)
+    {
+      if (!test_column(Q[k], NUM_COLS, c, true_Q[k],
+                       "init_scatt_wavevector_to_Q", debug)
+          || !test_column(Q_err2[k], NUM_COLS, c, true_Q_err2[k],
+                          "init_scatt_wavevector_to_Q err2", debug))
+        {
+          return false;
+        }
+    }
+
+  // reverse_array_cp of the column
+  Nessi::Vector<NumT> reversed(NUM_ROWS * NUM_COLS);
+  AxisManip::reverse_array_cp(tof_col,
+                              Nessi::VectorView<NumT>(reversed, c, NUM_ROWS,
+                                                      NUM_COLS));
+  AxisManip::reverse_array_cp(in, true_output);
+  if (!test_column(reversed, NUM_COLS, c, true_output, "reverse_array_cp",
+                   debug))
+    {
+      return false;
+    }
+
+  // rebin_axis_1D along the column
+  Nessi::Vector<NumT> axis_in;
+  for (size_t i = 0; i <= NUM_ROWS; ++i)
+    {
+      axis_in.push_back(static_cast<NumT>(2 * i));
+    }
+  Nessi::Vector<NumT> axis_out;
+  for (size_t i = 0; i <= NUM_ROWS_OUT; ++i)
+    {
+      axis_out.push_back(static_cast<NumT>(1 + 3.25 * i));
+    }
+  Nessi::Vector<NumT> rebinned(NUM_ROWS_OUT * NUM_COLS);
+  Nessi::Vector<NumT> rebinned_err2(NUM_ROWS_OUT * NUM_COLS);
+  AxisManip::rebin_axis_1D(axis_in, tof_col, tof_col_err2, axis_out,
+                           Nessi::VectorView<NumT>(rebinned, c,
+                                                   NUM_ROWS_OUT, NUM_COLS),
+                           Nessi::VectorView<NumT>(rebinned_err2, c,
+                                                   NUM_ROWS_OUT, NUM_COLS));
+  Nessi::Vector<NumT> rebin_output(NUM_ROWS_OUT);
+  Nessi::Vector<NumT> rebin_output_err2(NUM_ROWS_OUT);
+  AxisManip::rebin_axis_1D(axis_in, in, in_err2, axis_out, rebin_output,
+                           rebin_output_err2);
+  if (!test_column(rebinned, NUM_COLS, c, rebin_output, "rebin_axis_1D",
+                   debug)
+      || !test_column(rebinned_err2, NUM_COLS, c, rebin_output_err2,
+                      "rebin_axis_1D err2", debug))
+    {
+      return false;
+    }
+
+  // integrate_1D_hist over part of the column
+  Nessi::Vector<NumT> bin_widths;
+  bin_widths.assign(NUM_ROWS, static_cast<NumT>(2));
+  NumT integral;
+  NumT integral_err2;
+  NumT true_integral;
+  NumT true_integral_err2;
+  Utils::integrate_1D_hist(tof_col, tof_col_err2, axis_in,
+                           static_cast<NumT>(3), static_cast<NumT>(9), true,
+                           bin_widths, integral, integral_err2);
+  Utils::integrate_1D_hist(in, in_err2, axis_in, static_cast<NumT>(3),
+                           static_cast<NumT>(9), true, bin_widths,
+                           true_integral, true_integral_err2);
+  if (integral != true_integral || integral_err2 != true_integral_err2)
+    {
+      cout << "(" << type_string(in) << " integrate_1D_hist, column " << c
+           << ") FAILED....Output different from vector expected" << endl;
+      return false;
+    }
+
+  // fit_linear_background on the column
+  Nessi::Vector<NumT> axis_pts(NUM_ROWS);
+  for (size_t i = 0; i < NUM_ROWS; ++i)
+    {
+      axis_pts[i] = static_cast<NumT>(i + 1);
+    }
+  NumT slope[2];
+  NumT slope_err2[2];
+  NumT intercept[2];
+  NumT intercept_err2[2];
+  Utils::fit_linear_background(axis_pts, tof_col, tof_col_err2, 1, 0,
+                               slope[0], slope_err2[0], intercept[0],
+                               intercept_err2[0]);
+  Utils::fit_linear_background(axis_pts, in, in_err2, 1, 0, slope[1],
+                               slope_err2[1], intercept[1],
+                               intercept_err2[1]);
+  if (slope[0] != slope[1] || slope_err2[0] != slope_err2[1]
+      || intercept[0] != intercept[1]
+      || intercept_err2[0] != intercept_err2[1])
+    {
+      cout << "(" << type_string(in) << " fit_linear_background, column "
+           << c << ") FAILED....Output different from vector expected"
+           << endl;
+      return false;
+    }
+
+  return true;
+}
+
+/**
+ * Function that runs the tests on every column and checks that
+ * inconsistent views are rejected.
+ *
+ * \param key (INPUT) key that permits to launch the correct test
+ * \param debug (INPUT) is any string that launches the debug mode (print all
+ * the array created and calculated)
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_func(NumT key, string debug)
+{
+  for (size_t c = 0; c < NUM_COLS; ++c)
+    {
+      if (!test_column_funcs<NumT>(c, debug))
+        {
+          return false;
+        }
+    }
+
+  Nessi::Vector<NumT> array(NUM_ROWS * NUM_COLS);
+  try
+    {
+      Nessi::VectorView<NumT> view(array, 1, NUM_ROWS + 1, NUM_COLS);
+      cout << "(" << type_string(array) << ") FAILED....No exception "
+           << "thrown for a view out of the vector" << endl;
+      return false;
+    }
+  catch (std::invalid_argument &)
+    {
+    }
+
+  Nessi::VectorView<NumT> short_view(array, 0, NUM_ROWS - 1, NUM_COLS);
+  Nessi::VectorView<NumT> view(array, 0, NUM_ROWS, NUM_COLS);
+  try
+    {
+      AxisManip::wavelength_to_energy(Nessi::VectorView<const NumT>(view),
+                                      Nessi::VectorView<const NumT>(view),
+                                      short_view, short_view);
+      cout << "(" << type_string(array) << ") FAILED....No exception "
+           << "thrown for views of different sizes" << endl;
+      return false;
+    }
+  catch (std::invalid_argument &)
+    {
+    }
+
+  return true;
+}
+
+/**
+ * Main function that tests the view versions of the functions for float
+ * and double.
+ *
+ * \param argc The number of command-line arguments present
+ * \param argv The list of command-line arguments
+ */
+int main(int argc, char *argv[])
+{
+  cout << "vector_view_test.cpp..........";
+
+  string debug;
+  if (argc >1)
+    {
+      debug = argv[1];
+    }
+
+  int value = 0;
+
+  if(!test_func(static_cast<float>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(!test_func(static_cast<double>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(value == 0)
+    {
+      cout << "Functionality OK" << endl;
+    }
+
+  return value;
+}
+
+/**
+ * \}
+ */   //end of vector_view_test group
@@ -0,0 +1,369 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file axis_manip/test/cpp/workspace_test.cpp
+ */
+
+
+#include "nessi_workspace.hpp"
+#include "rebinning.hpp"
+#include "test_common.hpp"
+#include "utils.hpp"
+
+using namespace std;
+
+/// Number of bins along every axis of the 2D histograms
+const size_t NUM_BINS = 6;
+/// Number of calls made with the same workspace
+const int NUM_CALLS = 4;
+
+/**
+ * \defgroup workspace_test workspace_test
+ * \{
+ *
+ * This test checks the bookkeeping of Nessi::Workspace and runs
+ * <i>rebin_axis_2D</i>, <i>rebin_2D_quad_to_rectlin</i> and
+ * <i>calc_eq_jacobian_dgs</i> with and without a workspace. The results
+ * must be identical and, once the workspace has grown during the first
+ * call, the following calls must not make any heap allocation.
+ *
+ * <b>Notation used:</b>
+ * - VV = "v,v"
+ * - ERROR = "Error"
+ */
+
+/**
+ * Function that compares two arrays element by element. No tolerance is
+ * allowed.
+ *
+ * \param output (INPUT) is the array created with a workspace
+ * \param true_output (INPUT) is the array created without a workspace
+ * \param what (INPUT) is the name of the check for the error message
+ * \param debug (INPUT) is any string that launches the debug mode
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_identical(Nessi::Vector<NumT> & output,
+                    Nessi::Vector<NumT> & true_output,
+                    const string & what, string debug)
+{
+  if (!debug.empty())
+    {
+      print(output, true_output, VV, debug);
+    }
+
+  if (output.size() != true_output.size())
+    {
+      cout << "(" << type_string(output) << " " << what << ") FAILED...."
+           << "Output size different from vector expected" << endl;
+      return false;
+    }
+  for (size_t i = 0; i < output.size(); ++i)
+    {
+      if (!(output[i] == true_output[i]))
+        {
+          cout << "(" << type_string(output) << " " << what << ") FAILED...."
+               << "Output different from vector expected at index #" << i
+               << endl;
+          return false;
+        }
+    }
+  return true;
+}
+
+/**
+ * Function that checks the number of heap allocations of a workspace after
+ * the first call.
+ *
+ * \param workspace (INPUT) is the workspace used for all calls
+ * \param allocations (INPUT) is the number of heap allocations after the
+ * first call
+ * \param what (INPUT) is the name of the function for the error message
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+bool test_allocations(const Nessi::Workspace & workspace,
+                      const size_t allocations, const string & what)
+{
+  if (workspace.heap_allocations() != allocations)
+    {
+      cout << "(" << what << ") FAILED....Workspace allocated memory after "
+           << "the first call" << endl;
+      return false;
+    }
+  return true;
+}
+
+/**
+ * Function that checks the carving, the overflow and the consolidation of
+ * a workspace.
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+bool test_workspace()
+{
+  Nessi::Workspace workspace(256);
+  if (!workspace.valid())
+    {
+      cout << "(workspace) FAILED....Live workspace not valid" << endl;
+      return false;
+    }
+  for (int pass = 0; pass < 2; ++pass)
+    {
+      Nessi::Workspace::Marker m = workspace.mark();
+      double * a = workspace.allocate<double>(10);
+      float * b = workspace.allocate<float>(100);
+      char * c = workspace.allocate<char>(3);
+      if (reinterpret_cast<size_t>(a) % Nessi::VECTOR_ALIGNMENT != 0
+          || reinterpret_cast<size_t>(b) % Nessi::VECTOR_ALIGNMENT != 0
+          || reinterpret_cast<size_t>(c) % Nessi::VECTOR_ALIGNMENT != 0)
+        {
+          cout << "(workspace) FAILED....Memory not aligned" << endl;
+          return false;
+        }
+      workspace.release(m);
+    }
+
+  // 80 + 400 + 3 bytes need 640 bytes once aligned. The first pass
+  // overflows the buffer into one chunk, the release replaces the buffer
+  // and the second pass fits in it.
+  if (workspace.capacity() < 640 || workspace.high_water() != 640)
+    {
+      cout << "(workspace) FAILED....Buffer not grown to the largest use"
+           << endl;
+      return false;
+    }
+  if (workspace.heap_allocations() != 3)
+    {
+      cout << "(workspace) FAILED....Unexpected number of heap allocations"
+           << endl;
+      return false;
+    }
+  return true;
+}
+
+/**
+ * Function that runs the 2D rebinning functions with and without a
+ * workspace.
+ *
+ * \param key (INPUT) key that permits to launch the correct test
+ * \param debug (INPUT) is any string that launches the debug mode (print all
+ * the array created and calculated)
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_func(NumT key, string debug)
+{
+  // rebin_axis_2D
+  Nessi::Vector<NumT> axis_in;
+  Nessi::Vector<NumT> axis_out;
+  for (size_t i = 0; i <= NUM_BINS; ++i)
+    {
+      axis_in.push_back(static_cast<NumT>(i));
+      axis_out.push_back(static_cast<NumT>(0.5 + 0.75 * i));
+    }
+  Nessi::Vector<NumT> input;
+  Nessi::Vector<NumT> input_err2;
+  for (size_t i = 0; i < NUM_BINS * NUM_BINS; ++i)
+    {
+      input.push_back(static_cast<NumT>(10. + 0.5 * i));
+      input_err2.push_back(static_cast<NumT>(1. + 0.25 * i));
+    }
+  Nessi::Vector<NumT> true_output(NUM_BINS * NUM_BINS);
+  Nessi::Vector<NumT> true_output_err2(NUM_BINS * NUM_BINS);
+  AxisManip::rebin_axis_2D(axis_in, axis_in, input, input_err2, axis_out,
+                           axis_out, true_output, true_output_err2);
+
+  // every other call reuses the plans instead of the axes
+  AxisManip::RebinPlan1D<NumT> plan(axis_in, axis_out);
+  Nessi::Workspace workspace;
+  size_t allocations = 0;
+  for (int call = 0; call < NUM_CALLS; ++call)
+    {
+      Nessi::Vector<NumT> output(NUM_BINS * NUM_BINS);
+      Nessi::Vector<NumT> output_err2(NUM_BINS * NUM_BINS);
+      if (call % 2 == 0)
+        {
+          AxisManip::rebin_axis_2D(axis_in, axis_in, input, input_err2,
+                                   axis_out, axis_out, output, output_err2,
+                                   &workspace);
+        }
+      else
+        {
+          AxisManip::rebin_axis_2D(plan, plan, input, input_err2, output,
+                                   output_err2, &workspace);
+        }
+      if (!test_identical(output, true_output, "rebin_axis_2D", debug)
+          || !test_identical(output_err2, true_output_err2,
+                             "rebin_axis_2D err2", debug))
+        {
+          return false;
+        }
+      if (call == 0)
+        {
+          allocations = workspace.heap_allocations();
+        }
+      else if (!test_allocations(workspace, allocations, "rebin_axis_2D"))
+        {
+          return false;
+        }
+    }
+
+  // rebin_2D_quad_to_rectlin with slightly rotated quadrilaterals
+  Nessi::Vector<NumT> x[4];
+  Nessi::Vector<NumT> y[4];
+  const double dx[4] = {0., 0.1, 1.1, 1.};
+  const double dy[4] = {0., 1., 0.9, -0.1};
+  Nessi::Vector<NumT> quad_input;
+  Nessi::Vector<NumT> quad_input_err2;
+  for (size_t k = 0; k < NUM_BINS; ++k)
+    {
+      for (int c = 0; c < 4; ++c)
+        {
+          x[c].push_back(static_cast<NumT>(0.3 + 0.7 * k + dx[c]));
+          y[c].push_back(static_cast<NumT>(0.6 + 0.5 * k + dy[c]));
+        }
+      quad_input.push_back(static_cast<NumT>(5. + k));
+      quad_input_err2.push_back(static_cast<NumT>(1. + 0.5 * k));
+    }
+  size_t num_out = NUM_BINS * NUM_BINS;
+  Nessi::Vector<NumT> true_results[4];
+  Nessi::Vector<NumT> results[4];
+  for (int call = 0; call <= NUM_CALLS; ++call)
+    {
+      Nessi::Vector<NumT> orig_bin_x(4);
+      Nessi::Vector<NumT> orig_bin_y(4);
+      Nessi::Vector<NumT> rebin_bin_x(4);
+      Nessi::Vector<NumT> rebin_bin_y(4);
+      Nessi::Vector<NumT> frac_bin_x(8);
+      Nessi::Vector<NumT> frac_bin_y(8);
+      Nessi::Vector<NumT> * out = (call == 0) ? true_results : results;
+      for (int r = 0; r < 4; ++r)
+        {
+          out[r].assign(num_out, static_cast<NumT>(0));
+        }
+      AxisManip::rebin_2D_quad_to_rectlin(x[0], y[0], x[1], y[1], x[2],
+                                          y[2], x[3], y[3], quad_input,
+                                          quad_input_err2, axis_out,
+                                          axis_out, orig_bin_x, orig_bin_y,
+                                          rebin_bin_x, rebin_bin_y,
+                                          frac_bin_x, frac_bin_y, out[0],
+                                          out[1], out[2], out[3],
+                                          (call == 0) ? NULL : &workspace);
+      if (call == 0)
+        {
+          continue;
+        }
+      for (int r = 0; r < 4; ++r)
+        {
+          if (!test_identical(results[r], true_results[r],
+                              "rebin_2D_quad_to_rectlin", debug))
+            {
+              return false;
+            }
+        }
+      if (call == 1)
+        {
+          allocations = workspace.heap_allocations();
+        }
+      else if (!test_allocations(workspace, allocations,
+                                 "rebin_2D_quad_to_rectlin"))
+        {
+          return false;
+        }
+    }
+
+  // calc_eq_jacobian_dgs on the same quadrilaterals
+  Nessi::Vector<NumT> true_jacobian(NUM_BINS);
+  Utils::calc_eq_jacobian_dgs(x[0], x[1], x[2], x[3], y[0], y[1], y[2],
+                              y[3], true_jacobian);
+  for (int call = 0; call < NUM_CALLS; ++call)
+    {
+      Nessi::Vector<NumT> jacobian(NUM_BINS);
+      Utils::calc_eq_jacobian_dgs(x[0], x[1], x[2], x[3], y[0], y[1], y[2],
+                                  y[3], jacobian, &workspace);
+      if (!test_identical(jacobian, true_jacobian, "calc_eq_jacobian_dgs",
+                          debug))
+        {
+          return false;
+        }
+      if (!test_allocations(workspace, allocations, "calc_eq_jacobian_dgs"))
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+
+/**
+ * Main function that tests the workspace and the functions using it for
+ * float and double.
+ *
+ * \param argc The number of command-line arguments present
+ * \param argv The list of command-line arguments
+ */
+int main(int argc, char *argv[])
+{
+  cout << "workspace_test.cpp..........";
+
+  string debug;
+  if (argc >1)
+    {
+      debug = argv[1];
+    }
+
+  int value = 0;
+
+  if(!test_workspace())
+    {
+      value = -1;
+    }
+
+  if(!test_func(static_cast<float>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(!test_func(static_cast<double>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(value == 0)
+    {
+      cout << "Functionality OK" << endl;
+    }
+
+  return value;
+}
+
+/**
+ * \}
+ */   //end of workspace_test group
@@ -30,6 +30,8 @@
 
 // Need to ignore guard names from header files
 %ignore _NESSI_HPP;
+%ignore Nessi::uninitialized;
+%ignore Nessi::Vector::Vector(size_type, Uninitialized);
 
 %include <std_string.i>
 %include <std_vector.i>
@@ -48,9 +50,14 @@ This function sets the self vector from another vector. The self
 vector must not be empty.
 """;
 
+// Nessi::Vector is derived from a std::vector using Nessi::Allocator
+namespace Nessi {
+  template <typename T> class Allocator;
+}
+
 namespace std {
-  %template(DoubleVector) vector<double>;
-  %template(IntVector) vector<int>;
+  %template(DoubleVector) vector<double, Nessi::Allocator<double> >;
+  %template(IntVector) vector<int, Nessi::Allocator<int> >;
 }
 
 namespace Nessi {
@@ -62,7 +69,7 @@ namespace Nessi {
     std::string __type__() {
       return "double";
     }
-    PyObject * __set_from_NessiVector__(std::vector<double> *target,
+    PyObject * __set_from_NessiVector__(std::vector<double, Nessi::Allocator<double> > *target,
                                         PyObject *source){
         if(!PyCObject_Check(source)){
           PyErr_SetString(PyExc_TypeError,"Can only handle c-objects");
@@ -70,14 +77,14 @@ namespace Nessi {
         }
           
         void * void_source=PyCObject_AsVoidPtr(source);
-        std::vector<double> *source_ptr=static_cast<std::vector<double> *>(void_source);
+        std::vector<double, Nessi::Allocator<double> > *source_ptr=static_cast<std::vector<double, Nessi::Allocator<double> > *>(void_source);
 
         target->assign(source_ptr->begin(),source_ptr->end());
 
         Py_INCREF(Py_None);
         return Py_None;
     }
-    void  __set_from_Vector__(std::vector<double> *source) {
+    void  __set_from_Vector__(std::vector<double, Nessi::Allocator<double> > *source) {
        	
 	self->assign(source->begin(),source->end());
 	return;
@@ -88,21 +95,21 @@ namespace Nessi {
     std::string __type__() {
       return "int";
     }
-    PyObject * __set_from_NessiVector__(std::vector<int> *target, PyObject *source){
+    PyObject * __set_from_NessiVector__(std::vector<int, Nessi::Allocator<int> > *target, PyObject *source){
         if(!PyCObject_Check(source)){
           PyErr_SetString(PyExc_TypeError,"Can only handle c-objects");
           return NULL;
         }
           
         void * void_source=PyCObject_AsVoidPtr(source);
-        std::vector<int> *source_ptr=static_cast<std::vector<int> *>(void_source);
+        std::vector<int, Nessi::Allocator<int> > *source_ptr=static_cast<std::vector<int, Nessi::Allocator<int> > *>(void_source);
 
         target->assign(source_ptr->begin(),source_ptr->end());
 
         Py_INCREF(Py_None);
         return Py_None;
     }
-    void  __set_from_Vector__(std::vector<int> *source) {
+    void  __set_from_Vector__(std::vector<int, Nessi::Allocator<int> > *source) {
        	
 	self->assign(source->begin(),source->end());
 	return;
@@ -31,7 +31,11 @@
 #ifndef _NESSI_HPP
 #define _NESSI_HPP 1
 
+#include "nessi_alloc.hpp"
 #include <vector>
+#if __cplusplus >= 201103L
+#include <utility>
+#endif
 
 /**
  * \namespace Nessi
@@ -42,11 +46,32 @@
  * The features contained in this namespace have influence on all functions
  * provided in the SNS common libraries. One feature is the use of global
  * abstraction (Nessi::Vector) for the underlying data container, which in
- * this case is currently std::vector. The other feature is an empty warning
+ * this case is currently std::vector with an aligned allocator
+ * (Nessi::Allocator). The other feature is an empty warning
  * string that functions return when no warnings are generated.
  */
 namespace Nessi
 {
+  /**
+   * \brief Tag type selecting the uninitialized constructor of Vector
+   */
+  struct Uninitialized
+  {
+  };
+
+  /**
+   * \brief Tag selecting the uninitialized constructor of Vector
+   *
+   * \code
+   * Nessi::Vector<double> output(size, Nessi::uninitialized);
+   * \endcode
+   * creates a Vector whose elements are not set. It is meant for outputs
+   * that are completely overwritten, where filling the memory with zeros
+   * first would be a wasted pass over the data. Functions that accumulate
+   * into their output still require a zero filled Vector.
+   */
+  const Uninitialized uninitialized = Uninitialized();
+
   /**
    * \brief Provides wrapper for std::vector
    *
@@ -94,23 +119,48 @@ namespace Nessi
    * out_of_range lookups are not defined.
    */
   template <typename T>
-  class Vector : public std::vector<T>
+  class Vector : public std::vector<T, Allocator<T> >
   {
   public:
+    /// The underlying container
+    typedef std::vector<T, Allocator<T> > base_type;
+    /// Type for the number of elements
+    typedef typename base_type::size_type size_type;
+
     /**
      * \brief Constructor for empty Vector
      *
      * This provides a constructor method for an empty Vector
      */
-    Vector() : std::vector<T>() { }
+    Vector() : base_type() { }
     /**
      * \brief Constructor for Vector of size i
      *
-     * This provides a constructor method for Vector of size i
+     * This provides a constructor method for Vector of size i. All
+     * elements are set to zero.
      *
      * \param i is the size of the desired Vector
      */
-    Vector(int i) : std::vector<T>(i) { }
+    Vector(int i) : base_type(i, T()) { }
+
+    /**
+     * \brief Constructor for Vector of size i without setting the elements
+     *
+     * This provides a constructor method for Vector of size i whose
+     * elements are default-initialized, which leaves the arithmetic types
+     * unset. Compilers older than C++11 set the elements to zero. The
+     * elements added later, by resize() for instance, are set to zero.
+     *
+     * \param i is the size of the desired Vector, which may exceed the
+     * range of int
+     * \param tag is Nessi::uninitialized
+     */
+#if __cplusplus >= 201103L
+    Vector(size_type i, Uninitialized tag)
+      : base_type(base_type(i, Allocator<T>(tag)), Allocator<T>()) { }
+#else
+    Vector(size_type i, Uninitialized) : base_type(i) { }
+#endif
 
     /**
      * \brief Copy Constructor for Vector
@@ -119,9 +169,84 @@ namespace Nessi
      *
      * \param a is the Vector to be copied 
      */
-    Vector(const Vector<T> &a) : std::vector<T>(a.begin(), a.end()) { }
+    Vector(const Vector<T> &a) : base_type(a) { }
+
+    /**
+     * \brief Assignment operator for Vector
+     *
+     * \param a is the Vector to be copied
+     */
+    Vector<T> & operator=(const Vector<T> &a)
+    {
+      base_type::operator=(a);
+      return *this;
+    }
+
+#if __cplusplus >= 201103L
+    /**
+     * \brief Move Constructor for Vector
+     *
+     * This takes over the memory of \p a without copying the elements.
+     * \p a is left empty.
+     *
+     * \param a is the Vector to be moved
+     */
+    Vector(Vector<T> &&a) noexcept : base_type(std::move(a)) { }
+
+    /**
+     * \brief Move assignment operator for Vector
+     *
+     * This takes over the memory of \p a without copying the elements.
+     *
+     * \param a is the Vector to be moved
+     */
+    Vector<T> & operator=(Vector<T> &&a) noexcept
+    {
+      base_type::operator=(std::move(a));
+      return *this;
+    }
+#endif
+
+    /**
+     * \brief Changes the size of the Vector
+     *
+     * New elements are set to zero.
+     *
+     * \param n is the new size of the Vector
+     */
+    void resize(size_type n)
+    {
+      base_type::resize(n, T());
+    }
+
+    /**
+     * \brief Changes the size of the Vector
+     *
+     * \param n is the new size of the Vector
+     * \param value is the value of the new elements
+     */
+    void resize(size_type n, const T & value)
+    {
+      base_type::resize(n, value);
+    }
   };
 
+  /**
+   * \brief Exchanges the contents of two Vectors
+   *
+   * Only the memory is exchanged, no element is copied. This is found by
+   * argument dependent lookup, so <code>using std::swap; swap(a, b);</code>
+   * does not copy the Vectors even without move semantics.
+   *
+   * \param a is the first Vector
+   * \param b is the second Vector
+   */
+  template <typename T>
+  inline void swap(Vector<T> &a, Vector<T> &b)
+  {
+    a.swap(b);
+  }
+
   /**
    * \}
    */
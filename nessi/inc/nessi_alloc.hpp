@@ -0,0 +1,290 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file nessi/inc/nessi_alloc.hpp
+ */
+
+#ifndef _NESSI_ALLOC_HPP
+#define _NESSI_ALLOC_HPP 1
+
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#if __cplusplus >= 201103L
+#include <utility>
+#endif
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace Nessi
+{
+  /**
+   * \defgroup nessi_alloc Nessi::Allocator
+   * \{
+   *
+   * The memory of every Nessi::Vector is obtained through
+   * Nessi::Allocator. The first element is aligned on a cache line, which
+   * is also the width of the largest vector register, so the vectorized
+   * kernels never split a load of the first elements across two cache
+   * lines.
+   *
+   * An element created without a value is value-initialized, as with
+   * std::allocator. When the library is built as C++11 or newer, an
+   * allocator constructed from Nessi::uninitialized default-initializes
+   * such elements instead, which for the arithmetic types means the memory
+   * is not written at all. Nessi::Vector only uses it in its uninitialized
+   * constructor and hands the elements over to a regular allocator, so
+   * its later resizes set the new elements to zero.
+   */
+
+  struct Uninitialized;
+
+  /// Alignment in bytes of the memory returned by Nessi::Allocator
+  const std::size_t VECTOR_ALIGNMENT = 64;
+
+  /**
+   * \brief Standard conforming allocator returning aligned memory
+   */
+  template <typename T>
+  class Allocator
+  {
+  public:
+    /// Type of the allocated elements
+    typedef T value_type;
+    /// Pointer to an element
+    typedef T * pointer;
+    /// Constant pointer to an element
+    typedef const T * const_pointer;
+    /// Reference to an element
+    typedef T & reference;
+    /// Constant reference to an element
+    typedef const T & const_reference;
+    /// Type for the number of elements
+    typedef std::size_t size_type;
+    /// Type for the difference between two pointers
+    typedef std::ptrdiff_t difference_type;
+
+    /**
+     * \brief The same allocator for another element type
+     */
+    template <typename U>
+    struct rebind
+    {
+      /// The allocator for the elements of type U
+      typedef Allocator<U> other;
+    };
+
+    /**
+     * \brief Constructor for the allocator
+     */
+    Allocator() throw() : default_init_(false) { }
+
+    /**
+     * \brief Constructor for an allocator default-initializing the
+     * elements created without a value
+     */
+    explicit Allocator(const Uninitialized &) throw() : default_init_(true)
+    { }
+
+    /**
+     * \brief Copy Constructor for the allocator
+     */
+    Allocator(const Allocator & a) throw() : default_init_(a.default_init_)
+    { }
+
+    /**
+     * \brief Constructor from the allocator of another element type
+     */
+    template <typename U>
+    Allocator(const Allocator<U> & a) throw()
+      : default_init_(a.default_init())
+    { }
+
+    /**
+     * \brief Returns true if the elements created without a value are
+     * default-initialized
+     */
+    bool default_init() const throw()
+    {
+      return default_init_;
+    }
+
+    /**
+     * \brief Returns the address of \p x
+     */
+    pointer address(reference x) const
+    {
+      return &x;
+    }
+
+    /**
+     * \brief Returns the address of \p x
+     */
+    const_pointer address(const_reference x) const
+    {
+      return &x;
+    }
+
+    /**
+     * \brief Allocates memory for \p n elements aligned on
+     * Nessi::VECTOR_ALIGNMENT bytes
+     *
+     * \exception std::bad_alloc is thrown if the memory cannot be
+     * allocated
+     */
+    pointer allocate(size_type n, const void * = 0)
+    {
+      if (n == 0)
+        {
+          return 0;
+        }
+      if (n > this->max_size())
+        {
+          throw std::bad_alloc();
+        }
+      void *p = 0;
+#ifdef _WIN32
+      p = _aligned_malloc(n * sizeof(T), VECTOR_ALIGNMENT);
+#else
+      if (posix_memalign(&p, VECTOR_ALIGNMENT, n * sizeof(T)) != 0)
+        {
+          p = 0;
+        }
+#endif
+      if (p == 0)
+        {
+          throw std::bad_alloc();
+        }
+      return static_cast<pointer>(p);
+    }
+
+    /**
+     * \brief Releases memory obtained from allocate()
+     */
+    void deallocate(pointer p, size_type)
+    {
+#ifdef _WIN32
+      _aligned_free(p);
+#else
+      std::free(p);
+#endif
+    }
+
+    /**
+     * \brief Returns the largest number of elements that can be allocated
+     */
+    size_type max_size() const throw()
+    {
+      return std::numeric_limits<size_type>::max() / sizeof(T);
+    }
+
+#if __cplusplus >= 201103L
+    /**
+     * \brief Value-initializes an element, or default-initializes it for
+     * an allocator constructed from Nessi::uninitialized
+     */
+    template <typename U>
+    void construct(U * p)
+    {
+      if (default_init_)
+        {
+          ::new(static_cast<void *>(p)) U;
+        }
+      else
+        {
+          ::new(static_cast<void *>(p)) U();
+        }
+    }
+
+    /**
+     * \brief Constructs an element from \p args
+     */
+    template <typename U, typename... Args>
+    void construct(U * p, Args&&... args)
+    {
+      ::new(static_cast<void *>(p)) U(std::forward<Args>(args)...);
+    }
+
+    /**
+     * \brief Destroys an element
+     */
+    template <typename U>
+    void destroy(U * p)
+    {
+      p->~U();
+    }
+#else
+    /**
+     * \brief Constructs an element as a copy of \p value
+     */
+    void construct(pointer p, const T & value)
+    {
+      ::new(static_cast<void *>(p)) T(value);
+    }
+
+    /**
+     * \brief Destroys an element
+     */
+    void destroy(pointer p)
+    {
+      p->~T();
+    }
+#endif
+
+  private:
+    /// True if the elements created without a value are
+    /// default-initialized
+    bool default_init_;
+  };
+
+  /**
+   * \brief All Nessi allocators are interchangeable
+   */
+  template <typename T, typename U>
+  inline bool operator==(const Allocator<T> &, const Allocator<U> &)
+  {
+    return true;
+  }
+
+  /**
+   * \brief All Nessi allocators are interchangeable
+   */
+  template <typename T, typename U>
+  inline bool operator!=(const Allocator<T> &, const Allocator<U> &)
+  {
+    return false;
+  }
+
+  /**
+   * \}
+   */ // end of nessi_alloc group
+
+} // Nessi
+
+#endif // _NESSI_ALLOC_HPP
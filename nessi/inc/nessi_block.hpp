@@ -0,0 +1,313 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file nessi/inc/nessi_block.hpp
+ */
+
+#ifndef _NESSI_BLOCK_HPP
+#define _NESSI_BLOCK_HPP 1
+
+#include "nessi.hpp"
+#include <cstddef>
+#include <stdexcept>
+
+namespace Nessi
+{
+  /**
+   * \defgroup nessi_block Nessi::SpectrumBlock
+   * \{
+   *
+   * A Nessi::SpectrumBlock holds the spectra of many pixels that share the
+   * same number of bins. The values of all spectra are stored in one
+   * Nessi::Vector and the squares of the uncertainties in a second one.
+   * Spectrum \f$p\f$ starts at element \f$p \times stride\f$ of both
+   * vectors and its bins are consecutive. The stride is at least the
+   * number of bins. A larger stride leaves padding elements between the
+   * spectra that are never read or written by the library, which allows
+   * every spectrum to start on an aligned address.
+   *
+   * The batch overloads of the library functions process all spectra of a
+   * block in one call. When the stride equals the number of bins the
+   * spectra form a single array and element-wise operations run over the
+   * whole block in one pass.
+   */
+
+  /**
+   * \brief Contiguous storage of the spectra of many pixels
+   */
+  template <typename T>
+  class SpectrumBlock
+  {
+  public:
+    /**
+     * \brief Constructor for an empty block
+     */
+    SpectrumBlock()
+      : num_spectra_(0), num_bins_(0), stride_(0)
+    { }
+
+    /**
+     * \brief Constructor for a block of zero filled spectra
+     *
+     * \param num_spectra is the number of spectra (pixels)
+     * \param num_bins is the number of bins in every spectrum
+     */
+    SpectrumBlock(const std::size_t num_spectra, const std::size_t num_bins)
+      : num_spectra_(num_spectra), num_bins_(num_bins), stride_(num_bins)
+    {
+      value_.assign(num_spectra * num_bins, T());
+      err2_.assign(num_spectra * num_bins, T());
+    }
+
+    /**
+     * \brief Constructor for a block of zero filled, padded spectra
+     *
+     * \param num_spectra is the number of spectra (pixels)
+     * \param num_bins is the number of bins in every spectrum
+     * \param stride is the distance in elements between the first bins of
+     * two consecutive spectra
+     *
+     * \exception std::invalid_argument is thrown if the stride is smaller
+     * than the number of bins.
+     */
+    SpectrumBlock(const std::size_t num_spectra, const std::size_t num_bins,
+                  const std::size_t stride)
+      : num_spectra_(num_spectra), num_bins_(num_bins), stride_(stride)
+    {
+      if (stride < num_bins)
+        {
+          throw std::invalid_argument("Nessi::SpectrumBlock: stride smaller "
+                                      "than the number of bins");
+        }
+      value_.assign(num_spectra * stride, T());
+      err2_.assign(num_spectra * stride, T());
+    }
+
+    /**
+     * \brief Returns the number of spectra
+     */
+    std::size_t num_spectra() const
+    {
+      return num_spectra_;
+    }
+
+    /**
+     * \brief Returns the number of bins in every spectrum
+     */
+    std::size_t num_bins() const
+    {
+      return num_bins_;
+    }
+
+    /**
+     * \brief Returns the distance between two consecutive spectra
+     */
+    std::size_t stride() const
+    {
+      return stride_;
+    }
+
+    /**
+     * \brief Returns true if there is no padding between the spectra
+     */
+    bool is_contiguous() const
+    {
+      return stride_ == num_bins_;
+    }
+
+    /**
+     * \brief Returns true if \p other has the same number of spectra and
+     * bins. The strides may differ.
+     */
+    template <typename U>
+    bool same_shape(const SpectrumBlock<U> & other) const
+    {
+      return num_spectra_ == other.num_spectra()
+        && num_bins_ == other.num_bins();
+    }
+
+    /**
+     * \brief Returns the values of all spectra
+     */
+    Vector<T> & value()
+    {
+      return value_;
+    }
+
+    /**
+     * \brief Returns the values of all spectra
+     */
+    const Vector<T> & value() const
+    {
+      return value_;
+    }
+
+    /**
+     * \brief Returns the squared uncertainties of all spectra
+     */
+    Vector<T> & err2()
+    {
+      return err2_;
+    }
+
+    /**
+     * \brief Returns the squared uncertainties of all spectra
+     */
+    const Vector<T> & err2() const
+    {
+      return err2_;
+    }
+
+    /**
+     * \brief Returns the first value of spectrum \p i
+     *
+     * The index is not checked. A block without elements returns a null
+     * pointer.
+     */
+    T * value(const std::size_t i)
+    {
+      return value_.empty() ? 0 : &value_[0] + i * stride_;
+    }
+
+    /**
+     * \brief Returns the first value of spectrum \p i
+     *
+     * The index is not checked. A block without elements returns a null
+     * pointer.
+     */
+    const T * value(const std::size_t i) const
+    {
+      return value_.empty() ? 0 : &value_[0] + i * stride_;
+    }
+
+    /**
+     * \brief Returns the first squared uncertainty of spectrum \p i
+     *
+     * The index is not checked. A block without elements returns a null
+     * pointer.
+     */
+    T * err2(const std::size_t i)
+    {
+      return err2_.empty() ? 0 : &err2_[0] + i * stride_;
+    }
+
+    /**
+     * \brief Returns the first squared uncertainty of spectrum \p i
+     *
+     * The index is not checked. A block without elements returns a null
+     * pointer.
+     */
+    const T * err2(const std::size_t i) const
+    {
+      return err2_.empty() ? 0 : &err2_[0] + i * stride_;
+    }
+
+    /**
+     * \brief Copies a spectrum into the block
+     *
+     * \param i is the index of the spectrum to set
+     * \param value is the array of values
+     * \param err2 is the array of squared uncertainties
+     *
+     * \exception std::invalid_argument is thrown if the index is out of
+     * range or if the arrays do not have the number of bins of the block.
+     */
+    void set_spectrum(const std::size_t i, const Vector<T> & value,
+                      const Vector<T> & err2)
+    {
+      this->check_spectrum(i, value, err2);
+      T * out = this->value(i);
+      T * out_err2 = this->err2(i);
+      for (std::size_t j = 0; j < num_bins_; ++j)
+        {
+          out[j] = value[j];
+          out_err2[j] = err2[j];
+        }
+    }
+
+    /**
+     * \brief Copies a spectrum out of the block
+     *
+     * \param i is the index of the spectrum to get
+     * \param value is the array of values
+     * \param err2 is the array of squared uncertainties
+     *
+     * \exception std::invalid_argument is thrown if the index is out of
+     * range or if the arrays do not have the number of bins of the block.
+     */
+    void get_spectrum(const std::size_t i, Vector<T> & value,
+                      Vector<T> & err2) const
+    {
+      this->check_spectrum(i, value, err2);
+      const T * in = this->value(i);
+      const T * in_err2 = this->err2(i);
+      for (std::size_t j = 0; j < num_bins_; ++j)
+        {
+          value[j] = in[j];
+          err2[j] = in_err2[j];
+        }
+    }
+
+  private:
+    /**
+     * This is a PRIVATE helper checking the arguments of set_spectrum()
+     * and get_spectrum().
+     */
+    void check_spectrum(const std::size_t i, const Vector<T> & value,
+                        const Vector<T> & err2) const
+    {
+      if (i >= num_spectra_)
+        {
+          throw std::invalid_argument("Nessi::SpectrumBlock: spectrum index "
+                                      "out of range");
+        }
+      if (value.size() != num_bins_ || err2.size() != num_bins_)
+        {
+          throw std::invalid_argument("Nessi::SpectrumBlock: spectrum not "
+                                      "the same size as the block");
+        }
+    }
+
+    /// Number of spectra
+    std::size_t num_spectra_;
+    /// Number of bins in every spectrum
+    std::size_t num_bins_;
+    /// Distance between the first bins of two consecutive spectra
+    std::size_t stride_;
+    /// Values of all spectra
+    Vector<T> value_;
+    /// Squared uncertainties of all spectra
+    Vector<T> err2_;
+  };
+
+  /**
+   * \}
+   */ // end of nessi_block group
+
+} // Nessi
+
+#endif // _NESSI_BLOCK_HPP
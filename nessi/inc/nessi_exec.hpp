@@ -0,0 +1,215 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file nessi/inc/nessi_exec.hpp
+ */
+
+#ifndef _NESSI_EXEC_HPP
+#define _NESSI_EXEC_HPP 1
+
+#include <cstddef>
+
+namespace Nessi
+{
+  /**
+   * \defgroup nessi_exec Nessi::ExecutionPolicy
+   * \{
+   *
+   * The batch overloads of the library accept an execution policy as their
+   * first argument, in the manner of the C++17 parallel algorithms:
+   * - Nessi::execution::seq processes the spectra one after the other in
+   *   the calling thread.
+   * - Nessi::execution::par distributes the spectra over the threads of
+   *   the library.
+   * - Nessi::execution::par_unseq does the same. The element loops inside
+   *   a spectrum are vectorized with every policy, so it is accepted for
+   *   symmetry with the standard.
+   *
+   * The threads of the library are the OpenMP thread pool. Their number
+   * is set with Nessi::set_num_threads(). When the library is built
+   * without OpenMP the parallel policies run sequentially.
+   *
+   * Every spectrum is computed by exactly one thread with the same
+   * operations as the sequential version, and the warnings are collected
+   * in the order of the spectra. The results are therefore identical for
+   * any number of threads.
+   */
+
+  /**
+   * \brief Selects how the spectra of a batch call are processed
+   */
+  class ExecutionPolicy
+  {
+  public:
+    /// The kinds of execution
+    enum Kind
+      {
+        /// One spectrum after the other in the calling thread
+        SEQUENCED,
+        /// Spectra distributed over the threads
+        PARALLEL,
+        /// Spectra distributed over the threads, elements vectorized
+        PARALLEL_UNSEQUENCED
+      };
+
+    /**
+     * \brief Constructor for a policy of the given kind
+     */
+    explicit ExecutionPolicy(const Kind kind)
+      : kind_(kind)
+    { }
+
+    /**
+     * \brief Returns the kind of the policy
+     */
+    Kind kind() const
+    {
+      return kind_;
+    }
+
+    /**
+     * \brief Returns true if the spectra may be processed by several
+     * threads
+     */
+    bool is_parallel() const
+    {
+      return kind_ != SEQUENCED;
+    }
+
+  private:
+    /// The kind of the policy
+    Kind kind_;
+  };
+
+  /**
+   * \brief The policy objects passed to the batch overloads
+   */
+  namespace execution
+  {
+    /// Sequential execution
+    static const ExecutionPolicy seq(ExecutionPolicy::SEQUENCED);
+    /// Parallel execution
+    static const ExecutionPolicy par(ExecutionPolicy::PARALLEL);
+    /// Parallel and vectorized execution
+    static const ExecutionPolicy
+    par_unseq(ExecutionPolicy::PARALLEL_UNSEQUENCED);
+  } // execution
+
+  /**
+   * This is a PRIVATE helper holding the number of threads requested with
+   * set_num_threads(). Zero selects the default of the OpenMP runtime.
+   */
+  inline int & __requested_num_threads()
+  {
+    static int num_threads = 0;
+    return num_threads;
+  }
+
+  /**
+   * \brief Sets the number of threads used by the parallel policies
+   *
+   * \param num_threads is the number of threads, zero restores the default
+   * of the OpenMP runtime (usually the number of cores or the value of
+   * OMP_NUM_THREADS)
+   */
+  inline void set_num_threads(const int num_threads)
+  {
+    __requested_num_threads() = (num_threads > 0) ? num_threads : 0;
+  }
+
+  /**
+   * \brief Returns the number of threads used by the parallel policies
+   *
+   * A library built without OpenMP always returns one. The function is
+   * compiled into the library, so the answer does not depend on whether
+   * the calling code is built with OpenMP.
+   */
+  int get_num_threads();
+
+  /**
+   * \brief Returns the number of chunks for_each_chunk() splits \p size
+   * items into
+   *
+   * \param policy is the execution policy of the call
+   * \param size is the number of items
+   */
+  inline std::size_t num_chunks(const ExecutionPolicy & policy,
+                                const std::size_t size)
+  {
+    if (size == 0)
+      {
+        return 0;
+      }
+    if (!policy.is_parallel())
+      {
+        return 1;
+      }
+    std::size_t num_threads = static_cast<std::size_t>(get_num_threads());
+    return (num_threads < size) ? num_threads : size;
+  }
+
+  /**
+   * \brief Calls \p func once for every chunk of the items [0, size)
+   *
+   * The items are split into num_chunks() ranges of consecutive items and
+   * \p func is called as func(chunk, begin, end) for each of them. With a
+   * parallel policy the chunks run on different threads, so \p func must
+   * only write to the items of its own range and must not throw.
+   *
+   * \param policy is the execution policy of the call
+   * \param size is the number of items
+   * \param func is the function object processing a chunk
+   */
+  template <typename FuncT>
+  void for_each_chunk(const ExecutionPolicy & policy, const std::size_t size,
+                      const FuncT & func)
+  {
+    std::size_t chunks = num_chunks(policy, size);
+    if (chunks == 1)
+      {
+        func(0, 0, size);
+        return;
+      }
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(static_cast<int>(chunks)) \
+  schedule(static, 1)
+#endif
+    for (long c = 0; c < static_cast<long>(chunks); ++c)
+      {
+        std::size_t chunk = static_cast<std::size_t>(c);
+        func(chunk, chunk * size / chunks, (chunk + 1) * size / chunks);
+      }
+  }
+
+  /**
+   * \}
+   */ // end of nessi_exec group
+
+} // Nessi
+
+#endif // _NESSI_EXEC_HPP
@@ -0,0 +1,155 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file nessi/inc/nessi_simd.hpp
+ */
+
+#ifndef _NESSI_SIMD_HPP
+#define _NESSI_SIMD_HPP 1
+
+/**
+ * This macro is defined when the compiler is able to build the explicit
+ * x86 vector kernels (function specific target options and the CPU
+ * feature builtins are required).
+ */
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) \
+  && !defined(__INTEL_COMPILER) \
+  && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define NESSI_HAVE_X86_SIMD 1
+#endif
+
+/**
+ * This macro is defined when the compiler is also able to build the
+ * AVX-512 kernels.
+ */
+#if defined(NESSI_HAVE_X86_SIMD) && (__GNUC__ >= 5)
+#define NESSI_HAVE_AVX512 1
+#endif
+
+namespace Nessi
+{
+  /**
+   * \defgroup nessi_simd Nessi::SimdLevel
+   * \{
+   *
+   * The vectorized kernels of the library are compiled for several
+   * instruction sets. The widest instruction set supported by the host is
+   * selected at runtime the first time a kernel is called, so that the
+   * same installed library runs on every processor generation.
+   */
+
+  /**
+   * This enum lists the instruction sets the vectorized kernels are
+   * compiled for. The order of the entries is significant: a larger value
+   * is a wider instruction set.
+   */
+  enum SimdLevel
+    {
+      SIMD_NONE = 0,  ///< plain scalar loops
+      SIMD_SSE2 = 1,  ///< 128-bit SSE2 kernels
+      SIMD_AVX2 = 2,  ///< 256-bit AVX2 kernels
+      SIMD_AVX512 = 3 ///< 512-bit AVX-512F kernels
+    };
+
+  /**
+   * This is a PRIVATE helper that detects the widest instruction set
+   * supported by both the host and the compiler.
+   */
+  inline SimdLevel __detect_simd_level()
+  {
+#ifdef NESSI_HAVE_X86_SIMD
+    __builtin_cpu_init();
+#ifdef NESSI_HAVE_AVX512
+    if (__builtin_cpu_supports("avx512f"))
+      {
+        return SIMD_AVX512;
+      }
+#endif
+    if (__builtin_cpu_supports("avx2"))
+      {
+        return SIMD_AVX2;
+      }
+    if (__builtin_cpu_supports("sse2"))
+      {
+        return SIMD_SSE2;
+      }
+#endif
+    return SIMD_NONE;
+  }
+
+  /**
+   * This is a PRIVATE helper holding the detected instruction set and the
+   * currently selected one.
+   */
+  inline SimdLevel & __simd_level_storage(const bool detected)
+  {
+    static SimdLevel host = __detect_simd_level();
+    static SimdLevel current = host;
+    if (detected)
+      {
+        return host;
+      }
+    return current;
+  }
+
+  /**
+   * \brief This function returns the instruction set used by the
+   * vectorized kernels.
+   *
+   * \return The selected instruction set
+   */
+  inline SimdLevel simd_level()
+  {
+    return __simd_level_storage(false);
+  }
+
+  /**
+   * \brief This function restricts the instruction set used by the
+   * vectorized kernels.
+   *
+   * The selection is capped at what the host supports. Setting
+   * Nessi::SIMD_NONE forces the plain scalar loops, which is useful for
+   * comparing results.
+   *
+   * \param level (INPUT) is the widest instruction set to use
+   *
+   * \return The instruction set actually selected
+   */
+  inline SimdLevel set_simd_level(const SimdLevel level)
+  {
+    SimdLevel host = __simd_level_storage(true);
+    __simd_level_storage(false) = (level < host) ? level : host;
+    return __simd_level_storage(false);
+  }
+
+  /**
+   * \}
+   */ // end of nessi_simd group
+
+} // Nessi
+
+#endif // _NESSI_SIMD_HPP
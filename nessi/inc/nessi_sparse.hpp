@@ -0,0 +1,406 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+
+/**
+ * $Id$
+ *
+ * \file nessi/inc/nessi_sparse.hpp
+ */
+
+#ifndef _NESSI_SPARSE_HPP
+#define _NESSI_SPARSE_HPP 1
+
+#include "nessi.hpp"
+#include <cstddef>
+#include <stdexcept>
+#if __cplusplus >= 201103L
+#include <unordered_map>
+#else
+#include <map>
+#endif
+
+namespace Nessi
+{
+  /**
+   * \defgroup nessi_sparse Nessi::SparseHistogram4D
+   * \{
+   *
+   * A Nessi::SparseHistogram4D holds a four-dimensional histogram of
+   * which only a small part is occupied, like the
+   * \f$(Q_x, Q_y, Q_z, E)\f$ histogram of a single crystal. The bins are
+   * grouped in bricks of \f$b^4\f$ bins and a brick is only created when
+   * one of its bins is first written. The bricks are found through a hash
+   * table (an ordered map before C++11), so the memory grows with the
+   * occupied region instead of the size of the grid.
+   *
+   * Bin \f$(i, j, k, l)\f$ has the same meaning as element
+   * \f$((i \times n_2 + j) \times n_3 + k) \times n_4 + l\f$ of a dense
+   * histogram, which to_dense() produces for grids small enough to fit in
+   * memory.
+   */
+
+  /**
+   * \brief Four-dimensional histogram storing only its occupied bricks
+   */
+  template <typename T>
+  class SparseHistogram4D
+  {
+  public:
+    /// Default number of bins along every side of a brick
+    static const std::size_t DEFAULT_BRICK_SIZE = 8;
+
+    /**
+     * \brief Constructor for an empty histogram without bins
+     */
+    SparseHistogram4D()
+      : brick_size_(DEFAULT_BRICK_SIZE), brick_volume_(0)
+    {
+      this->set_shape(0, 0, 0, 0);
+    }
+
+    /**
+     * \brief Constructor for an empty histogram of the given shape
+     *
+     * \param num_bins_1 is the number of bins along the 1st axis
+     * \param num_bins_2 is the number of bins along the 2nd axis
+     * \param num_bins_3 is the number of bins along the 3rd axis
+     * \param num_bins_4 is the number of bins along the 4th axis
+     * \param brick_size is the number of bins along every side of a brick
+     *
+     * \exception std::invalid_argument is thrown if the brick size is zero
+     */
+    SparseHistogram4D(const std::size_t num_bins_1,
+                      const std::size_t num_bins_2,
+                      const std::size_t num_bins_3,
+                      const std::size_t num_bins_4,
+                      const std::size_t brick_size=DEFAULT_BRICK_SIZE)
+      : brick_size_(brick_size), brick_volume_(0)
+    {
+      if (brick_size == 0)
+        {
+          throw std::invalid_argument("Nessi::SparseHistogram4D: brick "
+                                      "size of zero");
+        }
+      this->set_shape(num_bins_1, num_bins_2, num_bins_3, num_bins_4);
+    }
+
+    /**
+     * \brief Returns the number of bins along axis \p axis (0 to 3)
+     */
+    std::size_t num_bins(const std::size_t axis) const
+    {
+      return num_bins_[axis];
+    }
+
+    /**
+     * \brief Returns the number of bins of the whole grid
+     */
+    std::size_t size() const
+    {
+      return num_bins_[0] * num_bins_[1] * num_bins_[2] * num_bins_[3];
+    }
+
+    /**
+     * \brief Returns the number of bins along every side of a brick
+     */
+    std::size_t brick_size() const
+    {
+      return brick_size_;
+    }
+
+    /**
+     * \brief Returns the number of bricks created so far
+     */
+    std::size_t num_bricks() const
+    {
+      return key_.size();
+    }
+
+    /**
+     * \brief Returns true if \p other has the same number of bins along
+     * every axis. The brick sizes may differ.
+     */
+    template <typename U>
+    bool same_shape(const SparseHistogram4D<U> & other) const
+    {
+      return num_bins_[0] == other.num_bins(0)
+        && num_bins_[1] == other.num_bins(1)
+        && num_bins_[2] == other.num_bins(2)
+        && num_bins_[3] == other.num_bins(3);
+    }
+
+    /**
+     * \brief Removes all bricks, the shape is kept
+     */
+    void clear()
+    {
+      brick_of_key_.clear();
+      key_.clear();
+      value_.clear();
+      err2_.clear();
+      last_key_ = NO_BRICK;
+    }
+
+    /**
+     * \brief Adds to the value and the squared uncertainty of a bin
+     *
+     * The indices are not checked.
+     */
+    void add(const std::size_t i, const std::size_t j, const std::size_t k,
+             const std::size_t l, const T & value, const T & err2)
+    {
+      std::size_t key = this->brick_key(i, j, k, l);
+      if (key != last_key_)
+        {
+          last_brick_ = this->find_or_create_brick(key);
+          last_key_ = key;
+        }
+      std::size_t index = last_brick_ + this->brick_offset(i, j, k, l);
+      value_[index] += value;
+      err2_[index] += err2;
+    }
+
+    /**
+     * \brief Returns the value of a bin, zero if its brick does not exist
+     *
+     * The indices are not checked.
+     */
+    T value(const std::size_t i, const std::size_t j, const std::size_t k,
+            const std::size_t l) const
+    {
+      std::size_t brick = this->find_brick(this->brick_key(i, j, k, l));
+      return (brick == NO_BRICK) ? T()
+        : value_[brick + this->brick_offset(i, j, k, l)];
+    }
+
+    /**
+     * \brief Returns the squared uncertainty of a bin, zero if its brick
+     * does not exist
+     *
+     * The indices are not checked.
+     */
+    T err2(const std::size_t i, const std::size_t j, const std::size_t k,
+           const std::size_t l) const
+    {
+      std::size_t brick = this->find_brick(this->brick_key(i, j, k, l));
+      return (brick == NO_BRICK) ? T()
+        : err2_[brick + this->brick_offset(i, j, k, l)];
+    }
+
+    /**
+     * \brief Adds all bins of \p other to the histogram
+     *
+     * The bricks of \p other are visited in the order they were created,
+     * so the result does not depend on the hash table.
+     *
+     * \exception std::invalid_argument is thrown if the histograms do not
+     * have the same shape and brick size
+     */
+    void merge(const SparseHistogram4D & other)
+    {
+      if (!this->same_shape(other) || brick_size_ != other.brick_size_)
+        {
+          throw std::invalid_argument("Nessi::SparseHistogram4D: merged "
+                                      "histograms do not have the same "
+                                      "bricks");
+        }
+      for (std::size_t b = 0; b < other.key_.size(); ++b)
+        {
+          std::size_t brick = this->find_or_create_brick(other.key_[b]);
+          std::size_t other_brick = b * brick_volume_;
+          for (std::size_t e = 0; e < brick_volume_; ++e)
+            {
+              value_[brick + e] += other.value_[other_brick + e];
+              err2_[brick + e] += other.err2_[other_brick + e];
+            }
+        }
+    }
+
+    /**
+     * \brief Copies the histogram into dense arrays
+     *
+     * \param value is resized to size() and receives the values
+     * \param err2 is resized to size() and receives the squared
+     * uncertainties
+     */
+    void to_dense(Vector<T> & value, Vector<T> & err2) const
+    {
+      value.assign(this->size(), T());
+      err2.assign(this->size(), T());
+
+      for (std::size_t b = 0; b < key_.size(); ++b)
+        {
+          // the first bin of the brick
+          std::size_t key = key_[b];
+          std::size_t first[4];
+          for (int a = 3; a >= 0; --a)
+            {
+              first[a] = (key % num_bricks_[a]) * brick_size_;
+              key /= num_bricks_[a];
+            }
+
+          std::size_t e = b * brick_volume_;
+          for (std::size_t i = 0; i < brick_size_; ++i)
+            {
+              for (std::size_t j = 0; j < brick_size_; ++j)
+                {
+                  for (std::size_t k = 0; k < brick_size_; ++k)
+                    {
+                      for (std::size_t l = 0; l < brick_size_; ++l, ++e)
+                        {
+                          std::size_t bi = first[0] + i;
+                          std::size_t bj = first[1] + j;
+                          std::size_t bk = first[2] + k;
+                          std::size_t bl = first[3] + l;
+                          if (bi >= num_bins_[0] || bj >= num_bins_[1]
+                              || bk >= num_bins_[2] || bl >= num_bins_[3])
+                            {
+                              continue;
+                            }
+                          std::size_t index = ((bi * num_bins_[1] + bj)
+                                               * num_bins_[2] + bk)
+                            * num_bins_[3] + bl;
+                          value[index] = value_[e];
+                          err2[index] = err2_[e];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+  private:
+#if __cplusplus >= 201103L
+    /// Table from the key of a brick to its first element
+    typedef std::unordered_map<std::size_t, std::size_t> BrickMap;
+#else
+    /// Table from the key of a brick to its first element
+    typedef std::map<std::size_t, std::size_t> BrickMap;
+#endif
+
+    /// Marks a brick that does not exist
+    static const std::size_t NO_BRICK = static_cast<std::size_t>(-1);
+
+    /**
+     * This is a PRIVATE helper setting the shape and removing all bricks.
+     * The brick size must be set.
+     */
+    void set_shape(const std::size_t num_bins_1,
+                   const std::size_t num_bins_2,
+                   const std::size_t num_bins_3,
+                   const std::size_t num_bins_4)
+    {
+      num_bins_[0] = num_bins_1;
+      num_bins_[1] = num_bins_2;
+      num_bins_[2] = num_bins_3;
+      num_bins_[3] = num_bins_4;
+      brick_volume_ = brick_size_ * brick_size_ * brick_size_ * brick_size_;
+      for (int a = 0; a < 4; ++a)
+        {
+          num_bricks_[a] = (num_bins_[a] + brick_size_ - 1) / brick_size_;
+        }
+      this->clear();
+    }
+
+    /**
+     * This is a PRIVATE helper returning the key of the brick of a bin.
+     */
+    std::size_t brick_key(const std::size_t i, const std::size_t j,
+                          const std::size_t k, const std::size_t l) const
+    {
+      return ((i / brick_size_ * num_bricks_[1] + j / brick_size_)
+              * num_bricks_[2] + k / brick_size_) * num_bricks_[3]
+        + l / brick_size_;
+    }
+
+    /**
+     * This is a PRIVATE helper returning the position of a bin in its
+     * brick.
+     */
+    std::size_t brick_offset(const std::size_t i, const std::size_t j,
+                             const std::size_t k, const std::size_t l) const
+    {
+      return ((i % brick_size_ * brick_size_ + j % brick_size_)
+              * brick_size_ + k % brick_size_) * brick_size_
+        + l % brick_size_;
+    }
+
+    /**
+     * This is a PRIVATE helper returning the first element of a brick, or
+     * NO_BRICK.
+     */
+    std::size_t find_brick(const std::size_t key) const
+    {
+      typename BrickMap::const_iterator it = brick_of_key_.find(key);
+      return (it == brick_of_key_.end()) ? NO_BRICK : it->second;
+    }
+
+    /**
+     * This is a PRIVATE helper returning the first element of a brick,
+     * creating a zero filled brick if needed.
+     */
+    std::size_t find_or_create_brick(const std::size_t key)
+    {
+      std::size_t brick = this->find_brick(key);
+      if (brick == NO_BRICK)
+        {
+          brick = value_.size();
+          brick_of_key_[key] = brick;
+          key_.push_back(key);
+          value_.resize(brick + brick_volume_, T());
+          err2_.resize(brick + brick_volume_, T());
+        }
+      return brick;
+    }
+
+    /// Number of bins along every axis
+    std::size_t num_bins_[4];
+    /// Number of bricks along every axis
+    std::size_t num_bricks_[4];
+    /// Number of bins along every side of a brick
+    std::size_t brick_size_;
+    /// Number of bins of a brick
+    std::size_t brick_volume_;
+    /// Table from the key of a brick to its first element
+    BrickMap brick_of_key_;
+    /// Key of every brick, in the order of creation
+    Vector<std::size_t> key_;
+    /// Values of all bricks
+    Vector<T> value_;
+    /// Squared uncertainties of all bricks
+    Vector<T> err2_;
+    /// Key of the brick last written by add()
+    std::size_t last_key_;
+    /// First element of the brick last written by add()
+    std::size_t last_brick_;
+  };
+
+  /**
+   * \}
+   */ // end of nessi_sparse group
+
+} // Nessi
+
+#endif // _NESSI_SPARSE_HPP
@@ -0,0 +1,250 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file nessi/inc/nessi_view.hpp
+ */
+
+#ifndef _NESSI_VIEW_HPP
+#define _NESSI_VIEW_HPP 1
+
+#include "nessi.hpp"
+#include <cstddef>
+#include <stdexcept>
+
+namespace Nessi
+{
+  /**
+   * \defgroup nessi_view Nessi::VectorView
+   * \{
+   *
+   * A Nessi::VectorView refers to elements that are stored elsewhere,
+   * usually in a Nessi::Vector or in a Nessi::SpectrumBlock. It is made of
+   * a pointer to the first element, the number of elements and the
+   * distance in elements between two consecutive elements. A view never
+   * owns, allocates or releases memory, so it is cheap to copy and must
+   * not outlive the storage it refers to.
+   *
+   * A view with a stride of one refers to a slice of an array. A view with
+   * a larger stride refers, for instance, to a column of a 2D array stored
+   * row by row, or to the same bin in every spectrum of a
+   * Nessi::SpectrumBlock. The library functions that accept views process
+   * such rows and columns in place, without copying them into a temporary
+   * Nessi::Vector first.
+   *
+   * Read-only arguments are passed as views of <tt>const</tt> elements,
+   * for instance <tt>Nessi::VectorView<const double></tt>, and results as
+   * views of modifiable elements. A view of modifiable elements converts
+   * to a view of <tt>const</tt> elements, but not the other way around.
+   */
+
+  /**
+   * \brief Non-owning, strided view on the elements of an array
+   */
+  template <typename T>
+  class VectorView
+  {
+  public:
+    /// Type of the elements, including the <tt>const</tt> qualifier
+    typedef T value_type;
+    /// Type for the number of elements
+    typedef std::size_t size_type;
+
+    /**
+     * \brief Constructor for an empty view
+     */
+    VectorView()
+      : data_(0), size_(0), stride_(1)
+    { }
+
+    /**
+     * \brief Constructor for a view on raw memory
+     *
+     * \param data is the address of the first element
+     * \param size is the number of elements
+     * \param stride is the distance in elements between two consecutive
+     * elements
+     */
+    VectorView(T * data, const size_type size, const size_type stride = 1)
+      : data_(data), size_(size), stride_(stride)
+    { }
+
+    /**
+     * \brief Constructor for a view on all elements of a vector
+     */
+    template <typename U>
+    VectorView(Vector<U> & v)
+      : data_(v.empty() ? 0 : &v[0]), size_(v.size()), stride_(1)
+    { }
+
+    /**
+     * \brief Constructor for a view on all elements of a vector
+     */
+    template <typename U>
+    VectorView(const Vector<U> & v)
+      : data_(v.empty() ? 0 : &v[0]), size_(v.size()), stride_(1)
+    { }
+
+    /**
+     * \brief Constructor for a view on some elements of a vector
+     *
+     * \param v is the vector holding the elements
+     * \param start is the index in \p v of the first element of the view
+     * \param size is the number of elements
+     * \param stride is the distance in elements between two consecutive
+     * elements
+     *
+     * \exception std::invalid_argument is thrown if the view does not fit
+     * in the vector or if the stride is zero.
+     */
+    template <typename U>
+    VectorView(Vector<U> & v, const size_type start, const size_type size,
+               const size_type stride = 1)
+      : data_(0), size_(size), stride_(stride)
+    {
+      check_range(v.size(), start, size, stride);
+      if (size > 0)
+        {
+          data_ = &v[start];
+        }
+    }
+
+    /**
+     * \brief Constructor for a view on some elements of a vector
+     *
+     * \param v is the vector holding the elements
+     * \param start is the index in \p v of the first element of the view
+     * \param size is the number of elements
+     * \param stride is the distance in elements between two consecutive
+     * elements
+     *
+     * \exception std::invalid_argument is thrown if the view does not fit
+     * in the vector or if the stride is zero.
+     */
+    template <typename U>
+    VectorView(const Vector<U> & v, const size_type start,
+               const size_type size, const size_type stride = 1)
+      : data_(0), size_(size), stride_(stride)
+    {
+      check_range(v.size(), start, size, stride);
+      if (size > 0)
+        {
+          data_ = &v[start];
+        }
+    }
+
+    /**
+     * \brief Conversion from a view on modifiable elements to a view on
+     * <tt>const</tt> elements
+     */
+    template <typename U>
+    VectorView(const VectorView<U> & other)
+      : data_(other.data()), size_(other.size()), stride_(other.stride())
+    { }
+
+    /**
+     * \brief Returns the number of elements
+     */
+    size_type size() const
+    {
+      return size_;
+    }
+
+    /**
+     * \brief Returns true if the view has no element
+     */
+    bool empty() const
+    {
+      return size_ == 0;
+    }
+
+    /**
+     * \brief Returns the distance in elements between two consecutive
+     * elements
+     */
+    size_type stride() const
+    {
+      return stride_;
+    }
+
+    /**
+     * \brief Returns true if the elements are consecutive in memory
+     */
+    bool is_contiguous() const
+    {
+      return stride_ == 1;
+    }
+
+    /**
+     * \brief Returns the address of the first element
+     */
+    T * data() const
+    {
+      return data_;
+    }
+
+    /**
+     * \brief Returns element \p i. The index is not checked.
+     */
+    T & operator[](const size_type i) const
+    {
+      return data_[i * stride_];
+    }
+
+  private:
+    /**
+     * This is a PRIVATE helper checking that a view fits in a vector.
+     */
+    static void check_range(const size_type vsize, const size_type start,
+                            const size_type size, const size_type stride)
+    {
+      if (stride == 0)
+        {
+          throw std::invalid_argument("Nessi::VectorView: stride of zero");
+        }
+      if (size > 0 && (start >= vsize
+                       || (size - 1) > (vsize - 1 - start) / stride))
+        {
+          throw std::invalid_argument("Nessi::VectorView: view does not fit "
+                                      "in the vector");
+        }
+    }
+
+    /// Address of the first element
+    T * data_;
+    /// Number of elements
+    size_type size_;
+    /// Distance between two consecutive elements
+    size_type stride_;
+  };
+
+  /**
+   * \}
+   */ // end of nessi_view group
+
+} // Nessi
+
+#endif // _NESSI_VIEW_HPP
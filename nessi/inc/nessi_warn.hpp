@@ -40,6 +40,129 @@ namespace Nessi
    */
   static const std::string EMPTY_WARN("");
 
+  /**
+   * \defgroup nessi_warn_sink Nessi::WarningSink
+   * \{
+   *
+   * The element-wise helpers of the library report their warnings into a
+   * sink instead of returning a string for every element. A
+   * Nessi::WarningSink keeps the text of the warnings, and the public
+   * functions turn it into the warning string they return with
+   * Nessi::WarningSink::str(), once per call.
+   *
+   * Nessi::NoWarnings has the same interface and does nothing, so a loop
+   * instantiated with it carries no warning bookkeeping at all. The
+   * library uses Nessi::DefaultWarningSink, which is Nessi::NoWarnings
+   * when NESSI_NO_WARNINGS is defined at compile time and
+   * Nessi::WarningSink otherwise.
+   */
+
+  /**
+   * \brief Collects the warnings of one function call
+   */
+  class WarningSink
+  {
+  public:
+    /**
+     * \brief Keeps the text of a warning returned as a string. An empty
+     * string is not a warning and is ignored.
+     */
+    void report(const std::string & warn)
+    {
+      if (!warn.empty())
+        {
+          text_ += warn;
+        }
+    }
+
+    /**
+     * \brief Adds the warnings of \p other to this sink
+     */
+    void merge(const WarningSink & other)
+    {
+      text_ += other.text_;
+    }
+
+    /**
+     * \brief Returns true if nothing was reported
+     */
+    bool empty() const
+    {
+      return text_.empty();
+    }
+
+    /**
+     * \brief Forgets all reported warnings
+     */
+    void clear()
+    {
+      text_.clear();
+    }
+
+    /**
+     * \brief Returns the warning string of the public functions, the text
+     * of the warnings in the order they were reported. A sink without
+     * warnings returns Nessi::EMPTY_WARN.
+     */
+    std::string str() const
+    {
+      return text_;
+    }
+
+  private:
+    /// Warnings reported as text
+    std::string text_;
+  };
+
+  /**
+   * \brief Sink that drops every warning
+   */
+  class NoWarnings
+  {
+  public:
+    /**
+     * \brief Drops the warning string
+     */
+    void report(const std::string &)
+    {
+    }
+
+    /**
+     * \brief Drops the warnings of \p other
+     */
+    void merge(const NoWarnings &)
+    {
+    }
+
+    /**
+     * \brief Returns true
+     */
+    bool empty() const
+    {
+      return true;
+    }
+
+    /**
+     * \brief Returns Nessi::EMPTY_WARN
+     */
+    std::string str() const
+    {
+      return EMPTY_WARN;
+    }
+  };
+
+#ifdef NESSI_NO_WARNINGS
+  /// The sink used by the public functions of the library
+  typedef NoWarnings DefaultWarningSink;
+#else
+  /// The sink used by the public functions of the library
+  typedef WarningSink DefaultWarningSink;
+#endif
+
+  /**
+   * \}
+   */ // end of nessi_warn_sink group
+
 } // Nessi
 
 #endif // _NESSI_WARN_HPP
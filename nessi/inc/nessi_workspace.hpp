@@ -0,0 +1,408 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file nessi/inc/nessi_workspace.hpp
+ */
+
+
+#ifndef _NESSI_WORKSPACE_HPP
+#define _NESSI_WORKSPACE_HPP 1
+
+#include "nessi.hpp"
+#include "nessi_alloc.hpp"
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace Nessi
+{
+  /**
+   * \defgroup nessi_workspace Nessi::Workspace
+   * \{
+   *
+   * Every library function takes a last argument <tt>void *temp</tt>. It
+   * is either NULL or the address of a Nessi::Workspace. A workspace is an
+   * arena of scratch memory that the functions use instead of allocating
+   * their temporary arrays on the heap. Keeping the same workspace across
+   * the calls of a reduction loop means that, once the workspace has grown
+   * to the largest amount of scratch memory needed by a call, the
+   * functions do no heap allocation at all.
+   *
+   * The memory is handed out in a stack-like manner: a function records
+   * the position of the workspace with mark(), carves its arrays with
+   * allocate() and gives them all back with release(). When a request
+   * does not fit in the current buffer it is served by a separate chunk of
+   * heap memory. The next time the workspace is completely released, the
+   * chunks are freed and the buffer is replaced by one large enough for
+   * everything that was in use at the same time.
+   *
+   * Nessi::Scratch wraps these steps for a single array and falls back to
+   * a private Nessi::Vector when no workspace is given. A workspace must
+   * not be shared by two threads at the same time.
+   *
+   * Anything else passed as <tt>temp</tt> is undefined behaviour. A
+   * workspace carries a tag that Nessi::Scratch checks with assert(), so
+   * a build without NDEBUG stops on such a pointer.
+   */
+
+  /**
+   * \brief Arena of scratch memory passed through the <tt>temp</tt>
+   * argument of the library functions
+   */
+  class Workspace
+  {
+  public:
+    /**
+     * \brief Position of a workspace returned by mark()
+     */
+    struct Marker
+    {
+      /// Number of bytes in use in the buffer
+      std::size_t used;
+      /// Number of overflow chunks in use
+      std::size_t chunks;
+    };
+
+    /// Value of the tag of a live workspace
+    static const unsigned int TAG = 0x4E575350;
+
+    /**
+     * \brief Constructor for an empty workspace. The buffer is created
+     * by the first allocation.
+     */
+    Workspace()
+      : tag_(TAG), buffer_(0), capacity_(0), used_(0), in_use_(0),
+        high_water_(0), heap_allocations_(0)
+    { }
+
+    /**
+     * \brief Constructor for a workspace with a buffer of \p bytes bytes
+     */
+    explicit Workspace(const std::size_t bytes)
+      : tag_(TAG), buffer_(0), capacity_(0), used_(0), in_use_(0),
+        high_water_(0), heap_allocations_(0)
+    {
+      this->grow(bytes);
+    }
+
+    /**
+     * \brief Destructor releasing all memory of the workspace
+     */
+    ~Workspace()
+    {
+      this->free_chunks(0);
+      Allocator<char>().deallocate(buffer_, capacity_);
+      tag_ = 0;
+    }
+
+    /**
+     * \brief Returns true if the object is a live workspace. It is only
+     * meant for debugging checks on the <tt>temp</tt> argument.
+     */
+    bool valid() const
+    {
+      return tag_ == TAG;
+    }
+
+    /**
+     * \brief Returns the current position of the workspace
+     */
+    Marker mark() const
+    {
+      Marker m;
+      m.used = used_;
+      m.chunks = chunks_.size();
+      return m;
+    }
+
+    /**
+     * \brief Gives back all memory allocated since \p m was taken
+     *
+     * The markers must be released in the reverse order they were taken.
+     */
+    void release(const Marker & m)
+    {
+      this->free_chunks(m.chunks);
+      used_ = m.used;
+      in_use_ = used_ + this->chunk_bytes();
+      if (used_ == 0 && chunks_.empty() && high_water_ > capacity_)
+        {
+          this->grow(high_water_);
+        }
+    }
+
+    /**
+     * \brief Gives back all memory of the workspace
+     */
+    void reset()
+    {
+      Marker m;
+      m.used = 0;
+      m.chunks = 0;
+      this->release(m);
+    }
+
+    /**
+     * \brief Returns uninitialized memory for \p n elements of type T
+     * aligned on Nessi::VECTOR_ALIGNMENT bytes
+     *
+     * \exception std::bad_alloc is thrown if the memory cannot be
+     * allocated
+     */
+    template <typename T>
+    T * allocate(const std::size_t n)
+    {
+      std::size_t bytes = round_up(n * sizeof(T));
+      in_use_ += bytes;
+      if (in_use_ > high_water_)
+        {
+          high_water_ = in_use_;
+        }
+      if (bytes == 0)
+        {
+          return 0;
+        }
+      if (used_ + bytes <= capacity_)
+        {
+          T * p = reinterpret_cast<T *>(buffer_ + used_);
+          used_ += bytes;
+          return p;
+        }
+
+      // the buffer is full, serve the request from a chunk
+      char * chunk = Allocator<char>().allocate(bytes);
+      ++heap_allocations_;
+      chunks_.push_back(chunk);
+      sizes_.push_back(bytes);
+      return reinterpret_cast<T *>(chunk);
+    }
+
+    /**
+     * \brief Returns the size in bytes of the buffer
+     */
+    std::size_t capacity() const
+    {
+      return capacity_;
+    }
+
+    /**
+     * \brief Returns the largest number of bytes that was in use at the
+     * same time
+     */
+    std::size_t high_water() const
+    {
+      return high_water_;
+    }
+
+    /**
+     * \brief Returns the number of heap allocations made by the workspace
+     * since it was created
+     */
+    std::size_t heap_allocations() const
+    {
+      return heap_allocations_;
+    }
+
+  private:
+    /// The workspace cannot be copied
+    Workspace(const Workspace &);
+    /// The workspace cannot be copied
+    Workspace & operator=(const Workspace &);
+
+    /**
+     * This is a PRIVATE helper rounding a number of bytes to a multiple of
+     * Nessi::VECTOR_ALIGNMENT.
+     */
+    static std::size_t round_up(const std::size_t bytes)
+    {
+      return (bytes + VECTOR_ALIGNMENT - 1) / VECTOR_ALIGNMENT
+        * VECTOR_ALIGNMENT;
+    }
+
+    /**
+     * This is a PRIVATE helper replacing the buffer by one of at least
+     * \p bytes bytes. The buffer must not be in use.
+     */
+    void grow(const std::size_t bytes)
+    {
+      std::size_t new_capacity = round_up(bytes);
+      char * new_buffer = Allocator<char>().allocate(new_capacity);
+      if (new_capacity > 0)
+        {
+          ++heap_allocations_;
+        }
+      Allocator<char>().deallocate(buffer_, capacity_);
+      buffer_ = new_buffer;
+      capacity_ = new_capacity;
+    }
+
+    /**
+     * This is a PRIVATE helper freeing the overflow chunks after the first
+     * \p keep ones.
+     */
+    void free_chunks(const std::size_t keep)
+    {
+      while (chunks_.size() > keep)
+        {
+          Allocator<char>().deallocate(chunks_.back(), sizes_.back());
+          chunks_.pop_back();
+          sizes_.pop_back();
+        }
+    }
+
+    /**
+     * This is a PRIVATE helper returning the bytes held by the overflow
+     * chunks.
+     */
+    std::size_t chunk_bytes() const
+    {
+      std::size_t bytes = 0;
+      for (std::size_t i = 0; i < sizes_.size(); ++i)
+        {
+          bytes += sizes_[i];
+        }
+      return bytes;
+    }
+
+    /// TAG while the workspace is alive
+    unsigned int tag_;
+    /// Start of the buffer
+    char * buffer_;
+    /// Size in bytes of the buffer
+    std::size_t capacity_;
+    /// Number of bytes in use in the buffer
+    std::size_t used_;
+    /// Number of bytes in use in the buffer and the chunks
+    std::size_t in_use_;
+    /// Largest value taken by in_use_
+    std::size_t high_water_;
+    /// Number of heap allocations
+    std::size_t heap_allocations_;
+    /// Overflow chunks in use
+    std::vector<char *> chunks_;
+    /// Sizes in bytes of the overflow chunks
+    std::vector<std::size_t> sizes_;
+  };
+
+  /**
+   * \brief Scratch array carved from the workspace given through the
+   * <tt>temp</tt> argument of a library function
+   *
+   * If \p temp is NULL the array is a private Nessi::Vector instead. The
+   * initial values of the elements are unspecified. The memory is given back
+   * to the workspace when the object is destroyed, so scratch arrays must
+   * be destroyed in the reverse order they were created, which is always
+   * the case for local variables.
+   */
+  template <typename T>
+  class Scratch
+  {
+  public:
+    /**
+     * \brief Constructor for a scratch array of \p n elements
+     *
+     * \param temp is the <tt>temp</tt> argument of the library function,
+     * either NULL or the address of a Nessi::Workspace
+     * \param n is the number of elements
+     */
+    Scratch(void * temp, const std::size_t n)
+      : workspace_(static_cast<Workspace *>(temp)), data_(0), size_(n)
+    {
+      if (workspace_ != 0)
+        {
+          assert(workspace_->valid());
+          marker_ = workspace_->mark();
+          data_ = workspace_->allocate<T>(n);
+        }
+      else if (n > 0)
+        {
+          Vector<T> own(n, uninitialized);
+          own_.swap(own);
+          data_ = &own_[0];
+        }
+    }
+
+    /**
+     * \brief Destructor giving the memory back to the workspace
+     */
+    ~Scratch()
+    {
+      if (workspace_ != 0)
+        {
+          workspace_->release(marker_);
+        }
+    }
+
+    /**
+     * \brief Returns the address of the first element
+     */
+    T * data() const
+    {
+      return data_;
+    }
+
+    /**
+     * \brief Returns the number of elements
+     */
+    std::size_t size() const
+    {
+      return size_;
+    }
+
+    /**
+     * \brief Returns element \p i. The index is not checked.
+     */
+    T & operator[](const std::size_t i) const
+    {
+      return data_[i];
+    }
+
+  private:
+    /// The scratch array cannot be copied
+    Scratch(const Scratch &);
+    /// The scratch array cannot be copied
+    Scratch & operator=(const Scratch &);
+
+    /// Workspace the memory comes from, NULL if it is owned
+    Workspace * workspace_;
+    /// Position of the workspace before the allocation
+    Workspace::Marker marker_;
+    /// Address of the first element
+    T * data_;
+    /// Number of elements
+    std::size_t size_;
+    /// Memory of the array when there is no workspace
+    Vector<T> own_;
+  };
+
+  /**
+   * \}
+   */ // end of nessi_workspace group
+
+} // Nessi
+
+#endif // _NESSI_WORKSPACE_HPP
@@ -31,6 +31,7 @@
 #define _PHYS_CORR_HPP 1
 
 #include "nessi.hpp"
+#include "nessi_view.hpp"
 #include <string>
 
 /**
@@ -204,6 +205,43 @@ namespace PhysCorr
                    NumT & eff_err2,
                    void *temp=NULL);
 
+  /**
+   * \brief This function is described in section 3.66 applied to views
+   *
+   * This function is the same as the vector version, but the arrays are
+   * Nessi::VectorView objects, so a row or a column of a larger array can
+   * be processed in place. Views with unit stride are passed to the same
+   * kernel as the vector version, while strided views are gathered into
+   * contiguous buffers first.
+   *
+   * \param axis_bc (INPUT) is a view of the (usually) wavelength axis bin
+   * center values
+   * \param scale (INPUT) is the scale factor for the detector efficiency
+   * \param scale_err2 (INPUT) is the square uncertainty of the scale factor
+   * for the detector efficiency
+   * \param constant (INPUT) is the exponential constant for the detector
+   * efficiency
+   * \param eff (OUTPUT) is a view of the resulting detector efficiency
+   * \param eff_err2 (OUTPUT) is a view of the square uncertainty of the
+   * detector efficiency
+   *
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the views are not all
+   * the same size.
+   */
+  template <typename NumT>
+  std::string
+  exp_detector_eff(const Nessi::VectorView<const NumT> & axis_bc,
+                   const NumT scale,
+                   const NumT scale_err2,
+                   const NumT constant,
+                   const Nessi::VectorView<NumT> & eff,
+                   const Nessi::VectorView<NumT> & eff_err2,
+                   void *temp=NULL);
+
   /**
    * \}
    */ // end of exp_detector_eff group
@@ -92,4 +92,33 @@ namespace PhysCorr
                            double & eff_err2,
                            void *temp);
 
+  /**
+   * This is the float declaration of the function defined in 3.66 for views.
+   *
+   * \ingroup exp_detector_eff
+   */
+  template std::string
+  exp_detector_eff<float>(const Nessi::VectorView<const float> & axis_bc,
+                          const float scale,
+                          const float scale_err2,
+                          const float constant,
+                          const Nessi::VectorView<float> & eff,
+                          const Nessi::VectorView<float> & eff_err2,
+                          void *temp);
+
+  /**
+   * This is the double precision float declaration of the function defined
+   * in 3.66 for views.
+   *
+   * \ingroup exp_detector_eff
+   */
+  template std::string
+  exp_detector_eff<double>(const Nessi::VectorView<const double> & axis_bc,
+                           const double scale,
+                           const double scale_err2,
+                           const double constant,
+                           const Nessi::VectorView<double> & eff,
+                           const Nessi::VectorView<double> & eff_err2,
+                           void *temp);
+
 } // PhysCorr
@@ -34,7 +34,9 @@
 #include "nessi_warn.hpp"
 #include "physcorr.hpp"
 #include "size_checks.hpp"
-#include <cmath>
+#include "vector_math.hpp"
+#include <algorithm>
+#include <stdexcept>
 
 namespace PhysCorr
 {
@@ -61,13 +63,13 @@ namespace PhysCorr
 
     // do the calculation
     std::size_t axis_size = axis_bc.size();
-    for (std::size_t i = 0; i < axis_size; ++i)
+    if (axis_size > 0)
       {
-        retstr += __exp_detector_eff_dynamic(axis_bc[i], scale, scale_err2, 
-                                             constant, eff[i], eff_err2[i]);
-
+        retstr += __exp_detector_eff_dynamic(&axis_bc[0], scale, scale_err2,
+                                             constant, &eff[0], &eff_err2[0],
+                                             axis_size);
       }
-    
+
     return retstr;
   }
 
@@ -85,8 +87,70 @@ namespace PhysCorr
     std::string retstr(Nessi::EMPTY_WARN); // the warning string
 
     // do the calculation
-    retstr += __exp_detector_eff_dynamic(axis_bc, scale, scale_err2, constant,
-                                         eff, eff_err2);
+    retstr += __exp_detector_eff_dynamic(&axis_bc, scale, scale_err2,
+                                         constant, &eff, &eff_err2, 1);
+
+    return retstr;
+  }
+
+  /// Number of elements of strided views gathered at a time
+  const std::size_t __EDE_VIEW_CHUNK = 256;
+
+  // 3.66
+  template <typename NumT>
+  std::string
+  exp_detector_eff(const Nessi::VectorView<const NumT> & axis_bc,
+                   const NumT scale,
+                   const NumT scale_err2,
+                   const NumT constant,
+                   const Nessi::VectorView<NumT> & eff,
+                   const Nessi::VectorView<NumT> & eff_err2,
+                   void *temp=NULL)
+  {
+    // check that the views are of proper size
+    std::size_t size = axis_bc.size();
+    if (eff.size() != size || eff_err2.size() != size)
+      {
+        throw std::invalid_argument(ede_func_str+" (view): views not the "
+                                    +"same size");
+      }
+
+    std::string retstr(Nessi::EMPTY_WARN); // the warning string
+    if (size == 0)
+      {
+        return retstr;
+      }
+
+    // views with unit stride are converted in one call
+    if (axis_bc.is_contiguous() && eff.is_contiguous()
+        && eff_err2.is_contiguous())
+      {
+        retstr += __exp_detector_eff_dynamic(axis_bc.data(), scale,
+                                             scale_err2, constant,
+                                             eff.data(), eff_err2.data(),
+                                             size);
+        return retstr;
+      }
+
+    // strided views are gathered into contiguous buffers a chunk at a time
+    NumT in[__EDE_VIEW_CHUNK];
+    NumT out[__EDE_VIEW_CHUNK];
+    NumT out_err2[__EDE_VIEW_CHUNK];
+    for (std::size_t start = 0; start < size; start += __EDE_VIEW_CHUNK)
+      {
+        std::size_t num = std::min(__EDE_VIEW_CHUNK, size - start);
+        for (std::size_t i = 0; i < num; ++i)
+          {
+            in[i] = axis_bc[start + i];
+          }
+        retstr += __exp_detector_eff_dynamic(in, scale, scale_err2,
+                                             constant, out, out_err2, num);
+        for (std::size_t i = 0; i < num; ++i)
+          {
+            eff[start + i] = out[i];
+            eff_err2[start + i] = out_err2[i];
+          }
+      }
 
     return retstr;
   }
@@ -96,32 +160,43 @@ namespace PhysCorr
    *
    * This is a PRIVATE helper function for exp_detector_eff that
    * calculates the exponential detector efficiency and its uncertainty
+   * for an array of axis values. The exponentials of the whole array are
+   * taken in one call to Utils::__vec_exp().
    *
-   * \param axis_bc (INPUT) same parameter as in exp_detector_eff()
+   * \param axis_bc (INPUT) is the first of the axis values
    * \param scale (INPUT) same parameter as in exp_detector_eff()
    * \param scale_err2 (INPUT) same parameter as in exp_detector_eff()
    * \param constant (INPUT) same parameter as in exp_detector_eff() 
-   * \param eff (OUTPUT) same parameter as in exp_detector_eff()
-   * \param eff_err2 (OUTPUT) same parameter as in exp_detector_eff()
+   * \param eff (OUTPUT) is the first of the efficiencies
+   * \param eff_err2 (OUTPUT) is the first of the squares of the
+   * uncertainties in the efficiencies
+   * \param size (INPUT) is the number of axis values
    */
   template <typename NumT>
-  std::string __exp_detector_eff_dynamic(const NumT axis_bc,
+  std::string __exp_detector_eff_dynamic(const NumT * axis_bc,
                                          const NumT scale,
                                          const NumT scale_err2,
                                          const NumT constant,
-                                         NumT & eff,
-                                         NumT & eff_err2)
+                                         NumT * eff,
+                                         NumT * eff_err2,
+                                         const std::size_t size)
   {
-    // calculate the value
-    NumT expon1 = static_cast<NumT>(-1.0) * constant * axis_bc;
-
-    eff = scale * static_cast<NumT>(std::exp(static_cast<double>(expon1)));
+    // calculate the exponents of the value and of the uncertainty
+    for (std::size_t i = 0; i < size; ++i)
+      {
+        NumT expon1 = static_cast<NumT>(-1.0) * constant * axis_bc[i];
+        eff[i] = expon1;
+        eff_err2[i] = static_cast<NumT>(2.0) * expon1;
+      }
 
-    // calculate the uncertainty
-    NumT expon2 = static_cast<NumT>(2.0) * expon1;
+    Utils::__vec_exp(eff, eff, size);
+    Utils::__vec_exp(eff_err2, eff_err2, size);
 
-    eff_err2 = scale_err2 * 
-      static_cast<NumT>(std::exp(static_cast<double>(expon2)));
+    for (std::size_t i = 0; i < size; ++i)
+      {
+        eff[i] = scale * eff[i];
+        eff_err2[i] = scale_err2 * eff_err2[i];
+      }
 
     return Nessi::EMPTY_WARN;
   }
@@ -242,6 +242,26 @@ bool test_func(NumT key, string debug) // key forces correct test to happen
   PhysCorr::exp_detector_eff(axis_bc, scale, scale_err2, constant,
                              output_vv, output_vv_err2);
 
+  // the view version on every other element gives the vector result
+  Nessi::Vector<NumT>   output_view(2 * NUM_VAL);
+  Nessi::Vector<NumT>   output_view_err2(2 * NUM_VAL);
+  PhysCorr::exp_detector_eff(Nessi::VectorView<const NumT>(axis_bc), scale,
+                             scale_err2, constant,
+                             Nessi::VectorView<NumT>(output_view, 1,
+                                                     NUM_VAL, 2),
+                             Nessi::VectorView<NumT>(output_view_err2, 1,
+                                                     NUM_VAL, 2));
+  for (size_t i = 0; i < NUM_VAL; ++i)
+    {
+      if (output_view[2 * i + 1] != output_vv[i]
+          || output_view_err2[2 * i + 1] != output_vv_err2[i])
+        {
+          cout << "(" << type_string(output_vv) << ") FAILED....View output "
+               << "different from vector output" << endl;
+          return false;
+        }
+    }
+
   if(!debug.empty())
     {
       cout << endl;
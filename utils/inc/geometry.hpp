@@ -92,10 +92,91 @@ namespace Utils
                        NumT & area,
                        void *temp=NULL);
 
+  /**
+   * \brief This function calculates the area of a polygon given by
+   * pointers
+   *
+   * This function calculates the same area as calc_area_2D_polygon()
+   * without any check of the arguments. It is used by the functions that
+   * keep their coordinates in scratch memory. <b>NOTE: This is a private
+   * function and will not be exported.</b>
+   *
+   * \param x_coord (INPUT) is the x coordinates of the polygon, with the
+   * first and second points repeated at the end (size_poly + 2 elements)
+   * \param y_coord (INPUT) is the y coordinates of the polygon, with the
+   * first and second points repeated at the end (size_poly + 2 elements)
+   * \param size_poly (INPUT) is the number of points of the polygon
+   * \param signed_area (INPUT) is a flag to return the signed area
+   *
+   * \return The area of the polygon
+   */
+  template <typename NumT>
+  NumT
+  __calc_area_2D_polygon(const NumT * x_coord,
+                         const NumT * y_coord,
+                         const std::size_t size_poly,
+                         const bool signed_area);
+
   /**
    * \} // end of calc_area_2D_polygon
    */ 
 
+  /**
+   * \defgroup clip_quad_to_rectangle Utils::__clip_quad_to_rectangle
+   * \{
+   */
+
+  /// Maximum number of points of a quadrilateral clipped to a rectangle
+  const std::size_t CLIP_QUAD_MAX_POINTS = 8;
+
+  /**
+   * \brief This function clips a quadrilateral to an axis-aligned rectangle
+   *
+   * This function calculates the overlap of a convex quadrilateral and a
+   * rectangle whose edges are parallel to the axes. It gives the same
+   * polygon as convex_polygon_intersect(), but the quadrilateral is clipped
+   * against the four edges of the rectangle one after the other
+   * (Sutherland-Hodgman), so the function only uses fixed-size arrays and
+   * never allocates memory. The points of the overlap are in the order of
+   * the quadrilateral and the first two are repeated at the end, so the
+   * arrays can be passed to __calc_area_2D_polygon() directly. The points
+   * on an edge of the rectangle are inside and repeated points are
+   * dropped, so a quadrilateral that only touches the rectangle gives
+   * fewer than 3 points. <b>NOTE: This is a private function and will not
+   * be exported.</b>
+   *
+   * \param quad_x (INPUT) is the x coordinates of the 4 corners
+   * \param quad_y (INPUT) is the y coordinates of the 4 corners
+   * \param x_min (INPUT) is the lower x edge of the rectangle
+   * \param x_max (INPUT) is the upper x edge of the rectangle
+   * \param y_min (INPUT) is the lower y edge of the rectangle
+   * \param y_max (INPUT) is the upper y edge of the rectangle
+   * \param clip_x (OUTPUT) is the x coordinates of the overlap
+   * (CLIP_QUAD_MAX_POINTS + 2 elements)
+   * \param clip_y (OUTPUT) is the y coordinates of the overlap
+   * (CLIP_QUAD_MAX_POINTS + 2 elements)
+   *
+   * \return The number of points of the overlap
+   *
+   * \exception std::invalid_argument is thrown if the overlap has more
+   * than CLIP_QUAD_MAX_POINTS points, which only happens for a quadrilateral
+   * that is not convex
+   */
+  template <typename NumT>
+  std::size_t
+  __clip_quad_to_rectangle(const NumT * quad_x,
+                           const NumT * quad_y,
+                           const NumT x_min,
+                           const NumT x_max,
+                           const NumT y_min,
+                           const NumT y_max,
+                           NumT * clip_x,
+                           NumT * clip_y);
+
+  /**
+   * \} // end of clip_quad_to_rectangle
+   */
+
   /**
    * \defgroup convex_polygon_intersect Utils::convex_polygon_intersect
    * \{
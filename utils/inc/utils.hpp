@@ -31,6 +31,7 @@
 #define _UTILS_HPP 1
 
 #include "nessi.hpp"
+#include "nessi_view.hpp"
 #include <string>
 
 /**
@@ -45,6 +46,149 @@
  */
 namespace Utils
 {
+  /**
+   * \defgroup axis_descriptor Utils::AxisDescriptor
+   * \{
+   */
+
+  /**
+   * \brief Bin searches on a histogram axis in constant time for linear and
+   * logarithmic axes
+   *
+   * Most target axes are either linear, \f$x_i = x_0 + i \Delta x\f$, or
+   * logarithmic, \f$x_i = x_0 r^i\f$. On such axes the bin holding a value
+   * can be computed instead of searched. An AxisDescriptor detects the
+   * spacing of an axis when it is constructed, or is told it by the caller,
+   * and answers the searches of std::upper_bound() and std::lower_bound()
+   * on the edges:
+   * - AxisDescriptor::LINEAR and AxisDescriptor::LOGARITHMIC compute the
+   *   position of the value, then move to the neighbouring edges while the
+   *   stored edges disagree, since the edges of a real axis are rounded.
+   * - AxisDescriptor::IRREGULAR bisects the edges, or walks from a hint
+   *   given by the caller.
+   *
+   * The answers are those of the standard algorithms on the stored edges
+   * for any axis and any spacing, the spacing only decides how fast they
+   * are found. When the computed position is more than a few edges off,
+   * the search falls back to a bisection. An axis is detected as linear or
+   * logarithmic when every edge lies within a quarter of a bin of the
+   * straight line, respectively of the geometric sequence, through its
+   * first and last edges.
+   *
+   * The descriptor keeps a reference to the axis, which must not be
+   * changed or destroyed while the descriptor is in use.
+   */
+  template <typename NumT>
+  class AxisDescriptor
+  {
+  public:
+    /// The spacings of the edges
+    enum Spacing
+      {
+        /// No regular spacing, the edges are bisected
+        IRREGULAR,
+        /// Edges \f$x_0 + i \Delta x\f$
+        LINEAR,
+        /// Edges \f$x_0 r^i\f$ with \f$x_0 > 0\f$
+        LOGARITHMIC
+      };
+
+    /**
+     * \brief Constructor detecting the spacing of an axis
+     *
+     * \param axis (INPUT) is the axis, with edges in increasing order
+     */
+    explicit AxisDescriptor(const Nessi::Vector<NumT> & axis);
+
+    /**
+     * \brief Constructor for an axis of known spacing
+     *
+     * The edges are not read except for the first and the last one, so the
+     * construction takes constant time.
+     *
+     * \param axis (INPUT) is the axis, with edges in increasing order
+     * \param spacing (INPUT) is the spacing of the edges
+     *
+     * \exception std::invalid_argument is thrown if a linear or logarithmic
+     * axis has fewer than two edges or a last edge not greater than the
+     * first one, or if a logarithmic axis has a first edge that is not
+     * positive
+     */
+    AxisDescriptor(const Nessi::Vector<NumT> & axis, const Spacing spacing);
+
+    /**
+     * \brief Returns the spacing used for the searches
+     */
+    Spacing spacing() const;
+
+    /**
+     * \brief Returns the axis
+     */
+    const Nessi::Vector<NumT> & axis() const;
+
+    /**
+     * \brief Returns the index of the first edge greater than \p value
+     */
+    std::size_t upper_bound(const NumT value) const;
+
+    /**
+     * \brief Returns the index of the first edge greater than \p value
+     *
+     * The search of an irregular axis starts at \p hint, which is
+     * usually the result for the previous value of an increasing sequence.
+     */
+    std::size_t upper_bound(const NumT value, const std::size_t hint) const;
+
+    /**
+     * \brief Returns the index of the first edge not less than \p value
+     */
+    std::size_t lower_bound(const NumT value) const;
+
+    /**
+     * \brief Returns the index of the first edge not less than \p value
+     *
+     * The search of an irregular axis starts at \p hint, which is
+     * usually the result for the previous value of an increasing sequence.
+     */
+    std::size_t lower_bound(const NumT value, const std::size_t hint) const;
+
+    /**
+     * \brief Returns the bin holding \p value, as found by bisect_helper()
+     */
+    std::size_t find_bin(const NumT value) const;
+
+  private:
+    /// Sets the spacing and the parameters of the computed positions
+    void set_spacing(const Spacing spacing);
+
+    /// Returns true if every edge is close to the given spacing
+    bool has_spacing(const Spacing spacing) const;
+
+    /// Returns the computed position of the first edge greater than value
+    std::size_t guess(const NumT value) const;
+
+    /// Moves from edge \p p to the position of \p value
+    std::size_t seek(const NumT value, std::size_t p, const bool upper)
+      const;
+
+    /// Bisects the edges [first, last) for the position of \p value
+    std::size_t bisect(const std::size_t first, const std::size_t last,
+                       const NumT value, const bool upper) const;
+
+    /// The axis
+    const Nessi::Vector<NumT> * axis_;
+    /// The spacing used for the searches
+    Spacing spacing_;
+    /// First edge, or its logarithm, of a linear or logarithmic axis
+    NumT origin_;
+    /// Inverse of the bin width, or of the logarithm of the ratio
+    NumT inv_step_;
+  };
+
+  /**
+   * \} // end of axis_descriptor group
+   */
+
   /**
    * \defgroup bisect_helper Utils::bisect_helper
    * \{
@@ -79,10 +223,73 @@ namespace Utils
                 std::size_t & index,
                 void *temp=NULL);
 
+  /**
+   * \brief This function is currently not described in the document
+   *
+   * This is the version of bisect_helper() for an axis described by an
+   * AxisDescriptor. The index is the same, but it is computed in constant
+   * time when the axis is linear or logarithmic.
+   *
+   * \param axis (INPUT) is the descriptor of the axis to search
+   * \param value (INPUT) is the value to search axis for
+   * \param index (OUTPUT) is the corresponding index for the value
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   */
+  template <typename NumT>
+  std::string
+  bisect_helper(const AxisDescriptor<NumT> & axis,
+                const NumT value,
+                std::size_t & index,
+                void *temp=NULL);
+
   /**
    * \} // end of bisect_helper group
    */
 
+  /**
+   * \defgroup bisect_many Utils::bisect_many
+   * \{
+   */
+
+  /**
+   * \brief This function is currently not described in the document
+   *
+   * This function finds the bins of many values on the same axis. Every
+   * index is the one bisect_helper() returns for the value, including
+   * the values outside the axis range.
+   *
+   * The search depends on the order of the values. When they are sorted,
+   * or form a few sorted runs, every search starts from the result of the
+   * previous value and gallops along the axis, so the values are merged
+   * with the axis in \f$O(M \log(N/M))\f$ for \f$M\f$ values and
+   * \f$N\f$ edges, at most \f$O(N+M)\f$. Values in no particular order
+   * are bisected with a search free of data dependent branches, in vector
+   * registers on hosts with AVX-512F (see Nessi::simd_level()) and in
+   * interleaved groups otherwise.
+   *
+   * \param axis (INPUT) is an array of independent axis values to search
+   * \param queries (INPUT) is the values to search axis for
+   * \param indices (OUTPUT) is the corresponding index for every value
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the queries and the
+   * indices are not the same size
+   */
+  template <typename NumT>
+  std::string
+  bisect_many(const Nessi::Vector<NumT> & axis,
+              const Nessi::Vector<NumT> & queries,
+              Nessi::Vector<std::size_t> & indices,
+              void *temp=NULL);
+
+  /**
+   * \} // end of bisect_many group
+   */
+
   /**
    * \defgroup calc_bin_centers Utils::calc_bin_centers
    * \{
@@ -228,7 +435,7 @@ namespace Utils
    * array
    * \param jacobian (OUTPUT) is the calculated Jacobian for each set of 
    * vertex coordinates
-   * \param temp  holds temporary memory to be passed to the function
+   * \param temp holds temporary memory to be passed to the function
    *
    * \return A set of warnings generated by the function
    */
@@ -403,6 +610,46 @@ namespace Utils
                         NumT & intercept_err2,
                         void *temp=NULL);
 
+  /**
+   * \brief This function is described in section 3.43 applied to views
+   *
+   * This function is the same as the vector version, but the data arrays
+   * are Nessi::VectorView objects, so a row or a column of a larger array
+   * can be fitted without copying it.
+   *
+   * \param axis_in (INPUT) is an array of independent axis values
+   * \param input (INPUT) is a view of the values associated with the
+   * independent axis
+   * \param input_err2 (INPUT) is a view of the squares of the uncertainties
+   * associated with the values
+   * \param min_bin (INPUT) is the minimum axis bin for the fit range
+   * \param max_bin (INPUT) is the maximum axis bin for the fit range
+   * \param slope (OUTPUT) is the slope of the line from the fit
+   * \param slope_err2 (OUTPUT) is the square of the uncertainties associated
+   * with the slope
+   * \param intercept (OUTPUT) is the intercept of the line from the fit
+   * \param intercept_err2 (OUTPUT) is the square of the uncertainties
+   * associated with the intercept
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if input, input_err2 and
+   * axis_in are not the same size.
+   */
+  template <typename NumT>
+  std::string
+  fit_linear_background(const Nessi::Vector<NumT> & axis_in,
+                        const Nessi::VectorView<const NumT> & input,
+                        const Nessi::VectorView<const NumT> & input_err2,
+                        const std::size_t min_bin,
+                        const std::size_t max_bin,
+                        NumT & slope,
+                        NumT & slope_err2,
+                        NumT & intercept,
+                        NumT & intercept_err2,
+                        void *temp=NULL);
+
   /**
    * \}
    */ // end of fit_linear_background group
@@ -600,6 +847,51 @@ namespace Utils
                     NumT & output_err2,
                     void *temp=NULL);
 
+  /**
+   * \brief This function is documented in section 3.65 applied to views
+   *
+   * This function is the same as the vector version with an integration
+   * range, but the data arrays are Nessi::VectorView objects, so a row or
+   * a column of a larger array can be integrated without copying it. An
+   * infinite \p min_int or \p max_int selects the first or the last bin.
+   *
+   * \param input (INPUT) is a view of the histogram data to integrate
+   * \param input_err2 (INPUT) is a view of the square uncertainty associated
+   * with the data to integrate
+   * \param axis_in (INPUT) is the independent-axis associated with the data
+   * \param min_int (INPUT) is the minimum independent-axis value to
+   * integrate from
+   * \param max_int (INPUT) is the maximum independent-axis value to
+   * integrate to
+   * \param width (INPUT) is a flag to remove the bin width from the
+   * integrated values
+   * \param axis_bw_in (INPUT) is the bin widths that will be used to when
+   * the width option is used
+   * \param output (OUTPUT) is the value of the integration of the data
+   * \param output_err2 (OUTPUT) is the squared uncertainty of the data
+   * integration
+   * \param temp holds temporary memory to be passed to the function
+   *
+   * \return A set of warnings generated by the function
+   *
+   * \exception std::invalid_argument is thrown if the size of axis_in is
+   * not one more than the size of input and input_err2.
+   * \exception std::invalid_argument is thrown if width is set and
+   * axis_bw_in is not the size of input.
+   */
+  template <typename NumT>
+  std::string
+  integrate_1D_hist(const Nessi::VectorView<const NumT> & input,
+                    const Nessi::VectorView<const NumT> & input_err2,
+                    const Nessi::Vector<NumT> & axis_in,
+                    const NumT min_int,
+                    const NumT max_int,
+                    const bool width,
+                    const Nessi::Vector<NumT> & axis_bw_in,
+                    NumT & output,
+                    NumT & output_err2,
+                    void *temp=NULL);
+
   /**
    * \}
    */ // end of integrate_1D_hist group
@@ -645,6 +937,9 @@ namespace Utils
    * original axis and \f$x'[k+1]\f$ is the high bin boundary and \f$x'[k]\f$ 
    * is the low bin boundary from the transformed axis.
    *
+   * A bin of zero width in the transformed axis is counted in the
+   * returned warnings.
+   *
    * \param orig_axis (INPUT) is the original histogram axis associated with 
    * the data
    * \param transform_axis (INPUT) is the transformed histogram axis 
@@ -704,6 +999,8 @@ namespace Utils
    * original axis and \f$x'_{hi}\f$ is the high bin boundary and 
    * \f$x'_{lo}\f$ is the low bin boundary from the transformed axis.
    *
+   * A transformed bin of zero width is reported in the returned warnings.
+   *
    * \param orig_axis_lo (INPUT) is the low bin boundary of the original 
    * histogram axis associated with the data
    * \param orig_axis_hi (INPUT) is the high bin boundary of the original 
@@ -0,0 +1,91 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+
+/**
+ * $Id$
+ *
+ * \file utils/inc/vector_math.hpp
+ */
+#ifndef _VECTOR_MATH_HPP
+#define _VECTOR_MATH_HPP 1
+
+#include <cstddef>
+
+/**
+ * \defgroup vector_math Utils vector math
+ * \{
+ *
+ * These are PRIVATE functions applying \f$\sqrt{x}\f$, \f$e^x\f$,
+ * \f$\sin x\f$ and \f$\cos x\f$ to every element of an array. They are
+ * defined in vector_math.cpp and, like the ncerr kernels of ArrayManip,
+ * select an SSE2, AVX2 or AVX-512 version at runtime (see
+ * Nessi::simd_level()). Float arrays are computed in single precision
+ * with their own polynomials instead of being converted to double.
+ *
+ * Every version, including the scalar loop used without vector
+ * instructions and for the elements left over at the end of an array,
+ * performs the same operations in the same order, so the results do not
+ * depend on the instruction set or on the position of an element. The
+ * bounds below are the largest errors measured against the exact result:
+ * - \f$\sqrt{x}\f$ is correctly rounded.
+ * - \f$e^x\f$ is within 1 ulp for float and 2 ulp for double. Results
+ *   below \f$e^{-86.9}\f$ (float) or \f$e^{-708}\f$ (double), which are
+ *   close to the smallest normal number, are flushed to zero.
+ * - \f$\sin x\f$ and \f$\cos x\f$ are within 2 ulp for
+ *   \f$|x| \le 64\f$ (float) or \f$|x| \le 2^{20}\f$ (double). Larger or
+ *   non-finite arguments are handed to the standard library in double
+ *   precision.
+ *
+ * The input and the output may be the same array.
+ */
+
+namespace Utils
+{
+  void __vec_sqrt(const float * input, float * output,
+                  const std::size_t size);
+  void __vec_sqrt(const double * input, double * output,
+                  const std::size_t size);
+
+  void __vec_exp(const float * input, float * output,
+                 const std::size_t size);
+  void __vec_exp(const double * input, double * output,
+                 const std::size_t size);
+
+  void __vec_sin(const float * input, float * output,
+                 const std::size_t size);
+  void __vec_sin(const double * input, double * output,
+                 const std::size_t size);
+
+  void __vec_cos(const float * input, float * output,
+                 const std::size_t size);
+  void __vec_cos(const double * input, double * output,
+                 const std::size_t size);
+} // Utils
+
+/**
+ * \}
+ */ // end of vector_math group
+
+#endif // _VECTOR_MATH_HPP
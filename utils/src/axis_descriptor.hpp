@@ -0,0 +1,288 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+
+/**
+ * $Id$
+ *
+ * \file utils/src/axis_descriptor.hpp
+ */
+#ifndef _AXIS_DESCRIPTOR_HPP
+#define _AXIS_DESCRIPTOR_HPP 1
+
+#include "utils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace Utils
+{
+  /// String for holding the AxisDescriptor class name
+  const std::string ad_func_str = "Utils::AxisDescriptor";
+
+  /// Number of edges a search walks before it bisects
+  const std::size_t AXIS_SEARCH_MAX_STEPS = 8;
+
+  template <typename NumT>
+  AxisDescriptor<NumT>::AxisDescriptor(const Nessi::Vector<NumT> & axis)
+    : axis_(&axis), spacing_(IRREGULAR), origin_(0), inv_step_(0)
+  {
+    if (this->has_spacing(LINEAR))
+      {
+        this->set_spacing(LINEAR);
+      }
+    else if (this->has_spacing(LOGARITHMIC))
+      {
+        this->set_spacing(LOGARITHMIC);
+      }
+  }
+
+  template <typename NumT>
+  AxisDescriptor<NumT>::AxisDescriptor(const Nessi::Vector<NumT> & axis,
+                                       const Spacing spacing)
+    : axis_(&axis), spacing_(IRREGULAR), origin_(0), inv_step_(0)
+  {
+    if (spacing == IRREGULAR)
+      {
+        return;
+      }
+    if (axis.size() < 2 || !(axis[axis.size() - 1] > axis[0]))
+      {
+        throw std::invalid_argument(ad_func_str+": axis not increasing");
+      }
+    if (spacing == LOGARITHMIC && !(axis[0] > static_cast<NumT>(0)))
+      {
+        throw std::invalid_argument(ad_func_str+": logarithmic axis not "
+                                    +"positive");
+      }
+    this->set_spacing(spacing);
+  }
+
+  template <typename NumT>
+  typename AxisDescriptor<NumT>::Spacing
+  AxisDescriptor<NumT>::spacing() const
+  {
+    return spacing_;
+  }
+
+  template <typename NumT>
+  const Nessi::Vector<NumT> &
+  AxisDescriptor<NumT>::axis() const
+  {
+    return *axis_;
+  }
+
+  template <typename NumT>
+  void
+  AxisDescriptor<NumT>::set_spacing(const Spacing spacing)
+  {
+    const Nessi::Vector<NumT> & axis = *axis_;
+    NumT num_bins = static_cast<NumT>(axis.size() - 1);
+    NumT first = axis[0];
+    NumT last = axis[axis.size() - 1];
+    if (spacing == LOGARITHMIC)
+      {
+        first = std::log(first);
+        last = std::log(last);
+      }
+
+    spacing_ = spacing;
+    origin_ = first;
+    inv_step_ = num_bins / (last - first);
+  }
+
+  template <typename NumT>
+  bool
+  AxisDescriptor<NumT>::has_spacing(const Spacing spacing) const
+  {
+    const Nessi::Vector<NumT> & axis = *axis_;
+    std::size_t num_edges = axis.size();
+    if (num_edges < 2 || !(axis[num_edges - 1] > axis[0]))
+      {
+        return false;
+      }
+    if (spacing == LOGARITHMIC && !(axis[0] > static_cast<NumT>(0)))
+      {
+        return false;
+      }
+
+    NumT first = axis[0];
+    NumT last = axis[num_edges - 1];
+    if (spacing == LOGARITHMIC)
+      {
+        first = std::log(first);
+        last = std::log(last);
+      }
+    NumT step = (last - first) / static_cast<NumT>(num_edges - 1);
+    NumT tolerance = step / static_cast<NumT>(4);
+
+    // Every edge lies within a quarter of a bin of its computed position
+    for (std::size_t i = 1; i < num_edges - 1; ++i)
+      {
+        NumT edge = (spacing == LOGARITHMIC) ? std::log(axis[i]) : axis[i];
+        NumT expected = first + static_cast<NumT>(i) * step;
+        if (!(std::fabs(edge - expected) <= tolerance))
+          {
+            return false;
+          }
+      }
+    return true;
+  }
+
+  template <typename NumT>
+  std::size_t
+  AxisDescriptor<NumT>::guess(const NumT value) const
+  {
+    std::size_t num_edges = axis_->size();
+    NumT position;
+    if (spacing_ == LOGARITHMIC)
+      {
+        if (!(value > static_cast<NumT>(0)))
+          {
+            return 0;
+          }
+        position = (std::log(value) - origin_) * inv_step_;
+      }
+    else
+      {
+        position = (value - origin_) * inv_step_;
+      }
+
+    // The first edge greater than the value follows the bin of the value
+    if (!(position >= static_cast<NumT>(0)))
+      {
+        return 0;
+      }
+    if (!(position < static_cast<NumT>(num_edges - 1)))
+      {
+        return num_edges;
+      }
+    return static_cast<std::size_t>(position) + 1;
+  }
+
+  template <typename NumT>
+  std::size_t
+  AxisDescriptor<NumT>::bisect(const std::size_t first,
+                               const std::size_t last,
+                               const NumT value,
+                               const bool upper) const
+  {
+    typename Nessi::Vector<NumT>::const_iterator begin = axis_->begin();
+    if (upper)
+      {
+        return std::upper_bound(begin + first, begin + last, value) - begin;
+      }
+    return std::lower_bound(begin + first, begin + last, value) - begin;
+  }
+
+  template <typename NumT>
+  std::size_t
+  AxisDescriptor<NumT>::seek(const NumT value,
+                             std::size_t p,
+                             const bool upper) const
+  {
+    const Nessi::Vector<NumT> & axis = *axis_;
+    std::size_t num_edges = axis.size();
+    p = std::min(p, num_edges);
+
+    // Edge p comes before the position while it is not greater than the
+    // value for upper_bound, and while it is less than the value for
+    // lower_bound
+    std::size_t steps = 0;
+    while (p < num_edges && (upper ? !(value < axis[p]) : axis[p] < value))
+      {
+        if (++steps > AXIS_SEARCH_MAX_STEPS)
+          {
+            return this->bisect(p, num_edges, value, upper);
+          }
+        ++p;
+      }
+    steps = 0;
+    while (p > 0 && (upper ? value < axis[p - 1] : !(axis[p - 1] < value)))
+      {
+        if (++steps > AXIS_SEARCH_MAX_STEPS)
+          {
+            return this->bisect(0, p, value, upper);
+          }
+        --p;
+      }
+    return p;
+  }
+
+  template <typename NumT>
+  std::size_t
+  AxisDescriptor<NumT>::upper_bound(const NumT value) const
+  {
+    if (spacing_ == IRREGULAR)
+      {
+        return this->bisect(0, axis_->size(), value, true);
+      }
+    return this->seek(value, this->guess(value), true);
+  }
+
+  template <typename NumT>
+  std::size_t
+  AxisDescriptor<NumT>::upper_bound(const NumT value,
+                                    const std::size_t hint) const
+  {
+    if (spacing_ == IRREGULAR)
+      {
+        return this->seek(value, hint, true);
+      }
+    return this->seek(value, this->guess(value), true);
+  }
+
+  template <typename NumT>
+  std::size_t
+  AxisDescriptor<NumT>::lower_bound(const NumT value) const
+  {
+    if (spacing_ == IRREGULAR)
+      {
+        return this->bisect(0, axis_->size(), value, false);
+      }
+    return this->seek(value, this->guess(value), false);
+  }
+
+  template <typename NumT>
+  std::size_t
+  AxisDescriptor<NumT>::lower_bound(const NumT value,
+                                    const std::size_t hint) const
+  {
+    if (spacing_ == IRREGULAR)
+      {
+        return this->seek(value, hint, false);
+      }
+    return this->seek(value, this->guess(value), false);
+  }
+
+  template <typename NumT>
+  std::size_t
+  AxisDescriptor<NumT>::find_bin(const NumT value) const
+  {
+    return __fix_index2(this->upper_bound(value) - 1, axis_->size() - 1);
+  }
+
+} // Utils
+
+#endif // _AXIS_DESCRIPTOR_HPP
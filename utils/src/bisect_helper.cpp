@@ -56,4 +56,28 @@ namespace Utils
                        std::size_t & index,
                        void *temp);
 
+  /**
+   * This is the float declaration of the bisect_helper() function for an
+   * AxisDescriptor
+   *
+   * \ingroup bisect_helper
+   */
+  template std::string
+  bisect_helper<float>(const AxisDescriptor<float> & axis,
+                       float value,
+                       std::size_t & index,
+                       void *temp);
+
+  /**
+   * This is the double precision float declaration of the bisect_helper()
+   * function for an AxisDescriptor
+   *
+   * \ingroup bisect_helper
+   */
+  template std::string
+  bisect_helper<double>(const AxisDescriptor<double> & axis,
+                        double value,
+                        std::size_t & index,
+                        void *temp);
+
 } // Utils
@@ -56,6 +56,17 @@ namespace Utils
     return Nessi::EMPTY_WARN;
   }
 
+  template <typename NumT>
+  std::string
+  bisect_helper(const AxisDescriptor<NumT> & axis,
+                const NumT value,
+                std::size_t & index,
+                void *temp=NULL)
+  {
+    index = axis.find_bin(value);
+
+    return Nessi::EMPTY_WARN;
+  }
 
 } // Utils
 
@@ -0,0 +1,241 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+
+/**
+ * $Id$
+ *
+ * \file utils/src/bisect_many.cpp
+ */
+#include "bisect_many.hpp"
+#include "nessi_simd.hpp"
+#include <climits>
+
+#ifdef NESSI_HAVE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace Utils
+{
+  // explicit instantiations
+
+  /**
+   * This is the float declaration of the bisect_many() function
+   *
+   * \ingroup bisect_many
+   */
+  template std::string
+  bisect_many<float>(const Nessi::Vector<float> & axis,
+                     const Nessi::Vector<float> & queries,
+                     Nessi::Vector<std::size_t> & indices,
+                     void *temp);
+
+  /**
+   * This is the double precision float declaration of the bisect_many()
+   * function
+   *
+   * \ingroup bisect_many
+   */
+  template std::string
+  bisect_many<double>(const Nessi::Vector<double> & axis,
+                      const Nessi::Vector<double> & queries,
+                      Nessi::Vector<std::size_t> & indices,
+                      void *temp);
+
+  /**
+   * This is the float declaration of the __bisect_many() function
+   *
+   * \ingroup bisect_many
+   */
+  template void
+  __bisect_many<float>(const float * axis,
+                       const std::size_t num_edges,
+                       const float * queries,
+                       const std::size_t num_queries,
+                       std::size_t * indices);
+
+  /**
+   * This is the double precision float declaration of the __bisect_many()
+   * function
+   *
+   * \ingroup bisect_many
+   */
+  template void
+  __bisect_many<double>(const double * axis,
+                        const std::size_t num_edges,
+                        const double * queries,
+                        const std::size_t num_queries,
+                        std::size_t * indices);
+
+  // The vector searches store the indices of the lanes as std::size_t, so
+  // they are only built for x86-64. SSE2 has no gather, and the AVX2
+  // gathers were measured slower than the interleaved search of
+  // __branchless_upper_bounds(), so only AVX-512F has a version.
+#if defined(NESSI_HAVE_AVX512) && defined(__x86_64__)
+#define __BISECT_MANY_SIMD 1
+
+  // Some versions of the compiler give a false uninitialized variable
+  // warning in the AVX-512 intrinsics.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+  namespace __avx512
+  {
+    /**
+     * \ingroup bisect_many
+     *
+     * This is a PRIVATE helper function for __simd_upper_bounds() that
+     * searches sixteen floats at a time with AVX-512F.
+     */
+    std::size_t upper_bounds(const float * axis,
+                             const std::size_t num_edges,
+                             const float * values,
+                             const std::size_t num_values,
+                             std::size_t * bound)
+    {
+      const std::size_t width = 16;
+      const __m512i one = _mm512_set1_epi32(1);
+      unsigned int lanes[width];
+      std::size_t i = 0;
+      for ( ; i + width <= num_values; i += width)
+        {
+          __m512 value = _mm512_loadu_ps(values + i);
+          __m512i base = _mm512_setzero_si512();
+          std::size_t length = num_edges;
+          while (length > 1)
+            {
+              std::size_t half = length / 2;
+              __m512i step = _mm512_set1_epi32(static_cast<int>(half));
+              __m512 edge = _mm512_i32gather_ps(_mm512_add_epi32(base, step),
+                                                axis, 4);
+              __mmask16 below = _mm512_cmp_ps_mask(value, edge, _CMP_LT_OQ);
+              base = _mm512_mask_add_epi32(base,
+                                           static_cast<__mmask16>(~below),
+                                           base, step);
+              length -= half;
+            }
+          __m512 edge = _mm512_i32gather_ps(base, axis, 4);
+          __mmask16 below = _mm512_cmp_ps_mask(value, edge, _CMP_LT_OQ);
+          base = _mm512_mask_add_epi32(base, static_cast<__mmask16>(~below),
+                                       base, one);
+          _mm512_storeu_si512(lanes, base);
+          for (std::size_t l = 0; l < width; ++l)
+            {
+              bound[i + l] = lanes[l];
+            }
+        }
+      return i;
+    }
+
+    /**
+     * \ingroup bisect_many
+     *
+     * This is a PRIVATE helper function for __simd_upper_bounds() that
+     * searches eight doubles at a time with AVX-512F.
+     */
+    std::size_t upper_bounds(const double * axis,
+                             const std::size_t num_edges,
+                             const double * values,
+                             const std::size_t num_values,
+                             std::size_t * bound)
+    {
+      const std::size_t width = 8;
+      const __m512i one = _mm512_set1_epi64(1);
+      std::size_t i = 0;
+      for ( ; i + width <= num_values; i += width)
+        {
+          __m512d value = _mm512_loadu_pd(values + i);
+          __m512i base = _mm512_setzero_si512();
+          std::size_t length = num_edges;
+          while (length > 1)
+            {
+              std::size_t half = length / 2;
+              __m512i step = _mm512_set1_epi64(half);
+              __m512d edge = _mm512_i64gather_pd(_mm512_add_epi64(base, step),
+                                                 axis, 8);
+              __mmask8 below = _mm512_cmp_pd_mask(value, edge, _CMP_LT_OQ);
+              base = _mm512_mask_add_epi64(base,
+                                           static_cast<__mmask8>(~below),
+                                           base, step);
+              length -= half;
+            }
+          __m512d edge = _mm512_i64gather_pd(base, axis, 8);
+          __mmask8 below = _mm512_cmp_pd_mask(value, edge, _CMP_LT_OQ);
+          base = _mm512_mask_add_epi64(base, static_cast<__mmask8>(~below),
+                                       base, one);
+          _mm512_storeu_si512(bound + i, base);
+        }
+      return i;
+    }
+  } // __avx512
+#pragma GCC pop_options
+#pragma GCC diagnostic pop
+
+#endif // NESSI_HAVE_AVX512 && __x86_64__
+
+  /**
+   * This macro expands to the body of a __simd_upper_bounds() function. It
+   * calls the AVX-512F version when that instruction set is selected and
+   * searches no value otherwise.
+   */
+#ifdef __BISECT_MANY_SIMD
+#define __BISECT_MANY_DISPATCH(args)                    \
+  if (Nessi::simd_level() == Nessi::SIMD_AVX512)        \
+    {                                                   \
+      return __avx512::upper_bounds args;               \
+    }                                                   \
+  return 0;
+#else
+#define __BISECT_MANY_DISPATCH(args)            \
+  return 0;
+#endif
+
+  std::size_t
+  __simd_upper_bounds(const float * axis,
+                      const std::size_t num_edges,
+                      const float * values,
+                      const std::size_t num_values,
+                      std::size_t * bound)
+  {
+    // the float version gathers with 32-bit indices
+    if (num_edges > static_cast<std::size_t>(INT_MAX))
+      {
+        return 0;
+      }
+    __BISECT_MANY_DISPATCH((axis, num_edges, values, num_values, bound))
+  }
+
+  std::size_t
+  __simd_upper_bounds(const double * axis,
+                      const std::size_t num_edges,
+                      const double * values,
+                      const std::size_t num_values,
+                      std::size_t * bound)
+  {
+    __BISECT_MANY_DISPATCH((axis, num_edges, values, num_values, bound))
+  }
+
+} // Utils
@@ -0,0 +1,301 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+
+/**
+ * $Id$
+ *
+ * \file utils/src/bisect_many.hpp
+ */
+#ifndef _BISECT_MANY_HPP
+#define _BISECT_MANY_HPP 1
+
+#include "utils.hpp"
+#include "nessi_warn.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace Utils
+{
+  // String for holding bisect_many function name
+  const std::string bm_func_str = "Utils::bisect_many";
+
+  /// Number of queries bisected together by the unsorted search
+  const std::size_t BISECT_MANY_LANES = 8;
+
+  /// Shortest average run of increasing queries searched from a cursor
+  const std::size_t BISECT_MANY_MIN_RUN = 8;
+
+  /**
+   * \ingroup bisect_many
+   *
+   * This is a PRIVATE helper function for bisect_many that returns the
+   * index of the first edge greater than \p value, like std::upper_bound(),
+   * starting from the index \p hint. The search gallops away from the
+   * hint with doubling steps, then bisects the last step, so it costs the
+   * logarithm of the distance between the hint and the result.
+   *
+   * \param axis (INPUT) is the first edge of the axis
+   * \param num_edges (INPUT) is the number of edges
+   * \param value (INPUT) is the value to search the axis for
+   * \param hint (INPUT) is the index the search starts from
+   */
+  template <typename NumT>
+  std::size_t
+  __gallop_upper_bound(const NumT * axis,
+                       const std::size_t num_edges,
+                       const NumT value,
+                       std::size_t hint)
+  {
+    hint = std::min(hint, num_edges);
+    std::size_t step = 1;
+    std::size_t low;
+    std::size_t high;
+    if (hint < num_edges && !(value < axis[hint]))
+      {
+        // The result is after the hint
+        low = hint + 1;
+        while (low + step - 1 < num_edges && !(value < axis[low + step - 1]))
+          {
+            low += step;
+            step *= 2;
+          }
+        high = std::min(low + step - 1, num_edges);
+      }
+    else
+      {
+        // The result is at the hint or before it
+        high = hint;
+        while (high >= step && value < axis[high - step])
+          {
+            high -= step;
+            step *= 2;
+          }
+        low = (high >= step) ? high - step + 1 : 0;
+      }
+    return std::upper_bound(axis + low, axis + high, value) - axis;
+  }
+
+  /**
+   * \ingroup bisect_many
+   *
+   * This is a PRIVATE helper function for bisect_many that finds the
+   * results of std::upper_bound() for a group of BISECT_MANY_LANES values.
+   * All values halve the same length of the axis at every step, so the
+   * loop over the values has no branch and the loads of the different
+   * values overlap. The selections compile to conditional moves.
+   *
+   * \param axis (INPUT) is the first edge of the axis
+   * \param num_edges (INPUT) is the number of edges, at least one
+   * \param values (INPUT) is the group of values to search the axis for
+   * \param bound (OUTPUT) is the index of the first edge greater than every
+   * value
+   */
+  template <typename NumT>
+  void
+  __branchless_upper_bounds(const NumT * axis,
+                            const std::size_t num_edges,
+                            const NumT * values,
+                            std::size_t * bound)
+  {
+    std::size_t base[BISECT_MANY_LANES];
+    for (std::size_t l = 0; l < BISECT_MANY_LANES; ++l)
+      {
+        base[l] = 0;
+      }
+
+    std::size_t length = num_edges;
+    while (length > 1)
+      {
+        std::size_t half = length / 2;
+        for (std::size_t l = 0; l < BISECT_MANY_LANES; ++l)
+          {
+            base[l] += (values[l] < axis[base[l] + half]) ? 0 : half;
+          }
+        length -= half;
+      }
+
+    for (std::size_t l = 0; l < BISECT_MANY_LANES; ++l)
+      {
+        bound[l] = base[l] + ((values[l] < axis[base[l]]) ? 0 : 1);
+      }
+  }
+
+  /**
+   * \ingroup bisect_many
+   *
+   * This is a PRIVATE helper function for bisect_many that runs the search
+   * of __branchless_upper_bounds() in vector registers, one value per
+   * lane, with gathers loading the edges of all lanes at once. The float
+   * and double versions are defined in bisect_many.cpp and run when
+   * Nessi::simd_level() selects AVX-512F. The narrower instruction sets,
+   * which either have no gather or gather slower than the interleaved
+   * search, and the other types search no value here.
+   *
+   * \param axis (INPUT) is the first edge of the axis
+   * \param num_edges (INPUT) is the number of edges, at least one
+   * \param values (INPUT) is the first value to search the axis for
+   * \param num_values (INPUT) is the number of values
+   * \param bound (OUTPUT) is the index of the first edge greater than every
+   * value searched
+   *
+   * \return The number of values searched, a multiple of the register
+   * width. The remaining values are left to the caller.
+   */
+  template <typename NumT>
+  std::size_t
+  __simd_upper_bounds(const NumT * axis,
+                      const std::size_t num_edges,
+                      const NumT * values,
+                      const std::size_t num_values,
+                      std::size_t * bound)
+  {
+    return 0;
+  }
+
+  std::size_t
+  __simd_upper_bounds(const float * axis,
+                      const std::size_t num_edges,
+                      const float * values,
+                      const std::size_t num_values,
+                      std::size_t * bound);
+
+  std::size_t
+  __simd_upper_bounds(const double * axis,
+                      const std::size_t num_edges,
+                      const double * values,
+                      const std::size_t num_values,
+                      std::size_t * bound);
+
+  /**
+   * \ingroup bisect_many
+   *
+   * This is a PRIVATE helper function for bisect_many() that takes the
+   * arrays by their first element and size, so the callers searching a
+   * few values need not allocate vectors.
+   *
+   * \param axis (INPUT) is the first edge of the axis
+   * \param num_edges (INPUT) is the number of edges
+   * \param queries (INPUT) is the first value to search axis for
+   * \param num_queries (INPUT) is the number of values
+   * \param indices (OUTPUT) is the corresponding index for every value
+   */
+
+  template <typename NumT>
+  void
+  __bisect_many(const NumT * axis,
+                const std::size_t num_edges,
+                const NumT * queries,
+                const std::size_t num_queries,
+                std::size_t * indices)
+  {
+    if (num_queries == 0)
+      {
+        return;
+      }
+
+    // A NaN breaks a run, as it is not ordered with the other values
+    std::size_t num_runs = 1;
+    for (std::size_t i = 1; i < num_queries; ++i)
+      {
+        if (!(queries[i - 1] <= queries[i]))
+          {
+            ++num_runs;
+          }
+      }
+
+    if (num_edges == 0 || num_runs == 1
+        || num_runs * BISECT_MANY_MIN_RUN <= num_queries)
+      {
+        // Merge the sorted runs of queries with the axis
+        std::size_t bound = 0;
+        for (std::size_t i = 0; i < num_queries; ++i)
+          {
+            bound = __gallop_upper_bound(axis, num_edges, queries[i], bound);
+            indices[i] = __fix_index2(bound - 1, num_edges - 1);
+          }
+        return;
+      }
+
+    // Bisect the values in vector registers, then in groups of lanes
+    std::size_t i = __simd_upper_bounds(axis, num_edges, queries,
+                                        num_queries, indices);
+    for (std::size_t j = 0; j < i; ++j)
+      {
+        indices[j] = __fix_index2(indices[j] - 1, num_edges - 1);
+      }
+
+    std::size_t bound[BISECT_MANY_LANES];
+    for ( ; i + BISECT_MANY_LANES <= num_queries; i += BISECT_MANY_LANES)
+      {
+        __branchless_upper_bounds(axis, num_edges, queries + i, bound);
+        for (std::size_t l = 0; l < BISECT_MANY_LANES; ++l)
+          {
+            indices[i + l] = __fix_index2(bound[l] - 1, num_edges - 1);
+          }
+      }
+
+    // The last values are padded with copies of the final query
+    std::size_t rest = num_queries - i;
+    if (rest > 0)
+      {
+        NumT values[BISECT_MANY_LANES];
+        for (std::size_t l = 0; l < BISECT_MANY_LANES; ++l)
+          {
+            values[l] = queries[i + std::min(l, rest - 1)];
+          }
+        __branchless_upper_bounds(axis, num_edges, values, bound);
+        for (std::size_t l = 0; l < rest; ++l)
+          {
+            indices[i + l] = __fix_index2(bound[l] - 1, num_edges - 1);
+          }
+      }
+  }
+
+  template <typename NumT>
+  std::string
+  bisect_many(const Nessi::Vector<NumT> & axis,
+              const Nessi::Vector<NumT> & queries,
+              Nessi::Vector<std::size_t> & indices,
+              void *temp=NULL)
+  {
+    if (queries.size() != indices.size())
+      {
+        throw std::invalid_argument(bm_func_str+": queries and indices not "
+                                    +"the same size");
+      }
+    if (queries.empty())
+      {
+        return Nessi::EMPTY_WARN;
+      }
+
+    __bisect_many(axis.empty() ? static_cast<const NumT *>(0) : &axis[0],
+                  axis.size(), &queries[0], queries.size(), &indices[0]);
+
+    return Nessi::EMPTY_WARN;
+  }
+
+} // Utils
+
+#endif // _BISECT_MANY_HPP
@@ -62,4 +62,28 @@ namespace Utils
                        double & area,
                        void *temp);
 
+  /**
+   * This is the float declaration of the private pointer version of
+   * calc_area_2D_polygon
+   *
+   * \ingroup calc_area_2D_polygon
+   */
+  template float
+  __calc_area_2D_polygon(const float * x_coord,
+                         const float * y_coord,
+                         const std::size_t size_poly,
+                         const bool signed_area);
+
+  /**
+   * This is the double precision float declaration of the private pointer
+   * version of calc_area_2D_polygon
+   *
+   * \ingroup calc_area_2D_polygon
+   */
+  template double
+  __calc_area_2D_polygon(const double * x_coord,
+                         const double * y_coord,
+                         const std::size_t size_poly,
+                         const bool signed_area);
+
 } // Utils
@@ -75,7 +75,20 @@ namespace Utils
                                     "elements repeated at end of arrays.");
       }
 
-    area = static_cast<NumT>(0.0);
+    area = __calc_area_2D_polygon(&x_coord[0], &y_coord[0], size_poly,
+                                  signed_area);
+
+    return Nessi::EMPTY_WARN;
+  }
+
+  template <typename NumT>
+  NumT
+  __calc_area_2D_polygon(const NumT * x_coord,
+                         const NumT * y_coord,
+                         const std::size_t size_poly,
+                         const bool signed_area)
+  {
+    NumT area = static_cast<NumT>(0.0);
     
     for (std::size_t i = 1; i <= size_poly; ++i)
       {
@@ -89,7 +102,7 @@ namespace Utils
         area = static_cast<NumT>(std::abs(static_cast<double>(area)));
       }
 
-    return Nessi::EMPTY_WARN;
+    return area;
   }
 
 } // Utils
@@ -64,49 +64,38 @@ namespace Utils
     Utils::check_sizes_square(cejd_func_str+": q3 & q4", q3_axis, q4_axis);
     Utils::check_sizes_square(cejd_func_str+": e1 & jac", e1_axis, jacobian);
 
-    std::string retstr(Nessi::EMPTY_WARN);
-    std::string warn;
-        
     std::size_t size_e1 = e1_axis.size();
 
-    // Create holders and constants for intermediate information
-    Nessi::Vector<NumT> e_points;
-    Nessi::Vector<NumT> q_points;
-    NumT area;
-    static const int poly_size = 4;
+    // Create holders and constants for intermediate information. The
+    // vertex coordinates of one quadrilateral are kept on the stack with
+    // the first two vertices repeated at the end for the area calculation,
+    // like the overlaps of Utils::__clip_quad_to_rectangle.
+    static const std::size_t poly_size = 4;
+    NumT e_points[poly_size + 2];
+    NumT q_points[poly_size + 2];
 
     for(std::size_t i = 0; i < size_e1; ++i)
       {
         // Create vertex coordinate arrays for area calculation function
-        e_points.push_back(e1_axis[i]);
-        e_points.push_back(e2_axis[i]);
-        e_points.push_back(e3_axis[i]);
-        e_points.push_back(e4_axis[i]);
-        e_points.push_back(e1_axis[i]);
-        e_points.push_back(e2_axis[i]);
+        e_points[0] = e1_axis[i];
+        e_points[1] = e2_axis[i];
+        e_points[2] = e3_axis[i];
+        e_points[3] = e4_axis[i];
+        e_points[4] = e1_axis[i];
+        e_points[5] = e2_axis[i];
 
-        q_points.push_back(q1_axis[i]);
-        q_points.push_back(q2_axis[i]);
-        q_points.push_back(q3_axis[i]);
-        q_points.push_back(q4_axis[i]);
-        q_points.push_back(q1_axis[i]);
-        q_points.push_back(q2_axis[i]); 
+        q_points[0] = q1_axis[i];
+        q_points[1] = q2_axis[i];
+        q_points[2] = q3_axis[i];
+        q_points[3] = q4_axis[i];
+        q_points[4] = q1_axis[i];
+        q_points[5] = q2_axis[i];
 
-        warn += Utils::calc_area_2D_polygon(e_points, q_points, 
-                                            poly_size, false, area);
-
-        if (!warn.empty())
-          {
-            retstr += warn;
-          }
-
-        jacobian[i] = area;
-
-        e_points.clear();
-        q_points.clear();
+        jacobian[i] = Utils::__calc_area_2D_polygon(e_points, q_points,
+                                                    poly_size, false);
       }
 
-    return retstr;
+    return Nessi::EMPTY_WARN;
   }
 
 } // Utils
@@ -0,0 +1,69 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file utils/src/clip_quad_to_rectangle.cpp
+ */
+
+#include "clip_quad_to_rectangle.hpp"
+
+namespace Utils
+{
+  // explicit instantiations
+
+  /**
+   * This is the float declaration of the private __clip_quad_to_rectangle
+   * function
+   *
+   * \ingroup clip_quad_to_rectangle
+   */
+  template std::size_t
+  __clip_quad_to_rectangle(const float * quad_x,
+                           const float * quad_y,
+                           const float x_min,
+                           const float x_max,
+                           const float y_min,
+                           const float y_max,
+                           float * clip_x,
+                           float * clip_y);
+
+  /**
+   * This is the double precision float declaration of the private
+   * __clip_quad_to_rectangle function
+   *
+   * \ingroup clip_quad_to_rectangle
+   */
+  template std::size_t
+  __clip_quad_to_rectangle(const double * quad_x,
+                           const double * quad_y,
+                           const double x_min,
+                           const double x_max,
+                           const double y_min,
+                           const double y_max,
+                           double * clip_x,
+                           double * clip_y);
+
+} // Utils
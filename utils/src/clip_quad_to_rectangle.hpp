@@ -0,0 +1,205 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file utils/src/clip_quad_to_rectangle.hpp
+ */
+#ifndef _CLIP_QUAD_TO_RECTANGLE_HPP
+#define _CLIP_QUAD_TO_RECTANGLE_HPP 1
+
+#include "geometry.hpp"
+#include <stdexcept>
+
+namespace Utils
+{
+  /// String for holding the __clip_quad_to_rectangle function name
+  const std::string cqtr_func_str = "Utils::__clip_quad_to_rectangle";
+
+  /**
+   * \ingroup clip_quad_to_rectangle
+   *
+   * This is a PRIVATE helper function for __clip_polygon_to_edge that
+   * appends a point to the clipped polygon. A point equal to the last one
+   * is dropped, so a polygon touching the edge in a single point does not
+   * turn into several copies of that point.
+   *
+   * \param a (INPUT) is the coordinate compared to the edge
+   * \param b (INPUT) is the other coordinate
+   * \param out_a (OUTPUT) is the first coordinates of the clipped polygon
+   * \param out_b (OUTPUT) is the second coordinates of the clipped polygon
+   * \param size_out (INPUT/OUTPUT) is the number of points of the clipped
+   * polygon
+   * \param size_max (INPUT) is the number of elements of out_a and out_b
+   *
+   * \exception std::invalid_argument is thrown if the clipped polygon has
+   * more than size_max points
+   */
+  template <typename NumT>
+  void
+  __add_clip_point(const NumT a,
+                   const NumT b,
+                   NumT * out_a,
+                   NumT * out_b,
+                   std::size_t & size_out,
+                   const std::size_t size_max)
+  {
+    if (size_out > 0 && out_a[size_out - 1] == a && out_b[size_out - 1] == b)
+      {
+        return;
+      }
+    if (size_out == size_max)
+      {
+        throw std::invalid_argument(cqtr_func_str+": too many points, "
+                                    +"quadrilateral not convex");
+      }
+    out_a[size_out] = a;
+    out_b[size_out] = b;
+    ++size_out;
+  }
+
+  /**
+   * \ingroup clip_quad_to_rectangle
+   *
+   * This is a PRIVATE helper function for __clip_quad_to_rectangle that
+   * clips a polygon against one edge of the rectangle. The points of the
+   * polygon that are on the kept side of the edge are copied, and a point
+   * is added where the polygon crosses the edge.
+   *
+   * \param in_x (INPUT) is the x coordinates of the polygon
+   * \param in_y (INPUT) is the y coordinates of the polygon
+   * \param size_in (INPUT) is the number of points of the polygon
+   * \param bound (INPUT) is the position of the edge
+   * \param along_x (INPUT) is true for an edge at x = bound and false for
+   * an edge at y = bound
+   * \param keep_above (INPUT) is true to keep the points above the edge
+   * \param out_x (OUTPUT) is the x coordinates of the clipped polygon
+   * \param out_y (OUTPUT) is the y coordinates of the clipped polygon
+   * \param size_max (INPUT) is the number of elements of out_x and out_y
+   *
+   * \return The number of points of the clipped polygon
+   */
+  template <typename NumT>
+  std::size_t
+  __clip_polygon_to_edge(const NumT * in_x,
+                         const NumT * in_y,
+                         const std::size_t size_in,
+                         const NumT bound,
+                         const bool along_x,
+                         const bool keep_above,
+                         NumT * out_x,
+                         NumT * out_y,
+                         const std::size_t size_max)
+  {
+    // The coordinate compared to the edge and the other one
+    const NumT * in_a = along_x ? in_x : in_y;
+    const NumT * in_b = along_x ? in_y : in_x;
+    NumT * out_a = along_x ? out_x : out_y;
+    NumT * out_b = along_x ? out_y : out_x;
+
+    std::size_t size_out = 0;
+    if (size_in == 0)
+      {
+        return size_out;
+      }
+
+    std::size_t prev = size_in - 1;
+    bool prev_inside = keep_above ? in_a[prev] >= bound : in_a[prev] <= bound;
+
+    for (std::size_t curr = 0; curr < size_in; ++curr)
+      {
+        bool curr_inside = keep_above ? in_a[curr] >= bound
+          : in_a[curr] <= bound;
+
+        if (curr_inside != prev_inside)
+          {
+            // The segment crosses the edge, add the crossing point
+            NumT t = (bound - in_a[prev]) / (in_a[curr] - in_a[prev]);
+            __add_clip_point(bound,
+                             in_b[prev] + t * (in_b[curr] - in_b[prev]),
+                             out_a, out_b, size_out, size_max);
+          }
+        if (curr_inside)
+          {
+            __add_clip_point(in_a[curr], in_b[curr], out_a, out_b,
+                             size_out, size_max);
+          }
+
+        prev = curr;
+        prev_inside = curr_inside;
+      }
+
+    // The polygon is closed, so the last point may equal the first one
+    if (size_out > 1 && out_a[size_out - 1] == out_a[0]
+        && out_b[size_out - 1] == out_b[0])
+      {
+        --size_out;
+      }
+
+    return size_out;
+  }
+
+  template <typename NumT>
+  std::size_t
+  __clip_quad_to_rectangle(const NumT * quad_x,
+                           const NumT * quad_y,
+                           const NumT x_min,
+                           const NumT x_max,
+                           const NumT y_min,
+                           const NumT y_max,
+                           NumT * clip_x,
+                           NumT * clip_y)
+  {
+    static const std::size_t SIZE_QUAD = 4;
+
+    // Two buffers on the stack that the four clips alternate between
+    NumT buf_x[CLIP_QUAD_MAX_POINTS];
+    NumT buf_y[CLIP_QUAD_MAX_POINTS];
+
+    std::size_t size;
+    size = __clip_polygon_to_edge(quad_x, quad_y, SIZE_QUAD, x_min, true,
+                                  true, buf_x, buf_y, CLIP_QUAD_MAX_POINTS);
+    size = __clip_polygon_to_edge(buf_x, buf_y, size, x_max, true, false,
+                                  clip_x, clip_y, CLIP_QUAD_MAX_POINTS);
+    size = __clip_polygon_to_edge(clip_x, clip_y, size, y_min, false, true,
+                                  buf_x, buf_y, CLIP_QUAD_MAX_POINTS);
+    size = __clip_polygon_to_edge(buf_x, buf_y, size, y_max, false, false,
+                                  clip_x, clip_y, CLIP_QUAD_MAX_POINTS);
+
+    // Repeat the first two points for the area calculation
+    if (size >= 2)
+      {
+        clip_x[size] = clip_x[0];
+        clip_y[size] = clip_y[0];
+        clip_x[size + 1] = clip_x[1];
+        clip_y[size + 1] = clip_y[1];
+      }
+
+    return size;
+  }
+
+} // Utils
+
+#endif // _CLIP_QUAD_TO_RECTANGLE_HPP
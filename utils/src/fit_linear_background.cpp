@@ -66,4 +66,42 @@ namespace Utils
                                 double & intercept,
                                 double & intercept_err2,
                                 void *temp);
+
+  /**
+   * This is the float declaration of the function defined in 3.43 for
+   * views.
+   *
+   * \ingroup fit_linear_background
+   */
+  template std::string
+  fit_linear_background<float>(const Nessi::Vector<float> & axis_in,
+                               const Nessi::VectorView<const float> & input,
+                               const Nessi::VectorView<const float> &
+                               input_err2,
+                               const std::size_t min_bin,
+                               const std::size_t max_bin,
+                               float & slope,
+                               float & slope_err2,
+                               float & intercept,
+                               float & intercept_err2,
+                               void *temp);
+  /**
+   * This is the double precision float declaration of the function
+   * defined in 3.43 for views.
+   *
+   * \ingroup fit_linear_background
+   */
+  template std::string
+  fit_linear_background<double>(const Nessi::Vector<double> & axis_in,
+                                const Nessi::VectorView<const double> &
+                                input,
+                                const Nessi::VectorView<const double> &
+                                input_err2,
+                                const std::size_t min_bin,
+                                const std::size_t max_bin,
+                                double & slope,
+                                double & slope_err2,
+                                double & intercept,
+                                double & intercept_err2,
+                                void *temp);
 } // Utils
@@ -41,40 +41,36 @@ namespace Utils
   /// String for holding the fit_linear_background function name
   const std::string flb_func_str = "Utils::fit_linear_background";
 
-  // 3.43
-  template <typename NumT>
+  /**
+   * \ingroup fit_linear_background
+   *
+   * This is a PRIVATE helper function for fit_linear_background that does
+   * the fit once the sizes have been checked. The data arrays are
+   * Nessi::Vector or Nessi::VectorView objects.
+   *
+   * \param axis_in (INPUT) same as parameter in fit_linear_background()
+   * \param input (INPUT) same as parameter in fit_linear_background()
+   * \param input_err2 (INPUT) same as parameter in fit_linear_background()
+   * \param min_bin (INPUT) same as parameter in fit_linear_background()
+   * \param max_bin (INPUT) same as parameter in fit_linear_background()
+   * \param slope (OUTPUT) same as parameter in fit_linear_background()
+   * \param slope_err2 (OUTPUT) same as parameter in fit_linear_background()
+   * \param intercept (OUTPUT) same as parameter in fit_linear_background()
+   * \param intercept_err2 (OUTPUT) same as parameter in
+   * fit_linear_background()
+   */
+  template <typename NumT, typename ArrayT>
   std::string
-  fit_linear_background(const Nessi::Vector<NumT> & axis_in,
-                        const Nessi::Vector<NumT> & input,
-                        const Nessi::Vector<NumT> & input_err2,
-                        const std::size_t min_bin,
-                        const std::size_t max_bin,
-                        NumT & slope,
-                        NumT & slope_err2,
-                        NumT & intercept,
-                        NumT & intercept_err2,
-                        void *temp=NULL)
+  __fit_linear_background(const Nessi::Vector<NumT> & axis_in,
+                          const ArrayT & input,
+                          const ArrayT & input_err2,
+                          const std::size_t min_bin,
+                          const std::size_t max_bin,
+                          NumT & slope,
+                          NumT & slope_err2,
+                          NumT & intercept,
+                          NumT & intercept_err2)
   {
-    // check that the input and input err2 arrays are of proper size
-    try
-      {
-        Utils::check_sizes_square(input, input_err2);
-      }
-    catch(std::invalid_argument &e)
-      {
-        throw std::invalid_argument(flb_func_str + " input data & err2 "
-                                    + e.what());
-      }
-    // check that the input and axis_in arrays are of proper size
-    try
-      {
-        Utils::check_sizes_square(axis_in, input);
-      }
-    catch(std::invalid_argument &e)
-      {
-        throw std::invalid_argument(flb_func_str + " input data & axis "
-                                    + e.what());
-      }
     std::string retstr(Nessi::EMPTY_WARN);
     std::string warn;
 
@@ -139,6 +135,77 @@ namespace Utils
     return retstr;
   }
 
+  // 3.43
+  template <typename NumT>
+  std::string
+  fit_linear_background(const Nessi::Vector<NumT> & axis_in,
+                        const Nessi::Vector<NumT> & input,
+                        const Nessi::Vector<NumT> & input_err2,
+                        const std::size_t min_bin,
+                        const std::size_t max_bin,
+                        NumT & slope,
+                        NumT & slope_err2,
+                        NumT & intercept,
+                        NumT & intercept_err2,
+                        void *temp=NULL)
+  {
+    // check that the input and input err2 arrays are of proper size
+    try
+      {
+        Utils::check_sizes_square(input, input_err2);
+      }
+    catch(std::invalid_argument &e)
+      {
+        throw std::invalid_argument(flb_func_str + " input data & err2 "
+                                    + e.what());
+      }
+    // check that the input and axis_in arrays are of proper size
+    try
+      {
+        Utils::check_sizes_square(axis_in, input);
+      }
+    catch(std::invalid_argument &e)
+      {
+        throw std::invalid_argument(flb_func_str + " input data & axis "
+                                    + e.what());
+      }
+    return __fit_linear_background(axis_in, input, input_err2, min_bin,
+                                   max_bin, slope, slope_err2, intercept,
+                                   intercept_err2);
+  }
+
+  // 3.43
+  template <typename NumT>
+  std::string
+  fit_linear_background(const Nessi::Vector<NumT> & axis_in,
+                        const Nessi::VectorView<const NumT> & input,
+                        const Nessi::VectorView<const NumT> & input_err2,
+                        const std::size_t min_bin,
+                        const std::size_t max_bin,
+                        NumT & slope,
+                        NumT & slope_err2,
+                        NumT & intercept,
+                        NumT & intercept_err2,
+                        void *temp=NULL)
+  {
+    // check that the input and input err2 views are of proper size
+    if (input.size() != input_err2.size())
+      {
+        throw std::invalid_argument(flb_func_str + " (view): input data & "
+                                    + "err2 not the same size");
+      }
+    // check that the input and axis_in arrays are of proper size
+    if (axis_in.size() != input.size())
+      {
+        throw std::invalid_argument(flb_func_str + " (view): input data & "
+                                    + "axis not the same size");
+      }
+
+    return __fit_linear_background(axis_in, input, input_err2, min_bin,
+                                   max_bin, slope, slope_err2, intercept,
+                                   intercept_err2);
+  }
+
   /**
    * \ingroup fit_linear_background
    * 
@@ -0,0 +1,45 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+/**
+ * $Id$
+ *
+ * \file utils/src/get_num_threads.cpp
+ */
+#include "nessi_exec.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace Nessi
+{
+  int get_num_threads()
+  {
+#ifdef _OPENMP
+    int num_threads = __requested_num_threads();
+    return (num_threads > 0) ? num_threads : omp_get_max_threads();
+#else
+    return 1;
+#endif
+  }
+} // Nessi
@@ -101,4 +101,40 @@ namespace Utils
                             double & output_err2,
                             void *temp);
 
+  /**
+   * This is the float declaration of the integrate_1D_hist function defined
+   * in 3.65 for views.
+   *
+   * \ingroup integrate_1D_hist
+   */
+  template std::string
+  integrate_1D_hist<float>(const Nessi::VectorView<const float> & input,
+                           const Nessi::VectorView<const float> & input_err2,
+                           const Nessi::Vector<float> & axis_in,
+                           const float min_int,
+                           const float max_int,
+                           const bool width,
+                           const Nessi::Vector<float> & axis_bw_in,
+                           float & output,
+                           float & output_err2,
+                           void *temp);
+  /**
+   * This is the double declaration of the integrate_1D_hist function defined
+   * in 3.65 for views.
+   *
+   * \ingroup integrate_1D_hist
+   */
+  template std::string
+  integrate_1D_hist<double>(const Nessi::VectorView<const double> & input,
+                            const Nessi::VectorView<const double> &
+                            input_err2,
+                            const Nessi::Vector<double> & axis_in,
+                            const double min_int,
+                            const double max_int,
+                            const bool width,
+                            const Nessi::Vector<double> & axis_bw_in,
+                            double & output,
+                            double & output_err2,
+                            void *temp);
+
 } // Utils
@@ -32,6 +32,8 @@
 
 #include <cmath>
 #include <limits>
+#include <stdexcept>
+#include "bisect_many.hpp"
 #include "size_checks.hpp"
 #include "utils.hpp"
 
@@ -40,6 +42,81 @@ namespace Utils
   // String for holding integrate_1D_hist function name
   const std::string i1h_func_str = "Utils::integrate_1D_hist";
 
+  /**
+   * \ingroup integrate_1D_hist
+   *
+   * This is a PRIVATE helper function for integrate_1D_hist that does the
+   * integration once the sizes have been checked. The data arrays are
+   * Nessi::Vector or Nessi::VectorView objects.
+   *
+   * \param input (INPUT) same as parameter in integrate_1D_hist()
+   * \param input_err2 (INPUT) same as parameter in integrate_1D_hist()
+   * \param axis_in (INPUT) same as parameter in integrate_1D_hist()
+   * \param min_int (INPUT) same as parameter in integrate_1D_hist()
+   * \param max_int (INPUT) same as parameter in integrate_1D_hist()
+   * \param width (INPUT) same as parameter in integrate_1D_hist()
+   * \param axis_bw_in (INPUT) same as parameter in integrate_1D_hist()
+   * \param output (OUTPUT) same as parameter in integrate_1D_hist()
+   * \param output_err2 (OUTPUT) same as parameter in integrate_1D_hist()
+   */
+  template <typename NumT, typename ArrayT>
+  std::string
+  __integrate_1D_hist(const ArrayT & input,
+                      const ArrayT & input_err2,
+                      const Nessi::Vector<NumT> & axis_in,
+                      const NumT min_int,
+                      const NumT max_int,
+                      const bool width,
+                      const Nessi::Vector<NumT> & axis_bw_in,
+                      NumT & output,
+                      NumT & output_err2)
+  {
+    // Zero output holders 
+    output = static_cast<NumT>(0.0);
+    output_err2 = static_cast<NumT>(0.0);
+
+    std::string warn = "";
+
+    // Determine the bin indices of the finite limits in one search
+    NumT limit[2];
+    std::size_t bin[2];
+    std::size_t num_limits = 0;
+    if (!std::isinf(min_int))
+      {
+        limit[num_limits++] = min_int;
+      }
+    if (!std::isinf(max_int))
+      {
+        limit[num_limits++] = max_int;
+      }
+    Utils::__bisect_many(&axis_in[0], axis_in.size(), limit, num_limits,
+                         bin);
+
+    std::size_t min_bin = std::isinf(min_int) ? 0 : bin[0];
+    std::size_t max_bin = std::isinf(max_int) ? input.size() - 1
+      : bin[num_limits - 1];
+
+    for (std::size_t i = min_bin; i <= max_bin; ++i)
+      {
+        if (!std::isnan(input[i]) && !std::isnan(input_err2[i]) && 
+            !std::isinf(input[i]) && !std::isinf(input_err2[i]))
+          {
+            if (width)
+              {
+                output += (axis_bw_in[i] * input[i]);
+                output_err2 += (axis_bw_in[i] * axis_bw_in[i] * input_err2[i]);
+              }
+            else
+              {
+                output += input[i];
+                output_err2 += input_err2[i];
+              }
+          }
+      }
+
+    return warn;
+  }
+
   // 3.65
   template <typename NumT>
   std::string
@@ -87,54 +164,44 @@ namespace Utils
                                   input, axis_bw_in);
       }
 
-    // Zero output holders 
-    output = static_cast<NumT>(0.0);
-    output_err2 = static_cast<NumT>(0.0);
-
-    std::size_t min_bin;
-    std::size_t max_bin;
-
-    std::string warn = "";
-
-    // Determine the lower bin index
-    if (std::isinf(min_int))
-      {
-        min_bin = 0;
-      }
-    else
-      {
-        warn += Utils::bisect_helper(axis_in, min_int, min_bin);
-      }
+    return __integrate_1D_hist(input, input_err2, axis_in, min_int,
+                               max_int, width, axis_bw_in, output,
+                               output_err2);
+  }
 
-    // Determine the upper bin index
-    if (std::isinf(max_int))
-      {
-        max_bin = input.size() - 1;
-      }
-    else
+  // 3.65
+  template <typename NumT>
+  std::string
+  integrate_1D_hist(const Nessi::VectorView<const NumT> & input,
+                    const Nessi::VectorView<const NumT> & input_err2,
+                    const Nessi::Vector<NumT> & axis_in,
+                    const NumT min_int,
+                    const NumT max_int,
+                    const bool width,
+                    const Nessi::Vector<NumT> & axis_bw_in,
+                    NumT & output,
+                    NumT & output_err2,
+                    void *temp=NULL)
+  {
+    // Check input is histogram
+    if (input.size() != input_err2.size()
+        || axis_in.size() != input.size() + 1)
       {
-        warn += Utils::bisect_helper(axis_in, max_int, max_bin);
+        throw std::invalid_argument(i1h_func_str + " (view): input "
+                                    + "histogram views not consistent with "
+                                    + "the axis");
       }
 
-    for (std::size_t i = min_bin; i <= max_bin; ++i)
+    // Check that input and axis_bw_in are the same size if width is true
+    if (width && input.size() != axis_bw_in.size())
       {
-        if (!std::isnan(input[i]) && !std::isnan(input_err2[i]) && 
-            !std::isinf(input[i]) && !std::isinf(input_err2[i]))
-          {
-            if (width)
-              {
-                output += (axis_bw_in[i] * input[i]);
-                output_err2 += (axis_bw_in[i] * axis_bw_in[i] * input_err2[i]);
-              }
-            else
-              {
-                output += input[i];
-                output_err2 += input_err2[i];
-              }
-          }
+        throw std::invalid_argument(i1h_func_str + " (view): input data & "
+                                    + "bin widths not the same size");
       }
 
-    return warn;
+    return __integrate_1D_hist(input, input_err2, axis_in, min_int,
+                               max_int, width, axis_bw_in, output,
+                               output_err2);
   }
 } // Utils
 
@@ -41,6 +41,45 @@ namespace Utils
   /// String for holding the linear_order_jacobian function name
   const std::string lojac_func_str = "Utils::linear_order_jacobian";
 
+  /**
+   * \ingroup linear_order_jacobian
+   *
+   * This is a PRIVATE helper function for linear_order_jacobian that
+   * corrects one bin. A transformed bin of zero width is not reported.
+   *
+   * \param orig_axis_lo (INPUT) same as the parameter in
+   * linear_order_jacobian()
+   * \param orig_axis_hi (INPUT) same as the parameter in
+   * linear_order_jacobian()
+   * \param transform_axis_lo (INPUT) same as the parameter in
+   * linear_order_jacobian()
+   * \param transform_axis_hi (INPUT) same as the parameter in
+   * linear_order_jacobian()
+   * \param input (INPUT) same as the parameter in linear_order_jacobian()
+   * \param input_err2 (INPUT) same as the parameter in
+   * linear_order_jacobian()
+   * \param output (OUTPUT) same as the parameter in linear_order_jacobian()
+   * \param output_err2 (OUTPUT) same as the parameter in
+   * linear_order_jacobian()
+   */
+  template <typename NumT>
+  void
+  __linear_order_jacobian(const NumT orig_axis_lo,
+                          const NumT orig_axis_hi,
+                          const NumT transform_axis_lo,
+                          const NumT transform_axis_hi,
+                          const NumT input,
+                          const NumT input_err2,
+                          NumT & output,
+                          NumT & output_err2)
+  {
+    NumT ratio = (orig_axis_hi - orig_axis_lo)
+      / (transform_axis_hi - transform_axis_lo);
+
+    output = input * static_cast<NumT>(std::fabs(static_cast<double>(ratio)));
+    output_err2 = input_err2 * ratio * ratio;
+  }
+
   // 3.49
   template <typename NumT>
   std::string
@@ -82,23 +121,16 @@ namespace Utils
         throw std::invalid_argument(lojac_func_str+": transformed histogram "
                                     +e.what());
       }
-    std::string retstr(Nessi::EMPTY_WARN);
-    std::string warn;
-
     std::size_t size_in = input.size();
     for (std::size_t i = 0; i < size_in; ++i)
       {
-        warn = linear_order_jacobian(orig_axis[i], orig_axis[i+1],
-                                     transform_axis[i], transform_axis[i+1],
-                                     input[i], input_err2[i],
-                                     output[i], output_err2[i]);
-       if (!warn.empty())
-          {
-            retstr += warn;
-          }
+        __linear_order_jacobian(orig_axis[i], orig_axis[i+1],
+                                transform_axis[i], transform_axis[i+1],
+                                input[i], input_err2[i],
+                                output[i], output_err2[i]);
       }
 
-    return retstr;
+    return Nessi::EMPTY_WARN;
   }
 
   // 3.49
@@ -114,11 +146,9 @@ namespace Utils
                         NumT & output_err2,
                         void *temp=NULL)
   {
-    NumT ratio = (orig_axis_hi - orig_axis_lo) / 
-      (transform_axis_hi - transform_axis_lo);
-
-    output = input * static_cast<NumT>(std::fabs(static_cast<double>(ratio)));
-    output_err2 = input_err2 * ratio * ratio;
+    __linear_order_jacobian(orig_axis_lo, orig_axis_hi, transform_axis_lo,
+                            transform_axis_hi, input, input_err2, output,
+                            output_err2);
 
     return Nessi::EMPTY_WARN;
   }
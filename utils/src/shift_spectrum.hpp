@@ -30,6 +30,8 @@
 #ifndef _SHIFT_SPECTRUM_HPP
 #define _SHIFT_SPECTRUM_HPP 1
 
+#include "bisect_many.hpp"
+#include "nessi_workspace.hpp"
 #include "num_comparison.hpp"
 #include "size_checks.hpp"
 #include "utils.hpp"
@@ -75,8 +77,6 @@ namespace Utils
 
     size_t ie_index;
     size_t ae_index;
-    size_t pos_index;
-    NumT axis_pos;
 
     std::string warn = "";
 
@@ -84,22 +84,37 @@ namespace Utils
     warn += Utils::bisect_helper(axis_in, xmin, ie_index);
     warn += Utils::bisect_helper(axis_in, xmax, ae_index);
 
+    if (ie_index > ae_index)
+      {
+        return warn;
+      }
+
+    // The shifted axis positions form two increasing runs, the bins below
+    // xshift moved up and the bins above it moved down
+    size_t num_pos = ae_index - ie_index + 1;
+    Nessi::Scratch<NumT> axis_pos(temp, num_pos);
     for (size_t i = ie_index; i <= ae_index; ++i)
       {
         if (Utils::compare(axis_bc_in[i], xshift) < 1)
           {
-            axis_pos = axis_bc_in[i] + (xmax - xshift);
+            axis_pos[i - ie_index] = axis_bc_in[i] + (xmax - xshift);
           }
         else
           {
-            axis_pos = axis_bc_in[i] - (xshift - xmin);
+            axis_pos[i - ie_index] = axis_bc_in[i] - (xshift - xmin);
           }
-        // Find bin index of shifted axis position
-        warn += Utils::bisect_helper(axis_in, axis_pos, pos_index);
+      }
 
-        // Fill in data
-        output[i] = input[pos_index];
-        output_err2[i] = input_err2[pos_index];
+    // Find bin indices of shifted axis positions
+    Nessi::Scratch<size_t> pos_index(temp, num_pos);
+    Utils::__bisect_many(&axis_in[0], axis_in.size(), axis_pos.data(),
+                         num_pos, pos_index.data());
+
+    // Fill in data
+    for (size_t i = ie_index; i <= ae_index; ++i)
+      {
+        output[i] = input[pos_index[i - ie_index]];
+        output_err2[i] = input_err2[pos_index[i - ie_index]];
       }
 
     return warn;
@@ -0,0 +1,473 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+
+/**
+ * $Id$
+ *
+ * \file utils/src/vector_math.cpp
+ */
+#include "vector_math.hpp"
+#include "nessi_simd.hpp"
+#include <cmath>
+
+#ifdef NESSI_HAVE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace Utils
+{
+  // Floating point contraction is switched off everywhere in this file so
+  // that the vector and the scalar versions round identically.
+
+#pragma GCC push_options
+#pragma GCC optimize("fp-contract=off")
+
+  /**
+   * \ingroup vector_math
+   *
+   * This is a PRIVATE register trait holding a single element. It computes
+   * the elements that do not fill a register, and every element when no
+   * vector instruction set is available.
+   */
+  template <typename NumT>
+  struct __ScalarVec
+  {
+    typedef NumT value_type;
+    typedef NumT reg;
+    typedef bool mask;
+    enum { width = 1 };
+    static inline reg load(const NumT * p) { return *p; }
+    static inline void store(NumT * p, reg a) { *p = a; }
+    static inline reg set1(const NumT a) { return a; }
+    static inline reg add(reg a, reg b) { return a + b; }
+    static inline reg sub(reg a, reg b) { return a - b; }
+    static inline reg mul(reg a, reg b) { return a * b; }
+    static inline reg div(reg a, reg b) { return a / b; }
+    static inline reg sqrt(reg a) { return std::sqrt(a); }
+    static inline reg abs(reg a) { return std::fabs(a); }
+    static inline reg trunc(reg a)
+    {
+      return static_cast<NumT>(static_cast<int>(a));
+    }
+    static inline reg pow2(reg n)
+    {
+      return (n == n) ? std::ldexp(static_cast<NumT>(1), static_cast<int>(n))
+        : n;
+    }
+    static inline mask lt(reg a, reg b) { return a < b; }
+    static inline mask le(reg a, reg b) { return a <= b; }
+    static inline reg select(mask m, reg a, reg b) { return m ? a : b; }
+    static inline bool all(mask m) { return m; }
+  };
+
+  namespace __none
+  {
+    typedef __ScalarVec<float> VecF;
+    typedef __ScalarVec<double> VecD;
+
+#include "vector_math_isa.hpp"
+  } // __none
+
+#pragma GCC pop_options
+
+#ifdef NESSI_HAVE_X86_SIMD
+
+  // Every instruction set gets its own region, with the same options as
+  // the ncerr kernels of ArrayManip.
+
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#pragma GCC optimize("fp-contract=off")
+  namespace __sse2
+  {
+    struct VecF
+    {
+      typedef float value_type;
+      typedef __m128 reg;
+      typedef __m128 mask;
+      enum { width = 4 };
+      static inline reg load(const float * p) { return _mm_loadu_ps(p); }
+      static inline void store(float * p, reg a) { _mm_storeu_ps(p, a); }
+      static inline reg set1(const float a) { return _mm_set1_ps(a); }
+      static inline reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+      static inline reg sub(reg a, reg b) { return _mm_sub_ps(a, b); }
+      static inline reg mul(reg a, reg b) { return _mm_mul_ps(a, b); }
+      static inline reg div(reg a, reg b) { return _mm_div_ps(a, b); }
+      static inline reg sqrt(reg a) { return _mm_sqrt_ps(a); }
+      static inline reg abs(reg a)
+      {
+        return _mm_andnot_ps(_mm_set1_ps(-0.0f), a);
+      }
+      static inline reg trunc(reg a)
+      {
+        return _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+      }
+      static inline reg pow2(reg n)
+      {
+        __m128i e = _mm_castps_si128(_mm_add_ps(n, _mm_set1_ps(8388735.0f)));
+        return _mm_castsi128_ps(_mm_slli_epi32(e, 23));
+      }
+      static inline mask lt(reg a, reg b) { return _mm_cmplt_ps(a, b); }
+      static inline mask le(reg a, reg b) { return _mm_cmple_ps(a, b); }
+      static inline reg select(mask m, reg a, reg b)
+      {
+        return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+      }
+      static inline bool all(mask m) { return _mm_movemask_ps(m) == 0xF; }
+    };
+
+    struct VecD
+    {
+      typedef double value_type;
+      typedef __m128d reg;
+      typedef __m128d mask;
+      enum { width = 2 };
+      static inline reg load(const double * p) { return _mm_loadu_pd(p); }
+      static inline void store(double * p, reg a) { _mm_storeu_pd(p, a); }
+      static inline reg set1(const double a) { return _mm_set1_pd(a); }
+      static inline reg add(reg a, reg b) { return _mm_add_pd(a, b); }
+      static inline reg sub(reg a, reg b) { return _mm_sub_pd(a, b); }
+      static inline reg mul(reg a, reg b) { return _mm_mul_pd(a, b); }
+      static inline reg div(reg a, reg b) { return _mm_div_pd(a, b); }
+      static inline reg sqrt(reg a) { return _mm_sqrt_pd(a); }
+      static inline reg abs(reg a)
+      {
+        return _mm_andnot_pd(_mm_set1_pd(-0.0), a);
+      }
+      static inline reg trunc(reg a)
+      {
+        return _mm_cvtepi32_pd(_mm_cvttpd_epi32(a));
+      }
+      static inline reg pow2(reg n)
+      {
+        __m128i e = _mm_castpd_si128(_mm_add_pd(n, _mm_set1_pd(
+                                                  4503599627371519.0)));
+        return _mm_castsi128_pd(_mm_slli_epi64(e, 52));
+      }
+      static inline mask lt(reg a, reg b) { return _mm_cmplt_pd(a, b); }
+      static inline mask le(reg a, reg b) { return _mm_cmple_pd(a, b); }
+      static inline reg select(mask m, reg a, reg b)
+      {
+        return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b));
+      }
+      static inline bool all(mask m) { return _mm_movemask_pd(m) == 0x3; }
+    };
+
+#include "vector_math_isa.hpp"
+  } // __sse2
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#pragma GCC optimize("fp-contract=off")
+  namespace __avx2
+  {
+    struct VecF
+    {
+      typedef float value_type;
+      typedef __m256 reg;
+      typedef __m256 mask;
+      enum { width = 8 };
+      static inline reg load(const float * p) { return _mm256_loadu_ps(p); }
+      static inline void store(float * p, reg a) { _mm256_storeu_ps(p, a); }
+      static inline reg set1(const float a) { return _mm256_set1_ps(a); }
+      static inline reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+      static inline reg sub(reg a, reg b) { return _mm256_sub_ps(a, b); }
+      static inline reg mul(reg a, reg b) { return _mm256_mul_ps(a, b); }
+      static inline reg div(reg a, reg b) { return _mm256_div_ps(a, b); }
+      static inline reg sqrt(reg a) { return _mm256_sqrt_ps(a); }
+      static inline reg abs(reg a)
+      {
+        return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a);
+      }
+      static inline reg trunc(reg a)
+      {
+        return _mm256_cvtepi32_ps(_mm256_cvttps_epi32(a));
+      }
+      static inline reg pow2(reg n)
+      {
+        __m256i e = _mm256_castps_si256(_mm256_add_ps(n, _mm256_set1_ps(
+                                                        8388735.0f)));
+        return _mm256_castsi256_ps(_mm256_slli_epi32(e, 23));
+      }
+      static inline mask lt(reg a, reg b)
+      {
+        return _mm256_cmp_ps(a, b, _CMP_LT_OQ);
+      }
+      static inline mask le(reg a, reg b)
+      {
+        return _mm256_cmp_ps(a, b, _CMP_LE_OQ);
+      }
+      static inline reg select(mask m, reg a, reg b)
+      {
+        return _mm256_blendv_ps(b, a, m);
+      }
+      static inline bool all(mask m)
+      {
+        return _mm256_movemask_ps(m) == 0xFF;
+      }
+    };
+
+    struct VecD
+    {
+      typedef double value_type;
+      typedef __m256d reg;
+      typedef __m256d mask;
+      enum { width = 4 };
+      static inline reg load(const double * p) { return _mm256_loadu_pd(p); }
+      static inline void store(double * p, reg a) { _mm256_storeu_pd(p, a); }
+      static inline reg set1(const double a) { return _mm256_set1_pd(a); }
+      static inline reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+      static inline reg sub(reg a, reg b) { return _mm256_sub_pd(a, b); }
+      static inline reg mul(reg a, reg b) { return _mm256_mul_pd(a, b); }
+      static inline reg div(reg a, reg b) { return _mm256_div_pd(a, b); }
+      static inline reg sqrt(reg a) { return _mm256_sqrt_pd(a); }
+      static inline reg abs(reg a)
+      {
+        return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a);
+      }
+      static inline reg trunc(reg a)
+      {
+        return _mm256_cvtepi32_pd(_mm256_cvttpd_epi32(a));
+      }
+      static inline reg pow2(reg n)
+      {
+        __m256i e = _mm256_castpd_si256(_mm256_add_pd(n, _mm256_set1_pd(
+                                                        4503599627371519.0)));
+        return _mm256_castsi256_pd(_mm256_slli_epi64(e, 52));
+      }
+      static inline mask lt(reg a, reg b)
+      {
+        return _mm256_cmp_pd(a, b, _CMP_LT_OQ);
+      }
+      static inline mask le(reg a, reg b)
+      {
+        return _mm256_cmp_pd(a, b, _CMP_LE_OQ);
+      }
+      static inline reg select(mask m, reg a, reg b)
+      {
+        return _mm256_blendv_pd(b, a, m);
+      }
+      static inline bool all(mask m)
+      {
+        return _mm256_movemask_pd(m) == 0xF;
+      }
+    };
+
+#include "vector_math_isa.hpp"
+  } // __avx2
+#pragma GCC pop_options
+
+#ifdef NESSI_HAVE_AVX512
+  // The AVX-512 headers of some GCC releases trigger a spurious
+  // uninitialized variable warning in the sqrt intrinsics.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#pragma GCC optimize("fp-contract=off")
+  namespace __avx512
+  {
+    struct VecF
+    {
+      typedef float value_type;
+      typedef __m512 reg;
+      typedef __mmask16 mask;
+      enum { width = 16 };
+      static inline reg load(const float * p) { return _mm512_loadu_ps(p); }
+      static inline void store(float * p, reg a) { _mm512_storeu_ps(p, a); }
+      static inline reg set1(const float a) { return _mm512_set1_ps(a); }
+      static inline reg add(reg a, reg b) { return _mm512_add_ps(a, b); }
+      static inline reg sub(reg a, reg b) { return _mm512_sub_ps(a, b); }
+      static inline reg mul(reg a, reg b) { return _mm512_mul_ps(a, b); }
+      static inline reg div(reg a, reg b) { return _mm512_div_ps(a, b); }
+      static inline reg sqrt(reg a) { return _mm512_sqrt_ps(a); }
+      static inline reg abs(reg a)
+      {
+        return _mm512_castsi512_ps(_mm512_and_epi32(
+                 _mm512_castps_si512(a), _mm512_set1_epi32(0x7FFFFFFF)));
+      }
+      static inline reg trunc(reg a)
+      {
+        return _mm512_cvtepi32_ps(_mm512_cvttps_epi32(a));
+      }
+      static inline reg pow2(reg n)
+      {
+        __m512i e = _mm512_castps_si512(_mm512_add_ps(n, _mm512_set1_ps(
+                                                        8388735.0f)));
+        return _mm512_castsi512_ps(_mm512_slli_epi32(e, 23));
+      }
+      static inline mask lt(reg a, reg b)
+      {
+        return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ);
+      }
+      static inline mask le(reg a, reg b)
+      {
+        return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ);
+      }
+      static inline reg select(mask m, reg a, reg b)
+      {
+        return _mm512_mask_blend_ps(m, b, a);
+      }
+      static inline bool all(mask m) { return m == 0xFFFF; }
+    };
+
+    struct VecD
+    {
+      typedef double value_type;
+      typedef __m512d reg;
+      typedef __mmask8 mask;
+      enum { width = 8 };
+      static inline reg load(const double * p) { return _mm512_loadu_pd(p); }
+      static inline void store(double * p, reg a) { _mm512_storeu_pd(p, a); }
+      static inline reg set1(const double a) { return _mm512_set1_pd(a); }
+      static inline reg add(reg a, reg b) { return _mm512_add_pd(a, b); }
+      static inline reg sub(reg a, reg b) { return _mm512_sub_pd(a, b); }
+      static inline reg mul(reg a, reg b) { return _mm512_mul_pd(a, b); }
+      static inline reg div(reg a, reg b) { return _mm512_div_pd(a, b); }
+      static inline reg sqrt(reg a) { return _mm512_sqrt_pd(a); }
+      static inline reg abs(reg a)
+      {
+        return _mm512_castsi512_pd(_mm512_and_epi64(
+                 _mm512_castpd_si512(a),
+                 _mm512_set1_epi64(0x7FFFFFFFFFFFFFFFLL)));
+      }
+      static inline reg trunc(reg a)
+      {
+        return _mm512_cvtepi32_pd(_mm512_cvttpd_epi32(a));
+      }
+      static inline reg pow2(reg n)
+      {
+        __m512i e = _mm512_castpd_si512(_mm512_add_pd(n, _mm512_set1_pd(
+                                                        4503599627371519.0)));
+        return _mm512_castsi512_pd(_mm512_slli_epi64(e, 52));
+      }
+      static inline mask lt(reg a, reg b)
+      {
+        return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ);
+      }
+      static inline mask le(reg a, reg b)
+      {
+        return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ);
+      }
+      static inline reg select(mask m, reg a, reg b)
+      {
+        return _mm512_mask_blend_pd(m, b, a);
+      }
+      static inline bool all(mask m) { return m == 0xFF; }
+    };
+
+#include "vector_math_isa.hpp"
+  } // __avx512
+#pragma GCC pop_options
+#pragma GCC diagnostic pop
+#endif // NESSI_HAVE_AVX512
+
+#endif // NESSI_HAVE_X86_SIMD
+
+  /**
+   * This macro expands to the body of a dispatching function. It calls
+   * the version compiled for the selected instruction set, or the scalar
+   * loop when no vector version is available.
+   */
+#ifdef NESSI_HAVE_AVX512
+#define __VECMATH_DISPATCH_AVX512(name, vec, args)      \
+  case Nessi::SIMD_AVX512:                              \
+    __avx512::name<__avx512::vec> args;                 \
+    return;
+#else
+#define __VECMATH_DISPATCH_AVX512(name, vec, args)
+#endif
+
+#ifdef NESSI_HAVE_X86_SIMD
+#define __VECMATH_DISPATCH(name, vec, args)             \
+  switch (Nessi::simd_level())                          \
+    {                                                   \
+      __VECMATH_DISPATCH_AVX512(name, vec, args)        \
+    case Nessi::SIMD_AVX2:                              \
+      __avx2::name<__avx2::vec> args;                   \
+      return;                                           \
+    case Nessi::SIMD_SSE2:                              \
+      __sse2::name<__sse2::vec> args;                   \
+      return;                                           \
+    default:                                            \
+      __none::name<__none::vec> args;                   \
+      return;                                           \
+    }
+#else
+#define __VECMATH_DISPATCH(name, vec, args)     \
+  __none::name<__none::vec> args;
+#endif
+
+  void __vec_sqrt(const float * input, float * output,
+                  const std::size_t size)
+  {
+    __VECMATH_DISPATCH(vec_sqrt, VecF, (input, output, size))
+  }
+
+  void __vec_sqrt(const double * input, double * output,
+                  const std::size_t size)
+  {
+    __VECMATH_DISPATCH(vec_sqrt, VecD, (input, output, size))
+  }
+
+  void __vec_exp(const float * input, float * output,
+                 const std::size_t size)
+  {
+    __VECMATH_DISPATCH(vec_exp, VecF, (input, output, size))
+  }
+
+  void __vec_exp(const double * input, double * output,
+                 const std::size_t size)
+  {
+    __VECMATH_DISPATCH(vec_exp, VecD, (input, output, size))
+  }
+
+  void __vec_sin(const float * input, float * output,
+                 const std::size_t size)
+  {
+    __VECMATH_DISPATCH(vec_sincos, VecF, (input, output, size, false))
+  }
+
+  void __vec_sin(const double * input, double * output,
+                 const std::size_t size)
+  {
+    __VECMATH_DISPATCH(vec_sincos, VecD, (input, output, size, false))
+  }
+
+  void __vec_cos(const float * input, float * output,
+                 const std::size_t size)
+  {
+    __VECMATH_DISPATCH(vec_sincos, VecF, (input, output, size, true))
+  }
+
+  void __vec_cos(const double * input, double * output,
+                 const std::size_t size)
+  {
+    __VECMATH_DISPATCH(vec_sincos, VecD, (input, output, size, true))
+  }
+
+} // Utils
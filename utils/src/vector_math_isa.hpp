@@ -0,0 +1,353 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+
+/**
+ * $Id$
+ *
+ * \file utils/src/vector_math_isa.hpp
+ *
+ * This file contains the bodies of the vector math functions. It has no
+ * include guard on purpose: vector_math.cpp includes it once per
+ * instruction set, inside a namespace that defines the register traits
+ * VecF (float) and VecD (double) and inside a region compiled for that
+ * instruction set. On top of the operations of the ncerr kernels, each
+ * trait provides a mask type with the lt, le, select and all operations,
+ * abs, trunc (towards zero, for values below \f$2^{31}\f$) and pow2, which
+ * returns \f$2^n\f$ for an integral \f$n\f$ in the range of the normal
+ * exponents. The scalar trait __ScalarVec of vector_math.cpp computes the
+ * elements left over at the end of an array with the same functions.
+ *
+ * The polynomials and the argument reductions are those of the Cephes
+ * library.
+ */
+
+/**
+ * This function returns \f$e^x\f$ for float registers.
+ */
+template <typename V>
+typename V::reg exp_core(const typename V::reg x, const float)
+{
+  typedef typename V::reg reg;
+  const reg lo = V::set1(-86.9f);
+  const reg hi = V::set1(89.0f);
+
+  // Clamp so that 2^(n-1) is a normal number, NaN passes through
+  reg xc = V::select(V::lt(x, lo), lo, x);
+  xc = V::select(V::lt(hi, xc), hi, xc);
+
+  // n = round(x / ln 2), then r = x - n ln 2 with ln 2 in two parts
+  const reg round = V::set1(12582912.0f);
+  reg n = V::sub(V::add(V::mul(xc, V::set1(1.44269504088896341f)), round),
+                 round);
+  reg r = V::sub(xc, V::mul(n, V::set1(0.693359375f)));
+  r = V::sub(r, V::mul(n, V::set1(-2.12194440e-4f)));
+
+  reg z = V::mul(r, r);
+  reg p = V::set1(1.9875691500e-4f);
+  p = V::add(V::mul(p, r), V::set1(1.3981999507e-3f));
+  p = V::add(V::mul(p, r), V::set1(8.3334519073e-3f));
+  p = V::add(V::mul(p, r), V::set1(4.1665795894e-2f));
+  p = V::add(V::mul(p, r), V::set1(1.6666665459e-1f));
+  p = V::add(V::mul(p, r), V::set1(5.0000001201e-1f));
+  p = V::add(V::add(V::mul(p, z), r), V::set1(1.0f));
+
+  // 2 p 2^(n-1) reaches the largest exponents without overflowing 2^n
+  const reg two = V::set1(2.0f);
+  reg e = V::mul(V::mul(p, two), V::pow2(V::sub(n, V::set1(1.0f))));
+  e = V::select(V::lt(x, lo), V::set1(0.0f), e);
+  return V::select(V::lt(hi, x), V::div(two, V::set1(0.0f)), e);
+}
+
+/**
+ * This function returns \f$e^x\f$ for double registers.
+ */
+template <typename V>
+typename V::reg exp_core(const typename V::reg x, const double)
+{
+  typedef typename V::reg reg;
+  const reg lo = V::set1(-708.0);
+  const reg hi = V::set1(710.0);
+
+  // Clamp so that 2^(n-1) is a normal number, NaN passes through
+  reg xc = V::select(V::lt(x, lo), lo, x);
+  xc = V::select(V::lt(hi, xc), hi, xc);
+
+  // n = round(x / ln 2), then r = x - n ln 2 with ln 2 in two parts
+  const reg round = V::set1(6755399441055744.0);
+  reg n = V::sub(V::add(V::mul(xc, V::set1(1.4426950408889634073599)),
+                        round), round);
+  reg r = V::sub(xc, V::mul(n, V::set1(6.93145751953125e-1)));
+  r = V::sub(r, V::mul(n, V::set1(1.42860682030941723212e-6)));
+
+  // e^r = 1 + 2 r P(r^2) / (Q(r^2) - r P(r^2))
+  reg z = V::mul(r, r);
+  reg p = V::set1(1.26177193074810590878e-4);
+  p = V::add(V::mul(p, z), V::set1(3.02994407707441961300e-2));
+  p = V::add(V::mul(p, z), V::set1(9.99999999999999999910e-1));
+  p = V::mul(p, r);
+  reg q = V::set1(3.00198505138664455042e-6);
+  q = V::add(V::mul(q, z), V::set1(2.52448340349684104192e-3));
+  q = V::add(V::mul(q, z), V::set1(2.27265548208155028766e-1));
+  q = V::add(V::mul(q, z), V::set1(2.00000000000000000009e0));
+  const reg two = V::set1(2.0);
+  p = V::add(V::set1(1.0), V::mul(two, V::div(p, V::sub(q, p))));
+
+  // 2 p 2^(n-1) reaches the largest exponents without overflowing 2^n
+  reg e = V::mul(V::mul(p, two), V::pow2(V::sub(n, V::set1(1.0))));
+  e = V::select(V::lt(x, lo), V::set1(0.0), e);
+  return V::select(V::lt(hi, x), V::div(two, V::set1(0.0)), e);
+}
+
+/**
+ * This function reduces the float registers \p ax, which are positive and
+ * not larger than the limit of sincos_limit(), to
+ * \f$r = ax - y \pi/4\f$ where \f$y\f$ is the even integer nearest to
+ * \f$4 ax/\pi\f$. It returns \f$r\f$ and sets \p ps to \f$\sin r\f$ and
+ * \p pc to \f$\cos r\f$.
+ */
+template <typename V>
+typename V::reg sincos_reduce(const typename V::reg ax,
+                              typename V::reg & ps,
+                              typename V::reg & pc,
+                              const float)
+{
+  typedef typename V::reg reg;
+  const reg half = V::set1(0.5f);
+  reg y = V::trunc(V::mul(ax, V::set1(1.27323954473516f)));
+  y = V::mul(V::trunc(V::mul(V::add(y, V::set1(1.0f)), half)),
+             V::set1(2.0f));
+
+  reg r = V::sub(ax, V::mul(y, V::set1(0.78515625f)));
+  r = V::sub(r, V::mul(y, V::set1(2.4187564849853515625e-4f)));
+  r = V::sub(r, V::mul(y, V::set1(3.77489497744594108e-8f)));
+  reg z = V::mul(r, r);
+
+  ps = V::set1(-1.9515295891e-4f);
+  ps = V::add(V::mul(ps, z), V::set1(8.3321608736e-3f));
+  ps = V::add(V::mul(ps, z), V::set1(-1.6666654611e-1f));
+  ps = V::add(V::mul(V::mul(ps, z), r), r);
+
+  pc = V::set1(2.443315711809948e-5f);
+  pc = V::add(V::mul(pc, z), V::set1(-1.388731625493765e-3f));
+  pc = V::add(V::mul(pc, z), V::set1(4.166664568298827e-2f));
+  pc = V::mul(V::mul(pc, z), z);
+  pc = V::add(V::sub(pc, V::mul(half, z)), V::set1(1.0f));
+
+  return y;
+}
+
+/**
+ * This function is sincos_reduce() for double registers.
+ */
+template <typename V>
+typename V::reg sincos_reduce(const typename V::reg ax,
+                              typename V::reg & ps,
+                              typename V::reg & pc,
+                              const double)
+{
+  typedef typename V::reg reg;
+  const reg half = V::set1(0.5);
+  reg y = V::trunc(V::mul(ax, V::set1(1.27323954473516268615)));
+  y = V::mul(V::trunc(V::mul(V::add(y, V::set1(1.0)), half)),
+             V::set1(2.0));
+
+  reg r = V::sub(ax, V::mul(y, V::set1(7.85398125648498535156e-1)));
+  r = V::sub(r, V::mul(y, V::set1(3.77489470793079817668e-8)));
+  r = V::sub(r, V::mul(y, V::set1(2.69515142907905952645e-15)));
+  reg z = V::mul(r, r);
+
+  ps = V::set1(1.58962301576546568060e-10);
+  ps = V::add(V::mul(ps, z), V::set1(-2.50507477628578072866e-8));
+  ps = V::add(V::mul(ps, z), V::set1(2.75573136213857245213e-6));
+  ps = V::add(V::mul(ps, z), V::set1(-1.98412698295895385996e-4));
+  ps = V::add(V::mul(ps, z), V::set1(8.33333333332211858878e-3));
+  ps = V::add(V::mul(ps, z), V::set1(-1.66666666666666307295e-1));
+  ps = V::add(r, V::mul(V::mul(r, z), ps));
+
+  pc = V::set1(-1.13585365213876817300e-11);
+  pc = V::add(V::mul(pc, z), V::set1(2.08757008419747316778e-9));
+  pc = V::add(V::mul(pc, z), V::set1(-2.75573141792967388112e-7));
+  pc = V::add(V::mul(pc, z), V::set1(2.48015872888517045348e-5));
+  pc = V::add(V::mul(pc, z), V::set1(-1.38888888888730564116e-3));
+  pc = V::add(V::mul(pc, z), V::set1(4.16666666666665929218e-2));
+  pc = V::add(V::sub(V::set1(1.0), V::mul(half, z)),
+              V::mul(V::mul(z, z), pc));
+
+  return y;
+}
+
+/**
+ * This function returns the largest argument of sin and cos computed
+ * with the polynomials of float registers.
+ */
+inline float sincos_limit(const float)
+{
+  return 64.0f;
+}
+
+/**
+ * This function returns the largest argument of sin and cos computed
+ * with the polynomials of double registers.
+ */
+inline double sincos_limit(const double)
+{
+  return 1048576.0;
+}
+
+/**
+ * This function returns \f$\sin x\f$, or \f$\cos x\f$ if \p cosine is
+ * true, for the lanes of \p ok. The other lanes are undefined.
+ */
+template <typename V>
+typename V::reg sincos_core(const typename V::reg x,
+                            const bool cosine,
+                            const typename V::mask ok)
+{
+  typedef typename V::value_type NumT;
+  typedef typename V::reg reg;
+  const reg zero = V::set1(static_cast<NumT>(0));
+  const reg two = V::set1(static_cast<NumT>(2));
+  const reg three = V::set1(static_cast<NumT>(3));
+  const reg four = V::set1(static_cast<NumT>(4));
+  const reg eight = V::set1(static_cast<NumT>(8));
+  const reg minus_one = V::set1(static_cast<NumT>(-1));
+
+  // The lanes out of range are reduced as zero and replaced afterwards
+  reg ax = V::select(ok, V::abs(x), zero);
+  reg ps;
+  reg pc;
+  reg y = sincos_reduce<V>(ax, ps, pc, NumT());
+
+  // octant = y mod 8, one of 0, 2, 4 and 6; cos x = sin(x + pi/2)
+  reg octant = V::sub(y, V::mul(eight, V::trunc(V::mul(y, V::set1(
+                                              static_cast<NumT>(0.125))))));
+  if (cosine)
+    {
+      octant = V::add(octant, two);
+      octant = V::select(V::lt(V::set1(static_cast<NumT>(7)), octant),
+                         V::sub(octant, eight), octant);
+    }
+
+  // The octants 2 and 6 take the cosine polynomial, 4 and 6 are negative
+  reg quadrant = V::select(V::lt(three, octant), V::sub(octant, four),
+                           octant);
+  reg v = V::select(V::lt(V::set1(static_cast<NumT>(1)), quadrant), pc, ps);
+  v = V::select(V::lt(three, octant), V::mul(v, minus_one), v);
+  if (!cosine)
+    {
+      v = V::select(V::lt(x, zero), V::mul(v, minus_one), v);
+    }
+  return v;
+}
+
+/**
+ * This function computes sin or cos for the V::width elements at
+ * \p input, handing the arguments out of range to the standard library.
+ */
+template <typename V>
+void sincos_block(const typename V::value_type * input,
+                  typename V::value_type * output,
+                  const bool cosine)
+{
+  typedef typename V::value_type NumT;
+  typedef typename V::reg reg;
+  const NumT limit = sincos_limit(NumT());
+  reg x = V::load(input);
+  typename V::mask ok = V::le(V::abs(x), V::set1(limit));
+  reg v = sincos_core<V>(x, cosine, ok);
+  if (V::all(ok))
+    {
+      V::store(output, v);
+      return;
+    }
+
+  NumT value[V::width];
+  V::store(value, v);
+  for (std::size_t l = 0; l < static_cast<std::size_t>(V::width); ++l)
+    {
+      double arg = static_cast<double>(input[l]);
+      if (!(std::fabs(input[l]) <= limit))
+        {
+          value[l] = static_cast<NumT>(cosine ? std::cos(arg)
+                                       : std::sin(arg));
+        }
+      output[l] = value[l];
+    }
+}
+
+template <typename V>
+void vec_sqrt(const typename V::value_type * input,
+              typename V::value_type * output,
+              const std::size_t size)
+{
+  typedef typename V::value_type NumT;
+  typedef __ScalarVec<NumT> S;
+  std::size_t i = 0;
+  for ( ; i + V::width <= size; i += V::width)
+    {
+      V::store(output + i, V::sqrt(V::load(input + i)));
+    }
+  for ( ; i < size; ++i)
+    {
+      output[i] = S::sqrt(input[i]);
+    }
+}
+
+template <typename V>
+void vec_exp(const typename V::value_type * input,
+             typename V::value_type * output,
+             const std::size_t size)
+{
+  typedef typename V::value_type NumT;
+  typedef __ScalarVec<NumT> S;
+  std::size_t i = 0;
+  for ( ; i + V::width <= size; i += V::width)
+    {
+      V::store(output + i, exp_core<V>(V::load(input + i), NumT()));
+    }
+  for ( ; i < size; ++i)
+    {
+      output[i] = exp_core<S>(input[i], NumT());
+    }
+}
+
+template <typename V>
+void vec_sincos(const typename V::value_type * input,
+                typename V::value_type * output,
+                const std::size_t size,
+                const bool cosine)
+{
+  typedef typename V::value_type NumT;
+  typedef __ScalarVec<NumT> S;
+  std::size_t i = 0;
+  for ( ; i + V::width <= size; i += V::width)
+    {
+      sincos_block<V>(input + i, output + i, cosine);
+    }
+  for ( ; i < size; ++i)
+    {
+      sincos_block<S>(input + i, output + i, cosine);
+    }
+}
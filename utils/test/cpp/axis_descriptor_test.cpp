@@ -0,0 +1,300 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+
+/**
+ * $Id$
+ *
+ * \file utils/test/cpp/axis_descriptor_test.cpp
+ */
+
+#include "utils.hpp"
+#include "test_common.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+/// Number of bins of the axes
+const size_t NUM_BINS = 200;
+/// Number of values searched on every axis
+const size_t NUM_VAL = 1000;
+
+/**
+ * \defgroup axis_descriptor_test axis_descriptor_test
+ * \{
+ *
+ * This test compares the searches of <i>Utils::AxisDescriptor</i> with
+ * std::upper_bound(), std::lower_bound() and the vector version of
+ * <i>bisect_helper</i> on linear, logarithmic and irregular axes. The
+ * values searched lie inside and outside the axes and on their edges.
+ */
+
+/**
+ * This function fills an axis.
+ *
+ * \param spacing (INPUT) is the spacing of the edges
+ * \param axis (OUTPUT) is the axis
+ */
+template <typename NumT>
+void initialize_axis(const int spacing, Nessi::Vector<NumT> & axis)
+{
+  axis.clear();
+  for (size_t i = 0; i <= NUM_BINS; ++i)
+    {
+      double x = static_cast<double>(i);
+      switch (spacing)
+        {
+        case 0:
+          // linear edges with the rounding of a binning of 0.1
+          axis.push_back(static_cast<NumT>(-3.7 + 0.1 * x));
+          break;
+        case 1:
+          axis.push_back(static_cast<NumT>(0.5 * std::pow(1.01, x)));
+          break;
+        default:
+          axis.push_back(static_cast<NumT>(x + 0.003 * x * x * x));
+          break;
+        }
+    }
+}
+
+/**
+ * This function fills the values to search on an axis: the edges, the
+ * values between them and values outside the axis, in a shuffled order.
+ *
+ * \param axis (INPUT) is the axis
+ * \param values (OUTPUT) is the values to search
+ */
+template <typename NumT>
+void initialize_values(const Nessi::Vector<NumT> & axis,
+                       Nessi::Vector<NumT> & values)
+{
+  values.clear();
+  NumT first = axis[0];
+  NumT width = axis[axis.size() - 1] - first;
+  for (size_t i = 0; i < NUM_VAL; ++i)
+    {
+      size_t j = (i * 7919) % NUM_VAL;
+      if (j % 3 == 0 && j / 3 < axis.size())
+        {
+          values.push_back(axis[j / 3]);
+        }
+      else
+        {
+          NumT x = static_cast<NumT>(j) / static_cast<NumT>(NUM_VAL - 100);
+          values.push_back(first + (x - static_cast<NumT>(0.05)) * width);
+        }
+    }
+  values.push_back(std::numeric_limits<NumT>::quiet_NaN());
+  values.push_back(-std::numeric_limits<NumT>::infinity());
+  values.push_back(std::numeric_limits<NumT>::infinity());
+}
+
+/**
+ * Function that compares every search of a descriptor with the standard
+ * algorithms.
+ *
+ * \param desc (INPUT) is the descriptor
+ * \param label (INPUT) names the axis in the messages
+ * \param debug (INPUT) is any string that launches the debug mode
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_searches(const Utils::AxisDescriptor<NumT> & desc,
+                   const string & label,
+                   string debug)
+{
+  const Nessi::Vector<NumT> & axis = desc.axis();
+  Nessi::Vector<NumT> values;
+  initialize_values(axis, values);
+
+  size_t hint = 0;
+  for (size_t i = 0; i < values.size(); ++i)
+    {
+      NumT value = values[i];
+      size_t true_upper = std::upper_bound(axis.begin(), axis.end(), value)
+        - axis.begin();
+      size_t true_lower = std::lower_bound(axis.begin(), axis.end(), value)
+        - axis.begin();
+      size_t true_bin;
+      Utils::bisect_helper(axis, value, true_bin);
+
+      size_t upper = desc.upper_bound(value);
+      size_t lower = desc.lower_bound(value);
+      size_t hinted_upper = desc.upper_bound(value, hint);
+      size_t hinted_lower = desc.lower_bound(value, hint);
+      size_t bin;
+      Utils::bisect_helper(desc, value, bin);
+      hint = hinted_upper;
+
+      if (!debug.empty())
+        {
+          print(upper, true_upper, SS, debug);
+          print(bin, true_bin, SS, debug);
+        }
+
+      if (upper != true_upper || hinted_upper != true_upper
+          || lower != true_lower || hinted_lower != true_lower
+          || bin != true_bin || desc.find_bin(value) != true_bin)
+        {
+          cout << "(" << type_string(value) << " " << label << ", value "
+               << value << ") FAILED....Search different from expected"
+               << endl;
+          return false;
+        }
+    }
+  return true;
+}
+
+/**
+ * Function that runs the searches on every axis, with the detected and the
+ * declared spacings, and checks the exceptions.
+ *
+ * \param key (INPUT) key that permits to launch the correct test
+ * \param debug (INPUT) is any string that launches the debug mode (print all
+ * the array created and calculated)
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_func(NumT key, string debug)
+{
+  typedef Utils::AxisDescriptor<NumT> Desc;
+  const typename Desc::Spacing spacings[3] = {Desc::LINEAR,
+                                              Desc::LOGARITHMIC,
+                                              Desc::IRREGULAR};
+  const string labels[3] = {"linear", "logarithmic", "irregular"};
+
+  Nessi::Vector<NumT> axis;
+  for (int s = 0; s < 3; ++s)
+    {
+      initialize_axis(s, axis);
+
+      Desc detected(axis);
+      if (detected.spacing() != spacings[s])
+        {
+          cout << "(" << type_string(key) << " " << labels[s]
+               << ") FAILED....Spacing not detected" << endl;
+          return false;
+        }
+      if (!test_searches(detected, labels[s], debug))
+        {
+          return false;
+        }
+
+      // a declared spacing gives the same answers on any increasing axis
+      for (int d = 0; d < 3; ++d)
+        {
+          if (spacings[d] == Desc::LOGARITHMIC && !(axis[0] > 0))
+            {
+              continue;
+            }
+          Desc declared(axis, spacings[d]);
+          if (!test_searches(declared, labels[s] + " as " + labels[d],
+                             debug))
+            {
+              return false;
+            }
+        }
+    }
+
+  // a logarithmic axis needs positive edges
+  initialize_axis(0, axis);
+  try
+    {
+      Desc desc(axis, Desc::LOGARITHMIC);
+      cout << "(" << type_string(key) << ") FAILED....No exception thrown"
+           << endl;
+      return false;
+    }
+  catch (std::invalid_argument &)
+    {
+    }
+
+  // a single edge cannot be linear
+  Nessi::Vector<NumT> single;
+  single.push_back(static_cast<NumT>(1));
+  if (Desc(single).spacing() != Desc::IRREGULAR)
+    {
+      cout << "(" << type_string(key) << ") FAILED....Single edge not "
+           << "irregular" << endl;
+      return false;
+    }
+  try
+    {
+      Desc desc(single, Desc::LINEAR);
+      cout << "(" << type_string(key) << ") FAILED....No exception thrown"
+           << endl;
+      return false;
+    }
+  catch (std::invalid_argument &)
+    {
+    }
+
+  return true;
+}
+
+/**
+ * Main function that tests <i>Utils::AxisDescriptor</i> for float and
+ * double
+ *
+ * \param argc The number of command-line arguments present
+ * \param argv The list of command-line arguments
+ */
+int main(int argc, char *argv[])
+{
+  cout << "axis_descriptor_test.cpp..........";
+
+  string debug;
+  if(argc > 1)
+    {
+      debug = argv[1];
+    }
+
+  int value = 0;
+
+  if(!test_func(static_cast<float>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(!test_func(static_cast<double>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(value == 0)
+    {
+      cout << "Functionality OK" << endl;
+    }
+
+  return value;
+}
+
+/**
+ * \}
+ */   //end of axis_descriptor_test group
@@ -0,0 +1,264 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+
+/**
+ * $Id$
+ *
+ * \file utils/test/cpp/bisect_many_test.cpp
+ */
+
+#include "nessi_simd.hpp"
+#include "utils.hpp"
+#include "test_common.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+/// Number of edges of the axis
+const size_t NUM_EDGES = 97;
+/// Number of values searched
+const size_t NUM_VAL = 501;
+
+/**
+ * \defgroup bisect_many_test bisect_many_test
+ * \{
+ *
+ * This test compares the indices found by the library function
+ * <i>bisect_many</i> with the indices found by <i>bisect_helper</i> for
+ * every value. The values are searched sorted, as a few sorted runs and
+ * shuffled, so that every search of <i>bisect_many</i> is run, with every
+ * instruction set supported by the host. They lie inside and outside the
+ * axis, on its edges, and include a NaN.
+ *
+ * <b>Notations used:</b>
+ * - SS = "s,s"
+ */
+
+/**
+ * This function initializes an irregular axis.
+ *
+ * \param axis (OUTPUT) is the axis to search
+ */
+template <typename NumT>
+void initialize_axis(Nessi::Vector<NumT> & axis)
+{
+  for (size_t i = 0; i < NUM_EDGES; ++i)
+    {
+      NumT x = static_cast<NumT>(i);
+      axis.push_back(x + x * x / static_cast<NumT>(50));
+    }
+}
+
+/**
+ * This function initializes the values to search, in increasing order.
+ *
+ * \param axis (INPUT) is the axis to search
+ * \param queries (OUTPUT) is the values to search the axis for
+ */
+template <typename NumT>
+void initialize_queries(const Nessi::Vector<NumT> & axis,
+                        Nessi::Vector<NumT> & queries)
+{
+  NumT first = axis[0] - static_cast<NumT>(10);
+  NumT step = (axis[NUM_EDGES - 1] + static_cast<NumT>(20))
+    / static_cast<NumT>(NUM_VAL);
+  for (size_t i = 0; i < NUM_VAL; ++i)
+    {
+      queries.push_back(first + static_cast<NumT>(i) * step);
+    }
+  // values on the edges
+  for (size_t i = 0; i < NUM_EDGES; i += 5)
+    {
+      queries.push_back(axis[i]);
+    }
+  std::sort(queries.begin(), queries.end());
+}
+
+/**
+ * Function that compares the indices of <i>bisect_many</i> with those of
+ * <i>bisect_helper</i> for every instruction set.
+ *
+ * \param axis (INPUT) is the axis to search
+ * \param queries (INPUT) is the values to search the axis for
+ * \param order (INPUT) names the order of the values in the messages
+ * \param debug (INPUT) is any string that launches the debug mode
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_order(const Nessi::Vector<NumT> & axis,
+                const Nessi::Vector<NumT> & queries,
+                const string & order,
+                string debug)
+{
+  Nessi::SimdLevel host = Nessi::set_simd_level(Nessi::SIMD_AVX512);
+  Nessi::Vector<size_t> indices(queries.size());
+  bool value = true;
+
+  for (int level = Nessi::SIMD_NONE; level <= host && value; ++level)
+    {
+      Nessi::set_simd_level(static_cast<Nessi::SimdLevel>(level));
+      Utils::bisect_many(axis, queries, indices);
+
+      for (size_t i = 0; i < queries.size(); ++i)
+        {
+          size_t true_index;
+          Utils::bisect_helper(axis, queries[i], true_index);
+          if (!debug.empty())
+            {
+              print(indices[i], true_index, SS, debug);
+            }
+          if (indices[i] != true_index)
+            {
+              cout << "(" << type_string(queries[i]) << " " << order
+                   << ", SIMD level " << level << ", value " << queries[i]
+                   << ") FAILED....Index different from expected" << endl;
+              value = false;
+              break;
+            }
+        }
+    }
+
+  Nessi::set_simd_level(host);
+
+  return value;
+}
+
+/**
+ * Function that runs the searches for sorted, partly sorted and shuffled
+ * values and checks the exceptions.
+ *
+ * \param key (INPUT) key that permits to launch the correct test
+ * \param debug (INPUT) is any string that launches the debug mode (print all
+ * the array created and calculated)
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_func(NumT key, string debug)
+{
+  Nessi::Vector<NumT> axis;
+  Nessi::Vector<NumT> sorted;
+  initialize_axis(axis);
+  initialize_queries(axis, sorted);
+
+  if (!test_order(axis, sorted, "sorted", debug))
+    {
+      return false;
+    }
+
+  // three sorted runs, like the shifted positions of shift_spectrum
+  Nessi::Vector<NumT> runs;
+  for (size_t r = 0; r < 3; ++r)
+    {
+      for (size_t i = r; i < sorted.size(); i += 3)
+        {
+          runs.push_back(sorted[i]);
+        }
+    }
+  if (!test_order(axis, runs, "runs", debug))
+    {
+      return false;
+    }
+
+  // shuffled, with a NaN and an odd number of values
+  Nessi::Vector<NumT> shuffled;
+  for (size_t i = 0; i < sorted.size(); ++i)
+    {
+      shuffled.push_back(sorted[(i * 409) % sorted.size()]);
+    }
+  shuffled.push_back(std::numeric_limits<NumT>::quiet_NaN());
+  shuffled.push_back(sorted[3]);
+  if (!test_order(axis, shuffled, "shuffled", debug))
+    {
+      return false;
+    }
+
+  // a few values
+  Nessi::Vector<NumT> few;
+  few.push_back(sorted[sorted.size() - 1]);
+  few.push_back(sorted[0]);
+  few.push_back(std::numeric_limits<NumT>::quiet_NaN());
+  if (!test_order(axis, few, "few", debug))
+    {
+      return false;
+    }
+
+  Nessi::Vector<size_t> wrong(sorted.size() + 1);
+  try
+    {
+      Utils::bisect_many(axis, sorted, wrong);
+      cout << "(" << type_string(key) << ") FAILED....No exception thrown"
+           << endl;
+      return false;
+    }
+  catch (std::invalid_argument &)
+    {
+    }
+
+  return true;
+}
+
+/**
+ * Main function that tests <i>bisect_many</i> for float and double
+ *
+ * \param argc The number of command-line arguments present
+ * \param argv The list of command-line arguments
+ */
+int main(int argc, char *argv[])
+{
+  cout << "bisect_many_test.cpp..........";
+
+  string debug;
+  if(argc > 1)
+    {
+      debug = argv[1];
+    }
+
+  int value = 0;
+
+  if(!test_func(static_cast<float>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(!test_func(static_cast<double>(1), debug))
+    {
+      value = -1;
+    }
+
+  if(value == 0)
+    {
+      cout << "Functionality OK" << endl;
+    }
+
+  return value;
+}
+
+/**
+ * \}
+ */   //end of bisect_many_test group
@@ -0,0 +1,339 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+
+/**
+ * $Id$
+ *
+ * \file utils/test/cpp/vector_math_test.cpp
+ */
+
+#include "nessi_simd.hpp"
+#include "test_common.hpp"
+#include "vector_math.hpp"
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+/// Number of elements, chosen to leave a remainder for every register width
+const size_t NUM_VAL = 37;
+
+/**
+ * \defgroup vector_math_test vector_math_test
+ * \{
+ *
+ * This test applies <i>Utils::__vec_sqrt</i>, <i>Utils::__vec_exp</i>,
+ * <i>Utils::__vec_sin</i> and <i>Utils::__vec_cos</i> to arrays of float
+ * and double. The results are compared with the standard library in long
+ * double precision within the bounds documented in vector_math.hpp, and
+ * the results of every instruction set supported by the host must be
+ * identical to the results of the scalar loop (Nessi::SIMD_NONE).
+ */
+
+/// Signature shared by the four vector functions
+typedef void (*vec_func_f)(const float *, float *, const size_t);
+/// Signature shared by the four vector functions
+typedef void (*vec_func_d)(const double *, double *, const size_t);
+
+/**
+ * This function returns the distance between \p output and \p expected in
+ * units in the last place of NumT.
+ *
+ * \param output (INPUT) is the value calculated
+ * \param expected (INPUT) is the exact value
+ */
+template <typename NumT>
+long double ulp_error(const NumT output, const long double expected)
+{
+  if (std::isnan(expected))
+    {
+      return std::isnan(output) ? 0 : numeric_limits<NumT>::max();
+    }
+  if (std::isinf(expected) || std::isinf(output))
+    {
+      return (output == expected) ? 0 : numeric_limits<NumT>::max();
+    }
+  int exponent = numeric_limits<NumT>::min_exponent;
+  if (std::fabs(expected) >= numeric_limits<NumT>::min())
+    {
+      std::frexp(expected, &exponent);
+    }
+  long double ulp = std::ldexp(1.0L, exponent
+                               - numeric_limits<NumT>::digits);
+  return std::fabs(static_cast<long double>(output) - expected) / ulp;
+}
+
+/**
+ * This function fills \p input with NUM_VAL values spread over
+ * [\p low, \p high].
+ *
+ * \param low (INPUT) is the first value
+ * \param high (INPUT) is the last value
+ * \param input (OUTPUT) is the array of values
+ */
+template <typename NumT>
+void initialize_input(const double low, const double high,
+                      Nessi::Vector<NumT> & input)
+{
+  input.clear();
+  for (size_t i = 0; i < NUM_VAL; ++i)
+    {
+      input.push_back(static_cast<NumT>(low + (high - low) * i
+                                        / (NUM_VAL - 1)));
+    }
+}
+
+/**
+ * This function runs one function of the vector math layer and checks
+ * its results.
+ *
+ * \param name (INPUT) is the name of the function for the messages
+ * \param func (INPUT) is the function to test
+ * \param func_ref (INPUT) is the standard library function
+ * \param bound (INPUT) is the largest error in ulp allowed
+ * \param input (INPUT) is the array of arguments
+ * \param host (INPUT) is the highest instruction set of the host
+ * \param debug (INPUT) is any string that launches the debug mode
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT, typename FuncT>
+bool test_one(const string & name, FuncT func,
+              long double (*func_ref)(long double),
+              const long double bound, const Nessi::Vector<NumT> & input,
+              const Nessi::SimdLevel host, string debug)
+{
+  size_t size = input.size();
+  Nessi::Vector<NumT> true_output(size);
+  Nessi::Vector<NumT> output(size);
+
+  Nessi::set_simd_level(Nessi::SIMD_NONE);
+  func(&input[0], &true_output[0], size);
+
+  for (size_t i = 0; i < size; ++i)
+    {
+      long double expected = func_ref(static_cast<long double>(input[i]));
+      long double error = ulp_error(true_output[i], expected);
+      if (!debug.empty())
+        {
+          cout << endl << name << "(" << input[i] << ") = "
+               << true_output[i] << " (" << error << " ulp)";
+        }
+      if (!(error <= bound))
+        {
+          cout << "(" << type_string(input[i]) << " " << name << ") "
+               << "FAILED....Error of " << error << " ulp for "
+               << input[i] << endl;
+          return false;
+        }
+    }
+
+  for (int level = Nessi::SIMD_SSE2; level <= host; ++level)
+    {
+      Nessi::set_simd_level(static_cast<Nessi::SimdLevel>(level));
+      func(&input[0], &output[0], size);
+      if (output != true_output)
+        {
+          cout << "(" << type_string(input[0]) << " " << name
+               << ", SIMD level " << level << ") FAILED....Output "
+               << "different from scalar loop" << endl;
+          return false;
+        }
+    }
+
+  // the output may overwrite the input
+  Nessi::Vector<NumT> in_place(input);
+  func(&in_place[0], &in_place[0], size);
+  if (in_place != true_output)
+    {
+      cout << "(" << type_string(input[0]) << " " << name << ") "
+           << "FAILED....In place output different" << endl;
+      return false;
+    }
+
+  return true;
+}
+
+/**
+ * This function returns the square root in long double precision.
+ */
+long double ref_sqrt(long double x)
+{
+  return std::sqrt(x);
+}
+
+/**
+ * This function returns the exponential in long double precision.
+ */
+long double ref_exp(long double x)
+{
+  return std::exp(x);
+}
+
+/**
+ * This function returns the sine in long double precision.
+ */
+long double ref_sin(long double x)
+{
+  return std::sin(x);
+}
+
+/**
+ * This function returns the cosine in long double precision.
+ */
+long double ref_cos(long double x)
+{
+  return std::cos(x);
+}
+
+/**
+ * Function that runs the four functions over the ranges where their
+ * bounds hold, on arguments outside of those ranges and on the special
+ * values.
+ *
+ * \param sqrt_f (INPUT) is Utils::__vec_sqrt() for NumT
+ * \param exp_f (INPUT) is Utils::__vec_exp() for NumT
+ * \param sin_f (INPUT) is Utils::__vec_sin() for NumT
+ * \param cos_f (INPUT) is Utils::__vec_cos() for NumT
+ * \param exp_bound (INPUT) is the error bound of the exponential
+ * \param trig_limit (INPUT) is the largest argument of sin and cos
+ * computed with the polynomials
+ * \param debug (INPUT) is any string that launches the debug mode (print all
+ * the array created and calculated)
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT, typename FuncT>
+bool test_func(FuncT sqrt_f, FuncT exp_f, FuncT sin_f, FuncT cos_f,
+               const long double exp_bound, const double trig_limit,
+               string debug)
+{
+  Nessi::SimdLevel host = Nessi::set_simd_level(Nessi::SIMD_AVX512);
+  Nessi::Vector<NumT> input;
+  bool value = true;
+
+  initialize_input(0.0, 1.0e6, input);
+  value = value && test_one("sqrt", sqrt_f, ref_sqrt, 0.5L, input, host,
+                            debug);
+  initialize_input(-80.0, 80.0, input);
+  value = value && test_one("exp", exp_f, ref_exp, exp_bound, input, host,
+                            debug);
+  initialize_input(-trig_limit, trig_limit, input);
+  value = value && test_one("sin", sin_f, ref_sin, 2.0L, input, host,
+                            debug);
+  value = value && test_one("cos", cos_f, ref_cos, 2.0L, input, host,
+                            debug);
+
+  // beyond the limit the standard library is used in double precision
+  initialize_input(2.0 * trig_limit, 1.0e7, input);
+  value = value && test_one("sin", sin_f, ref_sin, 1.0L, input, host,
+                            debug);
+
+  // special values
+  NumT inf = numeric_limits<NumT>::infinity();
+  NumT nan = numeric_limits<NumT>::quiet_NaN();
+  input.clear();
+  input.push_back(static_cast<NumT>(0));
+  input.push_back(inf);
+  input.push_back(-inf);
+  input.push_back(nan);
+  input.push_back(static_cast<NumT>(-1000));
+  input.push_back(static_cast<NumT>(1000));
+
+  Nessi::Vector<NumT> output(input.size());
+  for (int level = Nessi::SIMD_NONE; level <= host; ++level)
+    {
+      Nessi::set_simd_level(static_cast<Nessi::SimdLevel>(level));
+      exp_f(&input[0], &output[0], input.size());
+      if (output[0] != 1 || output[1] != inf || output[2] != 0
+          || !std::isnan(output[3]) || output[4] != 0 || output[5] != inf)
+        {
+          cout << "(" << type_string(input[0]) << " exp, SIMD level "
+               << level << ") FAILED....Special values" << endl;
+          value = false;
+        }
+      sin_f(&input[0], &output[0], input.size());
+      if (output[0] != 0 || !std::isnan(output[1]) || !std::isnan(output[2])
+          || !std::isnan(output[3]))
+        {
+          cout << "(" << type_string(input[0]) << " sin, SIMD level "
+               << level << ") FAILED....Special values" << endl;
+          value = false;
+        }
+    }
+
+  Nessi::set_simd_level(host);
+
+  return value;
+}
+
+/**
+ * Main function that tests the vector math layer for float and double.
+ *
+ * \param argc The number of command-line arguments present
+ * \param argv The list of command-line arguments
+ */
+int main(int argc, char *argv[])
+{
+  cout << "vector_math_test.cpp..........";
+
+  string debug;
+  if (argc >1)
+    {
+      debug = argv[1];
+    }
+
+  int value = 0;
+
+  vec_func_f sqrt_f = Utils::__vec_sqrt;
+  vec_func_f exp_f = Utils::__vec_exp;
+  vec_func_f sin_f = Utils::__vec_sin;
+  vec_func_f cos_f = Utils::__vec_cos;
+  if(!test_func<float>(sqrt_f, exp_f, sin_f, cos_f, 1.0L, 64.0, debug))
+    {
+      value = -1;
+    }
+
+  vec_func_d sqrt_d = Utils::__vec_sqrt;
+  vec_func_d exp_d = Utils::__vec_exp;
+  vec_func_d sin_d = Utils::__vec_sin;
+  vec_func_d cos_d = Utils::__vec_cos;
+  if(!test_func<double>(sqrt_d, exp_d, sin_d, cos_d, 2.0L, 1048576.0,
+                        debug))
+    {
+      value = -1;
+    }
+
+  if(value == 0)
+    {
+      cout << "Functionality OK" << endl;
+    }
+
+  return value;
+}
+
+/**
+ * \}
+ */   //end of vector_math_test group
@@ -0,0 +1,208 @@
+/*
+ *                     SNS Common Libraries
+ *           A part of the SNS Analysis Software Suite.
+ *
+ *                  Spallation Neutron Source
+ *          Oak Ridge National Laboratory, Oak Ridge TN.
+ *
+ *
+ *                             NOTICE
+ *
+ * For this software and its associated documentation, permission is granted
+ * to reproduce, prepare derivative works, and distribute copies to the public
+ * for any purpose and without fee.
+ *
+ * This material was prepared as an account of work sponsored by an agency of
+ * the United States Government.  Neither the United States Government nor the
+ * United States Department of Energy, nor any of their employees, makes any
+ * warranty, express or implied, or assumes any legal liability or
+ * responsibility for the accuracy, completeness, or usefulness of any
+ * information, apparatus, product, or process disclosed, or represents that
+ * its use would not infringe privately owned rights.
+ *
+ */
+
+/**
+ * $Id$
+ *
+ * \file utils/test/cpp/warning_sink_test.cpp
+ */
+
+#include "nessi_warn.hpp"
+#include "utils.hpp"
+#include "test_common.hpp"
+
+using namespace std;
+
+/// Number of bins in the histograms
+const int NUM_VAL = 4;
+
+/**
+ * \defgroup warning_sink_test warning_sink_test
+ * \{
+ *
+ * This test checks that Nessi::WarningSink keeps the string warnings in
+ * the order they were reported, that Nessi::NoWarnings drops everything and
+ * that <i>linear_order_jacobian</i> still returns an empty string, for a
+ * valid axis as well as for a transformed axis with a bin of zero width.
+ */
+
+/**
+ * Function that compares a warning string with the one expected.
+ *
+ * \param warn (INPUT) is the string returned
+ * \param true_warn (INPUT) is the string expected
+ * \param what (INPUT) is the name of the check for the error message
+ */
+bool test_warning(const string & warn, const string & true_warn,
+                  const string & what)
+{
+  if (warn != true_warn)
+    {
+      cout << "(" << what << ") FAILED....Warning \"" << warn
+           << "\" instead of \"" << true_warn << "\"" << endl;
+      return false;
+    }
+  return true;
+}
+
+/**
+ * Function that checks the sinks themselves.
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+bool test_sinks()
+{
+  bool value = true;
+
+  Nessi::WarningSink sink;
+  if (!sink.empty()
+      || !test_warning(sink.str(), Nessi::EMPTY_WARN, "empty sink"))
+    {
+      value = false;
+    }
+
+  sink.report("first warning\n");
+  sink.report(Nessi::EMPTY_WARN);
+  if (sink.empty()
+      || !test_warning(sink.str(), "first warning\n", "text"))
+    {
+      value = false;
+    }
+
+  Nessi::WarningSink other;
+  other.report("second warning\n");
+  sink.merge(other);
+  if (!test_warning(sink.str(), "first warning\nsecond warning\n",
+                    "merge"))
+    {
+      value = false;
+    }
+
+  sink.clear();
+  if (!sink.empty())
+    {
+      cout << "(clear) FAILED....Warnings left in the sink" << endl;
+      value = false;
+    }
+
+  Nessi::NoWarnings none;
+  none.report("text warning\n");
+  if (!none.empty()
+      || !test_warning(none.str(), Nessi::EMPTY_WARN, "no warnings"))
+    {
+      value = false;
+    }
+
+  return value;
+}
+
+/**
+ * Function that checks the warnings returned by linear_order_jacobian.
+ *
+ * \param key (INPUT) key that permits to launch the correct test
+ *
+ * \return Result of the function (TRUE/FALSE)
+ */
+template <typename NumT>
+bool test_func(NumT key)
+{
+  Nessi::Vector<NumT> input;
+  Nessi::Vector<NumT> input_err2;
+  Nessi::Vector<NumT> axis_in;
+  Nessi::Vector<NumT> axis_out;
+  for (int i = 0; i < NUM_VAL; ++i)
+    {
+      input.push_back(static_cast<NumT>(10 * (i + 1)));
+      input_err2.push_back(static_cast<NumT>(i + 1));
+    }
+  for (int i = 0; i <= NUM_VAL; ++i)
+    {
+      axis_in.push_back(static_cast<NumT>(i));
+      axis_out.push_back(static_cast<NumT>(2 * i));
+    }
+
+  Nessi::Vector<NumT> output(NUM_VAL);
+  Nessi::Vector<NumT> output_err2(NUM_VAL);
+
+  bool value = true;
+  string warn = Utils::linear_order_jacobian(axis_in, axis_out, input,
+                                             input_err2, output,
+                                             output_err2);
+  if (!test_warning(warn, Nessi::EMPTY_WARN, type_string(output)))
+    {
+      value = false;
+    }
+
+  // the second bin has no width
+  axis_out[2] = axis_out[1];
+  warn = Utils::linear_order_jacobian(axis_in, axis_out, input, input_err2,
+                                      output, output_err2);
+  if (!test_warning(warn, Nessi::EMPTY_WARN,
+                    type_string(output) + " zero width"))
+    {
+      value = false;
+    }
+
+  return value;
+}
+
+/**
+ * Main function that tests the warning sinks and the warnings of
+ * linear_order_jacobian for float and double.
+ *
+ * \param argc The number of command-line arguments present
+ * \param argv The list of command-line arguments
+ */
+int main(int argc, char *argv[])
+{
+  cout << "warning_sink_test.cpp..........";
+
+  int value = 0;
+
+  if (!test_sinks())
+    {
+      value = -1;
+    }
+
+  if(!test_func(static_cast<float>(1)))
+    {
+      value = -1;
+    }
+
+  if(!test_func(static_cast<double>(1)))
+    {
+      value = -1;
+    }
+
+  if(value == 0)
+    {
+      cout << "Functionality OK" << endl;
+    }
+
+  return value;
+}
+
+/**
+ * \}
+ */   //end of warning_sink_test group